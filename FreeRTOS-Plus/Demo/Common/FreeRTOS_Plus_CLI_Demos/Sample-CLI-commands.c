@@ -71,6 +71,13 @@ static BaseType_t prvTaskStatsCommand( char *pcWriteBuffer, size_t xWriteBufferL
 	static BaseType_t prvRunTimeStatsCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+/*
+ * Implements the sched-latency command.
+ */
+#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+	static BaseType_t prvSchedulingLatencyCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
+
 /*
  * Implements the echo-three-parameters command.
  */
@@ -139,6 +146,19 @@ static const CLI_Command_Definition_t xParameterEcho =
 	};
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+	/* Structure that defines the "sched-latency" command line command.  This
+	generates a histogram, for each priority, of the time tasks have waited to
+	run after becoming ready. */
+	static const CLI_Command_Definition_t xSchedulingLatency =
+	{
+		"sched-latency", /* The command string to type. */
+		"\r\nsched-latency:\r\n Displays, for each priority, how many times tasks waited between 2^n and 2^(n+1) run time counts to run after becoming ready\r\n",
+		prvSchedulingLatencyCommand, /* The function to run. */
+		0 /* No parameters are expected. */
+	};
+#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
+
 #if( configINCLUDE_QUERY_HEAP_COMMAND == 1 )
 	/* Structure that defines the "query_heap" command line command. */
 	static const CLI_Command_Definition_t xQueryHeap =
@@ -176,6 +196,12 @@ void vRegisterSampleCLICommands( void )
 		FreeRTOS_CLIRegisterCommand( &xRunTimeStats );
 	}
 	#endif
+
+	#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+	{
+		FreeRTOS_CLIRegisterCommand( &xSchedulingLatency );
+	}
+	#endif
 	
 	#if( configINCLUDE_QUERY_HEAP_COMMAND == 1 )
 	{
@@ -292,6 +318,81 @@ BaseType_t xSpacePadding;
 #endif /* configGENERATE_RUN_TIME_STATS */
 /*-----------------------------------------------------------*/
 
+#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+
+	static BaseType_t prvSchedulingLatencyCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+	{
+	static UBaseType_t uxNextPriority = 0;
+	uint32_t ulHistogram[ configSCHEDULING_LATENCY_BUCKETS ], ulSamples = 0;
+	configRUN_TIME_COUNTER_TYPE ulMaxLatency = 0;
+	UBaseType_t uxPriority = 0, uxBucket;
+	size_t xLength = 0;
+	BaseType_t xReturn;
+
+		/* Remove compile time warnings about unused parameters, and check the
+		write buffer is not NULL. */
+		( void ) pcCommandString;
+		configASSERT( pcWriteBuffer );
+
+		*pcWriteBuffer = 0x00;
+
+		if( uxNextPriority == 0 )
+		{
+			/* The first time the function is called after the command has been
+			entered the header is returned ahead of the first histogram. */
+			xLength = ( size_t ) snprintf( pcWriteBuffer, xWriteBufferLen, "Priority, longest wait, then 2^n:count for each non-zero bucket n\r\n" );
+		}
+
+		/* Find the next priority at which a task has been switched in. */
+		while( ( ulSamples == 0 ) && ( uxNextPriority < ( UBaseType_t ) configMAX_PRIORITIES ) )
+		{
+			uxPriority = uxNextPriority;
+			uxNextPriority++;
+			( void ) xTaskGetSchedulingLatencyHistogram( uxPriority, ulHistogram, &ulMaxLatency );
+
+			for( uxBucket = 0; uxBucket < ( UBaseType_t ) configSCHEDULING_LATENCY_BUCKETS; uxBucket++ )
+			{
+				ulSamples += ulHistogram[ uxBucket ];
+			}
+		}
+
+		if( ( ulSamples != 0 ) && ( xLength < xWriteBufferLen ) )
+		{
+			xLength += ( size_t ) snprintf( pcWriteBuffer + xLength, xWriteBufferLen - xLength, "%u, %lu,", ( unsigned int ) uxPriority, ( unsigned long ) ulMaxLatency );
+
+			for( uxBucket = 0; ( uxBucket < ( UBaseType_t ) configSCHEDULING_LATENCY_BUCKETS ) && ( xLength < xWriteBufferLen ); uxBucket++ )
+			{
+				if( ulHistogram[ uxBucket ] != 0 )
+				{
+					xLength += ( size_t ) snprintf( pcWriteBuffer + xLength, xWriteBufferLen - xLength, " 2^%u:%lu", ( unsigned int ) uxBucket, ( unsigned long ) ulHistogram[ uxBucket ] );
+				}
+			}
+
+			if( xLength < xWriteBufferLen )
+			{
+				snprintf( pcWriteBuffer + xLength, xWriteBufferLen - xLength, "\r\n" );
+			}
+		}
+
+		if( uxNextPriority < ( UBaseType_t ) configMAX_PRIORITIES )
+		{
+			/* There may be more priorities to return. */
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			/* This was the last priority, so start from the first priority the
+			next time the command is entered. */
+			uxNextPriority = 0;
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvThreeParameterEchoCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
 {
 const char *pcParameter;
@@ -689,7 +689,14 @@ static void prvTakeTwoMutexesReturnInDifferentOrder( SemaphoreHandle_t xMutex, S
 	simplification to allow FreeRTOS to be integrated with middleware that
 	attempts to hold multiple mutexes without bloating the code with complex
 	algorithms.  It is possible that the high priority mutex task will
-	execute as it shares a priority with this task. */
+	execute as it shares a priority with this task.
+
+	When configUSE_TRANSITIVE_PRIORITY_INHERITANCE is 1 the priority of this
+	task is instead recalculated from the tasks still waiting for the mutexes
+	it holds.  No task is waiting for the local mutex, so this task is
+	disinherited straight away, the medium priority task executes, and both the
+	high and medium priority tasks will have been suspended again by the time
+	this task next runs. */
 	if( xSemaphoreGive( xMutex ) != pdPASS )
 	{
 		xErrorDetected = pdTRUE;
@@ -699,25 +706,45 @@ static void prvTakeTwoMutexesReturnInDifferentOrder( SemaphoreHandle_t xMutex, S
 		taskYIELD();
 	#endif
 
-	/* The guarded variable is only incremented by the medium priority task,
-	which still should not have executed as this task should remain at the
-	higher priority, ensure this is the case. */
-	if( ulGuardedVariable != 0 )
+	#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 0 )
 	{
-		xErrorDetected = pdTRUE;
-	}
+		/* The guarded variable is only incremented by the medium priority
+		task, which still should not have executed as this task should remain
+		at the higher priority, ensure this is the case. */
+		if( ulGuardedVariable != 0 )
+		{
+			xErrorDetected = pdTRUE;
+		}
 
-	if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+		if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+	#else
 	{
-		xErrorDetected = pdTRUE;
+		/* The medium priority task should have executed, and this task should
+		have been disinherited to genqMUTEX_TEST_PRIORITY. */
+		if( ulGuardedVariable != 1 )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( uxTaskPriorityGet( NULL ) != genqMUTEX_TEST_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
 	}
+	#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
 
 	/* Now also give back the local mutex, taking the held count back to 0.
 	This time the priority of this task should be disinherited back to the
 	priority to which it was set while the mutex was held.  This means
 	the medium priority task should execute and increment the guarded
 	variable.   When this task next	runs both the high and medium priority
-	tasks will have been suspended again. */
+	tasks will have been suspended again.  (With transitive priority
+	inheritance that has already happened, so the checks below find the same
+	state.) */
 	if( xSemaphoreGive( xLocalMutex ) != pdPASS )
 	{
 		xErrorDetected = pdTRUE;
@@ -343,13 +343,28 @@ static void prvTakeAndGiveInTheOppositeOrder( void )
 		xErrorDetected = pdTRUE;
 	}
 
-	/* Should still be at the priority of the slave task as this task still
-	holds one semaphore (this is a simplification in the priority inheritance
-	mechanism. */
-	if( uxTaskPriorityGet( NULL ) != intsemSLAVE_PRIORITY )
+	#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 0 )
 	{
-		xErrorDetected = pdTRUE;
+		/* Should still be at the priority of the slave task as this task
+		still holds one semaphore (this is a simplification in the priority
+		inheritance mechanism. */
+		if( uxTaskPriorityGet( NULL ) != intsemSLAVE_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+	#else
+	{
+		/* With transitive priority inheritance the priority is recalculated
+		from the tasks waiting for the semaphores still held.  No task is
+		waiting for the ISR mutex, so the priority is disinherited straight
+		away. */
+		if( uxTaskPriorityGet( NULL ) != intsemMASTER_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
 	}
+	#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
 
 	/* Give back the ISR semaphore, which should result in the priority being
 	disinherited as it was the last mutex held. */
@@ -0,0 +1,680 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Compares async tasks with ordinary tasks, then checks that async tasks wait
+ * for queues, stream and message buffers, notifications and timeouts as
+ * documented.
+ *
+ * The comparison measures the heap used by each async task and each task, and
+ * the time taken to pass a token back and forth between two async tasks, and
+ * between two tasks, through a pair of queues.  Each pass includes switching
+ * from one to the other, which for async tasks is a function call made by the
+ * executor task rather than a context switch.
+ *
+ * The benchmark runs on the POSIX/Linux simulator port, so the absolute
+ * figures reflect the speed of the host.  The heap used by a task does not
+ * include the host thread the simulator creates for it.  Build and run it from
+ * this directory with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/tasks.c ../../Source/queue.c ../../Source/list.c
+ *     ../../Source/stream_buffer.c ../../Source/async.c
+ *     ../../Source/portable/MemMang/heap_4.c
+ *     ../../Source/portable/ThirdParty/GCC/Posix/port.c -lpthread -o async_benchmark
+ * ./async_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "async.h"
+
+/* The number of async tasks, and of tasks, created to measure the heap each
+uses. */
+#define mainASYNC_TASKS					( 1000 )
+#define mainTASKS						( 20 )
+
+/* The number of times the token is passed between the pair of async tasks, or
+tasks. */
+#define mainPING_PONG_PASSES			( 100000UL )
+
+/* The number of bytes sent through the stream buffer, and of messages sent
+through the message buffer. */
+#define mainSTREAM_BYTES				( 10000UL )
+#define mainMESSAGES					( 200UL )
+
+/* The timeout used when checking timeouts, and the number of notifications
+given from the tick hook. */
+#define mainTIMEOUT_TICKS				( ( TickType_t ) 20 )
+#define mainTICK_GIVES					( 10UL )
+
+/* The maximum number of ticks to wait for the executor to delete and free the
+async tasks that have ended. */
+#define mainMAX_FREE_TICKS				( ( TickType_t ) 10 )
+
+/* The executor, and the tasks it is compared with, have a priority below that
+of the control task, so they only run while the control task waits. */
+#define mainEXECUTOR_PRIORITY			( tskIDLE_PRIORITY + 2 )
+#define mainCONTROL_PRIORITY			( tskIDLE_PRIORITY + 3 )
+
+/*-----------------------------------------------------------*/
+
+/* The state of one end of a ping pong.  Async tasks keep their state in a
+structure like this, as local variables do not keep their values while an
+async task waits. */
+typedef struct
+{
+	QueueHandle_t xRxQueue;
+	QueueHandle_t xTxQueue;
+	uint32_t ulToken;
+	BaseType_t xResult;
+} PingPong_t;
+
+/* The state of the async tasks that check timeouts. */
+typedef struct
+{
+	QueueHandle_t xQueue;
+	TickType_t xStart;
+	TickType_t xElapsed;
+	uint32_t ulValue;
+	uint32_t ulItem;
+	BaseType_t xResult;
+} Timeout_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs each test in turn and prints the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * Measures the heap used by async tasks and by tasks, each of which waits to
+ * be notified and then ends.
+ */
+static void prvCompareMemory( AsyncExecutorHandle_t xExecutor );
+
+/*
+ * Passes a token mainPING_PONG_PASSES times between two async tasks run by
+ * xExecutor, or between two tasks if xExecutor is NULL.  Returns the time
+ * taken in nanoseconds.
+ */
+static double prvPingPong( AsyncExecutorHandle_t xExecutor );
+
+/*
+ * Checks async tasks that receive from a stream buffer and send to a message
+ * buffer, and that wait with timeouts.
+ */
+static void prvCheckStreamBuffers( AsyncExecutorHandle_t xExecutor );
+static void prvCheckTimeouts( AsyncExecutorHandle_t xExecutor );
+
+/*
+ * The async task functions used by the tests above.
+ */
+static void prvWaiterAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters );
+static void prvPingPongAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters );
+static void prvStreamReceiverAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters );
+static void prvMessageSenderAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters );
+static void prvTimeoutAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters );
+static void prvTickNotifiedAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters );
+
+/*
+ * The task functions the async task functions are compared with.
+ */
+static void prvWaiterTask( void *pvParameters );
+static void prvPingPongTask( void *pvParameters );
+
+/*
+ * Counts a completed job and notifies the control task when every job started
+ * by the test in progress has completed.
+ */
+static void prvJobDone( void );
+
+/*
+ * The time between two readings of the host's monotonic clock, in
+ * nanoseconds.
+ */
+static double prvElapsedNanoseconds( const struct timespec * const pxStart, const struct timespec * const pxEnd );
+
+/*-----------------------------------------------------------*/
+
+/* The number of jobs expected to complete, and completed so far, in the test
+in progress. */
+static volatile UBaseType_t uxJobsExpected = 0;
+static volatile UBaseType_t uxJobsDone = 0;
+
+static TaskHandle_t xControlTask = NULL;
+
+/* The async task notified by the tick hook, if any. */
+static volatile AsyncTaskHandle_t xTickNotifiedAsyncTask = NULL;
+
+/* The buffers used by prvCheckStreamBuffers(), and the sum of the bytes
+received from the stream buffer. */
+static StreamBufferHandle_t xStreamBuffer = NULL;
+static MessageBufferHandle_t xMessageBuffer = NULL;
+static volatile uint32_t ulBytesReceived = 0, ulSumReceived = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 2, NULL, mainCONTROL_PRIORITY, &xControlTask );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	/* Notify an async task from an interrupt once per tick.  The tick hook
+	cannot request a context switch itself, so passes NULL to have one held
+	pending instead. */
+	if( xTickNotifiedAsyncTask != NULL )
+	{
+		vAsyncTaskNotifyGiveFromISR( xTickNotifiedAsyncTask, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+AsyncExecutorHandle_t xExecutor;
+double dAsyncNs, dTaskNs;
+
+	( void ) pvParameters;
+
+	xExecutor = xAsyncExecutorCreate( "Executor", configMINIMAL_STACK_SIZE * 2, mainEXECUTOR_PRIORITY );
+	configASSERT( xExecutor );
+	configASSERT( xAsyncExecutorGetTaskHandle( xExecutor ) != NULL );
+
+	prvCompareMemory( xExecutor );
+
+	dAsyncNs = prvPingPong( xExecutor );
+	dTaskNs = prvPingPong( NULL );
+	printf( "\nns per token pass, %lu passes:\n", mainPING_PONG_PASSES );
+	printf( "   async tasks %10.0f\n", dAsyncNs / ( double ) mainPING_PONG_PASSES );
+	printf( "   tasks       %10.0f\n", dTaskNs / ( double ) mainPING_PONG_PASSES );
+
+	prvCheckStreamBuffers( xExecutor );
+	prvCheckTimeouts( xExecutor );
+
+	configASSERT( uxAsyncExecutorGetNumberOfTasks( xExecutor ) == 0 );
+	printf( "\nAll checks passed.\n" );
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvCompareMemory( AsyncExecutorHandle_t xExecutor )
+{
+static AsyncTaskHandle_t xAsyncTasks[ mainASYNC_TASKS ];
+static TaskHandle_t xTasks[ mainTASKS ];
+size_t xFreeBefore, xAsyncBytes, xTaskBytes;
+UBaseType_t x;
+TickType_t xTicks;
+
+	/* Async tasks. */
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	for( x = 0; x < mainASYNC_TASKS; x++ )
+	{
+		xAsyncTasks[ x ] = xAsyncTaskCreate( xExecutor, prvWaiterAsyncTask, NULL );
+		configASSERT( xAsyncTasks[ x ] );
+	}
+
+	xAsyncBytes = xFreeBefore - xPortGetFreeHeapSize();
+	configASSERT( uxAsyncExecutorGetNumberOfTasks( xExecutor ) == mainASYNC_TASKS );
+
+	/* Let every async task start to wait, then notify each in turn.  Each
+	ends, and so is deleted, once it has been notified. */
+	vTaskDelay( 1 );
+	uxJobsDone = 0;
+	uxJobsExpected = mainASYNC_TASKS;
+
+	for( x = 0; x < mainASYNC_TASKS; x++ )
+	{
+		( void ) xAsyncTaskNotifyGive( xAsyncTasks[ x ] );
+	}
+
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	/* The last async task to end woke this task before it returned, so the
+	executor might not have deleted and freed it yet. */
+	for( xTicks = 0; ( xTicks < mainMAX_FREE_TICKS ) && ( ( uxAsyncExecutorGetNumberOfTasks( xExecutor ) != 0 ) || ( xPortGetFreeHeapSize() != xFreeBefore ) ); xTicks++ )
+	{
+		vTaskDelay( 1 );
+	}
+
+	configASSERT( uxAsyncExecutorGetNumberOfTasks( xExecutor ) == 0 );
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+
+	/* Tasks. */
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	for( x = 0; x < mainTASKS; x++ )
+	{
+		configASSERT( xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, NULL, mainEXECUTOR_PRIORITY, &( xTasks[ x ] ) ) == pdPASS );
+	}
+
+	xTaskBytes = xFreeBefore - xPortGetFreeHeapSize();
+	vTaskDelay( 1 );
+	uxJobsDone = 0;
+	uxJobsExpected = mainTASKS;
+
+	for( x = 0; x < mainTASKS; x++ )
+	{
+		xTaskNotifyGive( xTasks[ x ] );
+	}
+
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	printf( "Heap bytes used by each:\n" );
+	printf( "   async task  %10lu (%d created)\n", ( unsigned long ) ( xAsyncBytes / mainASYNC_TASKS ), mainASYNC_TASKS );
+	printf( "   task        %10lu (%d created, stacks of %d words)\n", ( unsigned long ) ( xTaskBytes / mainTASKS ), mainTASKS, configMINIMAL_STACK_SIZE );
+}
+/*-----------------------------------------------------------*/
+
+static double prvPingPong( AsyncExecutorHandle_t xExecutor )
+{
+static PingPong_t xPing, xPong;
+QueueHandle_t xQueues[ 2 ];
+struct timespec xStart, xEnd;
+uint32_t ulToken = 0;
+
+	xQueues[ 0 ] = xQueueCreate( 1, sizeof( uint32_t ) );
+	xQueues[ 1 ] = xQueueCreate( 1, sizeof( uint32_t ) );
+	configASSERT( xQueues[ 0 ] );
+	configASSERT( xQueues[ 1 ] );
+
+	xPing.xRxQueue = xQueues[ 0 ];
+	xPing.xTxQueue = xQueues[ 1 ];
+	xPong.xRxQueue = xQueues[ 1 ];
+	xPong.xTxQueue = xQueues[ 0 ];
+	uxJobsDone = 0;
+	uxJobsExpected = 2;
+
+	if( xExecutor != NULL )
+	{
+		configASSERT( xAsyncTaskCreate( xExecutor, prvPingPongAsyncTask, &xPing ) );
+		configASSERT( xAsyncTaskCreate( xExecutor, prvPingPongAsyncTask, &xPong ) );
+	}
+	else
+	{
+		configASSERT( xTaskCreate( prvPingPongTask, "Ping", configMINIMAL_STACK_SIZE, &xPing, mainEXECUTOR_PRIORITY, NULL ) == pdPASS );
+		configASSERT( xTaskCreate( prvPingPongTask, "Pong", configMINIMAL_STACK_SIZE, &xPong, mainEXECUTOR_PRIORITY, NULL ) == pdPASS );
+	}
+
+	/* Start the ping pong by sending the first token. */
+	clock_gettime( CLOCK_MONOTONIC, &xStart );
+	( void ) xQueueSend( xQueues[ 0 ], &ulToken, portMAX_DELAY );
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	clock_gettime( CLOCK_MONOTONIC, &xEnd );
+
+	/* Let the tasks delete themselves before their queues are deleted. */
+	vTaskDelay( 1 );
+	vQueueDelete( xQueues[ 0 ] );
+	vQueueDelete( xQueues[ 1 ] );
+
+	return prvElapsedNanoseconds( &xStart, &xEnd );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckStreamBuffers( AsyncExecutorHandle_t xExecutor )
+{
+uint8_t ucChunk[ 37 ], ucMessage[ 16 ];
+uint32_t ulByte = 0, ulSumSent = 0, ulMessage;
+size_t xLength, xSent;
+
+	/* The buffers are small, so the async tasks wait for both data and
+	space. */
+	xStreamBuffer = xStreamBufferCreate( 64, 1 );
+	xMessageBuffer = xMessageBufferCreate( 32 );
+	configASSERT( xStreamBuffer );
+	configASSERT( xMessageBuffer );
+
+	uxJobsDone = 0;
+	uxJobsExpected = 1;
+	configASSERT( xAsyncTaskCreate( xExecutor, prvStreamReceiverAsyncTask, NULL ) );
+	configASSERT( xAsyncTaskCreate( xExecutor, prvMessageSenderAsyncTask, NULL ) );
+
+	/* Send the bytes to the stream buffer in chunks that do not match the
+	size of the receiver's buffer. */
+	while( ulByte < mainSTREAM_BYTES )
+	{
+		for( xLength = 0; ( xLength < sizeof( ucChunk ) ) && ( ulByte < mainSTREAM_BYTES ); xLength++, ulByte++ )
+		{
+			ucChunk[ xLength ] = ( uint8_t ) ( ulByte * 7 );
+			ulSumSent += ucChunk[ xLength ];
+		}
+
+		for( xSent = 0; xSent < xLength; )
+		{
+			xSent += xStreamBufferSend( xStreamBuffer, &( ucChunk[ xSent ] ), xLength - xSent, portMAX_DELAY );
+		}
+	}
+
+	/* Wait for the receiver to finish before receiving from the message
+	buffer, as both prvJobDone() and the message buffer use the control task's
+	notification. */
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	configASSERT( ulBytesReceived == mainSTREAM_BYTES );
+	configASSERT( ulSumReceived == ulSumSent );
+
+	/* Receive the messages, each of which holds its own number followed by
+	as many bytes as the number modulo 8. */
+	for( ulMessage = 0; ulMessage < mainMESSAGES; ulMessage++ )
+	{
+		xLength = xMessageBufferReceive( xMessageBuffer, ucMessage, sizeof( ucMessage ), portMAX_DELAY );
+		configASSERT( xLength == sizeof( uint32_t ) + ( ulMessage % 8 ) );
+		configASSERT( *( ( uint32_t * ) ucMessage ) == ulMessage );
+	}
+
+	vTaskDelay( 1 );
+	vStreamBufferDelete( xStreamBuffer );
+	vMessageBufferDelete( xMessageBuffer );
+
+	printf( "\nAsync tasks received %lu bytes from a stream buffer and sent %lu messages to a message buffer.\n", ( unsigned long ) ulBytesReceived, ( unsigned long ) mainMESSAGES );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTimeouts( AsyncExecutorHandle_t xExecutor )
+{
+static Timeout_t xTimeout;
+AsyncTaskHandle_t xAsyncTask;
+TickType_t xStart;
+uint32_t ulItem = 0;
+
+	xTimeout.xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+	configASSERT( xTimeout.xQueue );
+
+	/* An async task that waits for an empty queue, a notification, a delay
+	and a full queue, each of which times out. */
+	uxJobsDone = 0;
+	uxJobsExpected = 1;
+	configASSERT( xAsyncTaskCreate( xExecutor, prvTimeoutAsyncTask, &xTimeout ) );
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	/* An async task that is notified from the tick hook. */
+	uxJobsDone = 0;
+	uxJobsExpected = 1;
+	xStart = xTaskGetTickCount();
+	xAsyncTask = xAsyncTaskCreate( xExecutor, prvTickNotifiedAsyncTask, NULL );
+	configASSERT( xAsyncTask );
+	xTickNotifiedAsyncTask = xAsyncTask;
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	xTickNotifiedAsyncTask = NULL;
+	configASSERT( ( TickType_t ) ( xTaskGetTickCount() - xStart ) >= ( TickType_t ) ( mainTICK_GIVES - 1 ) );
+
+	/* An async task that is deleted while it waits indefinitely for a full
+	queue.  It must no longer be waiting once deleted, so the queue can be
+	deleted. */
+	( void ) xQueueSend( xTimeout.xQueue, &ulItem, 0 );
+	xAsyncTask = xAsyncTaskCreate( xExecutor, prvTimeoutAsyncTask, &xTimeout );
+	configASSERT( xAsyncTask );
+	vTaskDelay( 1 );
+	configASSERT( uxAsyncExecutorGetNumberOfTasks( xExecutor ) == 1 );
+	vAsyncTaskDelete( xAsyncTask );
+	configASSERT( uxAsyncExecutorGetNumberOfTasks( xExecutor ) == 0 );
+	vQueueDelete( xTimeout.xQueue );
+
+	printf( "\nAsync task waits timed out after %lu ticks, for a timeout of %lu ticks.\n", ( unsigned long ) xTimeout.xElapsed, ( unsigned long ) mainTIMEOUT_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters )
+{
+/* Can be shared by every async task, as it is only read straight after it is
+written. */
+static uint32_t ulValue;
+
+	( void ) pvParameters;
+
+	asyncBEGIN( xAsyncTask );
+
+	asyncNOTIFY_TAKE( xAsyncTask, pdTRUE, portMAX_DELAY, &ulValue );
+	configASSERT( ulValue == 1 );
+	prvJobDone();
+
+	asyncEND( xAsyncTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingPongAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters )
+{
+PingPong_t * const pxPingPong = ( PingPong_t * ) pvParameters;
+
+	asyncBEGIN( xAsyncTask );
+
+	for( ;; )
+	{
+		asyncQUEUE_RECEIVE( xAsyncTask, pxPingPong->xRxQueue, &( pxPingPong->ulToken ), portMAX_DELAY, &( pxPingPong->xResult ) );
+		configASSERT( pxPingPong->xResult == pdPASS );
+
+		if( pxPingPong->ulToken >= mainPING_PONG_PASSES )
+		{
+			break;
+		}
+
+		( pxPingPong->ulToken )++;
+		asyncQUEUE_SEND( xAsyncTask, pxPingPong->xTxQueue, &( pxPingPong->ulToken ), portMAX_DELAY, &( pxPingPong->xResult ) );
+		configASSERT( pxPingPong->xResult == pdPASS );
+
+		if( pxPingPong->ulToken >= mainPING_PONG_PASSES )
+		{
+			break;
+		}
+	}
+
+	prvJobDone();
+
+	asyncEND( xAsyncTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamReceiverAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters )
+{
+static uint8_t ucBuffer[ 16 ];
+static size_t xReceived;
+size_t x;
+
+	( void ) pvParameters;
+
+	asyncBEGIN( xAsyncTask );
+
+	ulBytesReceived = 0;
+	ulSumReceived = 0;
+
+	while( ulBytesReceived < mainSTREAM_BYTES )
+	{
+		asyncSTREAM_BUFFER_RECEIVE( xAsyncTask, xStreamBuffer, ucBuffer, sizeof( ucBuffer ), portMAX_DELAY, &xReceived );
+
+		for( x = 0; x < xReceived; x++ )
+		{
+			configASSERT( ucBuffer[ x ] == ( uint8_t ) ( ulBytesReceived * 7 ) );
+			ulSumReceived += ucBuffer[ x ];
+			ulBytesReceived++;
+		}
+	}
+
+	prvJobDone();
+
+	asyncEND( xAsyncTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMessageSenderAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters )
+{
+static uint8_t ucMessage[ 16 ];
+static uint32_t ulMessage;
+static size_t xSent;
+
+	( void ) pvParameters;
+
+	asyncBEGIN( xAsyncTask );
+
+	for( ulMessage = 0; ulMessage < mainMESSAGES; ulMessage++ )
+	{
+		*( ( uint32_t * ) ucMessage ) = ulMessage;
+		asyncSTREAM_BUFFER_SEND( xAsyncTask, xMessageBuffer, ucMessage, sizeof( uint32_t ) + ( ulMessage % 8 ), portMAX_DELAY, &xSent );
+		configASSERT( xSent == sizeof( uint32_t ) + ( ulMessage % 8 ) );
+	}
+
+	asyncEND( xAsyncTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimeoutAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters )
+{
+Timeout_t * const pxTimeout = ( Timeout_t * ) pvParameters;
+
+	asyncBEGIN( xAsyncTask );
+
+	if( uxQueueMessagesWaiting( pxTimeout->xQueue ) != 0 )
+	{
+		/* Created to be deleted while it waits for space. */
+		asyncQUEUE_SEND( xAsyncTask, pxTimeout->xQueue, &( pxTimeout->ulItem ), portMAX_DELAY, &( pxTimeout->xResult ) );
+		configASSERT( pdFALSE );
+	}
+
+	pxTimeout->xStart = xTaskGetTickCount();
+	asyncQUEUE_RECEIVE( xAsyncTask, pxTimeout->xQueue, &( pxTimeout->ulItem ), mainTIMEOUT_TICKS, &( pxTimeout->xResult ) );
+	pxTimeout->xElapsed = xTaskGetTickCount() - pxTimeout->xStart;
+	configASSERT( pxTimeout->xResult == errQUEUE_EMPTY );
+	configASSERT( pxTimeout->xElapsed >= mainTIMEOUT_TICKS );
+
+	pxTimeout->xStart = xTaskGetTickCount();
+	asyncNOTIFY_TAKE( xAsyncTask, pdFALSE, mainTIMEOUT_TICKS, &( pxTimeout->ulValue ) );
+	configASSERT( pxTimeout->ulValue == 0 );
+	configASSERT( ( TickType_t ) ( xTaskGetTickCount() - pxTimeout->xStart ) >= mainTIMEOUT_TICKS );
+
+	pxTimeout->xStart = xTaskGetTickCount();
+	asyncDELAY( xAsyncTask, mainTIMEOUT_TICKS );
+	configASSERT( ( TickType_t ) ( xTaskGetTickCount() - pxTimeout->xStart ) >= mainTIMEOUT_TICKS );
+
+	/* Fill the queue, then time out waiting for space. */
+	asyncQUEUE_SEND( xAsyncTask, pxTimeout->xQueue, &( pxTimeout->ulItem ), 0, &( pxTimeout->xResult ) );
+	configASSERT( pxTimeout->xResult == pdPASS );
+	asyncQUEUE_SEND( xAsyncTask, pxTimeout->xQueue, &( pxTimeout->ulItem ), mainTIMEOUT_TICKS, &( pxTimeout->xResult ) );
+	configASSERT( pxTimeout->xResult == errQUEUE_FULL );
+
+	prvJobDone();
+
+	asyncEND( xAsyncTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickNotifiedAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters )
+{
+static uint32_t ulGives, ulValue;
+
+	( void ) pvParameters;
+
+	asyncBEGIN( xAsyncTask );
+
+	for( ulGives = 0; ulGives < mainTICK_GIVES; )
+	{
+		asyncNOTIFY_TAKE( xAsyncTask, pdFALSE, portMAX_DELAY, &ulValue );
+		configASSERT( ulValue > 0 );
+		ulGives++;
+	}
+
+	prvJobDone();
+
+	asyncEND( xAsyncTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	prvJobDone();
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingPongTask( void *pvParameters )
+{
+PingPong_t * const pxPingPong = ( PingPong_t * ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xQueueReceive( pxPingPong->xRxQueue, &( pxPingPong->ulToken ), portMAX_DELAY );
+
+		if( pxPingPong->ulToken >= mainPING_PONG_PASSES )
+		{
+			break;
+		}
+
+		( pxPingPong->ulToken )++;
+		( void ) xQueueSend( pxPingPong->xTxQueue, &( pxPingPong->ulToken ), portMAX_DELAY );
+
+		if( pxPingPong->ulToken >= mainPING_PONG_PASSES )
+		{
+			break;
+		}
+	}
+
+	prvJobDone();
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvJobDone( void )
+{
+BaseType_t xLastJob;
+
+	taskENTER_CRITICAL();
+	{
+		uxJobsDone++;
+		xLastJob = ( uxJobsDone == uxJobsExpected ) ? pdTRUE : pdFALSE;
+	}
+	taskEXIT_CRITICAL();
+
+	if( xLastJob != pdFALSE )
+	{
+		xTaskNotifyGive( xControlTask );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static double prvElapsedNanoseconds( const struct timespec * const pxStart, const struct timespec * const pxEnd )
+{
+	return ( ( double ) ( pxEnd->tv_sec - pxStart->tv_sec ) * 1e9 ) + ( double ) ( pxEnd->tv_nsec - pxStart->tv_nsec );
+}
+/*-----------------------------------------------------------*/
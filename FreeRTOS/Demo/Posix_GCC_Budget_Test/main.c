@@ -0,0 +1,416 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Checks that a task with a budget that uses the eBudgetDemote action is
+ * demoted when it exhausts its budget and has its priority restored when its
+ * budget is replenished, including while it holds a mutex and so may be using
+ * an inherited priority.
+ *
+ * A worker task runs without ever blocking, so it uses its whole budget in
+ * every replenish period.  A control task, which has the highest priority,
+ * gives the worker a budget, then watches the worker's priority and budget
+ * status while it commands the worker to take and give a mutex, and commands
+ * two waiter tasks, one with a priority above the worker's and one with a
+ * priority between the worker's and the priority the worker is demoted to, to
+ * take the mutex.  It checks that:
+ *
+ * + The worker is demoted when it exhausts its budget, and its priority is
+ *   restored when its budget is replenished.
+ * + A worker that exhausts its budget while using a priority inherited from
+ *   the higher priority waiter keeps the inherited priority, and is demoted
+ *   when it gives the mutex.
+ * + A demoted worker inherits the priority of a waiter whose priority is above
+ *   the demoted priority, and has its own priority restored when its budget
+ *   is replenished if that is higher than the inherited priority.  The waiter
+ *   then only runs once the worker has given the mutex and been demoted again.
+ * + A demoted worker that uses a priority inherited from the higher priority
+ *   waiter keeps the inherited priority when its budget is replenished, and
+ *   has its own priority restored when it gives the mutex.
+ *
+ * The test runs on the POSIX/Linux simulator port.  Build and run it from this
+ * directory with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/tasks.c ../../Source/queue.c ../../Source/list.c
+ *     ../../Source/portable/MemMang/heap_4.c
+ *     ../../Source/portable/ThirdParty/GCC/Posix/port.c -lpthread -o budget_test
+ * ./budget_test
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* The priorities of the tasks.  The worker is demoted to mainDEMOTED_PRIORITY
+when it exhausts its budget. */
+#define mainDEMOTED_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainMID_PRIORITY				( tskIDLE_PRIORITY + 2 )
+#define mainWORKER_PRIORITY				( tskIDLE_PRIORITY + 3 )
+#define mainHIGH_PRIORITY				( tskIDLE_PRIORITY + 4 )
+#define mainCONTROL_PRIORITY			( tskIDLE_PRIORITY + 5 )
+
+/* The worker's budget, in run time counter counts (microseconds), and the
+period at which it is replenished. */
+#define mainBUDGET						( 20000UL )
+#define mainREPLENISH_TICKS				pdMS_TO_TICKS( 100 )
+
+/* The commands the control task sends to the worker. */
+#define mainTAKE_MUTEX					( 1UL )
+#define mainGIVE_MUTEX					( 2UL )
+
+/* The time the control task leaves the other tasks to run after each command,
+and after a budget is replenished. */
+#define mainSETTLE_TICKS				pdMS_TO_TICKS( 2 )
+
+/*-----------------------------------------------------------*/
+
+/* A task that takes the mutex when commanded to, and the number of commands
+it has completed. */
+typedef struct HELPER
+{
+	TaskHandle_t xTask;
+	volatile uint32_t ulCommand;		/* The last command sent to the task.  Only used by the worker. */
+	volatile UBaseType_t uxCompleted;	/* The number of commands the task has completed. */
+	volatile UBaseType_t uxSent;		/* The number of commands sent to the task. */
+} Helper_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs each check in turn.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * Runs the checks of the demotion and restoration of a worker that does not
+ * hold a mutex.
+ */
+static void prvCheckDemotion( void );
+
+/*
+ * Runs the checks of the demotion and restoration of a worker that holds a
+ * mutex.
+ */
+static void prvCheckInheritance( void );
+
+/*
+ * The worker task.  It never blocks, other than to take the mutex when
+ * commanded to, so it exhausts its budget in every replenish period.
+ */
+static void prvWorkerTask( void *pvParameters );
+
+/*
+ * The waiter tasks.  Each takes, then immediately gives, the mutex each time
+ * it is notified.
+ */
+static void prvWaiterTask( void *pvParameters );
+
+/*
+ * Send ulCommand to the worker, then leave the other tasks time to run.
+ */
+static void prvCommandWorker( uint32_t ulCommand );
+
+/*
+ * Command a waiter to take the mutex, then leave the other tasks time to run.
+ */
+static void prvCommandWaiter( Helper_t *pxWaiter );
+
+/*
+ * Returns pdTRUE if the task has completed every command sent to it, so is not
+ * waiting for the mutex.
+ */
+static BaseType_t prvCompleted( const Helper_t *pxHelper );
+
+/*
+ * Wait for the worker to exhaust its budget, or for its budget to be
+ * replenished, then leave the other tasks time to run.
+ */
+static void prvWaitForExhaustion( void );
+static void prvWaitForReplenishment( void );
+
+/*-----------------------------------------------------------*/
+
+/* The mutex the worker and waiters take. */
+static SemaphoreHandle_t xMutex = NULL;
+
+/* The worker and the waiter tasks. */
+static Helper_t xWorker, xMidWaiter, xHighWaiter;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xMutex = xSemaphoreCreateMutex();
+	configASSERT( xMutex );
+
+	xTaskCreate( prvWorkerTask, "Worker", configMINIMAL_STACK_SIZE, &xWorker, mainWORKER_PRIORITY, &( xWorker.xTask ) );
+	xTaskCreate( prvWaiterTask, "Mid", configMINIMAL_STACK_SIZE, &xMidWaiter, mainMID_PRIORITY, &( xMidWaiter.xTask ) );
+	xTaskCreate( prvWaiterTask, "High", configMINIMAL_STACK_SIZE, &xHighWaiter, mainHIGH_PRIORITY, &( xHighWaiter.xTask ) );
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 2, NULL, mainCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+TaskBudgetStatus_t xStatus;
+
+	( void ) pvParameters;
+
+	vTaskSetBudget( xWorker.xTask, mainBUDGET, mainREPLENISH_TICKS, eBudgetDemote, mainDEMOTED_PRIORITY );
+
+	prvCheckDemotion();
+	printf( "Demotion checks passed.\n" );
+
+	prvCheckInheritance();
+	printf( "Inherited priority checks passed.\n" );
+
+	/* The worker exhausted its budget once in each replenish period the
+	checks waited for. */
+	vTaskGetBudgetStatus( xWorker.xTask, &xStatus );
+	configASSERT( xStatus.uxExhaustedCount == 4 );
+
+	printf( "\nAll checks passed.\n" );
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckDemotion( void )
+{
+TaskBudgetStatus_t xStatus;
+
+	/* The worker runs at its own priority until it exhausts its budget. */
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainWORKER_PRIORITY );
+
+	prvWaitForExhaustion();
+	vTaskGetBudgetStatus( xWorker.xTask, &xStatus );
+	configASSERT( xStatus.uxExhaustedCount == 1 );
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainDEMOTED_PRIORITY );
+
+	/* Its priority is restored when its budget is replenished, and it is
+	demoted again when it exhausts the replenished budget. */
+	prvWaitForReplenishment();
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainWORKER_PRIORITY );
+
+	prvWaitForExhaustion();
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainDEMOTED_PRIORITY );
+
+	prvWaitForReplenishment();
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainWORKER_PRIORITY );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckInheritance( void )
+{
+	/* The worker has just had its budget replenished.  It takes the mutex, and
+	inherits the priority of the higher priority waiter. */
+	prvCommandWorker( mainTAKE_MUTEX );
+	configASSERT( prvCompleted( &xWorker ) );
+	prvCommandWaiter( &xHighWaiter );
+	configASSERT( prvCompleted( &xHighWaiter ) == pdFALSE );
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainHIGH_PRIORITY );
+
+	/* Exhausting its budget does not remove the inherited priority, but the
+	worker is demoted as soon as it gives the mutex. */
+	prvWaitForExhaustion();
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainHIGH_PRIORITY );
+	prvCommandWorker( mainGIVE_MUTEX );
+	configASSERT( prvCompleted( &xHighWaiter ) );
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainDEMOTED_PRIORITY );
+
+	/* The demoted worker takes the mutex, and inherits the priority of a
+	waiter that has a priority between its demoted priority and its own
+	priority. */
+	prvCommandWorker( mainTAKE_MUTEX );
+	configASSERT( prvCompleted( &xWorker ) );
+	prvCommandWaiter( &xMidWaiter );
+	configASSERT( prvCompleted( &xMidWaiter ) == pdFALSE );
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainMID_PRIORITY );
+
+	/* The worker's own priority is higher than the inherited priority, so is
+	used once its budget is replenished. */
+	prvWaitForReplenishment();
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainWORKER_PRIORITY );
+	configASSERT( prvCompleted( &xMidWaiter ) == pdFALSE );
+
+	/* The waiter has a lower priority than the worker, so only runs once the
+	worker has given the mutex and been demoted again. */
+	prvCommandWorker( mainGIVE_MUTEX );
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainWORKER_PRIORITY );
+	configASSERT( prvCompleted( &xMidWaiter ) == pdFALSE );
+	prvWaitForExhaustion();
+	configASSERT( prvCompleted( &xMidWaiter ) );
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainDEMOTED_PRIORITY );
+
+	/* The demoted worker takes the mutex again, and inherits the priority of
+	the higher priority waiter. */
+	prvCommandWorker( mainTAKE_MUTEX );
+	configASSERT( prvCompleted( &xWorker ) );
+	prvCommandWaiter( &xHighWaiter );
+	configASSERT( prvCompleted( &xHighWaiter ) == pdFALSE );
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainHIGH_PRIORITY );
+
+	/* The inherited priority is higher than the worker's own priority, so is
+	kept when its budget is replenished, until the worker gives the mutex. */
+	prvWaitForReplenishment();
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainHIGH_PRIORITY );
+	prvCommandWorker( mainGIVE_MUTEX );
+	configASSERT( prvCompleted( &xHighWaiter ) );
+	configASSERT( uxTaskPriorityGet( xWorker.xTask ) == mainWORKER_PRIORITY );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+Helper_t *pxWorker = ( Helper_t * ) pvParameters;
+
+	for( ;; )
+	{
+		/* Spin, using the processor, until a command is sent. */
+		if( pxWorker->uxCompleted != pxWorker->uxSent )
+		{
+			if( pxWorker->ulCommand == mainTAKE_MUTEX )
+			{
+				configASSERT( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+			}
+			else
+			{
+				configASSERT( xSemaphoreGive( xMutex ) == pdPASS );
+			}
+
+			pxWorker->uxCompleted++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+Helper_t *pxWaiter = ( Helper_t * ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+		configASSERT( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+		configASSERT( xSemaphoreGive( xMutex ) == pdPASS );
+		pxWaiter->uxCompleted++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCommandWorker( uint32_t ulCommand )
+{
+	xWorker.ulCommand = ulCommand;
+	xWorker.uxSent++;
+	vTaskDelay( mainSETTLE_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCommandWaiter( Helper_t *pxWaiter )
+{
+	pxWaiter->uxSent++;
+	xTaskNotifyGive( pxWaiter->xTask );
+	vTaskDelay( mainSETTLE_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCompleted( const Helper_t *pxHelper )
+{
+BaseType_t xReturn;
+
+	if( pxHelper->uxCompleted == pxHelper->uxSent )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForExhaustion( void )
+{
+TaskBudgetStatus_t xStatus;
+const TickType_t xStart = xTaskGetTickCount();
+
+	/* The worker uses its whole budget in every replenish period, so exhausts
+	it before the period ends. */
+	for( ;; )
+	{
+		vTaskGetBudgetStatus( xWorker.xTask, &xStatus );
+
+		if( xStatus.xExhausted != pdFALSE )
+		{
+			break;
+		}
+
+		configASSERT( ( TickType_t ) ( xTaskGetTickCount() - xStart ) <= mainREPLENISH_TICKS );
+		vTaskDelay( 1 );
+	}
+
+	vTaskDelay( mainSETTLE_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForReplenishment( void )
+{
+TaskBudgetStatus_t xStatus;
+TickType_t xTicksToWait;
+
+	vTaskGetBudgetStatus( xWorker.xTask, &xStatus );
+	configASSERT( xStatus.xExhausted != pdFALSE );
+
+	xTicksToWait = xStatus.xNextReplenishTime - xTaskGetTickCount();
+	configASSERT( xTicksToWait <= mainREPLENISH_TICKS );
+	vTaskDelay( xTicksToWait + mainSETTLE_TICKS );
+
+	vTaskGetBudgetStatus( xWorker.xTask, &xStatus );
+	configASSERT( xStatus.xExhausted == pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulGetRunTimeCounterValue( void )
+{
+struct timespec xNow;
+
+	/* Microseconds of the host's monotonic clock. */
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( unsigned long ) ( ( xNow.tv_sec * 1000000L ) + ( xNow.tv_nsec / 1000L ) );
+}
+/*-----------------------------------------------------------*/
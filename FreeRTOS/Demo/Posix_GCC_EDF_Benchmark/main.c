@@ -0,0 +1,258 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Compares the deadlines met by two periodic tasks when they are scheduled
+ * with fixed priorities and when they are scheduled earliest deadline first.
+ *
+ * The short task executes for 2 ticks every 5 ticks and the long task for 4
+ * ticks every 7 ticks.  Each job has to complete before the next job of the
+ * same task is released.  Together the tasks use 97.1% of the processor, which
+ * is more than fixed priorities can guarantee for two tasks (82.8%) but not
+ * more than earliest deadline first scheduling can guarantee (100%).
+ *
+ * With fixed priorities the tasks are given rate monotonic priorities, so the
+ * short task has the higher priority, and the long task misses one deadline in
+ * every five.  With earliest deadline first scheduling the tasks are created
+ * with xTaskCreateDeadline() and no deadlines are missed.
+ *
+ * The tick hook charges each tick to the task that was running when it
+ * occurred, and a job executes until it has been charged its execution time,
+ * so the results do not depend on how fast the host is.  The host does not
+ * always deliver ticks on time though, and a tick delivered late can be
+ * charged to a task that has already completed its job, leaving too little
+ * time for the jobs that follow.  A few more deadlines than expected are then
+ * missed with either scheduler.
+ *
+ * Each task runs the jobs released in the first 7000 ticks, then the number of
+ * deadlines each missed is printed.  With earliest deadline first scheduling
+ * the number counted by the kernel, returned by uxTaskGetDeadlineMisses(), is
+ * printed too.
+ *
+ * The benchmark runs on the POSIX/Linux simulator port.  Build and run it from
+ * this directory with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/tasks.c ../../Source/queue.c ../../Source/list.c
+ *     ../../Source/portable/MemMang/heap_4.c
+ *     ../../Source/portable/ThirdParty/GCC/Posix/port.c -lpthread -o edf_benchmark
+ * ./edf_benchmark
+ *
+ * then again adding -DconfigUSE_EDF_SCHEDULING=1 to the gcc command line.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The priorities used with fixed priority scheduling.  The control task only
+runs once both periodic tasks have finished. */
+#define mainCONTROL_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainLONG_PRIORITY				( tskIDLE_PRIORITY + 2 )
+#define mainSHORT_PRIORITY				( tskIDLE_PRIORITY + 3 )
+
+/* The number of ticks over which jobs are released.  It is a multiple of the
+period of both tasks. */
+#define mainRUN_TICKS					( 7000 )
+
+/* The number of periodic tasks. */
+#define mainTASKS						( 2 )
+
+/*-----------------------------------------------------------*/
+
+/* A periodic task, and the deadlines met by its jobs. */
+typedef struct PERIODIC_TASK
+{
+	const char *pcName;
+	TickType_t xExecutionTicks;			/* The number of ticks each job executes for. */
+	TickType_t xPeriod;					/* The number of ticks between releases, which is also the relative deadline. */
+	UBaseType_t uxPriority;				/* The priority used with fixed priority scheduling. */
+	TaskHandle_t xTask;
+	volatile TickType_t xChargedTicks;	/* The number of ticks charged to the task by the tick hook. */
+	volatile TickType_t xLastCharged;	/* The tick count when a tick was last charged to the task. */
+	UBaseType_t uxJobs;
+	UBaseType_t uxMisses;
+} PeriodicTask_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Waits for the periodic tasks to finish, then prints the number of deadlines
+ * they missed.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * The periodic tasks.  Each runs the jobs released in the first mainRUN_TICKS
+ * ticks, counting those that miss their deadline, then suspends itself.
+ */
+static void prvPeriodicTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The periodic tasks. */
+static PeriodicTask_t xPeriodicTasks[ mainTASKS ] =
+{
+	{ "Short", 2, 5, mainSHORT_PRIORITY, NULL, 0, 0, 0, 0 },
+	{ "Long", 4, 7, mainLONG_PRIORITY, NULL, 0, 0, 0, 0 }
+};
+
+/* The task that prints the results. */
+static TaskHandle_t xControlTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t x;
+
+	for( x = 0; x < mainTASKS; x++ )
+	{
+		#if( configUSE_EDF_SCHEDULING == 1 )
+		{
+			xTaskCreateDeadline( prvPeriodicTask, xPeriodicTasks[ x ].pcName, configMINIMAL_STACK_SIZE, &( xPeriodicTasks[ x ] ), xPeriodicTasks[ x ].xPeriod, xPeriodicTasks[ x ].xPeriod, &( xPeriodicTasks[ x ].xTask ) );
+		}
+		#else
+		{
+			xTaskCreate( prvPeriodicTask, xPeriodicTasks[ x ].pcName, configMINIMAL_STACK_SIZE, &( xPeriodicTasks[ x ] ), xPeriodicTasks[ x ].uxPriority, &( xPeriodicTasks[ x ].xTask ) );
+		}
+		#endif
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 2, NULL, mainCONTROL_PRIORITY, &xControlTask );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t x, uxPermille = 0;
+PeriodicTask_t *pxTask;
+
+	( void ) pvParameters;
+
+	/* Each periodic task notifies this task when it has finished. */
+	for( x = 0; x < mainTASKS; x++ )
+	{
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+		uxPermille += ( UBaseType_t ) ( ( xPeriodicTasks[ x ].xExecutionTicks * 1000UL ) / xPeriodicTasks[ x ].xPeriod );
+	}
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		printf( "Earliest deadline first scheduling, %u.%u%% utilisation:\n", ( unsigned ) ( uxPermille / 10 ), ( unsigned ) ( uxPermille % 10 ) );
+	}
+	#else
+	{
+		printf( "Fixed priority scheduling, %u.%u%% utilisation:\n", ( unsigned ) ( uxPermille / 10 ), ( unsigned ) ( uxPermille % 10 ) );
+	}
+	#endif
+
+	for( x = 0; x < mainTASKS; x++ )
+	{
+		pxTask = &( xPeriodicTasks[ x ] );
+		printf( "  %-5s C=%u P=%u: %u of %u deadlines missed", pxTask->pcName, ( unsigned ) pxTask->xExecutionTicks, ( unsigned ) pxTask->xPeriod, ( unsigned ) pxTask->uxMisses, ( unsigned ) pxTask->uxJobs );
+
+		#if( configUSE_EDF_SCHEDULING == 1 )
+		{
+			printf( " (%u counted by the kernel)", ( unsigned ) uxTaskGetDeadlineMisses( pxTask->xTask ) );
+		}
+		#endif
+
+		printf( "\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void *pvParameters )
+{
+PeriodicTask_t *pxTask = ( PeriodicTask_t * ) pvParameters;
+TickType_t xRelease, xCharged;
+
+	/* The tasks are created before the scheduler is started, so the first job
+	of each is released at time 0. */
+	xRelease = 0;
+
+	while( xRelease < ( TickType_t ) mainRUN_TICKS )
+	{
+		/* Execute until the job has been charged its execution time. */
+		xCharged = pxTask->xChargedTicks;
+
+		while( ( TickType_t ) ( pxTask->xChargedTicks - xCharged ) < pxTask->xExecutionTicks )
+		{
+		}
+
+		/* The job completed when the last of its ticks was charged.  The task
+		might not have run since if a job of the other task was released at
+		the same time. */
+		if( ( TickType_t ) ( pxTask->xLastCharged - xRelease ) > pxTask->xPeriod )
+		{
+			( pxTask->uxMisses )++;
+		}
+
+		( pxTask->uxJobs )++;
+
+		#if( configUSE_EDF_SCHEDULING == 1 )
+		{
+			vTaskWaitForNextPeriod();
+			xRelease += pxTask->xPeriod;
+		}
+		#else
+		{
+			vTaskDelayUntil( &xRelease, pxTask->xPeriod );
+		}
+		#endif
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+TaskHandle_t xRunning = xTaskGetCurrentTaskHandle();
+UBaseType_t x;
+
+	/* Charge the tick to the task that was running when it occurred. */
+	for( x = 0; x < mainTASKS; x++ )
+	{
+		if( xPeriodicTasks[ x ].xTask == xRunning )
+		{
+			xPeriodicTasks[ x ].xLastCharged = xTaskGetTickCountFromISR();
+			( xPeriodicTasks[ x ].xChargedTicks )++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,202 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Checks heap_6.c with a pseudo random mix of allocations and frees that are
+ * mostly small, so most blocks come from the linearly divided small free lists
+ * and, if configHEAP_CACHE_DEPTH is above 0, the caches.  Occasional larger
+ * allocations leave free blocks of sizes that are not a multiple of the small
+ * block granularity.
+ *
+ * Every allocation is checked to be correctly aligned, then filled with a
+ * pattern that is checked again when the allocation is freed, so an
+ * allocation that overlaps another, or is smaller than requested, is
+ * detected.  Once everything has been freed the free heap size is checked to
+ * be the same as it was at the start.
+ *
+ * The test does not create any tasks, so it runs before the scheduler is
+ * started.  That means it can be built with a portBYTE_ALIGNMENT smaller than
+ * the POSIX/Linux simulator port needs to run tasks, to test the alignment
+ * used by smaller targets.  Build and run it from this directory with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/tasks.c ../../Source/list.c
+ *     ../../Source/portable/MemMang/heap_6.c
+ *     ../../Source/portable/ThirdParty/GCC/Posix/port.c -lpthread -o heap6_test
+ * ./heap6_test
+ *
+ * adding -DportBYTE_ALIGNMENT=4 (or 2) to the gcc command line to test an
+ * alignment below the size of the small block granularity, and
+ * -DconfigHEAP_CACHE_DEPTH=4 to test the caches.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The number of allocations that can exist at once. */
+#define mainSLOTS						( 64 )
+
+/* The number of times a slot is chosen at random and the allocation in it is
+freed, or an allocation made if the slot is empty. */
+#define mainITERATIONS					( 500000UL )
+
+/* Most allocations request between 1 and mainMAX_SMALL_SIZE bytes.  One in
+mainLARGE_RATIO requests between mainMAX_SMALL_SIZE + 1 and mainMAX_LARGE_SIZE
+bytes. */
+#define mainMAX_SMALL_SIZE				( 120UL )
+#define mainMAX_LARGE_SIZE				( 700UL )
+#define mainLARGE_RATIO					( 16UL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Make an allocation in slot xSlot, check its alignment, and fill it with the
+ * pattern for its serial number.
+ */
+static void prvAllocate( size_t xSlot );
+
+/*
+ * Check the pattern in the allocation in slot xSlot is intact, then free it.
+ */
+static void prvFree( size_t xSlot );
+
+/*
+ * A simple pseudo random number generator, so every run uses the same
+ * sequence of allocations.
+ */
+static uint32_t prvRand( void );
+
+/*-----------------------------------------------------------*/
+
+/* The allocations that exist, the number of bytes requested for each, and the
+serial number used to generate the pattern in each. */
+static uint8_t *pucAllocations[ mainSLOTS ];
+static size_t xAllocationSizes[ mainSLOTS ];
+static uint8_t ucSerials[ mainSLOTS ];
+
+/* The serial number given to the next allocation. */
+static uint8_t ucNextSerial = 0U;
+
+/* The state of the pseudo random number generator. */
+static uint32_t ulRandomSeed = 1UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+size_t xSlot, xStartFreeSize;
+uint32_t ulIteration;
+
+	printf( "portBYTE_ALIGNMENT %d, configHEAP_CACHE_DEPTH %d.\n", portBYTE_ALIGNMENT, configHEAP_CACHE_DEPTH );
+
+	/* The heap is initialised by the first allocation. */
+	vPortFree( pvPortMalloc( 1 ) );
+	xStartFreeSize = xPortGetFreeHeapSize();
+
+	for( ulIteration = 0; ulIteration < mainITERATIONS; ulIteration++ )
+	{
+		xSlot = ( size_t ) ( prvRand() % mainSLOTS );
+
+		if( pucAllocations[ xSlot ] == NULL )
+		{
+			prvAllocate( xSlot );
+		}
+		else
+		{
+			prvFree( xSlot );
+		}
+	}
+
+	for( xSlot = 0; xSlot < mainSLOTS; xSlot++ )
+	{
+		if( pucAllocations[ xSlot ] != NULL )
+		{
+			prvFree( xSlot );
+		}
+	}
+
+	configASSERT( xPortGetFreeHeapSize() == xStartFreeSize );
+
+	printf( "%lu allocations and frees passed, minimum ever free heap %lu of %lu bytes.\n",
+			( unsigned long ) mainITERATIONS,
+			( unsigned long ) xPortGetMinimumEverFreeHeapSize(),
+			( unsigned long ) xStartFreeSize );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAllocate( size_t xSlot )
+{
+size_t xSize;
+
+	if( ( prvRand() % mainLARGE_RATIO ) == 0UL )
+	{
+		xSize = ( size_t ) ( mainMAX_SMALL_SIZE + 1UL + ( prvRand() % ( mainMAX_LARGE_SIZE - mainMAX_SMALL_SIZE ) ) );
+	}
+	else
+	{
+		xSize = ( size_t ) ( 1UL + ( prvRand() % mainMAX_SMALL_SIZE ) );
+	}
+
+	pucAllocations[ xSlot ] = ( uint8_t * ) pvPortMalloc( xSize );
+	configASSERT( pucAllocations[ xSlot ] != NULL );
+	configASSERT( ( ( ( size_t ) pucAllocations[ xSlot ] ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+
+	xAllocationSizes[ xSlot ] = xSize;
+	ucSerials[ xSlot ] = ucNextSerial;
+	ucNextSerial++;
+
+	memset( pucAllocations[ xSlot ], ucSerials[ xSlot ], xSize );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFree( size_t xSlot )
+{
+size_t x;
+
+	for( x = 0; x < xAllocationSizes[ xSlot ]; x++ )
+	{
+		configASSERT( pucAllocations[ xSlot ][ x ] == ucSerials[ xSlot ] );
+	}
+
+	vPortFree( pucAllocations[ xSlot ] );
+	pucAllocations[ xSlot ] = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+	ulRandomSeed = ( ulRandomSeed * 1103515245UL ) + 12345UL;
+	return ( ulRandomSeed >> 8 ) & 0xffffffUL;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,436 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Checks that priority inheritance follows chains of tasks that are each
+ * blocked on a mutex held by the next, as enabled by setting
+ * configUSE_TRANSITIVE_PRIORITY_INHERITANCE to 1, and shows that doing so
+ * bounds the time a high priority task can be blocked by lower priority tasks.
+ *
+ * The chain test creates task C, which takes mutex 1 and waits for a
+ * notification, then task B, which takes mutex 0 then blocks on mutex 1, then
+ * task A, which blocks on mutex 0 with a timeout.  While A is blocked both B
+ * and C must run at A's priority, as C must complete for B to be able to
+ * complete.  When A times out B must return to its base priority, while C must
+ * keep the priority it inherited from B.
+ *
+ * The stress test then runs a number of low priority tasks that repeatedly
+ * take a random run of mutexes, in index order so they cannot deadlock,
+ * holding each for a few ticks of processing, and one high priority task that
+ * does the same while recording the longest time it has been blocked waiting
+ * for a mutex.  A medium priority task repeatedly uses the processor for much
+ * longer than any mutex is held.  Without transitive priority inheritance a low
+ * priority task at the end of a chain is starved by the medium priority task
+ * while the high priority task waits at the other end of the chain.  With it,
+ * every task along the chain runs at the high priority, so the high priority
+ * task is only ever blocked while each low priority task completes at most one
+ * run of mutexes.  Every task also checks that it is back at its base priority
+ * whenever it holds no mutexes.
+ *
+ * The test runs on the POSIX/Linux simulator port.  Build and run it from this
+ * directory with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/tasks.c ../../Source/queue.c ../../Source/list.c
+ *     ../../Source/portable/MemMang/heap_4.c
+ *     ../../Source/portable/ThirdParty/GCC/Posix/port.c -lpthread -o inheritance_stress
+ * ./inheritance_stress
+ *
+ * adding -DconfigUSE_TRANSITIVE_PRIORITY_INHERITANCE=0 to the gcc command line
+ * to see the results without transitive priority inheritance.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* The number of mutexes shared by the tasks. */
+#define mainNUM_MUTEXES					( 4 )
+
+/* Priorities of the tasks used by the chain test. */
+#define mainTASK_C_PRIORITY				( tskIDLE_PRIORITY + 1 )
+#define mainTASK_B_PRIORITY				( tskIDLE_PRIORITY + 2 )
+#define mainTASK_A_PRIORITY				( tskIDLE_PRIORITY + 5 )
+
+/* How long task A waits for mutex 0 in the chain test, and how long after A
+blocks the priorities of B and C are checked. */
+#define mainCHAIN_TIMEOUT				( ( TickType_t ) 20 )
+#define mainCHAIN_CHECK_DELAY			( ( TickType_t ) 5 )
+
+/* The number of low priority tasks in the stress test, the priority of the
+first, and the priorities of the medium and high priority tasks.  The low
+priority tasks are given increasing priorities below the medium priority. */
+#define mainNUM_LOW_PRIORITY_TASKS		( 4 )
+#define mainLOW_PRIORITY				( tskIDLE_PRIORITY + 1 )
+#define mainMEDIUM_PRIORITY				( tskIDLE_PRIORITY + 4 )
+#define mainHIGH_PRIORITY				( tskIDLE_PRIORITY + 5 )
+
+/* The control task runs above every other task so it can check their
+priorities. */
+#define mainCONTROL_PRIORITY			( tskIDLE_PRIORITY + 6 )
+
+/* Each run of mutexes taken in the stress test is between 1 and
+mainMAX_NESTING mutexes long, each of which is held for mainHOLD_TICKS ticks of
+processing before the next is taken. */
+#define mainMAX_NESTING					( 3 )
+#define mainHOLD_TICKS					( ( TickType_t ) 2 )
+
+/* The medium priority task uses the processor for mainHOG_TICKS ticks then
+blocks for mainHOG_DELAY ticks. */
+#define mainHOG_TICKS					( ( TickType_t ) 100 )
+#define mainHOG_DELAY					( ( TickType_t ) 50 )
+
+/* After each run of mutexes a low priority task blocks for up to
+mainLOW_PRIORITY_DELAY - 1 ticks, and the high priority task for up to
+mainHIGH_PRIORITY_DELAY - 1 ticks, so the low priority tasks have time to build
+chains of blocked mutex holders between the high priority task's runs. */
+#define mainLOW_PRIORITY_DELAY			( 3UL )
+#define mainHIGH_PRIORITY_DELAY			( 20UL )
+
+/* How long the stress test runs for. */
+#define mainSTRESS_TEST_TICKS			pdMS_TO_TICKS( 5000 )
+
+/* The longest the high priority task should be blocked - while each low
+priority task completes at most one run of mutexes.  Processing is measured in
+ticks, so each mutex can be held for up to one tick longer than mainHOLD_TICKS,
+and one extra tick is allowed for the time to take the mutex to be measured. */
+#define mainBLOCKING_BOUND				( ( TickType_t ) ( mainNUM_LOW_PRIORITY_TASKS * mainMAX_NESTING * ( mainHOLD_TICKS + 1 ) ) + 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the chain test then the stress test, and prints the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * The tasks used by the chain test.
+ */
+static void prvChainTaskA( void *pvParameters );
+static void prvChainTaskB( void *pvParameters );
+static void prvChainTaskC( void *pvParameters );
+
+/*
+ * The tasks used by the stress test.  The parameter of a task that takes
+ * mutexes is the number of the task, where task mainNUM_LOW_PRIORITY_TASKS is
+ * the high priority task.
+ */
+static void prvMutexTask( void *pvParameters );
+static void prvHogTask( void *pvParameters );
+
+/*
+ * Use the processor until xTicks tick interrupts have occurred while the
+ * calling task was running.  A task that is preempted sees at most one tick
+ * interrupt over the time it is not running.
+ */
+static void prvUseProcessor( TickType_t xTicks );
+
+/*
+ * A simple pseudo random number generator, so every run uses the same
+ * sequence of mutexes in each task.
+ */
+static uint32_t prvRand( uint32_t *pulState );
+
+/*-----------------------------------------------------------*/
+
+/* The mutexes shared by the tasks. */
+static SemaphoreHandle_t xMutexes[ mainNUM_MUTEXES ];
+
+/* The control task, notified as each task finishes. */
+static TaskHandle_t xControlTask = NULL;
+
+/* The result of task A's attempt to take mutex 0 in the chain test. */
+static volatile BaseType_t xChainTakeResult = pdFALSE;
+
+/* The tick count at which the stress test ends. */
+static TickType_t xStressTestEnd = 0;
+
+/* The longest time each task that takes mutexes was blocked waiting for a
+mutex, the number of runs of mutexes it took, and the number of times a task
+was found not to be at its base priority when it held no mutexes. */
+static TickType_t xLongestBlockTime[ mainNUM_LOW_PRIORITY_TASKS + 1 ];
+static uint32_t ulRuns[ mainNUM_LOW_PRIORITY_TASKS + 1 ];
+static volatile uint32_t ulPriorityErrors = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t x;
+
+	for( x = 0; x < mainNUM_MUTEXES; x++ )
+	{
+		xMutexes[ x ] = xSemaphoreCreateMutex();
+		configASSERT( xMutexes[ x ] );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 2, NULL, mainCONTROL_PRIORITY, &xControlTask );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+TaskHandle_t xTaskA, xTaskB, xTaskC;
+UBaseType_t uxWaitingPriorityB, uxWaitingPriorityC, uxTimedOutPriorityB, uxTimedOutPriorityC;
+UBaseType_t x, uxTasks;
+BaseType_t xChainPassed, xStressPassed;
+
+	( void ) pvParameters;
+
+	printf( "transitive priority inheritance %s\n\n", ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) ? "on" : "off" );
+
+	/* The chain test.  Each task is created then allowed to run until it
+	blocks, so C holds mutex 1 and B holds mutex 0 and waits for mutex 1 before
+	A blocks on mutex 0. */
+	xTaskCreate( prvChainTaskC, "C", configMINIMAL_STACK_SIZE, NULL, mainTASK_C_PRIORITY, &xTaskC );
+	vTaskDelay( 1 );
+	xTaskCreate( prvChainTaskB, "B", configMINIMAL_STACK_SIZE, NULL, mainTASK_B_PRIORITY, &xTaskB );
+	vTaskDelay( 1 );
+	xTaskCreate( prvChainTaskA, "A", configMINIMAL_STACK_SIZE, NULL, mainTASK_A_PRIORITY, &xTaskA );
+
+	vTaskDelay( mainCHAIN_CHECK_DELAY );
+	uxWaitingPriorityB = uxTaskPriorityGet( xTaskB );
+	uxWaitingPriorityC = uxTaskPriorityGet( xTaskC );
+
+	/* Wait for A to time out and finish. */
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	uxTimedOutPriorityB = uxTaskPriorityGet( xTaskB );
+	uxTimedOutPriorityC = uxTaskPriorityGet( xTaskC );
+
+	/* Let C give mutex 1 back, then wait for B and C to finish. */
+	xTaskNotifyGive( xTaskC );
+	for( x = 0; x < 2; x++ )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+
+	xChainPassed = ( ( xChainTakeResult == pdFALSE ) &&
+					 ( uxWaitingPriorityB == mainTASK_A_PRIORITY ) &&
+					 ( uxWaitingPriorityC == mainTASK_A_PRIORITY ) &&
+					 ( uxTimedOutPriorityB == mainTASK_B_PRIORITY ) &&
+					 ( uxTimedOutPriorityC == mainTASK_B_PRIORITY ) );
+
+	printf( "chain test: priority of B and C while A waits %lu %lu (expected %lu %lu), after A times out %lu %lu (expected %lu %lu) - %s\n\n",
+			( unsigned long ) uxWaitingPriorityB, ( unsigned long ) uxWaitingPriorityC,
+			( unsigned long ) mainTASK_A_PRIORITY, ( unsigned long ) mainTASK_A_PRIORITY,
+			( unsigned long ) uxTimedOutPriorityB, ( unsigned long ) uxTimedOutPriorityC,
+			( unsigned long ) mainTASK_B_PRIORITY, ( unsigned long ) mainTASK_B_PRIORITY,
+			( xChainPassed != pdFALSE ) ? "PASS" : "FAIL" );
+
+	/* The stress test. */
+	xStressTestEnd = xTaskGetTickCount() + mainSTRESS_TEST_TICKS;
+
+	for( x = 0; x < mainNUM_LOW_PRIORITY_TASKS; x++ )
+	{
+		xTaskCreate( prvMutexTask, "Low", configMINIMAL_STACK_SIZE, ( void * ) x, mainLOW_PRIORITY + ( x / 2 ), NULL );
+	}
+
+	xTaskCreate( prvMutexTask, "High", configMINIMAL_STACK_SIZE, ( void * ) x, mainHIGH_PRIORITY, NULL );
+	xTaskCreate( prvHogTask, "Hog", configMINIMAL_STACK_SIZE, NULL, mainMEDIUM_PRIORITY, NULL );
+	uxTasks = mainNUM_LOW_PRIORITY_TASKS + 2;
+
+	for( x = 0; x < uxTasks; x++ )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+
+	printf( "stress test: task  priority  runs  longest block (ticks)\n" );
+	for( x = 0; x <= mainNUM_LOW_PRIORITY_TASKS; x++ )
+	{
+		printf( "             %4lu  %8lu  %4lu  %lu\n",
+				( unsigned long ) x,
+				( unsigned long ) ( ( x < mainNUM_LOW_PRIORITY_TASKS ) ? ( mainLOW_PRIORITY + ( x / 2 ) ) : mainHIGH_PRIORITY ),
+				( unsigned long ) ulRuns[ x ],
+				( unsigned long ) xLongestBlockTime[ x ] );
+	}
+
+	xStressPassed = ( ( xLongestBlockTime[ mainNUM_LOW_PRIORITY_TASKS ] <= mainBLOCKING_BOUND ) && ( ulPriorityErrors == 0 ) );
+
+	printf( "high priority task blocked for at most %lu ticks (bound %lu), %lu priority errors - %s\n",
+			( unsigned long ) xLongestBlockTime[ mainNUM_LOW_PRIORITY_TASKS ],
+			( unsigned long ) mainBLOCKING_BOUND,
+			( unsigned long ) ulPriorityErrors,
+			( xStressPassed != pdFALSE ) ? "PASS" : "FAIL" );
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainTaskA( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	/* Blocks on mutex 0, which is held by B, which is blocked on mutex 1,
+	which is held by C. */
+	xChainTakeResult = xSemaphoreTake( xMutexes[ 0 ], mainCHAIN_TIMEOUT );
+
+	if( xChainTakeResult != pdFALSE )
+	{
+		( void ) xSemaphoreGive( xMutexes[ 0 ] );
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainTaskB( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	( void ) xSemaphoreTake( xMutexes[ 0 ], portMAX_DELAY );
+	( void ) xSemaphoreTake( xMutexes[ 1 ], portMAX_DELAY );
+	( void ) xSemaphoreGive( xMutexes[ 1 ] );
+	( void ) xSemaphoreGive( xMutexes[ 0 ] );
+
+	if( uxTaskPriorityGet( NULL ) != mainTASK_B_PRIORITY )
+	{
+		ulPriorityErrors++;
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainTaskC( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	( void ) xSemaphoreTake( xMutexes[ 1 ], portMAX_DELAY );
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	( void ) xSemaphoreGive( xMutexes[ 1 ] );
+
+	if( uxTaskPriorityGet( NULL ) != mainTASK_C_PRIORITY )
+	{
+		ulPriorityErrors++;
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexTask( void *pvParameters )
+{
+const UBaseType_t uxTask = ( UBaseType_t ) pvParameters;
+const UBaseType_t uxBasePriority = uxTaskPriorityGet( NULL );
+uint32_t ulRandomState = ( uint32_t ) uxTask + 1UL;
+UBaseType_t uxFirst, uxCount, x;
+TickType_t xTimeBeforeTake, xBlockTime;
+
+	while( ( TickType_t ) ( xStressTestEnd - xTaskGetTickCount() ) <= mainSTRESS_TEST_TICKS )
+	{
+		uxFirst = ( UBaseType_t ) ( prvRand( &ulRandomState ) % mainNUM_MUTEXES );
+		uxCount = ( UBaseType_t ) ( prvRand( &ulRandomState ) % mainMAX_NESTING ) + 1;
+
+		if( ( uxFirst + uxCount ) > mainNUM_MUTEXES )
+		{
+			uxCount = mainNUM_MUTEXES - uxFirst;
+		}
+
+		/* Mutexes are always taken in index order, so the tasks cannot
+		deadlock. */
+		for( x = uxFirst; x < ( uxFirst + uxCount ); x++ )
+		{
+			xTimeBeforeTake = xTaskGetTickCount();
+			( void ) xSemaphoreTake( xMutexes[ x ], portMAX_DELAY );
+			xBlockTime = xTaskGetTickCount() - xTimeBeforeTake;
+
+			if( xBlockTime > xLongestBlockTime[ uxTask ] )
+			{
+				xLongestBlockTime[ uxTask ] = xBlockTime;
+			}
+
+			prvUseProcessor( mainHOLD_TICKS );
+		}
+
+		for( x = uxFirst + uxCount; x > uxFirst; x-- )
+		{
+			( void ) xSemaphoreGive( xMutexes[ x - 1 ] );
+		}
+
+		/* No mutexes are held, so no priority can be inherited. */
+		if( uxTaskPriorityGet( NULL ) != uxBasePriority )
+		{
+			ulPriorityErrors++;
+		}
+
+		ulRuns[ uxTask ]++;
+		vTaskDelay( ( TickType_t ) ( prvRand( &ulRandomState ) % ( ( uxTask < mainNUM_LOW_PRIORITY_TASKS ) ? mainLOW_PRIORITY_DELAY : mainHIGH_PRIORITY_DELAY ) ) );
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHogTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	while( ( TickType_t ) ( xStressTestEnd - xTaskGetTickCount() ) <= mainSTRESS_TEST_TICKS )
+	{
+		prvUseProcessor( mainHOG_TICKS );
+		vTaskDelay( mainHOG_DELAY );
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUseProcessor( TickType_t xTicks )
+{
+TickType_t xLastTickCount = xTaskGetTickCount(), xTickCount, xTicksSeen = 0;
+
+	while( xTicksSeen < xTicks )
+	{
+		xTickCount = xTaskGetTickCount();
+
+		if( xTickCount != xLastTickCount )
+		{
+			xLastTickCount = xTickCount;
+			xTicksSeen++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( uint32_t *pulState )
+{
+	*pulState = ( *pulState * 1103515245UL ) + 12345UL;
+	return ( *pulState >> 16 ) & 0x7fffUL;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,376 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Measures the throughput of multi-producer, multi-consumer (MPMC) message
+ * buffers, created using xMessageBufferCreateMPMC(), against the alternative
+ * of sharing an ordinary message buffer between several tasks by guarding its
+ * send end with one mutex and its receive end with another.
+ *
+ * For each combination of producer and consumer task counts, the producers
+ * send a fixed number of messages between them and the consumers receive them.
+ * Every message carries the number of the producer that sent it, a sequence
+ * number and a checksum, which the consumers check.  The time taken for all the
+ * messages to be received is reported as messages per second, along with the
+ * number of kernel ticks that elapsed.
+ *
+ * The benchmark runs on the POSIX/Linux simulator port, where each task is a
+ * host thread and only one runs at a time, so the absolute figures reflect the
+ * cost of context switching on the host.  The ratio between the two methods is
+ * the figure of interest.
+ *
+ * Build and run from this directory with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/tasks.c ../../Source/queue.c ../../Source/list.c
+ *     ../../Source/stream_buffer.c ../../Source/portable/MemMang/heap_4.c
+ *     ../../Source/portable/ThirdParty/GCC/Posix/port.c -lpthread -o mpmc_benchmark
+ * ./mpmc_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "message_buffer.h"
+
+/* The number of messages sent in each test, and the size of each message. */
+#define mainMESSAGES_PER_TEST			( 120000UL )
+#define mainMESSAGE_DATA_BYTES			( 24 )
+
+/* The size of the message buffer, in messages. */
+#define mainBUFFER_LENGTH_MESSAGES		( 16 )
+
+/* The maximum number of producer or consumer tasks in a test. */
+#define mainMAX_TASKS					( 4 )
+
+/* Priorities at which the tasks are created.  The control task has the highest
+priority so it can create all the tasks in a test before any of them run. */
+#define mainPRODUCER_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainCONSUMER_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainCONTROL_PRIORITY			( tskIDLE_PRIORITY + 3 )
+
+/* How long a consumer waits for a message before checking whether all the
+messages have been received. */
+#define mainRECEIVE_TIMEOUT				pdMS_TO_TICKS( 20 )
+
+/*-----------------------------------------------------------*/
+
+/* The messages passed from the producers to the consumers. */
+typedef struct MESSAGE
+{
+	uint32_t ulProducer;
+	uint32_t ulSequence;
+	uint32_t ulChecksum;
+	uint8_t ucData[ mainMESSAGE_DATA_BYTES ];
+} Message_t;
+
+/* Describes one test. */
+typedef struct TEST
+{
+	UBaseType_t uxProducers;
+	UBaseType_t uxConsumers;
+	BaseType_t xUseMPMC;
+} Test_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The tasks that send and receive messages.  The parameter is the number of the
+ * producer or consumer.
+ */
+static void prvProducerTask( void *pvParameters );
+static void prvConsumerTask( void *pvParameters );
+
+/*
+ * Creates the tasks for each test in turn, waits for them to finish, and
+ * prints the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * Send a message to, or receive a message from, the message buffer under test,
+ * using whichever method the test uses to share the message buffer.
+ */
+static void prvSend( const Message_t * const pxMessage );
+static size_t prvReceive( Message_t * const pxMessage );
+
+/*
+ * Calculate the checksum sent with each message.
+ */
+static uint32_t prvChecksum( const Message_t * const pxMessage );
+
+/*-----------------------------------------------------------*/
+
+/* The message buffer used by the test in progress, and the mutexes that guard
+it when it is not an MPMC message buffer. */
+static MessageBufferHandle_t xMessageBuffer = NULL;
+static SemaphoreHandle_t xSendMutex = NULL, xReceiveMutex = NULL;
+static BaseType_t xUseMPMC = pdFALSE;
+
+/* The number of messages each producer sends in the test in progress, the
+number of messages sent in total, the number of messages received so far, and
+the number of errors detected. */
+static uint32_t ulMessagesPerProducer = 0;
+static uint32_t ulMessagesExpected = 0;
+static volatile uint32_t ulMessagesReceived = 0;
+static volatile uint32_t ulErrors = 0;
+
+/* The task notified as each producer and consumer finishes. */
+static TaskHandle_t xControlTask = NULL;
+
+static const Test_t xTests[] =
+{
+	{ 1, 1, pdFALSE }, { 1, 1, pdTRUE },
+	{ 2, 2, pdFALSE }, { 2, 2, pdTRUE },
+	{ 4, 1, pdFALSE }, { 4, 1, pdTRUE },
+	{ 1, 4, pdFALSE }, { 1, 4, pdTRUE },
+	{ 4, 4, pdFALSE }, { 4, 4, pdTRUE }
+};
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 2, NULL, mainCONTROL_PRIORITY, &xControlTask );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+const size_t xBufferSizeBytes = mainBUFFER_LENGTH_MESSAGES * ( sizeof( Message_t ) + sizeof( size_t ) );
+struct timespec xStart, xEnd;
+TickType_t xStartTicks, xTicks;
+UBaseType_t x, uxTask;
+double dSeconds;
+
+	( void ) pvParameters;
+
+	printf( "%lu messages of %lu bytes per test, message buffer holds %lu messages.\n\n",
+			( unsigned long ) mainMESSAGES_PER_TEST, ( unsigned long ) sizeof( Message_t ), ( unsigned long ) mainBUFFER_LENGTH_MESSAGES );
+	printf( "producers consumers  method              messages/s     ticks  errors\n" );
+
+	for( x = 0; x < ( sizeof( xTests ) / sizeof( xTests[ 0 ] ) ); x++ )
+	{
+		xUseMPMC = xTests[ x ].xUseMPMC;
+		ulMessagesPerProducer = mainMESSAGES_PER_TEST / ( uint32_t ) xTests[ x ].uxProducers;
+		ulMessagesExpected = ulMessagesPerProducer * ( uint32_t ) xTests[ x ].uxProducers;
+		ulMessagesReceived = 0;
+		ulErrors = 0;
+
+		if( xUseMPMC != pdFALSE )
+		{
+			xMessageBuffer = xMessageBufferCreateMPMC( xBufferSizeBytes );
+		}
+		else
+		{
+			xMessageBuffer = xMessageBufferCreate( xBufferSizeBytes );
+			xSendMutex = xSemaphoreCreateMutex();
+			xReceiveMutex = xSemaphoreCreateMutex();
+			configASSERT( xSendMutex );
+			configASSERT( xReceiveMutex );
+		}
+
+		configASSERT( xMessageBuffer );
+
+		/* The tasks do not run until this task blocks. */
+		for( uxTask = 0; uxTask < xTests[ x ].uxConsumers; uxTask++ )
+		{
+			xTaskCreate( prvConsumerTask, "Cons", configMINIMAL_STACK_SIZE, ( void * ) uxTask, mainCONSUMER_PRIORITY, NULL );
+		}
+
+		for( uxTask = 0; uxTask < xTests[ x ].uxProducers; uxTask++ )
+		{
+			xTaskCreate( prvProducerTask, "Prod", configMINIMAL_STACK_SIZE, ( void * ) uxTask, mainPRODUCER_PRIORITY, NULL );
+		}
+
+		clock_gettime( CLOCK_MONOTONIC, &xStart );
+		xStartTicks = xTaskGetTickCount();
+
+		/* Each task notifies this task when it has finished. */
+		for( uxTask = 0; uxTask < ( xTests[ x ].uxProducers + xTests[ x ].uxConsumers ); uxTask++ )
+		{
+			( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+		}
+
+		clock_gettime( CLOCK_MONOTONIC, &xEnd );
+		xTicks = xTaskGetTickCount() - xStartTicks;
+
+		/* Let the idle task free the memory of the deleted tasks. */
+		vTaskDelay( pdMS_TO_TICKS( 10 ) );
+
+		if( ulMessagesReceived != ulMessagesExpected )
+		{
+			ulErrors++;
+		}
+
+		dSeconds = ( double ) ( xEnd.tv_sec - xStart.tv_sec ) + ( ( double ) ( xEnd.tv_nsec - xStart.tv_nsec ) / 1e9 );
+		printf( "%9lu %9lu  %-18s %11.0f %9lu %7lu\n",
+				( unsigned long ) xTests[ x ].uxProducers,
+				( unsigned long ) xTests[ x ].uxConsumers,
+				( xUseMPMC != pdFALSE ) ? "MPMC" : "mutex guarded",
+				( double ) ulMessagesReceived / dSeconds,
+				( unsigned long ) xTicks,
+				( unsigned long ) ulErrors );
+
+		vMessageBufferDelete( xMessageBuffer );
+
+		if( xUseMPMC == pdFALSE )
+		{
+			vSemaphoreDelete( xSendMutex );
+			vSemaphoreDelete( xReceiveMutex );
+		}
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void *pvParameters )
+{
+Message_t xMessage;
+uint32_t ulSequence;
+size_t x;
+
+	xMessage.ulProducer = ( uint32_t ) ( UBaseType_t ) pvParameters;
+
+	for( ulSequence = 0; ulSequence < ulMessagesPerProducer; ulSequence++ )
+	{
+		xMessage.ulSequence = ulSequence;
+
+		for( x = 0; x < mainMESSAGE_DATA_BYTES; x++ )
+		{
+			xMessage.ucData[ x ] = ( uint8_t ) ( ulSequence + x );
+		}
+
+		xMessage.ulChecksum = prvChecksum( &xMessage );
+		prvSend( &xMessage );
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+Message_t xMessage;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( prvReceive( &xMessage ) == sizeof( Message_t ) )
+		{
+			if( xMessage.ulChecksum != prvChecksum( &xMessage ) )
+			{
+				ulErrors++;
+			}
+
+			taskENTER_CRITICAL();
+			{
+				ulMessagesReceived++;
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			/* Timed out.  Finished if every message has been received. */
+			if( ulMessagesReceived >= ulMessagesExpected )
+			{
+				break;
+			}
+		}
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSend( const Message_t * const pxMessage )
+{
+	if( xUseMPMC != pdFALSE )
+	{
+		( void ) xMessageBufferSend( xMessageBuffer, pxMessage, sizeof( Message_t ), portMAX_DELAY );
+	}
+	else
+	{
+		/* Only one task at a time can use each end of an ordinary message
+		buffer. */
+		( void ) xSemaphoreTake( xSendMutex, portMAX_DELAY );
+		( void ) xMessageBufferSend( xMessageBuffer, pxMessage, sizeof( Message_t ), portMAX_DELAY );
+		( void ) xSemaphoreGive( xSendMutex );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReceive( Message_t * const pxMessage )
+{
+size_t xReceived = 0;
+
+	if( xUseMPMC != pdFALSE )
+	{
+		xReceived = xMessageBufferReceive( xMessageBuffer, pxMessage, sizeof( Message_t ), mainRECEIVE_TIMEOUT );
+	}
+	else
+	{
+		if( xSemaphoreTake( xReceiveMutex, mainRECEIVE_TIMEOUT ) != pdFALSE )
+		{
+			xReceived = xMessageBufferReceive( xMessageBuffer, pxMessage, sizeof( Message_t ), mainRECEIVE_TIMEOUT );
+			( void ) xSemaphoreGive( xReceiveMutex );
+		}
+	}
+
+	return xReceived;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvChecksum( const Message_t * const pxMessage )
+{
+uint32_t ulChecksum;
+size_t x;
+
+	ulChecksum = ( pxMessage->ulProducer << 24 ) ^ pxMessage->ulSequence;
+
+	for( x = 0; x < mainMESSAGE_DATA_BYTES; x++ )
+	{
+		ulChecksum = ( ulChecksum * 31UL ) + pxMessage->ucData[ x ];
+	}
+
+	return ulChecksum;
+}
+/*-----------------------------------------------------------*/
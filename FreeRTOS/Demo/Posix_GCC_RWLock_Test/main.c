@@ -0,0 +1,370 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Checks reader-writer locks created with each policy, the timeout used when
+ * taking a lock, and the priority inheritance performed for the task that
+ * holds a lock for writing.
+ *
+ * A control task, which has the highest priority, commands helper tasks to
+ * take and give a lock, leaving them time to run after each command before it
+ * checks which of them hold the lock and which are still waiting for it.  For
+ * each policy it checks that:
+ *
+ * + Any number of tasks can hold the lock for reading at the same time.
+ * + A task cannot take the lock for writing while it is held for reading, so
+ *   its attempt times out, and the tasks that hold the lock for reading do not
+ *   inherit its priority.
+ * + While a writer is waiting, another reader can take the lock if readers are
+ *   preferred, but has to wait if writers are preferred.
+ * + The waiting writer takes the lock once every reader has given it - before
+ *   the waiting reader if writers are preferred, even though the reader has
+ *   the higher priority.
+ *
+ * It then checks that the task that holds the lock for writing inherits the
+ * priority of a higher priority task that waits to take the lock for writing,
+ * until the higher priority task times out, and of one that waits to take it
+ * for reading, until the lock is given.
+ *
+ * The test runs on the POSIX/Linux simulator port.  Build and run it from this
+ * directory with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/tasks.c ../../Source/queue.c ../../Source/list.c
+ *     ../../Source/rwlock.c ../../Source/portable/MemMang/heap_4.c
+ *     ../../Source/portable/ThirdParty/GCC/Posix/port.c -lpthread -o rwlock_test
+ * ./rwlock_test
+ *
+ * adding -DconfigUSE_TRANSITIVE_PRIORITY_INHERITANCE=1 to the gcc command line
+ * to run the checks with transitive priority inheritance.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+/* The priorities of the tasks.  The writer has a lower priority than the
+readers, so the policies can be seen to unblock it before them. */
+#define mainWRITER_PRIORITY				( tskIDLE_PRIORITY + 1 )
+#define mainREADER_PRIORITY				( tskIDLE_PRIORITY + 2 )
+#define mainHIGH_PRIORITY				( tskIDLE_PRIORITY + 3 )
+#define mainCONTROL_PRIORITY			( tskIDLE_PRIORITY + 4 )
+
+/* The number of reader tasks. */
+#define mainREADERS						( 3 )
+
+/* The commands the control task sends to the helper tasks. */
+#define mainTAKE_READ					( 1UL )
+#define mainGIVE_READ					( 2UL )
+#define mainTAKE_WRITE					( 3UL )
+#define mainGIVE_WRITE					( 4UL )
+
+/* The time the control task leaves the helper tasks to run after each
+command. */
+#define mainSETTLE_TICKS				pdMS_TO_TICKS( 5 )
+
+/* The timeout used by the attempts to take a lock that are expected to time
+out, and the much longer timeout used by those that are not. */
+#define mainTIMEOUT_TICKS				pdMS_TO_TICKS( 20 )
+#define mainBLOCK_TICKS					pdMS_TO_TICKS( 1000 )
+
+/*-----------------------------------------------------------*/
+
+/* A task that takes and gives the lock when commanded to, and the result of
+the last command it completed. */
+typedef struct HELPER
+{
+	TaskHandle_t xTask;
+	volatile BaseType_t xResult;
+	volatile UBaseType_t uxCompleted;	/* The number of commands the task has completed. */
+	UBaseType_t uxSent;					/* The number of commands sent to the task. */
+} Helper_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs each check in turn.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * Runs the checks of a lock created with policy ePolicy.
+ */
+static void prvCheckPolicy( eRWLockPolicy ePolicy );
+
+/*
+ * Runs the checks of the priority inheritance performed for the task that
+ * holds a lock for writing.
+ */
+static void prvCheckInheritance( void );
+
+/*
+ * The helper tasks.  Each performs the commands sent to it by the control
+ * task on xLock.
+ */
+static void prvHelperTask( void *pvParameters );
+
+/*
+ * Send ulCommand to a helper task, then leave the helper tasks time to run.
+ */
+static void prvCommand( Helper_t *pxHelper, uint32_t ulCommand );
+
+/*
+ * Returns pdTRUE if the helper task has completed every command sent to it,
+ * so is not waiting for the lock.
+ */
+static BaseType_t prvCompleted( const Helper_t *pxHelper );
+
+/*-----------------------------------------------------------*/
+
+/* The lock being checked. */
+static RWLockHandle_t xLock = NULL;
+
+/* The timeout the helper tasks use when they take the lock. */
+static volatile TickType_t xHelperTicksToWait = mainBLOCK_TICKS;
+
+/* The helper tasks. */
+static Helper_t xReaders[ mainREADERS ], xWriter, xHigh;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t x;
+
+	for( x = 0; x < mainREADERS; x++ )
+	{
+		xTaskCreate( prvHelperTask, "Reader", configMINIMAL_STACK_SIZE, &( xReaders[ x ] ), mainREADER_PRIORITY, &( xReaders[ x ].xTask ) );
+	}
+
+	xTaskCreate( prvHelperTask, "Writer", configMINIMAL_STACK_SIZE, &xWriter, mainWRITER_PRIORITY, &( xWriter.xTask ) );
+	xTaskCreate( prvHelperTask, "High", configMINIMAL_STACK_SIZE, &xHigh, mainHIGH_PRIORITY, &( xHigh.xTask ) );
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 2, NULL, mainCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	prvCheckPolicy( eRWLockPreferReaders );
+	printf( "Prefer readers policy checks passed.\n" );
+
+	prvCheckPolicy( eRWLockPreferWriters );
+	printf( "Prefer writers policy checks passed.\n" );
+
+	prvCheckInheritance();
+	printf( "Writer priority inheritance checks passed.\n" );
+
+	printf( "\nAll checks passed.\n" );
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckPolicy( eRWLockPolicy ePolicy )
+{
+TickType_t xStart;
+
+	xLock = xRWLockCreate( ePolicy );
+	configASSERT( xLock );
+
+	/* Two tasks hold the lock for reading at the same time. */
+	prvCommand( &( xReaders[ 0 ] ), mainTAKE_READ );
+	prvCommand( &( xReaders[ 1 ] ), mainTAKE_READ );
+	configASSERT( prvCompleted( &( xReaders[ 0 ] ) ) && ( xReaders[ 0 ].xResult == pdPASS ) );
+	configASSERT( prvCompleted( &( xReaders[ 1 ] ) ) && ( xReaders[ 1 ].xResult == pdPASS ) );
+	configASSERT( uxRWLockGetReaderCount( xLock ) == 2 );
+
+	/* The lock cannot be taken for writing while it is held for reading, so
+	the attempt times out.  The readers do not inherit the priority of the
+	waiting task. */
+	xStart = xTaskGetTickCount();
+	configASSERT( xRWLockTakeWrite( xLock, mainTIMEOUT_TICKS ) == pdFAIL );
+	configASSERT( ( TickType_t ) ( xTaskGetTickCount() - xStart ) >= mainTIMEOUT_TICKS );
+	configASSERT( uxTaskPriorityGet( xReaders[ 0 ].xTask ) == mainREADER_PRIORITY );
+
+	/* A lower priority task waits to take the lock for writing. */
+	prvCommand( &xWriter, mainTAKE_WRITE );
+	configASSERT( prvCompleted( &xWriter ) == pdFALSE );
+
+	/* Another reader can take the lock while the writer is waiting only if
+	readers are preferred. */
+	prvCommand( &( xReaders[ 2 ] ), mainTAKE_READ );
+
+	if( ePolicy == eRWLockPreferReaders )
+	{
+		configASSERT( prvCompleted( &( xReaders[ 2 ] ) ) && ( xReaders[ 2 ].xResult == pdPASS ) );
+		configASSERT( uxRWLockGetReaderCount( xLock ) == 3 );
+	}
+	else
+	{
+		configASSERT( prvCompleted( &( xReaders[ 2 ] ) ) == pdFALSE );
+		configASSERT( xRWLockTakeRead( xLock, 0 ) == pdFAIL );
+		configASSERT( uxRWLockGetReaderCount( xLock ) == 2 );
+	}
+
+	/* The writer takes the lock once every reader has given it.  If writers
+	are preferred it takes the lock before the waiting reader, even though the
+	reader has the higher priority. */
+	prvCommand( &( xReaders[ 0 ] ), mainGIVE_READ );
+	prvCommand( &( xReaders[ 1 ] ), mainGIVE_READ );
+
+	if( ePolicy == eRWLockPreferReaders )
+	{
+		configASSERT( prvCompleted( &xWriter ) == pdFALSE );
+		prvCommand( &( xReaders[ 2 ] ), mainGIVE_READ );
+	}
+	else
+	{
+		configASSERT( prvCompleted( &( xReaders[ 2 ] ) ) == pdFALSE );
+	}
+
+	configASSERT( prvCompleted( &xWriter ) && ( xWriter.xResult == pdPASS ) );
+	configASSERT( uxRWLockGetReaderCount( xLock ) == 0 );
+
+	/* The waiting reader takes the lock once the writer has given it. */
+	prvCommand( &xWriter, mainGIVE_WRITE );
+	configASSERT( prvCompleted( &xWriter ) && ( xWriter.xResult == pdPASS ) );
+
+	if( ePolicy == eRWLockPreferWriters )
+	{
+		configASSERT( prvCompleted( &( xReaders[ 2 ] ) ) && ( xReaders[ 2 ].xResult == pdPASS ) );
+		prvCommand( &( xReaders[ 2 ] ), mainGIVE_READ );
+	}
+
+	configASSERT( uxRWLockGetReaderCount( xLock ) == 0 );
+	vRWLockDelete( xLock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckInheritance( void )
+{
+	xLock = xRWLockCreate( eRWLockPreferWriters );
+	configASSERT( xLock );
+
+	prvCommand( &xWriter, mainTAKE_WRITE );
+	configASSERT( prvCompleted( &xWriter ) && ( xWriter.xResult == pdPASS ) );
+
+	/* The writer inherits the priority of a higher priority task that waits
+	to take the lock for writing, until that task times out. */
+	xHelperTicksToWait = mainTIMEOUT_TICKS;
+	prvCommand( &xHigh, mainTAKE_WRITE );
+	configASSERT( prvCompleted( &xHigh ) == pdFALSE );
+	configASSERT( uxTaskPriorityGet( xWriter.xTask ) == mainHIGH_PRIORITY );
+
+	vTaskDelay( mainTIMEOUT_TICKS );
+	configASSERT( prvCompleted( &xHigh ) && ( xHigh.xResult == pdFAIL ) );
+	configASSERT( uxTaskPriorityGet( xWriter.xTask ) == mainWRITER_PRIORITY );
+
+	/* The writer inherits the priority of a higher priority task that waits
+	to take the lock for reading, until it gives the lock. */
+	xHelperTicksToWait = mainBLOCK_TICKS;
+	prvCommand( &xHigh, mainTAKE_READ );
+	configASSERT( prvCompleted( &xHigh ) == pdFALSE );
+	configASSERT( uxTaskPriorityGet( xWriter.xTask ) == mainHIGH_PRIORITY );
+
+	prvCommand( &xWriter, mainGIVE_WRITE );
+	configASSERT( prvCompleted( &xWriter ) && ( xWriter.xResult == pdPASS ) );
+	configASSERT( uxTaskPriorityGet( xWriter.xTask ) == mainWRITER_PRIORITY );
+	configASSERT( prvCompleted( &xHigh ) && ( xHigh.xResult == pdPASS ) );
+
+	prvCommand( &xHigh, mainGIVE_READ );
+	configASSERT( uxRWLockGetReaderCount( xLock ) == 0 );
+	vRWLockDelete( xLock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHelperTask( void *pvParameters )
+{
+Helper_t * const pxHelper = ( Helper_t * ) pvParameters;
+uint32_t ulCommand;
+
+	for( ;; )
+	{
+		( void ) xTaskNotifyWait( 0, UINT32_MAX, &ulCommand, portMAX_DELAY );
+
+		switch( ulCommand )
+		{
+			case mainTAKE_READ:
+				pxHelper->xResult = xRWLockTakeRead( xLock, xHelperTicksToWait );
+				break;
+
+			case mainGIVE_READ:
+				pxHelper->xResult = xRWLockGiveRead( xLock );
+				break;
+
+			case mainTAKE_WRITE:
+				pxHelper->xResult = xRWLockTakeWrite( xLock, xHelperTicksToWait );
+				break;
+
+			case mainGIVE_WRITE:
+				pxHelper->xResult = xRWLockGiveWrite( xLock );
+				break;
+
+			default:
+				/* Not a valid command. */
+				configASSERT( pdFALSE );
+				break;
+		}
+
+		pxHelper->uxCompleted++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCommand( Helper_t *pxHelper, uint32_t ulCommand )
+{
+	pxHelper->uxSent++;
+	( void ) xTaskNotify( pxHelper->xTask, ulCommand, eSetValueWithOverwrite );
+	vTaskDelay( mainSETTLE_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCompleted( const Helper_t *pxHelper )
+{
+BaseType_t xReturn;
+
+	if( pxHelper->uxCompleted == pxHelper->uxSent )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,647 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A host runnable benchmark for the generic tickless idle implementation in
+ * FreeRTOS/Source/portable/Common/tickless.c.
+ *
+ * vPortTicklessSuppressTicksAndSleep() is driven against a cycle accurate
+ * simulation of a 24-bit SysTick timer, in place of the real hardware, while a
+ * synthetic workload of periodic software timers and asynchronous interrupts
+ * decides how long each idle period is expected to last.  The kernel functions
+ * the tickless code calls (eTaskConfirmSleepModeStatus() and vTaskStepTick())
+ * are replaced by versions that maintain a simulated tick count, so the tick
+ * count the kernel would hold can be compared against true simulated time.
+ *
+ * For each workload the benchmark reports:
+ *
+ * + Drift - how far the kernel's tick count has moved from true time by the
+ *   end of the run, in timer counts and parts per million.  Time is lost
+ *   whenever the timer is stopped for longer, or shorter, than the stopped
+ *   timer compensation allows for.
+ *
+ * + Wake-up latency - when a sleep ends because the expected idle time
+ *   elapsed, the time between the tick on which the next task should have been
+ *   unblocked occurring (had the tick not been suppressed) and the kernel's tick
+ *   count reaching that tick.  When a sleep is
+ *   ended early by an interrupt, the time between the interrupt and the
+ *   function returning.
+ *
+ * + Critical section time - the number of timer counts spent with interrupts
+ *   masked inside each call, and the number of timer register accesses made by
+ *   each call, which together give the CPU overhead of tick suppression.
+ *
+ * Each timer register access and each change to the interrupt mask is charged
+ * a fixed number of cycles, which can be changed using the definitions below
+ * to match the target hardware.
+ *
+ * Build and run from this directory with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/portable/Common/tickless.c -o tickless_benchmark
+ * ./tickless_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdint.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The simulated processor and SysTick clock frequency.  The SysTick is clocked
+from the processor clock, as is the default for the ARM_CM4F port. */
+#define mainCPU_CLOCK_HZ				( 48000000UL )
+#define mainCOUNTS_PER_TICK				( mainCPU_CLOCK_HZ / configTICK_RATE_HZ )
+#define mainMAX_24_BIT_NUMBER			( 0xffffffUL )
+
+/* The number of cycles charged for each access to a timer register, and for
+each change to the interrupt mask. */
+#define mainREGISTER_ACCESS_CYCLES		( 4ULL )
+#define mainINTERRUPT_MASK_CYCLES		( 3ULL )
+
+/* The compensation used for the time the timer is stopped, as used by the
+ARM_CM4F port. */
+#define mainMISSED_COUNTS_FACTOR		( 45UL )
+
+/* The number of calls to vPortTicklessSuppressTicksAndSleep() made for each
+workload. */
+#define mainSLEEPS_PER_WORKLOAD			( 200000UL )
+
+/* The maximum number of periodic software timers in a workload. */
+#define mainMAX_TIMERS					( 4 )
+
+/*-----------------------------------------------------------*/
+
+/* The state of the simulated processor and SysTick. */
+typedef struct SIMULATION_STATE
+{
+	uint64_t ullNow;					/* Cycles since the start of the workload. */
+	uint32_t ulCurrent;					/* The SysTick current value register. */
+	uint32_t ulLoad;					/* The SysTick reload register. */
+	BaseType_t xEnabled;				/* The SysTick enable bit. */
+	BaseType_t xCountFlag;				/* The SysTick count flag, cleared when read. */
+	BaseType_t xTickPending;			/* The SysTick interrupt is pending. */
+	BaseType_t xExternalPending;		/* An interrupt other than the SysTick is pending. */
+	BaseType_t xInterruptsMasked;
+	uint64_t ullNextExternalInterrupt;	/* When the next asynchronous interrupt occurs, or UINT64_MAX if there are none. */
+	uint64_t ullExternalPendedAt;		/* When the last asynchronous interrupt occurred. */
+	BaseType_t xWokenByInterrupt;		/* The last sleep was ended by an asynchronous interrupt. */
+	uint64_t ullMaskedAt;				/* When interrupts were last masked. */
+	uint64_t ullSleepCycles;			/* Cycles spent asleep since interrupts were last masked. */
+	TickType_t xTickCount;				/* The tick count the kernel would hold. */
+} SimulationState_t;
+
+/* Describes one workload. */
+typedef struct WORKLOAD
+{
+	const char *pcName;
+	TickType_t xTimerPeriods[ mainMAX_TIMERS ];	/* Zero terminated if fewer than mainMAX_TIMERS timers are used. */
+	uint64_t ullMeanInterruptInterval;				/* Mean number of cycles between asynchronous interrupts, 0 for none. */
+	uint32_t ulAbortPercent;						/* Percentage of sleeps abandoned by eTaskConfirmSleepModeStatus(). */
+} Workload_t;
+
+/* Results gathered for one workload. */
+typedef struct RESULTS
+{
+	uint32_t ulSleeps, ulAborted, ulTimerWakes, ulInterruptWakes;
+	int64_t llMinTimerLatency, llMaxTimerLatency, llTotalTimerLatency;
+	uint64_t ullMaxInterruptLatency, ullTotalInterruptLatency;
+	uint64_t ullMaxCriticalCycles, ullTotalCriticalCycles;
+	uint64_t ullRegisterAccesses;
+	uint64_t ullTicksSuppressed;
+} Results_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Functions that implement the simulated SysTick, in the form required by the
+ * TicklessTimer_t structure.
+ */
+static void prvSimStop( void );
+static void prvSimStart( void );
+static void prvSimRestartFromReload( void );
+static uint32_t prvSimGetCount( void );
+static void prvSimSetReload( uint32_t ulReload );
+static BaseType_t prvSimHasExpired( void );
+static void prvSimDisableInterrupts( void );
+static void prvSimEnableInterrupts( void );
+static void prvSimWaitForInterrupt( void );
+
+/*
+ * Move simulated time forward, running the SysTick if it is enabled.
+ */
+static void prvAdvance( uint64_t ullCycles );
+
+/*
+ * Run the interrupt handlers for any pending interrupts if interrupts are not
+ * masked.  Called after simulated time has advanced, as pending interrupts
+ * would execute as soon as they were pended on real hardware.
+ */
+static void prvServiceInterrupts( void );
+
+/*
+ * Run the processor for a number of cycles with interrupts enabled.
+ */
+static void prvRunFor( uint64_t ullCycles );
+
+/*
+ * Run one workload and print its results.
+ */
+static void prvRunWorkload( const Workload_t * const pxWorkload );
+
+/*
+ * Record the wake-up latency if the tick count has just reached the tick on
+ * which the sleep in progress was expected to end.
+ */
+static void prvCheckTargetReached( void );
+
+/*
+ * A small pseudo random number generator, so results are repeatable.
+ */
+static uint32_t prvRand( void );
+
+/*-----------------------------------------------------------*/
+
+static SimulationState_t xSim;
+static Results_t xResults;
+static uint32_t ulAbortPercent = 0;
+static uint64_t ullMeanInterruptInterval = 0;
+static uint32_t ulRandomState = 0x12345678UL;
+
+/* The tick on which the sleep in progress was expected to end, and the time at
+which that tick would have occurred had the tick not been suppressed. */
+static TickType_t xTargetTick = 0;
+static uint64_t ullTargetTime = 0;
+static BaseType_t xTargetReached = pdFALSE;
+
+static TicklessTimer_t xSimulatedSysTick =
+{
+	mainCOUNTS_PER_TICK,
+	mainMAX_24_BIT_NUMBER / mainCOUNTS_PER_TICK,
+	mainMISSED_COUNTS_FACTOR,
+	prvSimStop,
+	prvSimStart,
+	prvSimRestartFromReload,
+	prvSimGetCount,
+	prvSimSetReload,
+	prvSimHasExpired,
+	prvSimDisableInterrupts,
+	prvSimEnableInterrupts,
+	prvSimWaitForInterrupt
+};
+
+static const Workload_t xWorkloads[] =
+{
+	/* Name						Timer periods (ticks)	Mean interrupt interval				Abort % */
+	{ "short timers",			{ 3, 7, 0, 0 },			0ULL,								0 },
+	{ "mixed timers",			{ 10, 37, 250, 0 },		0ULL,								0 },
+	{ "mixed timers + irqs",	{ 10, 37, 250, 0 },		( mainCOUNTS_PER_TICK * 20ULL ),	5 },
+	{ "long idle",				{ 5000, 0, 0, 0 },		0ULL,								0 },
+	{ "long idle + irqs",		{ 5000, 0, 0, 0 },		( mainCOUNTS_PER_TICK * 150ULL ),	0 }
+};
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+size_t x;
+
+	printf( "Simulated SysTick at %lu Hz, %lu counts per tick, %lu ticks maximum sleep, %lu counts stopped timer compensation.\n",
+			( unsigned long ) mainCPU_CLOCK_HZ,
+			( unsigned long ) xSimulatedSysTick.ulCountsPerTick,
+			( unsigned long ) xSimulatedSysTick.ulMaximumSuppressedTicks,
+			( unsigned long ) xSimulatedSysTick.ulStoppedTimerCompensation );
+
+	for( x = 0; x < ( sizeof( xWorkloads ) / sizeof( xWorkloads[ 0 ] ) ); x++ )
+	{
+		prvRunWorkload( &( xWorkloads[ x ] ) );
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunWorkload( const Workload_t * const pxWorkload )
+{
+TickType_t xNextExpiry[ mainMAX_TIMERS ], xNextWake, xExpectedIdleTime;
+uint64_t ullCriticalAtEntry;
+int64_t llDrift;
+uint32_t ulSleeps;
+size_t x;
+
+	/* Start from a freshly configured SysTick, with the first tick occurring
+	one tick period after time 0. */
+	xSim = ( SimulationState_t ) { 0 };
+	xSim.ulLoad = mainCOUNTS_PER_TICK - 1UL;
+	xSim.ulCurrent = xSim.ulLoad;
+	xSim.xEnabled = pdTRUE;
+	xResults = ( Results_t ) { 0 };
+	xResults.llMinTimerLatency = INT64_MAX;
+	xResults.llMaxTimerLatency = INT64_MIN;
+	ulAbortPercent = pxWorkload->ulAbortPercent;
+	ullMeanInterruptInterval = pxWorkload->ullMeanInterruptInterval;
+	xSim.ullNextExternalInterrupt = ( ullMeanInterruptInterval != 0ULL ) ? ( ( uint64_t ) prvRand() % ( 2ULL * ullMeanInterruptInterval ) ) : UINT64_MAX;
+
+	for( x = 0; x < mainMAX_TIMERS; x++ )
+	{
+		xNextExpiry[ x ] = pxWorkload->xTimerPeriods[ x ];
+	}
+
+	for( ulSleeps = 0; ulSleeps < mainSLEEPS_PER_WORKLOAD; )
+	{
+		/* Run the callbacks of any timers that have expired, each of which
+		keeps the processor busy for up to half a tick period. */
+		xNextWake = portMAX_DELAY;
+		for( x = 0; ( x < mainMAX_TIMERS ) && ( pxWorkload->xTimerPeriods[ x ] != 0 ); x++ )
+		{
+			while( xNextExpiry[ x ] <= xSim.xTickCount )
+			{
+				prvRunFor( ( uint64_t ) ( prvRand() % ( mainCOUNTS_PER_TICK / 2UL ) ) );
+				xNextExpiry[ x ] += pxWorkload->xTimerPeriods[ x ];
+			}
+
+			if( xNextExpiry[ x ] < xNextWake )
+			{
+				xNextWake = xNextExpiry[ x ];
+			}
+		}
+
+		/* The idle task only suppresses the tick if nothing is due to run for
+		at least configEXPECTED_IDLE_TIME_BEFORE_SLEEP ticks - otherwise it
+		waits for the next tick. */
+		xExpectedIdleTime = xNextWake - xSim.xTickCount;
+		if( xExpectedIdleTime < configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+		{
+			prvRunFor( ( uint64_t ) xSim.ulCurrent + 1ULL );
+			continue;
+		}
+
+		xTargetTick = xNextWake;
+		xTargetReached = pdFALSE;
+		if( xExpectedIdleTime > xSimulatedSysTick.ulMaximumSuppressedTicks )
+		{
+			/* The sleep will be cut short by the length of the timer, so the
+			time at which it ends is not a wake-up. */
+			xTargetTick = xSim.xTickCount + xSimulatedSysTick.ulMaximumSuppressedTicks;
+		}
+
+		/* The next tick occurs when the count reaches zero, and each
+		subsequent tick one tick period later. */
+		ullTargetTime = xSim.ullNow + ( uint64_t ) xSim.ulCurrent + ( ( uint64_t ) ( xTargetTick - xSim.xTickCount - 1 ) * mainCOUNTS_PER_TICK );
+
+		ullCriticalAtEntry = xResults.ullTotalCriticalCycles;
+		xSim.xExternalPending = pdFALSE;
+		xSim.xWokenByInterrupt = pdFALSE;
+
+		vPortTicklessSuppressTicksAndSleep( xExpectedIdleTime, &xSimulatedSysTick );
+		ulSleeps++;
+
+		if( ( xResults.ullTotalCriticalCycles - ullCriticalAtEntry ) > xResults.ullMaxCriticalCycles )
+		{
+			xResults.ullMaxCriticalCycles = xResults.ullTotalCriticalCycles - ullCriticalAtEntry;
+		}
+
+		if( xSim.xWokenByInterrupt != pdFALSE )
+		{
+		uint64_t ullLatency = xSim.ullNow - xSim.ullExternalPendedAt;
+
+			xResults.ulInterruptWakes++;
+			xResults.ullTotalInterruptLatency += ullLatency;
+
+			if( ullLatency > xResults.ullMaxInterruptLatency )
+			{
+				xResults.ullMaxInterruptLatency = ullLatency;
+			}
+		}
+	}
+
+	xResults.ulSleeps = ulSleeps;
+
+	/* The kernel's view of time is xTickCount tick periods, which is compared
+	against the number of tick periods that have really elapsed.  The first
+	tick occurs at the end of the first tick period. */
+	llDrift = ( int64_t ) ( ( uint64_t ) xSim.xTickCount * mainCOUNTS_PER_TICK ) - ( int64_t ) xSim.ullNow;
+
+	printf( "\n%s:\n", pxWorkload->pcName );
+	printf( "  sleeps %lu (aborted %lu, ended by timer %lu, ended by interrupt %lu), %llu ticks suppressed in %llu ticks\n",
+			( unsigned long ) xResults.ulSleeps, ( unsigned long ) xResults.ulAborted,
+			( unsigned long ) xResults.ulTimerWakes, ( unsigned long ) xResults.ulInterruptWakes,
+			( unsigned long long ) xResults.ullTicksSuppressed, ( unsigned long long ) xSim.xTickCount );
+	printf( "  drift %lld counts (%.2f ticks, %.2f ppm)\n",
+			( long long ) llDrift, ( double ) llDrift / ( double ) mainCOUNTS_PER_TICK,
+			( ( double ) llDrift * 1000000.0 ) / ( double ) xSim.ullNow );
+
+	if( xResults.ulTimerWakes != 0UL )
+	{
+		printf( "  timer wake-up latency min %lld avg %lld max %lld counts\n",
+				( long long ) xResults.llMinTimerLatency,
+				( long long ) ( xResults.llTotalTimerLatency / ( int64_t ) xResults.ulTimerWakes ),
+				( long long ) xResults.llMaxTimerLatency );
+	}
+
+	if( xResults.ulInterruptWakes != 0UL )
+	{
+		printf( "  interrupt wake-up latency avg %llu max %llu counts\n",
+				( unsigned long long ) ( xResults.ullTotalInterruptLatency / xResults.ulInterruptWakes ),
+				( unsigned long long ) xResults.ullMaxInterruptLatency );
+	}
+
+	printf( "  critical section avg %llu max %llu counts per call, %.1f timer register accesses per call\n",
+			( unsigned long long ) ( xResults.ullTotalCriticalCycles / xResults.ulSleeps ),
+			( unsigned long long ) xResults.ullMaxCriticalCycles,
+			( double ) xResults.ullRegisterAccesses / ( double ) xResults.ulSleeps );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAdvance( uint64_t ullCycles )
+{
+uint64_t ullStep;
+
+	while( ullCycles > 0ULL )
+	{
+		/* Asynchronous interrupts are pended at the time they occur. */
+		if( xSim.ullNow >= xSim.ullNextExternalInterrupt )
+		{
+			xSim.xExternalPending = pdTRUE;
+			xSim.ullExternalPendedAt = xSim.ullNow;
+			xSim.ullNextExternalInterrupt = xSim.ullNow + 1ULL + ( ( uint64_t ) prvRand() % ( 2ULL * ullMeanInterruptInterval ) );
+		}
+
+		ullStep = ullCycles;
+		if( ( xSim.ullNextExternalInterrupt - xSim.ullNow ) < ullStep )
+		{
+			ullStep = xSim.ullNextExternalInterrupt - xSim.ullNow;
+		}
+
+		if( xSim.xEnabled == pdFALSE )
+		{
+			xSim.ullNow += ullStep;
+			ullCycles -= ullStep;
+		}
+		else if( xSim.ulCurrent == 0UL )
+		{
+			/* The clock after the count reaches zero reloads the counter. */
+			xSim.ulCurrent = xSim.ulLoad;
+			xSim.ullNow++;
+			ullCycles--;
+		}
+		else
+		{
+			if( ( uint64_t ) xSim.ulCurrent < ullStep )
+			{
+				ullStep = xSim.ulCurrent;
+			}
+
+			xSim.ulCurrent -= ( uint32_t ) ullStep;
+			xSim.ullNow += ullStep;
+			ullCycles -= ullStep;
+
+			if( xSim.ulCurrent == 0UL )
+			{
+				/* Counting down to zero sets the count flag and pends the
+				tick interrupt. */
+				xSim.xCountFlag = pdTRUE;
+				xSim.xTickPending = pdTRUE;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvServiceInterrupts( void )
+{
+	if( xSim.xInterruptsMasked == pdFALSE )
+	{
+		if( xSim.xTickPending != pdFALSE )
+		{
+			xSim.xTickPending = pdFALSE;
+			xSim.xTickCount++;
+
+			prvCheckTargetReached();
+		}
+
+		xSim.xExternalPending = pdFALSE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTargetReached( void )
+{
+int64_t llLatency;
+
+	if( ( xTargetReached == pdFALSE ) && ( xSim.xTickCount >= xTargetTick ) )
+	{
+		/* Compare when the tick count reached the tick on which the sleep was
+		expected to end against when that tick would have occurred. */
+		xTargetReached = pdTRUE;
+		llLatency = ( int64_t ) xSim.ullNow - ( int64_t ) ullTargetTime;
+
+		xResults.ulTimerWakes++;
+		xResults.llTotalTimerLatency += llLatency;
+
+		if( llLatency < xResults.llMinTimerLatency )
+		{
+			xResults.llMinTimerLatency = llLatency;
+		}
+
+		if( llLatency > xResults.llMaxTimerLatency )
+		{
+			xResults.llMaxTimerLatency = llLatency;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunFor( uint64_t ullCycles )
+{
+uint64_t ullStep;
+
+	/* Run in steps of at most one cycle past the next timer event, so each
+	tick interrupt is serviced when it occurs. */
+	while( ullCycles > 0ULL )
+	{
+		ullStep = ( xSim.ulCurrent != 0UL ) ? ( uint64_t ) xSim.ulCurrent : 1ULL;
+		if( ullStep > ullCycles )
+		{
+			ullStep = ullCycles;
+		}
+
+		prvAdvance( ullStep );
+		ullCycles -= ullStep;
+		prvServiceInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+	/* xorshift32. */
+	ulRandomState ^= ulRandomState << 13;
+	ulRandomState ^= ulRandomState >> 17;
+	ulRandomState ^= ulRandomState << 5;
+	return ulRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimStop( void )
+{
+	xResults.ullRegisterAccesses++;
+	prvAdvance( mainREGISTER_ACCESS_CYCLES );
+	prvServiceInterrupts();
+	xSim.xEnabled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimStart( void )
+{
+	/* A read-modify-write of the control register, which clears the count
+	flag. */
+	xResults.ullRegisterAccesses += 2ULL;
+	prvAdvance( mainREGISTER_ACCESS_CYCLES * 2ULL );
+	xSim.xCountFlag = pdFALSE;
+	xSim.xEnabled = pdTRUE;
+	prvServiceInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimRestartFromReload( void )
+{
+	xResults.ullRegisterAccesses++;
+	prvAdvance( mainREGISTER_ACCESS_CYCLES );
+	xSim.ulCurrent = 0UL;
+	xSim.xCountFlag = pdFALSE;
+	prvSimStart();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvSimGetCount( void )
+{
+	xResults.ullRegisterAccesses++;
+	prvAdvance( mainREGISTER_ACCESS_CYCLES );
+	prvServiceInterrupts();
+	return xSim.ulCurrent;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimSetReload( uint32_t ulReload )
+{
+	configASSERT( ulReload <= mainMAX_24_BIT_NUMBER );
+	xResults.ullRegisterAccesses++;
+	prvAdvance( mainREGISTER_ACCESS_CYCLES );
+	xSim.ulLoad = ulReload;
+	prvServiceInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSimHasExpired( void )
+{
+BaseType_t xReturn;
+
+	xResults.ullRegisterAccesses++;
+	prvAdvance( mainREGISTER_ACCESS_CYCLES );
+	xReturn = xSim.xCountFlag;
+	xSim.xCountFlag = pdFALSE;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimDisableInterrupts( void )
+{
+	prvAdvance( mainINTERRUPT_MASK_CYCLES );
+	xSim.xInterruptsMasked = pdTRUE;
+	xSim.ullMaskedAt = xSim.ullNow;
+	xSim.ullSleepCycles = 0ULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimEnableInterrupts( void )
+{
+	prvAdvance( mainINTERRUPT_MASK_CYCLES );
+	/* Time spent asleep with interrupts masked is not overhead, as the
+	processor would otherwise be idle. */
+	xResults.ullTotalCriticalCycles += ( xSim.ullNow - xSim.ullMaskedAt ) - xSim.ullSleepCycles;
+	xSim.xInterruptsMasked = pdFALSE;
+	prvServiceInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimWaitForInterrupt( void )
+{
+uint64_t ullStep;
+
+	/* Sleep until either the SysTick or an asynchronous interrupt becomes
+	pending.  Interrupts are masked, so they remain pending until the tickless
+	code unmasks them. */
+	while( ( xSim.xTickPending == pdFALSE ) && ( xSim.xExternalPending == pdFALSE ) )
+	{
+		ullStep = ( xSim.ulCurrent != 0UL ) ? ( uint64_t ) xSim.ulCurrent : 1ULL;
+		if( ( xSim.ullNextExternalInterrupt - xSim.ullNow ) < ullStep )
+		{
+			ullStep = ( xSim.ullNextExternalInterrupt - xSim.ullNow ) + 1ULL;
+		}
+
+		prvAdvance( ullStep );
+		xSim.ullSleepCycles += ullStep;
+	}
+
+	if( xSim.xTickPending == pdFALSE )
+	{
+		/* Woken by an interrupt other than the tick.  The latency is measured
+		when the tickless code returns. */
+		xSim.xWokenByInterrupt = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Replacements for the kernel functions called by the tickless code. */
+
+eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+{
+eSleepModeStatus eReturn = eStandardSleep;
+
+	if( ( ulAbortPercent != 0UL ) && ( ( prvRand() % 100UL ) < ulAbortPercent ) )
+	{
+		/* Simulate a task becoming ready between the idle task deciding to
+		sleep and interrupts being masked. */
+		eReturn = eAbortSleep;
+		xResults.ulAborted++;
+	}
+
+	return eReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskStepTick( const TickType_t xTicksToJump )
+{
+	xSim.xTickCount += xTicksToJump;
+	prvCheckTargetReached();
+	xResults.ullTicksSuppressed += xTicksToJump;
+}
+/*-----------------------------------------------------------*/
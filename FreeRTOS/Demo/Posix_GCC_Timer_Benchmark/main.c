@@ -0,0 +1,365 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Measures the cost of software timer commands and expiries as the number of
+ * active timers grows, to compare the ways the timer service task can hold the
+ * active timers - in sorted lists (the default), or in a timing wheel when
+ * configUSE_TIMER_WHEEL is set to 1 - and the effect of receiving commands in
+ * batches by setting configTIMER_COMMAND_BATCH_SIZE above 1.
+ *
+ * For each number of timers, every timer is started with a pseudo random
+ * period that is long enough for none of them to expire during the test.  The
+ * control task, which has a priority above the timer service task, then stops
+ * and restarts randomly chosen timers, so commands accumulate in the timer
+ * queue and the timer service task processes them in bursts.  The time taken
+ * for every command to be processed is reported per command.  Finally every
+ * timer is restarted with the same short period, and the time from the first
+ * timer's callback executing to the last timer's callback executing is
+ * reported per timer.
+ *
+ * The benchmark runs on the POSIX/Linux simulator port, so the absolute
+ * figures reflect the speed of the host.  Build and run it once for each
+ * configuration of interest from this directory with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/tasks.c ../../Source/queue.c ../../Source/list.c
+ *     ../../Source/timers.c ../../Source/portable/MemMang/heap_4.c
+ *     ../../Source/portable/ThirdParty/GCC/Posix/port.c -lpthread -o timer_benchmark
+ * ./timer_benchmark
+ *
+ * adding -DconfigUSE_TIMER_WHEEL=1 and -DconfigTIMER_COMMAND_BATCH_SIZE=16 to
+ * the gcc command line to select the timing wheel and command batching.
+ *
+ * Adding -DconfigUSE_TIMER_SLACK=1 also measures how often the timer service
+ * task wakes to process a set of periodic timers, first when the timers are
+ * created without slack, then when they are created by xTimerCreateWithSlack()
+ * with a slack of a quarter of their period.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* The largest number of timers used in a test. */
+#define mainMAX_TIMERS					( 2048 )
+
+/* The number of times a timer is stopped then started again in the timed part
+of each test.  Each counts as two commands. */
+#define mainRESTARTS_PER_TEST			( 20000UL )
+
+/* Timers are started with a period between mainMIN_PERIOD and
+mainMIN_PERIOD + mainPERIOD_RANGE - 1 ticks, so none expire during the test. */
+#define mainMIN_PERIOD					( ( TickType_t ) 100000 )
+#define mainPERIOD_RANGE				( 100000UL )
+
+/* The period every timer is given when measuring expiries. */
+#define mainEXPIRY_PERIOD				pdMS_TO_TICKS( 50 )
+
+/* The number of periodic timers, the range of their periods, and the number of
+ticks for which they run, when measuring how often the timer service task
+wakes. */
+#define mainWAKE_UP_TIMERS				( 64 )
+#define mainWAKE_UP_MIN_PERIOD			pdMS_TO_TICKS( 100 )
+#define mainWAKE_UP_PERIOD_RANGE		( 900UL )
+#define mainWAKE_UP_TEST_TICKS			pdMS_TO_TICKS( 5000 )
+
+/* The control task has a priority above the timer service task so commands
+are queued faster than they are processed. */
+#define mainCONTROL_PRIORITY			( configTIMER_TASK_PRIORITY + 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs each test in turn and prints the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * The callback used by every timer.  Counts expiries, noting the time of the
+ * first and last.
+ */
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+/*
+ * Runs mainWAKE_UP_TIMERS periodic timers for mainWAKE_UP_TEST_TICKS ticks and
+ * returns the number of ticks in which at least one of them expired, that is,
+ * the number of times the timer service task woke to process them.  Each
+ * timer's slack is its period divided by xSlackDivisor, or 0 if xSlackDivisor
+ * is 0.
+ */
+#if( configUSE_TIMER_SLACK == 1 )
+	static uint32_t prvMeasureWakeUps( TickType_t xSlackDivisor );
+#endif
+
+/*
+ * The callback used by the timers created by prvMeasureWakeUps().
+ */
+#if( configUSE_TIMER_SLACK == 1 )
+	static void prvWakeUpCallback( TimerHandle_t xTimer );
+#endif
+
+/*
+ * Pended to the timer service task after the last command of a test to notify
+ * the control task that every command has been processed.
+ */
+static void prvCommandsProcessed( void *pvParameter1, uint32_t ulParameter2 );
+
+/*
+ * A simple pseudo random number generator, so every run uses the same
+ * sequence of timers and periods.
+ */
+static uint32_t prvRand( void );
+
+/*
+ * The time between two readings of the host's monotonic clock, in
+ * nanoseconds.
+ */
+static double prvElapsedNanoseconds( const struct timespec * const pxStart, const struct timespec * const pxEnd );
+
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xTimers[ mainMAX_TIMERS ];
+
+/* The numbers of timers used by the tests. */
+static const UBaseType_t uxTimerCounts[] = { 16, 128, 512, mainMAX_TIMERS };
+
+/* The number of expiries expected, and counted so far, in the test in
+progress, and the times of the first and last. */
+static volatile UBaseType_t uxExpiriesExpected = 0;
+static volatile UBaseType_t uxExpiries = 0;
+static struct timespec xFirstExpiry, xLastExpiry;
+
+/* The number of ticks in which a timer created by prvMeasureWakeUps() has
+expired, and the last of them. */
+#if( configUSE_TIMER_SLACK == 1 )
+	static volatile uint32_t ulWakeUps = 0;
+	static TickType_t xLastWakeUpTick = 0;
+#endif
+
+static TaskHandle_t xControlTask = NULL;
+static uint32_t ulRandomSeed = 0x12345678UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 2, NULL, mainCONTROL_PRIORITY, &xControlTask );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+struct timespec xStart, xEnd;
+UBaseType_t x, uxTimer, uxTimers;
+uint32_t ulRestart;
+double dCommandNs, dExpiryNs;
+
+	( void ) pvParameters;
+
+	for( uxTimer = 0; uxTimer < mainMAX_TIMERS; uxTimer++ )
+	{
+		xTimers[ uxTimer ] = xTimerCreate( "Tmr", mainMIN_PERIOD, pdFALSE, NULL, prvTimerCallback );
+		configASSERT( xTimers[ uxTimer ] );
+	}
+
+	printf( "Active timers held in %s, up to %lu commands received at a time.\n\n",
+			( configUSE_TIMER_WHEEL == 1 ) ? "a timing wheel" : "sorted lists",
+			( unsigned long ) configTIMER_COMMAND_BATCH_SIZE );
+	printf( "   timers  ns/command   ns/expiry\n" );
+
+	for( x = 0; x < ( sizeof( uxTimerCounts ) / sizeof( uxTimerCounts[ 0 ] ) ); x++ )
+	{
+		uxTimers = uxTimerCounts[ x ];
+
+		/* Start the timers used by this test. */
+		for( uxTimer = 0; uxTimer < uxTimers; uxTimer++ )
+		{
+			( void ) xTimerChangePeriod( xTimers[ uxTimer ], mainMIN_PERIOD + ( TickType_t ) ( prvRand() % mainPERIOD_RANGE ), portMAX_DELAY );
+		}
+
+		( void ) xTimerPendFunctionCall( prvCommandsProcessed, NULL, 0, portMAX_DELAY );
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		/* Stop and restart randomly chosen timers. */
+		clock_gettime( CLOCK_MONOTONIC, &xStart );
+
+		for( ulRestart = 0; ulRestart < mainRESTARTS_PER_TEST; ulRestart++ )
+		{
+			uxTimer = ( UBaseType_t ) ( prvRand() % uxTimers );
+			( void ) xTimerStop( xTimers[ uxTimer ], portMAX_DELAY );
+			( void ) xTimerStart( xTimers[ uxTimer ], portMAX_DELAY );
+		}
+
+		( void ) xTimerPendFunctionCall( prvCommandsProcessed, NULL, 0, portMAX_DELAY );
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		clock_gettime( CLOCK_MONOTONIC, &xEnd );
+
+		dCommandNs = prvElapsedNanoseconds( &xStart, &xEnd ) / ( double ) ( mainRESTARTS_PER_TEST * 2UL );
+
+		/* Restart every timer with the same short period and wait for them all
+		to expire. */
+		uxExpiries = 0;
+		uxExpiriesExpected = uxTimers;
+
+		for( uxTimer = 0; uxTimer < uxTimers; uxTimer++ )
+		{
+			( void ) xTimerChangePeriod( xTimers[ uxTimer ], mainEXPIRY_PERIOD, portMAX_DELAY );
+		}
+
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		dExpiryNs = prvElapsedNanoseconds( &xFirstExpiry, &xLastExpiry ) / ( double ) uxTimers;
+
+		printf( "%9lu %11.0f %11.0f\n", ( unsigned long ) uxTimers, dCommandNs, dExpiryNs );
+	}
+
+	#if( configUSE_TIMER_SLACK == 1 )
+	{
+	uint32_t ulWakeUpsWithoutSlack, ulWakeUpsWithSlack;
+
+		/* The long running timers are no longer needed. */
+		for( uxTimer = 0; uxTimer < mainMAX_TIMERS; uxTimer++ )
+		{
+			( void ) xTimerDelete( xTimers[ uxTimer ], portMAX_DELAY );
+		}
+
+		ulWakeUpsWithoutSlack = prvMeasureWakeUps( 0 );
+		ulWakeUpsWithSlack = prvMeasureWakeUps( 4 );
+
+		printf( "\nTimer service task wake-ups per second for %d periodic timers:\n", mainWAKE_UP_TIMERS );
+		printf( "   without slack %7.1f\n", ( double ) ulWakeUpsWithoutSlack * ( double ) configTICK_RATE_HZ / ( double ) mainWAKE_UP_TEST_TICKS );
+		printf( "   with slack    %7.1f\n", ( double ) ulWakeUpsWithSlack * ( double ) configTICK_RATE_HZ / ( double ) mainWAKE_UP_TEST_TICKS );
+	}
+	#endif /* configUSE_TIMER_SLACK */
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+
+	if( uxExpiries == 0 )
+	{
+		clock_gettime( CLOCK_MONOTONIC, &xFirstExpiry );
+	}
+
+	uxExpiries++;
+
+	if( uxExpiries == uxExpiriesExpected )
+	{
+		clock_gettime( CLOCK_MONOTONIC, &xLastExpiry );
+		xTaskNotifyGive( xControlTask );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_SLACK == 1 )
+
+	static uint32_t prvMeasureWakeUps( TickType_t xSlackDivisor )
+	{
+	TimerHandle_t xWakeUpTimers[ mainWAKE_UP_TIMERS ];
+	TickType_t xPeriod, xSlack;
+	UBaseType_t uxTimer;
+
+		ulWakeUps = 0;
+		xLastWakeUpTick = xTaskGetTickCount();
+
+		for( uxTimer = 0; uxTimer < mainWAKE_UP_TIMERS; uxTimer++ )
+		{
+			xPeriod = mainWAKE_UP_MIN_PERIOD + ( TickType_t ) ( prvRand() % mainWAKE_UP_PERIOD_RANGE );
+			xSlack = ( xSlackDivisor == 0 ) ? 0 : ( xPeriod / xSlackDivisor );
+
+			xWakeUpTimers[ uxTimer ] = xTimerCreateWithSlack( "Wake", xPeriod, pdTRUE, NULL, prvWakeUpCallback, xSlack );
+			configASSERT( xWakeUpTimers[ uxTimer ] );
+			( void ) xTimerStart( xWakeUpTimers[ uxTimer ], portMAX_DELAY );
+		}
+
+		vTaskDelay( mainWAKE_UP_TEST_TICKS );
+
+		for( uxTimer = 0; uxTimer < mainWAKE_UP_TIMERS; uxTimer++ )
+		{
+			( void ) xTimerDelete( xWakeUpTimers[ uxTimer ], portMAX_DELAY );
+		}
+
+		/* Ensure the timers have been deleted before the count is used. */
+		( void ) xTimerPendFunctionCall( prvCommandsProcessed, NULL, 0, portMAX_DELAY );
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		return ulWakeUps;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWakeUpCallback( TimerHandle_t xTimer )
+	{
+	const TickType_t xTickCount = xTaskGetTickCount();
+
+		( void ) xTimer;
+
+		if( xTickCount != xLastWakeUpTick )
+		{
+			xLastWakeUpTick = xTickCount;
+			ulWakeUps++;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TIMER_SLACK */
+
+static void prvCommandsProcessed( void *pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+	( void ) ulParameter2;
+
+	xTaskNotifyGive( xControlTask );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+	ulRandomSeed = ( ulRandomSeed * 1103515245UL ) + 12345UL;
+	return ( ulRandomSeed >> 8 ) & 0xffffffUL;
+}
+/*-----------------------------------------------------------*/
+
+static double prvElapsedNanoseconds( const struct timespec * const pxStart, const struct timespec * const pxEnd )
+{
+	return ( ( double ) ( pxEnd->tv_sec - pxStart->tv_sec ) * 1e9 ) + ( double ) ( pxEnd->tv_nsec - pxStart->tv_nsec );
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,359 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Compares running deferred jobs by pending them to the timer service task
+ * with xTimerPendFunctionCall() against submitting them to a work queue with
+ * one worker, and to a work queue with mainWORKERS workers, then checks that
+ * delayed work items, cancellation and the work queue statistics behave as
+ * documented.
+ *
+ * Two kinds of job are used.  An overhead job does nothing but count itself,
+ * so the time taken per job is the cost of deferring it.  A blocking job waits
+ * for mainBLOCK_TICKS ticks, as a job that waits for a peripheral or another
+ * task would, so the total number of ticks taken shows whether jobs are run
+ * one after another or at the same time.  Jobs that only use the CPU cannot
+ * run faster with more workers on the simulator, as it only runs one task at a
+ * time.
+ *
+ * The benchmark runs on the POSIX/Linux simulator port, so the absolute
+ * figures reflect the speed of the host.  Build and run it from this directory
+ * with:
+ *
+ * gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/Posix
+ *     main.c ../../Source/tasks.c ../../Source/queue.c ../../Source/list.c
+ *     ../../Source/timers.c ../../Source/workqueue.c
+ *     ../../Source/portable/MemMang/heap_4.c
+ *     ../../Source/portable/ThirdParty/GCC/Posix/port.c -lpthread -o workqueue_benchmark
+ * ./workqueue_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "workqueue.h"
+
+/* The number of workers in the larger work queue. */
+#define mainWORKERS						( 4 )
+
+/* The number of jobs deferred at once, each of which uses its own work
+item. */
+#define mainJOBS						( 32 )
+
+/* The number of times mainJOBS overhead jobs are deferred when measuring the
+cost of deferring a job. */
+#define mainOVERHEAD_ROUNDS				( 1000UL )
+
+/* The number of ticks for which a blocking job waits. */
+#define mainBLOCK_TICKS					( ( TickType_t ) 4 )
+
+/* The delay used when checking delayed work items. */
+#define mainWORK_DELAY					( ( TickType_t ) 50 )
+
+/* The workers and the timer service task share a priority below that of the
+control task, so jobs accumulate and are run in bursts. */
+#define mainWORKER_PRIORITY				( configTIMER_TASK_PRIORITY )
+#define mainCONTROL_PRIORITY			( configTIMER_TASK_PRIORITY + 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs each test in turn and prints the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * The jobs as pended to the timer service task.  ulParameter2 is pdTRUE for
+ * a blocking job.
+ */
+static void prvPendedJob( void *pvParameter1, uint32_t ulParameter2 );
+
+/*
+ * The jobs as run by a work queue.  The parameter points to a BaseType_t that
+ * is pdTRUE for a blocking job.
+ */
+static void prvWorkJob( void *pvParameter );
+
+/*
+ * Counts a completed job and notifies the control task when every job
+ * deferred by the test in progress has completed.
+ */
+static void prvJobDone( void );
+
+/*
+ * Defers mainJOBS jobs, xRounds times, waiting for every job to complete
+ * before starting the next round, either by pending them to the timer
+ * service task, if xWorkQueue is NULL, or by submitting them to xWorkQueue.
+ * Returns the time taken in nanoseconds and sets *pxTicks to the number of
+ * ticks taken.
+ */
+static double prvRunJobs( WorkQueueHandle_t xWorkQueue, UBaseType_t uxRounds, BaseType_t xBlocking, TickType_t *pxTicks );
+
+/*
+ * Checks delayed work items, cancellation and resubmission, then prints the
+ * statistics of xWorkQueue.
+ */
+static void prvCheckWorkQueue( WorkQueueHandle_t xWorkQueue );
+
+/*
+ * The work function used by prvCheckWorkQueue().  Records the tick count at
+ * which it ran in the TickType_t pointed to by the parameter.
+ */
+static void prvRecordTime( void *pvParameter );
+
+/*
+ * The time between two readings of the host's monotonic clock, in
+ * nanoseconds.
+ */
+static double prvElapsedNanoseconds( const struct timespec * const pxStart, const struct timespec * const pxEnd );
+
+/*-----------------------------------------------------------*/
+
+/* The work items used for overhead and blocking jobs respectively, and the
+parameters given to them. */
+static WorkItemHandle_t xOverheadItems[ mainJOBS ], xBlockingItems[ mainJOBS ];
+static BaseType_t xOverheadJob = pdFALSE, xBlockingJob = pdTRUE;
+
+/* The number of jobs expected to complete, and completed so far, in the round
+in progress. */
+static volatile UBaseType_t uxJobsExpected = 0;
+static volatile UBaseType_t uxJobsDone = 0;
+
+static TaskHandle_t xControlTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 2, NULL, mainCONTROL_PRIORITY, &xControlTask );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+const UBaseType_t uxPriorities[ mainWORKERS ] = { mainWORKER_PRIORITY, mainWORKER_PRIORITY, mainWORKER_PRIORITY, mainWORKER_PRIORITY };
+WorkQueueHandle_t xSingleWorkQueue, xMultipleWorkQueue;
+TickType_t xTicks;
+double dNs;
+UBaseType_t x;
+
+	( void ) pvParameters;
+
+	xSingleWorkQueue = xWorkQueueCreate( "Single", 1, uxPriorities, configMINIMAL_STACK_SIZE * 2 );
+	xMultipleWorkQueue = xWorkQueueCreate( "Multiple", mainWORKERS, uxPriorities, configMINIMAL_STACK_SIZE * 2 );
+	configASSERT( xSingleWorkQueue );
+	configASSERT( xMultipleWorkQueue );
+
+	for( x = 0; x < mainJOBS; x++ )
+	{
+		xOverheadItems[ x ] = xWorkItemCreate( prvWorkJob, &xOverheadJob );
+		xBlockingItems[ x ] = xWorkItemCreate( prvWorkJob, &xBlockingJob );
+		configASSERT( xOverheadItems[ x ] );
+		configASSERT( xBlockingItems[ x ] );
+	}
+
+	printf( "%d jobs deferred at a time.\n\n", mainJOBS );
+	printf( "                      ns/overhead job   ticks for %d jobs blocking %lu ticks each\n", mainJOBS, ( unsigned long ) mainBLOCK_TICKS );
+
+	dNs = prvRunJobs( NULL, mainOVERHEAD_ROUNDS, pdFALSE, &xTicks );
+	( void ) prvRunJobs( NULL, 1, pdTRUE, &xTicks );
+	printf( "   timer service task %15.0f %10lu\n", dNs / ( double ) ( mainOVERHEAD_ROUNDS * mainJOBS ), ( unsigned long ) xTicks );
+
+	dNs = prvRunJobs( xSingleWorkQueue, mainOVERHEAD_ROUNDS, pdFALSE, &xTicks );
+	( void ) prvRunJobs( xSingleWorkQueue, 1, pdTRUE, &xTicks );
+	printf( "   1 worker           %15.0f %10lu\n", dNs / ( double ) ( mainOVERHEAD_ROUNDS * mainJOBS ), ( unsigned long ) xTicks );
+
+	dNs = prvRunJobs( xMultipleWorkQueue, mainOVERHEAD_ROUNDS, pdFALSE, &xTicks );
+	( void ) prvRunJobs( xMultipleWorkQueue, 1, pdTRUE, &xTicks );
+	printf( "   %d workers          %15.0f %10lu\n", mainWORKERS, dNs / ( double ) ( mainOVERHEAD_ROUNDS * mainJOBS ), ( unsigned long ) xTicks );
+
+	prvCheckWorkQueue( xMultipleWorkQueue );
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static double prvRunJobs( WorkQueueHandle_t xWorkQueue, UBaseType_t uxRounds, BaseType_t xBlocking, TickType_t *pxTicks )
+{
+struct timespec xStart, xEnd;
+TickType_t xStartTick;
+UBaseType_t uxRound, x;
+BaseType_t xResult;
+
+	clock_gettime( CLOCK_MONOTONIC, &xStart );
+	xStartTick = xTaskGetTickCount();
+
+	for( uxRound = 0; uxRound < uxRounds; uxRound++ )
+	{
+		uxJobsDone = 0;
+		uxJobsExpected = mainJOBS;
+
+		for( x = 0; x < mainJOBS; x++ )
+		{
+			if( xWorkQueue == NULL )
+			{
+				( void ) xTimerPendFunctionCall( prvPendedJob, NULL, ( uint32_t ) xBlocking, portMAX_DELAY );
+			}
+			else
+			{
+				xResult = xWorkQueueSubmit( xWorkQueue, ( xBlocking != pdFALSE ) ? xBlockingItems[ x ] : xOverheadItems[ x ], 0 );
+				configASSERT( xResult == pdPASS );
+			}
+		}
+
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+
+	*pxTicks = xTaskGetTickCount() - xStartTick;
+	clock_gettime( CLOCK_MONOTONIC, &xEnd );
+
+	return prvElapsedNanoseconds( &xStart, &xEnd );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckWorkQueue( WorkQueueHandle_t xWorkQueue )
+{
+WorkItemHandle_t xDelayedItem, xCancelledItem;
+volatile TickType_t xDelayedRan = 0, xCancelledRan = 0;
+TickType_t xSubmitted;
+WorkQueueStats_t xStats;
+UBaseType_t x;
+
+	xDelayedItem = xWorkItemCreate( prvRecordTime, ( void * ) &xDelayedRan );
+	xCancelledItem = xWorkItemCreate( prvRecordTime, ( void * ) &xCancelledRan );
+	configASSERT( xDelayedItem );
+	configASSERT( xCancelledItem );
+
+	/* A delayed work item runs once its delay has expired, and a work item
+	that is waiting to run cannot be submitted again. */
+	xSubmitted = xTaskGetTickCount();
+	configASSERT( xWorkQueueSubmit( xWorkQueue, xDelayedItem, mainWORK_DELAY ) == pdPASS );
+	configASSERT( xWorkQueueSubmit( xWorkQueue, xDelayedItem, 0 ) == pdFAIL );
+	configASSERT( xWorkQueueSubmit( xWorkQueue, xCancelledItem, mainWORK_DELAY / 2 ) == pdPASS );
+	configASSERT( xWorkItemIsBusy( xDelayedItem ) == pdTRUE );
+
+	/* A cancelled work item does not run, and can be cancelled only once. */
+	configASSERT( xWorkItemCancel( xCancelledItem ) == pdPASS );
+	configASSERT( xWorkItemCancel( xCancelledItem ) == pdFAIL );
+	configASSERT( xWorkItemIsBusy( xCancelledItem ) == pdFALSE );
+
+	vTaskDelay( mainWORK_DELAY * 2 );
+
+	configASSERT( xDelayedRan != 0 );
+	configASSERT( ( TickType_t ) ( xDelayedRan - xSubmitted ) >= mainWORK_DELAY );
+	configASSERT( xCancelledRan == 0 );
+	configASSERT( xWorkItemIsBusy( xDelayedItem ) == pdFALSE );
+
+	printf( "\nDelayed work item ran after %lu ticks, for a delay of %lu ticks.\n", ( unsigned long ) ( xDelayedRan - xSubmitted ), ( unsigned long ) mainWORK_DELAY );
+
+	vWorkItemDelete( xDelayedItem );
+	vWorkItemDelete( xCancelledItem );
+
+	vWorkQueueGetStats( xWorkQueue, &xStats );
+	configASSERT( xStats.uxPendingItems == 0 );
+	configASSERT( xStats.uxDelayedItems == 0 );
+	configASSERT( xStats.uxNumberOfItemsRun + xStats.uxNumberOfItemsCancelled == xStats.uxNumberOfSubmissions );
+
+	printf( "\nStatistics of the work queue with %lu workers:\n", ( unsigned long ) xStats.uxNumberOfWorkers );
+	printf( "   submissions          %lu\n", ( unsigned long ) xStats.uxNumberOfSubmissions );
+	printf( "   failed submissions   %lu\n", ( unsigned long ) xStats.uxNumberOfFailedSubmissions );
+	printf( "   work items run       %lu\n", ( unsigned long ) xStats.uxNumberOfItemsRun );
+	printf( "   work items stolen    %lu\n", ( unsigned long ) xStats.uxNumberOfItemsStolen );
+	printf( "   work items cancelled %lu\n", ( unsigned long ) xStats.uxNumberOfItemsCancelled );
+	printf( "   most pending         %lu\n", ( unsigned long ) xStats.uxMaxPendingItems );
+	printf( "   longest latency      %lu ticks\n", ( unsigned long ) xStats.xMaxLatency );
+
+	for( x = 0; x < xStats.uxNumberOfWorkers; x++ )
+	{
+		configASSERT( xWorkQueueGetWorkerHandle( xWorkQueue, x ) != NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPendedJob( void *pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+
+	if( ulParameter2 != ( uint32_t ) pdFALSE )
+	{
+		vTaskDelay( mainBLOCK_TICKS );
+	}
+
+	prvJobDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkJob( void *pvParameter )
+{
+	if( *( ( BaseType_t * ) pvParameter ) != pdFALSE )
+	{
+		vTaskDelay( mainBLOCK_TICKS );
+	}
+
+	prvJobDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvJobDone( void )
+{
+BaseType_t xLastJob;
+
+	/* Jobs run by different workers can complete at the same time. */
+	taskENTER_CRITICAL();
+	{
+		uxJobsDone++;
+		xLastJob = ( uxJobsDone == uxJobsExpected ) ? pdTRUE : pdFALSE;
+	}
+	taskEXIT_CRITICAL();
+
+	if( xLastJob != pdFALSE )
+	{
+		xTaskNotifyGive( xControlTask );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordTime( void *pvParameter )
+{
+	*( ( volatile TickType_t * ) pvParameter ) = xTaskGetTickCount();
+}
+/*-----------------------------------------------------------*/
+
+static double prvElapsedNanoseconds( const struct timespec * const pxStart, const struct timespec * const pxEnd )
+{
+	return ( ( double ) ( pxEnd->tv_sec - pxStart->tv_sec ) * 1e9 ) + ( double ) ( pxEnd->tv_nsec - pxStart->tv_nsec );
+}
+/*-----------------------------------------------------------*/
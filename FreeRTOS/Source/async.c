@@ -0,0 +1,1097 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "async.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+to include async task functionality.  This #if is closed at the very bottom of
+this file.  If you want to include async tasks then ensure
+configUSE_ASYNC_TASKS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_ASYNC_TASKS == 1 )
+
+/* The states an async task can be in, stored in the ucState member of the
+async task. */
+#define asyncREADY								( ( uint8_t ) 0 ) /* In the executor's list of async tasks that are ready to run. */
+#define asyncRUNNING							( ( uint8_t ) 1 ) /* Being run by the executor, so in no state list. */
+#define asyncWAITING							( ( uint8_t ) 2 ) /* Waiting for a kernel object, a notification or a delay, so in a list of delayed async tasks if the wait has a timeout. */
+
+/* Bits stored in the ucFlags member of an async task. */
+#define asyncFLAGS_IS_STATICALLY_ALLOCATED		( ( uint8_t ) 1 ) /* Set if the async task structure was created using statically allocated memory. */
+#define asyncFLAGS_DELETE_PENDING				( ( uint8_t ) 2 ) /* Set if the async task was deleted while it was running, so must be freed when it returns. */
+#define asyncFLAGS_WAITING_FOR_NOTIFICATION		( ( uint8_t ) 4 ) /* Set if the async task is waiting in asyncNOTIFY_TAKE(). */
+
+/*-----------------------------------------------------------*/
+
+struct xASYNC_EXECUTOR;
+
+/* Structure that holds the state of an async task. */
+typedef struct xASYNC_TASK /*lint !e9058 Style convention uses tag. */
+{
+	ListItem_t xStateListItem;			/* Held in the executor's list of ready async tasks, or in one of its lists of delayed async tasks.  The item value is the time at which a delayed async task wakes. */
+	ListItem_t xEventListItem;			/* Held in the list of async tasks waiting for a queue or stream buffer.  The item value is asyncWAITING_TO_RECEIVE or asyncWAITING_TO_SEND. */
+	AsyncTaskFunction_t pxTaskCode;		/* The async task function. */
+	void *pvParameters;					/* The value passed into pxTaskCode. */
+	struct xASYNC_EXECUTOR *pxExecutor;	/* The executor that runs the async task. */
+	TimeOut_t xTimeOut;					/* The time at which the async task started to wait. */
+	TickType_t xTicksToWait;			/* The maximum time the async task waits, counted from xTimeOut. */
+	uint32_t ulNotifiedValue;			/* Incremented by xAsyncTaskNotifyGive(), and taken by asyncNOTIFY_TAKE(). */
+	UBaseType_t uxResumePoint;			/* The point in pxTaskCode at which the async task continues, or 0 to start from the beginning. */
+	uint8_t ucState;					/* One of the async task states defined above. */
+	uint8_t ucFlags;
+} AsyncTask_t;
+
+/* Structure that holds the state of an executor. */
+typedef struct xASYNC_EXECUTOR /*lint !e9058 Style convention uses tag. */
+{
+	List_t xReadyTasks;					/* The async tasks that are ready to run, in the order in which they became ready. */
+	List_t xDelayedTasks1;				/* Async tasks that are waiting with a timeout, ordered by the time at which they wake. */
+	List_t xDelayedTasks2;				/* As above, the two lists are used as the current and overflow lists. */
+	List_t *pxDelayedTasks;				/* Delayed async tasks that wake before the tick count next overflows. */
+	List_t *pxOverflowDelayedTasks;		/* Delayed async tasks that wake after the tick count next overflows. */
+	TickType_t xLastTime;				/* The tick count when the delayed async tasks were last checked, used to detect the tick count overflowing. */
+	TaskHandle_t xTask;					/* The executor task. */
+	AsyncTask_t *pxCurrentTask;			/* The async task the executor is running, or NULL. */
+	UBaseType_t uxNumberOfTasks;		/* The number of async tasks run by the executor. */
+	BaseType_t xIsIdle;					/* pdTRUE if the executor task is waiting for an async task to become ready and has not yet been woken. */
+} AsyncExecutor_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The function executed by every executor task.  The parameter is the
+ * executor.
+ */
+static void prvExecutorTask( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by an executor task to get the next async task to run.  Moves any
+ * delayed async tasks that have woken to the list of ready async tasks, then
+ * takes the oldest ready async task.  Returns NULL if no async tasks are
+ * ready, in which case *pxTicksToWait is set to the time the executor should
+ * wait before checking again.  Must be called from a critical section.
+ */
+static AsyncTask_t *prvGetNextTask( AsyncExecutor_t * const pxExecutor, TickType_t * const pxTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialises a new async task and adds it to the async tasks that are ready
+ * to be run by pxExecutor.
+ */
+static void prvInitialiseNewAsyncTask( AsyncExecutor_t * const pxExecutor, AsyncTaskFunction_t pxTaskCode, void *pvParameters, AsyncTask_t * const pxAsyncTask, const uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes an async task from any list it is waiting in and adds it to the end
+ * of its executor's list of ready async tasks, waking the executor if it is
+ * idle.  xFromISR is pdTRUE when called from an interrupt, in which case
+ * pxHigherPriorityTaskWoken is passed on to vTaskNotifyGiveIndexedFromISR(),
+ * and so can be NULL.  Must be called from a critical section.
+ */
+static void prvMakeReady( AsyncTask_t * const pxAsyncTask, const BaseType_t xFromISR, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Makes the running async task wait in pxWaitingList, which can be NULL, and
+ * in the executor's list of delayed async tasks if the wait has a timeout.
+ * Returns pdFALSE, without waiting, if the time given to
+ * vAsyncTaskPrepareToWait() has already expired.  Must be called from a
+ * critical section.
+ */
+static BaseType_t prvBlock( AsyncTask_t * const pxAsyncTask, List_t * const pxWaitingList, const TickType_t xEvent ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the operation an async task started to wait for is completed
+ * by the attempt made after it started to wait.  The async task stops waiting
+ * and continues running.
+ */
+static void prvUnblock( AsyncTask_t * const pxAsyncTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds an async task to the list of delayed async tasks, to wake in
+ * xTicksToWait ticks.  Must be called from a critical section.
+ */
+static void prvAddToDelayedList( AsyncExecutor_t * const pxExecutor, AsyncTask_t * const pxAsyncTask, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Makes delayed async tasks that wake at or before xTimeNow ready to run.
+ * Switches the current and overflow lists of delayed async tasks if the tick
+ * count has overflowed since they were last checked.  Must be called from a
+ * critical section.
+ */
+static void prvMoveWokenDelayedTasks( AsyncExecutor_t * const pxExecutor, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Implements both vAsyncTaskWakeWaiting() and vAsyncTaskWakeWaitingFromISR().
+ * Must be called from a critical section.
+ */
+static void prvWakeWaiting( List_t * const pxWaitingList, const TickType_t xEvent, UBaseType_t uxMaxToWake, const BaseType_t xFromISR, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	AsyncExecutorHandle_t xAsyncExecutorCreate( const char * const pcName, configSTACK_DEPTH_TYPE usStackDepth, UBaseType_t uxPriority )
+	{
+	AsyncExecutor_t *pxExecutor;
+
+		pxExecutor = ( AsyncExecutor_t * ) pvPortMalloc( sizeof( AsyncExecutor_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxExecutor != NULL )
+		{
+			vListInitialise( &( pxExecutor->xReadyTasks ) );
+			vListInitialise( &( pxExecutor->xDelayedTasks1 ) );
+			vListInitialise( &( pxExecutor->xDelayedTasks2 ) );
+			pxExecutor->pxDelayedTasks = &( pxExecutor->xDelayedTasks1 );
+			pxExecutor->pxOverflowDelayedTasks = &( pxExecutor->xDelayedTasks2 );
+			pxExecutor->xLastTime = xTaskGetTickCount();
+			pxExecutor->xTask = NULL;
+			pxExecutor->pxCurrentTask = NULL;
+			pxExecutor->uxNumberOfTasks = ( UBaseType_t ) 0;
+			pxExecutor->xIsIdle = pdFALSE;
+
+			if( xTaskCreate( prvExecutorTask, pcName, usStackDepth, ( void * ) pxExecutor, uxPriority, &( pxExecutor->xTask ) ) == pdPASS )
+			{
+				traceASYNC_EXECUTOR_CREATE( pxExecutor );
+			}
+			else
+			{
+				vPortFree( ( void * ) pxExecutor );
+				pxExecutor = NULL;
+				traceASYNC_EXECUTOR_CREATE_FAILED();
+			}
+		}
+		else
+		{
+			traceASYNC_EXECUTOR_CREATE_FAILED();
+		}
+
+		return ( AsyncExecutorHandle_t ) pxExecutor;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	AsyncTaskHandle_t xAsyncTaskCreate( AsyncExecutorHandle_t xExecutor, AsyncTaskFunction_t pxTaskCode, void *pvParameters )
+	{
+	AsyncExecutor_t * const pxExecutor = ( AsyncExecutor_t * ) xExecutor;
+	AsyncTask_t *pxAsyncTask;
+
+		configASSERT( pxExecutor );
+		configASSERT( pxTaskCode );
+
+		pxAsyncTask = ( AsyncTask_t * ) pvPortMalloc( sizeof( AsyncTask_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxAsyncTask != NULL )
+		{
+			prvInitialiseNewAsyncTask( pxExecutor, pxTaskCode, pvParameters, pxAsyncTask, 0 );
+		}
+		else
+		{
+			traceASYNC_TASK_CREATE_FAILED();
+		}
+
+		return ( AsyncTaskHandle_t ) pxAsyncTask;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	AsyncTaskHandle_t xAsyncTaskCreateStatic( AsyncExecutorHandle_t xExecutor, AsyncTaskFunction_t pxTaskCode, void *pvParameters, StaticAsyncTask_t *pxAsyncTaskBuffer )
+	{
+	AsyncExecutor_t * const pxExecutor = ( AsyncExecutor_t * ) xExecutor;
+	AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) pxAsyncTaskBuffer; /*lint !e740 !e9087 Safe cast as StaticAsyncTask_t is opaque AsyncTask_t. */
+
+		configASSERT( pxExecutor );
+		configASSERT( pxTaskCode );
+		configASSERT( pxAsyncTaskBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticAsyncTask_t equals the size of the real async
+			task structure. */
+			volatile size_t xSize = sizeof( StaticAsyncTask_t );
+			configASSERT( xSize == sizeof( AsyncTask_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( pxAsyncTask != NULL )
+		{
+			/* Remember this was statically allocated in case it is ever
+			deleted. */
+			prvInitialiseNewAsyncTask( pxExecutor, pxTaskCode, pvParameters, pxAsyncTask, asyncFLAGS_IS_STATICALLY_ALLOCATED );
+		}
+		else
+		{
+			traceASYNC_TASK_CREATE_FAILED();
+		}
+
+		return ( AsyncTaskHandle_t ) pxAsyncTask;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vAsyncTaskDelete( AsyncTaskHandle_t xAsyncTask )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+AsyncExecutor_t *pxExecutor;
+BaseType_t xFree;
+
+	configASSERT( pxAsyncTask );
+
+	taskENTER_CRITICAL();
+	{
+		pxExecutor = pxAsyncTask->pxExecutor;
+		traceASYNC_TASK_DELETE( pxAsyncTask );
+
+		if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxAsyncTask->xEventListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xStateListItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxAsyncTask->xStateListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( pxExecutor->uxNumberOfTasks )--;
+
+		if( pxExecutor->pxCurrentTask == pxAsyncTask )
+		{
+			/* The async task is running, possibly because it is deleting
+			itself, so the executor frees it once it returns. */
+			pxAsyncTask->ucFlags |= asyncFLAGS_DELETE_PENDING;
+			xFree = pdFALSE;
+		}
+		else if( ( pxAsyncTask->ucFlags & asyncFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+		{
+			xFree = pdTRUE;
+		}
+		else
+		{
+			/* The async task was statically allocated, so there is no memory
+			to free. */
+			xFree = pdFALSE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xFree != pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			vPortFree( ( void * ) pxAsyncTask );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt.
+			Force an assert. */
+			configASSERT( xAsyncTask == ( AsyncTaskHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAsyncTaskNotifyGive( AsyncTaskHandle_t xAsyncTask )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+
+	configASSERT( pxAsyncTask );
+
+	taskENTER_CRITICAL();
+	{
+		( pxAsyncTask->ulNotifiedValue )++;
+		traceASYNC_TASK_NOTIFY_GIVE( pxAsyncTask );
+
+		if( ( pxAsyncTask->ucFlags & asyncFLAGS_WAITING_FOR_NOTIFICATION ) != ( uint8_t ) 0 )
+		{
+			prvMakeReady( pxAsyncTask, pdFALSE, NULL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vAsyncTaskNotifyGiveFromISR( AsyncTaskHandle_t xAsyncTask, BaseType_t *pxHigherPriorityTaskWoken )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxAsyncTask );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		( pxAsyncTask->ulNotifiedValue )++;
+		traceASYNC_TASK_NOTIFY_GIVE( pxAsyncTask );
+
+		if( ( pxAsyncTask->ucFlags & asyncFLAGS_WAITING_FOR_NOTIFICATION ) != ( uint8_t ) 0 )
+		{
+			prvMakeReady( pxAsyncTask, pdTRUE, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xAsyncExecutorGetTaskHandle( AsyncExecutorHandle_t xExecutor )
+{
+const AsyncExecutor_t * const pxExecutor = ( AsyncExecutor_t * ) xExecutor;
+
+	configASSERT( pxExecutor );
+
+	return pxExecutor->xTask;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxAsyncExecutorGetNumberOfTasks( AsyncExecutorHandle_t xExecutor )
+{
+const AsyncExecutor_t * const pxExecutor = ( AsyncExecutor_t * ) xExecutor;
+
+	configASSERT( pxExecutor );
+
+	return pxExecutor->uxNumberOfTasks;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxAsyncTaskGetResumePoint( AsyncTaskHandle_t xAsyncTask )
+{
+	return ( ( AsyncTask_t * ) xAsyncTask )->uxResumePoint;
+}
+/*-----------------------------------------------------------*/
+
+void vAsyncTaskDelay( AsyncTaskHandle_t xAsyncTask, TickType_t xTicksToDelay, UBaseType_t uxResumePoint )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+
+	/* Only the running async task can delay itself. */
+	configASSERT( pxAsyncTask->pxExecutor->pxCurrentTask == pxAsyncTask );
+
+	pxAsyncTask->uxResumePoint = uxResumePoint;
+
+	if( xTicksToDelay > ( TickType_t ) 0 )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxAsyncTask->ucState = asyncWAITING;
+			prvAddToDelayedList( pxAsyncTask->pxExecutor, pxAsyncTask, xTicksToDelay );
+			traceASYNC_TASK_BLOCK( pxAsyncTask );
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		/* The async task is still running when it returns, so the executor
+		moves it to the end of the list of ready async tasks. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vAsyncTaskPrepareToWait( AsyncTaskHandle_t xAsyncTask, TickType_t xTicksToWait, UBaseType_t uxResumePoint )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+
+	configASSERT( pxAsyncTask->pxExecutor->pxCurrentTask == pxAsyncTask );
+
+	pxAsyncTask->uxResumePoint = uxResumePoint;
+	pxAsyncTask->xTicksToWait = xTicksToWait;
+	vTaskSetTimeOutState( &( pxAsyncTask->xTimeOut ) );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAsyncTaskNotifyTake( AsyncTaskHandle_t xAsyncTask, BaseType_t xClearCountOnExit, uint32_t *pulValue )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+BaseType_t xReturn;
+
+	configASSERT( pulValue );
+
+	taskENTER_CRITICAL();
+	{
+		if( pxAsyncTask->ulNotifiedValue != ( uint32_t ) 0 )
+		{
+			*pulValue = pxAsyncTask->ulNotifiedValue;
+
+			if( xClearCountOnExit != pdFALSE )
+			{
+				pxAsyncTask->ulNotifiedValue = ( uint32_t ) 0;
+			}
+			else
+			{
+				( pxAsyncTask->ulNotifiedValue )--;
+			}
+
+			xReturn = pdPASS;
+		}
+		else if( prvBlock( pxAsyncTask, NULL, ( TickType_t ) 0 ) != pdFALSE )
+		{
+			pxAsyncTask->ucFlags |= asyncFLAGS_WAITING_FOR_NOTIFICATION;
+			xReturn = errQUEUE_BLOCKED;
+		}
+		else
+		{
+			*pulValue = ( uint32_t ) 0;
+			xReturn = pdFAIL;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAsyncTaskQueueSend( AsyncTaskHandle_t xAsyncTask, QueueHandle_t xQueue, const void * const pvItemToQueue )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+BaseType_t xReturn, xBlocked;
+
+	xReturn = xQueueGenericSend( xQueue, pvItemToQueue, ( TickType_t ) 0, queueSEND_TO_BACK );
+
+	if( xReturn != pdPASS )
+	{
+		taskENTER_CRITICAL();
+		{
+			xBlocked = prvBlock( pxAsyncTask, ( List_t * ) pvQueueGetAsyncTaskList( xQueue ), asyncWAITING_TO_SEND );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBlocked != pdFALSE )
+		{
+			/* Space might have become available between the first attempt
+			and the async task starting to wait, in which case nothing would
+			wake it, so try once more. */
+			if( xQueueGenericSend( xQueue, pvItemToQueue, ( TickType_t ) 0, queueSEND_TO_BACK ) == pdPASS )
+			{
+				prvUnblock( pxAsyncTask );
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = errQUEUE_BLOCKED;
+			}
+		}
+		else
+		{
+			xReturn = errQUEUE_FULL;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAsyncTaskQueueReceive( AsyncTaskHandle_t xAsyncTask, QueueHandle_t xQueue, void * const pvBuffer )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+BaseType_t xReturn, xBlocked;
+
+	xReturn = xQueueReceive( xQueue, pvBuffer, ( TickType_t ) 0 );
+
+	if( xReturn != pdPASS )
+	{
+		taskENTER_CRITICAL();
+		{
+			xBlocked = prvBlock( pxAsyncTask, ( List_t * ) pvQueueGetAsyncTaskList( xQueue ), asyncWAITING_TO_RECEIVE );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBlocked != pdFALSE )
+		{
+			/* As in xAsyncTaskQueueSend(). */
+			if( xQueueReceive( xQueue, pvBuffer, ( TickType_t ) 0 ) == pdPASS )
+			{
+				prvUnblock( pxAsyncTask );
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = errQUEUE_BLOCKED;
+			}
+		}
+		else
+		{
+			xReturn = errQUEUE_EMPTY;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAsyncTaskStreamBufferSend( AsyncTaskHandle_t xAsyncTask, StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, size_t *pxBytesSent )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+BaseType_t xReturn = pdPASS, xBlocked;
+
+	configASSERT( pxBytesSent );
+
+	*pxBytesSent = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, ( TickType_t ) 0 );
+
+	if( *pxBytesSent == ( size_t ) 0 )
+	{
+		taskENTER_CRITICAL();
+		{
+			xBlocked = prvBlock( pxAsyncTask, ( List_t * ) pvStreamBufferGetAsyncTaskList( xStreamBuffer ), asyncWAITING_TO_SEND );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBlocked != pdFALSE )
+		{
+			/* As in xAsyncTaskQueueSend(). */
+			*pxBytesSent = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, ( TickType_t ) 0 );
+
+			if( *pxBytesSent != ( size_t ) 0 )
+			{
+				prvUnblock( pxAsyncTask );
+			}
+			else
+			{
+				xReturn = errQUEUE_BLOCKED;
+			}
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAsyncTaskStreamBufferReceive( AsyncTaskHandle_t xAsyncTask, StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, size_t *pxReceivedBytes )
+{
+AsyncTask_t * const pxAsyncTask = ( AsyncTask_t * ) xAsyncTask;
+BaseType_t xReturn = pdPASS, xBlocked;
+
+	configASSERT( pxReceivedBytes );
+
+	*pxReceivedBytes = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, ( TickType_t ) 0 );
+
+	if( *pxReceivedBytes == ( size_t ) 0 )
+	{
+		taskENTER_CRITICAL();
+		{
+			xBlocked = prvBlock( pxAsyncTask, ( List_t * ) pvStreamBufferGetAsyncTaskList( xStreamBuffer ), asyncWAITING_TO_RECEIVE );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBlocked != pdFALSE )
+		{
+			/* As in xAsyncTaskQueueSend(). */
+			*pxReceivedBytes = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, ( TickType_t ) 0 );
+
+			if( *pxReceivedBytes != ( size_t ) 0 )
+			{
+				prvUnblock( pxAsyncTask );
+			}
+			else
+			{
+				xReturn = errQUEUE_BLOCKED;
+			}
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vAsyncTaskWakeWaiting( List_t * const pxWaitingList, const TickType_t xEvent, UBaseType_t uxMaxToWake )
+{
+	taskENTER_CRITICAL();
+	{
+		prvWakeWaiting( pxWaitingList, xEvent, uxMaxToWake, pdFALSE, NULL );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vAsyncTaskWakeWaitingFromISR( List_t * const pxWaitingList, const TickType_t xEvent, UBaseType_t uxMaxToWake, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		prvWakeWaiting( pxWaitingList, xEvent, uxMaxToWake, pdTRUE, pxHigherPriorityTaskWoken );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static void prvExecutorTask( void *pvParameters )
+{
+AsyncExecutor_t * const pxExecutor = ( AsyncExecutor_t * ) pvParameters;
+AsyncTask_t *pxAsyncTask;
+TickType_t xTicksToWait = portMAX_DELAY;
+BaseType_t xFree;
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxAsyncTask = prvGetNextTask( pxExecutor, &xTicksToWait );
+		}
+		taskEXIT_CRITICAL();
+
+		if( pxAsyncTask != NULL )
+		{
+			/* The async task cannot be freed while it is the executor's
+			current async task, so its members can be read outside of a
+			critical section. */
+			traceASYNC_TASK_RESUME( pxAsyncTask );
+			pxAsyncTask->pxTaskCode( ( AsyncTaskHandle_t ) pxAsyncTask, pxAsyncTask->pvParameters );
+
+			taskENTER_CRITICAL();
+			{
+				pxExecutor->pxCurrentTask = NULL;
+				xFree = pdFALSE;
+
+				if( ( pxAsyncTask->ucFlags & asyncFLAGS_DELETE_PENDING ) != ( uint8_t ) 0 )
+				{
+					/* The async task was deleted while it was running, and
+					might have started to wait since. */
+					if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxAsyncTask->xEventListItem ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xStateListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxAsyncTask->xStateListItem ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( ( pxAsyncTask->ucFlags & asyncFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+					{
+						xFree = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( pxAsyncTask->ucState == asyncRUNNING )
+				{
+					/* The async task yielded, or returned without waiting, so
+					runs again after the other ready async tasks. */
+					pxAsyncTask->ucState = asyncREADY;
+					vListInsertEnd( &( pxExecutor->xReadyTasks ), &( pxAsyncTask->xStateListItem ) );
+				}
+				else
+				{
+					/* The async task is waiting, or was woken before it
+					returned so is already in the list of ready async tasks. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xFree != pdFALSE )
+			{
+				#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+				{
+					vPortFree( ( void * ) pxAsyncTask );
+				}
+				#endif
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* There is no async task to run.  An async task that became ready
+			after the executor was marked as idle leaves the notification
+			pending, so this does not block. */
+			( void ) ulTaskNotifyTakeIndexed( configASYNC_TASK_NOTIFICATION_INDEX, pdTRUE, xTicksToWait );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static AsyncTask_t *prvGetNextTask( AsyncExecutor_t * const pxExecutor, TickType_t * const pxTicksToWait )
+{
+const TickType_t xTimeNow = xTaskGetTickCount();
+AsyncTask_t *pxAsyncTask;
+
+	/* The executor is running so is no longer idle. */
+	pxExecutor->xIsIdle = pdFALSE;
+
+	prvMoveWokenDelayedTasks( pxExecutor, xTimeNow );
+
+	if( listLIST_IS_EMPTY( &( pxExecutor->xReadyTasks ) ) == pdFALSE )
+	{
+		/* Take the async task that has been ready the longest, which is at
+		the head of the list. */
+		pxAsyncTask = ( AsyncTask_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxExecutor->xReadyTasks ) ); /*lint !e9087 !e9079 void * is used as the list owner. */
+		( void ) uxListRemove( &( pxAsyncTask->xStateListItem ) );
+		pxAsyncTask->ucState = asyncRUNNING;
+		pxExecutor->pxCurrentTask = pxAsyncTask;
+	}
+	else
+	{
+		/* Wait until the first delayed async task wakes.  The tick count
+		might overflow first, but the subtraction still gives the number of
+		ticks until it wakes. */
+		pxExecutor->xIsIdle = pdTRUE;
+		pxAsyncTask = NULL;
+
+		if( listLIST_IS_EMPTY( pxExecutor->pxDelayedTasks ) == pdFALSE )
+		{
+			*pxTicksToWait = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxExecutor->pxDelayedTasks ) - xTimeNow;
+		}
+		else if( listLIST_IS_EMPTY( pxExecutor->pxOverflowDelayedTasks ) == pdFALSE )
+		{
+			*pxTicksToWait = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxExecutor->pxOverflowDelayedTasks ) - xTimeNow;
+		}
+		else
+		{
+			*pxTicksToWait = portMAX_DELAY;
+		}
+	}
+
+	return pxAsyncTask;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewAsyncTask( AsyncExecutor_t * const pxExecutor, AsyncTaskFunction_t pxTaskCode, void *pvParameters, AsyncTask_t * const pxAsyncTask, const uint8_t ucFlags )
+{
+	vListInitialiseItem( &( pxAsyncTask->xStateListItem ) );
+	listSET_LIST_ITEM_OWNER( &( pxAsyncTask->xStateListItem ), pxAsyncTask );
+	vListInitialiseItem( &( pxAsyncTask->xEventListItem ) );
+	listSET_LIST_ITEM_OWNER( &( pxAsyncTask->xEventListItem ), pxAsyncTask );
+	pxAsyncTask->pxTaskCode = pxTaskCode;
+	pxAsyncTask->pvParameters = pvParameters;
+	pxAsyncTask->pxExecutor = pxExecutor;
+	pxAsyncTask->xTicksToWait = ( TickType_t ) 0;
+	pxAsyncTask->ulNotifiedValue = ( uint32_t ) 0;
+	pxAsyncTask->uxResumePoint = ( UBaseType_t ) 0;
+	pxAsyncTask->ucState = asyncREADY;
+	pxAsyncTask->ucFlags = ucFlags;
+	traceASYNC_TASK_CREATE( pxAsyncTask );
+
+	taskENTER_CRITICAL();
+	{
+		( pxExecutor->uxNumberOfTasks )++;
+		prvMakeReady( pxAsyncTask, pdFALSE, NULL );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMakeReady( AsyncTask_t * const pxAsyncTask, const BaseType_t xFromISR, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+AsyncExecutor_t * const pxExecutor = pxAsyncTask->pxExecutor;
+
+	if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) != NULL )
+	{
+		( void ) uxListRemove( &( pxAsyncTask->xEventListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xStateListItem ) ) != NULL )
+	{
+		( void ) uxListRemove( &( pxAsyncTask->xStateListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxAsyncTask->ucState = asyncREADY;
+	pxAsyncTask->ucFlags &= ( uint8_t ) ~asyncFLAGS_WAITING_FOR_NOTIFICATION;
+	vListInsertEnd( &( pxExecutor->xReadyTasks ), &( pxAsyncTask->xStateListItem ) );
+
+	if( pxExecutor->xIsIdle != pdFALSE )
+	{
+		/* Once woken the executor is not idle, so it is only notified once. */
+		pxExecutor->xIsIdle = pdFALSE;
+
+		if( xFromISR == pdFALSE )
+		{
+			( void ) xTaskNotifyGiveIndexed( pxExecutor->xTask, configASYNC_TASK_NOTIFICATION_INDEX );
+		}
+		else
+		{
+			vTaskNotifyGiveIndexedFromISR( pxExecutor->xTask, configASYNC_TASK_NOTIFICATION_INDEX, pxHigherPriorityTaskWoken );
+		}
+	}
+	else
+	{
+		/* The executor is running, and will find the async task before it
+		next waits. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvBlock( AsyncTask_t * const pxAsyncTask, List_t * const pxWaitingList, const TickType_t xEvent )
+{
+BaseType_t xReturn;
+
+	if( xTaskCheckForTimeOut( &( pxAsyncTask->xTimeOut ), &( pxAsyncTask->xTicksToWait ) ) == pdFALSE )
+	{
+		pxAsyncTask->ucState = asyncWAITING;
+
+		if( pxWaitingList != NULL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxAsyncTask->xEventListItem ), xEvent );
+			vListInsertEnd( pxWaitingList, &( pxAsyncTask->xEventListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( pxAsyncTask->xTicksToWait != portMAX_DELAY )
+			{
+				prvAddToDelayedList( pxAsyncTask->pxExecutor, pxAsyncTask, pxAsyncTask->xTicksToWait );
+			}
+			else
+			{
+				/* Wait indefinitely. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			prvAddToDelayedList( pxAsyncTask->pxExecutor, pxAsyncTask, pxAsyncTask->xTicksToWait );
+		}
+		#endif /* INCLUDE_vTaskSuspend */
+
+		traceASYNC_TASK_BLOCK( pxAsyncTask );
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnblock( AsyncTask_t * const pxAsyncTask )
+{
+	taskENTER_CRITICAL();
+	{
+		/* The async task might also have been woken, and so be in the list of
+		ready async tasks. */
+		if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxAsyncTask->xEventListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xStateListItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxAsyncTask->xStateListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxAsyncTask->ucState = asyncRUNNING;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddToDelayedList( AsyncExecutor_t * const pxExecutor, AsyncTask_t * const pxAsyncTask, const TickType_t xTicksToWait )
+{
+const TickType_t xTimeNow = xTaskGetTickCount();
+const TickType_t xWakeTime = xTimeNow + xTicksToWait;
+
+	/* Check for the tick count overflowing before the async task is placed in
+	one of the lists of delayed async tasks. */
+	prvMoveWokenDelayedTasks( pxExecutor, xTimeNow );
+
+	listSET_LIST_ITEM_VALUE( &( pxAsyncTask->xStateListItem ), xWakeTime );
+
+	if( xWakeTime < xTimeNow )
+	{
+		/* The wake time has overflowed. */
+		vListInsert( pxExecutor->pxOverflowDelayedTasks, &( pxAsyncTask->xStateListItem ) );
+	}
+	else
+	{
+		vListInsert( pxExecutor->pxDelayedTasks, &( pxAsyncTask->xStateListItem ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMoveWokenDelayedTasks( AsyncExecutor_t * const pxExecutor, const TickType_t xTimeNow )
+{
+AsyncTask_t *pxAsyncTask;
+List_t *pxTemp;
+
+	if( xTimeNow < pxExecutor->xLastTime )
+	{
+		/* The tick count has overflowed, so every async task remaining in the
+		current list of delayed async tasks woke before the overflow.  Then
+		switch the lists, as explained in the same situation in timers.c. */
+		while( listLIST_IS_EMPTY( pxExecutor->pxDelayedTasks ) == pdFALSE )
+		{
+			pxAsyncTask = ( AsyncTask_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxExecutor->pxDelayedTasks ); /*lint !e9087 !e9079 void * is used as the list owner. */
+			prvMakeReady( pxAsyncTask, pdFALSE, NULL );
+		}
+
+		pxTemp = pxExecutor->pxDelayedTasks;
+		pxExecutor->pxDelayedTasks = pxExecutor->pxOverflowDelayedTasks;
+		pxExecutor->pxOverflowDelayedTasks = pxTemp;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxExecutor->xLastTime = xTimeNow;
+
+	/* The current list is ordered by wake time, so stop at the first async
+	task that has not woken yet.  An async task that was waiting for a kernel
+	object finds that its wait has timed out when it runs. */
+	while( ( listLIST_IS_EMPTY( pxExecutor->pxDelayedTasks ) == pdFALSE ) && ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxExecutor->pxDelayedTasks ) <= xTimeNow ) )
+	{
+		pxAsyncTask = ( AsyncTask_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxExecutor->pxDelayedTasks ); /*lint !e9087 !e9079 void * is used as the list owner. */
+		prvMakeReady( pxAsyncTask, pdFALSE, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeWaiting( List_t * const pxWaitingList, const TickType_t xEvent, UBaseType_t uxMaxToWake, const BaseType_t xFromISR, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+ListItem_t *pxItem, *pxNext;
+
+	/* Async tasks are woken in the order in which they started to wait, but
+	only those waiting for xEvent. */
+	pxItem = listGET_HEAD_ENTRY( pxWaitingList );
+
+	while( ( pxItem != listGET_END_MARKER( pxWaitingList ) ) && ( uxMaxToWake > ( UBaseType_t ) 0 ) )
+	{
+		pxNext = listGET_NEXT( pxItem );
+
+		if( listGET_LIST_ITEM_VALUE( pxItem ) == xEvent )
+		{
+			prvMakeReady( ( AsyncTask_t * ) listGET_LIST_ITEM_OWNER( pxItem ), xFromISR, pxHigherPriorityTaskWoken ); /*lint !e9087 !e9079 void * is used as the list owner. */
+			uxMaxToWake--;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxItem = pxNext;
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include async task functionality.  If you want to include async tasks then
+ensure configUSE_ASYNC_TASKS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_ASYNC_TASKS == 1 */
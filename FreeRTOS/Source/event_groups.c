@@ -60,10 +60,43 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
 #endif
 
+/* Tasks waiting for bits are held in configEVENT_GROUP_WAIT_LISTS lists, so
+setting a bit only has to check the tasks in the list that the bit maps to.  A
+task waiting for all of a set of bits is held in the list of one of the bits it
+is waiting for that is not yet set, as it cannot be unblocked until that bit
+is set.  A task waiting for any of a set of bits is held in the list the bits
+map to, or in xTasksWaitingForAnyBits if they map to more than one list.  With
+a single list every task is checked each time a bit is set, as in previous
+versions. */
+#define eventWAIT_LISTS					( ( UBaseType_t ) configEVENT_GROUP_WAIT_LISTS )
+#define eventWAIT_LIST_INDEX( uxBit )	( ( UBaseType_t ) ( uxBit ) % eventWAIT_LISTS )
+
+/* When configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR is 1 interrupts set bits, and
+unblock tasks, directly, so tasks lock the event group while they access the
+lists of waiting tasks with the scheduler suspended - in the same way queues
+are locked. */
+#if( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+	#define eventLOCK( pxEventBits )	prvLockEventGroup( pxEventBits )
+	#define eventUNLOCK( pxEventBits )	prvUnlockEventGroup( pxEventBits )
+#else
+	#define eventLOCK( pxEventBits )
+	#define eventUNLOCK( pxEventBits )
+#endif
+
 typedef struct xEventGroupDefinition
 {
 	EventBits_t uxEventBits;
-	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
+	List_t xTasksWaitingForBits[ eventWAIT_LISTS ];	/*< Lists of tasks waiting for a bit to be set. */
+
+	#if( configEVENT_GROUP_WAIT_LISTS > 1 )
+		List_t xTasksWaitingForAnyBits;		/*< List of tasks waiting for any of a set of bits that map to more than one list. */
+		EventBits_t uxAnyBitsWaitedFor;		/*< The bits the tasks in xTasksWaitingForAnyBits are waiting for.  Can contain bits no task is waiting for any longer. */
+	#endif
+
+	#if( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+		volatile EventBits_t uxBitsSetFromISR;	/*< Bits set from interrupts while the event group was locked. */
+		volatile BaseType_t xLocked;			/*< Set to pdTRUE while a task is accessing the lists of waiting tasks. */
+	#endif
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
@@ -86,6 +119,59 @@ typedef struct xEventGroupDefinition
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Unblock every task in one of the lists of waiting tasks, as the event group
+ * is being deleted.
+ */
+static void prvUnblockAllTasks( const List_t *pxTasksWaitingForBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialise the members of a newly created event group.
+ */
+static void prvInitialiseNewEventGroup( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set bits in the event group, then unblock the tasks whose wait condition is
+ * met as a result.  Must be called with the scheduler suspended and the event
+ * group locked, or, if xFromISR is pdTRUE, from a critical section while the
+ * event group is not locked.  Returns pdTRUE if a task that has a priority
+ * above the calling task was unblocked.
+ */
+static BaseType_t prvSetBits( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Check the tasks in one of the lists of waiting tasks against the event bits,
+ * unblocking those whose wait condition is met and moving the others to the
+ * list they should now be held in.  The bits to clear because a task that was
+ * unblocked was waiting with the eventCLEAR_EVENTS_ON_EXIT_BIT set are added
+ * to *puxBitsToClear.
+ */
+static BaseType_t prvCheckWaitList( EventGroup_t *pxEventBits, List_t *pxList, EventBits_t * const puxBitsToClear, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the list a task that is waiting for uxBitsWaitedFor, which includes
+ * the control bits, should be held in.
+ */
+static List_t *prvSelectWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsWaitedFor ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return a bitmap of the lists of waiting tasks that the bits in uxBits map
+ * to.
+ */
+#if( configEVENT_GROUP_WAIT_LISTS > 1 )
+	static uint32_t prvGetWaitLists( EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Lock the event group so interrupts leave any bits they set for the task to
+ * set, then unlock it again, setting any bits that were set from interrupts
+ * while it was locked.  Must be called with the scheduler suspended.
+ */
+#if( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+	static void prvLockEventGroup( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+	static void prvUnlockEventGroup( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -112,8 +198,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 
 		if( pxEventBits != NULL )
 		{
-			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseNewEventGroup( pxEventBits );
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -148,8 +233,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 
 		if( pxEventBits != NULL )
 		{
-			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseNewEventGroup( pxEventBits );
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -189,10 +273,12 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventLOCK( pxEventBits );
 	{
 		uxOriginalBitValue = pxEventBits->uxEventBits;
 
-		( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+		( void ) prvSetBits( pxEventBits, uxBitsToSet, pdFALSE );
 
 		if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
 		{
@@ -214,7 +300,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				vTaskPlaceOnUnorderedEventList( prvSelectWaitList( pxEventBits, ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ) ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -231,6 +317,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			}
 		}
 	}
+	eventUNLOCK( pxEventBits );
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -312,6 +399,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventLOCK( pxEventBits );
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -369,7 +457,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			vTaskPlaceOnUnorderedEventList( prvSelectWaitList( pxEventBits, ( uxBitsToWaitFor | uxControlBits ) ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -379,6 +467,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
 	}
+	eventUNLOCK( pxEventBits );
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -491,11 +580,11 @@ UBaseType_t uxSavedInterruptStatus;
 EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
 EventBits_t uxReturn;
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		uxReturn = pxEventBits->uxEventBits;
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return uxReturn;
 }
@@ -503,114 +592,416 @@ EventBits_t uxReturn;
 
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
-ListItem_t *pxListItem, *pxNext;
-ListItem_t const *pxListEnd;
-List_t *pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
 EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
-BaseType_t xMatchFound = pdFALSE;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
+	eventLOCK( pxEventBits );
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+		( void ) prvSetBits( pxEventBits, uxBitsToSet, pdFALSE );
+	}
+	eventUNLOCK( pxEventBits );
+	( void ) xTaskResumeAll();
+
+	return pxEventBits->uxEventBits;
+}
+/*-----------------------------------------------------------*/
 
-		pxListItem = listGET_HEAD_ENTRY( pxList );
+static BaseType_t prvSetBits( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR )
+{
+EventBits_t uxBitsToClear = 0, uxNewBits;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+#if( configEVENT_GROUP_WAIT_LISTS > 1 )
+	UBaseType_t uxList;
+	uint32_t ulWaitListsToCheck;
+#endif
 
-		/* Set the bits. */
-		pxEventBits->uxEventBits |= uxBitsToSet;
+	/* A task only blocks if its wait condition is not met, and a wait
+	condition can only become met when a bit is set that was not set before,
+	so only the lists that bits being set for the first time map to need to be
+	checked. */
+	uxNewBits = uxBitsToSet & ~( pxEventBits->uxEventBits );
 
-		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
-		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
+	/* Set the bits. */
+	pxEventBits->uxEventBits |= uxBitsToSet;
 
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+	#if( configEVENT_GROUP_WAIT_LISTS == 1 )
+	{
+		if( uxNewBits != ( EventBits_t ) 0 )
+		{
+			xHigherPriorityTaskWoken = prvCheckWaitList( pxEventBits, &( pxEventBits->xTasksWaitingForBits[ 0 ] ), &uxBitsToClear, xFromISR );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		ulWaitListsToCheck = prvGetWaitLists( uxNewBits );
 
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+		for( uxList = 0; ulWaitListsToCheck != 0UL; uxList++ )
+		{
+			if( ( ulWaitListsToCheck & ( 1UL << uxList ) ) != 0UL )
 			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+				ulWaitListsToCheck &= ~( 1UL << uxList );
+
+				if( prvCheckWaitList( pxEventBits, &( pxEventBits->xTasksWaitingForBits[ uxList ] ), &uxBitsToClear, xFromISR ) != pdFALSE )
 				{
-					xMatchFound = pdTRUE;
+					xHigherPriorityTaskWoken = pdTRUE;
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( ( uxNewBits & pxEventBits->uxAnyBitsWaitedFor ) != ( EventBits_t ) 0 )
+		{
+			/* The bits waited for by the tasks that remain in the list are
+			recalculated as the list is checked. */
+			pxEventBits->uxAnyBitsWaitedFor = 0;
+
+			if( prvCheckWaitList( pxEventBits, &( pxEventBits->xTasksWaitingForAnyBits ), &uxBitsToClear, xFromISR ) != pdFALSE )
+			{
+				xHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configEVENT_GROUP_WAIT_LISTS */
+
+	/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+	bit was set in the control word. */
+	pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckWaitList( EventGroup_t *pxEventBits, List_t *pxList, EventBits_t * const puxBitsToClear, const BaseType_t xFromISR )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd;
+EventBits_t uxBitsWaitedFor, uxControlBits;
+BaseType_t xMatchFound, xHigherPriorityTaskWoken = pdFALSE;
+#if( configEVENT_GROUP_WAIT_LISTS > 1 )
+	List_t *pxNewList;
+#endif
+
+	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	pxListItem = listGET_HEAD_ENTRY( pxList );
+
+	/* See if the new bit value should unblock any tasks. */
+	while( pxListItem != pxListEnd )
+	{
+		pxNext = listGET_NEXT( pxListItem );
+		uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+		xMatchFound = pdFALSE;
+
+		/* Split the bits waited for from the control bits. */
+		uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+		uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+		if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+		{
+			/* Just looking for single bit being set. */
+			if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
 			{
-				/* All bits are set. */
 				xMatchFound = pdTRUE;
 			}
 			else
 			{
-				/* Need all bits to be set, but not all the bits were set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+		{
+			/* All bits are set. */
+			xMatchFound = pdTRUE;
+		}
+		else
+		{
+			/* Need all bits to be set, but not all the bits were set. */
+		}
+
+		if( xMatchFound != pdFALSE )
+		{
+			/* The bits match.  Should the bits be cleared on exit? */
+			if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+			{
+				*puxBitsToClear |= uxBitsWaitedFor;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
 			}
 
-			if( xMatchFound != pdFALSE )
+			/* Store the actual event flag value in the task's event list
+			item before removing the task from the event list.  The
+			eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+			that is was unblocked due to its required bits matching, rather
+			than because it timed out. */
+			#if( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+			{
+				if( xFromISR != pdFALSE )
+				{
+					if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+					{
+						xHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+				}
+			}
+			#else
+			{
+				( void ) xFromISR;
+				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
+			#endif /* configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR */
+		}
+		else
+		{
+			#if( configEVENT_GROUP_WAIT_LISTS > 1 )
 			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+				/* A task waiting for all of a set of bits might now have to
+				wait for a bit that maps to a different list. */
+				pxNewList = prvSelectWaitList( pxEventBits, uxBitsWaitedFor | uxControlBits );
+
+				if( pxNewList != pxList )
 				{
-					uxBitsToClear |= uxBitsWaitedFor;
+					( void ) uxListRemove( pxListItem );
+					vListInsertEnd( pxNewList, pxListItem );
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+			}
+			#endif /* configEVENT_GROUP_WAIT_LISTS */
+		}
+
+		/* Move onto the next list item.  Note pxListItem->pxNext is not
+		used here as the list item may have been removed from the event list
+		and inserted into the ready/pending reading list. */
+		pxListItem = pxNext;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static List_t *prvSelectWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsWaitedFor )
+{
+List_t *pxList;
+#if( configEVENT_GROUP_WAIT_LISTS > 1 )
+	EventBits_t uxBits = uxBitsWaitedFor & ~eventEVENT_BITS_CONTROL_BYTES;
+	UBaseType_t uxBit = 0;
+	uint32_t ulWaitLists;
+#endif
+
+	#if( configEVENT_GROUP_WAIT_LISTS == 1 )
+	{
+		( void ) uxBitsWaitedFor;
+		pxList = &( pxEventBits->xTasksWaitingForBits[ 0 ] );
+	}
+	#else
+	{
+		if( ( uxBitsWaitedFor & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 )
+		{
+			/* Use the list of the lowest bit the task is waiting for that is
+			not set.  There must be one, as the task would otherwise not be
+			waiting. */
+			uxBits &= ~( pxEventBits->uxEventBits );
+			configASSERT( uxBits );
+
+			while( ( uxBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0 )
+			{
+				uxBits >>= 1;
+				uxBit++;
+			}
+
+			pxList = &( pxEventBits->xTasksWaitingForBits[ eventWAIT_LIST_INDEX( uxBit ) ] );
+		}
+		else
+		{
+			ulWaitLists = prvGetWaitLists( uxBits );
+
+			if( ( ulWaitLists & ( ulWaitLists - 1UL ) ) == 0UL )
+			{
+				/* All the bits map to the same list. */
+				while( ( ulWaitLists & 1UL ) == 0UL )
+				{
+					ulWaitLists >>= 1;
+					uxBit++;
+				}
 
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
-				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+				pxList = &( pxEventBits->xTasksWaitingForBits[ uxBit ] );
+			}
+			else
+			{
+				pxEventBits->uxAnyBitsWaitedFor |= uxBits;
+				pxList = &( pxEventBits->xTasksWaitingForAnyBits );
+			}
+		}
+	}
+	#endif /* configEVENT_GROUP_WAIT_LISTS */
+
+	return pxList;
+}
+/*-----------------------------------------------------------*/
+
+#if( configEVENT_GROUP_WAIT_LISTS > 1 )
+
+	static uint32_t prvGetWaitLists( EventBits_t uxBits )
+	{
+	uint32_t ulWaitLists = 0;
+	UBaseType_t uxBit = 0;
+
+		while( uxBits != ( EventBits_t ) 0 )
+		{
+			if( ( uxBits & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+			{
+				ulWaitLists |= 1UL << eventWAIT_LIST_INDEX( uxBit );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
 			}
 
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
+			uxBits >>= 1;
+			uxBit++;
 		}
 
-		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-		bit was set in the control word. */
-		pxEventBits->uxEventBits &= ~uxBitsToClear;
+		return ulWaitLists;
 	}
-	( void ) xTaskResumeAll();
 
-	return pxEventBits->uxEventBits;
+#endif /* configEVENT_GROUP_WAIT_LISTS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+
+	static void prvLockEventGroup( EventGroup_t *pxEventBits )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxEventBits->xLocked = pdTRUE;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvUnlockEventGroup( EventGroup_t *pxEventBits )
+	{
+	EventBits_t uxBitsToSet;
+
+		/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+
+		/* Interrupts that executed while the event group was locked left the
+		bits they set in uxBitsSetFromISR.  Set them now, keeping the event
+		group locked until no more bits have been left. */
+		do
+		{
+			taskENTER_CRITICAL();
+			{
+				uxBitsToSet = pxEventBits->uxBitsSetFromISR;
+				pxEventBits->uxBitsSetFromISR = 0;
+
+				if( uxBitsToSet == ( EventBits_t ) 0 )
+				{
+					pxEventBits->xLocked = pdFALSE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( uxBitsToSet != ( EventBits_t ) 0 )
+			{
+				( void ) prvSetBits( pxEventBits, uxBitsToSet, pdFALSE );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		} while( uxBitsToSet != ( EventBits_t ) 0 );
+	}
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewEventGroup( EventGroup_t *pxEventBits )
+{
+UBaseType_t uxList;
+
+	pxEventBits->uxEventBits = 0;
+
+	for( uxList = ( UBaseType_t ) 0U; uxList < eventWAIT_LISTS; uxList++ )
+	{
+		vListInitialise( &( pxEventBits->xTasksWaitingForBits[ uxList ] ) );
+	}
+
+	#if( configEVENT_GROUP_WAIT_LISTS > 1 )
+	{
+		vListInitialise( &( pxEventBits->xTasksWaitingForAnyBits ) );
+		pxEventBits->uxAnyBitsWaitedFor = 0;
+	}
+	#endif /* configEVENT_GROUP_WAIT_LISTS */
+
+	#if( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+	{
+		pxEventBits->uxBitsSetFromISR = 0;
+		pxEventBits->xLocked = pdFALSE;
+	}
+	#endif /* configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR */
 }
 /*-----------------------------------------------------------*/
 
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
 EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
-const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+UBaseType_t uxList;
 
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		for( uxList = ( UBaseType_t ) 0U; uxList < eventWAIT_LISTS; uxList++ )
+		{
+			prvUnblockAllTasks( &( pxEventBits->xTasksWaitingForBits[ uxList ] ) );
+		}
+
+		#if( configEVENT_GROUP_WAIT_LISTS > 1 )
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			prvUnblockAllTasks( &( pxEventBits->xTasksWaitingForAnyBits ) );
 		}
+		#endif /* configEVENT_GROUP_WAIT_LISTS */
 
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
@@ -637,6 +1028,18 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 }
 /*-----------------------------------------------------------*/
 
+static void prvUnblockAllTasks( const List_t *pxTasksWaitingForBits )
+{
+	while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+	{
+		/* Unblock the task, returning 0 as the event list is being deleted
+		and cannot therefore have any bits set. */
+		configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+		vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+	}
+}
+/*-----------------------------------------------------------*/
+
 /* For internal use only - execute a 'set bits' command that was pended from
 an interrupt. */
 void vEventGroupSetBitsCallback( void *pvEventGroup, const uint32_t ulBitsToSet )
@@ -688,7 +1091,56 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+
+	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xYieldRequired = pdFALSE;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		/* See the comments in xQueueGenericSendFromISR() regarding the
+		priority of the interrupts that can call this function. */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		/* A critical section rather than just masking interrupts, so the
+		lock is checked and the waiting tasks unblocked atomically with respect
+		to tasks locking the event group on other cores too. */
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+			if( pxEventBits->xLocked == pdFALSE )
+			{
+				/* No task is accessing the lists of waiting tasks, so set the
+				bits and unblock the waiting tasks now. */
+				xYieldRequired = prvSetBits( pxEventBits, uxBitsToSet, pdTRUE );
+			}
+			else
+			{
+				/* A task is accessing the lists of waiting tasks.  Leave the
+				bits for the task to set when it unlocks the event group. */
+				pxEventBits->uxBitsSetFromISR |= uxBitsToSet;
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pdPASS;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
@@ -58,6 +58,18 @@ extern "C" {
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
+/* Must be defaulted before portable.h is included as the port layer provides
+additional definitions when the scheduler runs on more than one core. */
+#ifndef configNUM_CORES
+	#define configNUM_CORES 1
+#endif
+
+/* Must be defaulted before portable.h is included as it changes the structure
+used to report heap statistics. */
+#ifndef configUSE_HEAP_INSTRUMENTATION
+	#define configUSE_HEAP_INSTRUMENTATION 0
+#endif
+
 /* Definitions specific to the port being used. */
 #include "portable.h"
 
@@ -202,6 +214,21 @@ extern "C" {
 	#define configUSE_MUTEXES 0
 #endif
 
+#ifndef configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+	/* Set to 1 to have priority inheritance follow chains of tasks blocked on
+	mutexes held by other tasks.  This also changes when a priority is
+	disinherited.  Normally a task that holds several mutexes keeps its
+	inherited priority until it has given back every one of them.  With this
+	option the priority is recalculated each time a mutex is given, from the
+	tasks still waiting for the mutexes the task holds, so can drop while other
+	mutexes are still held. */
+	#define configUSE_TRANSITIVE_PRIORITY_INHERITANCE 0
+#endif
+
+#ifndef configMAX_INHERITANCE_CHAIN_LENGTH
+	#define configMAX_INHERITANCE_CHAIN_LENGTH 8
+#endif
+
 #ifndef configUSE_TIMERS
 	#define configUSE_TIMERS 0
 #endif
@@ -500,6 +527,22 @@ extern "C" {
 	#define traceTASK_DELAY_UNTIL( x )
 #endif
 
+#ifndef traceTASK_WAIT_FOR_NEXT_PERIOD
+	#define traceTASK_WAIT_FOR_NEXT_PERIOD( xTimeToWake )
+#endif
+
+#ifndef traceTASK_DEADLINE_MISSED
+	#define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
+#ifndef traceTASK_BUDGET_EXHAUSTED
+	#define traceTASK_BUDGET_EXHAUSTED( pxTCB )
+#endif
+
+#ifndef traceTASK_BUDGET_REPLENISHED
+	#define traceTASK_BUDGET_REPLENISHED( pxTCB )
+#endif
+
 #ifndef traceTASK_DELAY
 	#define traceTASK_DELAY()
 #endif
@@ -688,6 +731,126 @@ extern "C" {
 	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef tracePOOL_CREATE
+	#define tracePOOL_CREATE( pxPool )
+#endif
+
+#ifndef tracePOOL_CREATE_FAILED
+	#define tracePOOL_CREATE_FAILED()
+#endif
+
+#ifndef tracePOOL_DELETE
+	#define tracePOOL_DELETE( xPool )
+#endif
+
+#ifndef tracePOOL_ALLOC
+	#define tracePOOL_ALLOC( xPool, pvObject )
+#endif
+
+#ifndef tracePOOL_ALLOC_FAILED
+	#define tracePOOL_ALLOC_FAILED( xPool )
+#endif
+
+#ifndef tracePOOL_FREE
+	#define tracePOOL_FREE( xPool, pvObject )
+#endif
+
+#ifndef traceRWLOCK_CREATE
+	#define traceRWLOCK_CREATE( pxRWLock )
+#endif
+
+#ifndef traceRWLOCK_CREATE_FAILED
+	#define traceRWLOCK_CREATE_FAILED()
+#endif
+
+#ifndef traceRWLOCK_DELETE
+	#define traceRWLOCK_DELETE( xRWLock )
+#endif
+
+#ifndef traceRWLOCK_TAKE
+	#define traceRWLOCK_TAKE( xRWLock, xExclusive )
+#endif
+
+#ifndef traceRWLOCK_TAKE_FAILED
+	#define traceRWLOCK_TAKE_FAILED( xRWLock, xExclusive )
+#endif
+
+#ifndef traceBLOCKING_ON_RWLOCK_TAKE
+	#define traceBLOCKING_ON_RWLOCK_TAKE( xRWLock, xExclusive )
+#endif
+
+#ifndef traceRWLOCK_GIVE
+	#define traceRWLOCK_GIVE( xRWLock, xExclusive )
+#endif
+
+#ifndef traceWORK_QUEUE_CREATE
+	#define traceWORK_QUEUE_CREATE( pxWorkQueue )
+#endif
+
+#ifndef traceWORK_QUEUE_CREATE_FAILED
+	#define traceWORK_QUEUE_CREATE_FAILED()
+#endif
+
+#ifndef traceWORK_ITEM_CREATE
+	#define traceWORK_ITEM_CREATE( pxWorkItem )
+#endif
+
+#ifndef traceWORK_ITEM_CREATE_FAILED
+	#define traceWORK_ITEM_CREATE_FAILED()
+#endif
+
+#ifndef traceWORK_ITEM_DELETE
+	#define traceWORK_ITEM_DELETE( xWorkItem )
+#endif
+
+#ifndef traceWORK_ITEM_SUBMIT
+	#define traceWORK_ITEM_SUBMIT( xWorkQueue, xWorkItem, xDelay )
+#endif
+
+#ifndef traceWORK_ITEM_SUBMIT_FAILED
+	#define traceWORK_ITEM_SUBMIT_FAILED( xWorkQueue, xWorkItem )
+#endif
+
+#ifndef traceWORK_ITEM_CANCEL
+	#define traceWORK_ITEM_CANCEL( xWorkItem )
+#endif
+
+#ifndef traceWORK_ITEM_START
+	#define traceWORK_ITEM_START( pxWorkQueue, pxWorkItem )
+#endif
+
+#ifndef traceASYNC_EXECUTOR_CREATE
+	#define traceASYNC_EXECUTOR_CREATE( pxAsyncExecutor )
+#endif
+
+#ifndef traceASYNC_EXECUTOR_CREATE_FAILED
+	#define traceASYNC_EXECUTOR_CREATE_FAILED()
+#endif
+
+#ifndef traceASYNC_TASK_CREATE
+	#define traceASYNC_TASK_CREATE( pxAsyncTask )
+#endif
+
+#ifndef traceASYNC_TASK_CREATE_FAILED
+	#define traceASYNC_TASK_CREATE_FAILED()
+#endif
+
+#ifndef traceASYNC_TASK_DELETE
+	#define traceASYNC_TASK_DELETE( pxAsyncTask )
+#endif
+
+#ifndef traceASYNC_TASK_RESUME
+	#define traceASYNC_TASK_RESUME( pxAsyncTask )
+#endif
+
+#ifndef traceASYNC_TASK_BLOCK
+	#define traceASYNC_TASK_BLOCK( pxAsyncTask )
+#endif
+
+#ifndef traceASYNC_TASK_NOTIFY_GIVE
+	#define traceASYNC_TASK_NOTIFY_GIVE( pxAsyncTask )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -706,6 +869,46 @@ extern "C" {
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+#ifndef configRUN_TIME_COUNTER_TYPE
+	/* Defaults to uint32_t for backward compatibility, but can be overridden
+	in FreeRTOSConfig.h, for example with uint64_t if the run time counter
+	clock is fast enough to overflow a 32-bit counter, in which case
+	portGET_RUN_TIME_COUNTER_VALUE() should return a value of the same type. */
+	#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
+#ifndef configGENERATE_TASK_SWITCH_STATS
+	#define configGENERATE_TASK_SWITCH_STATS 0
+#endif
+
+#if ( configGENERATE_TASK_SWITCH_STATS == 1 )
+	#if ( configGENERATE_RUN_TIME_STATS != 1 )
+		#error configGENERATE_RUN_TIME_STATS must be 1 if configGENERATE_TASK_SWITCH_STATS is 1 as the statistics are measured with the run time stats counter.
+	#endif
+#endif /* configGENERATE_TASK_SWITCH_STATS */
+
+#ifndef configGENERATE_SCHEDULING_LATENCY_STATS
+	#define configGENERATE_SCHEDULING_LATENCY_STATS 0
+#endif
+
+#ifndef configSCHEDULING_LATENCY_BUCKETS
+	/* The number of buckets in each scheduling latency histogram.  Bucket n
+	counts latencies of at least 2^n run time counter counts, and less than
+	2^(n+1) counts, except the last bucket, which counts all longer latencies,
+	and bucket 0, which also counts latencies of 0. */
+	#define configSCHEDULING_LATENCY_BUCKETS 16
+#endif
+
+#if ( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+	#if ( configGENERATE_RUN_TIME_STATS != 1 )
+		#error configGENERATE_RUN_TIME_STATS must be 1 if configGENERATE_SCHEDULING_LATENCY_STATS is 1 as latencies are measured with the run time stats counter.
+	#endif
+
+	#if ( ( configSCHEDULING_LATENCY_BUCKETS < 1 ) || ( configSCHEDULING_LATENCY_BUCKETS > 64 ) )
+		#error configSCHEDULING_LATENCY_BUCKETS must be between 1 and 64.
+	#endif
+#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
@@ -719,7 +922,14 @@ extern "C" {
 #endif
 
 #ifndef portYIELD_WITHIN_API
-	#define portYIELD_WITHIN_API portYIELD
+	#if( configNUM_CORES > 1 )
+		/* When more than one core is used a yield requested from within a
+		critical section is held pending until the critical section is exited,
+		as the kernel lock cannot be held across a context switch. */
+		#define portYIELD_WITHIN_API vTaskYieldWithinAPI
+	#else
+		#define portYIELD_WITHIN_API portYIELD
+	#endif
 #endif
 
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
@@ -738,6 +948,10 @@ extern "C" {
 	#define configUSE_TICKLESS_IDLE 0
 #endif
 
+#ifndef configUSE_GENERIC_TICKLESS_IDLE
+	#define configUSE_GENERIC_TICKLESS_IDLE 0
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
 	#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -754,6 +968,38 @@ extern "C" {
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef configUSE_SPSC_QUEUES
+	#define configUSE_SPSC_QUEUES 0
+#endif
+
+#ifndef configUSE_MPMC_STREAM_BUFFERS
+	#define configUSE_MPMC_STREAM_BUFFERS 0
+#endif
+
+#ifndef configUSE_ASYNC_TASKS
+	#define configUSE_ASYNC_TASKS 0
+#endif
+
+#ifndef configUSE_RWLOCKS
+	#define configUSE_RWLOCKS 0
+#endif
+
+#ifndef configTASK_POOL_LENGTH
+	#define configTASK_POOL_LENGTH 0
+#endif
+
+#ifndef configQUEUE_POOL_LENGTH
+	#define configQUEUE_POOL_LENGTH 0
+#endif
+
+#ifndef configQUEUE_POOL_STORAGE_BYTES
+	#define configQUEUE_POOL_STORAGE_BYTES 0
+#endif
+
+#ifndef configTIMER_POOL_LENGTH
+	#define configTIMER_POOL_LENGTH 0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
 	#define portTASK_USES_FLOATING_POINT()
 #endif
@@ -794,10 +1040,53 @@ extern "C" {
 	#define portASSERT_IF_IN_ISR()
 #endif
 
+#ifndef portMEMORY_BARRIER
+	/* Prevents memory accesses being reordered across it.  The default only
+	prevents the compiler reordering them, which is sufficient on a single core
+	that is not weakly ordered.  Ports for multi-core or weakly ordered hardware
+	must define portMEMORY_BARRIER() to also issue a hardware barrier. */
+	#define portUSING_DEFAULT_MEMORY_BARRIER 1
+
+	#if defined( __GNUC__ ) || defined( __IAR_SYSTEMS_ICC__ )
+		#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+	#elif defined( __CC_ARM )
+		#define portMEMORY_BARRIER() __memory_changed()
+	#else
+		/* The compiler is not known, so rely on the indexes that the barrier
+		orders accesses against being volatile. */
+		#define portMEMORY_BARRIER()
+	#endif
+#endif
+
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
 #endif
 
+#ifndef configUSE_BITMAP_TASK_SELECTION
+	#define configUSE_BITMAP_TASK_SELECTION 0
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#ifndef configEDF_TASK_PRIORITY
+	/* The priority at which tasks created by xTaskCreateDeadline() run. */
+	#define configEDF_TASK_PRIORITY ( configMAX_PRIORITIES - 1 )
+#endif
+
+#ifndef configUSE_DEADLINE_MISS_HOOK
+	#define configUSE_DEADLINE_MISS_HOOK 0
+#endif
+
+#ifndef configUSE_TASK_BUDGETS
+	#define configUSE_TASK_BUDGETS 0
+#endif
+
+#ifndef configUSE_BUDGET_EXHAUSTED_HOOK
+	#define configUSE_BUDGET_EXHAUSTED_HOOK 0
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
@@ -806,6 +1095,22 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#ifndef configWORK_QUEUE_NOTIFICATION_INDEX
+	/* The index of the task notification used to wake work queue worker
+	tasks.  Work functions can use the other indexes. */
+	#define configWORK_QUEUE_NOTIFICATION_INDEX 0
+#endif
+
+#ifndef configASYNC_TASK_NOTIFICATION_INDEX
+	/* The index of the task notification used to wake the tasks that run async
+	tasks.  Async tasks have their own notification value. */
+	#define configASYNC_TASK_NOTIFICATION_INDEX 0
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
@@ -826,6 +1131,56 @@ extern "C" {
 	#define configSTACK_DEPTH_TYPE uint16_t
 #endif
 
+#ifndef configUSE_DELAYED_TASK_WHEEL
+	/* Defaults to 0 so Blocked tasks are held in sorted delayed lists, as in
+	previous versions. */
+	#define configUSE_DELAYED_TASK_WHEEL 0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SLOT_BITS
+	#define configDELAYED_TASK_WHEEL_SLOT_BITS 4
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	/* Defaults to 0 so active software timers are held in sorted lists, as in
+	previous versions. */
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+	#define configTIMER_WHEEL_SLOT_BITS 4
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH_SIZE
+	/* The maximum number of commands the timer service task receives from the
+	timer queue at a time.  Each command received at once occupies space on the
+	timer service task's stack. */
+	#define configTIMER_COMMAND_BATCH_SIZE 1
+#endif
+
+#ifndef configUSE_TIMER_SLACK
+	#define configUSE_TIMER_SLACK 0
+#endif
+
+#ifndef configEVENT_GROUP_WAIT_LISTS
+	/* Defaults to 1 so the tasks waiting on an event group are held in a
+	single list, as in previous versions. */
+	#define configEVENT_GROUP_WAIT_LISTS 1
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR
+	#define configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR 0
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+	#define configUSE_CORE_AFFINITY 0
+#endif
+
+#ifndef configTASK_DEFAULT_CORE_AFFINITY
+	/* By default a task can run on any core. */
+	#define configTASK_DEFAULT_CORE_AFFINITY ( ~( ( UBaseType_t ) 0U ) )
+#endif
+
 /* Sanity check the configuration. */
 #if( configUSE_TICKLESS_IDLE != 0 )
 	#if( INCLUDE_vTaskSuspend != 1 )
@@ -833,14 +1188,158 @@ extern "C" {
 	#endif /* INCLUDE_vTaskSuspend */
 #endif /* configUSE_TICKLESS_IDLE */
 
+#if( configUSE_BITMAP_TASK_SELECTION == 1 )
+	#if( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+		#error configUSE_BITMAP_TASK_SELECTION and configUSE_PORT_OPTIMISED_TASK_SELECTION cannot both be set to 1.  Some ports set configUSE_PORT_OPTIMISED_TASK_SELECTION to 1 by default, so it must be set to 0 in FreeRTOSConfig.h when configUSE_BITMAP_TASK_SELECTION is set to 1.
+	#endif
+
+	#if( configMAX_PRIORITIES > 1024 )
+		#error configMAX_PRIORITIES cannot exceed 1024 when configUSE_BITMAP_TASK_SELECTION is 1.
+	#endif
+#endif /* configUSE_BITMAP_TASK_SELECTION */
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+	#if( configEDF_TASK_PRIORITY >= configMAX_PRIORITIES )
+		#error configEDF_TASK_PRIORITY must be less than configMAX_PRIORITIES.
+	#endif
+
+	#if( configNUM_CORES > 1 )
+		#error configUSE_EDF_SCHEDULING must be 0 if configNUM_CORES is greater than 1.
+	#endif
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if( configUSE_TASK_BUDGETS == 1 )
+	#if( configGENERATE_RUN_TIME_STATS != 1 )
+		#error configGENERATE_RUN_TIME_STATS must be 1 if configUSE_TASK_BUDGETS is 1 as budgets are measured with the run time stats counter.
+	#endif
+
+	#if( configUSE_PREEMPTION != 1 )
+		#error configUSE_PREEMPTION must be 1 if configUSE_TASK_BUDGETS is 1.
+	#endif
+
+	#if( configNUM_CORES > 1 )
+		#error configUSE_TASK_BUDGETS must be 0 if configNUM_CORES is greater than 1.
+	#endif
+#endif /* configUSE_TASK_BUDGETS */
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	#if( ( configDELAYED_TASK_WHEEL_SLOT_BITS < 1 ) || ( configDELAYED_TASK_WHEEL_SLOT_BITS > 5 ) )
+		#error configDELAYED_TASK_WHEEL_SLOT_BITS must be between 1 and 5 as each level of the delayed task wheel has ( 1 << configDELAYED_TASK_WHEEL_SLOT_BITS ) slots.
+	#endif
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
+#if( configUSE_TIMER_WHEEL == 1 )
+	#if( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) )
+		#error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5 as each level of the active timer wheel has ( 1 << configTIMER_WHEEL_SLOT_BITS ) slots.
+	#endif
+#endif /* configUSE_TIMER_WHEEL */
+
+#if( configTIMER_COMMAND_BATCH_SIZE < 1 )
+	#error configTIMER_COMMAND_BATCH_SIZE must be at least 1.
+#endif
+
+#if( configEVENT_GROUP_WAIT_LISTS < 1 )
+	#error configEVENT_GROUP_WAIT_LISTS must be at least 1.
+#endif
+
+#if( ( configUSE_16_BIT_TICKS == 1 ) && ( configEVENT_GROUP_WAIT_LISTS > 8 ) )
+	#error configEVENT_GROUP_WAIT_LISTS cannot exceed 8, the number of bits an event group can hold when configUSE_16_BIT_TICKS is 1.
+#endif
+
+#if( configEVENT_GROUP_WAIT_LISTS > 24 )
+	#error configEVENT_GROUP_WAIT_LISTS cannot exceed 24, the number of bits an event group can hold.
+#endif
+
+#if( configNUM_CORES > 1 )
+	#ifndef portGET_CORE_ID
+		#error portGET_CORE_ID() must be defined by the port if configNUM_CORES is greater than 1.  The port in use might not support multiple cores.
+	#endif
+
+	#ifndef portYIELD_CORE
+		#error portYIELD_CORE() must be defined by the port if configNUM_CORES is greater than 1.  The port in use might not support multiple cores.
+	#endif
+
+	#if !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK ) || !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK )
+		#error The port must provide the task and ISR spinlock macros if configNUM_CORES is greater than 1.  The port in use might not support multiple cores.
+	#endif
+
+	#if !defined( portGET_CRITICAL_NESTING_COUNT ) || !defined( portINCREMENT_CRITICAL_NESTING_COUNT ) || !defined( portDECREMENT_CRITICAL_NESTING_COUNT )
+		#error The port must provide a per core critical nesting count if configNUM_CORES is greater than 1.  The port in use might not support multiple cores.
+	#endif
+
+	#if( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION must be 0 if configNUM_CORES is greater than 1 as the running tasks are selected from the ready lists one core at a time.
+	#endif
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TICKLESS_IDLE must be 0 if configNUM_CORES is greater than 1.
+	#endif
+
+	#if( configUSE_CO_ROUTINES != 0 )
+		#error configUSE_CO_ROUTINES must be 0 if configNUM_CORES is greater than 1.
+	#endif
+
+	#if( portCRITICAL_NESTING_IN_TCB == 1 )
+		#error portCRITICAL_NESTING_IN_TCB must be 0 if configNUM_CORES is greater than 1 as the critical nesting count is held per core.
+	#endif
+#endif /* configNUM_CORES */
+
+#if( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUM_CORES == 1 ) )
+	#error configUSE_CORE_AFFINITY can only be set to 1 if configNUM_CORES is greater than 1.
+#endif
+
 #if( ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
 	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES < 1 )
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1.
+#endif
+
+#if( configWORK_QUEUE_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+	#error configWORK_QUEUE_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+#endif
+
+#if( configUSE_ASYNC_TASKS == 1 )
+	#if( configUSE_TASK_NOTIFICATIONS != 1 )
+		#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use async tasks
+	#endif
+
+	#if( configASYNC_TASK_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+		#error configASYNC_TASK_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+	#endif
+#endif
+
 #if( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	#if( configUSE_MUTEXES != 1 )
+		#error configUSE_MUTEXES must be set to 1 to use transitive priority inheritance
+	#endif
+
+	#if( configMAX_INHERITANCE_CHAIN_LENGTH < 1 )
+		#error configMAX_INHERITANCE_CHAIN_LENGTH must be at least 1.
+	#endif
+#endif
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) && ( configNUM_CORES == 1 ) )
+		#error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 in FreeRTOSConfig.h if configUSE_HEAP_INSTRUMENTATION is set to 1, as allocated blocks are tagged with the handle of the task that allocated them.
+	#endif
+
+	#if( ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 ) )
+		#error INCLUDE_xTaskGetSchedulerState must be set to 1 in FreeRTOSConfig.h if configUSE_HEAP_INSTRUMENTATION is set to 1.
+	#endif
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
+#if( configUSE_SPSC_QUEUES == 1 )
+	#if( ( configNUM_CORES > 1 ) && defined( portUSING_DEFAULT_MEMORY_BARRIER ) )
+		#error portMEMORY_BARRIER() must be defined by the port if configUSE_SPSC_QUEUES is set to 1 and configNUM_CORES is greater than 1.  The default only prevents the compiler reordering memory accesses, but the sender and receiver can run on different cores so the CPU must be prevented from reordering them too.
+	#endif
+#endif /* configUSE_SPSC_QUEUES */
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -997,6 +1496,12 @@ typedef struct xSTATIC_TCB
 	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 		UBaseType_t		uxDummy9;
 	#endif
+	#if ( configNUM_CORES > 1 )
+		BaseType_t		xDummy22;
+		#if ( configUSE_CORE_AFFINITY == 1 )
+			UBaseType_t	uxDummy23;
+		#endif
+	#endif
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxDummy10[ 2 ];
 	#endif
@@ -1010,14 +1515,14 @@ typedef struct xSTATIC_TCB
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		configRUN_TIME_COUNTER_TYPE	ulDummy16;
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if( ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) || ( portUSING_MPU_WRAPPERS == 1 ) )
 		uint8_t			uxDummy20;
@@ -1027,6 +1532,34 @@ typedef struct xSTATIC_TCB
 		uint8_t ucDummy21;
 	#endif
 
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy24[ 4 ];
+		UBaseType_t		uxDummy25;
+	#endif
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+		uint32_t		ulDummy26[ 2 ];
+		TickType_t		xDummy27[ 2 ];
+		UBaseType_t		uxDummy28[ 2 ];
+		StaticListItem_t	xDummy29;
+		uint8_t			ucDummy30[ 2 ];
+	#endif
+
+	#if( configGENERATE_TASK_SWITCH_STATS == 1 )
+		uint32_t		ulDummy31[ 2 ];
+		configRUN_TIME_COUNTER_TYPE	ulDummy32[ 3 ];
+		uint8_t			ucDummy33;
+	#endif
+
+	#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE	ulDummy34;
+	#endif
+
+	#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+		StaticList_t	xDummy35;
+		void			*pvDummy36;
+	#endif
+
 } StaticTask_t;
 
 /*
@@ -1070,6 +1603,19 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_SPSC_QUEUES == 1 )
+		UBaseType_t uxDummy10[ 2 ];
+		uint8_t ucDummy11;
+	#endif
+
+	#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+		StaticListItem_t xDummy12;
+	#endif
+
+	#if ( configUSE_ASYNC_TASKS == 1 )
+		StaticList_t xDummy13;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1090,7 +1636,17 @@ typedef StaticQueue_t StaticSemaphore_t;
 typedef struct xSTATIC_EVENT_GROUP
 {
 	TickType_t xDummy1;
-	StaticList_t xDummy2;
+	StaticList_t xDummy2[ configEVENT_GROUP_WAIT_LISTS ];
+
+	#if( configEVENT_GROUP_WAIT_LISTS > 1 )
+		StaticList_t xDummy5;
+		TickType_t xDummy6;
+	#endif
+
+	#if( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+		TickType_t xDummy7;
+		BaseType_t xDummy8;
+	#endif
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
@@ -1131,6 +1687,10 @@ typedef struct xSTATIC_TIMER
 		uint8_t 		ucDummy7;
 	#endif
 
+	#if( configUSE_TIMER_SLACK == 1 )
+		TickType_t		xDummy8;
+	#endif
+
 } StaticTimer_t;
 
 /*
@@ -1155,11 +1715,91 @@ typedef struct xSTATIC_STREAM_BUFFER
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
+
+	#if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+		StaticList_t xDummy5[ 2 ];
+		size_t xDummy6[ 2 ];
+		UBaseType_t uxDummy7[ 2 ];
+	#endif
+
+	#if ( configUSE_ASYNC_TASKS == 1 )
+		StaticList_t xDummy8;
+	#endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real pool structure is not accessible to
+ * application code.  The StaticPool_t structure below is provided so
+ * application writers can statically allocate the memory required to create a
+ * pool.  Its size and alignment requirements are guaranteed to match those of
+ * the genuine structure.
+ */
+typedef struct xSTATIC_POOL
+{
+	void *pvDummy1[ 2 ];
+	size_t xDummy2;
+	UBaseType_t uxDummy3[ 7 ];
+	uint8_t ucDummy4;
+} StaticPool_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real reader-writer lock structure is not
+ * accessible to application code.  The StaticRWLock_t structure below is
+ * provided so application writers can statically allocate the memory required
+ * to create a reader-writer lock.  Its size and alignment requirements are
+ * guaranteed to match those of the genuine structure.
+ */
+typedef struct xSTATIC_RWLOCK
+{
+	StaticList_t xDummy1[ 2 ];
+	void *pvDummy2;
+	UBaseType_t uxDummy3;
+	uint8_t ucDummy4[ 2 ];
+	#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+		StaticListItem_t xDummy5[ 2 ];
+	#endif
+} StaticRWLock_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real work item structure is not accessible to
+ * application code.  The StaticWorkItem_t structure below is provided so
+ * application writers can statically allocate the memory required to create a
+ * work item.  Its size and alignment requirements are guaranteed to match those
+ * of the genuine structure.
+ */
+typedef struct xSTATIC_WORK_ITEM
+{
+	StaticListItem_t xDummy1;
+	void *pvDummy2[ 3 ];
+	TickType_t xDummy3;
+	uint8_t ucDummy4[ 2 ];
+} StaticWorkItem_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real async task structure is not accessible to
+ * application code.  The StaticAsyncTask_t structure below is provided so
+ * application writers can statically allocate the memory required to create an
+ * async task.  Its size and alignment requirements are guaranteed to match
+ * those of the genuine structure.
+ */
+typedef struct xSTATIC_ASYNC_TASK
+{
+	StaticListItem_t xDummy1[ 2 ];
+	void *pvDummy2[ 3 ];
+	BaseType_t xDummy3;
+	TickType_t xDummy4[ 2 ];
+	uint32_t ulDummy5;
+	UBaseType_t uxDummy6;
+	uint8_t ucDummy7[ 2 ];
+} StaticAsyncTask_t;
+
 #ifdef __cplusplus
 }
 #endif
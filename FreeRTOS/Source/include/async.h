@@ -0,0 +1,767 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Async tasks are stackless tasks.  Any number of async tasks are run by one
+ * ordinary task, called the executor, so an async task only needs the memory
+ * for its small control structure, rather than a stack and task control block
+ * of its own.  They are intended to replace co-routines (croutine.c), but are
+ * woken by the same kernel objects as tasks - queues, semaphores, stream and
+ * message buffers - as well as by direct notifications and timeouts, and can
+ * be created and deleted at any time.
+ *
+ * An async task function is a state machine that is written as straight line
+ * code.  It must start with asyncBEGIN() and end with asyncEND(), and waits
+ * using the async macros - asyncDELAY(), asyncQUEUE_RECEIVE(), etc. - each of
+ * which returns from the function if it has to wait.  When the async task is
+ * woken the executor calls the function again, and it continues from the
+ * point at which it returned.  As a result:
+ *
+ * + Local variables do not keep their values while an async task waits.  Use
+ *   variables that are static, or that are held in a structure passed in as
+ *   the function's parameter, instead.  This includes the buffers and result
+ *   variables passed into the async macros.
+ *
+ * + The async macros can only be used in the async task function itself, not
+ *   in functions it calls, and must not be used in a switch statement.  Two
+ *   async macros must not be used on the same line.
+ *
+ * + An async task must not call API functions that block.  Doing so blocks
+ *   the executor, and with it every other async task the executor runs.
+ *
+ * Async tasks that are ready to run are run in the order in which they became
+ * ready.  Each runs until it waits or yields, so one async task never
+ * interrupts another that is run by the same executor.  Async tasks that need
+ * to run at different priorities are run by executors that have different
+ * priorities.
+ *
+ * Async tasks can wait for any queue or semaphore other than a mutex,
+ * recursive mutex, single producer single consumer queue or queue set, and for
+ * any stream or message buffer other than a multi-producer multi-consumer
+ * stream buffer.  Kernel objects can be shared between tasks and async tasks.
+ *
+ * The executor task waits for async tasks to become ready using its task
+ * notification at index configASYNC_TASK_NOTIFICATION_INDEX.
+ *
+ * configUSE_ASYNC_TASKS must be set to 1 in FreeRTOSConfig.h for async tasks
+ * to be available.
+ */
+
+#ifndef ASYNC_H
+#define ASYNC_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include async.h"
+#endif
+
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which async task executors are referenced.  For example, a call to
+ * xAsyncExecutorCreate() returns an AsyncExecutorHandle_t variable that can
+ * then be used as a parameter to xAsyncTaskCreate().
+ */
+typedef void * AsyncExecutorHandle_t;
+
+/**
+ * Type by which async tasks are referenced.  For example, a call to
+ * xAsyncTaskCreate() returns an AsyncTaskHandle_t variable that can then be
+ * used as a parameter to xAsyncTaskNotifyGive(), vAsyncTaskDelete(), etc.
+ */
+typedef void * AsyncTaskHandle_t;
+
+/*
+ * Defines the prototype to which async task functions must conform.  The
+ * first parameter is the handle of the async task being run, which is used
+ * with the async macros.  The second is the pvParameters value passed into
+ * xAsyncTaskCreate().
+ */
+typedef void (*AsyncTaskFunction_t)( AsyncTaskHandle_t xAsyncTask, void *pvParameters );
+
+/* The item values used by the lists in which async tasks wait for a kernel
+object.  For use by the kernel only. */
+#define asyncWAITING_TO_RECEIVE		( ( TickType_t ) 0 )
+#define asyncWAITING_TO_SEND		( ( TickType_t ) 1 )
+
+/**
+ * async. h
+ *
+<pre>
+AsyncExecutorHandle_t xAsyncExecutorCreate( const char * const pcName,
+                                            configSTACK_DEPTH_TYPE usStackDepth,
+                                            UBaseType_t uxPriority );
+</pre>
+ *
+ * Creates a new executor - the task that runs async tasks - using dynamically
+ * allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xAsyncExecutorCreate() to be available.  Executors are
+ * intended to exist for as long as the application runs, so cannot be
+ * deleted.
+ *
+ * @param pcName The name given to the executor task.
+ *
+ * @param usStackDepth The size of the executor task's stack, which is shared
+ * by every async task it runs, so must be large enough for the async task
+ * that uses the most stack.
+ *
+ * @param uxPriority The priority of the executor task, and so of every async
+ * task it runs.
+ *
+ * @return If the executor was created then its handle is returned.  If there
+ * was not enough heap memory to create the executor then NULL is returned.
+ *
+ * Example usage:
+<pre>
+AsyncExecutorHandle_t xExecutor;
+
+void vAFunction( void )
+{
+    // Create an executor to run the async tasks that handle connections.
+    xExecutor = xAsyncExecutorCreate( "Conn", configMINIMAL_STACK_SIZE * 2, tskIDLE_PRIORITY + 2 );
+
+    if( xExecutor != NULL )
+    {
+        // Async tasks can now be created with xAsyncTaskCreate().
+    }
+}
+</pre>
+ * \defgroup xAsyncExecutorCreate xAsyncExecutorCreate
+ * \ingroup AsyncTasks
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	AsyncExecutorHandle_t xAsyncExecutorCreate( const char * const pcName, configSTACK_DEPTH_TYPE usStackDepth, UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * async. h
+ *
+<pre>
+AsyncTaskHandle_t xAsyncTaskCreate( AsyncExecutorHandle_t xExecutor,
+                                    AsyncTaskFunction_t pxTaskCode,
+                                    void *pvParameters );
+</pre>
+ *
+ * Creates a new async task, using dynamically allocated memory, and adds it to
+ * the async tasks that are ready to be run by xExecutor.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xAsyncTaskCreate() to be available.
+ *
+ * @param xExecutor The handle of the executor that runs the async task.
+ *
+ * @param pxTaskCode The async task function, which must be written using the
+ * async macros as described at the top of this file.
+ *
+ * @param pvParameters The value passed into pxTaskCode each time it is called.
+ *
+ * @return If the async task was created then its handle is returned.  If there
+ * was not enough heap memory to create the async task then NULL is returned.
+ *
+ * Example usage:
+<pre>
+// The state of each connection is held in a structure that is passed into
+// the async task, as local variables do not keep their values while an async
+// task waits.
+typedef struct
+{
+    QueueHandle_t xRxQueue;
+    uint8_t ucByte;
+    BaseType_t xResult;
+} Connection_t;
+
+void vConnectionAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters )
+{
+Connection_t *pxConnection = ( Connection_t * ) pvParameters;
+
+    asyncBEGIN( xAsyncTask );
+
+    for( ;; )
+    {
+        // Wait up to a second for a byte.
+        asyncQUEUE_RECEIVE( xAsyncTask, pxConnection->xRxQueue, &( pxConnection->ucByte ), pdMS_TO_TICKS( 1000 ), &( pxConnection->xResult ) );
+
+        if( pxConnection->xResult != pdPASS )
+        {
+            // The connection has been idle for too long, so end the async
+            // task.
+            break;
+        }
+
+        // Process pxConnection->ucByte here.
+    }
+
+    asyncEND( xAsyncTask );
+}
+
+void vAFunction( Connection_t *pxConnection )
+{
+    if( xAsyncTaskCreate( xExecutor, vConnectionAsyncTask, ( void * ) pxConnection ) == NULL )
+    {
+        // There was not enough heap memory to create the async task.
+    }
+}
+</pre>
+ * \defgroup xAsyncTaskCreate xAsyncTaskCreate
+ * \ingroup AsyncTasks
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	AsyncTaskHandle_t xAsyncTaskCreate( AsyncExecutorHandle_t xExecutor, AsyncTaskFunction_t pxTaskCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * async. h
+ *
+<pre>
+AsyncTaskHandle_t xAsyncTaskCreateStatic( AsyncExecutorHandle_t xExecutor,
+                                          AsyncTaskFunction_t pxTaskCode,
+                                          void *pvParameters,
+                                          StaticAsyncTask_t *pxAsyncTaskBuffer );
+</pre>
+ *
+ * Creates a new async task, as xAsyncTaskCreate() does, but using memory
+ * provided by the application writer.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xAsyncTaskCreateStatic() to be available.
+ *
+ * @param xExecutor The handle of the executor that runs the async task.
+ *
+ * @param pxTaskCode The async task function.
+ *
+ * @param pvParameters The value passed into pxTaskCode each time it is called.
+ *
+ * @param pxAsyncTaskBuffer Must point to a variable of type StaticAsyncTask_t,
+ * which will be used to hold the async task's data structure.  It must not be
+ * reused until the async task has been deleted.
+ *
+ * @return The handle of the created async task.
+ *
+ * \defgroup xAsyncTaskCreateStatic xAsyncTaskCreateStatic
+ * \ingroup AsyncTasks
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	AsyncTaskHandle_t xAsyncTaskCreateStatic( AsyncExecutorHandle_t xExecutor, AsyncTaskFunction_t pxTaskCode, void *pvParameters, StaticAsyncTask_t *pxAsyncTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * async. h
+ *
+<pre>
+void vAsyncTaskDelete( AsyncTaskHandle_t xAsyncTask );
+</pre>
+ *
+ * Deletes an async task, which stops waiting for whatever it was waiting for
+ * and is never run again.  An async task that reaches asyncEND() deletes
+ * itself.
+ *
+ * Can be called from a task, or from an async task, including the async task
+ * being deleted, in which case the async task function must return straight
+ * away.  Must not be called from an interrupt.  Memory allocated by the
+ * kernel to a dynamically created async task is freed once the async task
+ * is no longer running.
+ *
+ * @param xAsyncTask The handle of the async task to delete.
+ *
+ * \defgroup vAsyncTaskDelete vAsyncTaskDelete
+ * \ingroup AsyncTasks
+ */
+void vAsyncTaskDelete( AsyncTaskHandle_t xAsyncTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * async. h
+ *
+<pre>
+BaseType_t xAsyncTaskNotifyGive( AsyncTaskHandle_t xAsyncTask );
+</pre>
+ *
+ * Increments the notification value of an async task, waking the async task
+ * if it is waiting in asyncNOTIFY_TAKE().  Each async task has its own
+ * notification value, which works as a counting semaphore, in the same way as
+ * xTaskNotifyGive() and ulTaskNotifyTake() work with a task's notification
+ * value.
+ *
+ * Can be called from a task or an async task.  Use
+ * vAsyncTaskNotifyGiveFromISR() from an interrupt.
+ *
+ * @param xAsyncTask The handle of the async task being notified.
+ *
+ * @return pdPASS is always returned.
+ *
+ * \defgroup xAsyncTaskNotifyGive xAsyncTaskNotifyGive
+ * \ingroup AsyncTasks
+ */
+BaseType_t xAsyncTaskNotifyGive( AsyncTaskHandle_t xAsyncTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * async. h
+ *
+<pre>
+void vAsyncTaskNotifyGiveFromISR( AsyncTaskHandle_t xAsyncTask, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xAsyncTaskNotifyGive() that can be called from an interrupt.
+ *
+ * @param xAsyncTask The handle of the async task being notified.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if waking the async task unblocked an executor task that has a priority
+ * above the priority of the interrupted task, in which case a context switch
+ * should be requested before the interrupt exits.  Can be NULL, in which case
+ * the context switch is held pending until the next time the kernel checks
+ * for one.
+ *
+ * \defgroup vAsyncTaskNotifyGiveFromISR vAsyncTaskNotifyGiveFromISR
+ * \ingroup AsyncTasks
+ */
+void vAsyncTaskNotifyGiveFromISR( AsyncTaskHandle_t xAsyncTask, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * async. h
+ *
+<pre>
+TaskHandle_t xAsyncExecutorGetTaskHandle( AsyncExecutorHandle_t xExecutor );
+</pre>
+ *
+ * @return The handle of the task that runs the async tasks of xExecutor.
+ *
+ * \defgroup xAsyncExecutorGetTaskHandle xAsyncExecutorGetTaskHandle
+ * \ingroup AsyncTasks
+ */
+TaskHandle_t xAsyncExecutorGetTaskHandle( AsyncExecutorHandle_t xExecutor ) PRIVILEGED_FUNCTION;
+
+/**
+ * async. h
+ *
+<pre>
+UBaseType_t uxAsyncExecutorGetNumberOfTasks( AsyncExecutorHandle_t xExecutor );
+</pre>
+ *
+ * @return The number of async tasks that exist and are run by xExecutor.
+ *
+ * \defgroup uxAsyncExecutorGetNumberOfTasks uxAsyncExecutorGetNumberOfTasks
+ * \ingroup AsyncTasks
+ */
+UBaseType_t uxAsyncExecutorGetNumberOfTasks( AsyncExecutorHandle_t xExecutor ) PRIVILEGED_FUNCTION;
+
+/**
+ * async. h
+ *
+<pre>
+asyncBEGIN( AsyncTaskHandle_t xAsyncTask );
+</pre>
+ *
+ * Must be the first statement of every async task function, after any
+ * declarations.  Continues the async task from the point at which it last
+ * returned, or from the start if it has not yet run.
+ *
+ * \defgroup asyncBEGIN asyncBEGIN
+ * \ingroup AsyncTasks
+ */
+#define asyncBEGIN( xAsyncTask ) switch( uxAsyncTaskGetResumePoint( ( xAsyncTask ) ) ) { case 0:
+
+/**
+ * async. h
+ *
+<pre>
+asyncEND( AsyncTaskHandle_t xAsyncTask );
+</pre>
+ *
+ * Must be the last statement of every async task function.  An async task
+ * that reaches asyncEND() has finished, and is deleted.
+ *
+ * \defgroup asyncEND asyncEND
+ * \ingroup AsyncTasks
+ */
+#define asyncEND( xAsyncTask ) } vAsyncTaskDelete( ( xAsyncTask ) ); return
+
+/**
+ * async. h
+ *
+<pre>
+asyncDELAY( AsyncTaskHandle_t xAsyncTask, TickType_t xTicksToDelay );
+</pre>
+ *
+ * Waits for xTicksToDelay ticks, in the same way as vTaskDelay() does for a
+ * task.  The executor runs other async tasks while it waits.
+ *
+ * @param xAsyncTask The handle of the async task, as passed into the async
+ * task function.
+ *
+ * @param xTicksToDelay The number of ticks to wait.  If xTicksToDelay is 0 the
+ * async task yields, letting every other async task that is ready to run
+ * before it continues.
+ *
+ * Example usage:
+<pre>
+// An async task that toggles an LED every 500ms.
+void vFlashAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters )
+{
+    asyncBEGIN( xAsyncTask );
+
+    for( ;; )
+    {
+        vToggleLED();
+        asyncDELAY( xAsyncTask, pdMS_TO_TICKS( 500 ) );
+    }
+
+    asyncEND( xAsyncTask );
+}
+</pre>
+ * \defgroup asyncDELAY asyncDELAY
+ * \ingroup AsyncTasks
+ */
+#define asyncDELAY( xAsyncTask, xTicksToDelay )										\
+{																					\
+	vAsyncTaskDelay( ( xAsyncTask ), ( xTicksToDelay ), ( UBaseType_t ) __LINE__ );	\
+	return;																			\
+	case __LINE__:																	\
+		;																			\
+}
+
+/**
+ * async. h
+ *
+<pre>
+asyncYIELD( AsyncTaskHandle_t xAsyncTask );
+</pre>
+ *
+ * Lets every other async task that is ready to run before this async task
+ * continues.  Equivalent to asyncDELAY( xAsyncTask, 0 ).
+ *
+ * \defgroup asyncYIELD asyncYIELD
+ * \ingroup AsyncTasks
+ */
+#define asyncYIELD( xAsyncTask ) asyncDELAY( ( xAsyncTask ), 0 )
+
+/**
+ * async. h
+ *
+<pre>
+asyncNOTIFY_TAKE( AsyncTaskHandle_t xAsyncTask,
+                  BaseType_t xClearCountOnExit,
+                  TickType_t xTicksToWait,
+                  uint32_t *pulValue );
+</pre>
+ *
+ * Waits for the async task's notification value to be non-zero, then either
+ * clears it or decrements it, in the same way as ulTaskNotifyTake() does for a
+ * task.  The notification value is incremented by xAsyncTaskNotifyGive() and
+ * vAsyncTaskNotifyGiveFromISR().
+ *
+ * @param xAsyncTask The handle of the async task, as passed into the async
+ * task function.
+ *
+ * @param xClearCountOnExit If pdTRUE the notification value is cleared to 0,
+ * otherwise it is decremented.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for the notification
+ * value to be non-zero.  portMAX_DELAY waits indefinitely if
+ * INCLUDE_vTaskSuspend is set to 1.
+ *
+ * @param pulValue Must point to a variable that keeps its value while the
+ * async task waits.  Set to the notification value before it was cleared or
+ * decremented, or to 0 if the wait timed out.
+ *
+ * \defgroup asyncNOTIFY_TAKE asyncNOTIFY_TAKE
+ * \ingroup AsyncTasks
+ */
+#define asyncNOTIFY_TAKE( xAsyncTask, xClearCountOnExit, xTicksToWait, pulValue )					\
+{																									\
+	vAsyncTaskPrepareToWait( ( xAsyncTask ), ( xTicksToWait ), ( UBaseType_t ) __LINE__ );			\
+	while( xAsyncTaskNotifyTake( ( xAsyncTask ), ( xClearCountOnExit ), ( pulValue ) ) == errQUEUE_BLOCKED )	\
+	{																								\
+		return;																						\
+		case __LINE__:																				\
+			;																						\
+	}																								\
+}
+
+/**
+ * async. h
+ *
+<pre>
+asyncQUEUE_SEND( AsyncTaskHandle_t xAsyncTask,
+                 QueueHandle_t xQueue,
+                 const void *pvItemToQueue,
+                 TickType_t xTicksToWait,
+                 BaseType_t *pxResult );
+</pre>
+ *
+ * Sends an item to the back of a queue, waiting for space to become available
+ * if the queue is full.  The async equivalent of xQueueSend().
+ *
+ * @param xAsyncTask The handle of the async task, as passed into the async
+ * task function.
+ *
+ * @param xQueue The handle of the queue.
+ *
+ * @param pvItemToQueue A pointer to the item to send, which must keep its
+ * value while the async task waits.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for space.
+ *
+ * @param pxResult Must point to a variable that keeps its value while the
+ * async task waits.  Set to pdPASS if the item was sent, or errQUEUE_FULL if
+ * the wait timed out.
+ *
+ * \defgroup asyncQUEUE_SEND asyncQUEUE_SEND
+ * \ingroup AsyncTasks
+ */
+#define asyncQUEUE_SEND( xAsyncTask, xQueue, pvItemToQueue, xTicksToWait, pxResult )				\
+{																									\
+	vAsyncTaskPrepareToWait( ( xAsyncTask ), ( xTicksToWait ), ( UBaseType_t ) __LINE__ );			\
+	while( ( *( pxResult ) = xAsyncTaskQueueSend( ( xAsyncTask ), ( xQueue ), ( pvItemToQueue ) ) ) == errQUEUE_BLOCKED )	\
+	{																								\
+		return;																						\
+		case __LINE__:																				\
+			;																						\
+	}																								\
+}
+
+/**
+ * async. h
+ *
+<pre>
+asyncQUEUE_RECEIVE( AsyncTaskHandle_t xAsyncTask,
+                    QueueHandle_t xQueue,
+                    void *pvBuffer,
+                    TickType_t xTicksToWait,
+                    BaseType_t *pxResult );
+</pre>
+ *
+ * Receives an item from a queue, waiting for an item to become available if
+ * the queue is empty.  The async equivalent of xQueueReceive().  Also takes a
+ * binary or counting semaphore, in which case pvBuffer must be NULL.
+ *
+ * @param xAsyncTask The handle of the async task, as passed into the async
+ * task function.
+ *
+ * @param xQueue The handle of the queue or semaphore.  Must not be a mutex.
+ *
+ * @param pvBuffer Where the received item is copied.  Must keep its value
+ * while the async task waits.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for an item.
+ *
+ * @param pxResult Must point to a variable that keeps its value while the
+ * async task waits.  Set to pdPASS if an item was received, or errQUEUE_EMPTY
+ * if the wait timed out.
+ *
+ * See the example for xAsyncTaskCreate().
+ *
+ * \defgroup asyncQUEUE_RECEIVE asyncQUEUE_RECEIVE
+ * \ingroup AsyncTasks
+ */
+#define asyncQUEUE_RECEIVE( xAsyncTask, xQueue, pvBuffer, xTicksToWait, pxResult )					\
+{																									\
+	vAsyncTaskPrepareToWait( ( xAsyncTask ), ( xTicksToWait ), ( UBaseType_t ) __LINE__ );			\
+	while( ( *( pxResult ) = xAsyncTaskQueueReceive( ( xAsyncTask ), ( xQueue ), ( pvBuffer ) ) ) == errQUEUE_BLOCKED )	\
+	{																								\
+		return;																						\
+		case __LINE__:																				\
+			;																						\
+	}																								\
+}
+
+/**
+ * async. h
+ *
+<pre>
+asyncSTREAM_BUFFER_SEND( AsyncTaskHandle_t xAsyncTask,
+                         StreamBufferHandle_t xStreamBuffer,
+                         const void *pvTxData,
+                         size_t xDataLengthBytes,
+                         TickType_t xTicksToWait,
+                         size_t *pxBytesSent );
+</pre>
+ *
+ * Sends bytes to a stream buffer, or a message to a message buffer, waiting
+ * for space to become available if there is none.  The async equivalent of
+ * xStreamBufferSend() and xMessageBufferSend().  As many bytes as fit are
+ * sent to a stream buffer, so fewer than xDataLengthBytes bytes might be sent.
+ * A message is only sent to a message buffer if the whole message fits.
+ *
+ * @param xAsyncTask The handle of the async task, as passed into the async
+ * task function.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer.
+ *
+ * @param pvTxData A pointer to the data to send, which must keep its value
+ * while the async task waits.
+ *
+ * @param xDataLengthBytes The number of bytes to send.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for space.
+ *
+ * @param pxBytesSent Must point to a variable that keeps its value while the
+ * async task waits.  Set to the number of bytes sent, which is 0 if the wait
+ * timed out.
+ *
+ * \defgroup asyncSTREAM_BUFFER_SEND asyncSTREAM_BUFFER_SEND
+ * \ingroup AsyncTasks
+ */
+#define asyncSTREAM_BUFFER_SEND( xAsyncTask, xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait, pxBytesSent )	\
+{																									\
+	vAsyncTaskPrepareToWait( ( xAsyncTask ), ( xTicksToWait ), ( UBaseType_t ) __LINE__ );			\
+	while( xAsyncTaskStreamBufferSend( ( xAsyncTask ), ( xStreamBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( pxBytesSent ) ) == errQUEUE_BLOCKED )	\
+	{																								\
+		return;																						\
+		case __LINE__:																				\
+			;																						\
+	}																								\
+}
+
+/**
+ * async. h
+ *
+<pre>
+asyncSTREAM_BUFFER_RECEIVE( AsyncTaskHandle_t xAsyncTask,
+                            StreamBufferHandle_t xStreamBuffer,
+                            void *pvRxData,
+                            size_t xBufferLengthBytes,
+                            TickType_t xTicksToWait,
+                            size_t *pxReceivedBytes );
+</pre>
+ *
+ * Receives bytes from a stream buffer, or a message from a message buffer,
+ * waiting for data to become available if there is none.  The async
+ * equivalent of xStreamBufferReceive() and xMessageBufferReceive().  An async
+ * task waiting to receive from a stream buffer is woken when the stream
+ * buffer's trigger level is reached.
+ *
+ * @param xAsyncTask The handle of the async task, as passed into the async
+ * task function.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer.
+ *
+ * @param pvRxData Where the received bytes are copied.  Must keep its value
+ * while the async task waits.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for data.
+ *
+ * @param pxReceivedBytes Must point to a variable that keeps its value while
+ * the async task waits.  Set to the number of bytes received, which is 0 if
+ * the wait timed out.
+ *
+ * Example usage:
+<pre>
+// An async task that echoes the bytes received by one stream buffer to
+// another.  The variables are static as the function is only used by one
+// async task.
+void vEchoAsyncTask( AsyncTaskHandle_t xAsyncTask, void *pvParameters )
+{
+static uint8_t ucBuffer[ 32 ];
+static size_t xReceived, xSent;
+
+    asyncBEGIN( xAsyncTask );
+
+    for( ;; )
+    {
+        asyncSTREAM_BUFFER_RECEIVE( xAsyncTask, xRxStreamBuffer, ucBuffer, sizeof( ucBuffer ), portMAX_DELAY, &xReceived );
+        asyncSTREAM_BUFFER_SEND( xAsyncTask, xTxStreamBuffer, ucBuffer, xReceived, portMAX_DELAY, &xSent );
+    }
+
+    asyncEND( xAsyncTask );
+}
+</pre>
+ * \defgroup asyncSTREAM_BUFFER_RECEIVE asyncSTREAM_BUFFER_RECEIVE
+ * \ingroup AsyncTasks
+ */
+#define asyncSTREAM_BUFFER_RECEIVE( xAsyncTask, xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait, pxReceivedBytes )	\
+{																									\
+	vAsyncTaskPrepareToWait( ( xAsyncTask ), ( xTicksToWait ), ( UBaseType_t ) __LINE__ );			\
+	while( xAsyncTaskStreamBufferReceive( ( xAsyncTask ), ( xStreamBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxReceivedBytes ) ) == errQUEUE_BLOCKED )	\
+	{																								\
+		return;																						\
+		case __LINE__:																				\
+			;																						\
+	}																								\
+}
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the async macros and the kernel only.  The macro nature of the
+ * async task implementation requires that their prototypes appear here.
+ */
+
+/*
+ * Returns the point at which an async task continues when it is next run, as
+ * recorded by vAsyncTaskDelay() or vAsyncTaskPrepareToWait().  0 if the async
+ * task has not yet run.
+ */
+UBaseType_t uxAsyncTaskGetResumePoint( AsyncTaskHandle_t xAsyncTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records the point at which the async task continues, and makes it wait for
+ * xTicksToDelay ticks once it returns.
+ */
+void vAsyncTaskDelay( AsyncTaskHandle_t xAsyncTask, TickType_t xTicksToDelay, UBaseType_t uxResumePoint ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records the point at which the async task continues, and the time at which
+ * it starts to wait, before it calls one of the functions below.
+ */
+void vAsyncTaskPrepareToWait( AsyncTaskHandle_t xAsyncTask, TickType_t xTicksToWait, UBaseType_t uxResumePoint ) PRIVILEGED_FUNCTION;
+
+/*
+ * Attempt the operation without blocking.  If it cannot be completed, and the
+ * time given to vAsyncTaskPrepareToWait() has not expired, the async task is
+ * made to wait for it to become possible and errQUEUE_BLOCKED is returned, in
+ * which case the async task function returns, and calls the function again
+ * when it is run again.
+ */
+BaseType_t xAsyncTaskNotifyTake( AsyncTaskHandle_t xAsyncTask, BaseType_t xClearCountOnExit, uint32_t *pulValue ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncTaskQueueSend( AsyncTaskHandle_t xAsyncTask, QueueHandle_t xQueue, const void * const pvItemToQueue ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncTaskQueueReceive( AsyncTaskHandle_t xAsyncTask, QueueHandle_t xQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncTaskStreamBufferSend( AsyncTaskHandle_t xAsyncTask, StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, size_t *pxBytesSent ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncTaskStreamBufferReceive( AsyncTaskHandle_t xAsyncTask, StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, size_t *pxReceivedBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the queue and stream buffer implementations when data or space
+ * becomes available.  Wakes up to uxMaxToWake of the async tasks in
+ * pxWaitingList that are waiting for xEvent - either asyncWAITING_TO_RECEIVE
+ * or asyncWAITING_TO_SEND.  The list is only accessed from critical sections,
+ * so can be used while the kernel object is locked.
+ */
+void vAsyncTaskWakeWaiting( List_t * const pxWaitingList, const TickType_t xEvent, UBaseType_t uxMaxToWake ) PRIVILEGED_FUNCTION;
+void vAsyncTaskWakeWaitingFromISR( List_t * const pxWaitingList, const TickType_t xEvent, UBaseType_t uxMaxToWake, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* ASYNC_H */
@@ -499,6 +499,16 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR is set to 1 in FreeRTOSConfig.h
+ * then xEventGroupSetBitsFromISR() instead sets the bits, and unblocks the
+ * tasks waiting for them, from within the interrupt, so the timer task is not
+ * used and the call cannot fail.  The time spent in the interrupt then depends
+ * on the number of tasks waiting for the bits being set, which can be limited
+ * by setting configEVENT_GROUP_WAIT_LISTS above 1 so only tasks waiting for
+ * bits that map to the same list as the bits being set are checked.  If a task
+ * is accessing the event group when the interrupt executes, the bits are set
+ * by that task instead, as soon as it has finished.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -517,7 +527,10 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  *
  * @return If the request to execute the function was posted successfully then
  * pdPASS is returned, otherwise pdFALSE is returned.  pdFALSE will be returned
- * if the timer service queue was full.
+ * if the timer service queue was full.  pdPASS is always returned if
+ * configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR is 1, in which case
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if a task that has a priority
+ * above the interrupted task was unblocked.
  *
  * Example usage:
    <pre>
@@ -555,7 +568,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 ) )
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
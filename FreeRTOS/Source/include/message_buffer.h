@@ -47,7 +47,8 @@
  * block time to 0.  Likewise, if there are to be multiple different readers
  * then the application writer must place each call to a reading API function
  * (such as xMessageBufferRead()) inside a critical section and set the receive
- * timeout to 0.
+ * timeout to 0.  The exception is message buffers created using
+ * xMessageBufferCreateMPMC(), which can have any number of writers and readers.
  *
  * Message buffers hold variable length messages.  To enable that, when a
  * message is written to the message buffer an additional sizeof( size_t ) bytes
@@ -135,7 +136,7 @@ const size_t xMessageBufferSizeBytes = 100;
  * \defgroup xMessageBufferCreate xMessageBufferCreate
  * \ingroup MessageBufferManagement
  */
-#define xMessageBufferCreate( xBufferSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreate( xBufferSizeBytes, ( size_t ) 0, pdTRUE )
+#define xMessageBufferCreate( xBufferSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreate( xBufferSizeBytes, ( size_t ) 0, sbTYPE_MESSAGE_BUFFER )
 
 /**
  * message_buffer.h
@@ -201,7 +202,54 @@ MessageBufferHandle_t xMessageBuffer;
  * \defgroup xMessageBufferCreateStatic xMessageBufferCreateStatic
  * \ingroup MessageBufferManagement
  */
-#define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, pdTRUE, pucMessageBufferStorageArea, pxStaticMessageBuffer )
+#define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, sbTYPE_MESSAGE_BUFFER, pucMessageBufferStorageArea, pxStaticMessageBuffer )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferCreateMPMC( size_t xBufferSizeBytes );
+</pre>
+ *
+ * Creates a new message buffer that can be written to by more than one task or
+ * interrupt, and read from by more than one task or interrupt, at the same
+ * time.  configUSE_MPMC_STREAM_BUFFERS must be set to 1 in FreeRTOSConfig.h
+ * for xMessageBufferCreateMPMC() to be available.
+ *
+ * Each message is written into a region of the buffer reserved for it alone,
+ * and read out of a region reserved for one reader alone, so messages are never
+ * interleaved or split between readers however many tasks and interrupts use
+ * the message buffer at once.  See xStreamBufferCreateMPMC() for a description
+ * of how multi-producer, multi-consumer buffers work.
+ *
+ * The parameter and return value are the same as for xMessageBufferCreate().
+ *
+ * \defgroup xMessageBufferCreateMPMC xMessageBufferCreateMPMC
+ * \ingroup MessageBufferManagement
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MPMC_STREAM_BUFFERS == 1 ) )
+	#define xMessageBufferCreateMPMC( xBufferSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreate( xBufferSizeBytes, ( size_t ) 0, sbTYPE_MPMC_MESSAGE_BUFFER )
+#endif
+
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferCreateMPMCStatic( size_t xBufferSizeBytes,
+                                                      uint8_t *pucMessageBufferStorageArea,
+                                                      StaticMessageBuffer_t *pxStaticMessageBuffer );
+</pre>
+ *
+ * Version of xMessageBufferCreateMPMC() that uses statically allocated memory.
+ * The parameters and return value are the same as for
+ * xMessageBufferCreateStatic().
+ *
+ * \defgroup xMessageBufferCreateMPMCStatic xMessageBufferCreateMPMCStatic
+ * \ingroup MessageBufferManagement
+ */
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MPMC_STREAM_BUFFERS == 1 ) )
+	#define xMessageBufferCreateMPMCStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, sbTYPE_MPMC_MESSAGE_BUFFER, pucMessageBufferStorageArea, pxStaticMessageBuffer )
+#endif
 
 /**
  * message_buffer.h
@@ -47,6 +47,13 @@ void MPU_vTaskDelete( TaskHandle_t xTaskToDelete );
 void MPU_vTaskDelay( const TickType_t xTicksToDelay );
 void MPU_vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement );
 BaseType_t MPU_xTaskAbortDelay( TaskHandle_t xTask );
+BaseType_t MPU_xTaskCreateDeadline( TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, const TickType_t xPeriod, const TickType_t xRelativeDeadline, TaskHandle_t * const pxCreatedTask );
+void MPU_vTaskWaitForNextPeriod( void );
+UBaseType_t MPU_uxTaskGetDeadlineMisses( TaskHandle_t xTask );
+void MPU_vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xReplenishPeriod, eBudgetAction eAction, UBaseType_t uxDemotedPriority );
+void MPU_vTaskGetBudgetStatus( TaskHandle_t xTask, TaskBudgetStatus_t *pxBudgetStatus );
+BaseType_t MPU_xTaskGetSchedulingLatencyHistogram( UBaseType_t uxPriority, uint32_t *pulHistogram, configRUN_TIME_COUNTER_TYPE *pulMaxLatency );
+void MPU_vTaskResetSchedulingLatencyStats( void );
 UBaseType_t MPU_uxTaskPriorityGet( TaskHandle_t xTask );
 eTaskState MPU_eTaskGetState( TaskHandle_t xTask );
 void MPU_vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState );
@@ -67,13 +74,13 @@ void MPU_vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t
 void * MPU_pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery, BaseType_t xIndex );
 BaseType_t MPU_xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter );
 TaskHandle_t MPU_xTaskGetIdleTaskHandle( void );
-UBaseType_t MPU_uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime );
+UBaseType_t MPU_uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime );
 void MPU_vTaskList( char * pcWriteBuffer );
 void MPU_vTaskGetRunTimeStats( char *pcWriteBuffer );
-BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue );
-BaseType_t MPU_xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );
-uint32_t MPU_ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );
-BaseType_t MPU_xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue );
+BaseType_t MPU_xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );
+uint32_t MPU_ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );
+BaseType_t MPU_xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear );
 BaseType_t MPU_xTaskIncrementTick( void );
 TaskHandle_t MPU_xTaskGetCurrentTaskHandle( void );
 void MPU_vTaskSetTimeOutState( TimeOut_t * const pxTimeOut );
@@ -85,6 +92,8 @@ BaseType_t MPU_xTaskGetSchedulerState( void );
 BaseType_t MPU_xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition );
 BaseType_t MPU_xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait );
 BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait );
+UBaseType_t MPU_uxQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait );
+UBaseType_t MPU_uxQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait );
 BaseType_t MPU_xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait );
 UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t xQueue );
 UBaseType_t MPU_uxQueueSpacesAvailable( const QueueHandle_t xQueue );
@@ -109,6 +118,10 @@ BaseType_t MPU_xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue );
 void MPU_vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber );
 UBaseType_t MPU_uxQueueGetQueueNumber( QueueHandle_t xQueue );
 uint8_t MPU_ucQueueGetQueueType( QueueHandle_t xQueue );
+BaseType_t MPU_xQueueReserve( QueueHandle_t xQueue, void ** const ppvSlot, TickType_t xTicksToWait );
+void MPU_vQueueCommit( QueueHandle_t xQueue );
+BaseType_t MPU_xQueuePeekAcquire( QueueHandle_t xQueue, void ** const ppvItem, TickType_t xTicksToWait );
+void MPU_vQueueRelease( QueueHandle_t xQueue );
 
 /* MPU versions of timers.h API functions. */
 TimerHandle_t MPU_xTimerCreate( const char * const pcTimerName, const TickType_t xTimerPeriodInTicks, const UBaseType_t uxAutoReload, void * const pvTimerID, TimerCallbackFunction_t pxCallbackFunction );
@@ -121,6 +134,9 @@ BaseType_t MPU_xTimerPendFunctionCall( PendedFunction_t xFunctionToPend, void *p
 const char * MPU_pcTimerGetName( TimerHandle_t xTimer );
 TickType_t MPU_xTimerGetPeriod( TimerHandle_t xTimer );
 TickType_t MPU_xTimerGetExpiryTime( TimerHandle_t xTimer );
+TimerHandle_t MPU_xTimerCreateWithSlack( const char * const pcTimerName, const TickType_t xTimerPeriodInTicks, const UBaseType_t uxAutoReload, void * const pvTimerID, TimerCallbackFunction_t pxCallbackFunction, const TickType_t xTimerSlack );
+TimerHandle_t MPU_xTimerCreateStaticWithSlack( const char * const pcTimerName, const TickType_t xTimerPeriodInTicks, const UBaseType_t uxAutoReload, void * const pvTimerID, TimerCallbackFunction_t pxCallbackFunction, const TickType_t xTimerSlack, StaticTimer_t *pxTimerBuffer );
+TickType_t MPU_xTimerGetSlack( TimerHandle_t xTimer );
 BaseType_t MPU_xTimerCreateTimerTask( void );
 BaseType_t MPU_xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait );
 
@@ -139,6 +155,10 @@ size_t MPU_xStreamBufferSend( StreamBufferHandle_t xStreamBuffer, const void *pv
 size_t MPU_xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken );
 size_t MPU_xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait );
 size_t MPU_xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken );
+size_t MPU_xStreamBufferGetWriteSpans( StreamBufferHandle_t xStreamBuffer, StreamBufferSpan_t pxSpans[ 2 ], TickType_t xTicksToWait );
+size_t MPU_xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten );
+size_t MPU_xStreamBufferGetReadSpans( StreamBufferHandle_t xStreamBuffer, StreamBufferSpan_t pxSpans[ 2 ], TickType_t xTicksToWait );
+size_t MPU_xStreamBufferCommitRead( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead );
 void MPU_vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer );
 BaseType_t MPU_xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer );
 BaseType_t MPU_xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer );
@@ -54,6 +54,13 @@ only for ports that are using the MPU. */
 		#define vTaskDelay								MPU_vTaskDelay
 		#define vTaskDelayUntil							MPU_vTaskDelayUntil
 		#define xTaskAbortDelay							MPU_xTaskAbortDelay
+		#define xTaskCreateDeadline						MPU_xTaskCreateDeadline
+		#define vTaskWaitForNextPeriod					MPU_vTaskWaitForNextPeriod
+		#define uxTaskGetDeadlineMisses					MPU_uxTaskGetDeadlineMisses
+		#define vTaskSetBudget							MPU_vTaskSetBudget
+		#define vTaskGetBudgetStatus					MPU_vTaskGetBudgetStatus
+		#define xTaskGetSchedulingLatencyHistogram		MPU_xTaskGetSchedulingLatencyHistogram
+		#define vTaskResetSchedulingLatencyStats		MPU_vTaskResetSchedulingLatencyStats
 		#define uxTaskPriorityGet						MPU_uxTaskPriorityGet
 		#define eTaskGetState							MPU_eTaskGetState
 		#define vTaskGetInfo							MPU_vTaskGetInfo
@@ -77,9 +84,9 @@ only for ports that are using the MPU. */
 		#define vTaskList								MPU_vTaskList
 		#define vTaskGetRunTimeStats					MPU_vTaskGetRunTimeStats
 		#define xTaskGenericNotify						MPU_xTaskGenericNotify
-		#define xTaskNotifyWait							MPU_xTaskNotifyWait
-		#define ulTaskNotifyTake						MPU_ulTaskNotifyTake
-		#define xTaskNotifyStateClear					MPU_xTaskNotifyStateClear
+		#define xTaskGenericNotifyWait					MPU_xTaskGenericNotifyWait
+		#define ulTaskGenericNotifyTake					MPU_ulTaskGenericNotifyTake
+		#define xTaskGenericNotifyStateClear			MPU_xTaskGenericNotifyStateClear
 
 		#define xTaskGetCurrentTaskHandle				MPU_xTaskGetCurrentTaskHandle
 		#define vTaskSetTimeOutState					MPU_vTaskSetTimeOutState
@@ -90,6 +97,8 @@ only for ports that are using the MPU. */
 		#define xQueueGenericSend						MPU_xQueueGenericSend
 		#define xQueueReceive							MPU_xQueueReceive
 		#define xQueuePeek								MPU_xQueuePeek
+		#define uxQueueSendMultiple						MPU_uxQueueSendMultiple
+		#define uxQueueReceiveMultiple					MPU_uxQueueReceiveMultiple
 		#define xQueueSemaphoreTake						MPU_xQueueSemaphoreTake
 		#define uxQueueMessagesWaiting					MPU_uxQueueMessagesWaiting
 		#define uxQueueSpacesAvailable					MPU_uxQueueSpacesAvailable
@@ -109,6 +118,13 @@ only for ports that are using the MPU. */
 		#define xQueueSelectFromSet						MPU_xQueueSelectFromSet
 		#define xQueueGenericReset						MPU_xQueueGenericReset
 
+		#if( configUSE_SPSC_QUEUES == 1 )
+			#define xQueueReserve							MPU_xQueueReserve
+			#define vQueueCommit							MPU_vQueueCommit
+			#define xQueuePeekAcquire						MPU_xQueuePeekAcquire
+			#define vQueueRelease							MPU_vQueueRelease
+		#endif
+
 		#if( configQUEUE_REGISTRY_SIZE > 0 )
 			#define vQueueAddToRegistry						MPU_vQueueAddToRegistry
 			#define vQueueUnregisterQueue					MPU_vQueueUnregisterQueue
@@ -126,6 +142,9 @@ only for ports that are using the MPU. */
 		#define pcTimerGetName							MPU_pcTimerGetName
 		#define xTimerGetPeriod							MPU_xTimerGetPeriod
 		#define xTimerGetExpiryTime						MPU_xTimerGetExpiryTime
+		#define xTimerCreateWithSlack					MPU_xTimerCreateWithSlack
+		#define xTimerCreateStaticWithSlack				MPU_xTimerCreateStaticWithSlack
+		#define xTimerGetSlack							MPU_xTimerGetSlack
 		#define xTimerGenericCommand					MPU_xTimerGenericCommand
 
 		/* Map standard event_group.h API functions to the MPU equivalents. */
@@ -143,6 +162,10 @@ only for ports that are using the MPU. */
 		#define xStreamBufferSendFromISR				MPU_xStreamBufferSendFromISR
 		#define xStreamBufferReceive					MPU_xStreamBufferReceive
 		#define xStreamBufferReceiveFromISR				MPU_xStreamBufferReceiveFromISR
+		#define xStreamBufferGetWriteSpans				MPU_xStreamBufferGetWriteSpans
+		#define xStreamBufferCommitWrite				MPU_xStreamBufferCommitWrite
+		#define xStreamBufferGetReadSpans				MPU_xStreamBufferGetReadSpans
+		#define xStreamBufferCommitRead					MPU_xStreamBufferCommitRead
 		#define vStreamBufferDelete						MPU_vStreamBufferDelete
 		#define xStreamBufferIsFull						MPU_xStreamBufferIsFull
 		#define xStreamBufferIsEmpty					MPU_xStreamBufferIsEmpty
@@ -0,0 +1,394 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Pools provide constant time allocation and freeing of fixed size objects
+ * from a single block of memory.  All the objects in a pool are the same size,
+ * so a pool cannot fragment, and allocating from a pool avoids the search and
+ * block splitting overhead of pvPortMalloc().  Pools are therefore well suited
+ * to applications that repeatedly create and delete many objects of the same
+ * type, such as message headers.
+ *
+ * Objects that have been freed are held on a singly linked list that is
+ * threaded through the first word of each free object.  Objects that have
+ * never been allocated are handed out in address order, so creating a pool
+ * does not need to touch the pool's storage and takes the same time no matter
+ * how many objects the pool holds.
+ *
+ * The kernel can also allocate task control blocks, queues and timers from
+ * internal pools - see the configTASK_POOL_LENGTH, configQUEUE_POOL_LENGTH and
+ * configTIMER_POOL_LENGTH definitions in FreeRTOSConfig.h.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include pool.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which pools are referenced.  For example, a call to xPoolCreate()
+ * returns a PoolHandle_t variable that can then be used as a parameter to
+ * pvPoolAlloc(), vPoolFree(), etc.
+ */
+typedef void * PoolHandle_t;
+
+/**
+ * Used with the vPoolGetStats() API function to obtain information about the
+ * use of a pool.
+ */
+typedef struct xPOOL_STATS
+{
+	size_t xObjectSize;						/* The size of each object in the pool after it has been rounded up to meet the alignment requirements of the port. */
+	UBaseType_t uxNumberOfObjects;			/* The total number of objects the pool can hold. */
+	UBaseType_t uxNumberOfFreeObjects;		/* The number of objects that are currently available for allocation. */
+	UBaseType_t uxMinimumEverFreeObjects;	/* The lowest number of free objects there have been since the pool was created. */
+	UBaseType_t uxNumberOfAllocations;		/* The number of calls to pvPoolAlloc() and pvPoolAllocFromISR() that returned an object. */
+	UBaseType_t uxNumberOfFailedAllocations;/* The number of calls to pvPoolAlloc() and pvPoolAllocFromISR() that returned NULL because the pool was empty. */
+	UBaseType_t uxNumberOfFrees;			/* The number of objects returned to the pool. */
+} PoolStats_t;
+
+/*
+ * The number of bytes of storage a pool actually uses for each object, which is
+ * the requested object size rounded up to hold at least a pointer and to meet
+ * the alignment requirements of the port.
+ */
+#define poolOBJECT_SIZE( xObjectSize ) ( ( ( ( ( size_t ) ( xObjectSize ) ) < sizeof( void * ) ? sizeof( void * ) : ( ( size_t ) ( xObjectSize ) ) ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/*
+ * The size, in bytes, of the storage area that must be passed into
+ * xPoolCreateStatic() to create a pool that holds uxNumberOfObjects objects of
+ * xObjectSize bytes each.
+ */
+#define poolSTORAGE_SIZE( xObjectSize, uxNumberOfObjects ) ( poolOBJECT_SIZE( xObjectSize ) * ( size_t ) ( uxNumberOfObjects ) )
+
+/*
+ * The kernel object types that can be allocated from the kernel's internal
+ * pools.  Passed into xPoolGetKernelObjectPool().
+ */
+#define poolKERNEL_POOL_TASKS		( ( BaseType_t ) 0 )
+#define poolKERNEL_POOL_QUEUES		( ( BaseType_t ) 1 )
+#define poolKERNEL_POOL_TIMERS		( ( BaseType_t ) 2 )
+
+/**
+ * pool.h
+ *
+<pre>
+PoolHandle_t xPoolCreate( size_t xObjectSize, UBaseType_t uxNumberOfObjects );
+</pre>
+ *
+ * Creates a new pool using dynamically allocated memory.  See
+ * xPoolCreateStatic() for a version that uses statically allocated memory
+ * (memory that is allocated at compile time).
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xPoolCreate() to be available.
+ *
+ * @param xObjectSize The size, in bytes, of each object the pool will hold.
+ *
+ * @param uxNumberOfObjects The maximum number of objects that can be allocated
+ * from the pool at any one time.
+ *
+ * @return If NULL is returned, then the pool cannot be created because there
+ * is insufficient heap memory available for FreeRTOS to allocate the pool data
+ * structure and storage area.  A non-NULL value being returned indicates that
+ * the pool has been created successfully - the returned value should be stored
+ * as the handle to the created pool.
+ *
+ * Example use:
+<pre>
+
+typedef struct A_MESSAGE
+{
+    uint32_t ulID;
+    uint8_t ucPayload[ 20 ];
+} Message_t;
+
+void vAFunction( void )
+{
+PoolHandle_t xPool;
+Message_t *pxMessage;
+
+    // Create a pool that can hold 50 messages.
+    xPool = xPoolCreate( sizeof( Message_t ), 50 );
+
+    if( xPool != NULL )
+    {
+        pxMessage = ( Message_t * ) pvPoolAlloc( xPool );
+
+        if( pxMessage != NULL )
+        {
+            // Use the message, then return it to the pool.
+            vPoolFree( xPool, pxMessage );
+        }
+    }
+}
+</pre>
+ * \defgroup xPoolCreate xPoolCreate
+ * \ingroup PoolManagement
+ */
+PoolHandle_t xPoolCreate( size_t xObjectSize, UBaseType_t uxNumberOfObjects ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ *
+<pre>
+PoolHandle_t xPoolCreateStatic( size_t xObjectSize,
+                                UBaseType_t uxNumberOfObjects,
+                                uint8_t * const pucPoolStorageArea,
+                                StaticPool_t * const pxStaticPool );
+</pre>
+ *
+ * Creates a new pool using statically allocated memory.  See xPoolCreate() for
+ * a version that uses dynamically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xPoolCreateStatic() to be available.
+ *
+ * @param xObjectSize The size, in bytes, of each object the pool will hold.
+ *
+ * @param uxNumberOfObjects The maximum number of objects that can be allocated
+ * from the pool at any one time.
+ *
+ * @param pucPoolStorageArea Must point to a uint8_t array that is at least
+ * poolSTORAGE_SIZE( xObjectSize, uxNumberOfObjects ) bytes big, and that meets
+ * the alignment requirements of the port (portBYTE_ALIGNMENT).  The objects
+ * allocated from the pool are placed in this array.
+ *
+ * @param pxStaticPool Must point to a variable of type StaticPool_t, which
+ * will be used to hold the pool's data structure.
+ *
+ * @return If the pool is created successfully then a handle to the created pool
+ * is returned.  If either pucPoolStorageArea or pxStaticPool are NULL then NULL
+ * is returned.
+ *
+ * Example use:
+<pre>
+
+#define NUMBER_OF_MESSAGES 50
+
+// Storage for the objects, and the structure that manages the pool.
+static uint8_t ucStorage[ poolSTORAGE_SIZE( sizeof( Message_t ), NUMBER_OF_MESSAGES ) ];
+static StaticPool_t xPoolStruct;
+
+void vAFunction( void )
+{
+PoolHandle_t xPool;
+
+    xPool = xPoolCreateStatic( sizeof( Message_t ),
+                               NUMBER_OF_MESSAGES,
+                               ucStorage,
+                               &xPoolStruct );
+
+    // As neither the pucPoolStorageArea or pxStaticPool parameters were NULL,
+    // xPool will not be NULL, and can be used to reference the created pool
+    // in other pool API calls.
+}
+</pre>
+ * \defgroup xPoolCreateStatic xPoolCreateStatic
+ * \ingroup PoolManagement
+ */
+PoolHandle_t xPoolCreateStatic( size_t xObjectSize,
+								UBaseType_t uxNumberOfObjects,
+								uint8_t * const pucPoolStorageArea,
+								StaticPool_t * const pxStaticPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ *
+<pre>
+void vPoolDelete( PoolHandle_t xPool );
+</pre>
+ *
+ * Deletes a pool that was previously created using a call to xPoolCreate() or
+ * xPoolCreateStatic().  If the pool was created using dynamic memory (that is,
+ * by xPoolCreate()), then the allocated memory is freed.
+ *
+ * Any objects that are still allocated from the pool become invalid when the
+ * pool is deleted.
+ *
+ * @param xPool The handle of the pool to be deleted.
+ *
+ * \defgroup vPoolDelete vPoolDelete
+ * \ingroup PoolManagement
+ */
+void vPoolDelete( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ *
+<pre>
+void *pvPoolAlloc( PoolHandle_t xPool );
+</pre>
+ *
+ * Allocates one object from a pool.  The time taken does not depend on the
+ * number of objects in the pool, or on the number of objects already
+ * allocated.  pvPoolAlloc() never blocks.
+ *
+ * Use pvPoolAllocFromISR() to allocate an object from an interrupt service
+ * routine (ISR).
+ *
+ * @param xPool The handle of the pool from which the object is allocated.
+ *
+ * @return A pointer to the allocated object, or NULL if all the objects in the
+ * pool are already allocated.  The returned object is not cleared.
+ *
+ * \defgroup pvPoolAlloc pvPoolAlloc
+ * \ingroup PoolManagement
+ */
+void *pvPoolAlloc( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ *
+<pre>
+void *pvPoolAllocFromISR( PoolHandle_t xPool );
+</pre>
+ *
+ * A version of pvPoolAlloc() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * @param xPool The handle of the pool from which the object is allocated.
+ *
+ * @return A pointer to the allocated object, or NULL if all the objects in the
+ * pool are already allocated.
+ *
+ * \defgroup pvPoolAllocFromISR pvPoolAllocFromISR
+ * \ingroup PoolManagement
+ */
+void *pvPoolAllocFromISR( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ *
+<pre>
+void vPoolFree( PoolHandle_t xPool, void *pvObject );
+</pre>
+ *
+ * Returns an object that was allocated by pvPoolAlloc() or pvPoolAllocFromISR()
+ * to the pool it was allocated from.  Objects can be freed from a different
+ * task, or from an interrupt, to the one that allocated them.
+ *
+ * Use vPoolFreeFromISR() to free an object from an interrupt service routine
+ * (ISR).
+ *
+ * @param xPool The handle of the pool from which the object was allocated.
+ *
+ * @param pvObject A pointer to the object being freed.
+ *
+ * \defgroup vPoolFree vPoolFree
+ * \ingroup PoolManagement
+ */
+void vPoolFree( PoolHandle_t xPool, void *pvObject ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ *
+<pre>
+void vPoolFreeFromISR( PoolHandle_t xPool, void *pvObject );
+</pre>
+ *
+ * A version of vPoolFree() that can be called from an interrupt service routine
+ * (ISR).
+ *
+ * @param xPool The handle of the pool from which the object was allocated.
+ *
+ * @param pvObject A pointer to the object being freed.
+ *
+ * \defgroup vPoolFreeFromISR vPoolFreeFromISR
+ * \ingroup PoolManagement
+ */
+void vPoolFreeFromISR( PoolHandle_t xPool, void *pvObject ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ *
+<pre>
+void vPoolGetStats( PoolHandle_t xPool, PoolStats_t *pxPoolStats );
+</pre>
+ *
+ * Populates a PoolStats_t structure with information about the use of a pool.
+ * The minimum ever free count can be used to size a pool so it holds no more
+ * objects than the application actually needs.
+ *
+ * @param xPool The handle of the pool being queried.
+ *
+ * @param pxPoolStats A pointer to the PoolStats_t structure that will be
+ * filled in.
+ *
+ * \defgroup vPoolGetStats vPoolGetStats
+ * \ingroup PoolManagement
+ */
+void vPoolGetStats( PoolHandle_t xPool, PoolStats_t *pxPoolStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ *
+<pre>
+PoolHandle_t xPoolGetKernelObjectPool( BaseType_t xObjectType );
+</pre>
+ *
+ * Returns the handle of one of the pools the kernel uses to allocate its own
+ * objects, so the pool can be passed into vPoolGetStats().
+ *
+ * @param xObjectType One of poolKERNEL_POOL_TASKS, poolKERNEL_POOL_QUEUES or
+ * poolKERNEL_POOL_TIMERS.
+ *
+ * @return The handle of the pool, or NULL if the pool has a length of zero in
+ * FreeRTOSConfig.h.
+ *
+ * \defgroup xPoolGetKernelObjectPool xPoolGetKernelObjectPool
+ * \ingroup PoolManagement
+ */
+PoolHandle_t xPoolGetKernelObjectPool( BaseType_t xObjectType ) PRIVILEGED_FUNCTION;
+
+/* Functions below here are not part of the public API. */
+
+/*
+ * Used by the kernel to allocate a task control block, queue or timer.  The
+ * object is taken from the kernel pool for xObjectType if the pool has been
+ * configured, xSize bytes fit in one of its objects, and the pool is not empty.
+ * Otherwise the object is allocated using pvPortMalloc().
+ */
+void *pvPoolAllocKernelObject( BaseType_t xObjectType, size_t xSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Frees an object allocated by pvPoolAllocKernelObject(), returning it either
+ * to the kernel pool or to the heap depending on where it was allocated from.
+ */
+void vPoolFreeKernelObject( BaseType_t xObjectType, void *pvObject ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( POOL_H ) */
@@ -132,6 +132,97 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/* The number of size classes in the allocation histogram returned by
+vPortGetHeapStats() when configUSE_HEAP_INSTRUMENTATION is set to 1. */
+#define heapNUMBER_OF_SIZE_CLASSES	16
+
+/* Used with vPortGetHeapStats() to obtain information about the state of the
+heap.  Provided by heap_4.c and heap_5.c. */
+typedef struct xHeapStats
+{
+	size_t xAvailableHeapSpaceInBytes;			/* The total heap size currently available - this is the sum of all the free blocks, not the largest block that can be allocated. */
+	size_t xSizeOfLargestFreeBlockInBytes;		/* The maximum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xSizeOfSmallestFreeBlockInBytes;		/* The minimum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xNumberOfFreeBlocks;					/* The number of free memory blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xMinimumEverFreeBytesRemaining;		/* The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
+	size_t xNumberOfSuccessfulAllocations;		/* The number of calls to pvPortMalloc() that have returned a valid memory block. */
+	size_t xNumberOfSuccessfulFrees;			/* The number of calls to vPortFree() that has successfully freed a block of memory. */
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		/* The number of blocks currently allocated in each size class.  Class 0
+		holds blocks of up to 32 bytes, including the block header, and each
+		following class holds blocks of up to twice the size of the class
+		before it.  The last class also holds all larger blocks. */
+		size_t xAllocatedBlocksInSizeClass[ heapNUMBER_OF_SIZE_CLASSES ];
+	#endif
+} HeapStats_t;
+
+/*
+ * Fills pxHeapStats with the free block count, the sizes of the largest and
+ * smallest free blocks, and the allocation counters.  The free blocks are
+ * walked with the scheduler suspended, so the time taken depends on how
+ * fragmented the heap is.
+ */
+void vPortGetHeapStats( HeapStats_t *pxHeapStats ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	/* Describes one block of the heap to the function passed into
+	vPortHeapDump(). */
+	typedef struct xHEAP_BLOCK_INFO
+	{
+		void *pvAddress;			/* The address returned by pvPortMalloc() if the block is allocated, otherwise the start of the free space. */
+		size_t xSizeInBytes;		/* The number of bytes in the block, excluding the block header. */
+		BaseType_t xIsAllocated;	/* pdTRUE if the block is allocated, pdFALSE if it is free. */
+		void *pvOwner;				/* The handle of the task that allocated the block, or NULL if the block is free or was allocated before the scheduler was started. */
+		void *pvCallSite;			/* The address from which pvPortMalloc() was called, or NULL if the block is free or the compiler cannot provide it. */
+	} HeapBlockInfo_t;
+
+	typedef void ( *HeapDumpFunction_t )( const HeapBlockInfo_t * const pxBlockInfo );
+
+	/*
+	 * Calls pxDumpFunction() once for every block in the heap, allocated or
+	 * free, in address order.  Blocks still owned by a task that has been
+	 * deleted, or that are not freed between two points in the program, are
+	 * memory leaks.  The heap is walked with the scheduler suspended, so
+	 * pxDumpFunction() must not block or call pvPortMalloc() or vPortFree().
+	 * Provided by heap_4.c and heap_5.c.
+	 */
+	void vPortHeapDump( HeapDumpFunction_t pxDumpFunction ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
+/*
+ * Describes the timer that generates the tick interrupt to
+ * vPortTicklessSuppressTicksAndSleep(), the generic tickless idle
+ * implementation in portable/Common/tickless.c.  The timer must count down
+ * from a reload value to zero, generate the tick interrupt and set an expired
+ * flag when it reaches zero, then continue from the reload value - as the
+ * Cortex-M SysTick does.  Ports that have such a timer can use the generic
+ * implementation rather than providing their own vPortSuppressTicksAndSleep().
+ */
+typedef struct xTICKLESS_TIMER
+{
+	uint32_t ulCountsPerTick;				/* The number of timer counts in one tick period. */
+	uint32_t ulMaximumSuppressedTicks;		/* The most tick periods the reload register can hold. */
+	uint32_t ulStoppedTimerCompensation;	/* Timer counts missed while the timer is stopped and restarted. */
+	void ( *vStop )( void );				/* Stop the timer without clearing its expired flag. */
+	void ( *vStart )( void );				/* Restart the timer from its current count. */
+	void ( *vRestartFromReload )( void );	/* Clear the count and expired flag so the timer restarts from the reload value, then start the timer. */
+	uint32_t ( *ulGetCount )( void );		/* Return the current count. */
+	void ( *vSetReload )( uint32_t );		/* Set the value the timer reloads from when it reaches zero. */
+	BaseType_t ( *xHasExpired )( void );	/* Return pdTRUE if the count reached zero since it was last restarted from the reload value. */
+	void ( *vDisableInterrupts )( void );	/* Globally mask interrupts in a way that still allows them to end a sleep. */
+	void ( *vEnableInterrupts )( void );
+	void ( *vWaitForInterrupt )( void );	/* Enter the low power state until an interrupt is pending. */
+} TicklessTimer_t;
+
+/*
+ * Generic tickless idle implementation.  Stops the tick interrupt for up to
+ * xExpectedIdleTime tick periods, sleeps, then steps the tick count forward by
+ * the number of tick periods that elapsed.
+ */
+void vPortTicklessSuppressTicksAndSleep( TickType_t xExpectedIdleTime, const TicklessTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -71,6 +71,7 @@ typedef void * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE	( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_SPSC				( ( uint8_t ) 5U )
 
 /**
  * queue. h
@@ -230,6 +231,74 @@ typedef void * QueueSetMemberHandle_t;
 	#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateSPSC(
+								  UBaseType_t uxQueueLength,
+								  UBaseType_t uxItemSize
+							  );
+ * </pre>
+ *
+ * Creates a single producer, single consumer queue.  configUSE_SPSC_QUEUES
+ * must be set to 1 in FreeRTOSConfig.h for xQueueCreateSPSC() to be available.
+ *
+ * The queue is used with the normal queue API, but exactly one task or
+ * interrupt may send to it and exactly one task or interrupt may receive from
+ * it.  In return for that restriction items are written and read without
+ * entering a critical section - a critical section is only entered when the
+ * sender or the receiver has to block, or has to unblock the other.
+ *
+ * Items can only be sent to the back of the queue (xQueueSend(),
+ * xQueueSendToBack() and their FromISR versions), and the queue cannot be a
+ * member of a queue set.  xQueueReset() must only be called when neither the
+ * sender nor the receiver is using the queue.
+ *
+ * The order in which the sender and receiver access the queue is enforced by
+ * portMEMORY_BARRIER().  A port that does not define portMEMORY_BARRIER() gets
+ * a default that only prevents the compiler reordering memory accesses, which
+ * is sufficient on single core ports.  Multi-core or weakly ordered ports must
+ * define portMEMORY_BARRIER() to issue a hardware barrier too.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must be greater than zero.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * \defgroup xQueueCreateSPSC xQueueCreateSPSC
+ * \ingroup QueueManagement
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_SPSC_QUEUES == 1 ) )
+	#define xQueueCreateSPSC( uxQueueLength, uxItemSize ) xQueueGenericCreate( ( uxQueueLength ), ( uxItemSize ), ( queueQUEUE_TYPE_SPSC ) )
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateSPSCStatic(
+										UBaseType_t uxQueueLength,
+										UBaseType_t uxItemSize,
+										uint8_t *pucQueueStorageBuffer,
+										StaticQueue_t *pxQueueBuffer
+									);
+ * </pre>
+ *
+ * Creates a single producer, single consumer queue using memory provided by
+ * the application writer.  See xQueueCreateSPSC() for a description of single
+ * producer, single consumer queues, and xQueueCreateStatic() for a description
+ * of the parameters.
+ *
+ * \defgroup xQueueCreateSPSCStatic xQueueCreateSPSCStatic
+ * \ingroup QueueManagement
+ */
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_SPSC_QUEUES == 1 ) )
+	#define xQueueCreateSPSCStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_SPSC ) )
+#endif
+
 /**
  * queue. h
  * <pre>
@@ -647,6 +716,69 @@ typedef void * QueueSetMemberHandle_t;
  */
 BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t uxQueueSendMultiple(
+									QueueHandle_t xQueue,
+									const void *pvItems,
+									UBaseType_t uxItemCount,
+									TickType_t xTicksToWait
+								);
+ </pre>
+ *
+ * Post uxItemCount items to the back of a queue.  The items are sent, and the
+ * tasks waiting to receive them are unblocked, using one critical section for
+ * as many items as the queue has space for, rather than one critical section
+ * per item as when xQueueSend() is called in a loop.  The items are queued by
+ * copy, not by reference.
+ *
+ * If the queue does not have space for all the items the items that fit are
+ * sent, then the calling task blocks until there is space for more, or the
+ * block time expires.
+ *
+ * Cannot be used with semaphores, mutexes or single producer, single consumer
+ * queues.  This function must not be called from an interrupt service
+ * routine.  See uxQueueSendMultipleFromISR() for an alternative which may be
+ * used in an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to an array of uxItemCount items to be placed on
+ * the queue.  The size of each item was defined when the queue was created.
+ *
+ * @param uxItemCount The number of items in the array pointed to by pvItems.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it be full.
+ *
+ * @return The number of items sent, which is less than uxItemCount if the
+ * block time expired before all the items could be sent.
+ *
+ * Example usage:
+   <pre>
+ void vLoggingTask( void *pvParameters )
+ {
+ struct ALogEntry xEntries[ 8 ];
+ UBaseType_t uxCount;
+
+	for( ;; )
+	{
+		uxCount = prvCollectEntries( xEntries, 8 );
+
+		// Post all the entries, waiting up to 10 ticks for space.
+		if( uxQueueSendMultiple( xQueue, xEntries, uxCount, 10 ) != uxCount )
+		{
+			// Some of the entries were dropped.
+		}
+	}
+ }
+ </pre>
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>
@@ -865,6 +997,197 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue, void * const pvBuffer ) PRIV
  */
 BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t uxQueueReceiveMultiple(
+									QueueHandle_t xQueue,
+									void *pvBuffer,
+									UBaseType_t uxMaxItems,
+									TickType_t xTicksToWait
+								);</pre>
+ *
+ * Receive up to uxMaxItems items from a queue using one critical section,
+ * rather than one critical section per item as when xQueueReceive() is called
+ * in a loop.  The items are received by copy so the buffer must be large
+ * enough to hold uxMaxItems items.
+ *
+ * The function returns as soon as at least one item is available, so the
+ * number of items received can be anything from 1 to uxMaxItems, or 0 if the
+ * block time expired before any items were available.
+ *
+ * Cannot be used with semaphores, mutexes or single producer, single consumer
+ * queues.  This function must not be used in an interrupt service routine.
+ * See uxQueueReceiveMultipleFromISR() for an alternative that can.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will be
+ * copied, in the order they were removed from the queue.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReserve(
+							QueueHandle_t xQueue,
+							void **ppvSlot,
+							TickType_t xTicksToWait
+						 );</pre>
+ *
+ * Reserve the next free slot in a single producer, single consumer queue so
+ * the item can be built directly in the queue's storage area, rather than
+ * being built in a buffer and then copied into the queue.  The item is not
+ * seen by the receiver until vQueueCommit() is called.
+ *
+ * Only available when configUSE_SPSC_QUEUES is set to 1, and only on queues
+ * created using xQueueCreateSPSC() or xQueueCreateSPSCStatic().  Each
+ * successful call to xQueueReserve() must be followed by a call to
+ * vQueueCommit() before the queue is written to again.
+ *
+ * This function must not be used in an interrupt service routine.  See
+ * xQueueReserveFromISR() for an alternative that can.
+ *
+ * @param xQueue The handle of the queue to reserve a slot in.
+ *
+ * @param ppvSlot Set to point to the reserved slot, which is uxItemSize bytes
+ * long, or to NULL if no slot was reserved.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot to become free should the queue be full.
+ *
+ * @return pdPASS if a slot was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+   <pre>
+ void vProducerTask( void *pvParameters )
+ {
+ struct ATelemetryRecord *pxRecord;
+
+	for( ;; )
+	{
+		if( xQueueReserve( xQueue, ( void ** ) &pxRecord, portMAX_DELAY ) == pdPASS )
+		{
+			// Fill in the record in place, then pass it to the receiver.
+			prvFillRecord( pxRecord );
+			vQueueCommit( xQueue );
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueReserve xQueueReserve
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReserve( QueueHandle_t xQueue, void ** const ppvSlot, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>void vQueueCommit( QueueHandle_t xQueue );</pre>
+ *
+ * Send the item built in the slot returned by the preceding call to
+ * xQueueReserve() to the back of the queue.  The slot must not be accessed
+ * once vQueueCommit() has been called.
+ *
+ * @param xQueue The handle of the queue the slot was reserved in.
+ *
+ * \defgroup vQueueCommit vQueueCommit
+ * \ingroup QueueManagement
+ */
+void vQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueuePeekAcquire(
+								QueueHandle_t xQueue,
+								void **ppvItem,
+								TickType_t xTicksToWait
+							 );</pre>
+ *
+ * Obtain a pointer to the item at the front of a single producer, single
+ * consumer queue so the item can be processed in the queue's storage area,
+ * rather than being copied out of the queue first.  The item remains in the
+ * queue, and its slot cannot be reused by the sender, until vQueueRelease()
+ * is called.
+ *
+ * Only available when configUSE_SPSC_QUEUES is set to 1, and only on queues
+ * created using xQueueCreateSPSC() or xQueueCreateSPSCStatic().  Each
+ * successful call to xQueuePeekAcquire() must be followed by a call to
+ * vQueueRelease() before the queue is read from again.
+ *
+ * This function must not be used in an interrupt service routine.  See
+ * xQueuePeekAcquireFromISR() for an alternative that can.
+ *
+ * @param xQueue The handle of the queue to acquire the item from.
+ *
+ * @param ppvItem Set to point to the item, which is uxItemSize bytes long, or
+ * to NULL if no item was acquired.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item should the queue be empty.
+ *
+ * @return pdPASS if an item was acquired, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xQueuePeekAcquire xQueuePeekAcquire
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueuePeekAcquire( QueueHandle_t xQueue, void ** const ppvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>void vQueueRelease( QueueHandle_t xQueue );</pre>
+ *
+ * Remove the item obtained by the preceding call to xQueuePeekAcquire() from
+ * the queue, returning its slot to the sender.  The item must not be accessed
+ * once vQueueRelease() has been called.
+ *
+ * @param xQueue The handle of the queue the item was acquired from.
+ *
+ * \defgroup vQueueRelease vQueueRelease
+ * \ingroup QueueManagement
+ */
+void vQueueRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReserveFromISR( QueueHandle_t xQueue, void **ppvSlot );
+ void vQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t *pxHigherPriorityTaskWoken );
+ BaseType_t xQueuePeekAcquireFromISR( QueueHandle_t xQueue, void **ppvItem );
+ void vQueueReleaseFromISR( QueueHandle_t xQueue, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * Versions of xQueueReserve(), vQueueCommit(), xQueuePeekAcquire() and
+ * vQueueRelease() that can be called from an interrupt service routine.  The
+ * reserve and acquire functions do not block, and return errQUEUE_FULL and
+ * pdFAIL respectively if the queue is full (empty).
+ *
+ * vQueueCommitFromISR() and vQueueReleaseFromISR() set
+ * *pxHigherPriorityTaskWoken to pdTRUE if committing (releasing) the item
+ * unblocked a task that has a priority higher than the currently running
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.  pxHigherPriorityTaskWoken can be set to NULL.
+ *
+ * \defgroup xQueueReserveFromISR xQueueReserveFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReserveFromISR( QueueHandle_t xQueue, void ** const ppvSlot ) PRIVILEGED_FUNCTION;
+void vQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xQueuePeekAcquireFromISR( QueueHandle_t xQueue, void ** const ppvItem ) PRIVILEGED_FUNCTION;
+void vQueueReleaseFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue );</pre>
@@ -1382,6 +1705,28 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherP
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue, const void *pvItems, UBaseType_t uxItemCount, BaseType_t *pxHigherPriorityTaskWoken );
+ UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void *pvBuffer, UBaseType_t uxMaxItems, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * Versions of uxQueueSendMultiple() and uxQueueReceiveMultiple() that can be
+ * called from an interrupt service routine.  Neither function blocks: as many
+ * items as there is space for (as are available, up to uxMaxItems) are sent
+ * (received) and the number of items sent (received) is returned.
+ *
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if sending (receiving) the
+ * items unblocked a task that has a priority higher than the currently
+ * running task, in which case a context switch should be requested before the
+ * interrupt is exited.  pxHigherPriorityTaskWoken can be set to NULL.
+ *
+ * \defgroup uxQueueSendMultipleFromISR uxQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -1404,6 +1749,14 @@ BaseType_t xQueueCRReceiveFromISR( QueueHandle_t xQueue, void *pvBuffer, BaseTyp
 BaseType_t xQueueCRSend( QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait );
 BaseType_t xQueueCRReceive( QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait );
 
+/*
+ * For internal use only.  Returns the list in which async tasks wait for the
+ * queue.  Async tasks use the macros defined within async.h.
+ */
+#if( configUSE_ASYNC_TASKS == 1 )
+	void *pvQueueGetAsyncTaskList( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Use xSemaphoreCreateMutex(),
  * xSemaphoreCreateCounting() or xSemaphoreGetMutexHolder() instead of calling
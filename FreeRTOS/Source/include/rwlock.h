@@ -0,0 +1,366 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Reader-writer locks protect data that is read often but written rarely.  Any
+ * number of tasks can hold a reader-writer lock for reading (shared access) at
+ * the same time, but only one task can hold it for writing (exclusive access),
+ * and then only while no task holds it for reading.
+ *
+ * Tasks that cannot obtain the lock wait in the Blocked state, in priority
+ * order, on one of two event lists held within the lock - one for readers and
+ * one for writers - so waiting tasks do not consume any CPU time.  The lock's
+ * policy decides which waiting tasks are unblocked when the lock is released
+ * while both readers and writers are waiting - see eRWLockPolicy.
+ *
+ * The task that holds the lock for writing is treated as a mutex holder, so it
+ * will inherit the priority of any higher priority task that blocks on the
+ * lock, exactly as if the lock were a mutex.  Priority inheritance is not
+ * performed for tasks that hold the lock for reading, as there can be any
+ * number of them.
+ *
+ * Reader-writer locks must not be used from interrupts, and are not recursive
+ * - a task that already holds the lock must not attempt to take it again, for
+ * reading or for writing.  There are no MPU wrappers for the reader-writer
+ * lock API, so with an MPU port only privileged tasks can use it.
+ *
+ * configUSE_RWLOCKS must be set to 1 in FreeRTOSConfig.h for reader-writer
+ * locks to be available.
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include rwlock.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which reader-writer locks are referenced.  For example, a call to
+ * xRWLockCreate() returns an RWLockHandle_t variable that can then be used as a
+ * parameter to xRWLockTakeRead(), xRWLockGiveWrite(), etc.
+ */
+typedef void * RWLockHandle_t;
+
+/**
+ * The policy used by a reader-writer lock, set when the lock is created.
+ */
+typedef enum
+{
+	eRWLockPreferReaders = 0,	/* A task can take the lock for reading whenever no task holds it for writing, even if writers are waiting.  Gives the most read concurrency, but writers can be starved by a continuous stream of readers. */
+	eRWLockPreferWriters		/* A task cannot take the lock for reading while a writer is waiting, and writers are unblocked before readers when the lock is released.  Writers cannot be starved, and updates are seen sooner. */
+} eRWLockPolicy;
+
+/**
+ * rwlock. h
+ *
+<pre>
+RWLockHandle_t xRWLockCreate( eRWLockPolicy ePolicy );
+</pre>
+ *
+ * Creates a new reader-writer lock using dynamically allocated memory.  See
+ * xRWLockCreateStatic() for a version that uses statically allocated memory
+ * (memory that is allocated at compile time).
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xRWLockCreate() to be available.
+ *
+ * @param ePolicy Either eRWLockPreferReaders or eRWLockPreferWriters - see the
+ * definition of eRWLockPolicy.
+ *
+ * @return If NULL is returned, then the lock cannot be created because there is
+ * insufficient heap memory available for FreeRTOS to allocate the lock data
+ * structure.  A non-NULL value being returned indicates that the lock has been
+ * created successfully - the returned value should be stored as the handle to
+ * the created lock.
+ *
+ * Example use:
+<pre>
+
+RWLockHandle_t xConfigLock;
+
+void vAFunction( void )
+{
+    // Create a lock that does not let readers starve writers.
+    xConfigLock = xRWLockCreate( eRWLockPreferWriters );
+
+    if( xConfigLock == NULL )
+    {
+        // There was insufficient FreeRTOS heap available for the lock to be
+        // created.
+    }
+}
+</pre>
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLockManagement
+ */
+RWLockHandle_t xRWLockCreate( eRWLockPolicy ePolicy ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock. h
+ *
+<pre>
+RWLockHandle_t xRWLockCreateStatic( eRWLockPolicy ePolicy, StaticRWLock_t *pxRWLockBuffer );
+</pre>
+ *
+ * Creates a new reader-writer lock using statically allocated memory.  See
+ * xRWLockCreate() for a version that uses dynamically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xRWLockCreateStatic() to be available.
+ *
+ * @param ePolicy Either eRWLockPreferReaders or eRWLockPreferWriters - see the
+ * definition of eRWLockPolicy.
+ *
+ * @param pxRWLockBuffer Must point to a variable of type StaticRWLock_t, which
+ * will then be used to hold the lock's data structure, removing the need for
+ * the memory to be allocated dynamically.
+ *
+ * @return If the lock is created successfully then a handle to the created lock
+ * is returned.  If pxRWLockBuffer is NULL then NULL is returned.
+ *
+ * Example use:
+<pre>
+
+static StaticRWLock_t xConfigLockBuffer;
+
+void vAFunction( void )
+{
+RWLockHandle_t xConfigLock;
+
+    xConfigLock = xRWLockCreateStatic( eRWLockPreferReaders, &xConfigLockBuffer );
+
+    // As pxRWLockBuffer was not NULL, xConfigLock will not be NULL, and can be
+    // used to reference the created lock in other lock API calls.
+}
+</pre>
+ * \defgroup xRWLockCreateStatic xRWLockCreateStatic
+ * \ingroup RWLockManagement
+ */
+RWLockHandle_t xRWLockCreateStatic( eRWLockPolicy ePolicy, StaticRWLock_t *pxRWLockBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock. h
+ *
+<pre>
+void vRWLockDelete( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * Deletes a reader-writer lock that was previously created using a call to
+ * xRWLockCreate() or xRWLockCreateStatic().  The lock must not be held, and no
+ * tasks can be waiting for it, when it is deleted.
+ *
+ * @param xRWLock The handle of the lock being deleted.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLockManagement
+ */
+void vRWLockDelete( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock. h
+ *
+<pre>
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+</pre>
+ *
+ * Takes a reader-writer lock for reading (shared access).  Any number of tasks
+ * can hold the lock for reading at the same time.  The lock cannot be taken for
+ * reading while a task holds it for writing or, if the lock was created with
+ * the eRWLockPreferWriters policy, while a task is waiting to take it for
+ * writing.
+ *
+ * A lock taken with xRWLockTakeRead() must be released with xRWLockGiveRead().
+ *
+ * @param xRWLock The handle of the lock being taken.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for the lock to become available for reading, should
+ * it not be available immediately.  Setting xTicksToWait to portMAX_DELAY will
+ * cause the task to wait indefinitely (provided INCLUDE_vTaskSuspend is set to
+ * 1 in FreeRTOSConfig.h).
+ *
+ * @return pdPASS if the lock was taken for reading.  pdFAIL if xTicksToWait
+ * expired before the lock became available.
+ *
+ * Example use:
+<pre>
+
+void vReadingTask( void * pvParameters )
+{
+    for( ;; )
+    {
+        // Wait up to 10 ticks for shared access to the configuration table.
+        if( xRWLockTakeRead( xConfigLock, 10 ) == pdPASS )
+        {
+            // Other readers can access the table at the same time as this
+            // task, but no task can change it.
+
+            xRWLockGiveRead( xConfigLock );
+        }
+    }
+}
+</pre>
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLockManagement
+ */
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock. h
+ *
+<pre>
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * Releases a reader-writer lock that was previously taken for reading using
+ * xRWLockTakeRead().  When the last reader releases the lock, the highest
+ * priority task waiting to take the lock for writing, if any, is unblocked.
+ *
+ * @param xRWLock The handle of the lock being released.
+ *
+ * @return pdPASS if the lock was released.  pdFAIL if the lock was not held for
+ * reading.
+ *
+ * \defgroup xRWLockGiveRead xRWLockGiveRead
+ * \ingroup RWLockManagement
+ */
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock. h
+ *
+<pre>
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+</pre>
+ *
+ * Takes a reader-writer lock for writing (exclusive access).  The lock can only
+ * be taken for writing when no other task holds it, for either reading or
+ * writing.
+ *
+ * The task that holds the lock for writing inherits the priority of any higher
+ * priority task that blocks on the lock, in the same way as the holder of a
+ * mutex.  A lock taken with xRWLockTakeWrite() must be released with
+ * xRWLockGiveWrite(), by the same task.
+ *
+ * @param xRWLock The handle of the lock being taken.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for the lock to become available for writing, should it
+ * not be available immediately.  Setting xTicksToWait to portMAX_DELAY will
+ * cause the task to wait indefinitely (provided INCLUDE_vTaskSuspend is set to
+ * 1 in FreeRTOSConfig.h).
+ *
+ * @return pdPASS if the lock was taken for writing.  pdFAIL if xTicksToWait
+ * expired before the lock became available.
+ *
+ * Example use:
+<pre>
+
+void vUpdateConfiguration( const Config_t * const pxNewConfig )
+{
+    // Wait as long as necessary for exclusive access to the table.
+    xRWLockTakeWrite( xConfigLock, portMAX_DELAY );
+    {
+        // No other task can read or write the table now.
+        memcpy( &xConfigTable, pxNewConfig, sizeof( xConfigTable ) );
+    }
+    xRWLockGiveWrite( xConfigLock );
+}
+</pre>
+ * \defgroup xRWLockTakeWrite xRWLockTakeWrite
+ * \ingroup RWLockManagement
+ */
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock. h
+ *
+<pre>
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * Releases a reader-writer lock that was previously taken for writing using
+ * xRWLockTakeWrite().  Any priority the calling task inherited while holding
+ * the lock is disinherited, then waiting tasks are unblocked in accordance with
+ * the lock's policy - either every waiting reader, or the highest priority
+ * waiting writer.
+ *
+ * @param xRWLock The handle of the lock being released.
+ *
+ * @return pdPASS if the lock was released.  pdFAIL if the calling task did not
+ * hold the lock for writing.
+ *
+ * \defgroup xRWLockGiveWrite xRWLockGiveWrite
+ * \ingroup RWLockManagement
+ */
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock. h
+ *
+<pre>
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * @param xRWLock The handle of the lock being queried.
+ *
+ * @return The number of tasks that currently hold the lock for reading.
+ *
+ * \defgroup uxRWLockGetReaderCount uxRWLockGetReaderCount
+ * \ingroup RWLockManagement
+ */
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock. h
+ *
+<pre>
+TaskHandle_t xRWLockGetWriter( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * @param xRWLock The handle of the lock being queried.
+ *
+ * @return The handle of the task that currently holds the lock for writing, or
+ * NULL if the lock is not held for writing.
+ *
+ * \defgroup xRWLockGetWriter xRWLockGetWriter
+ * \ingroup RWLockManagement
+ */
+TaskHandle_t xRWLockGetWriter( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* RWLOCK_H */
@@ -44,7 +44,9 @@
  * block time to 0.  Likewise, if there are to be multiple different readers
  * then the application writer must place each call to a reading API function
  * (such as xStreamBufferRead()) inside a critical section section and set the
- * receive block time to 0.
+ * receive block time to 0.  The exception is stream and message buffers created
+ * using xStreamBufferCreateMPMC() or xMessageBufferCreateMPMC(), which can have
+ * any number of writers and readers.
  *
  */
 
@@ -63,6 +65,18 @@ extern "C" {
  */
 typedef void * StreamBufferHandle_t;
 
+/**
+ * Describes a contiguous region of a stream buffer's storage area.  Used by
+ * xStreamBufferGetWriteSpans() and xStreamBufferGetReadSpans(), which describe
+ * the free space and the unread data in a stream buffer respectively as up to
+ * two such regions.
+ */
+typedef struct xSTREAM_BUFFER_SPAN
+{
+	uint8_t *pucData;	/*< The start of the region, or NULL if the region is empty. */
+	size_t xLength;		/*< The number of bytes in the region. */
+} StreamBufferSpan_t;
+
 
 /**
  * message_buffer.h
@@ -129,7 +143,7 @@ const size_t xStreamBufferSizeBytes = 100, xTriggerLevel = 10;
  * \defgroup xStreamBufferCreate xStreamBufferCreate
  * \ingroup StreamBufferManagement
  */
-#define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, pdFALSE )
+#define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, sbTYPE_STREAM_BUFFER )
 
 /**
  * stream_buffer.h
@@ -210,7 +224,71 @@ const size_t xTriggerLevel = 1;
  * \defgroup xStreamBufferCreateStatic xStreamBufferCreateStatic
  * \ingroup StreamBufferManagement
  */
-#define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pdFALSE, pucStreamBufferStorageArea, pxStaticStreamBuffer )
+#define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, sbTYPE_STREAM_BUFFER, pucStreamBufferStorageArea, pxStaticStreamBuffer )
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+StreamBufferHandle_t xStreamBufferCreateMPMC( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+</pre>
+ *
+ * Creates a new stream buffer that can be written to by more than one task or
+ * interrupt, and read from by more than one task or interrupt, at the same
+ * time.  configUSE_MPMC_STREAM_BUFFERS must be set to 1 in FreeRTOSConfig.h
+ * for xStreamBufferCreateMPMC() to be available.
+ *
+ * A stream buffer created using xStreamBufferCreate() assumes there is only
+ * one writer and one reader, so calls that use it must be placed in critical
+ * sections, or guarded by a mutex, if it is shared.
+ * A multi-producer, multi-consumer (MPMC) stream buffer does not need to be.
+ * Each writer reserves the region of the buffer it is going to write to, and
+ * each reader the region it is going to read from, in a short critical section
+ * that does not depend on the number of bytes being transferred.  The data
+ * itself is then copied with interrupts enabled, so writers and readers that
+ * preempt each other copy their data in parallel.  Data becomes visible to
+ * readers, and space visible to writers, once every transfer that was in
+ * progress in that direction has completed.
+ *
+ * Any number of tasks can be blocked on an MPMC stream buffer to wait for data
+ * or space.  They are held in priority order, so the highest priority waiting
+ * task is unblocked first, and are unblocked one at a time for as long as there
+ * is data or space left for the next.
+ *
+ * The parameters and return value are the same as for xStreamBufferCreate(),
+ * and the same API functions are used to send to and receive from the
+ * created stream buffer.  xStreamBufferSendCompletedFromISR() and
+ * xStreamBufferReceiveCompletedFromISR() unblock the highest priority waiting
+ * task, and the sbSEND_COMPLETED() and sbRECEIVE_COMPLETED() macros are not
+ * used.
+ *
+ * \defgroup xStreamBufferCreateMPMC xStreamBufferCreateMPMC
+ * \ingroup StreamBufferManagement
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MPMC_STREAM_BUFFERS == 1 ) )
+	#define xStreamBufferCreateMPMC( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, sbTYPE_MPMC_STREAM_BUFFER )
+#endif
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+StreamBufferHandle_t xStreamBufferCreateMPMCStatic( size_t xBufferSizeBytes,
+                                                    size_t xTriggerLevelBytes,
+                                                    uint8_t *pucStreamBufferStorageArea,
+                                                    StaticStreamBuffer_t *pxStaticStreamBuffer );
+</pre>
+ *
+ * Version of xStreamBufferCreateMPMC() that uses statically allocated memory.
+ * The parameters and return value are the same as for
+ * xStreamBufferCreateStatic().
+ *
+ * \defgroup xStreamBufferCreateMPMCStatic xStreamBufferCreateMPMCStatic
+ * \ingroup StreamBufferManagement
+ */
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MPMC_STREAM_BUFFERS == 1 ) )
+	#define xStreamBufferCreateMPMCStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, sbTYPE_MPMC_STREAM_BUFFER, pucStreamBufferStorageArea, pxStaticStreamBuffer )
+#endif
 
 /**
  * stream_buffer.h
@@ -585,6 +663,181 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
 									size_t xBufferLengthBytes,
 									BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferGetWriteSpans( StreamBufferHandle_t xStreamBuffer,
+                                   StreamBufferSpan_t pxSpans[ 2 ],
+                                   TickType_t xTicksToWait );
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xBytesWritten );
+</pre>
+ *
+ * Zero copy alternative to xStreamBufferSend().  xStreamBufferGetWriteSpans()
+ * describes the free space in the stream buffer as up to two contiguous spans
+ * of the buffer's storage area, the second being used only if the free space
+ * wraps around the end of the storage area.  The writer (for example a DMA
+ * engine or a peripheral driver) fills the spans in place, then calls
+ * xStreamBufferCommitWrite() to make the bytes available to the reader.
+ *
+ * The bytes must be written to the spans in order, starting at the beginning
+ * of pxSpans[ 0 ], and xStreamBufferCommitWrite() can commit fewer bytes than
+ * the spans describe.  Committing moves the buffer's head index on by
+ * xBytesWritten bytes, unblocks the reader if the trigger level is reached,
+ * and invalidates the spans.  If the bytes are written by a DMA engine then
+ * any cache maintenance must be performed before xStreamBufferCommitWrite() is
+ * called.
+ *
+ * Spans can only be used with stream buffers that have a single writer and a
+ * single reader - they cannot be used with message buffers or with buffers
+ * created using xStreamBufferCreateMPMC().  They can be mixed with calls to
+ * xStreamBufferReceive() by the reader.
+ *
+ * Use xStreamBufferGetWriteSpansFromISR() and xStreamBufferCommitWriteFromISR()
+ * from an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param pxSpans An array of two spans that is set to describe the free space.
+ * Spans that are not needed are set to a NULL pointer and zero length.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for at least one byte of space to become free should
+ * the stream buffer be full.
+ *
+ * @param xBytesWritten The number of bytes written to the spans.  Must not be
+ * more than the number of free bytes returned by the preceding call to
+ * xStreamBufferGetWriteSpans().
+ *
+ * @return xStreamBufferGetWriteSpans() returns the total number of free bytes
+ * described by the spans.  xStreamBufferCommitWrite() returns the number of
+ * bytes committed, which is 0 if xBytesWritten was too large.
+ *
+ * Example use:
+<pre>
+void vAFunction( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+size_t xFree, xWritten;
+
+    // Wait for up to 100ms for space to become free.
+    xFree = xStreamBufferGetWriteSpans( xStreamBuffer, xSpans, pdMS_TO_TICKS( 100 ) );
+
+    if( xFree > 0 )
+    {
+        // Let the peripheral fill the first span directly, then make the
+        // bytes it wrote available to the reader.
+        xWritten = prvReadPeripheral( xSpans[ 0 ].pucData, xSpans[ 0 ].xLength );
+        xStreamBufferCommitWrite( xStreamBuffer, xWritten );
+    }
+}
+</pre>
+ * \defgroup xStreamBufferGetWriteSpans xStreamBufferGetWriteSpans
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetWriteSpans( StreamBufferHandle_t xStreamBuffer,
+								   StreamBufferSpan_t pxSpans[ 2 ],
+								   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+								 size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferGetReadSpans( StreamBufferHandle_t xStreamBuffer,
+                                  StreamBufferSpan_t pxSpans[ 2 ],
+                                  TickType_t xTicksToWait );
+size_t xStreamBufferCommitRead( StreamBufferHandle_t xStreamBuffer,
+                                size_t xBytesRead );
+</pre>
+ *
+ * Zero copy alternative to xStreamBufferReceive().  xStreamBufferGetReadSpans()
+ * describes the unread data in the stream buffer as up to two contiguous spans
+ * of the buffer's storage area, the second being used only if the data wraps
+ * around the end of the storage area.  The reader (for example a protocol
+ * parser) processes the data in place, then calls xStreamBufferCommitRead() to
+ * free the space the processed bytes occupied.
+ *
+ * The bytes must be consumed in order, starting at the beginning of
+ * pxSpans[ 0 ], and xStreamBufferCommitRead() can commit fewer bytes than the
+ * spans describe - for example to leave an incomplete packet in the buffer
+ * until the rest of it arrives.  Committing moves the buffer's tail index on by
+ * xBytesRead bytes, unblocks the writer if it was waiting for space, and
+ * invalidates the spans.
+ *
+ * The same restrictions apply as for xStreamBufferGetWriteSpans().  Use
+ * xStreamBufferGetReadSpansFromISR() and xStreamBufferCommitReadFromISR() from
+ * an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param pxSpans An array of two spans that is set to describe the unread
+ * data.  Spans that are not needed are set to a NULL pointer and zero length.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data should the stream buffer be empty.  As with
+ * xStreamBufferReceive(), the task is not unblocked until the trigger level
+ * is reached or the block time expires.
+ *
+ * @param xBytesRead The number of bytes consumed from the spans.  Must not be
+ * more than the number of bytes returned by the preceding call to
+ * xStreamBufferGetReadSpans().
+ *
+ * @return xStreamBufferGetReadSpans() returns the total number of bytes
+ * described by the spans.  xStreamBufferCommitRead() returns the number of
+ * bytes committed, which is 0 if xBytesRead was too large.
+ *
+ * \defgroup xStreamBufferGetReadSpans xStreamBufferGetReadSpans
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetReadSpans( StreamBufferHandle_t xStreamBuffer,
+								  StreamBufferSpan_t pxSpans[ 2 ],
+								  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferCommitRead( StreamBufferHandle_t xStreamBuffer,
+								size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferGetWriteSpansFromISR( StreamBufferHandle_t xStreamBuffer, StreamBufferSpan_t pxSpans[ 2 ] );
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten, BaseType_t *pxHigherPriorityTaskWoken );
+size_t xStreamBufferGetReadSpansFromISR( StreamBufferHandle_t xStreamBuffer, StreamBufferSpan_t pxSpans[ 2 ] );
+size_t xStreamBufferCommitReadFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Versions of xStreamBufferGetWriteSpans(), xStreamBufferCommitWrite(),
+ * xStreamBufferGetReadSpans() and xStreamBufferCommitRead() that can be called
+ * from an interrupt service routine.  The functions that get spans do not
+ * block, and return 0 if the stream buffer is full (empty).
+ *
+ * The commit functions set *pxHigherPriorityTaskWoken to pdTRUE if committing
+ * the bytes unblocked a task that has a priority higher than the currently
+ * running task, in which case a context switch should be requested before the
+ * interrupt is exited.  *pxHigherPriorityTaskWoken should be set to pdFALSE
+ * before it is passed into the function.
+ *
+ * \defgroup xStreamBufferGetWriteSpansFromISR xStreamBufferGetWriteSpansFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetWriteSpansFromISR( StreamBufferHandle_t xStreamBuffer,
+										  StreamBufferSpan_t pxSpans[ 2 ] ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xBytesWritten,
+										BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferGetReadSpansFromISR( StreamBufferHandle_t xStreamBuffer,
+										 StreamBufferSpan_t pxSpans[ 2 ] ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferCommitReadFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xBytesRead,
+									   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -828,17 +1081,33 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
-/* Functions below here are not part of the public API. */
+/* Functions and definitions below here are not part of the public API. */
+
+/* Values for the xStreamBufferType parameter of xStreamBufferGenericCreate()
+and xStreamBufferGenericCreateStatic().  Bit 0 is set for a message buffer, so
+pdFALSE and pdTRUE remain valid values, and bit 1 for a multi-producer,
+multi-consumer buffer. */
+#define sbTYPE_STREAM_BUFFER			( ( BaseType_t ) 0 )
+#define sbTYPE_MESSAGE_BUFFER			( ( BaseType_t ) 1 )
+#define sbTYPE_MPMC_STREAM_BUFFER		( ( BaseType_t ) 2 )
+#define sbTYPE_MPMC_MESSAGE_BUFFER		( ( BaseType_t ) 3 )
+
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
-												 BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+												 BaseType_t xStreamBufferType ) PRIVILEGED_FUNCTION;
 
 StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 													   size_t xTriggerLevelBytes,
-													   BaseType_t xIsMessageBuffer,
+													   BaseType_t xStreamBufferType,
 													   uint8_t * const pucStreamBufferStorageArea,
 													   StaticStreamBuffer_t * const pxStaticStreamBuffer ) PRIVILEGED_FUNCTION;
 
+/* Returns the list in which async tasks wait for the stream buffer.  Async
+tasks use the macros defined within async.h. */
+#if( configUSE_ASYNC_TASKS == 1 )
+	void *pvStreamBufferGetAsyncTaskList( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 #if( configUSE_TRACE_FACILITY == 1 )
 	void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer, UBaseType_t uxStreamBufferNumber ) PRIVILEGED_FUNCTION;
 	UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
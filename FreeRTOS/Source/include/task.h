@@ -87,6 +87,15 @@ typedef enum
 	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
 } eNotifyAction;
 
+/* Actions that can be taken when a task exhausts the budget set by
+vTaskSetBudget(). */
+typedef enum
+{
+	eBudgetNotify = 0,	/* Record the exhaustion and call the budget exhausted hook, but let the task continue to run. */
+	eBudgetDemote,		/* Lower the task's priority until its budget is replenished. */
+	eBudgetSuspend		/* Hold the task in the Blocked state until its budget is replenished. */
+} eBudgetAction;
+
 /*
  * Used internally only.
  */
@@ -133,11 +142,29 @@ typedef struct xTASK_STATUS
 	eTaskState eCurrentState;		/* The state in which the task existed when the structure was populated. */
 	UBaseType_t uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
 	UBaseType_t uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
-	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	uint16_t usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+	#if( configGENERATE_TASK_SWITCH_STATS == 1 )
+		uint32_t ulVoluntarySwitches;						/* The number of times the task was switched out because it blocked, suspended or deleted itself. */
+		uint32_t ulInvoluntarySwitches;						/* The number of times the task was switched out while it was still able to run - because it was preempted, its time slice ended, or it yielded. */
+		configRUN_TIME_COUNTER_TYPE ulMaxRunTime;			/* The longest time, as defined by the run time stats clock, the task has run for without being switched out. */
+		configRUN_TIME_COUNTER_TYPE ulMaxTimeBetweenRuns;	/* The longest time, as defined by the run time stats clock, the task has waited to run again after being switched out while it was still able to run. */
+	#endif
 } TaskStatus_t;
 
+/* Used with the vTaskGetBudgetStatus() function to return the execution budget
+of a task. */
+typedef struct xTASK_BUDGET_STATUS
+{
+	uint32_t ulBudget;				/* The run time the task may use in each replenish period, as defined by the run time stats clock.  0 if the task does not have a budget. */
+	uint32_t ulBudgetUsed;			/* The run time the task has used in the current replenish period. */
+	TickType_t xReplenishPeriod;	/* The period, in ticks, at which the budget is replenished. */
+	TickType_t xNextReplenishTime;	/* The tick count at which the budget will next be replenished. */
+	UBaseType_t uxExhaustedCount;	/* The number of times the task has exhausted its budget. */
+	BaseType_t xExhausted;			/* pdTRUE if the task has exhausted its budget for the current replenish period, otherwise pdFALSE. */
+} TaskBudgetStatus_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -153,6 +180,23 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/**
+ * The core affinity mask that allows a task to run on any core.  Only used if
+ * configNUM_CORES is greater than 1.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskNO_AFFINITY				( ~( ( UBaseType_t ) 0U ) )
+
+/**
+ * The index within the array of task notifications used by the API functions
+ * that do not take an index parameter, such as xTaskNotify() and
+ * ulTaskNotifyTake().  Stream and message buffers also use this index.
+ *
+ * \ingroup TaskNotifications
+ */
+#define tskDEFAULT_INDEX_TO_NOTIFY	( 0 )
+
 /**
  * task. h
  *
@@ -176,7 +220,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskENTER_CRITICAL()		portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#if( configNUM_CORES == 1 )
+	#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#else
+	#define taskENTER_CRITICAL_FROM_ISR() uxTaskEnterCriticalFromISR()
+#endif
 
 /**
  * task. h
@@ -191,7 +239,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskEXIT_CRITICAL()			portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if( configNUM_CORES == 1 )
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#else
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) vTaskExitCriticalFromISR( x )
+#endif
 /**
  * task. h
  *
@@ -832,6 +884,294 @@ void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xT
  */
 BaseType_t xTaskAbortDelay( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+		/**
+		 * task. h
+		 *<pre>
+		 BaseType_t xTaskCreateDeadline(
+								  TaskFunction_t pvTaskCode,
+								  const char * const pcName,
+								  configSTACK_DEPTH_TYPE usStackDepth,
+								  void *pvParameters,
+								  TickType_t xPeriod,
+								  TickType_t xRelativeDeadline,
+								  TaskHandle_t *pvCreatedTask
+							  );</pre>
+		 *
+		 * configUSE_EDF_SCHEDULING and configSUPPORT_DYNAMIC_ALLOCATION must both
+		 * be set to 1 in FreeRTOSConfig.h for this function to be available.
+		 *
+		 * Create a periodic task that is scheduled earliest deadline first (EDF).
+		 * EDF tasks run at priority configEDF_TASK_PRIORITY, which defaults to the
+		 * highest priority.  Tasks of a higher priority than
+		 * configEDF_TASK_PRIORITY preempt EDF tasks, and EDF tasks preempt tasks
+		 * of a lower priority, as normal.  Between themselves, the EDF task that
+		 * has the earliest absolute deadline runs, and EDF tasks are not time
+		 * sliced.
+		 *
+		 * Each execution of the task's loop is a job.  The first job is released
+		 * when the task is created.  The task calls vTaskWaitForNextPeriod() when
+		 * each job completes, and the next job is released xPeriod ticks after
+		 * the completed job was released.  The absolute deadline of each job is
+		 * xRelativeDeadline ticks after the job was released.  A job that
+		 * completes after its deadline is counted as a deadline miss, see
+		 * uxTaskGetDeadlineMisses().
+		 *
+		 * Provided every EDF task completes its jobs within its deadline when
+		 * run alone, and the EDF tasks, plus any tasks of a higher priority, use
+		 * no more than 100% of the processor time, all the deadlines are met.
+		 *
+		 * Tasks that are not EDF tasks, but run at priority
+		 * configEDF_TASK_PRIORITY, for example because they hold a mutex an EDF
+		 * task is waiting for, are treated as having a deadline equal to the
+		 * time they became ready.
+		 *
+		 * @param pvTaskCode Pointer to the task entry function.  The function
+		 * must call vTaskWaitForNextPeriod() at the end of each job.
+		 *
+		 * @param pcName A descriptive name for the task.
+		 *
+		 * @param usStackDepth The size of the task stack specified as the number
+		 * of variables the stack can hold - not the number of bytes.
+		 *
+		 * @param pvParameters Pointer that will be used as the parameter for the
+		 * task being created.
+		 *
+		 * @param xPeriod The time, in ticks, between the release of consecutive
+		 * jobs.  Must be greater than zero.
+		 *
+		 * @param xRelativeDeadline The time, in ticks, after its release by which
+		 * each job must complete.  Must be greater than zero, and is normally no
+		 * more than xPeriod.
+		 *
+		 * @param pvCreatedTask Used to pass back a handle by which the created
+		 * task can be referenced.
+		 *
+		 * @return pdPASS if the task was successfully created and added to a ready
+		 * list, otherwise an error code defined in the file projdefs.h
+		 *
+		 * Example usage:
+		   <pre>
+		 // A control loop that runs every 10 ticks, and must complete each
+		 // iteration within 8 ticks of it starting.
+		 void vControlTask( void * pvParameters )
+		 {
+			 for( ;; )
+			 {
+				 vUpdateControlLoop();
+				 vTaskWaitForNextPeriod();
+			 }
+		 }
+
+		 void vOtherFunction( void )
+		 {
+			 xTaskCreateDeadline( vControlTask, "CTRL", configMINIMAL_STACK_SIZE, NULL, 10, 8, NULL );
+		 }
+		   </pre>
+		 * \defgroup xTaskCreateDeadline xTaskCreateDeadline
+		 * \ingroup Tasks
+		 */
+		BaseType_t xTaskCreateDeadline(	TaskFunction_t pxTaskCode,
+										const char * const pcName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+										const configSTACK_DEPTH_TYPE usStackDepth,
+										void * const pvParameters,
+										const TickType_t xPeriod,
+										const TickType_t xRelativeDeadline,
+										TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+	/**
+	 * task. h
+	 * <pre>void vTaskWaitForNextPeriod( void );</pre>
+	 *
+	 * configUSE_EDF_SCHEDULING must be set to 1 in FreeRTOSConfig.h for this
+	 * function to be available.
+	 *
+	 * Called by a task created by xTaskCreateDeadline() when its current job
+	 * has completed.  If the job completed after its deadline then the task's
+	 * deadline miss count is incremented, traceTASK_DEADLINE_MISSED() is
+	 * called, and, if configUSE_DEADLINE_MISS_HOOK is set to 1, the
+	 * application defined vApplicationDeadlineMissHook() is called.  The task
+	 * then blocks until its next job is released.  If the task has overrun its
+	 * period then the next job has already been released, so the task does
+	 * not block.
+	 *
+	 * \defgroup vTaskWaitForNextPeriod vTaskWaitForNextPeriod
+	 * \ingroup TaskCtrl
+	 */
+	void vTaskWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * task. h
+	 * <pre>UBaseType_t uxTaskGetDeadlineMisses( TaskHandle_t xTask );</pre>
+	 *
+	 * configUSE_EDF_SCHEDULING must be set to 1 in FreeRTOSConfig.h for this
+	 * function to be available.
+	 *
+	 * @param xTask Handle of the task to query.  Passing NULL queries the
+	 * calling task.
+	 *
+	 * @return The number of jobs of the task that have completed after their
+	 * deadline.  Always 0 for tasks that were not created by
+	 * xTaskCreateDeadline().
+	 *
+	 * \defgroup uxTaskGetDeadlineMisses uxTaskGetDeadlineMisses
+	 * \ingroup TaskUtils
+	 */
+	UBaseType_t uxTaskGetDeadlineMisses( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	/**
+	 * task. h
+	 * <pre>void vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xReplenishPeriod, eBudgetAction eAction, UBaseType_t uxDemotedPriority );</pre>
+	 *
+	 * configUSE_TASK_BUDGETS must be set to 1 in FreeRTOSConfig.h for this
+	 * function to be available.
+	 *
+	 * Limit the processor time a task can use.  The time a task runs for is
+	 * measured with the run time stats clock (see
+	 * portGET_RUN_TIME_COUNTER_VALUE()), and is checked against the budget in
+	 * the tick interrupt, so a task can overrun its budget by up to one tick
+	 * before the action is taken.  The budget is replenished every
+	 * xReplenishPeriod ticks.
+	 *
+	 * When a task exhausts its budget traceTASK_BUDGET_EXHAUSTED() is called,
+	 * and, if configUSE_BUDGET_EXHAUSTED_HOOK is set to 1, the application
+	 * defined vApplicationBudgetExhaustedHook() is called from within the tick
+	 * interrupt, then eAction is taken:
+	 *
+	 * eBudgetNotify - No further action is taken.
+	 *
+	 * eBudgetDemote - The task's priority is lowered to uxDemotedPriority
+	 * until its budget is replenished, at which time the priority it had when
+	 * it was demoted is restored.  A demoted task that holds a mutex still
+	 * inherits the priority of higher priority tasks that block on the mutex.
+	 *
+	 * eBudgetSuspend - The task is placed in the Blocked state until its budget
+	 * is replenished.  A task that uses this action should not hold a mutex for
+	 * longer than its budget.
+	 *
+	 * The idle task cannot be given a budget.
+	 *
+	 * @param xTask Handle of the task to which the budget applies.  Passing
+	 * NULL sets the budget of the calling task.
+	 *
+	 * @param ulBudget The run time, in run time stats clock counts, the task
+	 * can use in each replenish period.  Passing 0 removes the task's budget,
+	 * restoring its priority if it was demoted.  A task that is blocked because
+	 * it exhausted its budget remains blocked until the time at which its budget
+	 * would have been replenished.
+	 *
+	 * @param xReplenishPeriod The period, in ticks, at which the budget is
+	 * replenished.  Must not be 0 unless ulBudget is 0.
+	 *
+	 * @param eAction The action taken when the task exhausts its budget.
+	 *
+	 * @param uxDemotedPriority The priority the task runs at while its budget
+	 * is exhausted.  Only used when eAction is eBudgetDemote.
+	 *
+	 * Example usage:
+	   <pre>
+	 // A low criticality task that is allowed to use 1000 run time stats
+	 // clock counts every 100 ticks, and is otherwise run in the background.
+	 void vLowCriticalityTask( void * pvParameters )
+	 {
+		vTaskSetBudget( NULL, 1000UL, 100, eBudgetDemote, tskIDLE_PRIORITY );
+
+		for( ;; )
+		{
+			// Task code goes here.
+		}
+	 }
+	   </pre>
+	 * \defgroup vTaskSetBudget vTaskSetBudget
+	 * \ingroup TaskCtrl
+	 */
+	void vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xReplenishPeriod, eBudgetAction eAction, UBaseType_t uxDemotedPriority ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * task. h
+	 * <pre>void vTaskGetBudgetStatus( TaskHandle_t xTask, TaskBudgetStatus_t *pxBudgetStatus );</pre>
+	 *
+	 * configUSE_TASK_BUDGETS must be set to 1 in FreeRTOSConfig.h for this
+	 * function to be available.
+	 *
+	 * Populates a TaskBudgetStatus_t structure with the budget of a task, the
+	 * run time it has used in the current replenish period, and the number of
+	 * times it has exhausted its budget.
+	 *
+	 * @param xTask Handle of the task to query.  Passing NULL queries the
+	 * calling task.
+	 *
+	 * @param pxBudgetStatus The structure that will be filled with information
+	 * about the budget of the task referenced by xTask.
+	 *
+	 * \defgroup vTaskGetBudgetStatus vTaskGetBudgetStatus
+	 * \ingroup TaskUtils
+	 */
+	void vTaskGetBudgetStatus( TaskHandle_t xTask, TaskBudgetStatus_t *pxBudgetStatus ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_BUDGETS */
+
+#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+
+	/**
+	 * task. h
+	 * <pre>BaseType_t xTaskGetSchedulingLatencyHistogram( UBaseType_t uxPriority, uint32_t *pulHistogram, configRUN_TIME_COUNTER_TYPE *pulMaxLatency );</pre>
+	 *
+	 * configGENERATE_SCHEDULING_LATENCY_STATS must be set to 1 in
+	 * FreeRTOSConfig.h for this function to be available.
+	 *
+	 * The kernel records how long each task waits to run after it enters the
+	 * Ready state - after it is unblocked, resumed or created, or after it is
+	 * switched out while still able to run - as measured by the run time stats
+	 * clock.  The times are counted in one histogram per priority, each of
+	 * configSCHEDULING_LATENCY_BUCKETS buckets.  Bucket n counts waits of at
+	 * least 2^n, and less than 2^(n+1), run time stats clock counts, except
+	 * bucket 0 also counts waits of 0 and the last bucket counts all longer
+	 * waits.
+	 *
+	 * @param uxPriority The priority of the histogram to obtain.  Waits are
+	 * counted against the priority of the task at the time it was switched
+	 * in.
+	 *
+	 * @param pulHistogram An array of configSCHEDULING_LATENCY_BUCKETS values
+	 * into which the histogram is copied.
+	 *
+	 * @param pulMaxLatency Set to the longest wait of a task of priority
+	 * uxPriority.  Can be NULL if the longest wait is not required.
+	 *
+	 * @return pdFAIL if uxPriority is not a valid priority, otherwise pdPASS.
+	 *
+	 * \defgroup xTaskGetSchedulingLatencyHistogram xTaskGetSchedulingLatencyHistogram
+	 * \ingroup TaskUtils
+	 */
+	BaseType_t xTaskGetSchedulingLatencyHistogram( UBaseType_t uxPriority, uint32_t *pulHistogram, configRUN_TIME_COUNTER_TYPE *pulMaxLatency ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * task. h
+	 * <pre>void vTaskResetSchedulingLatencyStats( void );</pre>
+	 *
+	 * configGENERATE_SCHEDULING_LATENCY_STATS must be set to 1 in
+	 * FreeRTOSConfig.h for this function to be available.
+	 *
+	 * Clears the scheduling latency histograms, and the longest waits, of all
+	 * priorities.
+	 *
+	 * \defgroup vTaskResetSchedulingLatencyStats vTaskResetSchedulingLatencyStats
+	 * \ingroup TaskUtils
+	 */
+	void vTaskResetSchedulingLatencyStats( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
+
 /**
  * task. h
  * <pre>UBaseType_t uxTaskPriorityGet( TaskHandle_t xTask );</pre>
@@ -1483,6 +1823,75 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter )
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if( configNUM_CORES > 1 )
+
+	/**
+	 * xTaskGetIdleTaskHandleForCore() is only available if
+	 * INCLUDE_xTaskGetIdleTaskHandle is set to 1 in FreeRTOSConfig.h and
+	 * configNUM_CORES is greater than 1.
+	 *
+	 * One idle task is created for each core.  Returns the handle of the idle
+	 * task that was created for core xCoreID.  The idle tasks are not tied to
+	 * the cores they are created for, so the returned task is not necessarily
+	 * running on core xCoreID.
+	 */
+	TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * Returns the handle of the task that is running on core xCoreID.
+	 */
+	TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUM_CORES */
+
+#if( configUSE_CORE_AFFINITY == 1 )
+
+	/**
+	 * task. h
+	 * <pre>void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );</pre>
+	 *
+	 * configUSE_CORE_AFFINITY must be set to 1 in FreeRTOSConfig.h for this
+	 * function to be available.
+	 *
+	 * Sets the cores on which a task is allowed to run.  Bit n of
+	 * uxCoreAffinityMask is set if the task can run on core n, so a mask of
+	 * ( 1 << 0 ) ties the task to core 0.  Use tskNO_AFFINITY to allow the task
+	 * to run on any core.  Tasks are created with the affinity mask set by
+	 * configTASK_DEFAULT_CORE_AFFINITY.  If the task is running on a core that
+	 * is no longer in its affinity mask then the core is made to select another
+	 * task.
+	 *
+	 * @param xTask Handle of the task to set the affinity mask of.  Passing NULL
+	 * sets the affinity mask of the calling task.
+	 *
+	 * @param uxCoreAffinityMask The cores on which the task can run.  At least
+	 * one valid core must be included.
+	 *
+	 * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+	 * \ingroup Tasks
+	 */
+	void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * task. h
+	 * <pre>UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask );</pre>
+	 *
+	 * configUSE_CORE_AFFINITY must be set to 1 in FreeRTOSConfig.h for this
+	 * function to be available.
+	 *
+	 * @param xTask Handle of the task to query.  Passing NULL queries the calling
+	 * task.
+	 *
+	 * @return The core affinity mask of the task, as set by
+	 * vTaskCoreAffinitySet().
+	 *
+	 * \defgroup uxTaskCoreAffinityGet uxTaskCoreAffinityGet
+	 * \ingroup Tasks
+	 */
+	UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_CORE_AFFINITY */
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -1493,6 +1902,13 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
  * of run time consumed by the task.  See the TaskStatus_t structure
  * definition in this file for the full member list.
  *
+ * If configGENERATE_TASK_SWITCH_STATS is set to 1 in FreeRTOSConfig.h then
+ * each TaskStatus_t structure also contains the number of voluntary and
+ * involuntary context switches of the task, the longest time the task has run
+ * without being switched out, and the longest time it has waited to run again
+ * after being switched out while still able to run.  These are binary values,
+ * so can be collected at a high rate without the cost of formatting text.
+ *
  * NOTE:  This function is intended for debugging use only as its use results in
  * the scheduler remaining suspended for an extended period.
  *
@@ -1510,6 +1926,8 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
  * FreeRTOSConfig.h then *pulTotalRunTime is set by uxTaskGetSystemState() to the
  * total run time (as defined by the run time stats clock, see
  * http://www.freertos.org/rtos-run-time-stats.html) since the target booted.
+ * *pulTotalRunTime is of type configRUN_TIME_COUNTER_TYPE, which is uint32_t
+ * unless it is overridden in FreeRTOSConfig.h.
  * pulTotalRunTime can be set to NULL to omit the total run time information.
  *
  * @return The number of TaskStatus_t structures that were populated by
@@ -1526,7 +1944,7 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	volatile UBaseType_t uxArraySize, x;
-	uint32_t ulTotalRunTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalRunTime, ulStatsAsPercentage;
 
 		// Make sure the write buffer does not contain a string.
 		*pcWriteBuffer = 0x00;
@@ -1561,13 +1979,13 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
 					if( ulStatsAsPercentage > 0UL )
 					{
-						sprintf( pcWriteBuffer, "%s\t\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].pcTaskName, pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+						sprintf( pcWriteBuffer, "%s\t\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
 					}
 					else
 					{
 						// If the percentage is zero here then the task has
 						// consumed less than 1% of the total run time.
-						sprintf( pcWriteBuffer, "%s\t\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].pcTaskName, pxTaskStatusArray[ x ].ulRunTimeCounter );
+						sprintf( pcWriteBuffer, "%s\t\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
 					}
 
 					pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
@@ -1580,7 +1998,7 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	}
 	</pre>
  */
-UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -1686,12 +2104,27 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
  *
- * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
- * "notification value", which is a 32-bit unsigned integer (uint32_t).
+ * When configUSE_TASK_NOTIFICATIONS is set to one each task has an array of
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES private "notifications", each of which
+ * has a 32-bit unsigned integer (uint32_t) "notification value" and a
+ * notification state.  configTASK_NOTIFICATION_ARRAY_ENTRIES defaults to 1.
+ *
+ * Each entry in the array is independent of the others - a task waiting on
+ * the notification at one index is not unblocked by a notification sent to
+ * any other index.  That allows drivers, protocol stacks and application code
+ * to each own an index, and all use task notifications, without interfering
+ * with each other.
+ *
+ * xTaskNotifyIndexed() sends a notification to the array entry at index
+ * uxIndexToNotify.  xTaskNotify() is equivalent to xTaskNotifyIndexed() with
+ * uxIndexToNotify set to tskDEFAULT_INDEX_TO_NOTIFY (0), and is provided for
+ * backward compatibility.  The same is true of all the other "Indexed" task
+ * notification API functions and macros.
  *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
@@ -1721,6 +2154,11 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index within the target task's array of
+ * notifications to which the notification is sent.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  The versions of the API that do
+ * not have this parameter always send to index tskDEFAULT_INDEX_TO_NOTIFY.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1762,13 +2200,16 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1807,6 +2248,11 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index within the target task's array of
+ * notifications to which the notification is sent.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  The versions of the API that do
+ * not have this parameter always send to index tskDEFAULT_INDEX_TO_NOTIFY.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1853,13 +2299,16 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1890,6 +2339,11 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index within the calling task's array of
+ * notifications on which the calling task will wait.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  The versions of the API that do not
+ * have this parameter always wait on index tskDEFAULT_INDEX_TO_NOTIFY.
+ *
  * @param ulBitsToClearOnEntry Bits that are set in ulBitsToClearOnEntry value
  * will be cleared in the calling task's notification value before the task
  * checks to see if any notifications are pending, and optionally blocks if no
@@ -1930,11 +2384,14 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );</PRE>
+ * <PRE>BaseType_t xTaskNotifyGiveIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -1976,11 +2433,13 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
  * <PRE>void vTaskNotifyGiveFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+ * <PRE>void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken );
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2031,11 +2490,14 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
+ * <PRE>uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2079,6 +2541,11 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index within the calling task's array of
+ * notifications on which the calling task will wait.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  The versions of the API that do not
+ * have this parameter always wait on index tskDEFAULT_INDEX_TO_NOTIFY.
+ *
  * @param xClearCountOnExit if xClearCountOnExit is pdFALSE then the task's
  * notification value is decremented when the function exits.  In this way the
  * notification value acts like a counting semaphore.  If xClearCountOnExit is
@@ -2100,23 +2567,30 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWaitOn ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );</pre>
+ * <PRE>BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear );</pre>
  *
  * If the notification state of the task referenced by the handle xTask is
  * eNotified, then set the task's notification state to eNotWaitingNotification.
  * The task's notification value is not altered.  Set xTask to NULL to clear the
- * notification state of the calling task.
+ * notification state of the calling task.  xTaskNotifyStateClearIndexed()
+ * clears the notification at index uxIndexToClear, xTaskNotifyStateClear()
+ * clears the notification at index tskDEFAULT_INDEX_TO_NOTIFY.
  *
  * @return pdTRUE if the task's notification state was set to
  * eNotWaitingNotification, otherwise pdFALSE.
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
 
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -2205,13 +2679,17 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
  * vTaskRemoveFromUnorderedEventList() is used when the event list is not
  * ordered and the event list items hold something other than the owning tasks
  * priority.  In this case the event list item value is updated to the value
- * passed in the xItemValue parameter.
+ * passed in the xItemValue parameter.  vTaskRemoveFromUnorderedEventList() must
+ * be called with the scheduler suspended.
+ * xTaskRemoveFromUnorderedEventListFromISR() does the same, but can be called
+ * from a critical section, including a critical section within an ISR.
  *
  * @return pdTRUE if the task being removed has a higher priority than the task
  * making the call, otherwise pdFALSE.
  */
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
@@ -2223,6 +2701,25 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const Tick
  */
 void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
 
+#if( configNUM_CORES > 1 )
+
+	/*
+	 * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE ONLY
+	 * INTENDED FOR USE WHEN IMPLEMENTING A MULTICORE PORT OF THE SCHEDULER.
+	 *
+	 * Enter and exit a critical section that excludes interrupts on the calling
+	 * core and the other cores, by masking interrupts and taking the kernel
+	 * spinlocks.  A yield requested from within a critical section is held
+	 * pending until the critical section is exited.
+	 */
+	void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+	void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+	UBaseType_t uxTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+	void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+	void vTaskYieldWithinAPI( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUM_CORES */
+
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
  * THE EVENT BITS MODULE.
@@ -2322,6 +2819,26 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 void *pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Used when configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+ * is 1.  vTaskAddHeldMutex() adds a mutex to the list of mutexes held by the
+ * calling task when the mutex is taken.  The owner of pxMutexHeldListItem must
+ * be the mutex's list of waiting tasks, so the holder's inherited priority can
+ * be recalculated from every mutex it holds.  The item is removed from the
+ * list using uxListRemove() when the mutex is given back.
+ */
+void vTaskAddHeldMutex( ListItem_t * const pxMutexHeldListItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Used when configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+ * is 1.  Record the mutex the calling task is about to block on, and query the
+ * mutex a task is blocked on, so a priority can be passed along a chain of
+ * mutex holders that are each blocked on a mutex held by the next.  The record
+ * is cleared when the task is removed from the mutex's event list.
+ */
+void vTaskSetBlockedOnMutex( void * const pvMutex ) PRIVILEGED_FUNCTION;
+void *pvTaskGetBlockedOnMutex( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critial
  * section.
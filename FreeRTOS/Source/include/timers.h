@@ -362,6 +362,77 @@ typedef void (*PendedFunction_t)( void *, uint32_t );
 										StaticTimer_t *pxTimerBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * TimerHandle_t xTimerCreateWithSlack(	const char * const pcTimerName,
+ * 										TickType_t xTimerPeriodInTicks,
+ * 										UBaseType_t uxAutoReload,
+ * 										void * pvTimerID,
+ * 										TimerCallbackFunction_t pxCallbackFunction,
+ * 										TickType_t xTimerSlack );
+ *
+ * TimerHandle_t xTimerCreateStaticWithSlack(	const char * const pcTimerName,
+ * 												TickType_t xTimerPeriodInTicks,
+ * 												UBaseType_t uxAutoReload,
+ * 												void * pvTimerID,
+ * 												TimerCallbackFunction_t pxCallbackFunction,
+ * 												TickType_t xTimerSlack,
+ * 												StaticTimer_t *pxTimerBuffer );
+ *
+ * Creates a timer in the same way as xTimerCreate() and xTimerCreateStatic()
+ * respectively, but allows the timer to expire up to xTimerSlack ticks after
+ * its expiry time.  The timer never expires before its expiry time.
+ *
+ * Giving timers that do not need to expire at an exact time some slack allows
+ * the timer service task to process them when it wakes to process another
+ * timer, instead of waking at the exact expiry time of each.  That reduces
+ * the number of times the timer service task runs and, when
+ * configUSE_TICKLESS_IDLE is 1, lengthens the periods for which the tick can be
+ * suppressed.  The timer service task wakes when the first timer reaches its
+ * expiry time plus its slack, and in the same wake-up also processes the timers
+ * that follow it, in the order they reach their expiry time plus their slack,
+ * for as long as their expiry time has been reached.  Timers created with the same slack are therefore always
+ * processed in the order they expire.  Auto-reload timers are reloaded relative
+ * to their expiry time, not the time they were processed, so slack does not
+ * cause them to drift.
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for these functions
+ * to be available.  xTimerCreateWithSlack() also requires
+ * configSUPPORT_DYNAMIC_ALLOCATION to be 1, and xTimerCreateStaticWithSlack()
+ * requires configSUPPORT_STATIC_ALLOCATION to be 1.
+ *
+ * @param xTimerSlack The number of ticks after its expiry time the timer can be
+ * processed by.  A slack of 0 creates a timer that behaves exactly as one created
+ * by xTimerCreate() or xTimerCreateStatic().
+ *
+ * All other parameters, and the return value, are as for xTimerCreate() and
+ * xTimerCreateStatic().
+ *
+ * Example usage:
+ * @verbatim
+ * // Housekeeping that should run about once a second, but can run up to a
+ * // quarter of a second late.
+ * xTimer = xTimerCreateWithSlack( "Housekeeping", pdMS_TO_TICKS( 1000 ), pdTRUE, NULL, vHousekeepingCallback, pdMS_TO_TICKS( 250 ) );
+ * @endverbatim
+ */
+#if( ( configUSE_TIMER_SLACK == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	TimerHandle_t xTimerCreateWithSlack(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const TickType_t xTimerPeriodInTicks,
+											const UBaseType_t uxAutoReload,
+											void * const pvTimerID,
+											TimerCallbackFunction_t pxCallbackFunction,
+											const TickType_t xTimerSlack ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( ( configUSE_TIMER_SLACK == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	TimerHandle_t xTimerCreateStaticWithSlack(	const char * const pcTimerName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												const TickType_t xTimerPeriodInTicks,
+												const UBaseType_t uxAutoReload,
+												void * const pvTimerID,
+												TimerCallbackFunction_t pxCallbackFunction,
+												const TickType_t xTimerSlack,
+												StaticTimer_t *pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * void *pvTimerGetTimerID( TimerHandle_t xTimer );
  *
@@ -1246,7 +1317,8 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 *
 * Returns the time in ticks at which the timer will expire.  If this is less
 * than the current tick count then the expiry time has overflowed from the
-* current time.
+* current time.  The time returned does not include any slack the timer was
+* created with, so is the earliest time the timer will expire.
 *
 * @param xTimer The handle of the timer being queried.
 *
@@ -1256,6 +1328,23 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+* TickType_t xTimerGetSlack( TimerHandle_t xTimer );
+*
+* Returns the number of ticks a timer can expire after its expiry time, as set
+* when the timer was created by xTimerCreateWithSlack() or
+* xTimerCreateStaticWithSlack().  configUSE_TIMER_SLACK must be set to 1 in
+* FreeRTOSConfig.h for xTimerGetSlack() to be available.
+*
+* @param xTimer The handle of the timer being queried.
+*
+* @return The slack of the timer in ticks, which is 0 if the timer was created
+* by xTimerCreate() or xTimerCreateStatic().
+*/
+#if( configUSE_TIMER_SLACK == 1 )
+	TickType_t xTimerGetSlack( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
@@ -0,0 +1,482 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Work queues run short pieces of deferred processing - work items - on a set
+ * of worker tasks owned by the work queue.  They serve the same purpose as
+ * xTimerPendFunctionCall(), but rather than every deferred function being
+ * executed one after another by the single timer service task, a work queue
+ * can have any number of worker tasks, each with its own priority, so a work
+ * item that blocks or runs for a long time does not hold up all the others.
+ *
+ * A work item is created once, with the function it runs and the parameter
+ * passed to the function, then submitted to a work queue each time the
+ * function needs to run, either straight away or after a delay.  Work items
+ * do not allocate any memory when they are submitted, and can be submitted
+ * from interrupts.  A work item that is already waiting to run cannot be
+ * submitted again until it has started running, so a work item that is
+ * submitted many times before a worker gets to it runs once.
+ *
+ * Each worker task has its own list of work items waiting to run.  A work item
+ * that is submitted by one of the queue's own worker tasks is added to that
+ * worker's list, otherwise work items are shared between the workers in turn.
+ * A worker that runs out of work items takes (steals) the oldest work item
+ * from the worker with the most work items waiting, so no work item waits
+ * while a worker is idle.
+ *
+ * Work items that are submitted with a delay are held in a list ordered by the
+ * time at which they become ready to run.  Only one idle worker at a time
+ * waits for the first of them to become ready.
+ *
+ * Work functions run in the context of a worker task, so can call any API
+ * function that can be called from a task, including those that block.  They
+ * must not use the worker task's task notification at index
+ * configWORK_QUEUE_NOTIFICATION_INDEX, which is used to wake the worker.
+ */
+
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include workqueue.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which work queues are referenced.  For example, a call to
+ * xWorkQueueCreate() returns a WorkQueueHandle_t variable that can then be
+ * used as a parameter to xWorkQueueSubmit(), vWorkQueueGetStats(), etc.
+ */
+typedef void * WorkQueueHandle_t;
+
+/**
+ * Type by which work items are referenced.  For example, a call to
+ * xWorkItemCreate() returns a WorkItemHandle_t variable that can then be used
+ * as a parameter to xWorkQueueSubmit(), xWorkItemCancel(), etc.
+ */
+typedef void * WorkItemHandle_t;
+
+/*
+ * Defines the prototype to which work functions must conform.  The parameter
+ * is the pvParameter value passed into xWorkItemCreate().
+ */
+typedef void (*WorkFunction_t)( void *pvParameter );
+
+/**
+ * Used with the vWorkQueueGetStats() API function to obtain information about
+ * the use of a work queue.
+ */
+typedef struct xWORK_QUEUE_STATS
+{
+	UBaseType_t uxNumberOfWorkers;			/* The number of worker tasks that run the queue's work items. */
+	UBaseType_t uxPendingItems;				/* The number of work items that are ready to run but have not yet started. */
+	UBaseType_t uxDelayedItems;				/* The number of work items that were submitted with a delay that has not yet expired. */
+	UBaseType_t uxMaxPendingItems;			/* The highest value uxPendingItems has had since the queue was created. */
+	UBaseType_t uxNumberOfSubmissions;		/* The number of times a work item was successfully submitted to the queue. */
+	UBaseType_t uxNumberOfFailedSubmissions;/* The number of times a work item could not be submitted to the queue because it was already waiting to run. */
+	UBaseType_t uxNumberOfItemsRun;			/* The number of work items that have run to completion. */
+	UBaseType_t uxNumberOfItemsStolen;		/* The number of work items that were run by a worker other than the one they were given to. */
+	UBaseType_t uxNumberOfItemsCancelled;	/* The number of work items that were cancelled before they started. */
+	TickType_t xMaxLatency;					/* The longest time, in ticks, between a work item becoming ready to run and starting to run. */
+} WorkQueueStats_t;
+
+/**
+ * workqueue. h
+ *
+<pre>
+WorkQueueHandle_t xWorkQueueCreate( const char * const pcName,
+                                    UBaseType_t uxNumberOfWorkers,
+                                    const UBaseType_t * const puxWorkerPriorities,
+                                    configSTACK_DEPTH_TYPE usWorkerStackDepth );
+</pre>
+ *
+ * Creates a new work queue, and the worker tasks that run the work items that
+ * are submitted to it, using dynamically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xWorkQueueCreate() to be available.  Work queues are
+ * intended to exist for as long as the application runs, so cannot be deleted.
+ *
+ * @param pcName The name given to each of the queue's worker tasks.
+ *
+ * @param uxNumberOfWorkers The number of worker tasks to create.  Must be at
+ * least 1.
+ *
+ * @param puxWorkerPriorities An array of uxNumberOfWorkers priorities, one for
+ * each worker task.  Work items can run on any of the workers, so a work item
+ * runs at the priority of the worker that runs it.  Giving workers different
+ * priorities lets the highest priority idle worker take a work item as soon as
+ * it is submitted, while lower priority workers take up the remaining work
+ * items when higher priority tasks are not running.
+ *
+ * @param usWorkerStackDepth The size of each worker task's stack, specified as
+ * the number of variables the stack can hold - not the number of bytes.  See
+ * xTaskCreate().
+ *
+ * @return If NULL is returned, then the work queue cannot be created because
+ * there is insufficient heap memory available for FreeRTOS to allocate the
+ * work queue data structure or the worker tasks.  A non-NULL value being
+ * returned indicates that the work queue has been created successfully - the
+ * returned value should be stored as the handle to the created work queue.
+ *
+ * Example use:
+<pre>
+
+WorkQueueHandle_t xIOWorkQueue;
+
+void vAFunction( void )
+{
+const UBaseType_t uxPriorities[ 3 ] = { 3, 2, 2 };
+
+    // Create a work queue with three workers, one of which has a higher
+    // priority than the other two.
+    xIOWorkQueue = xWorkQueueCreate( "IOWork", 3, uxPriorities, configMINIMAL_STACK_SIZE * 2 );
+
+    if( xIOWorkQueue == NULL )
+    {
+        // There was insufficient FreeRTOS heap available for the work queue
+        // to be created.
+    }
+}
+</pre>
+ * \defgroup xWorkQueueCreate xWorkQueueCreate
+ * \ingroup WorkQueueManagement
+ */
+WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, UBaseType_t uxNumberOfWorkers, const UBaseType_t * const puxWorkerPriorities, configSTACK_DEPTH_TYPE usWorkerStackDepth ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ *
+<pre>
+WorkItemHandle_t xWorkItemCreate( WorkFunction_t pxWorkFunction, void *pvParameter );
+</pre>
+ *
+ * Creates a new work item using dynamically allocated memory.  See
+ * xWorkItemCreateStatic() for a version that uses statically allocated memory
+ * (memory that is allocated at compile time).
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xWorkItemCreate() to be available.
+ *
+ * @param pxWorkFunction The function a worker task calls each time the work
+ * item runs.
+ *
+ * @param pvParameter The value passed into pxWorkFunction.
+ *
+ * @return If NULL is returned, then the work item cannot be created because
+ * there is insufficient heap memory available for FreeRTOS to allocate the
+ * work item data structure.  A non-NULL value being returned indicates that
+ * the work item has been created successfully - the returned value should be
+ * stored as the handle to the created work item.
+ *
+ * Example use:
+<pre>
+
+static void prvFlushLog( void *pvParameter )
+{
+    // Write buffered log messages to the file system.  The worker task can
+    // block while the write completes.
+}
+
+WorkItemHandle_t xFlushLogWork;
+
+void vAFunction( void )
+{
+    xFlushLogWork = xWorkItemCreate( prvFlushLog, NULL );
+}
+</pre>
+ * \defgroup xWorkItemCreate xWorkItemCreate
+ * \ingroup WorkQueueManagement
+ */
+WorkItemHandle_t xWorkItemCreate( WorkFunction_t pxWorkFunction, void *pvParameter ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ *
+<pre>
+WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxWorkFunction,
+                                        void *pvParameter,
+                                        StaticWorkItem_t *pxWorkItemBuffer );
+</pre>
+ *
+ * Creates a new work item using statically allocated memory.  See
+ * xWorkItemCreate() for a version that uses dynamically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xWorkItemCreateStatic() to be available.
+ *
+ * @param pxWorkFunction The function a worker task calls each time the work
+ * item runs.
+ *
+ * @param pvParameter The value passed into pxWorkFunction.
+ *
+ * @param pxWorkItemBuffer Must point to a variable of type StaticWorkItem_t,
+ * which will be used to hold the work item's data structure.
+ *
+ * @return If pxWorkItemBuffer is not NULL then a handle to the created work
+ * item is returned.  If pxWorkItemBuffer is NULL then NULL is returned.
+ *
+ * Example use:
+<pre>
+
+static StaticWorkItem_t xFlushLogWorkBuffer;
+WorkItemHandle_t xFlushLogWork;
+
+void vAFunction( void )
+{
+    xFlushLogWork = xWorkItemCreateStatic( prvFlushLog, NULL, &xFlushLogWorkBuffer );
+}
+</pre>
+ * \defgroup xWorkItemCreateStatic xWorkItemCreateStatic
+ * \ingroup WorkQueueManagement
+ */
+WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxWorkFunction, void *pvParameter, StaticWorkItem_t *pxWorkItemBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ *
+<pre>
+void vWorkItemDelete( WorkItemHandle_t xWorkItem );
+</pre>
+ *
+ * Deletes a work item that was previously created using either
+ * xWorkItemCreate() or xWorkItemCreateStatic().  The work item must not be
+ * waiting to run or running - see xWorkItemCancel() and xWorkItemIsBusy().
+ *
+ * @param xWorkItem The handle of the work item being deleted.
+ *
+ * \defgroup vWorkItemDelete vWorkItemDelete
+ * \ingroup WorkQueueManagement
+ */
+void vWorkItemDelete( WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ *
+<pre>
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                             WorkItemHandle_t xWorkItem,
+                             TickType_t xDelay );
+</pre>
+ *
+ * Submits a work item to a work queue, so one of the queue's worker tasks
+ * calls the work item's function.  The function is called once each time the
+ * work item is submitted, unless the work item is submitted again before it
+ * has started to run, in which case the second submission fails.  A work item
+ * that is running can be submitted again, including by its own function.
+ *
+ * This function must not be called from an interrupt service routine.  See
+ * xWorkQueueSubmitFromISR() for a version that can.
+ *
+ * @param xWorkQueue The handle of the work queue the work item is submitted
+ * to.  A work item can be submitted to different work queues at different
+ * times, but can only be waiting on one of them at a time.
+ *
+ * @param xWorkItem The handle of the work item being submitted.
+ *
+ * @param xDelay The number of ticks that must pass before the work item is
+ * ready to run.  Zero makes the work item ready to run straight away.
+ *
+ * @return pdPASS if the work item was submitted.  pdFAIL if the work item was
+ * already waiting to run, either on this work queue or another.
+ *
+ * Example use:
+<pre>
+
+void vALogFunction( const char *pcMessage )
+{
+    // Buffer the message, then make sure the buffered messages are written
+    // out within 100ms.  If the flush is already waiting to run the buffered
+    // message will be written out by that flush, so the return value does
+    // not need to be checked.
+    prvBufferMessage( pcMessage );
+    xWorkQueueSubmit( xIOWorkQueue, xFlushLogWork, pdMS_TO_TICKS( 100 ) );
+}
+</pre>
+ * \defgroup xWorkQueueSubmit xWorkQueueSubmit
+ * \ingroup WorkQueueManagement
+ */
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue, WorkItemHandle_t xWorkItem, TickType_t xDelay ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ *
+<pre>
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                    WorkItemHandle_t xWorkItem,
+                                    TickType_t xDelay,
+                                    BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xWorkQueueSubmit() that can be called from an interrupt
+ * service routine, to defer the processing of the interrupt to a worker task.
+ *
+ * @param xWorkQueue The handle of the work queue the work item is submitted
+ * to.
+ *
+ * @param xWorkItem The handle of the work item being submitted.
+ *
+ * @param xDelay The number of ticks that must pass before the work item is
+ * ready to run.  Zero makes the work item ready to run straight away.
+ *
+ * @param pxHigherPriorityTaskWoken Submitting a work item wakes an idle
+ * worker task.  If the worker task has a priority above that of the currently
+ * running task then *pxHigherPriorityTaskWoken will be set to pdTRUE, and a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the work item was submitted.  pdFAIL if the work item was
+ * already waiting to run.
+ *
+ * Example use:
+<pre>
+
+void vAnInterruptHandler( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    // Clear the interrupt, then defer the processing of the data that
+    // arrived to a worker task.
+    prvClearInterrupt();
+    xWorkQueueSubmitFromISR( xIOWorkQueue, xProcessRxWork, 0, &xHigherPriorityTaskWoken );
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+</pre>
+ * \defgroup xWorkQueueSubmitFromISR xWorkQueueSubmitFromISR
+ * \ingroup WorkQueueManagement
+ */
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue, WorkItemHandle_t xWorkItem, TickType_t xDelay, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ *
+<pre>
+BaseType_t xWorkItemCancel( WorkItemHandle_t xWorkItem );
+</pre>
+ *
+ * Cancels a work item that is waiting to run, either because it was submitted
+ * with a delay that has not yet expired, or because it is waiting for a worker
+ * task.  A work item that has already started to run cannot be cancelled, and
+ * runs to completion.
+ *
+ * @param xWorkItem The handle of the work item being cancelled.
+ *
+ * @return pdPASS if the work item was waiting to run and has been cancelled.
+ * pdFAIL if the work item was not waiting to run.
+ *
+ * \defgroup xWorkItemCancel xWorkItemCancel
+ * \ingroup WorkQueueManagement
+ */
+BaseType_t xWorkItemCancel( WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ *
+<pre>
+BaseType_t xWorkItemIsBusy( WorkItemHandle_t xWorkItem );
+</pre>
+ *
+ * Queries whether a work item is waiting to run or is running.
+ *
+ * @param xWorkItem The handle of the work item being queried.
+ *
+ * @return pdFALSE if the work item is neither waiting to run nor running, so
+ * can be deleted.  Otherwise pdTRUE.
+ *
+ * \defgroup xWorkItemIsBusy xWorkItemIsBusy
+ * \ingroup WorkQueueManagement
+ */
+BaseType_t xWorkItemIsBusy( WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ *
+<pre>
+TaskHandle_t xWorkQueueGetWorkerHandle( WorkQueueHandle_t xWorkQueue, UBaseType_t uxWorker );
+</pre>
+ *
+ * Returns the handle of one of a work queue's worker tasks, for example so its
+ * stack high water mark can be checked.
+ *
+ * @param xWorkQueue The handle of the work queue being queried.
+ *
+ * @param uxWorker The number of the worker, from 0 to one less than the number
+ * of workers the queue was created with.
+ *
+ * @return The handle of the worker task.
+ *
+ * \defgroup xWorkQueueGetWorkerHandle xWorkQueueGetWorkerHandle
+ * \ingroup WorkQueueManagement
+ */
+TaskHandle_t xWorkQueueGetWorkerHandle( WorkQueueHandle_t xWorkQueue, UBaseType_t uxWorker ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ *
+<pre>
+void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue, WorkQueueStats_t *pxWorkQueueStats );
+</pre>
+ *
+ * Obtains information about the use of a work queue - see the definition of
+ * WorkQueueStats_t.
+ *
+ * @param xWorkQueue The handle of the work queue being queried.
+ *
+ * @param pxWorkQueueStats Pointer to the structure into which the information
+ * is written.
+ *
+ * Example use:
+<pre>
+
+void vAFunction( void )
+{
+WorkQueueStats_t xStats;
+
+    vWorkQueueGetStats( xIOWorkQueue, &xStats );
+
+    if( xStats.xMaxLatency > pdMS_TO_TICKS( 10 ) )
+    {
+        // Work items have waited longer than expected for a worker, so the
+        // queue might need more workers, or workers with higher priorities.
+    }
+}
+</pre>
+ * \defgroup vWorkQueueGetStats vWorkQueueGetStats
+ * \ingroup WorkQueueManagement
+ */
+void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue, WorkQueueStats_t *pxWorkQueueStats ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* WORK_QUEUE_H */
@@ -0,0 +1,605 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pool.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* The size of the Pool_t structure rounded up so the storage area that follows
+it in a dynamically allocated pool is correctly aligned. */
+#define poolSTRUCT_SIZE		( ( sizeof( Pool_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The number of kernel object types that can be allocated from pools. */
+#define poolNUMBER_OF_KERNEL_POOLS	3
+
+/* The size of each object in the kernel pools.  A queue allocated from the
+pool holds its storage area in the same block as its structure, so objects in
+the queue pool are configQUEUE_POOL_STORAGE_BYTES bigger than a queue
+structure. */
+#define poolTASK_OBJECT_SIZE		( sizeof( StaticTask_t ) )
+#define poolQUEUE_OBJECT_SIZE		( sizeof( StaticQueue_t ) + ( size_t ) configQUEUE_POOL_STORAGE_BYTES )
+#define poolTIMER_OBJECT_SIZE		( sizeof( StaticTimer_t ) )
+
+/* Bits stored in the ucFlags field of the pool. */
+#define poolFLAGS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 1 ) /* Set if the pool structure was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds the state of a pool. */
+typedef struct xPOOL /*lint !e9058 Style convention uses tag. */
+{
+	uint8_t *pucStorage;					/* Points to the first object in the pool. */
+	void *pvFreeList;						/* Points to the most recently freed object, which points to the next freed object, and so on. */
+	size_t xObjectSize;						/* The size of each object, rounded up to hold a pointer and meet the alignment requirements of the port. */
+	UBaseType_t uxNumberOfObjects;			/* The total number of objects in the pool. */
+	UBaseType_t uxNextUnused;				/* Objects at or above this index have never been allocated, so are not on the free list. */
+	UBaseType_t uxNumberOfFreeObjects;
+	UBaseType_t uxMinimumEverFreeObjects;
+	UBaseType_t uxNumberOfAllocations;
+	UBaseType_t uxNumberOfFailedAllocations;
+	UBaseType_t uxNumberOfFrees;
+	uint8_t ucFlags;
+} Pool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by xPoolCreate(), xPoolCreateStatic() and the kernel pool
+ * initialisation to initialise the members of a newly created pool structure.
+ */
+static void prvInitialiseNewPool( Pool_t * const pxPool,
+								  uint8_t * const pucStorage,
+								  size_t xObjectSize,
+								  UBaseType_t uxNumberOfObjects ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes an object from the pool, returning NULL if the pool is empty.  Must
+ * be called from within a critical section.
+ */
+static void *prvTakeObject( Pool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Places an object back into the pool.  Must be called from within a critical
+ * section.
+ */
+static void prvReturnObject( Pool_t * const pxPool, void *pvObject ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pvObject lies within the pool's storage area, otherwise
+ * pdFALSE.
+ */
+static BaseType_t prvIsObjectInPool( const Pool_t * const pxPool, const void * const pvObject ) PRIVILEGED_FUNCTION;
+
+#if( ( configTASK_POOL_LENGTH > 0 ) || ( configQUEUE_POOL_LENGTH > 0 ) || ( configTIMER_POOL_LENGTH > 0 ) )
+
+	/*
+	 * Initialises the kernel pools the first time a kernel object is allocated
+	 * from a pool.  Must be called from within a critical section.
+	 */
+	static void prvInitialiseKernelPools( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The pools used to allocate kernel objects, indexed by poolKERNEL_POOL_TASKS,
+poolKERNEL_POOL_QUEUES and poolKERNEL_POOL_TIMERS.  Pools that have a length of
+zero are left with no storage, so every allocation is passed to
+pvPortMalloc(). */
+PRIVILEGED_DATA static Pool_t xKernelPools[ poolNUMBER_OF_KERNEL_POOLS ];
+
+#if( ( configTASK_POOL_LENGTH > 0 ) || ( configQUEUE_POOL_LENGTH > 0 ) || ( configTIMER_POOL_LENGTH > 0 ) )
+	PRIVILEGED_DATA static BaseType_t xKernelPoolsInitialised = pdFALSE;
+#endif
+
+/* The storage used by the kernel pools.  Each array is over-sized by
+portBYTE_ALIGNMENT bytes so its start can be aligned at run time, as the
+compiler will only align the arrays to a byte boundary. */
+#if( configTASK_POOL_LENGTH > 0 )
+	PRIVILEGED_DATA static uint8_t ucTaskPoolStorage[ poolSTORAGE_SIZE( poolTASK_OBJECT_SIZE, configTASK_POOL_LENGTH ) + portBYTE_ALIGNMENT ];
+#endif
+
+#if( configQUEUE_POOL_LENGTH > 0 )
+	PRIVILEGED_DATA static uint8_t ucQueuePoolStorage[ poolSTORAGE_SIZE( poolQUEUE_OBJECT_SIZE, configQUEUE_POOL_LENGTH ) + portBYTE_ALIGNMENT ];
+#endif
+
+#if( configTIMER_POOL_LENGTH > 0 )
+	PRIVILEGED_DATA static uint8_t ucTimerPoolStorage[ poolSTORAGE_SIZE( poolTIMER_OBJECT_SIZE, configTIMER_POOL_LENGTH ) + portBYTE_ALIGNMENT ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	PoolHandle_t xPoolCreate( size_t xObjectSize, UBaseType_t uxNumberOfObjects )
+	{
+	uint8_t *pucAllocatedMemory;
+
+		configASSERT( xObjectSize > ( size_t ) 0 );
+		configASSERT( uxNumberOfObjects > ( UBaseType_t ) 0 );
+
+		/* The Pool_t structure and the storage area are allocated in a single
+		call to pvPortMalloc().  The structure is placed at the start of the
+		allocated memory and the storage area follows it. */
+		pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( poolSTRUCT_SIZE + poolSTORAGE_SIZE( xObjectSize, uxNumberOfObjects ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pucAllocatedMemory != NULL )
+		{
+			prvInitialiseNewPool( ( Pool_t * ) pucAllocatedMemory, /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+								  pucAllocatedMemory + poolSTRUCT_SIZE,
+								  xObjectSize,
+								  uxNumberOfObjects );
+
+			tracePOOL_CREATE( ( ( Pool_t * ) pucAllocatedMemory ) );
+		}
+		else
+		{
+			tracePOOL_CREATE_FAILED();
+		}
+
+		return ( PoolHandle_t ) pucAllocatedMemory;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	PoolHandle_t xPoolCreateStatic( size_t xObjectSize,
+									UBaseType_t uxNumberOfObjects,
+									uint8_t * const pucPoolStorageArea,
+									StaticPool_t * const pxStaticPool )
+	{
+	Pool_t * const pxPool = ( Pool_t * ) pxStaticPool; /*lint !e740 !e9087 Safe cast as StaticPool_t is opaque Pool_t. */
+	PoolHandle_t xReturn;
+
+		configASSERT( pucPoolStorageArea );
+		configASSERT( pxStaticPool );
+		configASSERT( xObjectSize > ( size_t ) 0 );
+		configASSERT( uxNumberOfObjects > ( UBaseType_t ) 0 );
+
+		/* The objects are handed out directly from the storage area, so the
+		storage area must meet the alignment requirements of the port. */
+		configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucPoolStorageArea ) & ( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) == 0UL );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticPool_t equals the size of the real pool
+			structure. */
+			volatile size_t xSize = sizeof( StaticPool_t );
+			configASSERT( xSize == sizeof( Pool_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( ( pucPoolStorageArea != NULL ) && ( pxStaticPool != NULL ) )
+		{
+			prvInitialiseNewPool( pxPool, pucPoolStorageArea, xObjectSize, uxNumberOfObjects );
+
+			/* Remember this was statically allocated in case it is ever deleted
+			again. */
+			pxPool->ucFlags |= poolFLAGS_IS_STATICALLY_ALLOCATED;
+
+			tracePOOL_CREATE( pxPool );
+
+			xReturn = ( PoolHandle_t ) pxStaticPool;
+		}
+		else
+		{
+			xReturn = NULL;
+			tracePOOL_CREATE_FAILED();
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vPoolDelete( PoolHandle_t xPool )
+{
+Pool_t * pxPool = ( Pool_t * ) xPool;
+
+	configASSERT( pxPool );
+
+	tracePOOL_DELETE( xPool );
+
+	if( ( pxPool->ucFlags & poolFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both the structure and the storage area were allocated using a
+			single call to pvPortMalloc(), hence only one call to vPortFree()
+			is required. */
+			vPortFree( ( void * ) pxPool );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt.
+			Force an assert. */
+			configASSERT( xPool == ( PoolHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The structure and storage area were not allocated dynamically and
+		cannot be freed - just scrub the structure so future use will
+		assert. */
+		memset( pxPool, 0x00, sizeof( Pool_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvPoolAlloc( PoolHandle_t xPool )
+{
+Pool_t * const pxPool = ( Pool_t * ) xPool;
+void *pvReturn;
+
+	configASSERT( pxPool );
+	configASSERT( pxPool->pucStorage );
+
+	taskENTER_CRITICAL();
+	{
+		pvReturn = prvTakeObject( pxPool );
+	}
+	taskEXIT_CRITICAL();
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPoolAllocFromISR( PoolHandle_t xPool )
+{
+Pool_t * const pxPool = ( Pool_t * ) xPool;
+void *pvReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+	configASSERT( pxPool->pucStorage );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		pvReturn = prvTakeObject( pxPool );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPoolFree( PoolHandle_t xPool, void *pvObject )
+{
+Pool_t * const pxPool = ( Pool_t * ) xPool;
+
+	configASSERT( pxPool );
+	configASSERT( prvIsObjectInPool( pxPool, pvObject ) != pdFALSE );
+
+	taskENTER_CRITICAL();
+	{
+		prvReturnObject( pxPool, pvObject );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vPoolFreeFromISR( PoolHandle_t xPool, void *pvObject )
+{
+Pool_t * const pxPool = ( Pool_t * ) xPool;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+	configASSERT( prvIsObjectInPool( pxPool, pvObject ) != pdFALSE );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		prvReturnObject( pxPool, pvObject );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vPoolGetStats( PoolHandle_t xPool, PoolStats_t *pxPoolStats )
+{
+Pool_t * const pxPool = ( Pool_t * ) xPool;
+
+	configASSERT( pxPool );
+	configASSERT( pxPoolStats );
+
+	/* Take a consistent snapshot of the counters. */
+	taskENTER_CRITICAL();
+	{
+		pxPoolStats->xObjectSize = pxPool->xObjectSize;
+		pxPoolStats->uxNumberOfObjects = pxPool->uxNumberOfObjects;
+		pxPoolStats->uxNumberOfFreeObjects = pxPool->uxNumberOfFreeObjects;
+		pxPoolStats->uxMinimumEverFreeObjects = pxPool->uxMinimumEverFreeObjects;
+		pxPoolStats->uxNumberOfAllocations = pxPool->uxNumberOfAllocations;
+		pxPoolStats->uxNumberOfFailedAllocations = pxPool->uxNumberOfFailedAllocations;
+		pxPoolStats->uxNumberOfFrees = pxPool->uxNumberOfFrees;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+PoolHandle_t xPoolGetKernelObjectPool( BaseType_t xObjectType )
+{
+PoolHandle_t xReturn = NULL;
+
+	configASSERT( ( xObjectType >= 0 ) && ( xObjectType < poolNUMBER_OF_KERNEL_POOLS ) );
+
+	#if( ( configTASK_POOL_LENGTH > 0 ) || ( configQUEUE_POOL_LENGTH > 0 ) || ( configTIMER_POOL_LENGTH > 0 ) )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( xKernelPoolsInitialised == pdFALSE )
+			{
+				prvInitialiseKernelPools();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xKernelPools[ xObjectType ].pucStorage != NULL )
+		{
+			xReturn = ( PoolHandle_t ) &( xKernelPools[ xObjectType ] );
+		}
+	}
+	#else
+	{
+		/* There are no kernel pools.  Remove compiler warnings about the
+		unused parameter should configASSERT() not be defined. */
+		( void ) xObjectType;
+	}
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPoolAllocKernelObject( BaseType_t xObjectType, size_t xSize )
+{
+void *pvReturn = NULL;
+
+	configASSERT( ( xObjectType >= 0 ) && ( xObjectType < poolNUMBER_OF_KERNEL_POOLS ) );
+
+	#if( ( configTASK_POOL_LENGTH > 0 ) || ( configQUEUE_POOL_LENGTH > 0 ) || ( configTIMER_POOL_LENGTH > 0 ) )
+	{
+	Pool_t * const pxPool = &( xKernelPools[ xObjectType ] );
+
+		taskENTER_CRITICAL();
+		{
+			if( xKernelPoolsInitialised == pdFALSE )
+			{
+				prvInitialiseKernelPools();
+			}
+
+			/* A pool that has a length of zero has an object size of zero, so
+			nothing will fit in it. */
+			if( xSize <= pxPool->xObjectSize )
+			{
+				pvReturn = prvTakeObject( pxPool );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	#else
+	{
+		/* There are no kernel pools, so every object is allocated from the
+		heap.  Remove compiler warnings about the unused parameter should
+		configASSERT() not be defined. */
+		( void ) xObjectType;
+	}
+	#endif
+
+	if( pvReturn == NULL )
+	{
+		/* The object does not fit in the pool, or the pool is empty, so fall
+		back to the heap. */
+		pvReturn = pvPortMalloc( xSize );
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPoolFreeKernelObject( BaseType_t xObjectType, void *pvObject )
+{
+Pool_t * const pxPool = &( xKernelPools[ xObjectType ] );
+
+	configASSERT( ( xObjectType >= 0 ) && ( xObjectType < poolNUMBER_OF_KERNEL_POOLS ) );
+
+	/* The storage area of a kernel pool never moves, so the object can be
+	checked against it without entering a critical section. */
+	if( prvIsObjectInPool( pxPool, pvObject ) != pdFALSE )
+	{
+		taskENTER_CRITICAL();
+		{
+			prvReturnObject( pxPool, pvObject );
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		vPortFree( pvObject );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewPool( Pool_t * const pxPool,
+								  uint8_t * const pucStorage,
+								  size_t xObjectSize,
+								  UBaseType_t uxNumberOfObjects )
+{
+	/* Objects are only placed on the free list once they have been freed, so
+	the storage area itself does not need to be initialised. */
+	memset( ( void * ) pxPool, 0x00, sizeof( Pool_t ) );
+	pxPool->pucStorage = pucStorage;
+	pxPool->pvFreeList = NULL;
+	pxPool->xObjectSize = poolOBJECT_SIZE( xObjectSize );
+	pxPool->uxNumberOfObjects = uxNumberOfObjects;
+	pxPool->uxNumberOfFreeObjects = uxNumberOfObjects;
+	pxPool->uxMinimumEverFreeObjects = uxNumberOfObjects;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTakeObject( Pool_t * const pxPool )
+{
+void *pvReturn;
+
+	if( pxPool->pvFreeList != NULL )
+	{
+		/* Reuse the most recently freed object, as it is the most likely to
+		still be in the cache. */
+		pvReturn = pxPool->pvFreeList;
+		pxPool->pvFreeList = *( ( void ** ) pvReturn );
+	}
+	else if( pxPool->uxNextUnused < pxPool->uxNumberOfObjects )
+	{
+		/* Hand out the next object that has never been used. */
+		pvReturn = ( void * ) ( pxPool->pucStorage + ( pxPool->xObjectSize * ( size_t ) pxPool->uxNextUnused ) );
+		( pxPool->uxNextUnused )++;
+	}
+	else
+	{
+		pvReturn = NULL;
+	}
+
+	if( pvReturn != NULL )
+	{
+		( pxPool->uxNumberOfFreeObjects )--;
+		( pxPool->uxNumberOfAllocations )++;
+
+		if( pxPool->uxNumberOfFreeObjects < pxPool->uxMinimumEverFreeObjects )
+		{
+			pxPool->uxMinimumEverFreeObjects = pxPool->uxNumberOfFreeObjects;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		tracePOOL_ALLOC( pxPool, pvReturn );
+	}
+	else
+	{
+		( pxPool->uxNumberOfFailedAllocations )++;
+		tracePOOL_ALLOC_FAILED( pxPool );
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReturnObject( Pool_t * const pxPool, void *pvObject )
+{
+	configASSERT( pxPool->uxNumberOfFreeObjects < pxPool->uxNumberOfObjects );
+
+	tracePOOL_FREE( pxPool, pvObject );
+
+	/* The first word of the freed object links it into the free list. */
+	*( ( void ** ) pvObject ) = pxPool->pvFreeList;
+	pxPool->pvFreeList = pvObject;
+
+	( pxPool->uxNumberOfFreeObjects )++;
+	( pxPool->uxNumberOfFrees )++;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsObjectInPool( const Pool_t * const pxPool, const void * const pvObject )
+{
+const uint8_t * const pucObject = ( const uint8_t * ) pvObject;
+BaseType_t xReturn;
+
+	if( ( pxPool->pucStorage != NULL ) &&
+		( pucObject >= pxPool->pucStorage ) &&
+		( pucObject < ( pxPool->pucStorage + ( pxPool->xObjectSize * ( size_t ) pxPool->uxNumberOfObjects ) ) ) )
+	{
+		/* An object in the pool must also start on an object boundary. */
+		configASSERT( ( ( size_t ) ( pucObject - pxPool->pucStorage ) % pxPool->xObjectSize ) == ( size_t ) 0 );
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( ( configTASK_POOL_LENGTH > 0 ) || ( configQUEUE_POOL_LENGTH > 0 ) || ( configTIMER_POOL_LENGTH > 0 ) )
+
+	static void prvInitialiseKernelPools( void )
+	{
+	uint8_t *pucStorage;
+
+		/* Pools that are not initialised below keep an object size of zero and
+		a NULL storage area, as xKernelPools[] is zeroed at start up. */
+		#if( configTASK_POOL_LENGTH > 0 )
+		{
+			pucStorage = ( uint8_t * ) ( ( ( portPOINTER_SIZE_TYPE ) &( ucTaskPoolStorage[ portBYTE_ALIGNMENT - 1 ] ) ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) );
+			prvInitialiseNewPool( &( xKernelPools[ poolKERNEL_POOL_TASKS ] ), pucStorage, poolTASK_OBJECT_SIZE, configTASK_POOL_LENGTH );
+		}
+		#endif
+
+		#if( configQUEUE_POOL_LENGTH > 0 )
+		{
+			pucStorage = ( uint8_t * ) ( ( ( portPOINTER_SIZE_TYPE ) &( ucQueuePoolStorage[ portBYTE_ALIGNMENT - 1 ] ) ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) );
+			prvInitialiseNewPool( &( xKernelPools[ poolKERNEL_POOL_QUEUES ] ), pucStorage, poolQUEUE_OBJECT_SIZE, configQUEUE_POOL_LENGTH );
+		}
+		#endif
+
+		#if( configTIMER_POOL_LENGTH > 0 )
+		{
+			pucStorage = ( uint8_t * ) ( ( ( portPOINTER_SIZE_TYPE ) &( ucTimerPoolStorage[ portBYTE_ALIGNMENT - 1 ] ) ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) );
+			prvInitialiseNewPool( &( xKernelPools[ poolKERNEL_POOL_TIMERS ] ), pucStorage, poolTIMER_OBJECT_SIZE, configTIMER_POOL_LENGTH );
+		}
+		#endif
+
+		xKernelPoolsInitialised = pdTRUE;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
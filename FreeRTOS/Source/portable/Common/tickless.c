@@ -0,0 +1,177 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A generic implementation of vPortSuppressTicksAndSleep() for ports that
+ * generate the tick interrupt from a down counting timer that automatically
+ * reloads, such as the Cortex-M SysTick.  The algorithm is the one used by the
+ * ARM_CM4F port.  The timer is accessed through the TicklessTimer_t structure
+ * passed in by the port (see portable.h), so the same code can be reused by
+ * any port, and can be driven by a simulated timer on a host.
+ *
+ * To use it, build this file with the port, fill in a TicklessTimer_t when the
+ * tick interrupt is configured, and implement vPortSuppressTicksAndSleep() as
+ * a call to vPortTicklessSuppressTicksAndSleep().
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+void vPortTicklessSuppressTicksAndSleep( TickType_t xExpectedIdleTime, const TicklessTimer_t * const pxTimer )
+{
+uint32_t ulReloadValue, ulCompleteTickPeriods, ulCompletedTimerDecrements, ulCalculatedLoadValue;
+TickType_t xModifiableIdleTime;
+
+	configASSERT( pxTimer );
+
+	/* Make sure the reload value does not overflow the counter. */
+	if( xExpectedIdleTime > pxTimer->ulMaximumSuppressedTicks )
+	{
+		xExpectedIdleTime = pxTimer->ulMaximumSuppressedTicks;
+	}
+
+	/* Stop the timer momentarily.  The time the timer is stopped for is
+	accounted for as best it can be, but using the tickless mode will
+	inevitably result in some tiny drift of the time maintained by the kernel
+	with respect to calendar time. */
+	pxTimer->vStop();
+
+	/* Calculate the reload value required to wait xExpectedIdleTime tick
+	periods.  -1 is used because this code will execute part way through one
+	of the tick periods. */
+	ulReloadValue = pxTimer->ulGetCount() + ( pxTimer->ulCountsPerTick * ( ( uint32_t ) xExpectedIdleTime - 1UL ) );
+	if( ulReloadValue > pxTimer->ulStoppedTimerCompensation )
+	{
+		ulReloadValue -= pxTimer->ulStoppedTimerCompensation;
+	}
+
+	/* Enter a critical section, but not one that would mask the interrupts
+	that should bring the processor out of sleep mode. */
+	pxTimer->vDisableInterrupts();
+
+	/* If a context switch is pending or a task is waiting for the scheduler to
+	be unsuspended then abandon the low power entry. */
+	if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+	{
+		/* Restart from whatever is left in the count register to complete this
+		tick period, then set the reload value back to the value required for
+		normal tick periods. */
+		pxTimer->vSetReload( pxTimer->ulGetCount() );
+		pxTimer->vStart();
+		pxTimer->vSetReload( pxTimer->ulCountsPerTick - 1UL );
+
+		pxTimer->vEnableInterrupts();
+	}
+	else
+	{
+		/* Set the new reload value, and restart the timer from it. */
+		pxTimer->vSetReload( ulReloadValue );
+		pxTimer->vRestartFromReload();
+
+		/* Sleep until something happens.  configPRE_SLEEP_PROCESSING() can set
+		its parameter to 0 to indicate that its implementation contains its own
+		wait for interrupt or wait for event instruction, and so the wait
+		should not be executed again.  However, the original expected idle time
+		variable must remain unmodified, so a copy is taken. */
+		xModifiableIdleTime = xExpectedIdleTime;
+		configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+		if( xModifiableIdleTime > 0 )
+		{
+			pxTimer->vWaitForInterrupt();
+		}
+		configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+		/* Re-enable interrupts to allow the interrupt that brought the
+		processor out of sleep mode to execute immediately, then disable them
+		again because the timer is about to be stopped and interrupts that
+		execute while it is stopped would increase any slippage between the
+		time maintained by the RTOS and calendar time. */
+		pxTimer->vEnableInterrupts();
+		pxTimer->vDisableInterrupts();
+
+		/* Stop the timer without clearing its expired flag. */
+		pxTimer->vStop();
+
+		/* Determine if the timer has already counted to zero and been set back
+		to the current reload value (the reload back being correct for the
+		entire expected idle time) or if the timer is yet to count to zero (in
+		which case an interrupt other than the tick must have brought the
+		system out of sleep mode). */
+		if( pxTimer->xHasExpired() != pdFALSE )
+		{
+			/* The tick interrupt is already pending, and the count reloaded
+			with ulReloadValue.  Reset the reload value with whatever remains
+			of this tick period. */
+			ulCalculatedLoadValue = ( pxTimer->ulCountsPerTick - 1UL ) - ( ulReloadValue - pxTimer->ulGetCount() );
+
+			/* Don't allow a tiny value, or values that have somehow
+			underflowed because the post sleep hook did something that took
+			too long. */
+			if( ( ulCalculatedLoadValue < pxTimer->ulStoppedTimerCompensation ) || ( ulCalculatedLoadValue > pxTimer->ulCountsPerTick ) )
+			{
+				ulCalculatedLoadValue = ( pxTimer->ulCountsPerTick - 1UL );
+			}
+
+			pxTimer->vSetReload( ulCalculatedLoadValue );
+
+			/* As the pending tick will be processed as soon as this function
+			exits, the tick value maintained by the tick is stepped forward by
+			one less than the time spent waiting. */
+			ulCompleteTickPeriods = ( uint32_t ) xExpectedIdleTime - 1UL;
+		}
+		else
+		{
+			/* Something other than the tick interrupt ended the sleep.  Work
+			out how long the sleep lasted rounded to complete tick periods (not
+			the ulReload value which accounted for part ticks). */
+			ulCompletedTimerDecrements = ( ( uint32_t ) xExpectedIdleTime * pxTimer->ulCountsPerTick ) - pxTimer->ulGetCount();
+
+			/* How many complete tick periods passed while the processor was
+			waiting? */
+			ulCompleteTickPeriods = ulCompletedTimerDecrements / pxTimer->ulCountsPerTick;
+
+			/* The reload value is set to whatever fraction of a single tick
+			period remains. */
+			pxTimer->vSetReload( ( ( ulCompleteTickPeriods + 1UL ) * pxTimer->ulCountsPerTick ) - ulCompletedTimerDecrements );
+		}
+
+		/* Restart the timer so it runs from the reload value set above, then
+		set the reload value back to its standard value. */
+		pxTimer->vRestartFromReload();
+		vTaskStepTick( ( TickType_t ) ulCompleteTickPeriods );
+		pxTimer->vSetReload( pxTimer->ulCountsPerTick - 1UL );
+
+		/* Exit with interrupts enabled. */
+		pxTimer->vEnableInterrupts();
+	}
+}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
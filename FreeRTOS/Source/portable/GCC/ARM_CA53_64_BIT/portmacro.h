@@ -75,15 +75,31 @@ not need to be guarded with a critical section. */
 /* Task utilities. */
 
 /* Called at the end of an ISR that can cause a context switch. */
-#define portEND_SWITCHING_ISR( xSwitchRequired )\
-{												\
-extern uint64_t ullPortYieldRequired;			\
-												\
-	if( xSwitchRequired != pdFALSE )			\
-	{											\
-		ullPortYieldRequired = pdTRUE;			\
-	}											\
-}
+#if( configNUM_CORES > 1 )
+
+	#define portEND_SWITCHING_ISR( xSwitchRequired )			\
+	{															\
+	extern uint64_t ullPortYieldRequired[ configNUM_CORES ];	\
+																\
+		if( xSwitchRequired != pdFALSE )						\
+		{														\
+			ullPortYieldRequired[ portGET_CORE_ID() ] = pdTRUE;	\
+		}														\
+	}
+
+#else
+
+	#define portEND_SWITCHING_ISR( xSwitchRequired )\
+	{												\
+	extern uint64_t ullPortYieldRequired;			\
+													\
+		if( xSwitchRequired != pdFALSE )			\
+		{											\
+			ullPortYieldRequired = pdTRUE;			\
+		}											\
+	}
+
+#endif /* configNUM_CORES */
 
 #define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
 #if defined( GUEST )
@@ -114,11 +130,74 @@ extern void vPortInstallFreeRTOSVectorTable( void );
 
 /* These macros do not globally disable/enable interrupts.  They do mask off
 interrupts that have a priority below configMAX_API_CALL_INTERRUPT_PRIORITY. */
-#define portENTER_CRITICAL()		vPortEnterCritical();
-#define portEXIT_CRITICAL()			vPortExitCritical();
+#if( configNUM_CORES > 1 )
+	/* When more than one core is in use the critical sections are implemented
+	by the kernel, which also takes the spinlocks defined below. */
+	extern void vTaskEnterCritical( void );
+	extern void vTaskExitCritical( void );
+	#define portENTER_CRITICAL()	vTaskEnterCritical();
+	#define portEXIT_CRITICAL()		vTaskExitCritical();
+#else
+	#define portENTER_CRITICAL()	vPortEnterCritical();
+	#define portEXIT_CRITICAL()		vPortExitCritical();
+#endif /* configNUM_CORES */
 #define portSET_INTERRUPT_MASK_FROM_ISR()		uxPortSetInterruptMask()
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
 
+/*-----------------------------------------------------------
+ * Multi-core support
+ *----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	/* The number of the core executing the calling code is held in the
+	affinity level 0 field of the MPIDR. */
+	static inline BaseType_t xPortGetCoreID( void )
+	{
+	uint64_t ullMPIDR;
+
+		__asm volatile ( "MRS %0, MPIDR_EL1" : "=r" ( ullMPIDR ) );
+		return ( BaseType_t ) ( ullMPIDR & 0xFFULL );
+	}
+
+	/* Another core is asked to yield by sending it the software generated
+	interrupt configCORE_YIELD_SGI.  The application must route that interrupt
+	to FreeRTOS_Yield_Handler(). */
+	#ifndef configCORE_YIELD_SGI
+		#define configCORE_YIELD_SGI	0
+	#endif
+
+	void vPortYieldCore( BaseType_t xCoreID );
+	void FreeRTOS_Yield_Handler( void );
+
+	/* Each core brings itself into the scheduler by calling
+	vPortStartSecondaryCore() from its start up code, after which the call
+	never returns.  Core 0 calls vTaskStartScheduler() as normal. */
+	void vPortStartSecondaryCore( void );
+
+	/* Recursive spinlocks used by the kernel to serialise access to its data
+	between the cores. */
+	#define portTASK_LOCK	0U
+	#define portISR_LOCK	1U
+	void vPortGetLock( uint32_t ulLockNum );
+	void vPortReleaseLock( uint32_t ulLockNum );
+
+	extern volatile uint64_t ullCriticalNesting[ configNUM_CORES ];
+	extern uint64_t ullPortInterruptNesting[ configNUM_CORES ];
+
+	#define portGET_CORE_ID()						xPortGetCoreID()
+	#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+	#define portGET_TASK_LOCK()						vPortGetLock( portTASK_LOCK )
+	#define portRELEASE_TASK_LOCK()					vPortReleaseLock( portTASK_LOCK )
+	#define portGET_ISR_LOCK()						vPortGetLock( portISR_LOCK )
+	#define portRELEASE_ISR_LOCK()					vPortReleaseLock( portISR_LOCK )
+	#define portGET_CRITICAL_NESTING_COUNT()		( ullCriticalNesting[ portGET_CORE_ID() ] )
+	#define portINCREMENT_CRITICAL_NESTING_COUNT()	( ullCriticalNesting[ portGET_CORE_ID() ]++ )
+	#define portDECREMENT_CRITICAL_NESTING_COUNT()	( ullCriticalNesting[ portGET_CORE_ID() ]-- )
+	#define portASSERT_IF_IN_ISR()					configASSERT( ullPortInterruptNesting[ portGET_CORE_ID() ] == 0ULL )
+
+#endif /* configNUM_CORES */
+
 /*-----------------------------------------------------------*/
 
 /* Task function macros as described on the FreeRTOS.org WEB site.  These are
@@ -141,7 +220,11 @@ void vPortTaskUsesFPU( void );
 
 /* Architecture specific optimisations. */
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
-	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+	#if( configNUM_CORES > 1 )
+		#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+	#else
+		#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+	#endif
 #endif
 
 #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
@@ -162,6 +245,7 @@ void vPortTaskUsesFPU( void );
 #endif /* configASSERT */
 
 #define portNOP() __asm volatile( "NOP" )
+#define portMEMORY_BARRIER() __asm volatile( "DMB ISH" ::: "memory" )
 #define portINLINE __inline
 
 #ifdef __cplusplus
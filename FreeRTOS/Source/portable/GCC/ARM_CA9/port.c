@@ -151,6 +151,25 @@ debugger. */
 registers, plus a 32-bit status register. */
 #define portFPU_REGISTER_WORDS	( ( 32 * 2 ) + 1 )
 
+#if( configNUM_CORES > 1 )
+	/* Distributor registers used to send, prioritise and enable the software
+	generated interrupt used to make another core yield.  Software generated
+	interrupts 0 to 15 are banked per core. */
+	#define portGICD_SGIR_REGISTER				( *( ( volatile uint32_t * ) ( configINTERRUPT_CONTROLLER_BASE_ADDRESS + 0xF00UL ) ) )
+	#define portGICD_ISENABLER0_REGISTER		( *( ( volatile uint32_t * ) ( configINTERRUPT_CONTROLLER_BASE_ADDRESS + 0x100UL ) ) )
+	#define portSGIR_TARGET_LIST_SHIFT			( 16UL )
+
+	/* The lock owner is stored as the core number plus one so zero can mean
+	the lock is free. */
+	#define portLOCK_IS_FREE					( 0UL )
+	#define portNUM_LOCKS						( 2 )
+
+	/* Access the calling core's copy of a port variable. */
+	#define portCORE_VARIABLE( xVariable )		( xVariable[ portGET_CORE_ID() ] )
+#else
+	#define portCORE_VARIABLE( xVariable )		( xVariable )
+#endif /* configNUM_CORES */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -185,6 +204,15 @@ static void prvTaskExitError( void );
  */
 void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR ) __attribute__((weak) );
 
+#if( configNUM_CORES > 1 )
+	/*
+	 * Set the priority of, and enable, the software generated interrupt used
+	 * to make the calling core yield.  Must be called on each core as the
+	 * software generated interrupts are banked.
+	 */
+	static void prvSetupYieldInterrupt( void );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* A variable is used to keep track of the critical section nesting.  This
@@ -192,18 +220,40 @@ variable has to be stored as part of the task context and must be initialised to
 a non zero value to ensure interrupts don't inadvertently become unmasked before
 the scheduler starts.  As it is stored as part of the task context it will
 automatically be set to 0 when the first task is started. */
-volatile uint32_t ulCriticalNesting = 9999UL;
+#if( configNUM_CORES > 1 )
+	/* Each core has its own copy of the variables accessed by portASM.S, which
+	indexes them using the core number. */
+	volatile uint32_t ulCriticalNesting[ configNUM_CORES ] = { [ 0 ... ( configNUM_CORES - 1 ) ] = 9999UL };
+	volatile uint32_t ulPortTaskHasFPUContext[ configNUM_CORES ] = { pdFALSE };
+	volatile uint32_t ulPortYieldRequired[ configNUM_CORES ] = { pdFALSE };
+	volatile uint32_t ulPortInterruptNesting[ configNUM_CORES ] = { 0UL };
+
+	/* The task and ISR spinlocks. */
+	typedef struct PORT_SPINLOCK
+	{
+		volatile uint32_t ulOwner;	/* The number of the owning core plus one, or portLOCK_IS_FREE. */
+		uint32_t ulCount;			/* The number of times the owner has taken the lock. */
+	} PortSpinlock_t;
+
+	static PortSpinlock_t xPortLocks[ portNUM_LOCKS ] = { { portLOCK_IS_FREE, 0UL } };
+
+	/* Set by core 0 once the scheduler has started, at which point the other
+	cores can start running tasks too. */
+	static volatile uint32_t ulPortSchedulerStarted = pdFALSE;
+#else
+	volatile uint32_t ulCriticalNesting = 9999UL;
 
-/* Saved as part of the task context.  If ulPortTaskHasFPUContext is non-zero then
-a floating point context must be saved and restored for the task. */
-volatile uint32_t ulPortTaskHasFPUContext = pdFALSE;
+	/* Saved as part of the task context.  If ulPortTaskHasFPUContext is non-zero then
+	a floating point context must be saved and restored for the task. */
+	volatile uint32_t ulPortTaskHasFPUContext = pdFALSE;
 
-/* Set to 1 to pend a context switch from an ISR. */
-volatile uint32_t ulPortYieldRequired = pdFALSE;
+	/* Set to 1 to pend a context switch from an ISR. */
+	volatile uint32_t ulPortYieldRequired = pdFALSE;
 
-/* Counts the interrupt nesting depth.  A context switch is only performed if
-if the nesting depth is 0. */
-volatile uint32_t ulPortInterruptNesting = 0UL;
+	/* Counts the interrupt nesting depth.  A context switch is only performed if
+	if the nesting depth is 0. */
+	volatile uint32_t ulPortInterruptNesting = 0UL;
+#endif /* configNUM_CORES */
 
 /* Used in the asm file. */
 __attribute__(( used )) const uint32_t ulICCIAR = portICCIAR_INTERRUPT_ACKNOWLEDGE_REGISTER_ADDRESS;
@@ -295,7 +345,7 @@ StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t px
 
 		pxTopOfStack--;
 		*pxTopOfStack = pdTRUE;
-		ulPortTaskHasFPUContext = pdTRUE;
+		portCORE_VARIABLE( ulPortTaskHasFPUContext ) = pdTRUE;
 	}
 	#else
 	{
@@ -315,7 +365,7 @@ static void prvTaskExitError( void )
 
 	Artificially force an assert() to be triggered if configASSERT() is
 	defined, then stop here so application writers can catch the error. */
-	configASSERT( ulPortInterruptNesting == ~0UL );
+	configASSERT( portCORE_VARIABLE( ulPortInterruptNesting ) == ~0UL );
 	portDISABLE_INTERRUPTS();
 	for( ;; );
 }
@@ -381,9 +431,22 @@ uint32_t ulAPSR;
 			executing. */
 			portCPU_IRQ_DISABLE();
 
-			/* Start the timer that generates the tick ISR. */
+			/* Start the timer that generates the tick ISR.  When more than one
+			core is in use only core 0 processes the tick. */
 			configSETUP_TICK_INTERRUPT();
 
+			#if( configNUM_CORES > 1 )
+			{
+				prvSetupYieldInterrupt();
+
+				/* Release the other cores, which are waiting in
+				vPortStartSecondaryCore(). */
+				ulPortSchedulerStarted = pdTRUE;
+				__asm volatile (	"dsb		\n"
+									"sev		\n" ::: "memory" );
+			}
+			#endif /* configNUM_CORES */
+
 			/* Start the first task executing. */
 			vPortRestoreTaskContext();
 		}
@@ -403,10 +466,129 @@ void vPortEndScheduler( void )
 {
 	/* Not implemented in ports where there is nothing to return to.
 	Artificially force an assert. */
-	configASSERT( ulCriticalNesting == 1000UL );
+	configASSERT( portCORE_VARIABLE( ulCriticalNesting ) == 1000UL );
 }
 /*-----------------------------------------------------------*/
 
+#if( configNUM_CORES > 1 )
+
+	void vPortStartSecondaryCore( void )
+	{
+		/* Wait for core 0 to start the scheduler, which also selects the task
+		each core runs first. */
+		while( ulPortSchedulerStarted == pdFALSE )
+		{
+			__asm volatile ( "wfe" ::: "memory" );
+		}
+
+		prvSetupYieldInterrupt();
+
+		/* Interrupts are turned off in the CPU itself until the first task
+		starts executing. */
+		portCPU_IRQ_DISABLE();
+
+		/* Start the first task executing. */
+		vPortRestoreTaskContext();
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	static void prvSetupYieldInterrupt( void )
+	{
+	volatile uint8_t * const pucSGIPriorityRegister = ( volatile uint8_t * const ) ( configINTERRUPT_CONTROLLER_BASE_ADDRESS + portINTERRUPT_PRIORITY_REGISTER_OFFSET + configCORE_YIELD_SGI );
+
+		/* The yield interrupt runs at the same priority as the tick so it is
+		masked by critical sections. */
+		*pucSGIPriorityRegister = ( uint8_t ) ( portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+		portGICD_ISENABLER0_REGISTER = ( 1UL << configCORE_YIELD_SGI );
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	void vPortYieldCore( BaseType_t xCoreID )
+	{
+		/* Ensure the other core sees the updated kernel data before it takes
+		the interrupt. */
+		__asm volatile ( "dsb" ::: "memory" );
+		portGICD_SGIR_REGISTER = ( 1UL << ( portSGIR_TARGET_LIST_SHIFT + ( uint32_t ) xCoreID ) ) | ( uint32_t ) configCORE_YIELD_SGI;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	void FreeRTOS_Yield_Handler( void )
+	{
+		/* Another core has asked this core to select a new task, which is
+		done when the interrupt exits. */
+		portCORE_VARIABLE( ulPortYieldRequired ) = pdTRUE;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	void vPortGetLock( uint32_t ulLockNum )
+	{
+	PortSpinlock_t * const pxLock = &( xPortLocks[ ulLockNum ] );
+	const uint32_t ulThisCore = ( uint32_t ) portGET_CORE_ID() + 1UL;
+	uint32_t ulExpected;
+
+		/* Only the owning core can write its own number to ulOwner, so the
+		check for a recursive take needs no atomic access. */
+		if( pxLock->ulOwner != ulThisCore )
+		{
+			for( ;; )
+			{
+				ulExpected = portLOCK_IS_FREE;
+
+				if( __atomic_compare_exchange_n( &( pxLock->ulOwner ), &ulExpected, ulThisCore, pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) != pdFALSE )
+				{
+					break;
+				}
+
+				/* Sleep until the owner releases a lock. */
+				__asm volatile ( "wfe" ::: "memory" );
+			}
+		}
+
+		( pxLock->ulCount )++;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	void vPortReleaseLock( uint32_t ulLockNum )
+	{
+	PortSpinlock_t * const pxLock = &( xPortLocks[ ulLockNum ] );
+
+		( pxLock->ulCount )--;
+
+		if( pxLock->ulCount == 0UL )
+		{
+			__atomic_store_n( &( pxLock->ulOwner ), portLOCK_IS_FREE, __ATOMIC_RELEASE );
+
+			/* Wake any cores waiting for the lock. */
+			__asm volatile (	"dsb		\n"
+								"sev		\n" ::: "memory" );
+		}
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES == 1 )
+
 void vPortEnterCritical( void )
 {
 	/* Mask interrupts up to the max syscall interrupt priority. */
@@ -447,6 +629,8 @@ void vPortExitCritical( void )
 		}
 	}
 }
+
+#endif /* configNUM_CORES */
 /*-----------------------------------------------------------*/
 
 void FreeRTOS_Tick_Handler( void )
@@ -465,7 +649,7 @@ void FreeRTOS_Tick_Handler( void )
 	/* Increment the RTOS tick. */
 	if( xTaskIncrementTick() != pdFALSE )
 	{
-		ulPortYieldRequired = pdTRUE;
+		portCORE_VARIABLE( ulPortYieldRequired ) = pdTRUE;
 	}
 
 	/* Ensure all interrupt priorities are active again. */
@@ -482,7 +666,7 @@ void FreeRTOS_Tick_Handler( void )
 
 		/* A task is registering the fact that it needs an FPU context.  Set the
 		FPU flag (which is saved as part of the task context). */
-		ulPortTaskHasFPUContext = pdTRUE;
+		portCORE_VARIABLE( ulPortTaskHasFPUContext ) = pdTRUE;
 
 		/* Initialise the floating point status register. */
 		__asm volatile ( "FMXR 	FPSCR, %0" :: "r" (ulInitialFPSCR) : "memory" );
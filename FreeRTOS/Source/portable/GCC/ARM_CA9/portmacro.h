@@ -74,15 +74,31 @@ not need to be guarded with a critical section. */
 /* Task utilities. */
 
 /* Called at the end of an ISR that can cause a context switch. */
-#define portEND_SWITCHING_ISR( xSwitchRequired )\
-{												\
-extern uint32_t ulPortYieldRequired;			\
-												\
-	if( xSwitchRequired != pdFALSE )			\
-	{											\
-		ulPortYieldRequired = pdTRUE;			\
-	}											\
-}
+#if( configNUM_CORES > 1 )
+
+	#define portEND_SWITCHING_ISR( xSwitchRequired )				\
+	{																\
+	extern volatile uint32_t ulPortYieldRequired[ configNUM_CORES ];\
+																	\
+		if( xSwitchRequired != pdFALSE )							\
+		{															\
+			ulPortYieldRequired[ portGET_CORE_ID() ] = pdTRUE;		\
+		}															\
+	}
+
+#else
+
+	#define portEND_SWITCHING_ISR( xSwitchRequired )\
+	{												\
+	extern uint32_t ulPortYieldRequired;			\
+													\
+		if( xSwitchRequired != pdFALSE )			\
+		{											\
+			ulPortYieldRequired = pdTRUE;			\
+		}											\
+	}
+
+#endif /* configNUM_CORES */
 
 #define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
 #define portYIELD() __asm volatile ( "SWI 0" ::: "memory" );
@@ -100,13 +116,76 @@ extern void vPortInstallFreeRTOSVectorTable( void );
 
 /* These macros do not globally disable/enable interrupts.  They do mask off
 interrupts that have a priority below configMAX_API_CALL_INTERRUPT_PRIORITY. */
-#define portENTER_CRITICAL()		vPortEnterCritical();
-#define portEXIT_CRITICAL()			vPortExitCritical();
+#if( configNUM_CORES > 1 )
+	/* When more than one core is in use the critical sections are implemented
+	by the kernel, which also takes the spinlocks defined below. */
+	extern void vTaskEnterCritical( void );
+	extern void vTaskExitCritical( void );
+	#define portENTER_CRITICAL()	vTaskEnterCritical();
+	#define portEXIT_CRITICAL()		vTaskExitCritical();
+#else
+	#define portENTER_CRITICAL()	vPortEnterCritical();
+	#define portEXIT_CRITICAL()		vPortExitCritical();
+#endif /* configNUM_CORES */
 #define portDISABLE_INTERRUPTS()	ulPortSetInterruptMask()
 #define portENABLE_INTERRUPTS()		vPortClearInterruptMask( 0 )
 #define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortSetInterruptMask()
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
 
+/*-----------------------------------------------------------
+ * Multi-core support
+ *----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	/* The number of the core executing the calling code is held in the
+	affinity level 0 field of the MPIDR. */
+	static inline BaseType_t xPortGetCoreID( void )
+	{
+	uint32_t ulMPIDR;
+
+		__asm volatile ( "MRC p15, 0, %0, c0, c0, 5" : "=r" ( ulMPIDR ) );
+		return ( BaseType_t ) ( ulMPIDR & 0x03UL );
+	}
+
+	/* Another core is asked to yield by sending it the software generated
+	interrupt configCORE_YIELD_SGI.  The application must route that interrupt
+	to FreeRTOS_Yield_Handler(). */
+	#ifndef configCORE_YIELD_SGI
+		#define configCORE_YIELD_SGI	0
+	#endif
+
+	void vPortYieldCore( BaseType_t xCoreID );
+	void FreeRTOS_Yield_Handler( void );
+
+	/* Each core brings itself into the scheduler by calling
+	vPortStartSecondaryCore() from its start up code, after which the call
+	never returns.  Core 0 calls vTaskStartScheduler() as normal. */
+	void vPortStartSecondaryCore( void );
+
+	/* Recursive spinlocks used by the kernel to serialise access to its data
+	between the cores. */
+	#define portTASK_LOCK	0UL
+	#define portISR_LOCK	1UL
+	void vPortGetLock( uint32_t ulLockNum );
+	void vPortReleaseLock( uint32_t ulLockNum );
+
+	extern volatile uint32_t ulCriticalNesting[ configNUM_CORES ];
+	extern volatile uint32_t ulPortInterruptNesting[ configNUM_CORES ];
+
+	#define portGET_CORE_ID()						xPortGetCoreID()
+	#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+	#define portGET_TASK_LOCK()						vPortGetLock( portTASK_LOCK )
+	#define portRELEASE_TASK_LOCK()					vPortReleaseLock( portTASK_LOCK )
+	#define portGET_ISR_LOCK()						vPortGetLock( portISR_LOCK )
+	#define portRELEASE_ISR_LOCK()					vPortReleaseLock( portISR_LOCK )
+	#define portGET_CRITICAL_NESTING_COUNT()		( ulCriticalNesting[ portGET_CORE_ID() ] )
+	#define portINCREMENT_CRITICAL_NESTING_COUNT()	( ulCriticalNesting[ portGET_CORE_ID() ]++ )
+	#define portDECREMENT_CRITICAL_NESTING_COUNT()	( ulCriticalNesting[ portGET_CORE_ID() ]-- )
+	#define portASSERT_IF_IN_ISR()					configASSERT( ulPortInterruptNesting[ portGET_CORE_ID() ] == 0UL )
+
+#endif /* configNUM_CORES */
+
 /*-----------------------------------------------------------*/
 
 /* Task function macros as described on the FreeRTOS.org WEB site.  These are
@@ -138,7 +217,11 @@ by default. */
 
 /* Architecture specific optimisations. */
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
-	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+	#if( configNUM_CORES > 1 )
+		#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+	#else
+		#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+	#endif
 #endif
 
 #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
@@ -159,6 +242,7 @@ by default. */
 #endif /* configASSERT */
 
 #define portNOP() __asm volatile( "NOP" )
+#define portMEMORY_BARRIER() __asm volatile( "DMB" ::: "memory" )
 #define portINLINE __inline
 
 #ifdef __cplusplus
@@ -162,6 +162,36 @@ static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 	static uint32_t ulStoppedTimerCompensation = 0;
 #endif /* configUSE_TICKLESS_IDLE */
 
+/*
+ * The SysTick access functions used by the generic tickless idle implementation
+ * in portable/Common/tickless.c, and the structure that describes them.
+ */
+#if( ( configUSE_TICKLESS_IDLE == 1 ) && ( configUSE_GENERIC_TICKLESS_IDLE == 1 ) )
+	static void prvSysTickStop( void );
+	static void prvSysTickStart( void );
+	static void prvSysTickRestartFromReload( void );
+	static uint32_t prvSysTickGetCount( void );
+	static void prvSysTickSetReload( uint32_t ulReload );
+	static BaseType_t prvSysTickHasExpired( void );
+	static void prvDisableInterruptsForSleep( void );
+	static void prvEnableInterruptsAfterSleep( void );
+	static void prvWaitForInterrupt( void );
+
+	static TicklessTimer_t xSysTickTimer =
+	{
+		0UL, 0UL, 0UL, /* The counts are set by vPortSetupTimerInterrupt(). */
+		prvSysTickStop,
+		prvSysTickStart,
+		prvSysTickRestartFromReload,
+		prvSysTickGetCount,
+		prvSysTickSetReload,
+		prvSysTickHasExpired,
+		prvDisableInterruptsForSleep,
+		prvEnableInterruptsAfterSleep,
+		prvWaitForInterrupt
+	};
+#endif /* configUSE_GENERIC_TICKLESS_IDLE */
+
 /*
  * Used by the portASSERT_IF_INTERRUPT_PRIORITY_INVALID() macro to ensure
  * FreeRTOS API functions are not called from interrupts that have been assigned
@@ -495,7 +525,92 @@ void xPortSysTickHandler( void )
 }
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TICKLESS_IDLE == 1 )
+#if( ( configUSE_TICKLESS_IDLE == 1 ) && ( configUSE_GENERIC_TICKLESS_IDLE == 1 ) )
+
+	__attribute__((weak)) void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+		vPortTicklessSuppressTicksAndSleep( xExpectedIdleTime, &xSysTickTimer );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSysTickStop( void )
+	{
+		/* Disable the SysTick without reading the control register so the
+		count flag is not cleared if it is set. */
+		portNVIC_SYSTICK_CTRL_REG = ( portNVIC_SYSTICK_CLK_BIT | portNVIC_SYSTICK_INT_BIT );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSysTickStart( void )
+	{
+		portNVIC_SYSTICK_CTRL_REG |= portNVIC_SYSTICK_ENABLE_BIT;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSysTickRestartFromReload( void )
+	{
+		/* Writing to the current value register clears both the count and the
+		count flag. */
+		portNVIC_SYSTICK_CURRENT_VALUE_REG = 0UL;
+		portNVIC_SYSTICK_CTRL_REG |= portNVIC_SYSTICK_ENABLE_BIT;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvSysTickGetCount( void )
+	{
+		return portNVIC_SYSTICK_CURRENT_VALUE_REG;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSysTickSetReload( uint32_t ulReload )
+	{
+		portNVIC_SYSTICK_LOAD_REG = ulReload;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvSysTickHasExpired( void )
+	{
+	BaseType_t xReturn;
+
+		if( ( portNVIC_SYSTICK_CTRL_REG & portNVIC_SYSTICK_COUNT_FLAG_BIT ) != 0 )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDisableInterruptsForSleep( void )
+	{
+		/* Don't use the taskENTER_CRITICAL() method as that will mask
+		interrupts that should exit sleep mode. */
+		__asm volatile( "cpsid i" ::: "memory" );
+		__asm volatile( "dsb" );
+		__asm volatile( "isb" );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvEnableInterruptsAfterSleep( void )
+	{
+		__asm volatile( "cpsie i" ::: "memory" );
+		__asm volatile( "dsb" );
+		__asm volatile( "isb" );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWaitForInterrupt( void )
+	{
+		__asm volatile( "dsb" ::: "memory" );
+		__asm volatile( "wfi" );
+		__asm volatile( "isb" );
+	}
+
+#elif( configUSE_TICKLESS_IDLE == 1 )
 
 	__attribute__((weak)) void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
 	{
@@ -674,6 +789,14 @@ __attribute__(( weak )) void vPortSetupTimerInterrupt( void )
 		ulTimerCountsForOneTick = ( configSYSTICK_CLOCK_HZ / configTICK_RATE_HZ );
 		xMaximumPossibleSuppressedTicks = portMAX_24_BIT_NUMBER / ulTimerCountsForOneTick;
 		ulStoppedTimerCompensation = portMISSED_COUNTS_FACTOR / ( configCPU_CLOCK_HZ / configSYSTICK_CLOCK_HZ );
+
+		#if( configUSE_GENERIC_TICKLESS_IDLE == 1 )
+		{
+			xSysTickTimer.ulCountsPerTick = ulTimerCountsForOneTick;
+			xSysTickTimer.ulMaximumSuppressedTicks = xMaximumPossibleSuppressedTicks;
+			xSysTickTimer.ulStoppedTimerCompensation = ulStoppedTimerCompensation;
+		}
+		#endif /* configUSE_GENERIC_TICKLESS_IDLE */
 	}
 	#endif /* configUSE_TICKLESS_IDLE */
 
@@ -55,6 +55,21 @@ task.h is included from an application file. */
 /* Assumes 8bit bytes! */
 #define heapBITS_PER_BYTE		( ( size_t ) 8 )
 
+/* The largest block, including its header, counted in the first size class of
+the allocation histogram. */
+#define heapSMALLEST_SIZE_CLASS_BYTES	( ( size_t ) 32 )
+
+/* The address recorded as the call site of an allocation when
+configUSE_HEAP_INSTRUMENTATION is set to 1.  Can be defined in FreeRTOSConfig.h
+for compilers that do not provide __builtin_return_address(). */
+#ifndef heapGET_CALL_SITE
+	#if defined( __GNUC__ )
+		#define heapGET_CALL_SITE() __builtin_return_address( 0 )
+	#else
+		#define heapGET_CALL_SITE() NULL
+	#endif
+#endif
+
 /* Allocate the memory for the heap. */
 #if( configAPPLICATION_ALLOCATED_HEAP == 1 )
 	/* The application writer has already defined the array used for the RTOS
@@ -70,6 +85,10 @@ typedef struct A_BLOCK_LINK
 {
 	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
 	size_t xBlockSize;						/*<< The size of the free block. */
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		void *pvOwner;						/*<< The task that allocated the block, if any. */
+		void *pvCallSite;					/*<< Where the block was allocated from. */
+	#endif
 } BlockLink_t;
 
 /*-----------------------------------------------------------*/
@@ -82,6 +101,16 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
 
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	/*
+	 * Returns the index of the allocation histogram size class that counts
+	 * blocks of xBlockSize bytes.
+	 */
+	static size_t prvGetSizeClass( size_t xBlockSize );
+
+#endif
+
 /*
  * Called automatically to setup the required heap structures the first time
  * pvPortMalloc() is called.
@@ -101,6 +130,19 @@ static BlockLink_t xStart, *pxEnd = NULL;
 fragmentation. */
 static size_t xFreeBytesRemaining = 0U;
 static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0U;
+static size_t xNumberOfSuccessfulFrees = 0U;
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	/* The first block in the heap, from which vPortHeapDump() starts walking
+	the heap. */
+	static BlockLink_t *pxFirstBlock = NULL;
+
+	/* The number of blocks currently allocated in each size class. */
+	static size_t xAllocatedBlocksInSizeClass[ heapNUMBER_OF_SIZE_CLASSES ] = { 0U };
+
+#endif
 
 /* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
 member of an BlockLink_t structure is set then the block belongs to the
@@ -221,6 +263,25 @@ void *pvReturn = NULL;
 					by the application and has no "next" block. */
 					pxBlock->xBlockSize |= xBlockAllocatedBit;
 					pxBlock->pxNextFreeBlock = NULL;
+					xNumberOfSuccessfulAllocations++;
+
+					#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+					{
+						/* Tag the block with its owner and call site so leaks
+						can be traced back to where they were allocated. */
+						if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+						{
+							pxBlock->pvOwner = ( void * ) xTaskGetCurrentTaskHandle();
+						}
+						else
+						{
+							pxBlock->pvOwner = NULL;
+						}
+
+						pxBlock->pvCallSite = heapGET_CALL_SITE();
+						( xAllocatedBlocksInSizeClass[ prvGetSizeClass( pxBlock->xBlockSize & ~xBlockAllocatedBit ) ] )++;
+					}
+					#endif
 				}
 				else
 				{
@@ -290,7 +351,15 @@ BlockLink_t *pxLink;
 				{
 					/* Add this block to the list of free blocks. */
 					xFreeBytesRemaining += pxLink->xBlockSize;
+					xNumberOfSuccessfulFrees++;
 					traceFREE( pv, pxLink->xBlockSize );
+
+					#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+					{
+						( xAllocatedBlocksInSizeClass[ prvGetSizeClass( pxLink->xBlockSize ) ] )--;
+					}
+					#endif
+
 					prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
 				}
 				( void ) xTaskResumeAll();
@@ -325,6 +394,130 @@ void vPortInitialiseBlocks( void )
 	/* This just exists to keep the linker quiet. */
 }
 /*-----------------------------------------------------------*/
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+BlockLink_t *pxBlock;
+size_t xBlocks = 0, xMaxSize = 0, xMinSize = ~( ( size_t ) 0 );
+
+	configASSERT( pxHeapStats );
+
+	vTaskSuspendAll();
+	{
+		pxBlock = xStart.pxNextFreeBlock;
+
+		/* pxBlock will be NULL if the heap has not been initialised yet. */
+		if( pxBlock != NULL )
+		{
+			while( pxBlock != pxEnd )
+			{
+				xBlocks++;
+
+				if( pxBlock->xBlockSize > xMaxSize )
+				{
+					xMaxSize = pxBlock->xBlockSize;
+				}
+
+				if( pxBlock->xBlockSize < xMinSize )
+				{
+					xMinSize = pxBlock->xBlockSize;
+				}
+
+				/* Move to the next block in the chain until the last block is
+				reached. */
+				pxBlock = pxBlock->pxNextFreeBlock;
+			}
+		}
+
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+
+		#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		{
+		size_t x;
+
+			for( x = 0; x < ( size_t ) heapNUMBER_OF_SIZE_CLASSES; x++ )
+			{
+				pxHeapStats->xAllocatedBlocksInSizeClass[ x ] = xAllocatedBlocksInSizeClass[ x ];
+			}
+		}
+		#endif
+	}
+	( void ) xTaskResumeAll();
+
+	if( xBlocks == ( size_t ) 0 )
+	{
+		xMinSize = 0;
+	}
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+	pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	void vPortHeapDump( HeapDumpFunction_t pxDumpFunction )
+	{
+	BlockLink_t *pxBlock;
+	HeapBlockInfo_t xBlockInfo;
+
+		configASSERT( pxDumpFunction );
+
+		vTaskSuspendAll();
+		{
+			/* pxFirstBlock will be NULL if the heap has not been initialised
+			yet. */
+			pxBlock = pxFirstBlock;
+
+			while( ( pxBlock != NULL ) && ( pxBlock != pxEnd ) )
+			{
+				xBlockInfo.pvAddress = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+				xBlockInfo.xSizeInBytes = ( pxBlock->xBlockSize & ~xBlockAllocatedBit ) - xHeapStructSize;
+				xBlockInfo.pvOwner = pxBlock->pvOwner;
+				xBlockInfo.pvCallSite = pxBlock->pvCallSite;
+
+				if( ( pxBlock->xBlockSize & xBlockAllocatedBit ) != 0 )
+				{
+					xBlockInfo.xIsAllocated = pdTRUE;
+				}
+				else
+				{
+					xBlockInfo.xIsAllocated = pdFALSE;
+				}
+
+				pxDumpFunction( &xBlockInfo );
+
+				/* The blocks are contiguous, so the next block starts where
+				this one ends. */
+				pxBlock = ( BlockLink_t * ) ( ( ( uint8_t * ) pxBlock ) + ( pxBlock->xBlockSize & ~xBlockAllocatedBit ) );
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	static size_t prvGetSizeClass( size_t xBlockSize )
+	{
+	size_t xSizeClass = 0, xLimit = heapSMALLEST_SIZE_CLASS_BYTES;
+
+		while( ( xBlockSize > xLimit ) && ( xSizeClass < ( ( size_t ) heapNUMBER_OF_SIZE_CLASSES - 1 ) ) )
+		{
+			xLimit <<= 1;
+			xSizeClass++;
+		}
+
+		return xSizeClass;
+	}
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+/*-----------------------------------------------------------*/
 
 static void prvHeapInit( void )
 {
@@ -365,6 +558,16 @@ size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
 	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
 	pxFirstFreeBlock->pxNextFreeBlock = pxEnd;
 
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	{
+		pxEnd->pvOwner = NULL;
+		pxEnd->pvCallSite = NULL;
+		pxFirstFreeBlock->pvOwner = NULL;
+		pxFirstFreeBlock->pvCallSite = NULL;
+		pxFirstBlock = pxFirstFreeBlock;
+	}
+	#endif
+
 	/* Only one block exists - and it covers the entire usable heap space. */
 	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
 	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
@@ -432,5 +635,17 @@ uint8_t *puc;
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
+
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	{
+		/* The block is free, so has no owner.  Cleared here because this is
+		where blocks being freed, the remainders of blocks split by
+		pvPortMalloc(), and blocks combined above all join the free list, and
+		their headers might otherwise hold stale values left in the memory
+		they were written to. */
+		pxBlockToInsert->pvOwner = NULL;
+		pxBlockToInsert->pvCallSite = NULL;
+	}
+	#endif
 }
 
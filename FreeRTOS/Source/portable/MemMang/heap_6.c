@@ -0,0 +1,942 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that has O(1),
+ * bounded, execution time.  Free blocks are held in segregated free lists
+ * that are indexed by a two level bitmap (the "two level segregated fit"
+ * scheme), so finding a block large enough for a request never requires a
+ * list to be searched.  Adjacent blocks are combined as they are freed, so
+ * fragmentation is limited as it is with heap_4.c.
+ *
+ * Optionally (configHEAP_CACHE_DEPTH > 0), each core keeps a cache of recently
+ * freed small blocks, one list per block size.  On multi-core systems the
+ * caches can be accessed without taking the scheduler lock, which removes the
+ * heap as a global serialisation point for small allocations.  Blocks held in
+ * a cache are counted as free by xPortGetFreeHeapSize(), and are returned to
+ * the heap if an allocation would otherwise fail.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* The number of freed blocks of each small block size each core keeps in its
+cache.  0 disables the caches. */
+#ifndef configHEAP_CACHE_DEPTH
+	#define configHEAP_CACHE_DEPTH 0
+#endif
+
+/* The caches are per core. */
+#if( configNUM_CORES > 1 )
+	#define heapGET_CORE_ID()		( ( BaseType_t ) portGET_CORE_ID() )
+#else
+	#define heapGET_CORE_ID()		( ( BaseType_t ) 0 )
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE			( ( size_t ) 8 )
+
+/* Set in the xBlockSize member of a block that belongs to the application (or
+is held in a cache). */
+#define heapBLOCK_ALLOCATED_BIT		( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+
+/* Each power of two range of block sizes (the first level) is divided into
+heapSL_INDEX_COUNT equally sized ranges (the second level), each of which has
+its own free list.  Blocks smaller than heapSMALL_BLOCK_SIZE all belong to the
+first level range, which is divided linearly. */
+#define heapSL_INDEX_COUNT_LOG2		( 4U )
+#define heapSL_INDEX_COUNT			( 1U << heapSL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT			( 7U )
+#define heapSMALL_BLOCK_SIZE		( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+#define heapSMALL_BLOCK_GRANULARITY	( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT )
+
+/* The position of the most significant set bit in a constant of up to 32
+bits, used to size the first level to the heap. */
+#define heapMSB_2( x )				( ( ( ( x ) & 0x2UL ) != 0UL ) ? 1 : 0 )
+#define heapMSB_4( x )				( ( ( ( x ) & 0xCUL ) != 0UL ) ? ( 2 + heapMSB_2( ( x ) >> 2 ) ) : heapMSB_2( x ) )
+#define heapMSB_8( x )				( ( ( ( x ) & 0xF0UL ) != 0UL ) ? ( 4 + heapMSB_4( ( x ) >> 4 ) ) : heapMSB_4( x ) )
+#define heapMSB_16( x )				( ( ( ( x ) & 0xFF00UL ) != 0UL ) ? ( 8 + heapMSB_8( ( x ) >> 8 ) ) : heapMSB_8( x ) )
+#define heapMSB_32( x )				( ( ( ( x ) & 0xFFFF0000UL ) != 0UL ) ? ( 16 + heapMSB_16( ( x ) >> 16 ) ) : heapMSB_16( x ) )
+
+/* The number of first level ranges needed to hold a block the size of the
+whole heap. */
+#define heapFL_INDEX_COUNT			( ( heapMSB_32( configTOTAL_HEAP_SIZE ) > ( int ) heapFL_INDEX_SHIFT ) ? ( heapMSB_32( configTOTAL_HEAP_SIZE ) - ( int ) heapFL_INDEX_SHIFT + 2 ) : 1 )
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The structure placed at the start of each block.  Only the first two
+members are used while the block is allocated, the free list links are
+overwritten by the application's data. */
+typedef struct A_BLOCK_HEADER
+{
+	struct A_BLOCK_HEADER *pxPreviousPhysicalBlock;	/*<< The block immediately below this block in memory, or NULL if this is the first block. */
+	size_t xBlockSize;								/*<< The size of the block, including this header. */
+	struct A_BLOCK_HEADER *pxNextFreeBlock;			/*<< The next block in the same free list. */
+	struct A_BLOCK_HEADER *pxPreviousFreeBlock;		/*<< The previous block in the same free list. */
+} BlockHeader_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Return the index of the most (least) significant set bit in ulValue, which
+ * must not be zero.
+ */
+static UBaseType_t prvMostSignificantBit( uint32_t ulValue );
+static UBaseType_t prvLeastSignificantBit( uint32_t ulValue );
+
+/*
+ * Calculate the first and second level indexes of the free list that holds
+ * blocks of xBlockSize bytes.
+ */
+static void prvMapBlockSize( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Add a free block to, or remove a free block from, the free list for its
+ * size.
+ */
+static void prvInsertFreeBlock( BlockHeader_t *pxBlock );
+static void prvRemoveFreeBlock( BlockHeader_t *pxBlock );
+
+/*
+ * Remove and return a free block of at least xBlockSize bytes, splitting it if
+ * it is larger than needed, or return NULL if there is no such block.  The
+ * block is marked as allocated and removed from the free byte count.  The
+ * scheduler must be suspended.
+ */
+static BlockHeader_t *prvAllocateBlock( size_t xBlockSize );
+
+/*
+ * Return a block to the free lists, combining it with the blocks either side
+ * of it if they are also free.  The scheduler must be suspended.
+ */
+static void prvFreeBlock( BlockHeader_t *pxBlock );
+
+#if( configHEAP_CACHE_DEPTH > 0 )
+
+	/*
+	 * Take a block of xBlockSize bytes from, or put a block into, the calling
+	 * core's cache.  Return NULL (pdFALSE) if the cache was empty (full).
+	 */
+	static BlockHeader_t *prvCacheAllocate( size_t xBlockSize );
+	static BaseType_t prvCacheFree( BlockHeader_t *pxBlock );
+
+	/*
+	 * Return all the blocks in the calling core's cache to the heap.
+	 */
+	static void prvCacheFlush( void );
+
+	/*
+	 * Stop the calling task being preempted, or moved to another core, while
+	 * the calling core's cache is accessed.
+	 */
+	static UBaseType_t prvCacheEnter( void );
+	static void prvCacheExit( UBaseType_t uxSavedInterruptStatus );
+
+#endif /* configHEAP_CACHE_DEPTH */
+
+/*-----------------------------------------------------------*/
+
+/* The size of the part of the block header that is kept while the block is
+allocated, and of the smallest block that can hold the whole header while the
+block is free.  Both must be correctly byte aligned. */
+static const size_t xHeapStructSize	= ( ( sizeof( BlockHeader_t * ) + sizeof( size_t ) ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+static const size_t xMinimumBlockSize = ( sizeof( BlockHeader_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The free lists, and the bitmaps that record which of them are not empty.
+Bit n of ulFirstLevelBitmap is set if any bit in ulSecondLevelBitmaps[ n ] is
+set.  Bit m of ulSecondLevelBitmaps[ n ] is set if pxFreeLists[ n ][ m ] is not
+empty. */
+static BlockHeader_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFirstLevelBitmap = 0U;
+static uint32_t ulSecondLevelBitmaps[ heapFL_INDEX_COUNT ];
+
+/* Marks the end of the heap.  Never free, so never combined with the last
+real block. */
+static BlockHeader_t *pxEnd = NULL;
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+#if( configHEAP_CACHE_DEPTH > 0 )
+
+	/* The per core caches of freed small blocks, one list per block size, and
+	the number of bytes each core's cache holds. */
+	static BlockHeader_t *pxCaches[ configNUM_CORES ][ heapSL_INDEX_COUNT ];
+	static uint8_t ucCacheCounts[ configNUM_CORES ][ heapSL_INDEX_COUNT ];
+	static size_t xCachedBytes[ configNUM_CORES ];
+
+#endif /* configHEAP_CACHE_DEPTH */
+
+/* Lookup tables used to find set bits with a multiplication by a de Bruijn
+sequence, as not all compilers provide builtins for this. */
+static const uint8_t ucMSBLookup[ 32 ] =
+{
+	0U, 9U, 1U, 10U, 13U, 21U, 2U, 29U, 11U, 14U, 16U, 18U, 22U, 25U, 3U, 30U,
+	8U, 12U, 20U, 28U, 15U, 17U, 24U, 7U, 19U, 27U, 23U, 6U, 26U, 5U, 4U, 31U
+};
+
+static const uint8_t ucLSBLookup[ 32 ] =
+{
+	0U, 1U, 28U, 2U, 29U, 14U, 24U, 3U, 30U, 22U, 20U, 15U, 25U, 17U, 4U, 8U,
+	31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U, 26U, 12U, 18U, 6U, 11U, 5U, 10U, 9U
+};
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+BlockHeader_t *pxBlock = NULL;
+void *pvReturn = NULL;
+size_t xFreeBytes;
+
+	/* Check the requested size is not zero and is not so large that it could
+	never be satisfied - which also means the size calculations below cannot
+	overflow. */
+	if( ( xWantedSize > ( size_t ) 0 ) && ( xWantedSize < ( size_t ) configTOTAL_HEAP_SIZE ) )
+	{
+		/* The wanted size is increased so it can contain the block header in
+		addition to the requested amount of bytes, and so the block is large
+		enough to hold the free list links once it is freed. */
+		xWantedSize += xHeapStructSize;
+
+		/* Ensure that blocks are always aligned to the required number of
+		bytes. */
+		if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+		{
+			/* Byte alignment required. */
+			xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+			configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xWantedSize < xMinimumBlockSize )
+		{
+			xWantedSize = xMinimumBlockSize;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configHEAP_CACHE_DEPTH > 0 )
+		{
+			pxBlock = prvCacheAllocate( xWantedSize );
+		}
+		#endif /* configHEAP_CACHE_DEPTH */
+
+		if( pxBlock == NULL )
+		{
+			vTaskSuspendAll();
+			{
+				/* If this is the first call to malloc then the heap will
+				require initialisation to setup the free lists. */
+				if( pxEnd == NULL )
+				{
+					prvHeapInit();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxBlock = prvAllocateBlock( xWantedSize );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configHEAP_CACHE_DEPTH > 0 )
+		{
+			if( pxBlock == NULL )
+			{
+				/* Blocks held in the calling core's cache might be combined
+				into a block large enough if they are returned to the heap. */
+				prvCacheFlush();
+
+				vTaskSuspendAll();
+				{
+					pxBlock = prvAllocateBlock( xWantedSize );
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configHEAP_CACHE_DEPTH */
+
+		if( pxBlock != NULL )
+		{
+			/* Return the memory space pointed to - jumping over the part of
+			the header that is kept while the block is allocated. */
+			pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+
+			/* With the caches enabled the minimum can be updated by more than
+			one core at once, in which case it might not record the lowest
+			value, but it is only ever approximate as the heap is not locked
+			while it is read anyway. */
+			xFreeBytes = xPortGetFreeHeapSize();
+			if( xFreeBytes < xMinimumEverFreeBytesRemaining )
+			{
+				xMinimumEverFreeBytesRemaining = xFreeBytes;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceMALLOC( pvReturn, xWantedSize );
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockHeader_t *pxBlock;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have the block header immediately
+		before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxBlock = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxBlock->xBlockSize & heapBLOCK_ALLOCATED_BIT ) != 0 );
+
+		if( ( pxBlock->xBlockSize & heapBLOCK_ALLOCATED_BIT ) != 0 )
+		{
+			#if( configHEAP_CACHE_DEPTH > 0 )
+			{
+				if( prvCacheFree( pxBlock ) != pdFALSE )
+				{
+					traceFREE( pv, pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BIT );
+					return;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configHEAP_CACHE_DEPTH */
+
+			vTaskSuspendAll();
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				pxBlock->xBlockSize &= ~heapBLOCK_ALLOCATED_BIT;
+				xFreeBytesRemaining += pxBlock->xBlockSize;
+				traceFREE( pv, pxBlock->xBlockSize );
+				prvFreeBlock( pxBlock );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+size_t xReturn = xFreeBytesRemaining;
+
+	#if( configHEAP_CACHE_DEPTH > 0 )
+	{
+	BaseType_t xCore;
+
+		for( xCore = 0; xCore < ( BaseType_t ) configNUM_CORES; xCore++ )
+		{
+			xReturn += xCachedBytes[ xCore ];
+		}
+	}
+	#endif /* configHEAP_CACHE_DEPTH */
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+BlockHeader_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* The first level bitmap is 32 bits. */
+	configASSERT( xTotalHeapSize <= ( size_t ) 0xFFFFFFFFUL );
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* pxEnd marks the end of the heap.  It is a zero sized block that is
+	always allocated, so the last real block never needs to be checked for a
+	block after it. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+	pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+
+	pxEnd->xBlockSize = heapBLOCK_ALLOCATED_BIT;
+	pxEnd->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+
+	prvInsertFreeBlock( pxFirstFreeBlock );
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvMostSignificantBit( uint32_t ulValue )
+{
+	/* Set every bit below the most significant set bit, so only 32 values are
+	possible. */
+	ulValue |= ulValue >> 1;
+	ulValue |= ulValue >> 2;
+	ulValue |= ulValue >> 4;
+	ulValue |= ulValue >> 8;
+	ulValue |= ulValue >> 16;
+
+	return ( UBaseType_t ) ucMSBLookup[ ( uint32_t ) ( ulValue * 0x07C4ACDDUL ) >> 27 ];
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvLeastSignificantBit( uint32_t ulValue )
+{
+	/* Isolate the least significant set bit. */
+	ulValue &= ( ~ulValue ) + 1UL;
+
+	return ( UBaseType_t ) ucLSBLookup[ ( uint32_t ) ( ulValue * 0x077CB531UL ) >> 27 ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapBlockSize( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxMSB;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks are divided linearly. */
+		*puxFirstLevel = 0U;
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize / heapSMALL_BLOCK_GRANULARITY );
+	}
+	else
+	{
+		/* The second level index is given by the heapSL_INDEX_COUNT_LOG2 bits
+		below the most significant set bit. */
+		uxMSB = prvMostSignificantBit( ( uint32_t ) xBlockSize );
+		*puxFirstLevel = uxMSB - ( heapFL_INDEX_SHIFT - 1U );
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxMSB - heapSL_INDEX_COUNT_LOG2 ) ) & ( heapSL_INDEX_COUNT - 1U );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockHeader_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+BlockHeader_t *pxHead;
+
+	prvMapBlockSize( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+	configASSERT( uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT );
+
+	/* Blocks are added to the head of the list. */
+	pxHead = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+	pxBlock->pxNextFreeBlock = pxHead;
+	pxBlock->pxPreviousFreeBlock = NULL;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPreviousFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+	ulFirstLevelBitmap |= ( 1UL << uxFirstLevel );
+	ulSecondLevelBitmaps[ uxFirstLevel ] |= ( 1UL << uxSecondLevel );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockHeader_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPreviousFreeBlock != NULL )
+	{
+		pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was at the head of its list. */
+		prvMapBlockSize( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+		pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			/* The list is now empty. */
+			ulSecondLevelBitmaps[ uxFirstLevel ] &= ~( 1UL << uxSecondLevel );
+
+			if( ulSecondLevelBitmaps[ uxFirstLevel ] == 0UL )
+			{
+				ulFirstLevelBitmap &= ~( 1UL << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BlockHeader_t *prvAllocateBlock( size_t xBlockSize )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulBitmap;
+size_t xSearchSize = xBlockSize;
+BlockHeader_t *pxBlock = NULL, *pxNewBlock, *pxNextBlock;
+
+	/* Round the size up to the start of the next second level range, so any
+	block in the list that is found is large enough.  The small ranges are
+	heapSMALL_BLOCK_GRANULARITY bytes wide, so hold blocks of more than one
+	size if portBYTE_ALIGNMENT is smaller than that. */
+	if( xSearchSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xSearchSize += ( ( size_t ) 1 << ( prvMostSignificantBit( ( uint32_t ) xSearchSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+	}
+	else
+	{
+		xSearchSize += heapSMALL_BLOCK_GRANULARITY - ( size_t ) 1;
+		xSearchSize &= ~( heapSMALL_BLOCK_GRANULARITY - ( size_t ) 1 );
+	}
+
+	prvMapBlockSize( xSearchSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT )
+	{
+		/* Look for a non empty list in the same first level range first, then
+		in the smallest larger first level range that has one. */
+		ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ] & ( ~0UL << uxSecondLevel );
+
+		if( ulBitmap == 0UL )
+		{
+			if( ( uxFirstLevel + 1U ) < ( UBaseType_t ) heapFL_INDEX_COUNT )
+			{
+				ulBitmap = ulFirstLevelBitmap & ( ~0UL << ( uxFirstLevel + 1U ) );
+			}
+			else
+			{
+				ulBitmap = 0UL;
+			}
+
+			if( ulBitmap != 0UL )
+			{
+				uxFirstLevel = prvLeastSignificantBit( ulBitmap );
+				ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ];
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ulBitmap != 0UL )
+		{
+			uxSecondLevel = prvLeastSignificantBit( ulBitmap );
+			pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+			configASSERT( pxBlock );
+			configASSERT( pxBlock->xBlockSize >= xBlockSize );
+
+			prvRemoveFreeBlock( pxBlock );
+
+			/* If the block is larger than required it can be split into
+			two. */
+			if( ( pxBlock->xBlockSize - xBlockSize ) >= xMinimumBlockSize )
+			{
+				/* The void cast is used to prevent byte alignment warnings
+				from the compiler. */
+				pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+				configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+				pxNewBlock->xBlockSize = pxBlock->xBlockSize - xBlockSize;
+				pxNewBlock->pxPreviousPhysicalBlock = pxBlock;
+				pxBlock->xBlockSize = xBlockSize;
+
+				/* The block after the new block now follows the new block. */
+				pxNextBlock = ( void * ) ( ( ( uint8_t * ) pxNewBlock ) + pxNewBlock->xBlockSize );
+				pxNextBlock->pxPreviousPhysicalBlock = pxNewBlock;
+
+				prvInsertFreeBlock( pxNewBlock );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+			/* The block is being returned - it is allocated and owned by the
+			application. */
+			pxBlock->xBlockSize |= heapBLOCK_ALLOCATED_BIT;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeBlock( BlockHeader_t *pxBlock )
+{
+BlockHeader_t *pxNeighbour;
+
+	/* Combine the block with the block after it if that block is free.  pxEnd
+	is always allocated, so is never combined. */
+	pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+	if( ( pxNeighbour->xBlockSize & heapBLOCK_ALLOCATED_BIT ) == 0 )
+	{
+		prvRemoveFreeBlock( pxNeighbour );
+		pxBlock->xBlockSize += pxNeighbour->xBlockSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Combine the block with the block before it if that block is free. */
+	pxNeighbour = pxBlock->pxPreviousPhysicalBlock;
+	if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xBlockSize & heapBLOCK_ALLOCATED_BIT ) == 0 ) )
+	{
+		prvRemoveFreeBlock( pxNeighbour );
+		pxNeighbour->xBlockSize += pxBlock->xBlockSize;
+		pxBlock = pxNeighbour;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* The block after the combined block now follows the combined block. */
+	pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+	pxNeighbour->pxPreviousPhysicalBlock = pxBlock;
+
+	prvInsertFreeBlock( pxBlock );
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_CACHE_DEPTH > 0 )
+
+	static UBaseType_t prvCacheEnter( void )
+	{
+	UBaseType_t uxReturn;
+
+		#if( configNUM_CORES > 1 )
+		{
+			/* Masking interrupts on the calling core stops the calling task
+			being preempted or moved to another core, so the core's cache can
+			be accessed without locking the scheduler on every core. */
+			uxReturn = portSET_INTERRUPT_MASK_FROM_ISR();
+		}
+		#else
+		{
+			vTaskSuspendAll();
+			uxReturn = 0U;
+		}
+		#endif /* configNUM_CORES */
+
+		return uxReturn;
+	}
+
+#endif /* configHEAP_CACHE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_CACHE_DEPTH > 0 )
+
+	static void prvCacheExit( UBaseType_t uxSavedInterruptStatus )
+	{
+		#if( configNUM_CORES > 1 )
+		{
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#else
+		{
+			( void ) uxSavedInterruptStatus;
+			( void ) xTaskResumeAll();
+		}
+		#endif /* configNUM_CORES */
+	}
+
+#endif /* configHEAP_CACHE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_CACHE_DEPTH > 0 )
+
+	static BlockHeader_t *prvCacheAllocate( size_t xBlockSize )
+	{
+	BlockHeader_t *pxBlock = NULL;
+	UBaseType_t uxSavedInterruptStatus, uxClass;
+	BaseType_t xCore;
+
+		/* Any block in the cache list for a size rounded up to the cache
+		granularity is large enough. */
+		uxClass = ( UBaseType_t ) ( ( xBlockSize + ( heapSMALL_BLOCK_GRANULARITY - 1U ) ) / heapSMALL_BLOCK_GRANULARITY );
+
+		if( uxClass < heapSL_INDEX_COUNT )
+		{
+			uxSavedInterruptStatus = prvCacheEnter();
+			{
+				xCore = heapGET_CORE_ID();
+				pxBlock = pxCaches[ xCore ][ uxClass ];
+
+				if( pxBlock != NULL )
+				{
+					pxCaches[ xCore ][ uxClass ] = pxBlock->pxNextFreeBlock;
+					ucCacheCounts[ xCore ][ uxClass ]--;
+					xCachedBytes[ xCore ] -= pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BIT;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			prvCacheExit( uxSavedInterruptStatus );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxBlock;
+	}
+
+#endif /* configHEAP_CACHE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_CACHE_DEPTH > 0 )
+
+	static BaseType_t prvCacheFree( BlockHeader_t *pxBlock )
+	{
+	BaseType_t xReturn = pdFALSE, xCore;
+	UBaseType_t uxSavedInterruptStatus, uxClass;
+	size_t xBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BIT;
+
+		/* Blocks are cached by their size rounded down to the cache
+		granularity.  They remain marked as allocated while they are in the
+		cache, so they are not combined with the blocks either side of them. */
+		uxClass = ( UBaseType_t ) ( xBlockSize / heapSMALL_BLOCK_GRANULARITY );
+
+		if( uxClass < heapSL_INDEX_COUNT )
+		{
+			uxSavedInterruptStatus = prvCacheEnter();
+			{
+				xCore = heapGET_CORE_ID();
+
+				if( ucCacheCounts[ xCore ][ uxClass ] < ( uint8_t ) configHEAP_CACHE_DEPTH )
+				{
+					pxBlock->pxNextFreeBlock = pxCaches[ xCore ][ uxClass ];
+					pxCaches[ xCore ][ uxClass ] = pxBlock;
+					ucCacheCounts[ xCore ][ uxClass ]++;
+					xCachedBytes[ xCore ] += xBlockSize;
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			prvCacheExit( uxSavedInterruptStatus );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configHEAP_CACHE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_CACHE_DEPTH > 0 )
+
+	static void prvCacheFlush( void )
+	{
+	BlockHeader_t *pxBlock;
+	UBaseType_t uxSavedInterruptStatus, uxClass;
+	BaseType_t xCore;
+
+		vTaskSuspendAll();
+		{
+			uxSavedInterruptStatus = prvCacheEnter();
+			{
+				xCore = heapGET_CORE_ID();
+
+				for( uxClass = 0U; uxClass < heapSL_INDEX_COUNT; uxClass++ )
+				{
+					while( pxCaches[ xCore ][ uxClass ] != NULL )
+					{
+						pxBlock = pxCaches[ xCore ][ uxClass ];
+						pxCaches[ xCore ][ uxClass ] = pxBlock->pxNextFreeBlock;
+
+						pxBlock->xBlockSize &= ~heapBLOCK_ALLOCATED_BIT;
+						xCachedBytes[ xCore ] -= pxBlock->xBlockSize;
+						xFreeBytesRemaining += pxBlock->xBlockSize;
+						prvFreeBlock( pxBlock );
+					}
+
+					ucCacheCounts[ xCore ][ uxClass ] = 0U;
+				}
+			}
+			prvCacheExit( uxSavedInterruptStatus );
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configHEAP_CACHE_DEPTH */
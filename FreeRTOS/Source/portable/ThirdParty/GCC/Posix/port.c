@@ -0,0 +1,554 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the Posix port.
+ *
+ * Each task is executed by its own host thread (pthread).  Only the thread of
+ * the task that is in the Running state is ever allowed to execute - the
+ * threads of all the other tasks are held blocked on a per thread event (a
+ * mutex and condition variable pair).  A context switch therefore consists of
+ * signalling the event of the thread being switched in, then waiting on the
+ * event of the thread being switched out.
+ *
+ * Interrupts are simulated using signals.  The tick interrupt is generated by
+ * an interval timer (SIGALRM), and disabling interrupts is achieved by blocking
+ * signals in the calling thread.  All signals are blocked in every thread other
+ * than the thread of the Running state task, so signals are always delivered
+ * to, and handled in the context of, the Running state task.
+ *
+ * NOTE:  Host library functions that take internal locks (printf(), malloc(),
+ * etc.) must only be called from within a critical section, or with the
+ * scheduler suspended, as otherwise a task switch can occur while the lock is
+ * held - and the next task to call the same library function will deadlock.
+ * Use heap_3.c, which suspends the scheduler around calls to malloc() and
+ * free(), if the FreeRTOS heap is to come from the host's heap.
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The signal used to generate the tick interrupt. */
+#define portTICK_SIGNAL				SIGALRM
+
+#define portNO_CRITICAL_NESTING		( ( UBaseType_t ) 0 )
+
+/* Used as the initial critical nesting value to prevent signals becoming
+unblocked before the first task starts to run. */
+#define portINITIAL_CRITICAL_NESTING ( ( UBaseType_t ) 9999 )
+
+/*-----------------------------------------------------------*/
+
+/* An event on which a thread can block until it is signalled by another
+thread.  Unlike a bare condition variable the event is latched, so a signal is
+not lost if it is given before the thread starts to wait. */
+typedef struct THREAD_EVENT
+{
+	pthread_mutex_t xMutex;
+	pthread_cond_t xCond;
+	BaseType_t xTriggered;
+} ThreadEvent_t;
+
+/* The Posix simulator runs each task in a thread.  The context switching is
+managed by the threads, so the task stack does not have to be managed directly,
+although the task stack is still used to hold a Thread_t structure, which is
+the only thing it will ever hold.  The structure maps the task handle to the
+thread that executes the task. */
+typedef struct THREAD
+{
+	pthread_t xPthread;				/*< The thread that executes the task. */
+	TaskFunction_t pxCode;			/*< The task's entry point. */
+	void *pvParams;					/*< The parameter passed to the task's entry point. */
+	volatile BaseType_t xDying;		/*< Set when the task is deleted so the thread exits rather than waiting to run again. */
+	ThreadEvent_t xWakeEvent;		/*< Signalled when the task is switched in. */
+} Thread_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The entry point of every task thread.  Waits until the task is switched in
+ * for the first time before calling the task's entry point.
+ */
+static void *prvWaitForStart( void *pvParams );
+
+/*
+ * Switch execution from the thread of pxThreadToSuspend to the thread of
+ * pxThreadToResume.  Must be called from the thread of pxThreadToSuspend with
+ * signals blocked.
+ */
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend );
+
+/*
+ * Select the next task to run and switch to it.
+ */
+static void prvYield( void );
+
+/*
+ * The simulated tick interrupt.
+ */
+static void prvTickSignalHandler( int iSignal );
+
+/*
+ * Start or stop the interval timer that generates the simulated tick
+ * interrupt.
+ */
+static void prvSetupTimerInterrupt( void );
+static void prvStopTimerInterrupt( void );
+
+/*
+ * Initialise the set of signals blocked to simulate disabling interrupts.
+ */
+static void prvInitialiseSignalMask( void );
+
+/*
+ * Event primitives used to hand execution from one thread to another.
+ */
+static void prvEventInitialise( ThreadEvent_t *pxEvent );
+static void prvEventDelete( ThreadEvent_t *pxEvent );
+static void prvEventSignal( ThreadEvent_t *pxEvent );
+static void prvEventWait( ThreadEvent_t *pxEvent );
+
+/*-----------------------------------------------------------*/
+
+/* Pointer to the TCB of the currently executing task.  The first member of the
+TCB is the top of stack pointer, which this port uses to locate the Thread_t
+structure of each task. */
+extern void * volatile pxCurrentTCB;
+
+/* The critical nesting count for the currently executing task.  Each thread
+saves its own value on its own (host) stack when it is switched out, and
+restores it when it is switched back in. */
+static volatile UBaseType_t uxCriticalNesting = portINITIAL_CRITICAL_NESTING;
+
+/* The signals that are blocked while (simulated) interrupts are disabled. */
+static sigset_t xAllSignals;
+static pthread_once_t xSignalMaskOnce = PTHREAD_ONCE_INIT;
+
+/* The thread that called xPortStartScheduler() waits on this event until
+vPortEndScheduler() is called. */
+static ThreadEvent_t xSchedulerEndEvent;
+
+/* Used to ensure nothing is processed during the startup sequence. */
+static volatile BaseType_t xPortRunning = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThreadFromTask( void *pvTask )
+{
+	/* The first member of the TCB points to the Thread_t structure, which was
+	placed at the top of the task's stack by pxPortInitialiseStack(). */
+	return ( Thread_t * ) *( ( StackType_t ** ) pvTask );
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+sigset_t xCallerSignals;
+int iRet;
+
+	( void ) pthread_once( &xSignalMaskOnce, prvInitialiseSignalMask );
+
+	/* In this simulated case a stack is not initialised, but instead a thread
+	is created that will execute the task being created.  The thread handles
+	the context switching itself.  The Thread_t object is placed onto the stack
+	that was created for the task - so the stack buffer is still used, just not
+	in the conventional way.  It will not be used for anything other than
+	holding this structure. */
+	pxThread = ( Thread_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxTopOfStack + 1 ) - sizeof( Thread_t ) ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) );
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParams = pvParameters;
+	pxThread->xDying = pdFALSE;
+	prvEventInitialise( &( pxThread->xWakeEvent ) );
+
+	/* The new thread inherits the signal mask of the creating thread, so block
+	all signals while the thread is created to ensure the simulated interrupts
+	are never delivered to a thread that is not running a task. */
+	( void ) pthread_sigmask( SIG_SETMASK, &xAllSignals, &xCallerSignals );
+	iRet = pthread_create( &( pxThread->xPthread ), NULL, prvWaitForStart, ( void * ) pxThread );
+	( void ) pthread_sigmask( SIG_SETMASK, &xCallerSignals, NULL );
+
+	configASSERT( iRet == 0 );
+	( void ) iRet;
+
+	return ( StackType_t * ) pxThread;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+struct sigaction xTickAction;
+Thread_t *pxFirstThread;
+
+	( void ) pthread_once( &xSignalMaskOnce, prvInitialiseSignalMask );
+
+	/* The thread that starts the scheduler never runs a task, so must never
+	receive a simulated interrupt. */
+	( void ) pthread_sigmask( SIG_SETMASK, &xAllSignals, NULL );
+
+	/* Install the tick handler.  All signals are blocked while the handler
+	executes, which is equivalent to the tick interrupt executing with
+	interrupts disabled.  SA_RESTART prevents the tick interrupting any host
+	system calls made by the tasks. */
+	memset( &xTickAction, 0x00, sizeof( xTickAction ) );
+	xTickAction.sa_handler = prvTickSignalHandler;
+	xTickAction.sa_flags = SA_RESTART;
+	( void ) sigfillset( &( xTickAction.sa_mask ) );
+	( void ) sigaction( portTICK_SIGNAL, &xTickAction, NULL );
+
+	prvEventInitialise( &xSchedulerEndEvent );
+
+	xPortRunning = pdTRUE;
+
+	/* Start the timer that generates the tick ISR. */
+	prvSetupTimerInterrupt();
+
+	/* Start the first task by signalling the thread of the task that was
+	selected to run first.  The thread will reset the critical nesting count
+	and unblock signals itself. */
+	pxFirstThread = prvGetThreadFromTask( pxCurrentTCB );
+	prvEventSignal( &( pxFirstThread->xWakeEvent ) );
+
+	/* Wait until vPortEndScheduler() is called by a task. */
+	prvEventWait( &xSchedulerEndEvent );
+
+	prvEventDelete( &xSchedulerEndEvent );
+
+	/* Should only get here if vTaskEndScheduler() was called. */
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	prvStopTimerInterrupt();
+	xPortRunning = pdFALSE;
+
+	/* Let the thread that called xPortStartScheduler() return from
+	vTaskStartScheduler(). */
+	prvEventSignal( &xSchedulerEndEvent );
+
+	/* The scheduler has stopped, so the task that called vTaskEndScheduler()
+	will never run again. */
+	pthread_exit( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	if( uxCriticalNesting == portNO_CRITICAL_NESTING )
+	{
+		vPortDisableInterrupts();
+	}
+
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	configASSERT( uxCriticalNesting > portNO_CRITICAL_NESTING );
+	uxCriticalNesting--;
+
+	/* Interrupts are only re-enabled when the outermost critical section is
+	exited. */
+	if( uxCriticalNesting == portNO_CRITICAL_NESTING )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	( void ) pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xPortSetInterruptMask( void )
+{
+sigset_t xPreviousSignals;
+
+	/* Return pdTRUE if the tick signal was already blocked, in which case
+	vPortClearInterruptMask() must leave it blocked. */
+	( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+	return ( UBaseType_t ) ( sigismember( &xPreviousSignals, portTICK_SIGNAL ) == 1 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+	if( uxMask == ( UBaseType_t ) pdFALSE )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	vPortEnterCritical();
+	{
+		prvYield();
+	}
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+	/* Signals are already blocked within a (simulated) interrupt handler. */
+	prvYield();
+}
+/*-----------------------------------------------------------*/
+
+void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+Thread_t *pxThread = prvGetThreadFromTask( pxTaskToDelete );
+
+	/* The task is deleting itself.  Its thread exits the next time it is
+	switched out, rather than waiting to be switched back in. */
+	pxThread->xDying = pdTRUE;
+
+	/* Unlike the Windows port this function returns, so the yield that follows
+	the deletion performs the context switch. */
+	( void ) pxPendYield;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pxTaskToDelete )
+{
+Thread_t *pxThread = prvGetThreadFromTask( pxTaskToDelete );
+UBaseType_t uxSavedInterruptStatus;
+
+	/* The thread is not running, so is either blocked on its wake event or,
+	if the task deleted itself, has already exited.  Wake it with the dying
+	flag set so it exits, then reclaim it.  The tick must not interrupt the
+	join, as the host library holds internal locks while it reclaims the
+	thread - if the tick switched to a task that then created a thread the
+	two would deadlock. */
+	uxSavedInterruptStatus = xPortSetInterruptMask();
+	{
+		pxThread->xDying = pdTRUE;
+		prvEventSignal( &( pxThread->xWakeEvent ) );
+		( void ) pthread_join( pxThread->xPthread, NULL );
+		prvEventDelete( &( pxThread->xWakeEvent ) );
+	}
+	vPortClearInterruptMask( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvWaitForStart( void *pvParams )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParams;
+
+	prvEventWait( &( pxThread->xWakeEvent ) );
+
+	/* The task might have been deleted before it ever ran. */
+	if( pxThread->xDying == pdFALSE )
+	{
+		/* Switched in for the first time, so interrupts must be enabled. */
+		uxCriticalNesting = portNO_CRITICAL_NESTING;
+		vPortEnableInterrupts();
+
+		pxThread->pxCode( pxThread->pvParams );
+
+		/* Tasks must not attempt to return from their implementing function,
+		but if one does then delete it cleanly rather than leaving its thread
+		in an unknown state. */
+		vTaskDelete( NULL );
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend )
+{
+UBaseType_t uxSavedCriticalNesting;
+BaseType_t xDying;
+
+	if( pxThreadToSuspend != pxThreadToResume )
+	{
+		/* The critical nesting count is per task, so save the value used by
+		the task being switched out on this thread's stack, and restore it when
+		the task is switched back in. */
+		uxSavedCriticalNesting = uxCriticalNesting;
+
+		/* A task that deleted itself has its Thread_t freed (along with its
+		stack) by the idle task, and the memory may even be reused by a new
+		task, as soon as the task being resumed runs - so the dying flag must
+		be read before the task being resumed is signalled. */
+		xDying = pxThreadToSuspend->xDying;
+
+		prvEventSignal( &( pxThreadToResume->xWakeEvent ) );
+
+		if( xDying != pdFALSE )
+		{
+			/* The task deleted itself, so its thread must never run again. */
+			pthread_exit( NULL );
+		}
+
+		prvEventWait( &( pxThreadToSuspend->xWakeEvent ) );
+
+		if( pxThreadToSuspend->xDying != pdFALSE )
+		{
+			/* The task was deleted by another task while it was switched
+			out - vPortCancelThread() woke it only so it can exit. */
+			pthread_exit( NULL );
+		}
+
+		uxCriticalNesting = uxSavedCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvYield( void )
+{
+Thread_t *pxThreadToSuspend, *pxThreadToResume;
+
+	pxThreadToSuspend = prvGetThreadFromTask( pxCurrentTCB );
+
+	/* Select the next task to run. */
+	vTaskSwitchContext();
+
+	pxThreadToResume = prvGetThreadFromTask( pxCurrentTCB );
+	prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickSignalHandler( int iSignal )
+{
+	( void ) iSignal;
+
+	/* The signal is only ever delivered to the thread of the Running state
+	task, and only when that task is not within a critical section. */
+	if( xPortRunning != pdFALSE )
+	{
+		/* Signals are blocked while the handler executes, so account for that
+		in the nesting count in case anything called from the handler uses a
+		critical section. */
+		uxCriticalNesting++;
+
+		if( xTaskIncrementTick() != pdFALSE )
+		{
+			prvYield();
+		}
+
+		uxCriticalNesting--;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupTimerInterrupt( void )
+{
+struct itimerval xTimer;
+const long lTickPeriodUs = ( long ) ( 1000000L / ( long ) configTICK_RATE_HZ );
+
+	configASSERT( lTickPeriodUs > 0L );
+
+	xTimer.it_interval.tv_sec = lTickPeriodUs / 1000000L;
+	xTimer.it_interval.tv_usec = lTickPeriodUs % 1000000L;
+	xTimer.it_value = xTimer.it_interval;
+
+	( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTimerInterrupt( void )
+{
+struct itimerval xTimer;
+
+	memset( &xTimer, 0x00, sizeof( xTimer ) );
+	( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseSignalMask( void )
+{
+	( void ) sigfillset( &xAllSignals );
+
+	/* Don't block SIGINT, so the simulation can always be stopped from the
+	console (or broken into from a debugger), even from within a critical
+	section. */
+	( void ) sigdelset( &xAllSignals, SIGINT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventInitialise( ThreadEvent_t *pxEvent )
+{
+	( void ) pthread_mutex_init( &( pxEvent->xMutex ), NULL );
+	( void ) pthread_cond_init( &( pxEvent->xCond ), NULL );
+	pxEvent->xTriggered = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventDelete( ThreadEvent_t *pxEvent )
+{
+	( void ) pthread_cond_destroy( &( pxEvent->xCond ) );
+	( void ) pthread_mutex_destroy( &( pxEvent->xMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventSignal( ThreadEvent_t *pxEvent )
+{
+	( void ) pthread_mutex_lock( &( pxEvent->xMutex ) );
+	pxEvent->xTriggered = pdTRUE;
+	( void ) pthread_cond_signal( &( pxEvent->xCond ) );
+	( void ) pthread_mutex_unlock( &( pxEvent->xMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventWait( ThreadEvent_t *pxEvent )
+{
+	( void ) pthread_mutex_lock( &( pxEvent->xMutex ) );
+
+	while( pxEvent->xTriggered == pdFALSE )
+	{
+		( void ) pthread_cond_wait( &( pxEvent->xCond ), &( pxEvent->xMutex ) );
+	}
+
+	pxEvent->xTriggered = pdFALSE;
+	( void ) pthread_mutex_unlock( &( pxEvent->xMutex ) );
+}
+/*-----------------------------------------------------------*/
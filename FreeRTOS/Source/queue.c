@@ -41,6 +41,14 @@ task.h is included from an application file. */
 	#include "croutine.h"
 #endif
 
+#if( configQUEUE_POOL_LENGTH > 0 )
+	#include "pool.h"
+#endif
+
+#if( configUSE_ASYNC_TASKS == 1 )
+	#include "async.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -51,6 +59,40 @@ privileged Vs unprivileged linkage and placement. */
 /* Constants used with the cRxLock and cTxLock structure members. */
 #define queueUNLOCKED					( ( int8_t ) -1 )
 #define queueLOCKED_UNMODIFIED			( ( int8_t ) 0 )
+#define queueINT8_MAX					( ( int8_t ) 127 )
+
+/* When configQUEUE_POOL_LENGTH is greater than zero dynamically allocated
+queues, semaphores and mutexes whose storage area is no larger than
+configQUEUE_POOL_STORAGE_BYTES are taken from the kernel's queue pool, and
+only come from the heap if the pool is empty. */
+#if( configQUEUE_POOL_LENGTH > 0 )
+	#define queueALLOCATE( xSize )		pvPoolAllocKernelObject( poolKERNEL_POOL_QUEUES, ( xSize ) )
+	#define queueFREE( pxQueue )		vPoolFreeKernelObject( poolKERNEL_POOL_QUEUES, ( void * ) ( pxQueue ) )
+#else
+	#define queueALLOCATE( xSize )		pvPortMalloc( xSize )
+	#define queueFREE( pxQueue )		vPortFree( pxQueue )
+#endif
+
+/* Async tasks wait for a queue in the queue's list of async tasks.  Unlike the
+event lists, the list is only accessed from critical sections, so async tasks
+are woken as soon as data or space becomes available, even if the queue is
+locked. */
+#if( configUSE_ASYNC_TASKS == 1 )
+	#define queueWAKE_ASYNC_TASKS( pxQueue, xEvent, uxMaxToWake )									\
+		if( listLIST_IS_EMPTY( &( ( pxQueue )->xAsyncTasksWaiting ) ) == pdFALSE )					\
+		{																							\
+			vAsyncTaskWakeWaiting( &( ( pxQueue )->xAsyncTasksWaiting ), ( xEvent ), ( uxMaxToWake ) );	\
+		}
+
+	#define queueWAKE_ASYNC_TASKS_FROM_ISR( pxQueue, xEvent, uxMaxToWake, pxHigherPriorityTaskWoken )	\
+		if( listLIST_IS_EMPTY( &( ( pxQueue )->xAsyncTasksWaiting ) ) == pdFALSE )					\
+		{																							\
+			vAsyncTaskWakeWaitingFromISR( &( ( pxQueue )->xAsyncTasksWaiting ), ( xEvent ), ( uxMaxToWake ), ( pxHigherPriorityTaskWoken ) );	\
+		}
+#else
+	#define queueWAKE_ASYNC_TASKS( pxQueue, xEvent, uxMaxToWake )
+	#define queueWAKE_ASYNC_TASKS_FROM_ISR( pxQueue, xEvent, uxMaxToWake, pxHigherPriorityTaskWoken )
+#endif /* configUSE_ASYNC_TASKS */
 
 /* When the Queue_t structure is used to represent a base queue its pcHead and
 pcTail members are used as pointers into the queue storage area.  When the
@@ -80,6 +122,24 @@ zero. */
 	#define queueYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if( configUSE_SPSC_QUEUES == 1 )
+	/* Single producer, single consumer queues do not maintain uxMessagesWaiting
+	as it would have to be updated by both the sender and the receiver.  Instead
+	the number of items is the difference between two counts that each only
+	have one writer. */
+	#define queueIS_SPSC( pxQueue )				( ( pxQueue )->ucIsSPSC != ( uint8_t ) pdFALSE )
+	#define queueMESSAGES_WAITING( pxQueue )	( queueIS_SPSC( pxQueue ) ? ( UBaseType_t ) ( ( pxQueue )->uxItemsWritten - ( pxQueue )->uxItemsRead ) : ( pxQueue )->uxMessagesWaiting )
+
+	/* After an item has been written to (read from) a single producer, single
+	consumer queue the event list of the other end of the queue is checked
+	without a critical section.  A task that is about to block locks the queue
+	before it checks the item counts, so is seen here even if it has not yet
+	been placed on the event list. */
+	#define queueSPSC_OTHER_END_MAY_BE_WAITING( pxEventList, cLock ) ( ( listLIST_IS_EMPTY( ( pxEventList ) ) == pdFALSE ) || ( ( cLock ) != queueUNLOCKED ) )
+#else
+	#define queueMESSAGES_WAITING( pxQueue )	( ( pxQueue )->uxMessagesWaiting )
+#endif /* configUSE_SPSC_QUEUES */
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -120,6 +180,20 @@ typedef struct QueueDefinition
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_SPSC_QUEUES == 1 )
+		volatile UBaseType_t uxItemsWritten;	/*< Single producer, single consumer queues only.  A free running count of the items written to the queue, only updated by the sender. */
+		volatile UBaseType_t uxItemsRead;		/*< Single producer, single consumer queues only.  A free running count of the items read from the queue, only updated by the receiver. */
+		uint8_t ucIsSPSC;						/*< Set to pdTRUE if the queue is a single producer, single consumer queue. */
+	#endif
+
+	#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+		ListItem_t xMutexHeldListItem;	/*< Mutexes only.  Placed in the list of mutexes held by the task that holds the mutex.  Its owner is xTasksWaitingToReceive. */
+	#endif
+
+	#if ( configUSE_ASYNC_TASKS == 1 )
+		List_t xAsyncTasksWaiting;		/*< List of async tasks that are waiting to send to or receive from the queue, in the order in which they started to wait. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -190,6 +264,37 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvIte
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies uxItemCount items to the back of a queue, or out of the front of a
+ * queue, using at most two memcpy() calls.  The caller must have checked the
+ * queue has space for (contains) that many items.
+ */
+static void prvCopyMultipleToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static void prvCopyMultipleFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks up to uxMaxTasks tasks waiting on pxEventList.  Called from a
+ * critical section when the queue is not locked, after items have been
+ * added to or removed from the queue.  Returns pdTRUE if any of the
+ * unblocked tasks has a priority above the calling task.
+ */
+static BaseType_t prvUnblockMultipleTasks( List_t * const pxEventList, UBaseType_t uxMaxTasks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wakes the tasks, or the queue set, waiting for the uxItemCount items just
+ * sent to the queue by uxQueueSendMultiple() or uxQueueSendMultipleFromISR().
+ * Returns pdTRUE if a task with a priority above the calling task was
+ * unblocked.
+ */
+static BaseType_t prvNotifyMultipleSent( Queue_t * const pxQueue, UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the lock count cLockCount increased by uxIncrement, saturating at
+ * queueINT8_MAX rather than wrapping.  Used when an interrupt sends or
+ * receives several items while the queue is locked.
+ */
+static int8_t prvIncrementLockCount( const int8_t cLockCount, const UBaseType_t uxIncrement ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
 	 * Checks to see if a queue is a member of a queue set, and if so, notifies
@@ -198,6 +303,61 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 #endif
 
+#if( configUSE_SPSC_QUEUES == 1 )
+	/*
+	 * The task and interrupt level send and receive functions used by single
+	 * producer, single consumer queues.  Items are copied without entering a
+	 * critical section, which is only entered when the caller has to block, or
+	 * has to unblock the task at the other end of the queue.
+	 */
+	static BaseType_t prvSPSCSend( Queue_t * const pxQueue, const void * const pvItemToQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvSPSCReceive( Queue_t * const pxQueue, void * const pvBuffer, TickType_t xTicksToWait, const BaseType_t xJustPeeking ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvSPSCSendFromISR( Queue_t * const pxQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvSPSCReceiveFromISR( Queue_t * const pxQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xJustPeeking ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return a pointer to the free slot the next item sent to a single
+	 * producer, single consumer queue will be written to, or NULL if the queue
+	 * is full.  prvSPSCPublishWrite() makes the item in that slot visible to
+	 * the receiver.
+	 */
+	static int8_t *prvSPSCGetWriteSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+	static void prvSPSCPublishWrite( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return a pointer to the slot holding the next item to be received from
+	 * a single producer, single consumer queue, or NULL if the queue is empty.
+	 * prvSPSCPublishRead() returns that slot to the sender.
+	 */
+	static int8_t *prvSPSCGetReadSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+	static void prvSPSCPublishRead( Queue_t * const pxQueue, int8_t * const pcSlot ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Unblock the task waiting on pxEventList, or if the queue is locked
+	 * increment the lock count pointed to by pcLock so the task that unlocks
+	 * the queue does it instead.  Must be called from a critical section.
+	 * Returns pdTRUE if the unblocked task has a priority above the calling
+	 * task.
+	 */
+	static BaseType_t prvSPSCUnblockWaitingTask( List_t * const pxEventList, volatile int8_t * const pcLock ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by one end of a single producer, single consumer queue after it
+	 * has changed the queue, to unblock the task waiting on pxEventList at the
+	 * other end of the queue, if there is one.
+	 */
+	static void prvSPSCWakeOtherEnd( List_t * const pxEventList, volatile int8_t * const pcLock ) PRIVILEGED_FUNCTION;
+	static void prvSPSCWakeOtherEndFromISR( List_t * const pxEventList, volatile int8_t * const pcLock, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Wait up to xTicksToWait for a free slot to write to (xWriting is pdTRUE)
+	 * or an item to read (xWriting is pdFALSE) in a single producer, single
+	 * consumer queue.  Returns a pointer to the slot, or NULL if the timeout
+	 * expired.
+	 */
+	static int8_t *prvSPSCWaitForSlot( Queue_t * const pxQueue, const BaseType_t xWriting, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -223,6 +383,26 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	 */
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	/*
+	 * Called from a critical section when the calling task is about to block
+	 * on a mutex.  The holder of the mutex inherits the calling task's
+	 * priority, and if the holder is itself blocked on a mutex then so does
+	 * the holder of that mutex, and so on along the chain of blocked mutex
+	 * holders for up to configMAX_INHERITANCE_CHAIN_LENGTH mutexes.  Returns
+	 * pdTRUE if any task along the chain has an inherited priority.
+	 */
+	static BaseType_t prvChainedPriorityInherit( const Queue_t * const pxMutex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from a critical section when the calling task has timed out
+	 * waiting for a mutex.  Recalculates the priority of every task along the
+	 * chain of blocked mutex holders that might have inherited the calling
+	 * task's priority.
+	 */
+	static void prvChainedPriorityDisinheritAfterTimeout( const Queue_t * const pxMutex ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -259,6 +439,13 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		pxQueue->cRxLock = queueUNLOCKED;
 		pxQueue->cTxLock = queueUNLOCKED;
 
+		#if( configUSE_SPSC_QUEUES == 1 )
+		{
+			pxQueue->uxItemsWritten = ( UBaseType_t ) 0U;
+			pxQueue->uxItemsRead = ( UBaseType_t ) 0U;
+		}
+		#endif /* configUSE_SPSC_QUEUES */
+
 		if( xNewQueue == pdFALSE )
 		{
 			/* If there are tasks blocked waiting to read from the queue, then
@@ -281,12 +468,20 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
+
+			queueWAKE_ASYNC_TASKS( pxQueue, asyncWAITING_TO_SEND, pxQueue->uxLength );
 		}
 		else
 		{
 			/* Ensure the event queues start in the correct state. */
 			vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
 			vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+
+			#if( configUSE_ASYNC_TASKS == 1 )
+			{
+				vListInitialise( &( pxQueue->xAsyncTasksWaiting ) );
+			}
+			#endif /* configUSE_ASYNC_TASKS */
 		}
 	}
 	taskEXIT_CRITICAL();
@@ -375,7 +570,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		}
 
-		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
+		pxNewQueue = ( Queue_t * ) queueALLOCATE( sizeof( Queue_t ) + xQueueSizeInBytes );
 
 		if( pxNewQueue != NULL )
 		{
@@ -443,6 +638,21 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_SPSC_QUEUES == 1 )
+	{
+		if( ucQueueType == queueQUEUE_TYPE_SPSC )
+		{
+			/* Single producer, single consumer queues must hold data. */
+			configASSERT( uxItemSize != ( UBaseType_t ) 0 );
+			pxNewQueue->ucIsSPSC = ( uint8_t ) pdTRUE;
+		}
+		else
+		{
+			pxNewQueue->ucIsSPSC = ( uint8_t ) pdFALSE;
+		}
+	}
+	#endif /* configUSE_SPSC_QUEUES */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -463,6 +673,16 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 			/* In case this is a recursive mutex. */
 			pxNewQueue->u.uxRecursiveCallCount = 0;
 
+			#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+			{
+				/* The holder's priority is calculated from the tasks waiting
+				for each mutex it holds, so the item placed in the holder's
+				list of held mutexes references the list of waiting tasks. */
+				vListInitialiseItem( &( pxNewQueue->xMutexHeldListItem ) );
+				listSET_LIST_ITEM_OWNER( &( pxNewQueue->xMutexHeldListItem ), &( pxNewQueue->xTasksWaitingToReceive ) );
+			}
+			#endif
+
 			traceCREATE_MUTEX( pxNewQueue );
 
 			/* Start with the semaphore in the expected state. */
@@ -737,6 +957,21 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	}
 	#endif
 
+	#if( configUSE_SPSC_QUEUES == 1 )
+	{
+		if( queueIS_SPSC( pxQueue ) )
+		{
+			/* Single producer, single consumer queues can only be written to
+			the back. */
+			configASSERT( xCopyPosition == queueSEND_TO_BACK );
+			return prvSPSCSend( pxQueue, pvItemToQueue, xTicksToWait );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_SPSC_QUEUES */
 
 	/* This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
@@ -753,6 +988,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			{
 				traceQUEUE_SEND( pxQueue );
 				xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+				queueWAKE_ASYNC_TASKS( pxQueue, asyncWAITING_TO_RECEIVE, 1 );
 
 				#if ( configUSE_QUEUE_SETS == 1 )
 				{
@@ -946,12 +1182,26 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
+	#if( configUSE_SPSC_QUEUES == 1 )
+	{
+		if( queueIS_SPSC( pxQueue ) )
+		{
+			configASSERT( xCopyPosition == queueSEND_TO_BACK );
+			return prvSPSCSendFromISR( pxQueue, pvItemToQueue, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_SPSC_QUEUES */
+
 	/* Similar to xQueueGenericSend, except without blocking if there is no room
 	in the queue.  Also don't directly wake a task that was blocked on a queue
 	read, instead return a flag to say whether a context switch is required or
 	not (i.e. has a task with a higher priority than us been woken by this
 	post). */
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
 		{
@@ -965,6 +1215,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			called here even though the disinherit function does not check if
 			the scheduler is suspended before accessing the ready lists. */
 			( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+			queueWAKE_ASYNC_TASKS_FROM_ISR( pxQueue, asyncWAITING_TO_RECEIVE, 1, pxHigherPriorityTaskWoken );
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1065,12 +1316,230 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			xReturn = errQUEUE_FULL;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+UBaseType_t uxItemsSent = 0, uxItemsToSend;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+const int8_t * const pcItems = ( const int8_t * ) pvItems;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+
+	/* Semaphores, mutexes and single producer, single consumer queues cannot
+	be written to in batches. */
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if( configUSE_SPSC_QUEUES == 1 )
+	{
+		configASSERT( !queueIS_SPSC( pxQueue ) );
+	}
+	#endif
+
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Send as many of the remaining items as there is space for, then
+			wake as many tasks as there are items, all within one critical
+			section. */
+			uxItemsToSend = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+			if( uxItemsToSend > ( uxItemCount - uxItemsSent ) )
+			{
+				uxItemsToSend = uxItemCount - uxItemsSent;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxItemsToSend > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_SEND( pxQueue );
+				prvCopyMultipleToQueue( pxQueue, &( pcItems[ uxItemsSent * pxQueue->uxItemSize ] ), uxItemsToSend );
+				queueWAKE_ASYNC_TASKS( pxQueue, asyncWAITING_TO_RECEIVE, uxItemsToSend );
+				uxItemsSent += uxItemsToSend;
+
+				if( prvNotifyMultipleSent( pxQueue, uxItemsToSend ) != pdFALSE )
+				{
+					/* An unblocked task has a priority higher than our own so
+					yield.  Yes it is ok to do this from within the critical
+					section - the kernel takes care of that. */
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxItemsSent == uxItemCount )
+			{
+				taskEXIT_CRITICAL();
+				return uxItemsSent;
+			}
+			else if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				/* The queue is full and no block time is specified (or the
+				block time has expired) so leave now. */
+				taskEXIT_CRITICAL();
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return uxItemsSent;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskInternalSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				/* Entry time was already set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet.  If it has
+		then xTicksToWait is set to zero so the loop makes one final attempt to
+		send the remaining items before returning. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxItemsSent;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if( configUSE_SPSC_QUEUES == 1 )
+	{
+		configASSERT( !queueIS_SPSC( pxQueue ) );
+	}
+	#endif
+
+	/* See the comments in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		uxItemsSent = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+		if( uxItemsSent > uxItemCount )
+		{
+			uxItemsSent = uxItemCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxItemsSent > ( UBaseType_t ) 0 )
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
+
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			prvCopyMultipleToQueue( pxQueue, ( const int8_t * ) pvItems, uxItemsSent );
+			queueWAKE_ASYNC_TASKS_FROM_ISR( pxQueue, asyncWAITING_TO_RECEIVE, uxItemsSent, pxHigherPriorityTaskWoken );
+
+			/* The event list is not altered if the queue is locked.  This will
+			be done when the queue is unlocked later. */
+			if( cTxLock == queueUNLOCKED )
+			{
+				if( ( prvNotifyMultipleSent( pxQueue, uxItemsSent ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Increment the lock count once per item so the task that
+				unlocks the queue knows how many items were posted while it
+				was locked.  A queue set is notified once per item when the
+				queue is unlocked, so the count must not saturate if the queue
+				is a member of a set. */
+				#if ( configUSE_QUEUE_SETS == 1 )
+				{
+					configASSERT( ( pxQueue->pxQueueSetContainer == NULL ) || ( uxItemsSent <= ( UBaseType_t ) ( queueINT8_MAX - cTxLock ) ) );
+				}
+				#endif /* configUSE_QUEUE_SETS */
+
+				pxQueue->cTxLock = prvIncrementLockCount( cTxLock, uxItemsSent );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxItemsSent < uxItemCount )
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxItemsSent;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
 {
 BaseType_t xReturn;
@@ -1110,7 +1579,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1130,6 +1599,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			priority disinheritance is needed.  Simply increase the count of
 			messages (semaphores) available. */
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+			queueWAKE_ASYNC_TASKS_FROM_ISR( pxQueue, asyncWAITING_TO_RECEIVE, 1, pxHigherPriorityTaskWoken );
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1230,7 +1700,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			xReturn = errQUEUE_FULL;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1256,6 +1726,18 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	}
 	#endif
 
+	#if( configUSE_SPSC_QUEUES == 1 )
+	{
+		if( queueIS_SPSC( pxQueue ) )
+		{
+			return prvSPSCReceive( pxQueue, pvBuffer, xTicksToWait, pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_SPSC_QUEUES */
 
 	/* This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
@@ -1275,6 +1757,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 				prvCopyDataFromQueue( pxQueue, pvBuffer );
 				traceQUEUE_RECEIVE( pxQueue );
 				pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+				queueWAKE_ASYNC_TASKS( pxQueue, asyncWAITING_TO_SEND, 1 );
 
 				/* There is now space in the queue, were any tasks waiting to
 				post to the queue?  If so, unblock the highest priority waiting
@@ -1424,6 +1907,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 				/* Semaphores are queues with a data size of zero and where the
 				messages waiting is the semaphore's count.  Reduce the count. */
 				pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+				queueWAKE_ASYNC_TASKS( pxQueue, asyncWAITING_TO_SEND, 1 );
 
 				#if ( configUSE_MUTEXES == 1 )
 				{
@@ -1432,7 +1916,13 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->pxMutexHolder = ( int8_t * ) pvTaskIncrementMutexHeldCount(); /*lint !e961 Cast is not redundant as TaskHandle_t is a typedef. */
-					}
+
+						#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+						{
+							vTaskAddHeldMutex( &( pxQueue->xMutexHeldListItem ) );
+						}
+						#endif
+					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
@@ -1519,7 +2009,16 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 					{
 						taskENTER_CRITICAL();
 						{
-							xInheritanceOccurred = xTaskPriorityInherit( ( void * ) pxQueue->pxMutexHolder );
+							#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+							{
+								vTaskSetBlockedOnMutex( ( void * ) pxQueue );
+								xInheritanceOccurred = prvChainedPriorityInherit( pxQueue );
+							}
+							#else
+							{
+								xInheritanceOccurred = xTaskPriorityInherit( ( void * ) pxQueue->pxMutexHolder );
+							}
+							#endif
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1561,7 +2060,29 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			queue being empty is equivalent to the semaphore count being 0. */
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
-				#if ( configUSE_MUTEXES == 1 )
+				#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+				{
+					/* The priority of this task might have been raised by
+					inheritance after it blocked, and passed along the chain
+					of mutex holders at that time, so the chain is checked
+					whether or not inheritance occurred when this task
+					blocked. */
+					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					{
+						taskENTER_CRITICAL();
+						{
+							prvChainedPriorityDisinheritAfterTimeout( pxQueue );
+						}
+						taskEXIT_CRITICAL();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					( void ) xInheritanceOccurred;
+				}
+				#elif ( configUSE_MUTEXES == 1 )
 				{
 					/* xInheritanceOccurred could only have be set if
 					pxQueue->uxQueueType == queueQUEUE_IS_MUTEX so no need to
@@ -1618,6 +2139,18 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	}
 	#endif
 
+	#if( configUSE_SPSC_QUEUES == 1 )
+	{
+		if( queueIS_SPSC( pxQueue ) )
+		{
+			return prvSPSCReceive( pxQueue, pvBuffer, xTicksToWait, pdTRUE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_SPSC_QUEUES */
 
 	/* This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
@@ -1772,7 +2305,20 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	#if( configUSE_SPSC_QUEUES == 1 )
+	{
+		if( queueIS_SPSC( pxQueue ) )
+		{
+			return prvSPSCReceiveFromISR( pxQueue, pvBuffer, pxHigherPriorityTaskWoken, pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_SPSC_QUEUES */
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1785,6 +2331,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
 			prvCopyDataFromQueue( pxQueue, pvBuffer );
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+			queueWAKE_ASYNC_TASKS_FROM_ISR( pxQueue, asyncWAITING_TO_SEND, 1, pxHigherPriorityTaskWoken );
 
 			/* If the queue is locked the event list will not be modified.
 			Instead update the lock count so the task that unlocks the queue
@@ -1832,7 +2379,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1865,7 +2412,20 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	#if( configUSE_SPSC_QUEUES == 1 )
+	{
+		if( queueIS_SPSC( pxQueue ) )
+		{
+			return prvSPSCReceiveFromISR( pxQueue, pvBuffer, NULL, pdTRUE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_SPSC_QUEUES */
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		/* Cannot block in an ISR, so check there is data available. */
 		if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
@@ -1886,186 +2446,1174 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait )
 {
-UBaseType_t uxReturn;
-
-	configASSERT( xQueue );
+BaseType_t xEntryTimeSet = pdFALSE;
+UBaseType_t uxItemsReceived;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
-	taskENTER_CRITICAL();
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if( configUSE_SPSC_QUEUES == 1 )
 	{
-		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+		configASSERT( !queueIS_SPSC( pxQueue ) );
 	}
-	taskEXIT_CRITICAL();
+	#endif
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
-Queue_t *pxQueue;
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			uxItemsReceived = pxQueue->uxMessagesWaiting;
+			if( uxItemsReceived > uxMaxItems )
+			{
+				uxItemsReceived = uxMaxItems;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-	pxQueue = ( Queue_t * ) xQueue;
-	configASSERT( pxQueue );
+			/* Return as soon as there is at least one item to receive. */
+			if( uxItemsReceived > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_RECEIVE( pxQueue );
+				prvCopyMultipleFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItemsReceived );
+				pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - uxItemsReceived;
+				queueWAKE_ASYNC_TASKS( pxQueue, asyncWAITING_TO_SEND, uxItemsReceived );
 
-	taskENTER_CRITICAL();
-	{
-		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-	}
-	taskEXIT_CRITICAL();
+				/* Each item removed makes space for one waiting task. */
+				if( prvUnblockMultipleTasks( &( pxQueue->xTasksWaitingToSend ), uxItemsReceived ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+				taskEXIT_CRITICAL();
+				return uxItemsReceived;
+			}
+			else
+			{
+				if( ( xTicksToWait == ( TickType_t ) 0 ) || ( uxMaxItems == ( UBaseType_t ) 0 ) )
+				{
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
 
-	configASSERT( xQueue );
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
 
-	uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to try and read
+				the data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* Timed out.  If there is no data in the queue exit, otherwise
+			loop back and attempt to read the data. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+}
 /*-----------------------------------------------------------*/
 
-void vQueueDelete( QueueHandle_t xQueue )
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
 {
+UBaseType_t uxItemsReceived;
+UBaseType_t uxSavedInterruptStatus;
 Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
 	configASSERT( pxQueue );
-	traceQUEUE_DELETE( pxQueue );
-
-	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if( configUSE_SPSC_QUEUES == 1 )
 	{
-		vQueueUnregisterQueue( pxQueue );
+		configASSERT( !queueIS_SPSC( pxQueue ) );
 	}
 	#endif
 
-	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-	{
-		/* The queue can only have been allocated dynamically - free it
-		again. */
-		vPortFree( pxQueue );
-	}
-	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	/* See the comments in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
-		/* The queue could have been allocated statically or dynamically, so
-		check before attempting to free the memory. */
-		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		uxItemsReceived = pxQueue->uxMessagesWaiting;
+		if( uxItemsReceived > uxMaxItems )
 		{
-			vPortFree( pxQueue );
+			uxItemsReceived = uxMaxItems;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		if( uxItemsReceived > ( UBaseType_t ) 0 )
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+			prvCopyMultipleFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItemsReceived );
+			pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - uxItemsReceived;
+			queueWAKE_ASYNC_TASKS_FROM_ISR( pxQueue, asyncWAITING_TO_SEND, uxItemsReceived, pxHigherPriorityTaskWoken );
+
+			/* If the queue is locked the event list will not be modified.
+			Instead update the lock count so the task that unlocks the queue
+			will know that items were removed while it was locked. */
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( ( prvUnblockMultipleTasks( &( pxQueue->xTasksWaitingToSend ), uxItemsReceived ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cRxLock = prvIncrementLockCount( cRxLock, uxItemsReceived );
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
 	}
-	#else
-	{
-		/* The queue must have been statically allocated, so is not going to be
-		deleted.  Avoid compiler warnings about the unused parameter. */
-		( void ) pxQueue;
-	}
-	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxItemsReceived;
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if( configUSE_SPSC_QUEUES == 1 )
 
-	UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+	BaseType_t xQueueReserve( QueueHandle_t xQueue, void ** const ppvSlot, TickType_t xTicksToWait )
 	{
-		return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-	}
+	BaseType_t xReturn;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+		configASSERT( pxQueue );
+		configASSERT( ppvSlot );
+		configASSERT( queueIS_SPSC( pxQueue ) );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+		/* Cannot block if the scheduler is suspended. */
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
 
-	void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber )
-	{
-		( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+		*ppvSlot = ( void * ) prvSPSCWaitForSlot( pxQueue, pdTRUE, xTicksToWait );
+
+		if( *ppvSlot != NULL )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			traceQUEUE_SEND_FAILED( pxQueue );
+			xReturn = errQUEUE_FULL;
+		}
+
+		return xReturn;
 	}
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_SPSC_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if( configUSE_SPSC_QUEUES == 1 )
 
-	uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+	void vQueueCommit( QueueHandle_t xQueue )
 	{
-		return ( ( Queue_t * ) xQueue )->ucQueueType;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( queueIS_SPSC( pxQueue ) );
+
+		/* The reserved slot is still free as only the caller writes to the
+		queue. */
+		configASSERT( ( UBaseType_t ) ( pxQueue->uxItemsWritten - pxQueue->uxItemsRead ) < pxQueue->uxLength );
+
+		prvSPSCPublishWrite( pxQueue );
+		traceQUEUE_SEND( pxQueue );
+		prvSPSCWakeOtherEnd( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->cTxLock ) );
 	}
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	BaseType_t xQueuePeekAcquire( QueueHandle_t xQueue, void ** const ppvItem, TickType_t xTicksToWait )
+	{
+	BaseType_t xReturn;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( ppvItem );
+		configASSERT( queueIS_SPSC( pxQueue ) );
+
+		/* Cannot block if the scheduler is suspended. */
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		*ppvItem = ( void * ) prvSPSCWaitForSlot( pxQueue, pdFALSE, xTicksToWait );
+
+		if( *ppvItem != NULL )
+		{
+			traceQUEUE_PEEK( pxQueue );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			traceQUEUE_PEEK_FAILED( pxQueue );
+			xReturn = errQUEUE_EMPTY;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	void vQueueRelease( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+	int8_t *pcSlot;
+
+		configASSERT( pxQueue );
+		configASSERT( queueIS_SPSC( pxQueue ) );
+
+		/* The acquired item is still at the front of the queue as only the
+		caller reads from the queue. */
+		pcSlot = prvSPSCGetReadSlot( pxQueue );
+		configASSERT( pcSlot );
+
+		prvSPSCPublishRead( pxQueue, pcSlot );
+		traceQUEUE_RECEIVE( pxQueue );
+		prvSPSCWakeOtherEnd( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->cRxLock ) );
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	BaseType_t xQueueReserveFromISR( QueueHandle_t xQueue, void ** const ppvSlot )
+	{
+	BaseType_t xReturn;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( ppvSlot );
+		configASSERT( queueIS_SPSC( pxQueue ) );
+
+		*ppvSlot = ( void * ) prvSPSCGetWriteSlot( pxQueue );
+
+		if( *ppvSlot != NULL )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			xReturn = errQUEUE_FULL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	void vQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( queueIS_SPSC( pxQueue ) );
+		configASSERT( ( UBaseType_t ) ( pxQueue->uxItemsWritten - pxQueue->uxItemsRead ) < pxQueue->uxLength );
+
+		prvSPSCPublishWrite( pxQueue );
+		traceQUEUE_SEND_FROM_ISR( pxQueue );
+		prvSPSCWakeOtherEndFromISR( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->cTxLock ), pxHigherPriorityTaskWoken );
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	BaseType_t xQueuePeekAcquireFromISR( QueueHandle_t xQueue, void ** const ppvItem )
+	{
+	BaseType_t xReturn;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( ppvItem );
+		configASSERT( queueIS_SPSC( pxQueue ) );
+
+		*ppvItem = ( void * ) prvSPSCGetReadSlot( pxQueue );
+
+		if( *ppvItem != NULL )
+		{
+			traceQUEUE_PEEK_FROM_ISR( pxQueue );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	void vQueueReleaseFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+	int8_t *pcSlot;
+
+		configASSERT( pxQueue );
+		configASSERT( queueIS_SPSC( pxQueue ) );
+
+		pcSlot = prvSPSCGetReadSlot( pxQueue );
+		configASSERT( pcSlot );
+
+		prvSPSCPublishRead( pxQueue, pcSlot );
+		traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+		prvSPSCWakeOtherEndFromISR( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->cRxLock ), pxHigherPriorityTaskWoken );
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = queueMESSAGES_WAITING( ( Queue_t * ) xQueue );
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+Queue_t *pxQueue;
+
+	pxQueue = ( Queue_t * ) xQueue;
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = pxQueue->uxLength - queueMESSAGES_WAITING( pxQueue );
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xQueue );
+
+	uxReturn = queueMESSAGES_WAITING( ( Queue_t * ) xQueue );
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	traceQUEUE_DELETE( pxQueue );
+
+	#if( configUSE_ASYNC_TASKS == 1 )
+	{
+		/* A queue must not be deleted while async tasks are waiting for it. */
+		configASSERT( listLIST_IS_EMPTY( &( pxQueue->xAsyncTasksWaiting ) ) != pdFALSE );
+	}
+	#endif /* configUSE_ASYNC_TASKS */
+
+	#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	{
+		/* A mutex should not be deleted while it is held, but if it is then
+		do not leave it in the holder's list of held mutexes. */
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( listLIST_ITEM_CONTAINER( &( pxQueue->xMutexHeldListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxQueue->xMutexHeldListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	{
+		vQueueUnregisterQueue( pxQueue );
+	}
+	#endif
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The queue can only have been allocated dynamically - free it
+		again. */
+		queueFREE( pxQueue );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The queue could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			queueFREE( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* The queue must have been statically allocated, so is not going to be
+		deleted.  Avoid compiler warnings about the unused parameter. */
+		( void ) pxQueue;
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+	{
+		return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber )
+	{
+		( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+	{
+		return ( ( Queue_t * ) xQueue )->ucQueueType;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
 #if( configUSE_MUTEXES == 1 )
 
-	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+	{
+	UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+		/* If a task waiting for a mutex causes the mutex holder to inherit a
+		priority, but the waiting task times out, then the holder should
+		disinherit the priority - but only down to the highest priority of any
+		other tasks that are waiting for the same mutex.  For this purpose,
+		return the priority of the highest priority task that is waiting for the
+		mutex. */
+		if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0 )
+		{
+			uxHighestPriorityOfWaitingTasks = configMAX_PRIORITIES - listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+		}
+		else
+		{
+			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+		}
+
+		return uxHighestPriorityOfWaitingTasks;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static BaseType_t prvChainedPriorityInherit( const Queue_t * const pxMutex )
+	{
+	const void * const pvCurrentTask = ( void * ) xTaskGetCurrentTaskHandle();
+	const Queue_t *pxBlockedOnMutex = pxMutex;
+	void *pvMutexHolder = ( void * ) pxMutex->pxMutexHolder;
+	BaseType_t xInheritanceOccurred = pdFALSE;
+	UBaseType_t uxChainLength;
+
+		/* Follow the chain until reaching a holder that is not blocked on a
+		mutex.  The chain length is limited to bound the time spent in the
+		critical section, and the chain can only lead back to the calling task
+		if the tasks along it are deadlocked. */
+		for( uxChainLength = ( UBaseType_t ) 0; ( uxChainLength < ( UBaseType_t ) configMAX_INHERITANCE_CHAIN_LENGTH ) && ( pvMutexHolder != NULL ) && ( pvMutexHolder != pvCurrentTask ); uxChainLength++ )
+		{
+			if( xTaskPriorityInherit( ( TaskHandle_t ) pvMutexHolder ) != pdFALSE )
+			{
+				xInheritanceOccurred = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxBlockedOnMutex = ( const Queue_t * ) pvTaskGetBlockedOnMutex( ( TaskHandle_t ) pvMutexHolder );
+
+			if( pxBlockedOnMutex != NULL )
+			{
+				pvMutexHolder = ( void * ) pxBlockedOnMutex->pxMutexHolder;
+			}
+			else
+			{
+				pvMutexHolder = NULL;
+			}
+		}
+
+		return xInheritanceOccurred;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static void prvChainedPriorityDisinheritAfterTimeout( const Queue_t * const pxMutex )
+	{
+	const void * const pvCurrentTask = ( void * ) xTaskGetCurrentTaskHandle();
+	const Queue_t *pxBlockedOnMutex = pxMutex;
+	void *pvMutexHolder = ( void * ) pxMutex->pxMutexHolder;
+	UBaseType_t uxChainLength;
+
+		/* Each holder along the chain has its priority recalculated from the
+		mutexes it holds.  A holder that moves down the list of tasks waiting
+		for the next mutex can lower the priority of the next holder in turn. */
+		for( uxChainLength = ( UBaseType_t ) 0; ( uxChainLength < ( UBaseType_t ) configMAX_INHERITANCE_CHAIN_LENGTH ) && ( pvMutexHolder != NULL ) && ( pvMutexHolder != pvCurrentTask ); uxChainLength++ )
+		{
+			vTaskPriorityDisinheritAfterTimeout( ( TaskHandle_t ) pvMutexHolder, prvGetDisinheritPriorityAfterTimeout( pxBlockedOnMutex ) );
+
+			pxBlockedOnMutex = ( const Queue_t * ) pvTaskGetBlockedOnMutex( ( TaskHandle_t ) pvMutexHolder );
+
+			if( pxBlockedOnMutex != NULL )
+			{
+				pvMutexHolder = ( void * ) pxBlockedOnMutex->pxMutexHolder;
+			}
+			else
+			{
+				pvMutexHolder = NULL;
+			}
+		}
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+{
+BaseType_t xReturn = pdFALSE;
+UBaseType_t uxMessagesWaiting;
+
+	/* This function is called from a critical section. */
+
+	uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+	if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+	{
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+			{
+				#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+				{
+					/* Remove the mutex from the holder's list of held mutexes
+					before the holder's priority is recalculated.  The mutex
+					is not held when it is first given by prvInitialiseMutex(),
+					or if it was taken before any tasks were created. */
+					if( listLIST_ITEM_CONTAINER( &( pxQueue->xMutexHeldListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxQueue->xMutexHeldListItem ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
+
+				/* The mutex is no longer being held. */
+				xReturn = xTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
+				pxQueue->pxMutexHolder = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_MUTEXES */
+	}
+	else if( xPosition == queueSEND_TO_BACK )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+		pxQueue->pcWriteTo += pxQueue->uxItemSize;
+		if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pxQueue->u.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->u.pcReadFrom -= pxQueue->uxItemSize;
+		if( pxQueue->u.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->u.pcReadFrom = ( pxQueue->pcTail - pxQueue->uxItemSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xPosition == queueOVERWRITE )
+		{
+			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				/* An item is not being added but overwritten, so subtract
+				one from the recorded number of items in the queue so when
+				one is added again below the number of recorded items remains
+				correct. */
+				--uxMessagesWaiting;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
+{
+	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+	{
+		pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
+		if( pxQueue->u.pcReadFrom >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		{
+			pxQueue->u.pcReadFrom = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyMultipleToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxItemCount )
+{
+size_t xBytes, xBytesToTail;
+
+	xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+	xBytesToTail = ( size_t ) ( pxQueue->pcTail - pxQueue->pcWriteTo ); /*lint !e946 !e9033 MISRA exception justified as pointer subtraction is the cleanest solution. */
+
+	if( xBytes >= xBytesToTail )
+	{
+		/* The items wrap around the end of the storage area. */
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytesToTail ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+		( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( pcItems[ xBytesToTail ] ), xBytes - xBytesToTail ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xBytesToTail );
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytes ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->pcWriteTo += xBytes;
+	}
+
+	pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyMultipleFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxItemCount )
+{
+size_t xBytes, xBytesToTail;
+int8_t *pcReadFrom;
+
+	/* u.pcReadFrom points to the last item read, so the first item to read
+	is the one after it. */
+	pcReadFrom = pxQueue->u.pcReadFrom + pxQueue->uxItemSize;
+	if( pcReadFrom >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+	{
+		pcReadFrom = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+	xBytesToTail = ( size_t ) ( pxQueue->pcTail - pcReadFrom ); /*lint !e946 !e9033 MISRA exception justified as pointer subtraction is the cleanest solution. */
+
+	if( xBytes > xBytesToTail )
+	{
+		/* The items wrap around the end of the storage area. */
+		( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcReadFrom, xBytesToTail ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+		( void ) memcpy( ( void * ) &( pcBuffer[ xBytesToTail ] ), ( void * ) pxQueue->pcHead, xBytes - xBytesToTail ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+		pcReadFrom = pxQueue->pcHead + ( xBytes - xBytesToTail );
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcReadFrom, xBytes ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+		pcReadFrom += xBytes;
+	}
+
+	/* Leave u.pcReadFrom pointing to the last item read, as
+	prvCopyDataFromQueue() does. */
+	pxQueue->u.pcReadFrom = pcReadFrom - pxQueue->uxItemSize;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockMultipleTasks( List_t * const pxEventList, UBaseType_t uxMaxTasks )
+{
+BaseType_t xReturn = pdFALSE;
+
+	while( ( uxMaxTasks > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxMaxTasks--;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static int8_t prvIncrementLockCount( const int8_t cLockCount, const UBaseType_t uxIncrement )
+{
+int8_t cReturn;
+
+	/* The lock count is the number of tasks to unblock when the queue is
+	unlocked.  prvUnlockQueue() stops as soon as no tasks are waiting, so
+	saturating the count does not lose a wake unless more than queueINT8_MAX
+	tasks are waiting. */
+	configASSERT( cLockCount >= queueLOCKED_UNMODIFIED );
+
+	if( uxIncrement >= ( UBaseType_t ) ( queueINT8_MAX - cLockCount ) )
+	{
+		cReturn = queueINT8_MAX;
+	}
+	else
+	{
+		cReturn = ( int8_t ) ( cLockCount + ( int8_t ) uxIncrement );
+	}
+
+	return cReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvNotifyMultipleSent( Queue_t * const pxQueue, UBaseType_t uxItemCount )
+{
+BaseType_t xReturn = pdFALSE;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			/* The queue set holds one event per item in its member queues. */
+			while( uxItemCount > ( UBaseType_t ) 0 )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				uxItemCount--;
+			}
+		}
+		else
+		{
+			/* Each item can satisfy one waiting task. */
+			xReturn = prvUnblockMultipleTasks( &( pxQueue->xTasksWaitingToReceive ), uxItemCount );
+		}
+	}
+	#else /* configUSE_QUEUE_SETS */
+	{
+		xReturn = prvUnblockMultipleTasks( &( pxQueue->xTasksWaitingToReceive ), uxItemCount );
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnlockQueue( Queue_t * const pxQueue )
+{
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+
+	/* The lock counts contains the number of extra data items placed or
+	removed from the queue while the queue was locked.  When a queue is
+	locked items can be added or removed, but the event lists cannot be
+	updated. */
+	taskENTER_CRITICAL();
+	{
+		int8_t cTxLock = pxQueue->cTxLock;
+
+		/* See if data was added to the queue while it was locked. */
+		while( cTxLock > queueLOCKED_UNMODIFIED )
+		{
+			/* Data was posted while the queue was locked.  Are any tasks
+			blocked waiting for data to become available? */
+			#if ( configUSE_QUEUE_SETS == 1 )
+			{
+				if( pxQueue->pxQueueSetContainer != NULL )
+				{
+					if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+					{
+						/* The queue is a member of a queue set, and posting to
+						the queue set caused a higher priority task to unblock.
+						A context switch is required. */
+						vTaskMissedYield();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Tasks that are removed from the event list will get
+					added to the pending ready list as the scheduler is still
+					suspended. */
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+						{
+							/* The task waiting has a higher priority so record that a
+							context	switch is required. */
+							vTaskMissedYield();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						break;
+					}
+				}
+			}
+			#else /* configUSE_QUEUE_SETS */
+			{
+				/* Tasks that are removed from the event list will get added to
+				the pending ready list as the scheduler is still suspended. */
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					{
+						/* The task waiting has a higher priority so record that
+						a context switch is required. */
+						vTaskMissedYield();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					break;
+				}
+			}
+			#endif /* configUSE_QUEUE_SETS */
+
+			--cTxLock;
+		}
+
+		pxQueue->cTxLock = queueUNLOCKED;
+	}
+	taskEXIT_CRITICAL();
+
+	/* Do the same for the Rx lock. */
+	taskENTER_CRITICAL();
 	{
-	UBaseType_t uxHighestPriorityOfWaitingTasks;
+		int8_t cRxLock = pxQueue->cRxLock;
 
-		/* If a task waiting for a mutex causes the mutex holder to inherit a
-		priority, but the waiting task times out, then the holder should
-		disinherit the priority - but only down to the highest priority of any
-		other tasks that are waiting for the same mutex.  For this purpose,
-		return the priority of the highest priority task that is waiting for the
-		mutex. */
-		if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0 )
+		while( cRxLock > queueLOCKED_UNMODIFIED )
 		{
-			uxHighestPriorityOfWaitingTasks = configMAX_PRIORITIES - listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+				{
+					vTaskMissedYield();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				--cRxLock;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		pxQueue->cRxLock = queueUNLOCKED;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsQueueEmpty( const Queue_t *pxQueue )
+{
+BaseType_t xReturn;
+
+	taskENTER_CRITICAL();
+	{
+		if( queueMESSAGES_WAITING( pxQueue ) == ( UBaseType_t )  0 )
+		{
+			xReturn = pdTRUE;
 		}
 		else
 		{
-			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+			xReturn = pdFALSE;
 		}
+	}
+	taskEXIT_CRITICAL();
 
-		return uxHighestPriorityOfWaitingTasks;
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
+{
+BaseType_t xReturn;
+
+	configASSERT( xQueue );
+	if( queueMESSAGES_WAITING( ( Queue_t * ) xQueue ) == ( UBaseType_t ) 0 )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
 	}
 
-#endif /* configUSE_MUTEXES */
+	return xReturn;
+} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+static BaseType_t prvIsQueueFull( const Queue_t *pxQueue )
 {
-BaseType_t xReturn = pdFALSE;
-UBaseType_t uxMessagesWaiting;
+BaseType_t xReturn;
 
-	/* This function is called from a critical section. */
+	taskENTER_CRITICAL();
+	{
+		if( queueMESSAGES_WAITING( pxQueue ) == pxQueue->uxLength )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+	}
+	taskEXIT_CRITICAL();
 
-	uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
 
-	if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
+{
+BaseType_t xReturn;
+
+	configASSERT( xQueue );
+	if( queueMESSAGES_WAITING( ( Queue_t * ) xQueue ) == ( ( Queue_t * ) xQueue )->uxLength )
 	{
-		#if ( configUSE_MUTEXES == 1 )
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static int8_t *prvSPSCGetWriteSlot( Queue_t * const pxQueue )
+	{
+	int8_t *pcSlot;
+
+		/* Only the sender updates uxItemsWritten and pcWriteTo, so they can be
+		accessed without a critical section.  If the receiver updates
+		uxItemsRead while it is being read the queue just looks fuller than it
+		is. */
+		if( ( UBaseType_t ) ( pxQueue->uxItemsWritten - pxQueue->uxItemsRead ) < pxQueue->uxLength )
 		{
-			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
-			{
-				/* The mutex is no longer being held. */
-				xReturn = xTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
-				pxQueue->pxMutexHolder = NULL;
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+			/* Don't write to the free slot until the receiver has finished
+			reading from it. */
+			portMEMORY_BARRIER();
+			pcSlot = pxQueue->pcWriteTo;
 		}
-		#endif /* configUSE_MUTEXES */
+		else
+		{
+			pcSlot = NULL;
+		}
+
+		return pcSlot;
 	}
-	else if( xPosition == queueSEND_TO_BACK )
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static void prvSPSCPublishWrite( Queue_t * const pxQueue )
 	{
-		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
 		pxQueue->pcWriteTo += pxQueue->uxItemSize;
 		if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
 		{
@@ -2075,29 +3623,120 @@ UBaseType_t uxMessagesWaiting;
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		/* The item must be in the queue before the receiver can see it, and
+		the receiver can see it before the caller checks whether the receiver
+		is blocked. */
+		portMEMORY_BARRIER();
+		pxQueue->uxItemsWritten = pxQueue->uxItemsWritten + ( UBaseType_t ) 1;
+		portMEMORY_BARRIER();
 	}
-	else
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static int8_t *prvSPSCGetReadSlot( Queue_t * const pxQueue )
 	{
-		( void ) memcpy( ( void * ) pxQueue->u.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-		pxQueue->u.pcReadFrom -= pxQueue->uxItemSize;
-		if( pxQueue->u.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+	int8_t *pcSlot;
+
+		/* Only the receiver updates uxItemsRead and pcReadFrom, so they can be
+		accessed without a critical section.  If the sender updates
+		uxItemsWritten while it is being read the queue just looks emptier than
+		it is. */
+		if( pxQueue->uxItemsWritten != pxQueue->uxItemsRead )
 		{
-			pxQueue->u.pcReadFrom = ( pxQueue->pcTail - pxQueue->uxItemSize );
+			/* Don't read the item before it was seen to be in the queue. */
+			portMEMORY_BARRIER();
+
+			pcSlot = pxQueue->u.pcReadFrom + pxQueue->uxItemSize;
+			if( pcSlot >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+			{
+				pcSlot = pxQueue->pcHead;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			pcSlot = NULL;
 		}
 
-		if( xPosition == queueOVERWRITE )
+		return pcSlot;
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static void prvSPSCPublishRead( Queue_t * const pxQueue, int8_t * const pcSlot )
+	{
+		/* The item must have been finished with before the sender can reuse
+		its slot, and the sender can reuse the slot before the caller checks
+		whether the sender is blocked. */
+		pxQueue->u.pcReadFrom = pcSlot;
+		portMEMORY_BARRIER();
+		pxQueue->uxItemsRead = pxQueue->uxItemsRead + ( UBaseType_t ) 1;
+		portMEMORY_BARRIER();
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static BaseType_t prvSPSCUnblockWaitingTask( List_t * const pxEventList, volatile int8_t * const pcLock )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		if( *pcLock == queueUNLOCKED )
 		{
-			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
 			{
-				/* An item is not being added but overwritten, so subtract
-				one from the recorded number of items in the queue so when
-				one is added again below the number of recorded items remains
-				correct. */
-				--uxMessagesWaiting;
+				xReturn = xTaskRemoveFromEventList( pxEventList );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* The task at the other end of the queue is in the process of
+			blocking.  Increment the lock count so it is unblocked when the
+			queue is unlocked. */
+			*pcLock = ( int8_t ) ( *pcLock + 1 );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static void prvSPSCWakeOtherEnd( List_t * const pxEventList, volatile int8_t * const pcLock )
+	{
+	BaseType_t xYieldRequired;
+
+		/* Only enter a critical section if the task at the other end of the
+		queue might be waiting. */
+		if( queueSPSC_OTHER_END_MAY_BE_WAITING( pxEventList, *pcLock ) )
+		{
+			taskENTER_CRITICAL();
+			{
+				xYieldRequired = prvSPSCUnblockWaitingTask( pxEventList, pcLock );
+			}
+			taskEXIT_CRITICAL();
+
+			if( xYieldRequired != pdFALSE )
+			{
+				queueYIELD_IF_USING_PREEMPTION();
 			}
 			else
 			{
@@ -2110,98 +3749,124 @@ UBaseType_t uxMessagesWaiting;
 		}
 	}
 
-	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
-
-	return xReturn;
-}
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static void prvSPSCWakeOtherEndFromISR( List_t * const pxEventList, volatile int8_t * const pcLock, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		if( queueSPSC_OTHER_END_MAY_BE_WAITING( pxEventList, *pcLock ) )
+		{
+			uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+			{
+				if( ( prvSPSCUnblockWaitingTask( pxEventList, pcLock ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
-{
-	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static int8_t *prvSPSCWaitForSlot( Queue_t * const pxQueue, const BaseType_t xWriting, TickType_t xTicksToWait )
 	{
-		pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
-		if( pxQueue->u.pcReadFrom >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+	int8_t *pcSlot;
+	BaseType_t xEntryTimeSet = pdFALSE, xMustBlock;
+	TimeOut_t xTimeOut;
+	List_t *pxEventList;
+
+		if( xWriting != pdFALSE )
 		{
-			pxQueue->u.pcReadFrom = pxQueue->pcHead;
+			pxEventList = &( pxQueue->xTasksWaitingToSend );
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			pxEventList = &( pxQueue->xTasksWaitingToReceive );
 		}
-		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
-	}
-}
-/*-----------------------------------------------------------*/
 
-static void prvUnlockQueue( Queue_t * const pxQueue )
-{
-	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+		for( ;; )
+		{
+			if( xWriting != pdFALSE )
+			{
+				pcSlot = prvSPSCGetWriteSlot( pxQueue );
+			}
+			else
+			{
+				pcSlot = prvSPSCGetReadSlot( pxQueue );
+			}
 
-	/* The lock counts contains the number of extra data items placed or
-	removed from the queue while the queue was locked.  When a queue is
-	locked items can be added or removed, but the event lists cannot be
-	updated. */
-	taskENTER_CRITICAL();
-	{
-		int8_t cTxLock = pxQueue->cTxLock;
+			if( pcSlot != NULL )
+			{
+				break;
+			}
+			else if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				/* The queue was full (empty) and either no block time was
+				specified or the block time has expired. */
+				break;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-		/* See if data was added to the queue while it was locked. */
-		while( cTxLock > queueLOCKED_UNMODIFIED )
-		{
-			/* Data was posted while the queue was locked.  Are any tasks
-			blocked waiting for data to become available? */
-			#if ( configUSE_QUEUE_SETS == 1 )
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet.  If it
+			has then xTicksToWait is set to zero, so one final attempt is made
+			to access the queue. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
 			{
-				if( pxQueue->pxQueueSetContainer != NULL )
+				/* The queue is locked, so if the task at the other end of the
+				queue changes the queue after this check it will unblock this
+				task when the queue is unlocked. */
+				if( xWriting != pdFALSE )
 				{
-					if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
-					{
-						/* The queue is a member of a queue set, and posting to
-						the queue set caused a higher priority task to unblock.
-						A context switch is required. */
-						vTaskMissedYield();
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+					xMustBlock = prvIsQueueFull( pxQueue );
 				}
 				else
 				{
-					/* Tasks that are removed from the event list will get
-					added to the pending ready list as the scheduler is still
-					suspended. */
-					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					xMustBlock = prvIsQueueEmpty( pxQueue );
+				}
+
+				if( xMustBlock != pdFALSE )
+				{
+					if( xWriting != pdFALSE )
 					{
-						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-						{
-							/* The task waiting has a higher priority so record that a
-							context	switch is required. */
-							vTaskMissedYield();
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
+						traceBLOCKING_ON_QUEUE_SEND( pxQueue );
 					}
 					else
 					{
-						break;
+						traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
 					}
-				}
-			}
-			#else /* configUSE_QUEUE_SETS */
-			{
-				/* Tasks that are removed from the event list will get added to
-				the pending ready list as the scheduler is still suspended. */
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+
+					vTaskPlaceOnEventList( pxEventList, xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
 					{
-						/* The task waiting has a higher priority so record that
-						a context switch is required. */
-						vTaskMissedYield();
+						portYIELD_WITHIN_API();
 					}
 					else
 					{
@@ -2210,126 +3875,172 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 				}
 				else
 				{
-					break;
+					/* The queue changed.  Loop back to try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
 				}
 			}
-			#endif /* configUSE_QUEUE_SETS */
+			else
+			{
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
 
-			--cTxLock;
+		return pcSlot;
+	}
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static BaseType_t prvSPSCSend( Queue_t * const pxQueue, const void * const pvItemToQueue, TickType_t xTicksToWait )
+	{
+	int8_t *pcSlot;
+	BaseType_t xReturn;
+
+		pcSlot = prvSPSCWaitForSlot( pxQueue, pdTRUE, xTicksToWait );
+
+		if( pcSlot != NULL )
+		{
+			( void ) memcpy( ( void * ) pcSlot, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+			prvSPSCPublishWrite( pxQueue );
+			traceQUEUE_SEND( pxQueue );
+			prvSPSCWakeOtherEnd( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->cTxLock ) );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			traceQUEUE_SEND_FAILED( pxQueue );
+			xReturn = errQUEUE_FULL;
 		}
 
-		pxQueue->cTxLock = queueUNLOCKED;
+		return xReturn;
 	}
-	taskEXIT_CRITICAL();
 
-	/* Do the same for the Rx lock. */
-	taskENTER_CRITICAL();
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_SPSC_QUEUES == 1 )
+
+	static BaseType_t prvSPSCReceive( Queue_t * const pxQueue, void * const pvBuffer, TickType_t xTicksToWait, const BaseType_t xJustPeeking )
 	{
-		int8_t cRxLock = pxQueue->cRxLock;
+	int8_t *pcSlot;
+	BaseType_t xReturn;
 
-		while( cRxLock > queueLOCKED_UNMODIFIED )
+		pcSlot = prvSPSCWaitForSlot( pxQueue, pdFALSE, xTicksToWait );
+
+		if( pcSlot != NULL )
 		{
-			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+			( void ) memcpy( ( void * ) pvBuffer, ( void * ) pcSlot, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
+
+			if( xJustPeeking == pdFALSE )
 			{
-				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-				{
-					vTaskMissedYield();
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
+				prvSPSCPublishRead( pxQueue, pcSlot );
+				traceQUEUE_RECEIVE( pxQueue );
+				prvSPSCWakeOtherEnd( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->cRxLock ) );
+			}
+			else
+			{
+				traceQUEUE_PEEK( pxQueue );
+			}
 
-				--cRxLock;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			if( xJustPeeking == pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
 			}
 			else
 			{
-				break;
+				traceQUEUE_PEEK_FAILED( pxQueue );
 			}
+
+			xReturn = errQUEUE_EMPTY;
 		}
 
-		pxQueue->cRxLock = queueUNLOCKED;
+		return xReturn;
 	}
-	taskEXIT_CRITICAL();
-}
+
+#endif /* configUSE_SPSC_QUEUES */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueEmpty( const Queue_t *pxQueue )
-{
-BaseType_t xReturn;
+#if( configUSE_SPSC_QUEUES == 1 )
 
-	taskENTER_CRITICAL();
+	static BaseType_t prvSPSCSendFromISR( Queue_t * const pxQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken )
 	{
-		if( pxQueue->uxMessagesWaiting == ( UBaseType_t )  0 )
+	int8_t *pcSlot;
+	BaseType_t xReturn;
+
+		pcSlot = prvSPSCGetWriteSlot( pxQueue );
+
+		if( pcSlot != NULL )
 		{
-			xReturn = pdTRUE;
+			( void ) memcpy( ( void * ) pcSlot, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+			prvSPSCPublishWrite( pxQueue );
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			prvSPSCWakeOtherEndFromISR( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->cTxLock ), pxHigherPriorityTaskWoken );
+			xReturn = pdPASS;
 		}
 		else
 		{
-			xReturn = pdFALSE;
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			xReturn = errQUEUE_FULL;
 		}
+
+		return xReturn;
 	}
-	taskEXIT_CRITICAL();
 
-	return xReturn;
-}
+#endif /* configUSE_SPSC_QUEUES */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
-{
-BaseType_t xReturn;
+#if( configUSE_SPSC_QUEUES == 1 )
 
-	configASSERT( xQueue );
-	if( ( ( Queue_t * ) xQueue )->uxMessagesWaiting == ( UBaseType_t ) 0 )
-	{
-		xReturn = pdTRUE;
-	}
-	else
+	static BaseType_t prvSPSCReceiveFromISR( Queue_t * const pxQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xJustPeeking )
 	{
-		xReturn = pdFALSE;
-	}
-
-	return xReturn;
-} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
-/*-----------------------------------------------------------*/
+	int8_t *pcSlot;
+	BaseType_t xReturn;
 
-static BaseType_t prvIsQueueFull( const Queue_t *pxQueue )
-{
-BaseType_t xReturn;
+		pcSlot = prvSPSCGetReadSlot( pxQueue );
 
-	taskENTER_CRITICAL();
-	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		if( pcSlot != NULL )
 		{
-			xReturn = pdTRUE;
+			( void ) memcpy( ( void * ) pvBuffer, ( void * ) pcSlot, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
+
+			if( xJustPeeking == pdFALSE )
+			{
+				prvSPSCPublishRead( pxQueue, pcSlot );
+				traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+				prvSPSCWakeOtherEndFromISR( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->cRxLock ), pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				traceQUEUE_PEEK_FROM_ISR( pxQueue );
+			}
+
+			xReturn = pdPASS;
 		}
 		else
 		{
-			xReturn = pdFALSE;
-		}
-	}
-	taskEXIT_CRITICAL();
-
-	return xReturn;
-}
-/*-----------------------------------------------------------*/
+			if( xJustPeeking == pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+			}
+			else
+			{
+				traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+			}
 
-BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
-{
-BaseType_t xReturn;
+			xReturn = pdFAIL;
+		}
 
-	configASSERT( xQueue );
-	if( ( ( Queue_t * ) xQueue )->uxMessagesWaiting == ( ( Queue_t * ) xQueue )->uxLength )
-	{
-		xReturn = pdTRUE;
-	}
-	else
-	{
-		xReturn = pdFALSE;
+		return xReturn;
 	}
 
-	return xReturn;
-} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+#endif /* configUSE_SPSC_QUEUES */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_CO_ROUTINES == 1 )
@@ -2607,6 +4318,31 @@ BaseType_t xReturn;
 #endif /* configUSE_CO_ROUTINES */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_ASYNC_TASKS == 1 )
+
+	void *pvQueueGetAsyncTaskList( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+
+		/* A mutex taken by an async task would be held by the executor task,
+		and single producer, single consumer queues do not use critical
+		sections, so async tasks cannot wait for either. */
+		configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+		#if( configUSE_SPSC_QUEUES == 1 )
+		{
+			configASSERT( !queueIS_SPSC( pxQueue ) );
+		}
+		#endif /* configUSE_SPSC_QUEUES */
+
+		return ( void * ) &( pxQueue->xAsyncTasksWaiting );
+	}
+
+#endif /* configUSE_ASYNC_TASKS */
+/*-----------------------------------------------------------*/
+
 #if ( configQUEUE_REGISTRY_SIZE > 0 )
 
 	void vQueueAddToRegistry( QueueHandle_t xQueue, const char *pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -2752,6 +4488,14 @@ BaseType_t xReturn;
 	{
 	BaseType_t xReturn;
 
+		#if( configUSE_SPSC_QUEUES == 1 )
+		{
+			/* Single producer, single consumer queues cannot be members of a
+			queue set. */
+			configASSERT( !queueIS_SPSC( ( Queue_t * ) xQueueOrSemaphore ) );
+		}
+		#endif /* configUSE_SPSC_QUEUES */
+
 		taskENTER_CRITICAL();
 		{
 			if( ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
@@ -0,0 +1,668 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+to include reader-writer lock functionality.  This #if is closed at the very
+bottom of this file.  If you want to include reader-writer locks then ensure
+configUSE_RWLOCKS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_RWLOCKS == 1 )
+
+/* The task that holds a lock for writing is recorded using its task handle. */
+#if( ( configUSE_MUTEXES != 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configNUM_CORES == 1 ) )
+	#error Either configUSE_MUTEXES or INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 if configUSE_RWLOCKS is set to 1
+#endif
+
+#if( configUSE_PREEMPTION == 0 )
+	/* If the cooperative scheduler is being used then a yield should not be
+	performed just because a higher priority task has been woken. */
+	#define rwlockYIELD_IF_USING_PREEMPTION()
+#else
+	#define rwlockYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+/* Bits stored in the ucFlags field of the lock. */
+#define rwlockFLAGS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 1 ) /* Set if the lock structure was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds the state of a reader-writer lock. */
+typedef struct xRWLOCK /*lint !e9058 Style convention uses tag. */
+{
+	List_t xTasksWaitingToRead;		/* List of tasks that are blocked waiting to take the lock for reading.  Stored in priority order. */
+	List_t xTasksWaitingToWrite;	/* List of tasks that are blocked waiting to take the lock for writing.  Stored in priority order. */
+	TaskHandle_t xWriter;			/* The task that holds the lock for writing, or NULL if the lock is not held for writing. */
+	UBaseType_t uxReaders;			/* The number of tasks that hold the lock for reading. */
+	uint8_t ucPolicy;				/* The eRWLockPolicy the lock was created with. */
+	uint8_t ucFlags;
+
+	#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+		ListItem_t xWriterHeldListItems[ 2 ];	/* Placed in the writer's list of held mutexes while the lock is held for writing.  Their owners are the two lists of waiting tasks. */
+	#endif
+} RWLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by xRWLockCreate() and xRWLockCreateStatic() to initialise the members
+ * of a newly created lock structure.
+ */
+static void prvInitialiseNewRWLock( RWLock_t * const pxRWLock, eRWLockPolicy ePolicy ) PRIVILEGED_FUNCTION;
+
+/*
+ * Implements both xRWLockTakeRead() and xRWLockTakeWrite().  xExclusive is
+ * pdTRUE to take the lock for writing and pdFALSE to take it for reading.
+ */
+static BaseType_t prvRWLockTake( RWLock_t * const pxRWLock, const BaseType_t xExclusive, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the calling task can take the lock now, for writing if
+ * xExclusive is pdTRUE or for reading if xExclusive is pdFALSE.  Must be called
+ * with the scheduler suspended.
+ */
+static BaseType_t prvIsAvailable( const RWLock_t * const pxRWLock, const BaseType_t xExclusive ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called whenever the state of the lock changes in a way that might allow
+ * waiting tasks to take it.  Unblocks either every waiting reader or the
+ * highest priority waiting writer, as the lock's policy dictates.  Unblocked
+ * tasks take the lock when they next run, in priority order, and return to the
+ * Blocked state if another task has taken the lock first.  Must be called with
+ * the scheduler suspended.
+ */
+static void prvUnblockWaitingTasks( RWLock_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_MUTEXES == 1 )
+
+	/*
+	 * If a task waiting for the lock causes the writer to inherit a priority,
+	 * but the waiting task times out, then the writer should disinherit the
+	 * priority - but only down to the priority of the highest priority task
+	 * still waiting for the lock, for either reading or writing.  Returns that
+	 * priority.
+	 */
+	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const RWLock_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	RWLockHandle_t xRWLockCreate( eRWLockPolicy ePolicy )
+	{
+	RWLock_t *pxRWLock;
+
+		pxRWLock = ( RWLock_t * ) pvPortMalloc( sizeof( RWLock_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxRWLock != NULL )
+		{
+			prvInitialiseNewRWLock( pxRWLock, ePolicy );
+			traceRWLOCK_CREATE( pxRWLock );
+		}
+		else
+		{
+			traceRWLOCK_CREATE_FAILED();
+		}
+
+		return ( RWLockHandle_t ) pxRWLock;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	RWLockHandle_t xRWLockCreateStatic( eRWLockPolicy ePolicy, StaticRWLock_t *pxRWLockBuffer )
+	{
+	RWLock_t * const pxRWLock = ( RWLock_t * ) pxRWLockBuffer; /*lint !e740 !e9087 Safe cast as StaticRWLock_t is opaque RWLock_t. */
+
+		configASSERT( pxRWLockBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticRWLock_t equals the size of the real lock
+			structure. */
+			volatile size_t xSize = sizeof( StaticRWLock_t );
+			configASSERT( xSize == sizeof( RWLock_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( pxRWLock != NULL )
+		{
+			prvInitialiseNewRWLock( pxRWLock, ePolicy );
+
+			/* Remember this was statically allocated in case it is ever deleted
+			again. */
+			pxRWLock->ucFlags |= rwlockFLAGS_IS_STATICALLY_ALLOCATED;
+
+			traceRWLOCK_CREATE( pxRWLock );
+		}
+		else
+		{
+			traceRWLOCK_CREATE_FAILED();
+		}
+
+		return ( RWLockHandle_t ) pxRWLock;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vRWLockDelete( RWLockHandle_t xRWLock )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+
+	configASSERT( pxRWLock );
+
+	/* A lock that is held, or that tasks are waiting for, cannot be deleted. */
+	configASSERT( pxRWLock->xWriter == NULL );
+	configASSERT( pxRWLock->uxReaders == ( UBaseType_t ) 0 );
+	configASSERT( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToRead ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) != pdFALSE );
+
+	traceRWLOCK_DELETE( xRWLock );
+
+	if( ( pxRWLock->ucFlags & rwlockFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			vPortFree( ( void * ) pxRWLock );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt.
+			Force an assert. */
+			configASSERT( xRWLock == ( RWLockHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The lock was statically allocated, so there is no memory to free. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+	return prvRWLockTake( ( RWLock_t * ) xRWLock, pdFALSE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+	return prvRWLockTake( ( RWLock_t * ) xRWLock, pdTRUE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn;
+
+	configASSERT( pxRWLock );
+
+	vTaskSuspendAll();
+	{
+		if( pxRWLock->uxReaders > ( UBaseType_t ) 0 )
+		{
+			( pxRWLock->uxReaders )--;
+			traceRWLOCK_GIVE( pxRWLock, pdFALSE );
+
+			/* If this was the last reader then a writer can now take the
+			lock. */
+			prvUnblockWaitingTasks( pxRWLock );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			/* The lock was not held for reading. */
+			xReturn = pdFAIL;
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock )
+{
+RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn, xYieldRequired = pdFALSE;
+
+	configASSERT( pxRWLock );
+
+	vTaskSuspendAll();
+	{
+		/* Only the task that took the lock for writing can give it back. */
+		if( ( pxRWLock->xWriter != NULL ) && ( pxRWLock->xWriter == xTaskGetCurrentTaskHandle() ) )
+		{
+			#if( configUSE_MUTEXES == 1 )
+			{
+				taskENTER_CRITICAL();
+				{
+					#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+					{
+						( void ) uxListRemove( &( pxRWLock->xWriterHeldListItems[ 0 ] ) );
+						( void ) uxListRemove( &( pxRWLock->xWriterHeldListItems[ 1 ] ) );
+					}
+					#endif
+
+					/* The writer might have inherited a priority from a task
+					that blocked on the lock.  Drop back to the base priority
+					if no other mutexes are held. */
+					xYieldRequired = xTaskPriorityDisinherit( pxRWLock->xWriter );
+				}
+				taskEXIT_CRITICAL();
+			}
+			#endif /* configUSE_MUTEXES */
+
+			pxRWLock->xWriter = NULL;
+			traceRWLOCK_GIVE( pxRWLock, pdTRUE );
+
+			prvUnblockWaitingTasks( pxRWLock );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+
+	/* Unblocking a higher priority task will have caused the yield when the
+	scheduler was resumed, but disinheriting a priority does not. */
+	if( xTaskResumeAll() == pdFALSE )
+	{
+		if( xYieldRequired != pdFALSE )
+		{
+			rwlockYIELD_IF_USING_PREEMPTION();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock )
+{
+const RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+
+	configASSERT( pxRWLock );
+	return pxRWLock->uxReaders;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xRWLockGetWriter( RWLockHandle_t xRWLock )
+{
+const RWLock_t * const pxRWLock = ( RWLock_t * ) xRWLock;
+
+	configASSERT( pxRWLock );
+	return pxRWLock->xWriter;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewRWLock( RWLock_t * const pxRWLock, eRWLockPolicy ePolicy )
+{
+	vListInitialise( &( pxRWLock->xTasksWaitingToRead ) );
+	vListInitialise( &( pxRWLock->xTasksWaitingToWrite ) );
+	pxRWLock->xWriter = NULL;
+	pxRWLock->uxReaders = ( UBaseType_t ) 0;
+	pxRWLock->ucPolicy = ( uint8_t ) ePolicy;
+	pxRWLock->ucFlags = 0;
+
+	#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	{
+		/* The writer's priority is recalculated from the tasks waiting for
+		each mutex it holds, and tasks can wait for this lock on either of two
+		lists. */
+		vListInitialiseItem( &( pxRWLock->xWriterHeldListItems[ 0 ] ) );
+		listSET_LIST_ITEM_OWNER( &( pxRWLock->xWriterHeldListItems[ 0 ] ), &( pxRWLock->xTasksWaitingToRead ) );
+		vListInitialiseItem( &( pxRWLock->xWriterHeldListItems[ 1 ] ) );
+		listSET_LIST_ITEM_OWNER( &( pxRWLock->xWriterHeldListItems[ 1 ] ), &( pxRWLock->xTasksWaitingToWrite ) );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRWLockTake( RWLock_t * const pxRWLock, const BaseType_t xExclusive, TickType_t xTicksToWait )
+{
+TimeOut_t xTimeOut;
+BaseType_t xEntryTimeSet = pdFALSE, xComplete = pdFALSE, xBlocked, xReturn = pdFAIL;
+List_t * const pxWaitingList = ( xExclusive != pdFALSE ) ? &( pxRWLock->xTasksWaitingToWrite ) : &( pxRWLock->xTasksWaitingToRead );
+
+#if( configUSE_MUTEXES == 1 )
+	BaseType_t xInheritanceOccurred = pdFALSE;
+#endif
+
+	configASSERT( pxRWLock );
+
+	/* The lock is not recursive, so the writer cannot take it again. */
+	configASSERT( pxRWLock->xWriter != xTaskGetCurrentTaskHandle() );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	do
+	{
+		xBlocked = pdFALSE;
+
+		/* The lock is only accessed by tasks, so suspending the scheduler is
+		enough to gain exclusive access to it. */
+		vTaskSuspendAll();
+		{
+			if( prvIsAvailable( pxRWLock, xExclusive ) != pdFALSE )
+			{
+				if( xExclusive != pdFALSE )
+				{
+					#if( configUSE_MUTEXES == 1 )
+					{
+						/* Record the writer as a mutex holder so it can
+						inherit the priority of tasks that block on the lock. */
+						pxRWLock->xWriter = ( TaskHandle_t ) pvTaskIncrementMutexHeldCount();
+
+						#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+						{
+							taskENTER_CRITICAL();
+							{
+								vTaskAddHeldMutex( &( pxRWLock->xWriterHeldListItems[ 0 ] ) );
+								vTaskAddHeldMutex( &( pxRWLock->xWriterHeldListItems[ 1 ] ) );
+							}
+							taskEXIT_CRITICAL();
+						}
+						#endif
+					}
+					#else
+					{
+						pxRWLock->xWriter = xTaskGetCurrentTaskHandle();
+					}
+					#endif
+				}
+				else
+				{
+					( pxRWLock->uxReaders )++;
+				}
+
+				traceRWLOCK_TAKE( pxRWLock, xExclusive );
+				xReturn = pdPASS;
+				xComplete = pdTRUE;
+			}
+			else if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				/* The lock is not available and no block time was specified. */
+				xComplete = pdTRUE;
+			}
+			else
+			{
+				if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+				{
+					traceBLOCKING_ON_RWLOCK_TAKE( pxRWLock, xExclusive );
+
+					#if( configUSE_MUTEXES == 1 )
+					{
+						/* Readers cannot inherit a priority as there can be any
+						number of them, but the writer can. */
+						if( pxRWLock->xWriter != NULL )
+						{
+							taskENTER_CRITICAL();
+							{
+								if( xTaskPriorityInherit( pxRWLock->xWriter ) != pdFALSE )
+								{
+									xInheritanceOccurred = pdTRUE;
+								}
+								else
+								{
+									mtCOVERAGE_TEST_MARKER();
+								}
+							}
+							taskEXIT_CRITICAL();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_MUTEXES */
+
+					vTaskPlaceOnEventList( pxWaitingList, xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					/* Timed out.  The task is no longer in the event list. */
+					#if( configUSE_MUTEXES == 1 )
+					{
+						if( xInheritanceOccurred != pdFALSE )
+						{
+							taskENTER_CRITICAL();
+							{
+								vTaskPriorityDisinheritAfterTimeout( pxRWLock->xWriter, prvGetDisinheritPriorityAfterTimeout( pxRWLock ) );
+							}
+							taskEXIT_CRITICAL();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_MUTEXES */
+
+					/* A writer that stops waiting might have been the only
+					thing preventing waiting readers from taking the lock. */
+					prvUnblockWaitingTasks( pxRWLock );
+					xComplete = pdTRUE;
+				}
+			}
+		}
+
+		if( xTaskResumeAll() == pdFALSE )
+		{
+			if( xBlocked != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+	} while( xComplete == pdFALSE );
+
+	if( xReturn == pdFAIL )
+	{
+		traceRWLOCK_TAKE_FAILED( pxRWLock, xExclusive );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsAvailable( const RWLock_t * const pxRWLock, const BaseType_t xExclusive )
+{
+BaseType_t xReturn;
+
+	if( pxRWLock->xWriter != NULL )
+	{
+		xReturn = pdFALSE;
+	}
+	else if( xExclusive != pdFALSE )
+	{
+		/* A writer needs the lock to itself. */
+		xReturn = ( pxRWLock->uxReaders == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+	}
+	else if( pxRWLock->ucPolicy == ( uint8_t ) eRWLockPreferWriters )
+	{
+		/* New readers queue behind waiting writers so the writers are not
+		starved. */
+		xReturn = listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) );
+	}
+	else
+	{
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnblockWaitingTasks( RWLock_t * const pxRWLock )
+{
+	if( pxRWLock->xWriter == NULL )
+	{
+		if( ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToRead ) ) == pdFALSE ) &&
+			( ( pxRWLock->ucPolicy == ( uint8_t ) eRWLockPreferReaders ) || ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) != pdFALSE ) ) )
+		{
+			/* Any number of readers can hold the lock at once, so unblock them
+			all.  Each is removed in its own critical section so interrupts
+			are not held off for the whole list. */
+			while( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToRead ) ) == pdFALSE )
+			{
+				taskENTER_CRITICAL();
+				{
+					( void ) xTaskRemoveFromEventList( &( pxRWLock->xTasksWaitingToRead ) );
+				}
+				taskEXIT_CRITICAL();
+			}
+		}
+		else if( ( pxRWLock->uxReaders == ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) == pdFALSE ) )
+		{
+			/* Only one writer can hold the lock, so only the highest priority
+			writer is unblocked. */
+			taskENTER_CRITICAL();
+			{
+				( void ) xTaskRemoveFromEventList( &( pxRWLock->xTasksWaitingToWrite ) );
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEXES == 1 )
+
+	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const RWLock_t * const pxRWLock )
+	{
+	UBaseType_t uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY, uxPriority;
+
+		if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToRead ) ) > 0 )
+		{
+			uxHighestPriorityOfWaitingTasks = configMAX_PRIORITIES - listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToRead ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToWrite ) ) > 0 )
+		{
+			uxPriority = configMAX_PRIORITIES - listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToWrite ) );
+
+			if( uxPriority > uxHighestPriorityOfWaitingTasks )
+			{
+				uxHighestPriorityOfWaitingTasks = uxPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxHighestPriorityOfWaitingTasks;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include reader-writer lock functionality.  If you want to include
+reader-writer locks then ensure configUSE_RWLOCKS is set to 1 in
+FreeRTOSConfig.h. */
+#endif /* configUSE_RWLOCKS == 1 */
@@ -39,6 +39,10 @@ task.h is included from an application file. */
 #include "task.h"
 #include "stream_buffer.h"
 
+#if( configUSE_ASYNC_TASKS == 1 )
+	#include "async.h"
+#endif
+
 #if( configUSE_TASK_NOTIFICATIONS != 1 )
 	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -74,7 +78,7 @@ that uses task notifications. */
 	{																					\
 	UBaseType_t uxSavedInterruptStatus;													\
 																						\
-		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();			\
 		{																				\
 			if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )						\
 			{																			\
@@ -85,7 +89,7 @@ that uses task notifications. */
 				( pxStreamBuffer )->xTaskWaitingToSend = NULL;							\
 			}																			\
 		}																				\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );							\
 	}
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -112,7 +116,7 @@ that uses task notifications. */
 	{																					\
 	UBaseType_t uxSavedInterruptStatus;													\
 																						\
-		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();			\
 		{																				\
 			if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )						\
 			{																			\
@@ -123,7 +127,7 @@ that uses task notifications. */
 				( pxStreamBuffer )->xTaskWaitingToReceive = NULL;						\
 			}																			\
 		}																				\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );							\
 	}
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 /*lint -restore (9026) */
@@ -134,6 +138,38 @@ that uses task notifications. */
 /* Bits stored in the ucFlags field of the stream buffer. */
 #define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
+#define sbFLAGS_IS_MPMC					( ( uint8_t ) 4 ) /* Set if the stream buffer was created as a multi-producer, multi-consumer buffer. */
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	#define sbIS_MPMC( pxStreamBuffer ) ( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_MPMC ) != ( uint8_t ) 0 )
+
+	/* Multi-producer, multi-consumer stream buffers hold blocked tasks in
+	event lists, so unblocking a task can make a context switch necessary. */
+	#if( configUSE_PREEMPTION == 0 )
+		#define sbYIELD_IF_USING_PREEMPTION()
+	#else
+		#define sbYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+	#endif
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+
+/* Async tasks wait for a stream buffer in the buffer's list of async tasks,
+which is only accessed from critical sections. */
+#if( configUSE_ASYNC_TASKS == 1 )
+	#define sbWAKE_ASYNC_TASKS( pxStreamBuffer, xEvent )											\
+		if( listLIST_IS_EMPTY( &( ( pxStreamBuffer )->xAsyncTasksWaiting ) ) == pdFALSE )			\
+		{																							\
+			vAsyncTaskWakeWaiting( &( ( pxStreamBuffer )->xAsyncTasksWaiting ), ( xEvent ), 1 );	\
+		}
+
+	#define sbWAKE_ASYNC_TASKS_FROM_ISR( pxStreamBuffer, xEvent, pxHigherPriorityTaskWoken )		\
+		if( listLIST_IS_EMPTY( &( ( pxStreamBuffer )->xAsyncTasksWaiting ) ) == pdFALSE )			\
+		{																							\
+			vAsyncTaskWakeWaitingFromISR( &( ( pxStreamBuffer )->xAsyncTasksWaiting ), ( xEvent ), 1, ( pxHigherPriorityTaskWoken ) );	\
+		}
+#else
+	#define sbWAKE_ASYNC_TASKS( pxStreamBuffer, xEvent )
+	#define sbWAKE_ASYNC_TASKS_FROM_ISR( pxStreamBuffer, xEvent, pxHigherPriorityTaskWoken )
+#endif /* configUSE_ASYNC_TASKS */
 
 /*-----------------------------------------------------------*/
 
@@ -152,6 +188,24 @@ typedef struct xSTREAM_BUFFER /*lint !e9058 Style convention uses tag. */
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
 	#endif
+
+	#if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+		/* Only used by multi-producer, multi-consumer stream buffers, for which
+		xHead and xTail only move once every write or read that was in progress
+		has completed.  Until then the bytes between xHead and xReservedHead
+		are being written, and the bytes between xTail and xReservedTail are
+		being read. */
+		List_t xTasksWaitingToSend;			/* List of tasks that are blocked waiting for space.  Stored in priority order. */
+		List_t xTasksWaitingToReceive;		/* List of tasks that are blocked waiting for data.  Stored in priority order. */
+		size_t xReservedHead;				/* Index to the next byte to reserve for writing. */
+		size_t xReservedTail;				/* Index to the next byte to reserve for reading. */
+		UBaseType_t uxWritesInProgress;		/* The number of writes that have reserved space but not yet completed. */
+		UBaseType_t uxReadsInProgress;		/* The number of reads that have reserved data but not yet completed. */
+	#endif
+
+	#if ( configUSE_ASYNC_TASKS == 1 )
+		List_t xAsyncTasksWaiting;			/* List of async tasks that are waiting to send to or receive from the buffer, in the order in which they started to wait. */
+	#endif
 } StreamBuffer_t;
 
 /*
@@ -159,6 +213,20 @@ typedef struct xSTREAM_BUFFER /*lint !e9058 Style convention uses tag. */
  */
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copy xCount bytes from pucData into the buffer's storage area, starting at
+ * index xOffset and wrapping back to the start of the storage area if
+ * necessary.  Returns the index that follows the last byte written.
+ */
+static size_t prvCopyBytesToBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xOffset, const uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes out of the buffer's storage area into pucData, starting at
+ * index xOffset and wrapping back to the start of the storage area if
+ * necessary.  Returns the index that follows the last byte read.
+ */
+static size_t prvCopyBytesFromBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xOffset, uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
 /*
  * Add xCount bytes from pucData into the pxStreamBuffer message buffer.
  * Returns the number of bytes written, which will either equal xCount in the
@@ -202,6 +270,28 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
 									  size_t xMaxCount,
 									  size_t xBytesAvailable ); PRIVILEGED_FUNCTION
 
+/*
+ * Describe the xCount bytes of the storage area that start at index xOffset as
+ * up to two contiguous spans - the first running from xOffset towards the end
+ * of the storage area, and the second (if the bytes wrap) from the start of the
+ * storage area.  Unused spans are set to a NULL pointer and a zero length.
+ * Returns xCount.
+ */
+static size_t prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+						   size_t xOffset,
+						   size_t xCount,
+						   StreamBufferSpan_t pxSpans[ 2 ] ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the head (tail) index of the buffer on by xCount bytes once the bytes
+ * in the spans returned by xStreamBufferGetWriteSpans()
+ * (xStreamBufferGetReadSpans()) have been written (read).  Returns xCount, or
+ * 0 if xCount is larger than the number of bytes that could have been written
+ * (read), in which case the index is not moved.
+ */
+static size_t prvCommitWrite( StreamBuffer_t * const pxStreamBuffer, size_t xCount ) PRIVILEGED_FUNCTION;
+static size_t prvCommitRead( StreamBuffer_t * const pxStreamBuffer, size_t xCount ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -210,13 +300,91 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  uint8_t * const pucBuffer,
 										  size_t xBufferSizeBytes,
 										  size_t xTriggerLevelBytes,
-										  BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+										  BaseType_t xStreamBufferType ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	/*
+	 * Versions of the send and receive functions used by multi-producer,
+	 * multi-consumer stream and message buffers.  pxHigherPriorityTaskWoken is
+	 * only used, and xTicksToWait only valid, when xFromISR is pdTRUE and
+	 * pdFALSE respectively.
+	 */
+	static size_t prvSendMPMC( StreamBuffer_t * const pxStreamBuffer,
+							   const void *pvTxData,
+							   size_t xDataLengthBytes,
+							   TickType_t xTicksToWait,
+							   BaseType_t xFromISR,
+							   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+	static size_t prvReceiveMPMC( StreamBuffer_t * const pxStreamBuffer,
+								  void *pvRxData,
+								  size_t xBufferLengthBytes,
+								  TickType_t xTicksToWait,
+								  BaseType_t xFromISR,
+								  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Reserve the region of the buffer a write of xDataLengthBytes will use,
+	 * including the message length if this is a message buffer.  Stream buffer
+	 * writes only reserve part of the space requested if xAcceptPartial is
+	 * pdTRUE.  Returns pdTRUE and sets *pxOffset to the start of the region and
+	 * *pxCount to the number of data bytes to write if space was reserved.  Must
+	 * be called from a critical section.
+	 */
+	static BaseType_t prvReserveWriteMPMC( StreamBuffer_t * const pxStreamBuffer,
+										   size_t xDataLengthBytes,
+										   BaseType_t xAcceptPartial,
+										   size_t *pxOffset,
+										   size_t *pxCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Reserve the region of the buffer holding the next message, if this is a
+	 * message buffer and the message fits in xBufferLengthBytes, or the next
+	 * xBufferLengthBytes bytes or as many bytes as are available if this is a
+	 * stream buffer.  Returns pdTRUE and sets *pxOffset to the first data byte
+	 * and *pxCount to the number of data bytes to read if data was reserved.
+	 * Must be called from a critical section.
+	 */
+	static BaseType_t prvReserveReadMPMC( StreamBuffer_t * const pxStreamBuffer,
+										  size_t xBufferLengthBytes,
+										  size_t *pxOffset,
+										  size_t *pxCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Mark a write or read reserved by prvReserveWriteMPMC() or
+	 * prvReserveReadMPMC() as complete, then unblock waiting tasks if there is
+	 * now data or space for them.  Returns pdTRUE if a task with a priority
+	 * higher than the calling task was unblocked.  Must be called from a
+	 * critical section.
+	 */
+	static BaseType_t prvCompleteWriteMPMC( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvCompleteReadMPMC( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Unblock the highest priority task waiting to receive if there is data for
+	 * it, and the highest priority task waiting to send if there is space.  Each
+	 * task that completes a transfer calls this function again, so waiting tasks
+	 * are unblocked one after the other for as long as there is data or space.
+	 * Returns pdTRUE if a task with a priority higher than the calling task was
+	 * unblocked.  Must be called from a critical section.
+	 */
+	static BaseType_t prvUnblockWaitingTasksMPMC( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The number of bytes that can be reserved for writing, and the number of
+	 * bytes that can be reserved for reading.
+	 */
+	static size_t prvSpacesAvailableMPMC( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+	static size_t prvBytesAvailableMPMC( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
 
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
+	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xStreamBufferType )
 	{
 	uint8_t *pucAllocatedMemory;
 
@@ -251,13 +419,13 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										   pucAllocatedMemory + sizeof( StreamBuffer_t ),  /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer, also storage area has no alignment requirement. */
 										   xBufferSizeBytes,
 										   xTriggerLevelBytes,
-										   xIsMessageBuffer );
+										   xStreamBufferType );
 
-			traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pucAllocatedMemory ), xIsMessageBuffer );
+			traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pucAllocatedMemory ), ( xStreamBufferType & sbTYPE_MESSAGE_BUFFER ) );
 		}
 		else
 		{
-			traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+			traceSTREAM_BUFFER_CREATE_FAILED( ( xStreamBufferType & sbTYPE_MESSAGE_BUFFER ) );
 		}
 
 		return ( StreamBufferHandle_t * ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
@@ -270,7 +438,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 	StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 														   size_t xTriggerLevelBytes,
-														   BaseType_t xIsMessageBuffer,
+														   BaseType_t xStreamBufferType,
 														   uint8_t * const pucStreamBufferStorageArea,
 														   StaticStreamBuffer_t * const pxStaticStreamBuffer )
 	{
@@ -310,20 +478,20 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  pucStreamBufferStorageArea,
 										  xBufferSizeBytes,
 										  xTriggerLevelBytes,
-										  xIsMessageBuffer );
+										  xStreamBufferType );
 
 			/* Remember this was statically allocated in case it is ever deleted
 			again. */
 			pxStreamBuffer->ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
 
-			traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer );
+			traceSTREAM_BUFFER_CREATE( pxStreamBuffer, ( xStreamBufferType & sbTYPE_MESSAGE_BUFFER ) );
 
 			xReturn = ( StreamBufferHandle_t ) pxStaticStreamBuffer; /*lint !e9087 Data hiding requires cast to opaque type. */
 		}
 		else
 		{
 			xReturn = NULL;
-			traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, xIsMessageBuffer );
+			traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, ( xStreamBufferType & sbTYPE_MESSAGE_BUFFER ) );
 		}
 
 		return xReturn;
@@ -340,6 +508,13 @@ StreamBuffer_t * pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9
 
 	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
 
+	#if( configUSE_ASYNC_TASKS == 1 )
+	{
+		/* A buffer must not be deleted while async tasks are waiting for it. */
+		configASSERT( listLIST_IS_EMPTY( &( pxStreamBuffer->xAsyncTasksWaiting ) ) != pdFALSE );
+	}
+	#endif /* configUSE_ASYNC_TASKS */
+
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
 	{
 		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -368,7 +543,7 @@ StreamBuffer_t * pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9
 BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
 {
 StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
-BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
+BaseType_t xReturn = pdFAIL, xStreamBufferType, xCanReset = pdTRUE;
 
 #if( configUSE_TRACE_FACILITY == 1 )
 	UBaseType_t uxStreamBufferNumber;
@@ -384,36 +559,92 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 	}
 	#endif
 
-	/* Can only reset a message buffer if there are no tasks blocked on it. */
-	if( pxStreamBuffer->xTaskWaitingToReceive == NULL )
+	/* The checks and the reset are performed in one critical section so a
+	task cannot start to wait for the buffer, or to write to or read from it,
+	after it has been checked but before it has been reset. */
+	taskENTER_CRITICAL();
 	{
-		if( pxStreamBuffer->xTaskWaitingToSend == NULL )
+		#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
 		{
-			if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+			/* A multi-producer, multi-consumer buffer can only be reset if
+			there are no tasks blocked on it and no writes or reads in
+			progress. */
+			if( sbIS_MPMC( pxStreamBuffer ) )
 			{
-				xIsMessageBuffer = pdTRUE;
+				if( ( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE ) ||
+					( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToReceive ) ) == pdFALSE ) ||
+					( pxStreamBuffer->uxWritesInProgress != ( UBaseType_t ) 0 ) ||
+					( pxStreamBuffer->uxReadsInProgress != ( UBaseType_t ) 0 ) )
+				{
+					xCanReset = pdFALSE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
-				xIsMessageBuffer = pdFALSE;
+				mtCOVERAGE_TEST_MARKER();
 			}
+		}
+		#endif /* configUSE_MPMC_STREAM_BUFFERS */
 
-			prvInitialiseNewStreamBuffer( pxStreamBuffer,
-										  pxStreamBuffer->pucBuffer,
-										  pxStreamBuffer->xLength,
-										  pxStreamBuffer->xTriggerLevelBytes,
-										  xIsMessageBuffer );
-			xReturn = pdPASS;
-
-			#if( configUSE_TRACE_FACILITY == 1 )
+		#if( configUSE_ASYNC_TASKS == 1 )
+		{
+			/* Nor if there are async tasks waiting for it. */
+			if( listLIST_IS_EMPTY( &( pxStreamBuffer->xAsyncTasksWaiting ) ) == pdFALSE )
+			{
+				xCanReset = pdFALSE;
+			}
+			else
 			{
-				pxStreamBuffer->uxStreamBufferNumber = uxStreamBufferNumber;
+				mtCOVERAGE_TEST_MARKER();
 			}
-			#endif
+		}
+		#endif /* configUSE_ASYNC_TASKS */
+
+		/* Can only reset a message buffer if there are no tasks blocked on it. */
+		if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( xCanReset != pdFALSE ) )
+		{
+			if( pxStreamBuffer->xTaskWaitingToSend == NULL )
+			{
+				if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+				{
+					xStreamBufferType = sbTYPE_MESSAGE_BUFFER;
+				}
+				else
+				{
+					xStreamBufferType = sbTYPE_STREAM_BUFFER;
+				}
+
+				if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MPMC ) != ( uint8_t ) 0 )
+				{
+					xStreamBufferType |= sbTYPE_MPMC_STREAM_BUFFER;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvInitialiseNewStreamBuffer( pxStreamBuffer,
+											  pxStreamBuffer->pucBuffer,
+											  pxStreamBuffer->xLength,
+											  pxStreamBuffer->xTriggerLevelBytes,
+											  xStreamBufferType );
+				xReturn = pdPASS;
+
+				#if( configUSE_TRACE_FACILITY == 1 )
+				{
+					pxStreamBuffer->uxStreamBufferNumber = uxStreamBufferNumber;
+				}
+				#endif
 
-			traceSTREAM_BUFFER_RESET( xStreamBuffer );
+				traceSTREAM_BUFFER_RESET( xStreamBuffer );
+			}
 		}
 	}
+	taskEXIT_CRITICAL();
 
 	return xReturn;
 }
@@ -455,17 +686,26 @@ size_t xSpace;
 
 	configASSERT( pxStreamBuffer );
 
-	xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
-	xSpace -= pxStreamBuffer->xHead;
-	xSpace -= ( size_t ) 1;
-
-	if( xSpace >= pxStreamBuffer->xLength )
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	if( sbIS_MPMC( pxStreamBuffer ) )
 	{
-		xSpace -= pxStreamBuffer->xLength;
+		xSpace = prvSpacesAvailableMPMC( pxStreamBuffer );
 	}
 	else
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
 	{
-		mtCOVERAGE_TEST_MARKER();
+		xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+		xSpace -= pxStreamBuffer->xHead;
+		xSpace -= ( size_t ) 1;
+
+		if( xSpace >= pxStreamBuffer->xLength )
+		{
+			xSpace -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
 
 	return xSpace;
@@ -479,7 +719,17 @@ size_t xReturn;
 
 	configASSERT( pxStreamBuffer );
 
-	xReturn = prvBytesInBuffer( pxStreamBuffer );
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	if( sbIS_MPMC( pxStreamBuffer ) )
+	{
+		xReturn = prvBytesAvailableMPMC( pxStreamBuffer );
+	}
+	else
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
+	{
+		xReturn = prvBytesInBuffer( pxStreamBuffer );
+	}
+
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
@@ -497,89 +747,99 @@ TimeOut_t xTimeOut;
 	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
 
-	/* This send function is used to write to both message buffers and stream
-	buffers.  If this is a message buffer then the space needed must be
-	increased by the amount of bytes needed to store the length of the
-	message. */
-	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	if( sbIS_MPMC( pxStreamBuffer ) )
 	{
-		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		xReturn = prvSendMPMC( pxStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait, pdFALSE, NULL );
 	}
 	else
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
 	{
-		mtCOVERAGE_TEST_MARKER();
-	}
-
-	if( xTicksToWait != ( TickType_t ) 0 )
-	{
-		vTaskSetTimeOutState( &xTimeOut );
-
-		do
+		/* This send function is used to write to both message buffers and stream
+		buffers.  If this is a message buffer then the space needed must be
+		increased by the amount of bytes needed to store the length of the
+		message. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
 		{
-			/* Wait until the required number of bytes are free in the message
-			buffer. */
-			taskENTER_CRITICAL();
-			{
-				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+			xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-				if( xSpace < xRequiredSpace )
-				{
-					/* Clear notification state as going to wait for space. */
-					( void ) xTaskNotifyStateClear( NULL );
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
 
-					/* Should only be one writer. */
-					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
-					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
-				}
-				else
+			do
+			{
+				/* Wait until the required number of bytes are free in the message
+				buffer. */
+				taskENTER_CRITICAL();
 				{
-					taskEXIT_CRITICAL();
-					break;
+					xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+					if( xSpace < xRequiredSpace )
+					{
+						/* Clear notification state as going to wait for space. */
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one writer. */
+						configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+						pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					}
+					else
+					{
+						taskEXIT_CRITICAL();
+						break;
+					}
 				}
-			}
-			taskEXIT_CRITICAL();
-
-			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
-			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
-			pxStreamBuffer->xTaskWaitingToSend = NULL;
+				taskEXIT_CRITICAL();
 
-		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+				traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
 
-	if( xSpace == ( size_t ) 0 )
-	{
-		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+			} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+		if( xSpace == ( size_t ) 0 )
+		{
+			xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	if( xReturn > ( size_t ) 0 )
-	{
-		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+		xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
-		/* Was a task waiting for the data? */
-		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		if( xReturn > ( size_t ) 0 )
 		{
-			sbSEND_COMPLETED( pxStreamBuffer );
+			traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETED( pxStreamBuffer );
+				sbWAKE_ASYNC_TASKS( pxStreamBuffer, asyncWAITING_TO_RECEIVE );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
+			traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
 		}
 	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-		traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
-	}
 
 	return xReturn;
 }
@@ -597,40 +857,50 @@ size_t xRequiredSpace = xDataLengthBytes;
 	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
 
-	/* This send function is used to write to both message buffers and stream
-	buffers.  If this is a message buffer then the space needed must be
-	increased by the amount of bytes needed to store the length of the
-	message. */
-	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	if( sbIS_MPMC( pxStreamBuffer ) )
 	{
-		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		xReturn = prvSendMPMC( pxStreamBuffer, pvTxData, xDataLengthBytes, ( TickType_t ) 0, pdTRUE, pxHigherPriorityTaskWoken );
 	}
 	else
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
 	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+		/* This send function is used to write to both message buffers and stream
+		buffers.  If this is a message buffer then the space needed must be
+		increased by the amount of bytes needed to store the length of the
+		message. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+		xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
-	if( xReturn > ( size_t ) 0 )
-	{
-		/* Was a task waiting for the data? */
-		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		if( xReturn > ( size_t ) 0 )
 		{
-			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+				sbWAKE_ASYNC_TASKS_FROM_ISR( pxStreamBuffer, asyncWAITING_TO_RECEIVE, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
 
-	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+	}
 
 	return xReturn;
 }
@@ -699,94 +969,104 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 	configASSERT( pvRxData );
 	configASSERT( pxStreamBuffer );
 
-	/* This receive function is used by both message buffers, which store
-	discrete messages, and stream buffers, which store a continuous stream of
-	bytes.  Discrete messages include an additional
-	sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the
-	message. */
-	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	if( sbIS_MPMC( pxStreamBuffer ) )
 	{
-		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		xReceivedLength = prvReceiveMPMC( pxStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait, pdFALSE, NULL );
 	}
 	else
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
 	{
-		xBytesToStoreMessageLength = 0;
-	}
+		/* This receive function is used by both message buffers, which store
+		discrete messages, and stream buffers, which store a continuous stream of
+		bytes.  Discrete messages include an additional
+		sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the
+		message. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
 
-	if( xTicksToWait != ( TickType_t ) 0 )
-	{
-		/* Checking if there is data and clearing the notification state must be
-		performed atomically. */
-		taskENTER_CRITICAL();
+		if( xTicksToWait != ( TickType_t ) 0 )
 		{
-			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+			/* Checking if there is data and clearing the notification state must be
+			performed atomically. */
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				/* If this function was invoked by a message buffer read then
+				xBytesToStoreMessageLength holds the number of bytes used to hold
+				the length of the next discrete message.  If this function was
+				invoked by a stream buffer read then xBytesToStoreMessageLength will
+				be 0. */
+				if( xBytesAvailable <= xBytesToStoreMessageLength )
+				{
+					/* Clear notification state as going to wait for data. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one reader. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
 
-			/* If this function was invoked by a message buffer read then
-			xBytesToStoreMessageLength holds the number of bytes used to hold
-			the length of the next discrete message.  If this function was
-			invoked by a stream buffer read then xBytesToStoreMessageLength will
-			be 0. */
 			if( xBytesAvailable <= xBytesToStoreMessageLength )
 			{
-				/* Clear notification state as going to wait for data. */
-				( void ) xTaskNotifyStateClear( NULL );
+				/* Wait for data to be available. */
+				traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
 
-				/* Should only be one reader. */
-				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
-				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				/* Recheck the data available after blocking. */
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		taskEXIT_CRITICAL();
-
-		if( xBytesAvailable <= xBytesToStoreMessageLength )
-		{
-			/* Wait for data to be available. */
-			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
-			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
-			pxStreamBuffer->xTaskWaitingToReceive = NULL;
-
-			/* Recheck the data available after blocking. */
-			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 		}
-	}
-	else
-	{
-		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-	}
 
-	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
-	holds the number of bytes used to store the message length) or a stream of
-	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
-	available must be greater than xBytesToStoreMessageLength to be able to
-	read bytes from the buffer. */
-	if( xBytesAvailable > xBytesToStoreMessageLength )
-	{
-		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
-
-		/* Was a task waiting for space in the buffer? */
-		if( xReceivedLength != ( size_t ) 0 )
+		/* Whether receiving a discrete message (where xBytesToStoreMessageLength
+		holds the number of bytes used to store the message length) or a stream of
+		bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+		available must be greater than xBytesToStoreMessageLength to be able to
+		read bytes from the buffer. */
+		if( xBytesAvailable > xBytesToStoreMessageLength )
 		{
-			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
-			sbRECEIVE_COMPLETED( pxStreamBuffer );
+			xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
+
+			/* Was a task waiting for space in the buffer? */
+			if( xReceivedLength != ( size_t ) 0 )
+			{
+				traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+				sbRECEIVE_COMPLETED( pxStreamBuffer );
+				sbWAKE_ASYNC_TASKS( pxStreamBuffer, asyncWAITING_TO_SEND );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
+			traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	else
-	{
-		traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
-		mtCOVERAGE_TEST_MARKER();
-	}
 
 	return xReceivedLength;
 }
@@ -803,47 +1083,57 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 	configASSERT( pvRxData );
 	configASSERT( pxStreamBuffer );
 
-	/* This receive function is used by both message buffers, which store
-	discrete messages, and stream buffers, which store a continuous stream of
-	bytes.  Discrete messages include an additional
-	sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the
-	message. */
-	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	if( sbIS_MPMC( pxStreamBuffer ) )
 	{
-		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		xReceivedLength = prvReceiveMPMC( pxStreamBuffer, pvRxData, xBufferLengthBytes, ( TickType_t ) 0, pdTRUE, pxHigherPriorityTaskWoken );
 	}
 	else
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
 	{
-		xBytesToStoreMessageLength = 0;
-	}
-
-	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-
-	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
-	holds the number of bytes used to store the message length) or a stream of
-	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
-	available must be greater than xBytesToStoreMessageLength to be able to
-	read bytes from the buffer. */
-	if( xBytesAvailable > xBytesToStoreMessageLength )
-	{
-		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
-
-		/* Was a task waiting for space in the buffer? */
-		if( xReceivedLength != ( size_t ) 0 )
+		/* This receive function is used by both message buffers, which store
+		discrete messages, and stream buffers, which store a continuous stream of
+		bytes.  Discrete messages include an additional
+		sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the
+		message. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
 		{
-			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			xBytesToStoreMessageLength = 0;
+		}
+
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+		/* Whether receiving a discrete message (where xBytesToStoreMessageLength
+		holds the number of bytes used to store the message length) or a stream of
+		bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+		available must be greater than xBytesToStoreMessageLength to be able to
+		read bytes from the buffer. */
+		if( xBytesAvailable > xBytesToStoreMessageLength )
+		{
+			xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
+
+			/* Was a task waiting for space in the buffer? */
+			if( xReceivedLength != ( size_t ) 0 )
+			{
+				sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+				sbWAKE_ASYNC_TASKS_FROM_ISR( pxStreamBuffer, asyncWAITING_TO_SEND, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
 
-	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+		traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+	}
 
 	return xReceivedLength;
 }
@@ -899,274 +1189,1446 @@ size_t xOriginalTail, xReceivedLength, xNextMessageLength;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
+size_t xStreamBufferGetWriteSpans( StreamBufferHandle_t xStreamBuffer,
+								   StreamBufferSpan_t pxSpans[ 2 ],
+								   TickType_t xTicksToWait )
 {
-const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
-BaseType_t xReturn;
-size_t xTail;
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xSpace;
+TimeOut_t xTimeOut;
 
 	configASSERT( pxStreamBuffer );
+	configASSERT( pxSpans );
 
-	/* True if no bytes are available. */
-	xTail = pxStreamBuffer->xTail;
-	if( pxStreamBuffer->xHead == xTail )
+	/* Spans can only be used with single writer, single reader stream buffers
+	as the length prefix of a message cannot be written in place, and the
+	reservations made by multiple writers are not contiguous. */
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
 	{
-		xReturn = pdTRUE;
+		configASSERT( !sbIS_MPMC( pxStreamBuffer ) );
+	}
+	#endif
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* Wait until at least one byte is free in the stream buffer. */
+			taskENTER_CRITICAL();
+			{
+				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+				if( xSpace == ( size_t ) 0 )
+				{
+					/* Clear notification state as going to wait for space. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one writer. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					taskEXIT_CRITICAL();
+					break;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
 	}
 	else
 	{
-		xReturn = pdFALSE;
+		mtCOVERAGE_TEST_MARKER();
 	}
 
-	return xReturn;
+	xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+	return prvGetSpans( pxStreamBuffer, pxStreamBuffer->xHead, xSpace, pxSpans );
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
+size_t xStreamBufferGetWriteSpansFromISR( StreamBufferHandle_t xStreamBuffer,
+										  StreamBufferSpan_t pxSpans[ 2 ] )
 {
-BaseType_t xReturn;
-size_t xBytesToStoreMessageLength;
-const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
 
 	configASSERT( pxStreamBuffer );
-
-	/* This generic version of the receive function is used by both message
-	buffers, which store discrete messages, and stream buffers, which store a
-	continuous stream of bytes.  Discrete messages include an additional
-	sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the message. */
-	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	configASSERT( pxSpans );
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
 	{
-		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
-	}
-	else
-	{
-		xBytesToStoreMessageLength = 0;
+		configASSERT( !sbIS_MPMC( pxStreamBuffer ) );
 	}
+	#endif
 
-	/* True if the available space equals zero. */
-	if( xStreamBufferSpacesAvailable( xStreamBuffer ) <= xBytesToStoreMessageLength )
+	return prvGetSpans( pxStreamBuffer, pxStreamBuffer->xHead, xStreamBufferSpacesAvailable( pxStreamBuffer ), pxSpans );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommitWrite( pxStreamBuffer, xBytesWritten );
+
+	if( xReturn > ( size_t ) 0 )
 	{
-		xReturn = pdTRUE;
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+			sbWAKE_ASYNC_TASKS( pxStreamBuffer, asyncWAITING_TO_RECEIVE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
 	else
 	{
-		xReturn = pdFALSE;
+		mtCOVERAGE_TEST_MARKER();
 	}
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken )
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xBytesWritten,
+										BaseType_t * const pxHigherPriorityTaskWoken )
 {
 StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
-BaseType_t xReturn;
-UBaseType_t uxSavedInterruptStatus;
+size_t xReturn;
 
 	configASSERT( pxStreamBuffer );
 
-	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	xReturn = prvCommitWrite( pxStreamBuffer, xBytesWritten );
+
+	if( xReturn > ( size_t ) 0 )
 	{
-		if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
 		{
-			( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,
-										 ( uint32_t ) 0,
-										 eNoAction,
-										 pxHigherPriorityTaskWoken );
-			( pxStreamBuffer )->xTaskWaitingToReceive = NULL;
-			xReturn = pdTRUE;
+			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			sbWAKE_ASYNC_TASKS_FROM_ISR( pxStreamBuffer, asyncWAITING_TO_RECEIVE, pxHigherPriorityTaskWoken );
 		}
 		else
 		{
-			xReturn = pdFALSE;
+			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken )
+size_t xStreamBufferGetReadSpans( StreamBufferHandle_t xStreamBuffer,
+								  StreamBufferSpan_t pxSpans[ 2 ],
+								  TickType_t xTicksToWait )
 {
 StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
-BaseType_t xReturn;
-UBaseType_t uxSavedInterruptStatus;
+size_t xBytesAvailable;
 
 	configASSERT( pxStreamBuffer );
+	configASSERT( pxSpans );
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	{
+		configASSERT( !sbIS_MPMC( pxStreamBuffer ) );
+	}
+	#endif
 
-	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	if( xTicksToWait != ( TickType_t ) 0 )
 	{
-		if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
+		/* Checking if there is data and clearing the notification state must be
+		performed atomically. */
+		taskENTER_CRITICAL();
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+			if( xBytesAvailable == ( size_t ) 0 )
+			{
+				/* Clear notification state as going to wait for data. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one reader. */
+				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBytesAvailable == ( size_t ) 0 )
 		{
-			( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,
-										 ( uint32_t ) 0,
-										 eNoAction,
-										 pxHigherPriorityTaskWoken );
-			( pxStreamBuffer )->xTaskWaitingToSend = NULL;
-			xReturn = pdTRUE;
+			/* Wait for data to be available. */
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+			/* Recheck the data available after blocking. */
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 		}
 		else
 		{
-			xReturn = pdFALSE;
+			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	else
+	{
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	}
 
-	return xReturn;
+	return prvGetSpans( pxStreamBuffer, pxStreamBuffer->xTail, xBytesAvailable, pxSpans );
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
+size_t xStreamBufferGetReadSpansFromISR( StreamBufferHandle_t xStreamBuffer,
+										 StreamBufferSpan_t pxSpans[ 2 ] )
 {
-size_t xNextHead, xFirstLength;
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
 
-	configASSERT( xCount > ( size_t ) 0 );
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxSpans );
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	{
+		configASSERT( !sbIS_MPMC( pxStreamBuffer ) );
+	}
+	#endif
 
-	xNextHead = pxStreamBuffer->xHead;
+	return prvGetSpans( pxStreamBuffer, pxStreamBuffer->xTail, prvBytesInBuffer( pxStreamBuffer ), pxSpans );
+}
+/*-----------------------------------------------------------*/
 
-	/* Calculate the number of bytes that can be added in the first write -
-	which may be less than the total number of bytes that need to be added if
-	the buffer will wrap back to the beginning. */
-	xFirstLength = configMIN( pxStreamBuffer->xLength - xNextHead, xCount );
+size_t xStreamBufferCommitRead( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReturn;
 
-	/* Write as many bytes as can be written in the first write. */
-	configASSERT( ( xNextHead + xFirstLength ) <= pxStreamBuffer->xLength );
-	memcpy( ( void* ) ( &( pxStreamBuffer->pucBuffer[ xNextHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	configASSERT( pxStreamBuffer );
 
-	/* If the number of bytes written was less than the number that could be
-	written in the first write... */
-	if( xCount > xFirstLength )
+	xReturn = prvCommitRead( pxStreamBuffer, xBytesRead );
+
+	/* Was a task waiting for space in the buffer? */
+	if( xReturn > ( size_t ) 0 )
 	{
-		/* ...then write the remaining bytes to the start of the buffer. */
-		configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
-		memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+		sbWAKE_ASYNC_TASKS( pxStreamBuffer, asyncWAITING_TO_SEND );
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	xNextHead += xCount;
-	if( xNextHead >= pxStreamBuffer->xLength )
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommitReadFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xBytesRead,
+									   BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommitRead( pxStreamBuffer, xBytesRead );
+
+	/* Was a task waiting for space in the buffer? */
+	if( xReturn > ( size_t ) 0 )
 	{
-		xNextHead -= pxStreamBuffer->xLength;
+		sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		sbWAKE_ASYNC_TASKS_FROM_ISR( pxStreamBuffer, asyncWAITING_TO_SEND, pxHigherPriorityTaskWoken );
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	pxStreamBuffer->xHead = xNextHead;
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
 
-	return xCount;
+	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xMaxCount, size_t xBytesAvailable )
+static size_t prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+						   size_t xOffset,
+						   size_t xCount,
+						   StreamBufferSpan_t pxSpans[ 2 ] )
 {
-size_t xCount, xFirstLength, xNextTail;
+size_t xFirstLength;
 
-	/* Use the minimum of the wanted bytes and the available bytes. */
-	xCount = configMIN( xBytesAvailable, xMaxCount );
+	/* The first span runs from xOffset up to, at most, the end of the storage
+	area.  Anything left over wraps to the start of the storage area. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xOffset, xCount );
 
-	if( xCount > ( size_t ) 0 )
+	if( xFirstLength > ( size_t ) 0 )
+	{
+		pxSpans[ 0 ].pucData = &( pxStreamBuffer->pucBuffer[ xOffset ] );
+	}
+	else
 	{
-		xNextTail = pxStreamBuffer->xTail;
+		pxSpans[ 0 ].pucData = NULL;
+	}
+	pxSpans[ 0 ].xLength = xFirstLength;
 
-		/* Calculate the number of bytes that can be read - which may be
-		less than the number wanted if the data wraps around to the start of
-		the buffer. */
-		xFirstLength = configMIN( pxStreamBuffer->xLength - xNextTail, xCount );
+	if( xCount > xFirstLength )
+	{
+		pxSpans[ 1 ].pucData = pxStreamBuffer->pucBuffer;
+	}
+	else
+	{
+		pxSpans[ 1 ].pucData = NULL;
+	}
+	pxSpans[ 1 ].xLength = xCount - xFirstLength;
 
-		/* Obtain the number of bytes it is possible to obtain in the first
-		read.  Asserts check bounds of read and write. */
-		configASSERT( xFirstLength <= xMaxCount );
-		configASSERT( ( xNextTail + xFirstLength ) <= pxStreamBuffer->xLength );
-		memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommitWrite( StreamBuffer_t * const pxStreamBuffer, size_t xCount )
+{
+size_t xReturn, xHead;
+
+	/* Cannot commit more bytes than were free. */
+	configASSERT( xCount <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+	if( ( xCount > ( size_t ) 0 ) && ( xCount <= xStreamBufferSpacesAvailable( pxStreamBuffer ) ) )
+	{
+		xHead = pxStreamBuffer->xHead + xCount;
 
-		/* If the total number of wanted bytes is greater than the number
-		that could be read in the first read... */
-		if( xCount > xFirstLength )
+		if( xHead >= pxStreamBuffer->xLength )
 		{
-			/*...then read the remaining bytes from the start of the buffer. */
-			configASSERT( xCount <= xMaxCount );
-			memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+			xHead -= pxStreamBuffer->xLength;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		/* Move the tail pointer to effectively remove the data read from
-		the buffer. */
-		xNextTail += xCount;
-
-		if( xNextTail >= pxStreamBuffer->xLength )
-		{
-			xNextTail -= pxStreamBuffer->xLength;
-		}
-
-		pxStreamBuffer->xTail = xNextTail;
+		/* The bytes were written directly into the storage area, possibly by
+		another bus master, so ensure they are visible before the reader can
+		see the new head index. */
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xHead = xHead;
+		xReturn = xCount;
 	}
 	else
 	{
-		mtCOVERAGE_TEST_MARKER();
+		xReturn = 0;
 	}
 
-	return xCount;
+	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+static size_t prvCommitRead( StreamBuffer_t * const pxStreamBuffer, size_t xCount )
 {
-/* Returns the distance between xTail and xHead. */
-size_t xCount;
+size_t xReturn, xTail;
 
-	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
-	xCount -= pxStreamBuffer->xTail;
-	if ( xCount >= pxStreamBuffer->xLength )
-	{
-		xCount -= pxStreamBuffer->xLength;
-	}
-	else
+	/* Cannot commit more bytes than were available. */
+	configASSERT( xCount <= prvBytesInBuffer( pxStreamBuffer ) );
+
+	if( ( xCount > ( size_t ) 0 ) && ( xCount <= prvBytesInBuffer( pxStreamBuffer ) ) )
 	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+		xTail = pxStreamBuffer->xTail + xCount;
 
-	return xCount;
+		if( xTail >= pxStreamBuffer->xLength )
+		{
+			xTail -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Ensure the reader has finished with the bytes before the writer can
+		see the space they occupied as free. */
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xTail = xTail;
+		xReturn = xCount;
+	}
+	else
+	{
+		xReturn = 0;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
+{
+const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+BaseType_t xReturn;
+size_t xTail;
+
+	configASSERT( pxStreamBuffer );
+
+	/* True if no bytes are available.  Bytes that are being read from a
+	multi-producer, multi-consumer buffer are no longer available. */
+	xTail = pxStreamBuffer->xTail;
+
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	{
+		if( sbIS_MPMC( pxStreamBuffer ) )
+		{
+			xTail = pxStreamBuffer->xReservedTail;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
+
+	if( pxStreamBuffer->xHead == xTail )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
+{
+BaseType_t xReturn;
+size_t xBytesToStoreMessageLength;
+const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+
+	configASSERT( pxStreamBuffer );
+
+	/* This generic version of the receive function is used by both message
+	buffers, which store discrete messages, and stream buffers, which store a
+	continuous stream of bytes.  Discrete messages include an additional
+	sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the message. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		xBytesToStoreMessageLength = 0;
+	}
+
+	/* True if the available space equals zero. */
+	if( xStreamBufferSpacesAvailable( xStreamBuffer ) <= xBytesToStoreMessageLength )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxStreamBuffer );
+
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	if( sbIS_MPMC( pxStreamBuffer ) )
+	{
+		xReturn = pdFALSE;
+
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+		{
+			if( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToReceive ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxStreamBuffer->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
+	{
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+		{
+			if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
+			{
+				( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,
+											 ( uint32_t ) 0,
+											 eNoAction,
+											 pxHigherPriorityTaskWoken );
+				( pxStreamBuffer )->xTaskWaitingToReceive = NULL;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxStreamBuffer );
+
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	if( sbIS_MPMC( pxStreamBuffer ) )
+	{
+		xReturn = pdFALSE;
+
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+		{
+			if( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxStreamBuffer->xTasksWaitingToSend ) ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
+	{
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+		{
+			if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
+			{
+				( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,
+											 ( uint32_t ) 0,
+											 eNoAction,
+											 pxHigherPriorityTaskWoken );
+				( pxStreamBuffer )->xTaskWaitingToSend = NULL;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCopyBytesToBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xOffset, const uint8_t *pucData, size_t xCount )
+{
+size_t xFirstLength;
+
+	/* Calculate the number of bytes that can be added in the first write -
+	which may be less than the total number of bytes that need to be added if
+	the buffer will wrap back to the beginning. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xOffset, xCount );
+
+	/* Write as many bytes as can be written in the first write. */
+	configASSERT( ( xOffset + xFirstLength ) <= pxStreamBuffer->xLength );
+	memcpy( ( void* ) ( &( pxStreamBuffer->pucBuffer[ xOffset ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	/* If the number of bytes written was less than the number that could be
+	written in the first write... */
+	if( xCount > xFirstLength )
+	{
+		/* ...then write the remaining bytes to the start of the buffer. */
+		configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
+		memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xOffset += xCount;
+	if( xOffset >= pxStreamBuffer->xLength )
+	{
+		xOffset -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xOffset;
 }
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
-										  uint8_t * const pucBuffer,
-										  size_t xBufferSizeBytes,
-										  size_t xTriggerLevelBytes,
-										  BaseType_t xIsMessageBuffer )
-{
-	/* Assert here is deliberately writing to the entire buffer to ensure it can
-	be written to without generating exceptions, and is setting the buffer to a
-	known value to assist in development/debugging. */
-	#if( configASSERT_DEFINED == 1 )
+static size_t prvCopyBytesFromBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xOffset, uint8_t *pucData, size_t xCount )
+{
+size_t xFirstLength;
+
+	/* Calculate the number of bytes that can be read - which may be less than
+	the number wanted if the data wraps around to the start of the buffer. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xOffset, xCount );
+
+	/* Obtain the number of bytes it is possible to obtain in the first read.
+	Asserts check bounds of read and write. */
+	configASSERT( ( xOffset + xFirstLength ) <= pxStreamBuffer->xLength );
+	memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xOffset ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	/* If the total number of wanted bytes is greater than the number that
+	could be read in the first read... */
+	if( xCount > xFirstLength )
+	{
+		/*...then read the remaining bytes from the start of the buffer. */
+		configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
+		memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xOffset += xCount;
+	if( xOffset >= pxStreamBuffer->xLength )
+	{
+		xOffset -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xOffset;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
+{
+	configASSERT( xCount > ( size_t ) 0 );
+
+	pxStreamBuffer->xHead = prvCopyBytesToBuffer( pxStreamBuffer, pxStreamBuffer->xHead, pucData, xCount );
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xMaxCount, size_t xBytesAvailable )
+{
+size_t xCount;
+
+	/* Use the minimum of the wanted bytes and the available bytes. */
+	xCount = configMIN( xBytesAvailable, xMaxCount );
+
+	if( xCount > ( size_t ) 0 )
+	{
+		/* Move the tail pointer to effectively remove the data read from
+		the buffer. */
+		pxStreamBuffer->xTail = prvCopyBytesFromBuffer( pxStreamBuffer, pxStreamBuffer->xTail, pucData, xCount );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+{
+/* Returns the distance between xTail and xHead. */
+size_t xCount;
+
+	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+	xCount -= pxStreamBuffer->xTail;
+	if ( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
+										  uint8_t * const pucBuffer,
+										  size_t xBufferSizeBytes,
+										  size_t xTriggerLevelBytes,
+										  BaseType_t xStreamBufferType )
+{
+	/* Assert here is deliberately writing to the entire buffer to ensure it can
+	be written to without generating exceptions, and is setting the buffer to a
+	known value to assist in development/debugging. */
+	#if( configASSERT_DEFINED == 1 )
+	{
+		/* The value written just has to be identifiable when looking at the
+		memory.  Don't use 0xA5 as that is the stack fill value and could
+		result in confusion as to what is actually being observed. */
+		const BaseType_t xWriteValue = 0x55;
+		configASSERT( memset( pucBuffer, ( int ) xWriteValue, xBufferSizeBytes ) == pucBuffer );
+	}
+	#endif
+
+	memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) ); /*lint !e9087 memset() requires void *. */
+	pxStreamBuffer->pucBuffer = pucBuffer;
+	pxStreamBuffer->xLength = xBufferSizeBytes;
+	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+
+	#if( configUSE_ASYNC_TASKS == 1 )
+	{
+		vListInitialise( &( pxStreamBuffer->xAsyncTasksWaiting ) );
+	}
+	#endif /* configUSE_ASYNC_TASKS */
+
+	if( ( xStreamBufferType & sbTYPE_MESSAGE_BUFFER ) != ( BaseType_t ) 0 )
+	{
+		pxStreamBuffer->ucFlags |= sbFLAGS_IS_MESSAGE_BUFFER;
+	}
+
+	#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+	{
+		if( ( xStreamBufferType & sbTYPE_MPMC_STREAM_BUFFER ) != ( BaseType_t ) 0 )
+		{
+			pxStreamBuffer->ucFlags |= sbFLAGS_IS_MPMC;
+			vListInitialise( &( pxStreamBuffer->xTasksWaitingToSend ) );
+			vListInitialise( &( pxStreamBuffer->xTasksWaitingToReceive ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* Multi-producer, multi-consumer buffers are only available when
+		configUSE_MPMC_STREAM_BUFFERS is 1. */
+		configASSERT( ( xStreamBufferType & sbTYPE_MPMC_STREAM_BUFFER ) == ( BaseType_t ) 0 );
+	}
+	#endif /* configUSE_MPMC_STREAM_BUFFERS */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	static size_t prvSendMPMC( StreamBuffer_t * const pxStreamBuffer,
+							   const void *pvTxData,
+							   size_t xDataLengthBytes,
+							   TickType_t xTicksToWait,
+							   BaseType_t xFromISR,
+							   BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	size_t xOffset = 0, xCount = 0;
+	BaseType_t xReserved = pdFALSE, xYieldRequired;
+	UBaseType_t uxSavedInterruptStatus;
+	TimeOut_t xTimeOut;
+
+		if( xFromISR != pdFALSE )
+		{
+			uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+			{
+				xReserved = prvReserveWriteMPMC( pxStreamBuffer, xDataLengthBytes, pdTRUE, &xOffset, &xCount );
+			}
+			taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+
+			for( ;; )
+			{
+				taskENTER_CRITICAL();
+				{
+					/* A stream buffer write only writes part of the data if
+					the task will not wait for space for all of it. */
+					xReserved = prvReserveWriteMPMC( pxStreamBuffer, xDataLengthBytes, ( xTicksToWait == ( TickType_t ) 0 ) ? pdTRUE : pdFALSE, &xOffset, &xCount );
+
+					if( ( xReserved == pdFALSE ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+					{
+						/* Wait for a reader to free space.  Interrupts are
+						disabled until the task has been added to the event
+						list, so a read that completes after the space was
+						checked cannot be missed. */
+						traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
+						vTaskPlaceOnEventList( &( pxStreamBuffer->xTasksWaitingToSend ), xTicksToWait );
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( ( xReserved != pdFALSE ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+				{
+					break;
+				}
+				else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+				{
+					/* Timed out.  Try once more without blocking, which
+					writes as many bytes as will fit to a stream buffer. */
+					xTicksToWait = ( TickType_t ) 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+
+		if( xReserved != pdFALSE )
+		{
+			/* The reserved region belongs to this writer alone, so the data is
+			copied with interrupts enabled. */
+			if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+			{
+				xOffset = prvCopyBytesToBuffer( pxStreamBuffer, xOffset, ( const uint8_t * ) &xCount, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xCount > ( size_t ) 0 )
+			{
+				( void ) prvCopyBytesToBuffer( pxStreamBuffer, xOffset, ( const uint8_t * ) pvTxData, xCount ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xFromISR != pdFALSE )
+			{
+				uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+				{
+					xYieldRequired = prvCompleteWriteMPMC( pxStreamBuffer );
+				}
+				taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+				if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				taskENTER_CRITICAL();
+				{
+					xYieldRequired = prvCompleteWriteMPMC( pxStreamBuffer );
+				}
+				taskEXIT_CRITICAL();
+
+				if( xYieldRequired != pdFALSE )
+				{
+					sbYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			xCount = 0;
+		}
+
+		if( xFromISR != pdFALSE )
+		{
+			traceSTREAM_BUFFER_SEND_FROM_ISR( pxStreamBuffer, xCount );
+		}
+		else if( xCount > ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_SEND( pxStreamBuffer, xCount );
+		}
+		else
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( pxStreamBuffer );
+		}
+
+		return xCount;
+	}
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	static size_t prvReceiveMPMC( StreamBuffer_t * const pxStreamBuffer,
+								  void *pvRxData,
+								  size_t xBufferLengthBytes,
+								  TickType_t xTicksToWait,
+								  BaseType_t xFromISR,
+								  BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	size_t xOffset = 0, xCount = 0;
+	BaseType_t xReserved = pdFALSE, xYieldRequired = pdFALSE;
+	UBaseType_t uxSavedInterruptStatus;
+	TimeOut_t xTimeOut;
+
+		if( xFromISR != pdFALSE )
+		{
+			uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+			{
+				if( prvBytesAvailableMPMC( pxStreamBuffer ) != ( size_t ) 0 )
+				{
+					xReserved = prvReserveReadMPMC( pxStreamBuffer, xBufferLengthBytes, &xOffset, &xCount );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+
+			for( ;; )
+			{
+				taskENTER_CRITICAL();
+				{
+					if( prvBytesAvailableMPMC( pxStreamBuffer ) != ( size_t ) 0 )
+					{
+						xReserved = prvReserveReadMPMC( pxStreamBuffer, xBufferLengthBytes, &xOffset, &xCount );
+
+						if( xReserved == pdFALSE )
+						{
+							/* The next message does not fit in the buffer
+							provided, so is left for another reader. */
+							xYieldRequired = prvUnblockWaitingTasksMPMC( pxStreamBuffer );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						/* As with other stream buffers, a read only blocks
+						if the buffer is empty. */
+						xTicksToWait = ( TickType_t ) 0;
+					}
+					else if( xTicksToWait != ( TickType_t ) 0 )
+					{
+						/* Wait for a writer to provide data.  Interrupts are
+						disabled until the task has been added to the event
+						list, so a write that completes after the data was
+						checked cannot be missed. */
+						traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+						vTaskPlaceOnEventList( &( pxStreamBuffer->xTasksWaitingToReceive ), xTicksToWait );
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					break;
+				}
+				else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+				{
+					/* Timed out.  Check for data once more without
+					blocking. */
+					xTicksToWait = ( TickType_t ) 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+
+		if( xReserved != pdFALSE )
+		{
+			/* The reserved region belongs to this reader alone, so the data is
+			copied with interrupts enabled. */
+			if( xCount > ( size_t ) 0 )
+			{
+				( void ) prvCopyBytesFromBuffer( pxStreamBuffer, xOffset, ( uint8_t * ) pvRxData, xCount ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xFromISR != pdFALSE )
+			{
+				uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+				{
+					xYieldRequired = prvCompleteReadMPMC( pxStreamBuffer );
+				}
+				taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+			}
+			else
+			{
+				taskENTER_CRITICAL();
+				{
+					xYieldRequired = prvCompleteReadMPMC( pxStreamBuffer );
+				}
+				taskEXIT_CRITICAL();
+			}
+		}
+		else
+		{
+			xCount = 0;
+		}
+
+		if( xYieldRequired != pdFALSE )
+		{
+			if( xFromISR != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				sbYIELD_IF_USING_PREEMPTION();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xFromISR != pdFALSE )
+		{
+			traceSTREAM_BUFFER_RECEIVE_FROM_ISR( pxStreamBuffer, xCount );
+		}
+		else if( xCount > ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_RECEIVE( pxStreamBuffer, xCount );
+		}
+		else
+		{
+			traceSTREAM_BUFFER_RECEIVE_FAILED( pxStreamBuffer );
+		}
+
+		return xCount;
+	}
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	static BaseType_t prvReserveWriteMPMC( StreamBuffer_t * const pxStreamBuffer,
+										   size_t xDataLengthBytes,
+										   BaseType_t xAcceptPartial,
+										   size_t *pxOffset,
+										   size_t *pxCount )
 	{
-		/* The value written just has to be identifiable when looking at the
-		memory.  Don't use 0xA5 as that is the stack fill value and could
-		result in confusion as to what is actually being observed. */
-		const BaseType_t xWriteValue = 0x55;
-		configASSERT( memset( pucBuffer, ( int ) xWriteValue, xBufferSizeBytes ) == pucBuffer );
+	size_t xSpace, xCount, xRequiredSpace;
+	BaseType_t xReturn;
+
+		xSpace = prvSpacesAvailableMPMC( pxStreamBuffer );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* A message is written whole, with its length, or not at all. */
+			xCount = xDataLengthBytes;
+			xRequiredSpace = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+			if( xSpace >= xRequiredSpace )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		else
+		{
+			if( xAcceptPartial != pdFALSE )
+			{
+				xCount = configMIN( xDataLengthBytes, xSpace );
+			}
+			else if( xSpace >= xDataLengthBytes )
+			{
+				xCount = xDataLengthBytes;
+			}
+			else
+			{
+				xCount = 0;
+			}
+
+			xRequiredSpace = xCount;
+
+			if( xCount > ( size_t ) 0 )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+
+		if( xReturn != pdFALSE )
+		{
+			*pxOffset = pxStreamBuffer->xReservedHead;
+			*pxCount = xCount;
+
+			pxStreamBuffer->xReservedHead += xRequiredSpace;
+			if( pxStreamBuffer->xReservedHead >= pxStreamBuffer->xLength )
+			{
+				pxStreamBuffer->xReservedHead -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( pxStreamBuffer->uxWritesInProgress )++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
 	}
-	#endif
 
-	memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) ); /*lint !e9087 memset() requires void *. */
-	pxStreamBuffer->pucBuffer = pucBuffer;
-	pxStreamBuffer->xLength = xBufferSizeBytes;
-	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
 
-	if( xIsMessageBuffer != pdFALSE )
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	static BaseType_t prvReserveReadMPMC( StreamBuffer_t * const pxStreamBuffer,
+										  size_t xBufferLengthBytes,
+										  size_t *pxOffset,
+										  size_t *pxCount )
 	{
-		pxStreamBuffer->ucFlags |= sbFLAGS_IS_MESSAGE_BUFFER;
+	size_t xOffset, xCount, xReservedLength;
+	BaseType_t xReturn;
+
+		xOffset = pxStreamBuffer->xReservedTail;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* Only whole messages are ever made available to readers, so if
+			there are any bytes available the next message is complete.  Read
+			its length to find out whether it fits in the buffer provided. */
+			xOffset = prvCopyBytesFromBuffer( pxStreamBuffer, xOffset, ( uint8_t * ) &xCount, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			xReservedLength = xCount + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+			if( xCount <= xBufferLengthBytes )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		else
+		{
+			xCount = configMIN( prvBytesAvailableMPMC( pxStreamBuffer ), xBufferLengthBytes );
+			xReservedLength = xCount;
+
+			if( xCount > ( size_t ) 0 )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+
+		if( xReturn != pdFALSE )
+		{
+			*pxOffset = xOffset;
+			*pxCount = xCount;
+
+			pxStreamBuffer->xReservedTail += xReservedLength;
+			if( pxStreamBuffer->xReservedTail >= pxStreamBuffer->xLength )
+			{
+				pxStreamBuffer->xReservedTail -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( pxStreamBuffer->uxReadsInProgress )++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
 	}
-}
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	static BaseType_t prvCompleteWriteMPMC( StreamBuffer_t * const pxStreamBuffer )
+	{
+		configASSERT( pxStreamBuffer->uxWritesInProgress > ( UBaseType_t ) 0 );
+		( pxStreamBuffer->uxWritesInProgress )--;
+
+		/* Writes can complete in a different order to the order in which they
+		reserved space, so the data is only made available to readers once no
+		writes are in progress, at which point every reserved byte has been
+		written. */
+		if( pxStreamBuffer->uxWritesInProgress == ( UBaseType_t ) 0 )
+		{
+			pxStreamBuffer->xHead = pxStreamBuffer->xReservedHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return prvUnblockWaitingTasksMPMC( pxStreamBuffer );
+	}
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	static BaseType_t prvCompleteReadMPMC( StreamBuffer_t * const pxStreamBuffer )
+	{
+		configASSERT( pxStreamBuffer->uxReadsInProgress > ( UBaseType_t ) 0 );
+		( pxStreamBuffer->uxReadsInProgress )--;
+
+		/* As for writes, the space is only made available to writers once no
+		reads are in progress. */
+		if( pxStreamBuffer->uxReadsInProgress == ( UBaseType_t ) 0 )
+		{
+			pxStreamBuffer->xTail = pxStreamBuffer->xReservedTail;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return prvUnblockWaitingTasksMPMC( pxStreamBuffer );
+	}
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	static BaseType_t prvUnblockWaitingTasksMPMC( StreamBuffer_t * const pxStreamBuffer )
+	{
+	BaseType_t xReturn = pdFALSE;
+	size_t xMinimumSpace;
+
+		if( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToReceive ) ) == pdFALSE )
+		{
+			/* The trigger level does not apply to message buffers, for which
+			any available bytes form at least one complete message. */
+			if( ( ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) && ( prvBytesAvailableMPMC( pxStreamBuffer ) != ( size_t ) 0 ) ) ||
+				( prvBytesAvailableMPMC( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) )
+			{
+				if( xTaskRemoveFromEventList( &( pxStreamBuffer->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE )
+		{
+			/* The amount of space the waiting writer needs is not known, so it
+			is unblocked if any data can be written.  Writers are unblocked in
+			priority order, so a writer that still cannot write blocks again
+			ahead of any lower priority writers. */
+			if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+			{
+				xMinimumSpace = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+			}
+			else
+			{
+				xMinimumSpace = 0;
+			}
+
+			if( prvSpacesAvailableMPMC( pxStreamBuffer ) > xMinimumSpace )
+			{
+				if( xTaskRemoveFromEventList( &( pxStreamBuffer->xTasksWaitingToSend ) ) != pdFALSE )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	static size_t prvSpacesAvailableMPMC( const StreamBuffer_t * const pxStreamBuffer )
+	{
+	size_t xSpace;
+
+		/* Space is freed when reads complete, and used when writes are
+		reserved. */
+		xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+		xSpace -= pxStreamBuffer->xReservedHead;
+		xSpace -= ( size_t ) 1;
+
+		if( xSpace >= pxStreamBuffer->xLength )
+		{
+			xSpace -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSpace;
+	}
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+	static size_t prvBytesAvailableMPMC( const StreamBuffer_t * const pxStreamBuffer )
+	{
+	size_t xCount;
+
+		/* Data is made available when writes complete, and used when reads are
+		reserved. */
+		xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+		xCount -= pxStreamBuffer->xReservedTail;
+
+		if( xCount >= pxStreamBuffer->xLength )
+		{
+			xCount -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xCount;
+	}
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
@@ -1197,3 +2659,25 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_ASYNC_TASKS == 1 )
+
+	void *pvStreamBufferGetAsyncTaskList( StreamBufferHandle_t xStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+
+		configASSERT( pxStreamBuffer );
+
+		/* Multi-producer, multi-consumer buffers block tasks in their own event
+		lists, and async tasks cannot be held in those. */
+		#if( configUSE_MPMC_STREAM_BUFFERS == 1 )
+		{
+			configASSERT( !sbIS_MPMC( pxStreamBuffer ) );
+		}
+		#endif /* configUSE_MPMC_STREAM_BUFFERS */
+
+		return ( void * ) &( pxStreamBuffer->xAsyncTasksWaiting );
+	}
+
+#endif /* configUSE_ASYNC_TASKS */
+/*-----------------------------------------------------------*/
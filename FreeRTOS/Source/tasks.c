@@ -40,6 +40,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "stack_macros.h"
 
+#if( configTASK_POOL_LENGTH > 0 )
+	#include "pool.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -64,7 +68,8 @@ functions but without including stdio.h here. */
 	#define taskYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
-/* Values that can be assigned to the ucNotifyState member of the TCB. */
+/* Values that can be assigned to the entries of the ucNotifyState array in the
+TCB. */
 #define taskNOT_WAITING_NOTIFICATION	( ( uint8_t ) 0 )
 #define taskWAITING_NOTIFICATION		( ( uint8_t ) 1 )
 #define taskNOTIFICATION_RECEIVED		( ( uint8_t ) 2 )
@@ -97,6 +102,17 @@ changed then the definition of StaticTask_t must also be updated. */
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY 			( ( uint8_t ) 1 )
 #define tskSTATICALLY_ALLOCATED_STACK_AND_TCB		( ( uint8_t ) 2 )
 
+/* When configTASK_POOL_LENGTH is greater than zero dynamically allocated TCBs
+are taken from the kernel's task pool, and only come from the heap if the pool
+is empty.  The stacks are always allocated from the heap. */
+#if( configTASK_POOL_LENGTH > 0 )
+	#define tskALLOCATE_TCB()		( ( TCB_t * ) pvPoolAllocKernelObject( poolKERNEL_POOL_TASKS, sizeof( TCB_t ) ) )
+	#define tskFREE_TCB( pxTCB )	vPoolFreeKernelObject( poolKERNEL_POOL_TASKS, ( void * ) ( pxTCB ) )
+#else
+	#define tskALLOCATE_TCB()		( ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ) )
+	#define tskFREE_TCB( pxTCB )	vPortFree( pxTCB )
+#endif
+
 /* If any of the following are set then task stacks are filled with a known
 value so the high water mark can be determined.  If none of the following are
 set then don't fill the stack so there is no unnecessary dependency on memset. */
@@ -129,7 +145,59 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* The ready list of priority configEDF_TASK_PRIORITY is held in order of
+	deadline, so the task at its head, which has the earliest deadline, is
+	always selected from it, and tasks of that priority are not time sliced.
+	Tasks of other priorities take it in turn to run. */
+	#define taskSELECT_TASK_FROM_READY_LIST( uxTopPriority )											\
+	{																									\
+		if( ( uxTopPriority ) == ( UBaseType_t ) configEDF_TASK_PRIORITY )								\
+		{																								\
+			pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxTopPriority ) ] ) );	\
+		}																								\
+		else																							\
+		{																								\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxTopPriority ) ] ) );	\
+		}																								\
+	} /* taskSELECT_TASK_FROM_READY_LIST */
+
+	#define taskPRIORITY_IS_TIME_SLICED( uxPriority ) ( ( uxPriority ) != ( UBaseType_t ) configEDF_TASK_PRIORITY )
+
+	/* Deadlines wrap with the tick count, so are compared relative to each
+	other.  xDeadlineA is earlier than xDeadlineB if xDeadlineA - xDeadlineB
+	is negative when treated as a signed value. */
+	#define taskDEADLINE_IS_BEFORE( xDeadlineA, xDeadlineB ) ( ( TickType_t ) ( ( xDeadlineA ) - ( xDeadlineB ) ) > ( portMAX_DELAY >> 1 ) )
+
+	/* pxTCB, which has just been made ready, should run in place of the
+	running task if it has a higher priority, or if both tasks are EDF tasks
+	and pxTCB has the earlier deadline. */
+	#define taskPREEMPTS_CURRENT_TASK( pxTCB )																		\
+		( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||													\
+		  ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&									\
+			( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&								\
+			( taskDEADLINE_IS_BEFORE( ( pxTCB )->xDeadline, pxCurrentTCB->xDeadline ) != pdFALSE ) ) )
+
+#else
+
+	#define taskSELECT_TASK_FROM_READY_LIST( uxTopPriority ) listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxTopPriority ) ] ) )
+	#define taskPRIORITY_IS_TIME_SLICED( uxPriority ) ( pdTRUE )
+	#define taskPREEMPTS_CURRENT_TASK( pxTCB ) ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	/* Replenish times wrap with the tick count, so xTime has been reached if
+	xTickCount - xTime is not negative when treated as a signed value. */
+	#define taskBUDGET_TIME_IS_REACHED( xTime, xTickCount ) ( ( TickType_t ) ( ( xTickCount ) - ( xTime ) ) <= ( portMAX_DELAY >> 1 ) )
+
+#endif /* configUSE_TASK_BUDGETS */
+
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_BITMAP_TASK_SELECTION == 0 ) )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
 	performed in a generic way that is not optimised to any particular
@@ -160,7 +228,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 																										\
 		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
 		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskSELECT_TASK_FROM_READY_LIST( uxTopPriority );												\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -172,6 +240,104 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define taskRESET_READY_PRIORITY( uxPriority )
 	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
+#elif ( configUSE_BITMAP_TASK_SELECTION == 1 )
+
+	/* If configUSE_BITMAP_TASK_SELECTION is 1 then task selection is performed
+	in a generic way, but a bit is held for each priority that has ready tasks
+	so the highest priority ready task is found in constant time, whatever the
+	number of priorities.  Bit n of ulReadyPriorities[ w ] is set if the ready
+	list of priority ( ( w * 32 ) + n ) is not empty.  When there are more than
+	32 priorities bit w of ulReadyPriorityGroups is set if any bit in
+	ulReadyPriorities[ w ] is set. */
+	#define taskREADY_PRIORITY_WORDS	( ( configMAX_PRIORITIES + 31 ) / 32 )
+	#define taskREADY_PRIORITY_WORD( uxPriority )	( ( UBaseType_t ) ( uxPriority ) >> 5U )
+	#define taskREADY_PRIORITY_BIT( uxPriority )	( ( uint32_t ) 1UL << ( ( UBaseType_t ) ( uxPriority ) & ( UBaseType_t ) 0x1fU ) )
+
+	/* taskHIGHEST_SET_BIT() returns the position of the most significant set
+	bit in a non-zero 32-bit value.  A port can provide a faster version by
+	defining portHIGHEST_SET_BIT() in portmacro.h, otherwise the compiler's
+	count leading zeros built-in is used if there is one, and a lookup table if
+	not. */
+	#if defined( portHIGHEST_SET_BIT )
+		#define taskHIGHEST_SET_BIT( ulBits )	portHIGHEST_SET_BIT( ulBits )
+		#define taskUSE_HIGHEST_SET_BIT_LOOKUP	0
+	#elif defined( __GNUC__ )
+		#define taskHIGHEST_SET_BIT( ulBits )	( ( UBaseType_t ) ( ( sizeof( unsigned long ) * ( size_t ) 8U ) - ( size_t ) 1U ) - ( UBaseType_t ) __builtin_clzl( ( unsigned long ) ( ulBits ) ) )
+		#define taskUSE_HIGHEST_SET_BIT_LOOKUP	0
+	#else
+		#define taskHIGHEST_SET_BIT( ulBits )	prvHighestSetBit( ulBits )
+		#define taskUSE_HIGHEST_SET_BIT_LOOKUP	1
+	#endif
+
+	/*-----------------------------------------------------------*/
+
+	#if( taskREADY_PRIORITY_WORDS == 1 )
+
+		#define taskRECORD_READY_PRIORITY( uxPriority )														\
+		{																									\
+			ulReadyPriorities[ 0 ] |= taskREADY_PRIORITY_BIT( uxPriority );									\
+		} /* taskRECORD_READY_PRIORITY */
+
+		#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )									\
+		{																									\
+			ulReadyPriorities[ 0 ] &= ~taskREADY_PRIORITY_BIT( uxPriority );								\
+		} /* portRESET_READY_PRIORITY */
+
+		#define taskGET_HIGHEST_READY_PRIORITY( uxTopPriority )												\
+		{																									\
+			( uxTopPriority ) = taskHIGHEST_SET_BIT( ulReadyPriorities[ 0 ] );								\
+		} /* taskGET_HIGHEST_READY_PRIORITY */
+
+	#else
+
+		#define taskRECORD_READY_PRIORITY( uxPriority )														\
+		{																									\
+			ulReadyPriorities[ taskREADY_PRIORITY_WORD( uxPriority ) ] |= taskREADY_PRIORITY_BIT( uxPriority );	\
+			ulReadyPriorityGroups |= ( uint32_t ) 1UL << taskREADY_PRIORITY_WORD( uxPriority );			\
+		} /* taskRECORD_READY_PRIORITY */
+
+		#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )									\
+		{																									\
+			ulReadyPriorities[ taskREADY_PRIORITY_WORD( uxPriority ) ] &= ~taskREADY_PRIORITY_BIT( uxPriority );	\
+			if( ulReadyPriorities[ taskREADY_PRIORITY_WORD( uxPriority ) ] == ( uint32_t ) 0UL )			\
+			{																								\
+				ulReadyPriorityGroups &= ~( ( uint32_t ) 1UL << taskREADY_PRIORITY_WORD( uxPriority ) );	\
+			}																								\
+		} /* portRESET_READY_PRIORITY */
+
+		#define taskGET_HIGHEST_READY_PRIORITY( uxTopPriority )												\
+		{																									\
+		UBaseType_t uxWord = taskHIGHEST_SET_BIT( ulReadyPriorityGroups );									\
+																											\
+			( uxTopPriority ) = ( uxWord << 5U ) + taskHIGHEST_SET_BIT( ulReadyPriorities[ uxWord ] );		\
+		} /* taskGET_HIGHEST_READY_PRIORITY */
+
+	#endif /* taskREADY_PRIORITY_WORDS */
+
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()															\
+	{																									\
+	UBaseType_t uxTopPriority;																			\
+																										\
+		/* Find the highest priority list that contains ready tasks. */									\
+		taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );												\
+		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );			\
+		taskSELECT_TASK_FROM_READY_LIST( uxTopPriority );												\
+	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+
+	/*-----------------------------------------------------------*/
+
+	/* Only clear the bit for the priority if the TCB being reset was in the
+	ready list, and the ready list is now empty. */
+	#define taskRESET_READY_PRIORITY( uxPriority )														\
+	{																									\
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
+		{																								\
+			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+		}																								\
+	}
+
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
@@ -190,7 +356,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 		/* Find the highest priority list that contains ready tasks. */								\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_TASK_FROM_READY_LIST( uxTopPriority );											\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -210,33 +376,161 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 /*-----------------------------------------------------------*/
 
-/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
-#define taskSWITCH_DELAYED_LISTS()																	\
-{																									\
-	List_t *pxTemp;																					\
+#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+
+	/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the
+	tick count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																\
+	{																								\
+		List_t *pxTemp;																				\
 																									\
-	/* The delayed tasks list should be empty when the lists are switched. */						\
-	configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
+		/* The delayed tasks list should be empty when the lists are switched. */					\
+		configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );									\
 																									\
-	pxTemp = pxDelayedTaskList;																		\
-	pxDelayedTaskList = pxOverflowDelayedTaskList;													\
-	pxOverflowDelayedTaskList = pxTemp;																\
-	xNumOfOverflows++;																				\
-	prvResetNextTaskUnblockTime();																	\
-}
+		pxTemp = pxDelayedTaskList;																	\
+		pxDelayedTaskList = pxOverflowDelayedTaskList;												\
+		pxOverflowDelayedTaskList = pxTemp;															\
+		xNumOfOverflows++;																			\
+		prvResetNextTaskUnblockTime();																\
+	}
+
+	/* Is pxList one of the lists that holds tasks that are in the Blocked state
+	with a timeout? */
+	#define taskIS_DELAYED_LIST( pxList ) ( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) )
+
+#else /* configUSE_DELAYED_TASK_WHEEL */
+
+	/* The delayed task wheel is hierarchical.  Each level has taskWHEEL_SLOTS
+	slots, and each slot is a list of the tasks that are due to leave the
+	Blocked state within the period of time represented by the slot.  Slots in
+	level 0 each represent a single tick, slots in level 1 each represent
+	taskWHEEL_SLOTS ticks, and so on, so enough levels are required to cover
+	every bit of the tick count. */
+	#define taskWHEEL_SLOT_BITS		( ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS )
+	#define taskWHEEL_SLOTS			( ( UBaseType_t ) 1U << taskWHEEL_SLOT_BITS )
+	#define taskWHEEL_SLOT_MASK		( ( TickType_t ) taskWHEEL_SLOTS - ( TickType_t ) 1U )
+	#define taskWHEEL_LEVELS		( ( ( sizeof( TickType_t ) * ( size_t ) 8U ) + ( size_t ) taskWHEEL_SLOT_BITS - ( size_t ) 1U ) / ( size_t ) taskWHEEL_SLOT_BITS )
+
+	/* The index of the slot that xTime falls within at level uxLevel. */
+	#define taskWHEEL_SLOT_INDEX( xTime, uxLevel ) ( ( UBaseType_t ) ( ( ( xTime ) >> ( ( uxLevel ) * taskWHEEL_SLOT_BITS ) ) & taskWHEEL_SLOT_MASK ) )
+
+	/* Tasks whose wake time has overflowed the tick count are held unsorted in
+	xOverflowDelayedTaskList.  Every wake time in the wheel will have been
+	reached by the time the tick count overflows, so at that point the
+	overflowed tasks can be distributed into the wheel. */
+	#define taskSWITCH_DELAYED_LISTS()																\
+	{																								\
+		prvDelayedWheelCascade( &xOverflowDelayedTaskList );										\
+		xNumOfOverflows++;																			\
+		prvResetNextTaskUnblockTime();																\
+	}
+
+	/* Is pxList one of the lists that holds tasks that are in the Blocked state
+	with a timeout? */
+	#define taskIS_DELAYED_LIST( pxList ) ( ( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ] ) ) && ( ( pxList ) < &( xDelayedTaskWheel[ taskWHEEL_LEVELS * taskWHEEL_SLOTS ] ) ) ) || ( ( pxList ) == &xOverflowDelayedTaskList ) )
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
+/*-----------------------------------------------------------*/
 
+#if( configNUM_CORES > 1 )
+
+	/* The value held in the xTaskRunState member of the TCB of a task that is
+	not running on any core.  Otherwise xTaskRunState holds the number of the
+	core the task is running on. */
+	#define taskTASK_NOT_RUNNING	( ( BaseType_t ) -1 )
+
+	/* Is the task running on any core? */
+	#define taskTASK_IS_RUNNING( pxTCB ) ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+	/* Does the affinity mask of the task allow it to run on core xCoreID? */
+	#if( configUSE_CORE_AFFINITY == 1 )
+		#define taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) ( ( ( pxTCB )->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) ( xCoreID ) ) ) != 0U )
+	#else
+		#define taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) ( pdTRUE )
+	#endif
+
+#else /* configNUM_CORES */
+
+	/* Is the task the running task? */
+	#define taskTASK_IS_RUNNING( pxTCB ) ( ( pxTCB ) == pxCurrentTCB )
+
+#endif /* configNUM_CORES */
+
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+
+	/* Record the time at which a task entered the Ready state, unless it is
+	already waiting to run, so the time it then waits to be selected can be
+	measured when it is switched in.  A ready time of 0 means no time is
+	recorded, so a task made ready when the counter is exactly 0 has its ready
+	time recorded when it is next made ready or switched out. */
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define taskRECORD_READY_TIME( pxTCB )										\
+			if( ( pxTCB )->ulReadyTime == ( configRUN_TIME_COUNTER_TYPE ) 0 )		\
+			{																		\
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ( pxTCB )->ulReadyTime );		\
+			}
+	#else
+		#define taskRECORD_READY_TIME( pxTCB )										\
+			if( ( pxTCB )->ulReadyTime == ( configRUN_TIME_COUNTER_TYPE ) 0 )		\
+			{																		\
+				( pxTCB )->ulReadyTime = portGET_RUN_TIME_COUNTER_VALUE();			\
+			}
+	#endif
+
+#else
+
+	#define taskRECORD_READY_TIME( pxTCB )
+
+#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
 /*-----------------------------------------------------------*/
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, unless EDF scheduling is
+ * used and the list is the EDF ready list, in which case it is inserted in
+ * order of deadline.
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_TIME( pxTCB );																	\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY )							\
+		{																								\
+			prvInsertTaskInDeadlineOrder( pxTCB );														\
+		}																								\
+		else																							\
+		{																								\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		}																								\
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#else
+
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_TIME( pxTCB );																	\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+/*
+ * Called wherever a task is removed from an event list, so a task that is no
+ * longer blocked on a mutex is never followed by the chains of mutex holders
+ * that transitive priority inheritance walks, even before it runs again.
  */
-#define prvAddTaskToReadyList( pxTCB )																\
-	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
-	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	#define taskCLEAR_BLOCKED_ON_MUTEX( pxTCB ) ( pxTCB )->pvBlockedOnMutex = NULL
+#else
+	#define taskCLEAR_BLOCKED_ON_MUTEX( pxTCB )
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -245,7 +539,14 @@ count overflows. */
  * task should be used in place of the parameter.  This macro simply checks to
  * see if the parameter is NULL and returns a pointer to the appropriate TCB.
  */
-#define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? ( TCB_t * ) pxCurrentTCB : ( TCB_t * ) ( pxHandle ) )
+#if( configNUM_CORES == 1 )
+	#define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? ( TCB_t * ) pxCurrentTCB : ( TCB_t * ) ( pxHandle ) )
+#else
+	/* The calling task could move to another core between the core number
+	being read and pxCurrentTCBs[] being indexed, unless interrupts are masked
+	while pxCurrentTCBs[] is read. */
+	#define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? ( TCB_t * ) xTaskGetCurrentTaskHandle() : ( TCB_t * ) ( pxHandle ) )
+#endif
 
 /* The item value of the event list item is normally used to hold the priority
 of the task to which it belongs (coded to allow it to be held in reverse
@@ -288,6 +589,13 @@ typedef struct tskTaskControlBlock
 		UBaseType_t		uxCriticalNesting;	/*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
 	#endif
 
+	#if ( configNUM_CORES > 1 )
+		volatile BaseType_t	xTaskRunState;	/*< The core the task is running on, or taskTASK_NOT_RUNNING. */
+		#if ( configUSE_CORE_AFFINITY == 1 )
+			UBaseType_t	uxCoreAffinityMask;	/*< Bit n is set if the task is allowed to run on core n. */
+		#endif
+	#endif
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxTCBNumber;		/*< Stores a number that increments each time a TCB is created.  It allows debuggers to determine when a task has been deleted and then recreated. */
 		UBaseType_t		uxTaskNumber;		/*< Stores a number specifically for use by third party trace code. */
@@ -307,7 +615,7 @@ typedef struct tskTaskControlBlock
 	#endif
 
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -322,8 +630,8 @@ typedef struct tskTaskControlBlock
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments above the definition of
@@ -336,6 +644,44 @@ typedef struct tskTaskControlBlock
 		uint8_t ucDelayAborted;
 	#endif
 
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xPeriod;			/*< The period of an EDF task, or 0 if the task is not an EDF task. */
+		TickType_t		xRelativeDeadline;	/*< The deadline of each job of an EDF task, relative to the time the job is released. */
+		TickType_t		xReleaseTime;		/*< The time at which the current job of an EDF task was released. */
+		TickType_t		xDeadline;			/*< The absolute deadline by which the task is ordered in the EDF ready list. */
+		UBaseType_t		uxDeadlineMisses;	/*< The number of jobs of an EDF task that completed after their deadline. */
+	#endif
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+		uint32_t		ulBudget;				/*< The run time the task can use in each replenish period, or 0 if the task does not have a budget. */
+		uint32_t		ulBudgetUsed;			/*< The run time the task has used in the current replenish period. */
+		TickType_t		xBudgetPeriod;			/*< The period at which the budget is replenished. */
+		TickType_t		xBudgetReplenishTime;	/*< The tick count at which the budget is next replenished. */
+		UBaseType_t		uxBudgetPriority;		/*< The priority the task is demoted to when its budget is exhausted.  Swapped with the base priority while the task is demoted, so it then holds the priority to restore. */
+		UBaseType_t		uxBudgetExhaustedCount;	/*< The number of times the task has exhausted its budget. */
+		ListItem_t		xBudgetListItem;		/*< Used to reference the task from the list of tasks that have exhausted their budget. */
+		uint8_t			ucBudgetAction;			/*< The eBudgetAction taken when the budget is exhausted. */
+		uint8_t			ucBudgetExhausted;		/*< Set to pdTRUE while the budget is exhausted. */
+	#endif
+
+	#if( configGENERATE_TASK_SWITCH_STATS == 1 )
+		uint32_t		ulVoluntarySwitches;	/*< The number of times the task was switched out because it left the Ready state. */
+		uint32_t		ulInvoluntarySwitches;	/*< The number of times the task was switched out while still in the Ready state. */
+		configRUN_TIME_COUNTER_TYPE	ulMaxRunTime;			/*< The longest time the task has run for without being switched out. */
+		configRUN_TIME_COUNTER_TYPE	ulMaxTimeBetweenRuns;	/*< The longest time the task has waited to run after being switched out while still in the Ready state. */
+		configRUN_TIME_COUNTER_TYPE	ulLastSwitchTime;		/*< The run time counter value when the task was last switched in or out. */
+		uint8_t			ucSwitchedOutReady;		/*< Set to pdTRUE if the task was in the Ready state when it was last switched out. */
+	#endif
+
+	#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE	ulReadyTime;	/*< The run time counter value when the task last entered the Ready state, or 0 if the task is not waiting to run. */
+	#endif
+
+	#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+		List_t			xMutexesHeldList;	/*< The mutexes held by the task.  The owner of each item is the list of tasks waiting for the mutex, from which the task's inherited priority is recalculated. */
+		void			*pvBlockedOnMutex;	/*< The mutex the task is blocked waiting to take, or NULL.  Used to follow chains of blocked mutex holders. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -345,14 +691,36 @@ typedef tskTCB TCB_t;
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUM_CORES == 1 )
+
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+
+#else
+
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUM_CORES ];	/*< The task running on each core. */
+
+	/* Within this file pxCurrentTCB is the task running on the calling core.
+	It can only be used where the calling task cannot move to another core -
+	from within a critical section, with the scheduler suspended, or from an
+	interrupt. */
+	#define pxCurrentTCB pxCurrentTCBs[ portGET_CORE_ID() ]
+
+#endif
 
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
+	PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#else
+	PRIVILEGED_DATA static List_t xDelayedTaskWheel[ taskWHEEL_LEVELS * taskWHEEL_SLOTS ];	/*< Delayed tasks, held in the slot of the wheel that corresponds to their wake time. */
+	PRIVILEGED_DATA static uint32_t ulDelayedTaskWheelMap[ taskWHEEL_LEVELS ];				/*< One bit per slot of each level of the wheel, set when a task is placed in the slot. */
+	PRIVILEGED_DATA static List_t xOverflowDelayedTaskList;									/*< Delayed tasks whose wake time has overflowed the current tick count. */
+#endif
+
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -371,14 +739,37 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+#if( configUSE_BITMAP_TASK_SELECTION == 1 )
+	PRIVILEGED_DATA static volatile uint32_t ulReadyPriorities[ taskREADY_PRIORITY_WORDS ] = { 0UL };
+	#if( taskREADY_PRIORITY_WORDS > 1 )
+		PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityGroups = 0UL;
+	#endif
+#else
+	PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 	= tskIDLE_PRIORITY;
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks 			= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+
+#if ( configNUM_CORES == 1 )
+
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPending 		= pdFALSE;
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle				= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+
+#else
+
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUM_CORES ];	/*< Set when a core must select a new task to run, but has not yet done so. */
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUM_CORES ];		/*< Holds the handles of the idle tasks - one is created for each core when the scheduler is started. */
+
+	/* Within this file xYieldPending is the yield pending flag of the calling
+	core, and xIdleTaskHandle is the idle task that performs the clean up of
+	deleted tasks and calls the idle hook. */
+	#define xYieldPending	xYieldPendings[ portGET_CORE_ID() ]
+	#define xIdleTaskHandle	xIdleTaskHandles[ 0 ]
+
+#endif
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
@@ -392,8 +783,28 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	#if ( configNUM_CORES == 1 )
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#else
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTimes[ configNUM_CORES ];	/*< Holds the value of a timer/counter the last time a task was switched in on each core. */
+		#define ulTaskSwitchedInTime ulTaskSwitchedInTimes[ portGET_CORE_ID() ]
+	#endif
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+
+#endif
+
+#if ( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+
+	PRIVILEGED_DATA static uint32_t ulSchedulingLatencyHistograms[ configMAX_PRIORITIES ][ configSCHEDULING_LATENCY_BUCKETS ];	/*< Counts of the time tasks waited to run after entering the Ready state, by priority and log2 of the time. */
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulMaxSchedulingLatencies[ configMAX_PRIORITIES ];	/*< The longest time a task of each priority has waited to run. */
+
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	PRIVILEGED_DATA static List_t xBudgetExhaustedTaskList;					/*< Tasks that have exhausted their budget and are waiting for it to be replenished. */
+	PRIVILEGED_DATA static TickType_t xNextBudgetReplenishTime = ( TickType_t ) 0U;	/*< The earliest replenish time of the tasks in xBudgetExhaustedTaskList. */
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulBudgetChargedTime = 0UL;	/*< The run time counter value up to which the running task has been charged against its budget. */
 
 #endif
 
@@ -414,10 +825,26 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if( configUSE_DEADLINE_MISS_HOOK > 0 )
+
+	extern void vApplicationDeadlineMissHook( TaskHandle_t xTask, char *pcTaskName );
+
+#endif
+
+#if( configUSE_BUDGET_EXHAUSTED_HOOK > 0 )
+
+	extern void vApplicationBudgetExhaustedHook( TaskHandle_t xTask, char *pcTaskName );
+
+#endif
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 	extern void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
 
+	#if( configNUM_CORES > 1 )
+		extern void vApplicationGetPassiveIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xCoreID );
+	#endif
+
 #endif
 
 /* File private functions. --------------------------------*/
@@ -452,6 +879,18 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
  */
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 
+/*
+ * When the scheduler runs on more than one core an idle task is created for
+ * each core.  The idle task created for core 0 is prvIdleTask(), which cleans
+ * up deleted tasks and calls the idle hook.  The idle tasks created for the
+ * other cores do nothing other than run when no other task can.
+ */
+#if ( configNUM_CORES > 1 )
+
+	static portTASK_FUNCTION_PROTO( prvPassiveIdleTask, pvParameters );
+
+#endif
+
 /*
  * Utility to free all memory allocated by the scheduler to hold a TCB,
  * including the stack pointed to by the TCB.
@@ -534,6 +973,39 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/*
+	 * Place the task that owns pxListItem into the delayed task wheel, in the
+	 * slot that corresponds to the wake time held in the list item's value.
+	 * The wake time must not be earlier than the tick count.  Lowers
+	 * xNextTaskUnblockTime if the slot must be processed before any other.
+	 */
+	static void prvDelayedWheelInsert( ListItem_t *pxListItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move every task in pxList (a slot of the wheel, or the overflow list)
+	 * into the slot of the wheel that is correct for the current tick count.
+	 * Tasks are cascaded down one or more levels each time this is called.
+	 */
+	static void prvDelayedWheelCascade( List_t *pxList ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Cascade the tasks held in every slot of the wheel that the new tick
+	 * count has just entered, then return the level 0 slot that holds the
+	 * tasks that are due to leave the Blocked state on this tick.
+	 */
+	static List_t *prvDelayedWheelAdvance( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count at which the slot uxSlot of level uxLevel must next be
+	 * processed - either to unblock its tasks (level 0), or to cascade them to
+	 * a lower level.
+	 */
+	static TickType_t prvDelayedWheelSlotTime( UBaseType_t uxLevel, UBaseType_t uxSlot ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -563,6 +1035,132 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if ( configNUM_CORES > 1 )
+
+	/*
+	 * Request that core xCoreID selects a new task to run.  If xCoreID is the
+	 * calling core then the request is only latched in xYieldPendings[], and
+	 * is acted on when the calling core leaves its critical section (or
+	 * interrupt, or resumes the scheduler).  Must be called from a critical
+	 * section.
+	 */
+	static void prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * pxTCB has just been placed in a ready list.  If pxTCB has a higher
+	 * priority than the task running on one of the cores it is allowed to run
+	 * on then request that the core running the lowest priority task selects
+	 * a new task.  Must be called from a critical section, or with the
+	 * scheduler suspended.
+	 */
+	static void prvYieldForTask( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Select the highest priority ready task that is not already running on
+	 * another core, and that is allowed to run on core xCoreID, as the task
+	 * that runs next on core xCoreID.
+	 */
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUM_CORES */
+
+#if( ( configUSE_BITMAP_TASK_SELECTION == 1 ) && ( taskUSE_HIGHEST_SET_BIT_LOOKUP == 1 ) )
+
+	/*
+	 * Return the position of the most significant set bit in ulValue, which
+	 * must not be zero.  Used to find the highest priority ready task when the
+	 * compiler does not provide a count leading zeros built-in.
+	 */
+	static UBaseType_t prvHighestSetBit( uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Insert pxTCB into the ready list of priority configEDF_TASK_PRIORITY
+	 * after the tasks that have the same or an earlier deadline.
+	 */
+	static void prvInsertTaskInDeadlineOrder( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	/*
+	 * Called from the tick interrupt.  Charges the running task for the run
+	 * time it has used, takes the budget action of the running task if it has
+	 * exhausted its budget, and replenishes the budgets of tasks whose replenish
+	 * time has been reached.  Returns pdTRUE if a context switch is required.
+	 */
+	static BaseType_t prvCheckTaskBudgets( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Charge the running task for the run time used since it was last charged,
+	 * ulRunTimeCounter being the current value of the run time stats counter.
+	 */
+	static void prvChargeRunningTaskBudget( const configRUN_TIME_COUNTER_TYPE ulRunTimeCounter ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove pxTCB from the list of tasks that have exhausted their budget,
+	 * restoring its priority if it was demoted.
+	 */
+	static void prvEndBudgetExhaustion( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Exchange the base priority of pxTCB with pxTCB->uxBudgetPriority, moving
+	 * the task to the ready list of its new priority if necessary.
+	 */
+	static void prvSwapBudgetPriority( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configGENERATE_TASK_SWITCH_STATS == 1 )
+
+	/*
+	 * Called by vTaskSwitchContext() after a task has been selected, with the
+	 * task that was running before the selection and the current value of the
+	 * run time stats counter.  Updates the context switch statistics of both
+	 * tasks if the selection switched from one task to another.
+	 */
+	static void prvUpdateTaskSwitchStats( TCB_t *pxPreviousTCB, const configRUN_TIME_COUNTER_TYPE ulRunTimeCounter ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+
+	/*
+	 * Called by vTaskSwitchContext() after a task has been selected.  Adds the
+	 * time the selected task waited to run to the latency histogram of its
+	 * priority, and records the time at which the task that was switched out
+	 * started to wait if it is still able to run.
+	 */
+	static void prvRecordSchedulingLatency( TCB_t *pxPreviousTCB, const configRUN_TIME_COUNTER_TYPE ulRunTimeCounter ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	/*
+	 * Returns the priority a task that holds mutexes should run at - the
+	 * higher of its base priority and the priority of the highest priority
+	 * task waiting for any of the mutexes it still holds.  Must be called from
+	 * a critical section.
+	 */
+	static UBaseType_t prvGetInheritedPriority( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called after the event list item value of a task has been changed to
+	 * reflect a change in the task's priority.  If the task is blocked on a
+	 * priority ordered event list then the task is moved to the position in
+	 * the list that matches its new priority, so the highest priority waiting
+	 * task remains at the head of the list.  Must be called from a critical
+	 * section.
+	 */
+	static void prvReorderEventListItem( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -692,7 +1290,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends
 			on the implementation of the port malloc function and whether or
 			not static allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = tskALLOCATE_TCB();
 
 			if( pxNewTCB != NULL )
 			{
@@ -747,7 +1345,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends on
 			the implementation of the port malloc function and whether or not static
 			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = tskALLOCATE_TCB();
 
 			if( pxNewTCB != NULL )
 			{
@@ -759,7 +1357,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				if( pxNewTCB->pxStack == NULL )
 				{
 					/* Could not allocate the stack.  Delete the allocated TCB. */
-					vPortFree( pxNewTCB );
+					tskFREE_TCB( pxNewTCB );
 					pxNewTCB = NULL;
 				}
 			}
@@ -774,7 +1372,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			if( pxStack != NULL )
 			{
 				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
+				pxNewTCB = tskALLOCATE_TCB(); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
 
 				if( pxNewTCB != NULL )
 				{
@@ -820,26 +1418,90 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
+#if( ( configUSE_EDF_SCHEDULING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	BaseType_t xTaskCreateDeadline(	TaskFunction_t pxTaskCode,
 									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-									const uint32_t ulStackDepth,
+									const configSTACK_DEPTH_TYPE usStackDepth,
 									void * const pvParameters,
-									UBaseType_t uxPriority,
-									TaskHandle_t * const pxCreatedTask,
-									TCB_t *pxNewTCB,
-									const MemoryRegion_t * const xRegions )
-{
-StackType_t *pxTopOfStack;
-UBaseType_t x;
+									const TickType_t xPeriod,
+									const TickType_t xRelativeDeadline,
+									TaskHandle_t * const pxCreatedTask )
+	{
+	TaskHandle_t xCreatedTask;
+	TCB_t *pxTCB;
+	BaseType_t xReturn;
 
-	#if( portUSING_MPU_WRAPPERS == 1 )
-		/* Should the task be created in privileged mode? */
-		BaseType_t xRunPrivileged;
-		if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
+		configASSERT( xPeriod > ( TickType_t ) 0U );
+		configASSERT( xRelativeDeadline > ( TickType_t ) 0U );
+
+		/* The scheduler is suspended so the new task cannot run until it has
+		been given its period and deadline. */
+		vTaskSuspendAll();
 		{
-			xRunPrivileged = pdTRUE;
-		}
-		else
+			xReturn = xTaskCreate( pxTaskCode, pcName, usStackDepth, pvParameters, ( UBaseType_t ) configEDF_TASK_PRIORITY, &xCreatedTask );
+
+			if( xReturn == pdPASS )
+			{
+				pxTCB = ( TCB_t * ) xCreatedTask;
+
+				taskENTER_CRITICAL();
+				{
+					/* The first job is released now. */
+					pxTCB->xPeriod = xPeriod;
+					pxTCB->xRelativeDeadline = xRelativeDeadline;
+					pxTCB->xReleaseTime = xTickCount;
+					pxTCB->xDeadline = pxTCB->xReleaseTime + xRelativeDeadline;
+
+					/* The task was placed in the EDF ready list before its
+					deadline was known, so move it to its place in the list. */
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				taskEXIT_CRITICAL();
+
+				if( pxCreatedTask != NULL )
+				{
+					*pxCreatedTask = xCreatedTask;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+
+#endif /* ( configUSE_EDF_SCHEDULING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
+									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const uint32_t ulStackDepth,
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask,
+									TCB_t *pxNewTCB,
+									const MemoryRegion_t * const xRegions )
+{
+StackType_t *pxTopOfStack;
+UBaseType_t x;
+
+	#if( portUSING_MPU_WRAPPERS == 1 )
+		/* Should the task be created in privileged mode? */
+		BaseType_t xRunPrivileged;
+		if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
+		{
+			xRunPrivileged = pdTRUE;
+		}
+		else
 		{
 			xRunPrivileged = pdFALSE;
 		}
@@ -945,6 +1607,18 @@ UBaseType_t x;
 	}
 	#endif /* portCRITICAL_NESTING_IN_TCB */
 
+	#if ( configNUM_CORES > 1 )
+	{
+		pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+
+		#if ( configUSE_CORE_AFFINITY == 1 )
+		{
+			pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+		}
+		#endif
+	}
+	#endif /* configNUM_CORES */
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 	{
 		pxNewTCB->pxTaskTag = NULL;
@@ -957,6 +1631,30 @@ UBaseType_t x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configGENERATE_TASK_SWITCH_STATS == 1 )
+	{
+		pxNewTCB->ulVoluntarySwitches = 0UL;
+		pxNewTCB->ulInvoluntarySwitches = 0UL;
+		pxNewTCB->ulMaxRunTime = 0UL;
+		pxNewTCB->ulMaxTimeBetweenRuns = 0UL;
+		pxNewTCB->ulLastSwitchTime = 0UL;
+		pxNewTCB->ucSwitchedOutReady = pdFALSE;
+	}
+	#endif /* configGENERATE_TASK_SWITCH_STATS */
+
+	#if ( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+	{
+		pxNewTCB->ulReadyTime = 0UL;
+	}
+	#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
+
+	#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	{
+		vListInitialise( &( pxNewTCB->xMutexesHeldList ) );
+		pxNewTCB->pvBlockedOnMutex = NULL;
+	}
+	#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -979,8 +1677,11 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+		{
+			pxNewTCB->ulNotifiedValue[ x ] = 0;
+			pxNewTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+		}
 	}
 	#endif
 
@@ -997,6 +1698,33 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		/* Tasks are not EDF tasks unless created by xTaskCreateDeadline(). */
+		pxNewTCB->xPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xRelativeDeadline = ( TickType_t ) 0U;
+		pxNewTCB->xReleaseTime = ( TickType_t ) 0U;
+		pxNewTCB->xDeadline = ( TickType_t ) 0U;
+		pxNewTCB->uxDeadlineMisses = ( UBaseType_t ) 0U;
+	}
+	#endif
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+	{
+		/* Tasks do not have a budget until vTaskSetBudget() is called. */
+		pxNewTCB->ulBudget = 0UL;
+		pxNewTCB->ulBudgetUsed = 0UL;
+		pxNewTCB->xBudgetPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xBudgetReplenishTime = ( TickType_t ) 0U;
+		pxNewTCB->uxBudgetPriority = tskIDLE_PRIORITY;
+		pxNewTCB->uxBudgetExhaustedCount = ( UBaseType_t ) 0U;
+		vListInitialiseItem( &( pxNewTCB->xBudgetListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewTCB->xBudgetListItem ), pxNewTCB );
+		pxNewTCB->ucBudgetAction = ( uint8_t ) eBudgetNotify;
+		pxNewTCB->ucBudgetExhausted = pdFALSE;
+	}
+	#endif
+
 	/* Initialize the TCB stack to look as if the task was already running,
 	but had been interrupted by the scheduler.  The return address is set
 	to the start of the task function. Once the stack has been initialised
@@ -1031,45 +1759,66 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	taskENTER_CRITICAL();
 	{
 		uxCurrentNumberOfTasks++;
-		if( pxCurrentTCB == NULL )
-		{
-			/* There are no other tasks, or all the other tasks are in
-			the suspended state - make this the current task. */
-			pxCurrentTCB = pxNewTCB;
 
-			if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+		#if ( configNUM_CORES == 1 )
+		{
+			if( pxCurrentTCB == NULL )
 			{
-				/* This is the first task to be created so do the preliminary
-				initialisation required.  We will not recover if this call
-				fails, but we will report the failure. */
-				prvInitialiseTaskLists();
+				/* There are no other tasks, or all the other tasks are in
+				the suspended state - make this the current task. */
+				pxCurrentTCB = pxNewTCB;
+
+				if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+				{
+					/* This is the first task to be created so do the
+					preliminary initialisation required.  We will not recover
+					if this call fails, but we will report the failure. */
+					prvInitialiseTaskLists();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
-			}
-		}
-		else
-		{
-			/* If the scheduler is not already running, make this task the
-			current task if it is the highest priority task to be created
-			so far. */
-			if( xSchedulerRunning == pdFALSE )
-			{
-				if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+				/* If the scheduler is not already running, make this task the
+				current task if it is the highest priority task to be created
+				so far. */
+				if( xSchedulerRunning == pdFALSE )
 				{
-					pxCurrentTCB = pxNewTCB;
+					if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+					{
+						pxCurrentTCB = pxNewTCB;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+		}
+		#else /* configNUM_CORES */
+		{
+			/* The task each core runs first is selected when the scheduler is
+			started, so pxCurrentTCBs[] is not updated here. */
+			if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+			{
+				/* This is the first task to be created so do the preliminary
+				initialisation required.  We will not recover if this call
+				fails, but we will report the failure. */
+				prvInitialiseTaskLists();
+			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configNUM_CORES */
 
 		uxTaskNumber++;
 
@@ -1084,26 +1833,47 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		prvAddTaskToReadyList( pxNewTCB );
 
 		portSETUP_TCB( pxNewTCB );
+
+		#if ( configNUM_CORES > 1 )
+		{
+			/* If the created task is of a higher priority than a task that is
+			running on a core it can run on then it should run now.  The yield
+			is performed when the critical section is exited if the core is
+			the calling core. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				prvYieldForTask( pxNewTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configNUM_CORES */
 	}
 	taskEXIT_CRITICAL();
 
-	if( xSchedulerRunning != pdFALSE )
+	#if ( configNUM_CORES == 1 )
 	{
-		/* If the created task is of a higher priority than the current task
-		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( xSchedulerRunning != pdFALSE )
 		{
-			taskYIELD_IF_USING_PREEMPTION();
+			/* If the created task is of a higher priority than the current
+			task then it should run now. */
+			if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+	#endif /* configNUM_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -1139,19 +1909,35 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if( configUSE_TASK_BUDGETS == 1 )
+			{
+				/* Is the task waiting for its budget to be replenished? */
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
 			not return. */
 			uxTaskNumber++;
 
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) )
 			{
-				/* A task is deleting itself.  This cannot complete within the
-				task itself, as a context switch to another task is required.
-				Place the task in the termination list.  The idle task will
-				check the termination list and free up any memory allocated by
-				the scheduler for the TCB and stack of the deleted task. */
+				/* A task is deleting itself (or, when there is more than one
+				core, a task that is running on another core is being deleted).
+				This cannot complete within the task itself, as a context switch
+				to another task is required.  Place the task in the termination
+				list.  The idle task will check the termination list and free up
+				any memory allocated by the scheduler for the TCB and stack of
+				the deleted task. */
 				vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
 
 				/* Increment the ucTasksDeleted variable so the idle task knows
@@ -1165,6 +1951,22 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				hence xYieldPending is used to latch that a context switch is
 				required. */
 				portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+
+				#if ( configNUM_CORES > 1 )
+				{
+					/* Force the core the task is running on to select another
+					task.  If that is the calling core the yield is performed
+					when the critical section is exited. */
+					if( xSchedulerRunning != pdFALSE )
+					{
+						prvYieldCore( pxTCB->xTaskRunState );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUM_CORES */
 			}
 			else
 			{
@@ -1180,20 +1982,24 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		}
 		taskEXIT_CRITICAL();
 
-		/* Force a reschedule if it is the currently running task that has just
-		been deleted. */
-		if( xSchedulerRunning != pdFALSE )
+		#if ( configNUM_CORES == 1 )
 		{
-			if( pxTCB == pxCurrentTCB )
-			{
-				configASSERT( uxSchedulerSuspended == 0 );
-				portYIELD_WITHIN_API();
-			}
-			else
+			/* Force a reschedule if it is the currently running task that has
+			just been deleted. */
+			if( xSchedulerRunning != pdFALSE )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				if( pxTCB == pxCurrentTCB )
+				{
+					configASSERT( uxSchedulerSuspended == 0 );
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
+		#endif /* configNUM_CORES */
 	}
 
 #endif /* INCLUDE_vTaskDelete */
@@ -1208,10 +2014,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxPreviousWakeTime );
 		configASSERT( ( xTimeIncrement > 0U ) );
-		configASSERT( uxSchedulerSuspended == 0 );
 
 		vTaskSuspendAll();
 		{
+			/* The scheduler must not have been suspended by the calling task
+			before it called this function.  This is checked after the
+			scheduler is suspended as, when there is more than one core, another
+			core can hold the scheduler suspended. */
+			configASSERT( uxSchedulerSuspended == 1 );
+
 			/* Minor optimisation.  The tick count cannot change in this
 			block. */
 			const TickType_t xConstTickCount = xTickCount;
@@ -1283,38 +2094,76 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelay == 1 )
+#if( configUSE_EDF_SCHEDULING == 1 )
 
-	void vTaskDelay( const TickType_t xTicksToDelay )
+	void vTaskWaitForNextPeriod( void )
 	{
-	BaseType_t xAlreadyYielded = pdFALSE;
+	TickType_t xTimeSinceRelease;
+	BaseType_t xAlreadyYielded;
 
-		/* A delay time of zero just forces a reschedule. */
-		if( xTicksToDelay > ( TickType_t ) 0U )
-		{
-			configASSERT( uxSchedulerSuspended == 0 );
-			vTaskSuspendAll();
-			{
-				traceTASK_DELAY();
+		/* Only EDF tasks have a period. */
+		configASSERT( pxCurrentTCB->xPeriod > ( TickType_t ) 0U );
 
-				/* A task that is removed from the event list while the
-				scheduler is suspended will not get placed in the ready
-				list or removed from the blocked list until the scheduler
-				is resumed.
+		/* The current job has completed.  It missed its deadline if it
+		completed more than its relative deadline after it was released. */
+		if( ( TickType_t ) ( xTaskGetTickCount() - pxCurrentTCB->xReleaseTime ) > pxCurrentTCB->xRelativeDeadline )
+		{
+			( pxCurrentTCB->uxDeadlineMisses )++;
+			traceTASK_DEADLINE_MISSED( pxCurrentTCB );
 
-				This task cannot be in an event list as it is the currently
-				executing task. */
-				prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+			#if( configUSE_DEADLINE_MISS_HOOK > 0 )
+			{
+				vApplicationDeadlineMissHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );
 			}
-			xAlreadyYielded = xTaskResumeAll();
+			#endif
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		vTaskSuspendAll();
+		{
+			/* The scheduler must not have been suspended by the calling task
+			before it called this function. */
+			configASSERT( uxSchedulerSuspended == 1 );
+
+			/* Minor optimisation.  The tick count cannot change in this
+			block. */
+			const TickType_t xConstTickCount = xTickCount;
+
+			xTimeSinceRelease = xConstTickCount - pxCurrentTCB->xReleaseTime;
+
+			/* The next job is released one period after the current job was
+			released, whenever the current job completed, so the task does not
+			drift. */
+			pxCurrentTCB->xReleaseTime += pxCurrentTCB->xPeriod;
+			pxCurrentTCB->xDeadline = pxCurrentTCB->xReleaseTime + pxCurrentTCB->xRelativeDeadline;
+
+			if( xTimeSinceRelease < pxCurrentTCB->xPeriod )
+			{
+				traceTASK_WAIT_FOR_NEXT_PERIOD( pxCurrentTCB->xReleaseTime );
+
+				/* prvAddCurrentTaskToDelayedList() needs the block time, not
+				the time to wake. */
+				prvAddCurrentTaskToDelayedList( pxCurrentTCB->xPeriod - xTimeSinceRelease, pdFALSE );
+			}
+			else
+			{
+				/* The task overran its period, so the next job has already
+				been released.  Its deadline is later than the deadline of the
+				job that completed, so move the task to its new place in the
+				ready list.  The ready list cannot become empty as the task is
+				put straight back in it. */
+				( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxCurrentTCB );
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
 		/* Force a reschedule if xTaskResumeAll has not already done so, we may
-		have put ourselves to sleep. */
+		have put ourselves to sleep, or another EDF task may now have the
+		earliest deadline. */
 		if( xAlreadyYielded == pdFALSE )
 		{
 			portYIELD_WITHIN_API();
@@ -1325,55 +2174,266 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		}
 	}
 
-#endif /* INCLUDE_vTaskDelay */
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
-#if( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) )
+#if( configUSE_EDF_SCHEDULING == 1 )
 
-	eTaskState eTaskGetState( TaskHandle_t xTask )
+	UBaseType_t uxTaskGetDeadlineMisses( TaskHandle_t xTask )
 	{
-	eTaskState eReturn;
-	List_t *pxStateList;
-	const TCB_t * const pxTCB = ( TCB_t * ) xTask;
+	TCB_t *pxTCB;
 
-		configASSERT( pxTCB );
+		pxTCB = prvGetTCBFromHandle( xTask );
+		return pxTCB->uxDeadlineMisses;
+	}
 
-		if( pxTCB == pxCurrentTCB )
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	void vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xReplenishPeriod, eBudgetAction eAction, UBaseType_t uxDemotedPriority )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( ( ulBudget == 0UL ) || ( xReplenishPeriod > ( TickType_t ) 0U ) );
+		configASSERT( ( xReplenishPeriod <= ( portMAX_DELAY >> 1 ) ) );
+		configASSERT( ( uxDemotedPriority < configMAX_PRIORITIES ) );
+
+		/* Ensure the demoted priority is valid. */
+		if( uxDemotedPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
 		{
-			/* The task calling this function is querying its own state. */
-			eReturn = eRunning;
+			uxDemotedPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
 		}
 		else
 		{
-			taskENTER_CRITICAL();
-			{
-				pxStateList = ( List_t * ) listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-			}
-			taskEXIT_CRITICAL();
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the budget of the calling
+			task that is being set. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* The idle task must always be able to run. */
+			configASSERT( ( ( TaskHandle_t ) pxTCB != xIdleTaskHandle ) );
 
-			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			/* Lift any restriction the previous budget placed on the task. */
+			if( pxTCB->ucBudgetExhausted != pdFALSE )
 			{
-				/* The task being queried is referenced from one of the Blocked
-				lists. */
-				eReturn = eBlocked;
-			}
+				prvEndBudgetExhaustion( pxTCB );
 
-			#if ( INCLUDE_vTaskSuspend == 1 )
-				else if( pxStateList == &xSuspendedTaskList )
+				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
 				{
-					/* The task being queried is referenced from the suspended
-					list.  Is it genuinely suspended or is it block
-					indefinitely? */
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
-					{
-						eReturn = eSuspended;
-					}
-					else
-					{
-						eReturn = eBlocked;
-					}
+					taskYIELD_IF_USING_PREEMPTION();
 				}
-			#endif
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->ulBudget = ulBudget;
+			pxTCB->ulBudgetUsed = 0UL;
+			pxTCB->xBudgetPeriod = xReplenishPeriod;
+			pxTCB->xBudgetReplenishTime = xTickCount + xReplenishPeriod;
+			pxTCB->uxBudgetPriority = uxDemotedPriority;
+			pxTCB->ucBudgetAction = ( uint8_t ) eAction;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	void vTaskGetBudgetStatus( TaskHandle_t xTask, TaskBudgetStatus_t *pxBudgetStatus )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( pxBudgetStatus );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			pxBudgetStatus->ulBudget = pxTCB->ulBudget;
+			pxBudgetStatus->ulBudgetUsed = pxTCB->ulBudgetUsed;
+			pxBudgetStatus->xReplenishPeriod = pxTCB->xBudgetPeriod;
+			pxBudgetStatus->xNextReplenishTime = pxTCB->xBudgetReplenishTime;
+			pxBudgetStatus->uxExhaustedCount = pxTCB->uxBudgetExhaustedCount;
+			pxBudgetStatus->xExhausted = ( BaseType_t ) pxTCB->ucBudgetExhausted;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+
+	BaseType_t xTaskGetSchedulingLatencyHistogram( UBaseType_t uxPriority, uint32_t *pulHistogram, configRUN_TIME_COUNTER_TYPE *pulMaxLatency )
+	{
+	BaseType_t xReturn;
+	UBaseType_t uxBucket;
+
+		configASSERT( pulHistogram );
+
+		if( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES )
+		{
+			taskENTER_CRITICAL();
+			{
+				for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configSCHEDULING_LATENCY_BUCKETS; uxBucket++ )
+				{
+					pulHistogram[ uxBucket ] = ulSchedulingLatencyHistograms[ uxPriority ][ uxBucket ];
+				}
+
+				if( pulMaxLatency != NULL )
+				{
+					*pulMaxLatency = ulMaxSchedulingLatencies[ uxPriority ];
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+
+	void vTaskResetSchedulingLatencyStats( void )
+	{
+	UBaseType_t uxPriority, uxBucket;
+
+		taskENTER_CRITICAL();
+		{
+			for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+			{
+				for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configSCHEDULING_LATENCY_BUCKETS; uxBucket++ )
+				{
+					ulSchedulingLatencyHistograms[ uxPriority ][ uxBucket ] = 0UL;
+				}
+
+				ulMaxSchedulingLatencies[ uxPriority ] = 0UL;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelay == 1 )
+
+	void vTaskDelay( const TickType_t xTicksToDelay )
+	{
+	BaseType_t xAlreadyYielded = pdFALSE;
+
+		/* A delay time of zero just forces a reschedule. */
+		if( xTicksToDelay > ( TickType_t ) 0U )
+		{
+			vTaskSuspendAll();
+			{
+				configASSERT( uxSchedulerSuspended == 1 );
+				traceTASK_DELAY();
+
+				/* A task that is removed from the event list while the
+				scheduler is suspended will not get placed in the ready
+				list or removed from the blocked list until the scheduler
+				is resumed.
+
+				This task cannot be in an event list as it is the currently
+				executing task. */
+				prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+			}
+			xAlreadyYielded = xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Force a reschedule if xTaskResumeAll has not already done so, we may
+		have put ourselves to sleep. */
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* INCLUDE_vTaskDelay */
+/*-----------------------------------------------------------*/
+
+#if( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) )
+
+	eTaskState eTaskGetState( TaskHandle_t xTask )
+	{
+	eTaskState eReturn;
+	List_t *pxStateList;
+	const TCB_t * const pxTCB = ( TCB_t * ) xTask;
+
+		configASSERT( pxTCB );
+
+		if( taskTASK_IS_RUNNING( pxTCB ) )
+		{
+			/* The task calling this function is querying its own state, or
+			the task being queried is running on another core. */
+			eReturn = eRunning;
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+			{
+				pxStateList = ( List_t * ) listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+			}
+			taskEXIT_CRITICAL();
+
+			if( taskIS_DELAYED_LIST( pxStateList ) )
+			{
+				/* The task being queried is referenced from one of the Blocked
+				lists. */
+				eReturn = eBlocked;
+			}
+
+			#if ( INCLUDE_vTaskSuspend == 1 )
+				else if( pxStateList == &xSuspendedTaskList )
+				{
+					/* The task being queried is referenced from the suspended
+					list.  Is it genuinely suspended or is it block
+					indefinitely? */
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
+					{
+						eReturn = eSuspended;
+					}
+					else
+					{
+						eReturn = eBlocked;
+					}
+				}
+			#endif
 
 			#if ( INCLUDE_vTaskDelete == 1 )
 				else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
@@ -1446,14 +2506,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
 		{
 			/* If null is passed in here then it is the priority of the calling
 			task that is being queried. */
 			pxTCB = prvGetTCBFromHandle( xTask );
 			uxReturn = pxTCB->uxPriority;
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
 		return uxReturn;
 	}
@@ -1501,44 +2561,75 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			if( uxCurrentBasePriority != uxNewPriority )
 			{
-				/* The priority change may have readied a task of higher
-				priority than the calling task. */
-				if( uxNewPriority > uxCurrentBasePriority )
+				#if ( configNUM_CORES == 1 )
 				{
-					if( pxTCB != pxCurrentTCB )
+					/* The priority change may have readied a task of higher
+					priority than the calling task. */
+					if( uxNewPriority > uxCurrentBasePriority )
 					{
-						/* The priority of a task other than the currently
-						running task is being raised.  Is the priority being
-						raised above that of the running task? */
-						if( uxNewPriority >= pxCurrentTCB->uxPriority )
+						if( pxTCB != pxCurrentTCB )
 						{
-							xYieldRequired = pdTRUE;
+							/* The priority of a task other than the currently
+							running task is being raised.  Is the priority being
+							raised above that of the running task? */
+							if( uxNewPriority >= pxCurrentTCB->uxPriority )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
 						}
 						else
 						{
-							mtCOVERAGE_TEST_MARKER();
+							/* The priority of the running task is being raised,
+							but the running task must already be the highest
+							priority task able to run so no yield is required. */
 						}
 					}
+					else if( pxTCB == pxCurrentTCB )
+					{
+						/* Setting the priority of the running task down means
+						there may now be another task of higher priority that
+						is ready to execute. */
+						xYieldRequired = pdTRUE;
+					}
 					else
 					{
-						/* The priority of the running task is being raised,
-						but the running task must already be the highest
-						priority task able to run so no yield is required. */
+						/* Setting the priority of any other task down does not
+						require a yield as the running task must be above the
+						new priority of the task being modified. */
 					}
 				}
-				else if( pxTCB == pxCurrentTCB )
-				{
-					/* Setting the priority of the running task down means
-					there may now be another task of higher priority that
-					is ready to execute. */
-					xYieldRequired = pdTRUE;
-				}
-				else
+				#else /* configNUM_CORES */
 				{
-					/* Setting the priority of any other task down does not
-					require a yield as the running task must be above the
-					new priority of the task being modified. */
+					/* Setting the priority of a running task down means there
+					may now be a ready task of higher priority that should run
+					on its core.  Setting the priority of a task that is not
+					running up means it may now be of higher priority than a
+					task that is running. */
+					if( taskTASK_IS_RUNNING( pxTCB ) )
+					{
+						if( uxNewPriority < uxCurrentBasePriority )
+						{
+							xYieldRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else if( uxNewPriority > uxCurrentBasePriority )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif /* configNUM_CORES */
 
 				/* Remember the ready list the task might be referenced from
 				before its uxPriority member is changed so the
@@ -1607,7 +2698,30 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 				if( xYieldRequired != pdFALSE )
 				{
-					taskYIELD_IF_USING_PREEMPTION();
+					#if ( configNUM_CORES == 1 )
+					{
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					#else
+					{
+						if( taskTASK_IS_RUNNING( pxTCB ) )
+						{
+							#if ( configUSE_PREEMPTION == 1 )
+							{
+								prvYieldCore( pxTCB->xTaskRunState );
+							}
+							#endif
+						}
+						else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+						{
+							prvYieldForTask( pxTCB );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configNUM_CORES */
 				}
 				else
 				{
@@ -1654,6 +2768,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
 			{
 				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				taskCLEAR_BLOCKED_ON_MUTEX( pxTCB );
 			}
 			else
 			{
@@ -1664,14 +2779,35 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t x;
+
+				for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but
+						is now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
+
+			#if ( configNUM_CORES > 1 )
+			{
+				/* Force the core the task is running on, if any, to select
+				another task.  If that is the calling core the yield is
+				performed when the critical section is exited. */
+				if( ( xSchedulerRunning != pdFALSE ) && taskTASK_IS_RUNNING( pxTCB ) )
+				{
+					prvYieldCore( pxTCB->xTaskRunState );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configNUM_CORES */
 		}
 		taskEXIT_CRITICAL();
 
@@ -1690,37 +2826,41 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		if( pxTCB == pxCurrentTCB )
+		#if ( configNUM_CORES == 1 )
 		{
-			if( xSchedulerRunning != pdFALSE )
-			{
-				/* The current task has just been suspended. */
-				configASSERT( uxSchedulerSuspended == 0 );
-				portYIELD_WITHIN_API();
-			}
-			else
+			if( pxTCB == pxCurrentTCB )
 			{
-				/* The scheduler is not running, but the task that was pointed
-				to by pxCurrentTCB has just been suspended and pxCurrentTCB
-				must be adjusted to point to a different task. */
-				if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks )
+				if( xSchedulerRunning != pdFALSE )
 				{
-					/* No other tasks are ready, so set pxCurrentTCB back to
-					NULL so when the next task is created pxCurrentTCB will
-					be set to point to it no matter what its relative priority
-					is. */
-					pxCurrentTCB = NULL;
+					/* The current task has just been suspended. */
+					configASSERT( uxSchedulerSuspended == 0 );
+					portYIELD_WITHIN_API();
 				}
 				else
 				{
-					vTaskSwitchContext();
+					/* The scheduler is not running, but the task that was pointed
+					to by pxCurrentTCB has just been suspended and pxCurrentTCB
+					must be adjusted to point to a different task. */
+					if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks )
+					{
+						/* No other tasks are ready, so set pxCurrentTCB back to
+						NULL so when the next task is created pxCurrentTCB will
+						be set to point to it no matter what its relative priority
+						is. */
+						pxCurrentTCB = NULL;
+					}
+					else
+					{
+						vTaskSwitchContext();
+					}
 				}
 			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+		#endif /* configNUM_CORES */
 	}
 
 #endif /* INCLUDE_vTaskSuspend */
@@ -1797,17 +2937,25 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* A higher priority task may have just been resumed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					#if ( configNUM_CORES == 1 )
 					{
-						/* This yield may not cause the task just resumed to run,
-						but will leave the lists in the correct state for the
-						next yield. */
-						taskYIELD_IF_USING_PREEMPTION();
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							/* This yield may not cause the task just resumed to
+							run, but will leave the lists in the correct state
+							for the next yield. */
+							taskYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 					}
-					else
+					#else
 					{
-						mtCOVERAGE_TEST_MARKER();
+						prvYieldForTask( pxTCB );
 					}
+					#endif /* configNUM_CORES */
 				}
 				else
 				{
@@ -1854,7 +3002,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
 			{
@@ -1865,17 +3013,30 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					#if ( configNUM_CORES == 1 )
 					{
-						xYieldRequired = pdTRUE;
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							xYieldRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 					}
+					#endif /* configNUM_CORES */
 
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 					prvAddTaskToReadyList( pxTCB );
+
+					#if ( configNUM_CORES > 1 )
+					{
+						/* A context switch is only required on the interrupted
+						core if that is the core selected to run the task. */
+						prvYieldForTask( pxTCB );
+						xYieldRequired = xYieldPending;
+					}
+					#endif /* configNUM_CORES */
 				}
 				else
 				{
@@ -1883,6 +3044,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					is held in the pending ready list until the scheduler is
 					unsuspended. */
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+					taskRECORD_READY_TIME( pxTCB );
 				}
 			}
 			else
@@ -1890,7 +3052,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xYieldRequired;
 	}
@@ -1941,6 +3103,71 @@ BaseType_t xReturn;
 	}
 	#endif /* configSUPPORT_STATIC_ALLOCATION */
 
+	#if ( configNUM_CORES > 1 )
+	{
+	BaseType_t xCoreID;
+	UBaseType_t x;
+	char cIdleName[ configMAX_TASK_NAME_LEN ];
+
+		/* Add an idle task for each of the other cores.  The name of each is
+		the name of the idle task with the number of the core appended. */
+		for( xCoreID = ( BaseType_t ) 1; ( xCoreID < ( BaseType_t ) configNUM_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+		{
+			for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 2 ); x++ )
+			{
+				cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
+
+				if( cIdleName[ x ] == 0x00 )
+				{
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			cIdleName[ x ] = ( char ) ( '0' + xCoreID );
+			cIdleName[ x + 1 ] = '\0';
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				StaticTask_t *pxIdleTaskTCBBuffer = NULL;
+				StackType_t *pxIdleTaskStackBuffer = NULL;
+				uint32_t ulIdleTaskStackSize;
+
+				vApplicationGetPassiveIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID );
+				xIdleTaskHandles[ xCoreID ] = xTaskCreateStatic(	prvPassiveIdleTask,
+																	cIdleName,
+																	ulIdleTaskStackSize,
+																	( void * ) NULL, /*lint !e961.  The cast is not redundant for all compilers. */
+																	( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
+																	pxIdleTaskStackBuffer,
+																	pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+				if( xIdleTaskHandles[ xCoreID ] != NULL )
+				{
+					xReturn = pdPASS;
+				}
+				else
+				{
+					xReturn = pdFAIL;
+				}
+			}
+			#else
+			{
+				xReturn = xTaskCreate(	prvPassiveIdleTask,
+										cIdleName,
+										configMINIMAL_STACK_SIZE,
+										( void * ) NULL,
+										( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
+										&( xIdleTaskHandles[ xCoreID ] ) ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+	}
+	#endif /* configNUM_CORES */
+
 	#if ( configUSE_TIMERS == 1 )
 	{
 		if( xReturn == pdPASS )
@@ -1972,6 +3199,28 @@ BaseType_t xReturn;
 		starts to run. */
 		portDISABLE_INTERRUPTS();
 
+		#if ( configNUM_CORES > 1 )
+		{
+		BaseType_t xCoreID;
+
+			/* Each core starts by running an idle task, which yields straight
+			away to select the highest priority task the core is able to run.
+			The idle tasks must be able to run on any core, whatever affinity
+			tasks are given by default. */
+			for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+			{
+				pxCurrentTCBs[ xCoreID ] = ( TCB_t * ) xIdleTaskHandles[ xCoreID ];
+				pxCurrentTCBs[ xCoreID ]->xTaskRunState = xCoreID;
+
+				#if ( configUSE_CORE_AFFINITY == 1 )
+				{
+					pxCurrentTCBs[ xCoreID ]->uxCoreAffinityMask = tskNO_AFFINITY;
+				}
+				#endif
+			}
+		}
+		#endif /* configNUM_CORES */
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -2031,11 +3280,41 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-	/* A critical section is not required as the variable is of type
-	BaseType_t.  Please read Richard Barry's reply in the following link to a
-	post in the FreeRTOS support forum before reporting this as a bug! -
-	http://goo.gl/wu4acr */
-	++uxSchedulerSuspended;
+	#if ( configNUM_CORES == 1 )
+	{
+		/* A critical section is not required as the variable is of type
+		BaseType_t.  Please read Richard Barry's reply in the following link to
+		a post in the FreeRTOS support forum before reporting this as a bug! -
+		http://goo.gl/wu4acr */
+		++uxSchedulerSuspended;
+	}
+	#else
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* The task lock is held until the scheduler is resumed, which
+			stops the other cores from switching tasks or entering critical
+			sections in the meantime.  Interrupts are masked so the calling
+			task cannot move to another core while the lock is taken.  The ISR
+			lock is only needed while uxSchedulerSuspended is updated, as it is
+			also read by interrupts. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			portGET_TASK_LOCK();
+			portGET_ISR_LOCK();
+			{
+				++uxSchedulerSuspended;
+			}
+			portRELEASE_ISR_LOCK();
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			++uxSchedulerSuspended;
+		}
+	}
+	#endif /* configNUM_CORES */
 }
 /*----------------------------------------------------------*/
 
@@ -2050,7 +3329,19 @@ void vTaskSuspendAll( void )
 		configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
 		task that are in the Ready state, even though the idle task is
 		running. */
-		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		#if( configUSE_BITMAP_TASK_SELECTION == 1 )
+		{
+		UBaseType_t uxTopPriority;
+
+			/* The calling task is ready, so at least one bit is set. */
+			taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );
+
+			if( uxTopPriority > tskIDLE_PRIORITY )
+			{
+				uxHigherPriorityReadyTasks = pdTRUE;
+			}
+		}
+		#elif( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 		{
 			if( uxTopReadyPriority > tskIDLE_PRIORITY )
 			{
@@ -2120,6 +3411,21 @@ BaseType_t xAlreadyYielded = pdFALSE;
 	{
 		--uxSchedulerSuspended;
 
+		#if ( configNUM_CORES > 1 )
+		{
+			/* Release the task lock taken by vTaskSuspendAll().  It is still
+			held by the critical section. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				portRELEASE_TASK_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configNUM_CORES */
+
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
@@ -2135,14 +3441,22 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					#if ( configNUM_CORES == 1 )
 					{
-						xYieldPending = pdTRUE;
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							xYieldPending = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 					}
-					else
+					#else
 					{
-						mtCOVERAGE_TEST_MARKER();
+						prvYieldForTask( pxTCB );
 					}
+					#endif /* configNUM_CORES */
 				}
 
 				if( pxTCB != NULL )
@@ -2366,15 +3680,31 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
+			#if( configUSE_DELAYED_TASK_WHEEL == 0 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-			}
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
 
-			if( pxTCB == NULL )
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				}
+			}
+			#else
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				for( uxQueue = ( UBaseType_t ) 0; ( pxTCB == NULL ) && ( uxQueue < ( UBaseType_t ) ( taskWHEEL_LEVELS * taskWHEEL_SLOTS ) ); uxQueue++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxQueue ] ), pcNameToQuery );
+				}
+
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &xOverflowDelayedTaskList, pcNameToQuery );
+				}
 			}
+			#endif
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
@@ -2406,7 +3736,7 @@ TCB_t *pxTCB;
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
 	{
 	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2426,8 +3756,21 @@ TCB_t *pxTCB;
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#else
+				{
+					for( uxQueue = ( UBaseType_t ) 0; uxQueue < ( UBaseType_t ) ( taskWHEEL_LEVELS * taskWHEEL_SLOTS ); uxQueue++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxQueue ] ), eBlocked );
+					}
+
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xOverflowDelayedTaskList, eBlocked );
+				}
+				#endif
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2491,6 +3834,21 @@ TCB_t *pxTCB;
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
 
+#if ( ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) && ( configNUM_CORES > 1 ) )
+
+	TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
+	{
+		configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUM_CORES ) );
+
+		/* If xTaskGetIdleTaskHandleForCore() is called before the scheduler
+		has been started, then the idle task handles will be NULL. */
+		configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+		return xIdleTaskHandles[ xCoreID ];
+	}
+
+#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+/*----------------------------------------------------------*/
+
 /* This conditional compilation should use inequality to 0, not equality to 1.
 This is to ensure vTaskStepTick() is available when user defined low power mode
 implementations require configUSE_TICKLESS_IDLE to be set to a value other than
@@ -2503,7 +3861,31 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		was suppressed.  Note this does *not* call the tick hook function for
 		each stepped tick. */
 		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
-		xTickCount += xTicksToJump;
+
+		#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+		{
+			/* The wheel is only processed on the ticks at which it is
+			incremented, so if the tick count is being stepped to the time at
+			which the wheel must next be processed then step to the tick
+			before, and pend the final tick so it is processed by
+			xTaskIncrementTick() when the scheduler is resumed.  The scheduler
+			is always suspended when this function is called. */
+			if( ( xTicksToJump > ( TickType_t ) 0U ) && ( ( xTickCount + xTicksToJump ) == xNextTaskUnblockTime ) )
+			{
+				xTickCount += xTicksToJump - ( TickType_t ) 1U;
+				++uxPendedTicks;
+			}
+			else
+			{
+				xTickCount += xTicksToJump;
+			}
+		}
+		#else
+		{
+			xTickCount += xTicksToJump;
+		}
+		#endif
+
 		traceINCREASE_TICK_COUNT( xTicksToJump );
 	}
 
@@ -2541,6 +3923,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
 					{
 						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						taskCLEAR_BLOCKED_ON_MUTEX( pxTCB );
 						pxTCB->ucDelayAborted = pdTRUE;
 					}
 					else
@@ -2560,16 +3943,24 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					#if ( configNUM_CORES == 1 )
 					{
-						/* Pend the yield to be performed when the scheduler
-						is unsuspended. */
-						xYieldPending = pdTRUE;
+						if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
+						{
+							/* Pend the yield to be performed when the
+							scheduler is unsuspended. */
+							xYieldPending = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 					}
-					else
+					#else
 					{
-						mtCOVERAGE_TEST_MARKER();
+						prvYieldForTask( pxTCB );
 					}
+					#endif /* configNUM_CORES */
 				}
 				#endif /* configUSE_PREEMPTION */
 			}
@@ -2591,10 +3982,26 @@ BaseType_t xTaskIncrementTick( void )
 TCB_t * pxTCB;
 TickType_t xItemValue;
 BaseType_t xSwitchRequired = pdFALSE;
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	/* When the wheel is used the delayed list processed on each tick is the
+	slot of the wheel that holds the tasks due to unblock on that tick. */
+	List_t *pxDelayedTaskList;
+#endif
+#if( configNUM_CORES > 1 )
+	UBaseType_t uxSavedInterruptStatus;
+#endif
 
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
-	tasks to be unblocked. */
+	tasks to be unblocked.  When there is more than one core the tick interrupt
+	is only processed by core 0, and the ISR lock is held so the other cores
+	cannot access the task lists at the same time. */
+	#if( configNUM_CORES > 1 )
+	{
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	}
+	#endif
+
 	traceTASK_INCREMENT_TICK( xTickCount );
 	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 	{
@@ -2621,16 +4028,33 @@ BaseType_t xSwitchRequired = pdFALSE;
 		look any further down the list. */
 		if( xConstTickCount >= xNextTaskUnblockTime )
 		{
+			#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+			{
+				pxDelayedTaskList = prvDelayedWheelAdvance( xConstTickCount );
+			}
+			#endif
+
 			for( ;; )
 			{
 				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+					{
+						/* The delayed list is empty.  Set xNextTaskUnblockTime
+						to the maximum possible value so it is extremely
+						unlikely that the
+						if( xTickCount >= xNextTaskUnblockTime ) test will pass
+						next time through. */
+						xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					}
+					#else
+					{
+						/* All the tasks due to unblock on this tick have been
+						unblocked, find the next slot of the wheel that needs
+						processing. */
+						prvResetNextTaskUnblockTime();
+					}
+					#endif
 					break;
 				}
 				else
@@ -2665,6 +4089,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
 					{
 						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						taskCLEAR_BLOCKED_ON_MUTEX( pxTCB );
 					}
 					else
 					{
@@ -2683,33 +4108,97 @@ BaseType_t xSwitchRequired = pdFALSE;
 						only be performed if the unblocked task has a
 						priority that is equal to or higher than the
 						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						#if ( configNUM_CORES == 1 )
 						{
-							xSwitchRequired = pdTRUE;
+							if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
 						}
-						else
+						#else
 						{
-							mtCOVERAGE_TEST_MARKER();
+							/* A context switch on this core is requested
+							through xYieldPending. */
+							prvYieldForTask( pxTCB );
 						}
+						#endif /* configNUM_CORES */
 					}
 					#endif /* configUSE_PREEMPTION */
 				}
 			}
 		}
 
+		#if ( configUSE_TASK_BUDGETS == 1 )
+		{
+			/* Enforce the budget of the running task, and replenish the
+			budgets of tasks that have exhausted theirs. */
+			if( prvCheckTaskBudgets( xConstTickCount ) != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_BUDGETS */
+
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#if ( configNUM_CORES == 1 )
 			{
-				xSwitchRequired = pdTRUE;
+				if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) && ( taskPRIORITY_IS_TIME_SLICED( pxCurrentTCB->uxPriority ) != pdFALSE ) )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
-			else
+			#else
 			{
-				mtCOVERAGE_TEST_MARKER();
+			BaseType_t xCoreID, x;
+			UBaseType_t uxPriority, uxRunningAtPriority;
+
+				/* A core must switch tasks if there are more ready tasks at
+				the priority of the task it is running than there are cores
+				running tasks of that priority. */
+				for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+				{
+					uxPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+					uxRunningAtPriority = ( UBaseType_t ) 0U;
+
+					for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configNUM_CORES; x++ )
+					{
+						if( pxCurrentTCBs[ x ]->uxPriority == uxPriority )
+						{
+							uxRunningAtPriority++;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ] ) ) > uxRunningAtPriority )
+					{
+						prvYieldCore( xCoreID );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
 			}
+			#endif /* configNUM_CORES */
 		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
@@ -2754,6 +4243,12 @@ BaseType_t xSwitchRequired = pdFALSE;
 	}
 	#endif /* configUSE_PREEMPTION */
 
+	#if( configNUM_CORES > 1 )
+	{
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+	#endif
+
 	return xSwitchRequired;
 }
 /*-----------------------------------------------------------*/
@@ -2766,14 +4261,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 		/* If xTask is NULL then it is the task hook of the calling task that is
 		getting set. */
-		if( xTask == NULL )
-		{
-			xTCB = ( TCB_t * ) pxCurrentTCB;
-		}
-		else
-		{
-			xTCB = ( TCB_t * ) xTask;
-		}
+		xTCB = prvGetTCBFromHandle( xTask );
 
 		/* Save the hook function in the TCB.  A critical section is required as
 		the value can be accessed from an interrupt. */
@@ -2793,14 +4281,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 	TaskHookFunction_t xReturn;
 
 		/* If xTask is NULL then we are setting our own task hook. */
-		if( xTask == NULL )
-		{
-			xTCB = ( TCB_t * ) pxCurrentTCB;
-		}
-		else
-		{
-			xTCB = ( TCB_t * ) xTask;
-		}
+		xTCB = prvGetTCBFromHandle( xTask );
 
 		/* Save the hook function in the TCB.  A critical section is required as
 		the value can be accessed from an interrupt. */
@@ -2850,6 +4331,22 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 void vTaskSwitchContext( void )
 {
+#if ( ( configGENERATE_TASK_SWITCH_STATS == 1 ) || ( configGENERATE_SCHEDULING_LATENCY_STATS == 1 ) )
+	TCB_t *pxPreviousTCB;
+#endif
+
+	#if ( configNUM_CORES > 1 )
+	{
+		/* Both locks are held while a new task is selected, so no other core
+		can select a task, or access the ready lists from a critical section or
+		an interrupt, at the same time.  Interrupts are already masked as this
+		function is only called from the port layer's yield and interrupt
+		handlers. */
+		portGET_TASK_LOCK();
+		portGET_ISR_LOCK();
+	}
+	#endif /* configNUM_CORES */
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -2861,6 +4358,12 @@ void vTaskSwitchContext( void )
 		xYieldPending = pdFALSE;
 		traceTASK_SWITCHED_OUT();
 
+		#if ( ( configGENERATE_TASK_SWITCH_STATS == 1 ) || ( configGENERATE_SCHEDULING_LATENCY_STATS == 1 ) )
+		{
+			pxPreviousTCB = pxCurrentTCB;
+		}
+		#endif
+
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
 				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
@@ -2885,6 +4388,14 @@ void vTaskSwitchContext( void )
 					mtCOVERAGE_TEST_MARKER();
 				}
 				ulTaskSwitchedInTime = ulTotalRunTime;
+
+				#if ( configUSE_TASK_BUDGETS == 1 )
+				{
+					/* Charge the task being switched out against its budget.
+					The budget is enforced from the tick interrupt. */
+					prvChargeRunningTaskBudget( ulTotalRunTime );
+				}
+				#endif
 		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -2893,20 +4404,226 @@ void vTaskSwitchContext( void )
 
 		/* Select a new task to run using either the generic C or port
 		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK();
+		#if ( configNUM_CORES == 1 )
+		{
+			taskSELECT_HIGHEST_PRIORITY_TASK();
+		}
+		#else
+		{
+			prvSelectHighestPriorityTask( portGET_CORE_ID() );
+		}
+		#endif /* configNUM_CORES */
 		traceTASK_SWITCHED_IN();
 
-		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		#if ( configGENERATE_TASK_SWITCH_STATS == 1 )
 		{
-			/* Switch Newlib's _impure_ptr variable to point to the _reent
-			structure specific to this task. */
+			prvUpdateTaskSwitchStats( pxPreviousTCB, ulTotalRunTime );
+		}
+		#endif
+
+		#if ( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+		{
+			prvRecordSchedulingLatency( pxPreviousTCB, ulTotalRunTime );
+		}
+		#endif
+
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		{
+			/* Switch Newlib's _impure_ptr variable to point to the _reent
+			structure specific to this task. */
 			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 	}
+
+	#if ( configNUM_CORES > 1 )
+	{
+		portRELEASE_ISR_LOCK();
+		portRELEASE_TASK_LOCK();
+	}
+	#endif /* configNUM_CORES */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUM_CORES > 1 )
+
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+	{
+	UBaseType_t uxTopPriority, x;
+	List_t *pxReadyList;
+	ListItem_t *pxListItem;
+	TCB_t *pxTCB;
+	BaseType_t xTaskSelected = pdFALSE;
+
+		/* The task that was running on this core can now be selected by any
+		core, including this one. */
+		pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+
+		/* Find the highest priority queue that contains ready tasks. */
+		#if( configUSE_BITMAP_TASK_SELECTION == 1 )
+		{
+			taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );
+		}
+		#else
+		{
+			while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )
+			{
+				configASSERT( uxTopReadyPriority );
+				--uxTopReadyPriority;
+			}
+
+			uxTopPriority = uxTopReadyPriority;
+		}
+		#endif /* configUSE_BITMAP_TASK_SELECTION */
+
+		/* Tasks that are running on other cores, or that are not allowed to
+		run on this core, are skipped, so the task selected is not necessarily
+		of the highest ready priority.  There is an idle task for each core, so
+		a task is always found. */
+		while( xTaskSelected == pdFALSE )
+		{
+			pxReadyList = &( pxReadyTasksLists[ uxTopPriority ] );
+			pxListItem = pxReadyList->pxIndex;
+
+			/* Index through the list starting after the task that was last
+			selected from it, so the tasks of the same priority get an equal
+			share of the processor time.  The list's end marker is visited,
+			but skipped, once. */
+			for( x = ( UBaseType_t ) 0; x <= listCURRENT_LIST_LENGTH( pxReadyList ); x++ )
+			{
+				pxListItem = listGET_NEXT( pxListItem );
+
+				if( pxListItem != ( ListItem_t * ) listGET_END_MARKER( pxReadyList ) )
+				{
+					pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+
+					if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) && ( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) )
+					{
+						pxReadyList->pxIndex = pxListItem;
+						pxTCB->xTaskRunState = xCoreID;
+						pxCurrentTCBs[ xCoreID ] = pxTCB;
+						xTaskSelected = pdTRUE;
+						break;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( xTaskSelected == pdFALSE )
+			{
+				configASSERT( uxTopPriority );
+				--uxTopPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_CORES > 1 )
+
+	static void prvYieldCore( BaseType_t xCoreID )
+	{
+		if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+		{
+			xYieldPendings[ xCoreID ] = pdTRUE;
+		}
+		else if( xYieldPendings[ xCoreID ] == pdFALSE )
+		{
+			/* The flag is cleared by the other core when it selects a new
+			task, so there is no need to interrupt the other core again until
+			it has done so. */
+			xYieldPendings[ xCoreID ] = pdTRUE;
+			portYIELD_CORE( xCoreID );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_CORES > 1 )
+
+	static void prvYieldForTask( TCB_t *pxTCB )
+	{
+		/* A task being readied cannot cause an immediate context switch if
+		preemption is turned off. */
+		#if ( configUSE_PREEMPTION == 1 )
+		{
+		BaseType_t xCoreID, x, xLowestPriorityCore = ( BaseType_t ) -1;
+		const BaseType_t xThisCoreID = ( BaseType_t ) portGET_CORE_ID();
+		UBaseType_t uxLowestPriority = pxTCB->uxPriority;
+
+			if( xSchedulerRunning != pdFALSE )
+			{
+				/* Find the core running the lowest priority task that is of
+				lower priority than pxTCB.  The search starts at the calling
+				core so the calling core is preferred if more than one core is
+				running a task of the lowest priority, as switching tasks on
+				the calling core does not require an inter-core interrupt.
+				Cores that have already been asked to select a new task are
+				skipped, as they will select the highest priority ready task
+				anyway. */
+				for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configNUM_CORES; x++ )
+				{
+					xCoreID = ( xThisCoreID + x ) % ( BaseType_t ) configNUM_CORES;
+
+					if( ( xYieldPendings[ xCoreID ] == pdFALSE ) && ( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) )
+					{
+						if( pxCurrentTCBs[ xCoreID ]->uxPriority < uxLowestPriority )
+						{
+							uxLowestPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+							xLowestPriorityCore = xCoreID;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				if( xLowestPriorityCore >= ( BaseType_t ) 0 )
+				{
+					prvYieldCore( xLowestPriorityCore );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			( void ) pxTCB;
+		}
+		#endif /* configUSE_PREEMPTION */
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
 {
 	configASSERT( pxEventList );
@@ -3002,34 +4719,54 @@ BaseType_t xReturn;
 	pxUnblockedTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
 	configASSERT( pxUnblockedTCB );
 	( void ) uxListRemove( &( pxUnblockedTCB->xEventListItem ) );
+	taskCLEAR_BLOCKED_ON_MUTEX( pxUnblockedTCB );
 
 	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 	{
 		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 		prvAddTaskToReadyList( pxUnblockedTCB );
+
+		#if ( configNUM_CORES > 1 )
+		{
+			/* The task may preempt a task running on another core, in which
+			case that core is interrupted. */
+			prvYieldForTask( pxUnblockedTCB );
+		}
+		#endif
 	}
 	else
 	{
 		/* The delayed and ready lists cannot be accessed, so hold this task
 		pending until the scheduler is resumed. */
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+		taskRECORD_READY_TIME( pxUnblockedTCB );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	#if ( configNUM_CORES == 1 )
 	{
-		/* Return true if the task removed from the event list has a higher
-		priority than the calling task.  This allows the calling task to know if
-		it should force a context switch now. */
-		xReturn = pdTRUE;
+		if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) != pdFALSE )
+		{
+			/* Return true if the task removed from the event list has a higher
+			priority than the calling task.  This allows the calling task to
+			know if it should force a context switch now. */
+			xReturn = pdTRUE;
 
-		/* Mark that a yield is pending in case the user is not using the
-		"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-		xYieldPending = pdTRUE;
+			/* Mark that a yield is pending in case the user is not using the
+			"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS
+			function. */
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
 	}
-	else
+	#else
 	{
-		xReturn = pdFALSE;
+		/* Return true if the calling core must switch to another task. */
+		xReturn = xYieldPending;
 	}
+	#endif /* configNUM_CORES */
 
 	#if( configUSE_TICKLESS_IDLE != 0 )
 	{
@@ -3072,14 +4809,96 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	#if ( configNUM_CORES == 1 )
 	{
-		/* The unblocked task has a priority above that of the calling task, so
-		a context switch is required.  This function is called with the
-		scheduler suspended so xYieldPending is set so the context switch
-		occurs immediately that the scheduler is resumed (unsuspended). */
-		xYieldPending = pdTRUE;
+		if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) != pdFALSE )
+		{
+			/* The unblocked task has a priority above that of the calling task,
+			so a context switch is required.  This function is called with the
+			scheduler suspended so xYieldPending is set so the context switch
+			occurs immediately that the scheduler is resumed (unsuspended). */
+			xYieldPending = pdTRUE;
+		}
+	}
+	#else
+	{
+		/* If the calling core must switch tasks xYieldPending is set, so the
+		context switch occurs when the scheduler is resumed. */
+		prvYieldForTask( pxUnblockedTCB );
+	}
+	#endif /* configNUM_CORES */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+{
+TCB_t *pxUnblockedTCB;
+BaseType_t xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+	called from a critical section within an ISR.  It is used by the event
+	flags implementation when event bits are set directly from an interrupt,
+	in which case the event flags implementation guarantees exclusive access
+	to the event list. */
+
+	/* Store the new item value in the event list. */
+	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	pxUnblockedTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxEventListItem );
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( pxEventListItem );
+
+	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	{
+		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+		prvAddTaskToReadyList( pxUnblockedTCB );
+
+		#if ( configNUM_CORES > 1 )
+		{
+			/* The task may preempt a task running on another core, in which
+			case that core is interrupted. */
+			prvYieldForTask( pxUnblockedTCB );
+		}
+		#endif
 	}
+	else
+	{
+		/* The delayed and ready lists cannot be accessed, so hold this task
+		pending until the scheduler is resumed. */
+		vListInsertEnd( &( xPendingReadyList ), pxEventListItem );
+		taskRECORD_READY_TIME( pxUnblockedTCB );
+	}
+
+	#if ( configNUM_CORES == 1 )
+	{
+		if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) != pdFALSE )
+		{
+			/* Return true if the task removed from the event list has a higher
+			priority than the calling task, and mark that a yield is pending in
+			case the caller does not use the return value. */
+			xReturn = pdTRUE;
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+	}
+	#else
+	{
+		/* Return true if the calling core must switch to another task. */
+		xReturn = xYieldPending;
+	}
+	#endif /* configNUM_CORES */
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		/* As in xTaskRemoveFromEventList(). */
+		prvResetNextTaskUnblockTime();
+	}
+	#endif
+
+	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -3234,6 +5053,14 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 	any. */
 	portTASK_CALLS_SECURE_FUNCTIONS();
 
+	#if ( configNUM_CORES > 1 )
+	{
+		/* Each core runs an idle task when the scheduler is started, so yield
+		to allow the core to select the highest priority task it can run. */
+		taskYIELD();
+	}
+	#endif /* configNUM_CORES */
+
 	for( ;; )
 	{
 		/* See if any tasks have deleted themselves - if so then the idle task
@@ -3258,10 +5085,11 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			timeslice.
 
 			A critical region is not required here as we are just reading from
-			the list, and an occasional incorrect value will not matter.  If
-			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			the list, and an occasional incorrect value will not matter.  There
+			is one idle task for each core, so if the ready list at the idle
+			priority contains more than configNUM_CORES tasks then a task other
+			than an idle task is ready to execute. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUM_CORES )
 			{
 				taskYIELD();
 			}
@@ -3338,6 +5166,47 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUM_CORES > 1 )
+
+	static portTASK_FUNCTION( prvPassiveIdleTask, pvParameters )
+	{
+		/* Stop warnings. */
+		( void ) pvParameters;
+
+		/* Yield to allow the core to select the highest priority task it can
+		run, as per prvIdleTask(). */
+		taskYIELD();
+
+		for( ;; )
+		{
+			#if ( configUSE_PREEMPTION == 0 )
+			{
+				/* If we are not using preemption we keep forcing a task switch
+				to see if any other task has become available. */
+				taskYIELD();
+			}
+			#endif /* configUSE_PREEMPTION */
+
+			#if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+			{
+				/* Yield if a task other than an idle task shares the idle
+				priority, as per prvIdleTask(). */
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUM_CORES )
+				{
+					taskYIELD();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+		}
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TICKLESS_IDLE != 0 )
 
 	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
@@ -3442,8 +5311,22 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#else
+	{
+		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) ( taskWHEEL_LEVELS * taskWHEEL_SLOTS ); uxPriority++ )
+		{
+			vListInitialise( &( xDelayedTaskWheel[ uxPriority ] ) );
+		}
+
+		vListInitialise( &xOverflowDelayedTaskList );
+	}
+	#endif
+
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3458,10 +5341,20 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if ( configUSE_TASK_BUDGETS == 1 )
+	{
+		vListInitialise( &xBudgetExhaustedTaskList );
+	}
+	#endif /* configUSE_TASK_BUDGETS */
+
+	#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -3478,23 +5371,59 @@ static void prvCheckTasksWaitingTermination( void )
 		being called too often in the idle task. */
 		while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
 		{
-			taskENTER_CRITICAL();
+			#if ( configNUM_CORES == 1 )
 			{
-				pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				--uxCurrentNumberOfTasks;
-				--uxDeletedTasksWaitingCleanUp;
-			}
-			taskEXIT_CRITICAL();
+				taskENTER_CRITICAL();
+				{
+					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					--uxCurrentNumberOfTasks;
+					--uxDeletedTasksWaitingCleanUp;
+				}
+				taskEXIT_CRITICAL();
 
-			prvDeleteTCB( pxTCB );
-		}
-	}
-	#endif /* INCLUDE_vTaskDelete */
-}
-/*-----------------------------------------------------------*/
+				prvDeleteTCB( pxTCB );
+			}
+			#else
+			{
+				taskENTER_CRITICAL();
+				{
+					/* A task that was deleted while it was running on another
+					core cannot be freed until that core has switched to
+					another task. */
+					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
 
-#if( configUSE_TRACE_FACILITY == 1 )
+					if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+					{
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						--uxCurrentNumberOfTasks;
+						--uxDeletedTasksWaitingCleanUp;
+					}
+					else
+					{
+						pxTCB = NULL;
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( pxTCB != NULL )
+				{
+					prvDeleteTCB( pxTCB );
+				}
+				else
+				{
+					/* Try again the next time the idle task runs. */
+					break;
+				}
+			}
+			#endif /* configNUM_CORES */
+		}
+	}
+	#endif /* INCLUDE_vTaskDelete */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRACE_FACILITY == 1 )
 
 	void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState )
 	{
@@ -3529,12 +5458,21 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif
 
+		#if ( configGENERATE_TASK_SWITCH_STATS == 1 )
+		{
+			pxTaskStatus->ulVoluntarySwitches = pxTCB->ulVoluntarySwitches;
+			pxTaskStatus->ulInvoluntarySwitches = pxTCB->ulInvoluntarySwitches;
+			pxTaskStatus->ulMaxRunTime = pxTCB->ulMaxRunTime;
+			pxTaskStatus->ulMaxTimeBetweenRuns = pxTCB->ulMaxTimeBetweenRuns;
+		}
+		#endif
+
 		/* Obtaining the task state is a little fiddly, so is only done if the
 		value of eState passed into this function is eInvalid - otherwise the
 		state is just set to whatever is passed in. */
 		if( eState != eInvalid )
 		{
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) )
 			{
 				pxTaskStatus->eCurrentState = eRunning;
 			}
@@ -3693,7 +5631,7 @@ static void prvCheckTasksWaitingTermination( void )
 			/* The task can only have been allocated dynamically - free both
 			the stack and TCB. */
 			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
+			tskFREE_TCB( pxTCB );
 		}
 		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 Macro has been consolidated for readability reasons. */
 		{
@@ -3705,13 +5643,13 @@ static void prvCheckTasksWaitingTermination( void )
 				/* Both the stack and TCB were allocated dynamically, so both
 				must be freed. */
 				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
+				tskFREE_TCB( pxTCB );
 			}
 			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
 			{
 				/* Only the stack was statically allocated, so the TCB is the
 				only memory that must be freed. */
-				vPortFree( pxTCB );
+				tskFREE_TCB( pxTCB );
 			}
 			else
 			{
@@ -3727,224 +5665,946 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-TCB_t *pxTCB;
+#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+
+	static void prvResetNextTaskUnblockTime( void )
+	{
+	TCB_t *pxTCB;
+
+		if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+		{
+			/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+			the maximum possible value so it is	extremely unlikely that the
+			if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+			there is an item in the delayed list. */
+			xNextTaskUnblockTime = portMAX_DELAY;
+		}
+		else
+		{
+			/* The new current delayed list is not empty, get the value of
+			the item at the head of the delayed list.  This is the time at
+			which the task at the head of the delayed list should be removed
+			from the Blocked state. */
+			( pxTCB ) = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+			xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+		}
+	}
+
+#else /* configUSE_DELAYED_TASK_WHEEL */
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	static void prvResetNextTaskUnblockTime( void )
 	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
+	UBaseType_t uxLevel, uxSlot;
+	uint32_t ulPendingSlots, ulSlotBit;
+
+		/* Set xNextTaskUnblockTime to the time at which the wheel next has to
+		be processed.  Slots in each level represent longer periods than the
+		slots in the level below, so the first occupied slot found when
+		searching upwards from level 0 is the one that must be processed
+		first.  Tasks in the overflow list are not considered as the wheel is
+		always processed when the tick count overflows. */
 		xNextTaskUnblockTime = portMAX_DELAY;
+
+		for( uxLevel = ( UBaseType_t ) 0; uxLevel < ( UBaseType_t ) taskWHEEL_LEVELS; uxLevel++ )
+		{
+			/* Only slots ahead of the slot the tick count is in can hold tasks.
+			The exception is the current level 0 slot, which can hold tasks
+			that cascaded into it and have not yet been processed. */
+			uxSlot = taskWHEEL_SLOT_INDEX( xTickCount, uxLevel );
+
+			if( uxLevel == ( UBaseType_t ) 0 )
+			{
+				ulPendingSlots = ulDelayedTaskWheelMap[ uxLevel ] & ~( ( 1UL << uxSlot ) - 1UL );
+			}
+			else
+			{
+				ulPendingSlots = ulDelayedTaskWheelMap[ uxLevel ] & ~( ( 2UL << uxSlot ) - 1UL );
+			}
+
+			while( ulPendingSlots != 0UL )
+			{
+				/* Find the first occupied slot. */
+				uxSlot = ( UBaseType_t ) 0;
+				while( ( ulPendingSlots & ( 1UL << uxSlot ) ) == 0UL )
+				{
+					uxSlot++;
+				}
+
+				if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ ( uxLevel * taskWHEEL_SLOTS ) + uxSlot ] ) ) == pdFALSE )
+				{
+					xNextTaskUnblockTime = prvDelayedWheelSlotTime( uxLevel, uxSlot );
+					break;
+				}
+				else
+				{
+					/* The tasks that were in the slot have since been removed
+					from the Blocked state for a reason other than a timeout.
+					Slot bits are only cleared here, and when the slot is
+					processed, to keep removing a task from the Blocked state
+					fast. */
+					ulSlotBit = 1UL << uxSlot;
+					ulDelayedTaskWheelMap[ uxLevel ] &= ~ulSlotBit;
+					ulPendingSlots &= ~ulSlotBit;
+				}
+			}
+
+			if( xNextTaskUnblockTime != portMAX_DELAY )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
 	}
-	else
+	/*-----------------------------------------------------------*/
+
+	static TickType_t prvDelayedWheelSlotTime( UBaseType_t uxLevel, UBaseType_t uxSlot )
 	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+	const UBaseType_t uxShift = uxLevel * taskWHEEL_SLOT_BITS;
+	TickType_t xLevelMask;
+
+		/* The bits of the tick count that are represented by this level and
+		the levels below it. */
+		xLevelMask = ( TickType_t ) ( ( taskWHEEL_SLOT_MASK << uxShift ) | ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U ) );
+
+		/* The slot is processed when the tick count reaches the start of the
+		period the slot represents. */
+		return ( TickType_t ) ( ( xTickCount & ( TickType_t ) ~xLevelMask ) | ( ( TickType_t ) uxSlot << uxShift ) );
 	}
-}
-/*-----------------------------------------------------------*/
+	/*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+	static void prvDelayedWheelInsert( ListItem_t *pxListItem )
+	{
+	const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxListItem );
+	TickType_t xDifference = xTimeToWake ^ xTickCount;
+	TickType_t xTimeToProcess;
+	UBaseType_t uxLevel = ( UBaseType_t ) 0, uxSlot;
 
-	TaskHandle_t xTaskGetCurrentTaskHandle( void )
+		/* The level used is that of the most significant group of bits in
+		which the wake time differs from the tick count.  The task is then
+		cascaded down a level each time the tick count reaches the slot it is
+		in, until it reaches level 0 where the slot matches the wake time
+		exactly.  This is a bounded loop, not a search. */
+		while( xDifference > taskWHEEL_SLOT_MASK )
+		{
+			xDifference >>= taskWHEEL_SLOT_BITS;
+			uxLevel++;
+		}
+
+		uxSlot = taskWHEEL_SLOT_INDEX( xTimeToWake, uxLevel );
+		vListInsertEnd( &( xDelayedTaskWheel[ ( uxLevel * taskWHEEL_SLOTS ) + uxSlot ] ), pxListItem );
+		ulDelayedTaskWheelMap[ uxLevel ] |= ( 1UL << uxSlot );
+
+		xTimeToProcess = prvDelayedWheelSlotTime( uxLevel, uxSlot );
+
+		if( xTimeToProcess < xNextTaskUnblockTime )
+		{
+			xNextTaskUnblockTime = xTimeToProcess;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDelayedWheelCascade( List_t *pxList )
 	{
-	TaskHandle_t xReturn;
+	ListItem_t *pxListItem;
+
+		while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+		{
+			pxListItem = listGET_HEAD_ENTRY( pxList );
+			( void ) uxListRemove( pxListItem );
+			prvDelayedWheelInsert( pxListItem );
+		}
+	}
+	/*-----------------------------------------------------------*/
 
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
+	static List_t *prvDelayedWheelAdvance( const TickType_t xConstTickCount )
+	{
+	UBaseType_t uxLevel = ( UBaseType_t ) 0, uxSlot;
 
-		return xReturn;
+		/* When the slot index of a level wraps to 0 the tick count enters a
+		new slot in the level above.  Find the highest level that has just
+		been entered, then cascade downwards so tasks cascaded from one level
+		can be cascaded again from the level below if necessary. */
+		while( ( uxLevel < ( ( UBaseType_t ) taskWHEEL_LEVELS - ( UBaseType_t ) 1 ) ) && ( taskWHEEL_SLOT_INDEX( xConstTickCount, uxLevel ) == ( UBaseType_t ) 0 ) )
+		{
+			uxLevel++;
+		}
+
+		while( uxLevel > ( UBaseType_t ) 0 )
+		{
+			uxSlot = taskWHEEL_SLOT_INDEX( xConstTickCount, uxLevel );
+
+			if( ( ulDelayedTaskWheelMap[ uxLevel ] & ( 1UL << uxSlot ) ) != 0UL )
+			{
+				ulDelayedTaskWheelMap[ uxLevel ] &= ~( 1UL << uxSlot );
+				prvDelayedWheelCascade( &( xDelayedTaskWheel[ ( uxLevel * taskWHEEL_SLOTS ) + uxSlot ] ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxLevel--;
+		}
+
+		/* Every task in the level 0 slot for this tick is due to unblock now,
+		so the slot is emptied by the caller. */
+		uxSlot = taskWHEEL_SLOT_INDEX( xConstTickCount, 0 );
+		ulDelayedTaskWheelMap[ 0 ] &= ~( 1UL << uxSlot );
+
+		return &( xDelayedTaskWheel[ uxSlot ] );
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+#if( ( configUSE_BITMAP_TASK_SELECTION == 1 ) && ( taskUSE_HIGHEST_SET_BIT_LOOKUP == 1 ) )
 
-	BaseType_t xTaskGetSchedulerState( void )
+	static UBaseType_t prvHighestSetBit( uint32_t ulValue )
 	{
-	BaseType_t xReturn;
+	static const uint8_t ucHighestSetBitLookup[ 32 ] =
+	{
+		0U, 9U, 1U, 10U, 13U, 21U, 2U, 29U, 11U, 14U, 16U, 18U, 22U, 25U, 3U, 30U,
+		8U, 12U, 20U, 28U, 15U, 17U, 24U, 7U, 19U, 27U, 23U, 6U, 26U, 5U, 4U, 31U
+	};
+
+		/* Set every bit below the most significant set bit, so only 32 values
+		are possible, then use a de Bruijn sequence to map each of them to a
+		unique index into the lookup table. */
+		ulValue |= ulValue >> 1;
+		ulValue |= ulValue >> 2;
+		ulValue |= ulValue >> 4;
+		ulValue |= ulValue >> 8;
+		ulValue |= ulValue >> 16;
+
+		return ( UBaseType_t ) ucHighestSetBitLookup[ ( uint32_t ) ( ulValue * 0x07C4ACDDUL ) >> 27 ];
+	}
 
-		if( xSchedulerRunning == pdFALSE )
+#endif /* configUSE_BITMAP_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvInsertTaskInDeadlineOrder( TCB_t *pxTCB )
+	{
+	List_t * const pxReadyList = &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] );
+	ListItem_t *pxIterator;
+	const TCB_t *pxListedTCB;
+
+		/* A task that is not an EDF task can only be at the EDF priority if
+		it was created at, set to, or inherited that priority.  It is given a
+		deadline equal to the time it became ready, so it runs ahead of the EDF
+		tasks that have a later deadline. */
+		if( pxTCB->xPeriod == ( TickType_t ) 0U )
 		{
-			xReturn = taskSCHEDULER_NOT_STARTED;
+			pxTCB->xDeadline = xTickCount;
 		}
 		else
 		{
-			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Find the first task that has a later deadline than pxTCB, so tasks
+		with the same deadline run in the order they became ready. */
+		for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != ( ListItem_t * ) listGET_END_MARKER( pxReadyList ); pxIterator = listGET_NEXT( pxIterator ) )
+		{
+			pxListedTCB = ( const TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+			if( taskDEADLINE_IS_BEFORE( pxTCB->xDeadline, pxListedTCB->xDeadline ) != pdFALSE )
 			{
-				xReturn = taskSCHEDULER_RUNNING;
+				break;
 			}
 			else
 			{
-				xReturn = taskSCHEDULER_SUSPENDED;
+				mtCOVERAGE_TEST_MARKER();
 			}
 		}
 
-		return xReturn;
+		/* vListInsertEnd() inserts the new item immediately before the item
+		indexed by the list, so index the task found above, or the end of the
+		list if no task has a later deadline.  The index is not otherwise used
+		by the EDF ready list as the task at its head is always selected. */
+		pxReadyList->pxIndex = pxIterator;
+		vListInsertEnd( pxReadyList, &( pxTCB->xStateListItem ) );
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if( configUSE_TASK_BUDGETS == 1 )
 
-	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+	static BaseType_t prvCheckTaskBudgets( const TickType_t xConstTickCount )
 	{
-	TCB_t * const pxMutexHolderTCB = ( TCB_t * ) pxMutexHolder;
-	BaseType_t xReturn = pdFALSE;
+	TCB_t * const pxTCB = pxCurrentTCB;
+	TCB_t *pxExhaustedTCB;
+	ListItem_t *pxIterator, *pxNext;
+	TickType_t xTicksToReplenish, xTicksToNextReplenish;
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulRunTimeCounter );
+		#else
+			ulRunTimeCounter = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
 
-		/* If the mutex was given back by an interrupt while the queue was
-		locked then the mutex holder might now be NULL.  _RB_ Is this still
-		needed as interrupts can no longer use mutexes? */
-		if( pxMutexHolder != NULL )
+		prvChargeRunningTaskBudget( ulRunTimeCounter );
+
+		/* The budget of a task that has not exhausted it is replenished the
+		first time the task is found running after its replenish time, so
+		only tasks that have exhausted their budget need to be tracked. */
+		if( ( pxTCB->ulBudget != 0UL ) && ( pxTCB->ucBudgetExhausted == pdFALSE ) )
 		{
-			/* If the holder of the mutex has a priority below the priority of
-			the task attempting to obtain the mutex then it will temporarily
-			inherit the priority of the task attempting to obtain the mutex. */
-			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+			if( taskBUDGET_TIME_IS_REACHED( pxTCB->xBudgetReplenishTime, xConstTickCount ) != pdFALSE )
 			{
-				/* Adjust the mutex holder state to account for its new
-				priority.  Only reset the event list item value if the value is
-				not being used for anything else. */
-				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				pxTCB->ulBudgetUsed = 0UL;
+				pxTCB->xBudgetReplenishTime += pxTCB->xBudgetPeriod;
+
+				/* Start a new period from now if more than a whole period
+				has passed since the task last ran. */
+				if( taskBUDGET_TIME_IS_REACHED( pxTCB->xBudgetReplenishTime, xConstTickCount ) != pdFALSE )
 				{
-					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					pxTCB->xBudgetReplenishTime = xConstTickCount + pxTCB->xBudgetPeriod;
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 
-				/* If the task being modified is in the ready state it will need
-				to be moved into a new list. */
-				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
-				{
-					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-					{
-						taskRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+				traceTASK_BUDGET_REPLENISHED( pxTCB );
+			}
+			else if( pxTCB->ulBudgetUsed >= pxTCB->ulBudget )
+			{
+				pxTCB->ucBudgetExhausted = pdTRUE;
+				( pxTCB->uxBudgetExhaustedCount )++;
+				traceTASK_BUDGET_EXHAUSTED( pxTCB );
 
-					/* Inherit the priority before being moved into the new list. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-					prvAddTaskToReadyList( pxMutexHolderTCB );
+				/* Remember the task so its budget can be replenished, and any
+				action undone, even if it does not run again. */
+				xTicksToReplenish = pxTCB->xBudgetReplenishTime - xConstTickCount;
+
+				if( ( listLIST_IS_EMPTY( &xBudgetExhaustedTaskList ) != pdFALSE ) ||
+					( xTicksToReplenish < ( TickType_t ) ( xNextBudgetReplenishTime - xConstTickCount ) ) )
+				{
+					xNextBudgetReplenishTime = pxTCB->xBudgetReplenishTime;
 				}
 				else
 				{
-					/* Just inherit the priority. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+					mtCOVERAGE_TEST_MARKER();
 				}
 
-				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+				vListInsertEnd( &xBudgetExhaustedTaskList, &( pxTCB->xBudgetListItem ) );
 
-				/* Inheritance occurred. */
-				xReturn = pdTRUE;
-			}
-			else
-			{
-				if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+				#if( configUSE_BUDGET_EXHAUSTED_HOOK == 1 )
 				{
-					/* The base priority of the mutex holder is lower than the
-					priority of the task attempting to take the mutex, but the
-					current priority of the mutex holder is not lower than the
-					priority of the task attempting to take the mutex.
-					Therefore the mutex holder must have already inherited a
-					priority, but inheritance would have occurred if that had
-					not been the case. */
-					xReturn = pdTRUE;
+					vApplicationBudgetExhaustedHook( ( TaskHandle_t ) pxTCB, pxTCB->pcTaskName );
+				}
+				#endif
+
+				if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetDemote )
+				{
+					prvSwapBudgetPriority( pxTCB );
+					xSwitchRequired = pdTRUE;
+				}
+				else if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetSuspend )
+				{
+					/* The task leaves the Blocked state when its budget is
+					replenished. */
+					prvAddCurrentTaskToDelayedList( xTicksToReplenish, pdFALSE );
+					xSwitchRequired = pdTRUE;
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		return xReturn;
-	}
-
-#endif /* configUSE_MUTEXES */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_MUTEXES == 1 )
-
-	BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
-	{
-	TCB_t * const pxTCB = ( TCB_t * ) pxMutexHolder;
-	BaseType_t xReturn = pdFALSE;
-
-		if( pxMutexHolder != NULL )
+		/* Replenish the budgets of the tasks that have exhausted their budget
+		and reached their replenish time.  The list is not sorted as few tasks
+		are expected to be in it, and it is only walked when the earliest
+		replenish time is reached. */
+		if( ( listLIST_IS_EMPTY( &xBudgetExhaustedTaskList ) == pdFALSE ) &&
+			( taskBUDGET_TIME_IS_REACHED( xNextBudgetReplenishTime, xConstTickCount ) != pdFALSE ) )
 		{
-			/* A task can only have an inherited priority if it holds the mutex.
-			If the mutex is held by a task then it cannot be given from an
-			interrupt, and if a mutex is given by the holding task then it must
-			be the running state task. */
-			configASSERT( pxTCB == pxCurrentTCB );
-			configASSERT( pxTCB->uxMutexesHeld );
-			( pxTCB->uxMutexesHeld )--;
+			xTicksToNextReplenish = portMAX_DELAY;
+			pxIterator = listGET_HEAD_ENTRY( &xBudgetExhaustedTaskList );
 
-			/* Has the holder of the mutex inherited the priority of another
-			task? */
-			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			while( pxIterator != ( ListItem_t * ) listGET_END_MARKER( &xBudgetExhaustedTaskList ) )
 			{
-				/* Only disinherit if no other mutexes are held. */
-				if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+				pxNext = listGET_NEXT( pxIterator );
+				pxExhaustedTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+				if( taskBUDGET_TIME_IS_REACHED( pxExhaustedTCB->xBudgetReplenishTime, xConstTickCount ) != pdFALSE )
 				{
-					/* A task can only have an inherited priority if it holds
-					the mutex.  If the mutex is held by a task then it cannot be
-					given from an interrupt, and if a mutex is given by the
-					holding task then it must be the running state task.  Remove
-					the holding task from the ready list. */
-					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					prvEndBudgetExhaustion( pxExhaustedTCB );
+					pxExhaustedTCB->ulBudgetUsed = 0UL;
+					pxExhaustedTCB->xBudgetReplenishTime = xConstTickCount + pxExhaustedTCB->xBudgetPeriod;
+					traceTASK_BUDGET_REPLENISHED( pxExhaustedTCB );
+
+					/* A task that was demoted may now have a higher priority
+					than the running task. */
+					if( pxExhaustedTCB->uxPriority > pxCurrentTCB->uxPriority )
 					{
-						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+						xSwitchRequired = pdTRUE;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
-
-					/* Disinherit the priority before adding the task into the
-					new	ready list. */
-					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-					pxTCB->uxPriority = pxTCB->uxBasePriority;
-
-					/* Reset the event list item value.  It cannot be in use for
-					any other purpose if this task is running, and it must be
-					running to give back the mutex. */
-					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					prvAddTaskToReadyList( pxTCB );
-
-					/* Return true to indicate that a context switch is required.
-					This is only actually required in the corner case whereby
-					multiple mutexes were held and the mutexes were given back
-					in an order different to that in which they were taken.
-					If a context switch did not occur when the first mutex was
-					returned, even if a task was waiting on it, then a context
-					switch should occur when the last mutex is returned whether
-					a task is waiting on it or not. */
-					xReturn = pdTRUE;
 				}
 				else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					xTicksToReplenish = pxExhaustedTCB->xBudgetReplenishTime - xConstTickCount;
+
+					if( xTicksToReplenish < xTicksToNextReplenish )
+					{
+						xTicksToNextReplenish = xTicksToReplenish;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				pxIterator = pxNext;
+			}
+
+			xNextBudgetReplenishTime = xConstTickCount + xTicksToNextReplenish;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvChargeRunningTaskBudget( const configRUN_TIME_COUNTER_TYPE ulRunTimeCounter )
+	{
+		/* Unlike the run time stats, budgets are expected to be used for longer
+		than the run time counter takes to overflow, so the unsigned
+		subtraction is relied on to give the correct time across an
+		overflow. */
+		if( pxCurrentTCB->ulBudget != 0UL )
+		{
+			pxCurrentTCB->ulBudgetUsed += ( uint32_t ) ( ulRunTimeCounter - ulBudgetChargedTime );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		ulBudgetChargedTime = ulRunTimeCounter;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvEndBudgetExhaustion( TCB_t *pxTCB )
+	{
+		( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+		pxTCB->ucBudgetExhausted = pdFALSE;
+
+		/* A task that was suspended is left to leave the Blocked state at its
+		replenish time, as it may since have blocked on something else. */
+		if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetDemote )
+		{
+			prvSwapBudgetPriority( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvSwapBudgetPriority( TCB_t *pxTCB )
+	{
+	const UBaseType_t uxNewPriority = pxTCB->uxBudgetPriority;
+	const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			pxTCB->uxBudgetPriority = pxTCB->uxBasePriority;
+
+			/* Only change the priority being used if the task is not
+			currently using an inherited priority, or if the priority being
+			restored is higher than the inherited priority - which is possible
+			if the priority was inherited while the task was demoted. */
+			if( ( pxTCB->uxBasePriority == pxTCB->uxPriority ) || ( uxNewPriority > pxTCB->uxPriority ) )
+			{
+				pxTCB->uxPriority = uxNewPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->uxBasePriority = uxNewPriority;
+		}
+		#else
+		{
+			pxTCB->uxBudgetPriority = pxTCB->uxPriority;
+			pxTCB->uxPriority = uxNewPriority;
+		}
+		#endif
+
+		/* Only reset the event list item value if the value is not being used
+		for anything else. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* If the task is in a ready list it must be moved to the ready list of
+		its new priority. */
+		if( ( pxTCB->uxPriority != uxPriorityUsedOnEntry ) &&
+			( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+		{
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			prvAddTaskToReadyList( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_TASK_SWITCH_STATS == 1 )
+
+	static void prvUpdateTaskSwitchStats( TCB_t *pxPreviousTCB, const configRUN_TIME_COUNTER_TYPE ulRunTimeCounter )
+	{
+	configRUN_TIME_COUNTER_TYPE ulElapsedTime;
+
+		/* Selecting the task that was already running is not a context
+		switch. */
+		if( pxCurrentTCB != pxPreviousTCB )
+		{
+			ulElapsedTime = ulRunTimeCounter - pxPreviousTCB->ulLastSwitchTime;
+
+			if( ulElapsedTime > pxPreviousTCB->ulMaxRunTime )
+			{
+				pxPreviousTCB->ulMaxRunTime = ulElapsedTime;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* A task that is still in its ready list was preempted, reached
+			the end of its time slice, or yielded.  Otherwise it blocked,
+			suspended itself, or deleted itself. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE )
+			{
+				( pxPreviousTCB->ulInvoluntarySwitches )++;
+				pxPreviousTCB->ucSwitchedOutReady = pdTRUE;
+			}
+			else
+			{
+				( pxPreviousTCB->ulVoluntarySwitches )++;
+				pxPreviousTCB->ucSwitchedOutReady = pdFALSE;
+			}
+
+			pxPreviousTCB->ulLastSwitchTime = ulRunTimeCounter;
+
+			/* The time between runs is only meaningful if the task was able
+			to run for all of it, otherwise it includes the time the task was
+			blocked. */
+			if( pxCurrentTCB->ucSwitchedOutReady != pdFALSE )
+			{
+				ulElapsedTime = ulRunTimeCounter - pxCurrentTCB->ulLastSwitchTime;
+
+				if( ulElapsedTime > pxCurrentTCB->ulMaxTimeBetweenRuns )
+				{
+					pxCurrentTCB->ulMaxTimeBetweenRuns = ulElapsedTime;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxCurrentTCB->ulLastSwitchTime = ulRunTimeCounter;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configGENERATE_TASK_SWITCH_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_SCHEDULING_LATENCY_STATS == 1 )
+
+	static void prvRecordSchedulingLatency( TCB_t *pxPreviousTCB, const configRUN_TIME_COUNTER_TYPE ulRunTimeCounter )
+	{
+	configRUN_TIME_COUNTER_TYPE ulLatency;
+	UBaseType_t uxBucket;
+
+		if( pxCurrentTCB != pxPreviousTCB )
+		{
+			/* A task that is switched out while still in its ready list
+			starts to wait to run again now.  A task that is not does not wait
+			until it is next made ready. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE )
+			{
+				pxPreviousTCB->ulReadyTime = ulRunTimeCounter;
+			}
+			else
+			{
+				pxPreviousTCB->ulReadyTime = 0UL;
+			}
+
+			if( pxCurrentTCB->ulReadyTime != ( configRUN_TIME_COUNTER_TYPE ) 0 )
+			{
+				ulLatency = ulRunTimeCounter - pxCurrentTCB->ulReadyTime;
+				pxCurrentTCB->ulReadyTime = 0UL;
+
+				if( ulLatency > ulMaxSchedulingLatencies[ pxCurrentTCB->uxPriority ] )
+				{
+					ulMaxSchedulingLatencies[ pxCurrentTCB->uxPriority ] = ulLatency;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The bucket is the position of the most significant set bit
+				of the latency, limited to the last bucket. */
+				uxBucket = ( UBaseType_t ) 0U;
+				while( ( ( ulLatency >> uxBucket ) > ( configRUN_TIME_COUNTER_TYPE ) 1 ) && ( uxBucket < ( UBaseType_t ) ( configSCHEDULING_LATENCY_BUCKETS - 1 ) ) )
+				{
+					uxBucket++;
+				}
+
+				( ulSchedulingLatencyHistograms[ pxCurrentTCB->uxPriority ][ uxBucket ] )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configGENERATE_SCHEDULING_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUM_CORES > 1 ) )
+
+	TaskHandle_t xTaskGetCurrentTaskHandle( void )
+	{
+	TaskHandle_t xReturn;
+
+		#if ( configNUM_CORES == 1 )
+		{
+			/* A critical section is not required as this is not called from
+			an interrupt and the current TCB will always be the same for any
+			individual execution thread. */
+			xReturn = pxCurrentTCB;
+		}
+		#else
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			/* Interrupts are masked so the calling task cannot move to another
+			core between the core number being read and pxCurrentTCBs[] being
+			indexed. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xReturn = pxCurrentTCB;
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#endif /* configNUM_CORES */
+
+		return xReturn;
+	}
+
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUM_CORES > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_CORES > 1 )
+
+	TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+	{
+		configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUM_CORES ) );
+		return pxCurrentTCBs[ xCoreID ];
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+
+	BaseType_t xTaskGetSchedulerState( void )
+	{
+	BaseType_t xReturn;
+
+		if( xSchedulerRunning == pdFALSE )
+		{
+			xReturn = taskSCHEDULER_NOT_STARTED;
+		}
+		else
+		{
+			/* When there is more than one core a critical section cannot be
+			entered while another core holds the scheduler suspended, so the
+			state read is that of the calling core. */
+			#if ( configNUM_CORES > 1 )
+				taskENTER_CRITICAL();
+			#endif
+			{
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					xReturn = taskSCHEDULER_RUNNING;
+				}
+				else
+				{
+					xReturn = taskSCHEDULER_SUSPENDED;
+				}
+			}
+			#if ( configNUM_CORES > 1 )
+				taskEXIT_CRITICAL();
+			#endif
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxMutexHolderTCB = ( TCB_t * ) pxMutexHolder;
+	BaseType_t xReturn = pdFALSE;
+
+		/* If the mutex was given back by an interrupt while the queue was
+		locked then the mutex holder might now be NULL.  _RB_ Is this still
+		needed as interrupts can no longer use mutexes? */
+		if( pxMutexHolder != NULL )
+		{
+			/* If the holder of the mutex has a priority below the priority of
+			the task attempting to obtain the mutex then it will temporarily
+			inherit the priority of the task attempting to obtain the mutex. */
+			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+			{
+				/* Adjust the mutex holder state to account for its new
+				priority.  Only reset the event list item value if the value is
+				not being used for anything else. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+					#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+					{
+						/* The mutex holder might itself be blocked waiting
+						for another mutex, in which case it must move up that
+						mutex's list of waiting tasks. */
+						prvReorderEventListItem( pxMutexHolderTCB );
+					}
+					#endif
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* If the task being modified is in the ready state it will need
+				to be moved into a new list. */
+				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+				{
+					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					{
+						taskRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Inherit the priority before being moved into the new list. */
+					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+					prvAddTaskToReadyList( pxMutexHolderTCB );
+				}
+				else
+				{
+					/* Just inherit the priority. */
+					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+				}
+
+				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+
+				/* Inheritance occurred. */
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+				{
+					/* The base priority of the mutex holder is lower than the
+					priority of the task attempting to take the mutex, but the
+					current priority of the mutex holder is not lower than the
+					priority of the task attempting to take the mutex.
+					Therefore the mutex holder must have already inherited a
+					priority, but inheritance would have occurred if that had
+					not been the case. */
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxTCB = ( TCB_t * ) pxMutexHolder;
+	BaseType_t xReturn = pdFALSE;
+	UBaseType_t uxPriorityToUse;
+
+		if( pxMutexHolder != NULL )
+		{
+			/* A task can only have an inherited priority if it holds the mutex.
+			If the mutex is held by a task then it cannot be given from an
+			interrupt, and if a mutex is given by the holding task then it must
+			be the running state task. */
+			configASSERT( pxTCB == pxCurrentTCB );
+			configASSERT( pxTCB->uxMutexesHeld );
+			( pxTCB->uxMutexesHeld )--;
+
+			/* Has the holder of the mutex inherited the priority of another
+			task? */
+			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			{
+				#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+				{
+					/* The mutex being given has already been removed from
+					the list of mutexes held by the task, so this is the
+					priority inherited through the mutexes that are still
+					held.  It may be the base priority. */
+					uxPriorityToUse = prvGetInheritedPriority( pxTCB );
+				}
+				#else
+				{
+					/* Only disinherit if no other mutexes are held, as the
+					other mutexes may have caused the priority inheritance. */
+					if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+					{
+						uxPriorityToUse = pxTCB->uxBasePriority;
+					}
+					else
+					{
+						uxPriorityToUse = pxTCB->uxPriority;
+					}
+				}
+				#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+
+				if( pxTCB->uxPriority != uxPriorityToUse )
+				{
+					/* A task can only have an inherited priority if it holds
+					the mutex.  If the mutex is held by a task then it cannot be
+					given from an interrupt, and if a mutex is given by the
+					holding task then it must be the running state task.  Remove
+					the holding task from the ready list. */
+					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					{
+						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Disinherit the priority before adding the task into the
+					new	ready list. */
+					traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+					pxTCB->uxPriority = uxPriorityToUse;
+
+					/* Reset the event list item value.  It cannot be in use for
+					any other purpose if this task is running, and it must be
+					running to give back the mutex. */
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					prvAddTaskToReadyList( pxTCB );
+
+					/* Return true to indicate that a context switch is required.
+					This is only actually required in the corner case whereby
+					multiple mutexes were held and the mutexes were given back
+					in an order different to that in which they were taken.
+					If a context switch did not occur when the first mutex was
+					returned, even if a task was waiting on it, then a context
+					switch should occur when the last mutex is returned whether
+					a task is waiting on it or not.  With transitive priority
+					inheritance the priority can also drop part of the way
+					while other mutexes are still held. */
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
 				}
 			}
 			else
@@ -3977,18 +6637,30 @@ TCB_t *pxTCB;
 			one mutex. */
 			configASSERT( pxTCB->uxMutexesHeld );
 
-			/* Determine the priority to which the priority of the task that
-			holds the mutex should be set.  This will be the greater of the
-			holding task's base priority and the priority of the highest
-			priority task that is waiting to obtain the mutex. */
-			if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+			#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
 			{
-				uxPriorityToUse = uxHighestPriorityWaitingTask;
+				/* The priority is recalculated from every mutex the task
+				holds, so the priority of the highest priority task waiting
+				for this one mutex is not needed. */
+				( void ) uxHighestPriorityWaitingTask;
+				uxPriorityToUse = prvGetInheritedPriority( pxTCB );
 			}
-			else
+			#else
 			{
-				uxPriorityToUse = pxTCB->uxBasePriority;
+				/* Determine the priority to which the priority of the task
+				that holds the mutex should be set.  This will be the greater
+				of the holding task's base priority and the priority of the
+				highest priority task that is waiting to obtain the mutex. */
+				if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+				{
+					uxPriorityToUse = uxHighestPriorityWaitingTask;
+				}
+				else
+				{
+					uxPriorityToUse = pxTCB->uxBasePriority;
+				}
 			}
+			#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
 
 			/* Does the priority need to change? */
 			if( pxTCB->uxPriority != uxPriorityToUse )
@@ -3996,8 +6668,10 @@ TCB_t *pxTCB;
 				/* Only disinherit if no other mutexes are held.  This is a
 				simplification in the priority inheritance implementation.  If
 				the task that holds the mutex is also holding other mutexes then
-				the other mutexes may have caused the priority inheritance. */
-				if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
+				the other mutexes may have caused the priority inheritance.  The
+				simplification is not needed when the priority was calculated
+				from every mutex held. */
+				if( ( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld ) || ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) )
 				{
 					/* If a task has timed out because it already holds the
 					mutex it was trying to obtain then it cannot of inherited
@@ -4011,35 +6685,289 @@ TCB_t *pxTCB;
 					uxPriorityUsedOnEntry = pxTCB->uxPriority;
 					pxTCB->uxPriority = uxPriorityToUse;
 
-					/* Only reset the event list item value if the value is not
-					being used for anything else. */
-					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-					{
-						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+					/* Only reset the event list item value if the value is not
+					being used for anything else. */
+					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+					{
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+						#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+						{
+							/* The mutex holder might itself be blocked waiting
+							for another mutex, in which case it must move down
+							that mutex's list of waiting tasks. */
+							prvReorderEventListItem( pxTCB );
+						}
+						#endif
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* If the running task is not the task that holds the mutex
+					then the task that holds the mutex could be in either the
+					Ready, Blocked or Suspended states.  Only remove the task
+					from its current state list if it is in the Ready state as
+					the task's priority is going to change and there is one
+					Ready list per priority. */
+					if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					{
+						if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+						{
+							taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						prvAddTaskToReadyList( pxTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					#if ( ( configNUM_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+					{
+						/* The task that holds the mutex may be running on
+						another core, which may now have to run a higher
+						priority task in its place. */
+						if( taskTASK_IS_RUNNING( pxTCB ) )
+						{
+							prvYieldCore( pxTCB->xTaskRunState );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static UBaseType_t prvGetInheritedPriority( const TCB_t * const pxTCB )
+	{
+	UBaseType_t uxPriority = pxTCB->uxBasePriority;
+	const ListItem_t *pxHeldMutexItem;
+	const ListItem_t * const pxEndMarker = listGET_END_MARKER( &( pxTCB->xMutexesHeldList ) );
+	const List_t *pxWaitingTasks;
+	const TCB_t *pxWaitingTCB;
+
+		/* Each held mutex contributes the priority of the highest priority
+		task waiting for it, which is the task at the head of its priority
+		ordered list of waiting tasks.  That task's priority might itself be
+		inherited from further along a chain of blocked mutex holders. */
+		for( pxHeldMutexItem = listGET_HEAD_ENTRY( &( pxTCB->xMutexesHeldList ) ); pxHeldMutexItem != pxEndMarker; pxHeldMutexItem = listGET_NEXT( pxHeldMutexItem ) )
+		{
+			pxWaitingTasks = ( const List_t * ) listGET_LIST_ITEM_OWNER( pxHeldMutexItem );
+
+			if( listLIST_IS_EMPTY( pxWaitingTasks ) == pdFALSE )
+			{
+				pxWaitingTCB = ( const TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxWaitingTasks );
+
+				if( pxWaitingTCB->uxPriority > uxPriority )
+				{
+					uxPriority = pxWaitingTCB->uxPriority;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return uxPriority;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static void prvReorderEventListItem( TCB_t * const pxTCB )
+	{
+	List_t * const pxEventList = ( List_t * ) listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+		/* Tasks that were unblocked while the scheduler was suspended are
+		held in xPendingReadyList, which is not in priority order. */
+		if( ( pxEventList != NULL ) && ( pxEventList != &xPendingReadyList ) )
+		{
+			( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	void vTaskEnterCritical( void )
+	{
+		portDISABLE_INTERRUPTS();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			( pxCurrentTCB->uxCriticalNesting )++;
+
+			/* This is not the interrupt safe version of the enter critical
+			function so	assert() if it is being called from an interrupt
+			context.  Only API functions that end in "FromISR" can be used in an
+			interrupt.  Only assert if the critical nesting count is 1 to
+			protect against recursive calls if the assert function also uses a
+			critical section. */
+			if( pxCurrentTCB->uxCriticalNesting == 1 )
+			{
+				portASSERT_IF_IN_ISR();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	void vTaskExitCritical( void )
+	{
+		if( xSchedulerRunning != pdFALSE )
+		{
+			if( pxCurrentTCB->uxCriticalNesting > 0U )
+			{
+				( pxCurrentTCB->uxCriticalNesting )--;
+
+				if( pxCurrentTCB->uxCriticalNesting == 0U )
+				{
+					portENABLE_INTERRUPTS();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_CORES > 1 )
+
+	void vTaskEnterCritical( void )
+	{
+		portDISABLE_INTERRUPTS();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* The outermost critical section takes the task lock, then the
+			ISR lock, so no other core can access the kernel's data from a
+			task or from an interrupt. */
+			if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+			{
+				portGET_TASK_LOCK();
+				portGET_ISR_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			portINCREMENT_CRITICAL_NESTING_COUNT();
+
+			/* This is not the interrupt safe version of the enter critical
+			function so	assert() if it is being called from an interrupt
+			context.  Only API functions that end in "FromISR" can be used in an
+			interrupt.  Only assert if the critical nesting count is 1 to
+			protect against recursive calls if the assert function also uses a
+			critical section. */
+			if( portGET_CRITICAL_NESTING_COUNT() == 1U )
+			{
+				portASSERT_IF_IN_ISR();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_CORES > 1 )
+
+	void vTaskExitCritical( void )
+	{
+	BaseType_t xYieldCurrentTask;
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+			if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+			{
+				portDECREMENT_CRITICAL_NESTING_COUNT();
+
+				if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+				{
+					/* A yield requested from within the critical section was
+					held pending, and is performed now - unless the calling
+					task has suspended the scheduler, in which case it is
+					performed when the scheduler is resumed. */
+					xYieldCurrentTask = ( ( xYieldPending != pdFALSE ) && ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) ) ? pdTRUE : pdFALSE;
+
+					portRELEASE_ISR_LOCK();
+					portRELEASE_TASK_LOCK();
+					portENABLE_INTERRUPTS();
 
-					/* If the running task is not the task that holds the mutex
-					then the task that holds the mutex could be in either the
-					Ready, Blocked or Suspended states.  Only remove the task
-					from its current state list if it is in the Ready state as
-					the task's priority is going to change and there is one
-					Ready list per priority. */
-					if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					if( xYieldCurrentTask != pdFALSE )
 					{
-						if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-						{
-							taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-
-						prvAddTaskToReadyList( pxTCB );
+						portYIELD();
 					}
 					else
 					{
@@ -4062,52 +6990,58 @@ TCB_t *pxTCB;
 		}
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* configNUM_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configNUM_CORES > 1 )
 
-	void vTaskEnterCritical( void )
+	UBaseType_t uxTaskEnterCriticalFromISR( void )
 	{
-		portDISABLE_INTERRUPTS();
+	UBaseType_t uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 
 		if( xSchedulerRunning != pdFALSE )
 		{
-			( pxCurrentTCB->uxCriticalNesting )++;
-
-			/* This is not the interrupt safe version of the enter critical
-			function so	assert() if it is being called from an interrupt
-			context.  Only API functions that end in "FromISR" can be used in an
-			interrupt.  Only assert if the critical nesting count is 1 to
-			protect against recursive calls if the assert function also uses a
-			critical section. */
-			if( pxCurrentTCB->uxCriticalNesting == 1 )
+			/* Interrupts never take the task lock, so the scheduler can remain
+			suspended by another core while interrupts are processed. */
+			if( portGET_CRITICAL_NESTING_COUNT() == 0U )
 			{
-				portASSERT_IF_IN_ISR();
+				portGET_ISR_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
 			}
+
+			portINCREMENT_CRITICAL_NESTING_COUNT();
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		return uxSavedInterruptStatus;
 	}
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configNUM_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configNUM_CORES > 1 )
 
-	void vTaskExitCritical( void )
+	void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
 	{
 		if( xSchedulerRunning != pdFALSE )
 		{
-			if( pxCurrentTCB->uxCriticalNesting > 0U )
+			configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+			if( portGET_CRITICAL_NESTING_COUNT() > 0U )
 			{
-				( pxCurrentTCB->uxCriticalNesting )--;
+				portDECREMENT_CRITICAL_NESTING_COUNT();
 
-				if( pxCurrentTCB->uxCriticalNesting == 0U )
+				if( portGET_CRITICAL_NESTING_COUNT() == 0U )
 				{
-					portENABLE_INTERRUPTS();
+					portRELEASE_ISR_LOCK();
 				}
 				else
 				{
@@ -4123,9 +7057,104 @@ TCB_t *pxTCB;
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 	}
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_CORES > 1 )
+
+	void vTaskYieldWithinAPI( void )
+	{
+		if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+		{
+			portYIELD();
+		}
+		else
+		{
+			/* The locks held by the critical section cannot be held across a
+			context switch, so the yield is performed when the critical section
+			is exited. */
+			xYieldPending = pdTRUE;
+		}
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CORE_AFFINITY == 1 )
+
+	void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( ( uxCoreAffinityMask & ( ( ( UBaseType_t ) 1U << configNUM_CORES ) - 1U ) ) != 0U );
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the affinity of the calling
+			task that is being set. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+			if( xSchedulerRunning != pdFALSE )
+			{
+				if( taskTASK_IS_RUNNING( pxTCB ) )
+				{
+					/* The task must move if it is no longer allowed to run on
+					the core it is running on.  If that is the calling core the
+					yield is performed when the critical section is exited. */
+					if( taskCAN_RUN_ON_CORE( pxTCB, pxTCB->xTaskRunState ) == pdFALSE )
+					{
+						prvYieldCore( pxTCB->xTaskRunState );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+				{
+					/* The task may now be able to run on a core that is
+					running a lower priority task. */
+					prvYieldForTask( pxTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CORE_AFFINITY == 1 )
+
+	UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxCoreAffinityMask;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxCoreAffinityMask;
+	}
+
+#endif /* configUSE_CORE_AFFINITY */
 /*-----------------------------------------------------------*/
 
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
@@ -4258,7 +7287,8 @@ TCB_t *pxTCB;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	volatile UBaseType_t uxArraySize, x;
-	uint32_t ulTotalTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime;
+	uint32_t ulStatsAsPercentage;
 
 		#if( configUSE_TRACE_FACILITY != 1 )
 		{
@@ -4320,7 +7350,7 @@ TCB_t *pxTCB;
 					/* What percentage of the total run time has the task used?
 					This will always be rounded down to the nearest integer.
 					ulTotalRunTimeDiv100 has already been divided by 100. */
-					ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+					ulStatsAsPercentage = ( uint32_t ) ( pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime );
 
 					/* Write the task name to the string, padding with
 					spaces so it can be printed in tabular form more
@@ -4331,7 +7361,7 @@ TCB_t *pxTCB;
 					{
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
 						}
 						#else
 						{
@@ -4347,7 +7377,7 @@ TCB_t *pxTCB;
 						consumed less than 1% of the total run time. */
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
 						}
 						#else
 						{
@@ -4410,19 +7440,62 @@ TickType_t uxReturn;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	void vTaskAddHeldMutex( ListItem_t * const pxMutexHeldListItem )
+	{
+		/* Called from a critical section by the task that has just taken the
+		mutex. */
+		if( pxCurrentTCB != NULL )
+		{
+			vListInsertEnd( &( pxCurrentTCB->xMutexesHeldList ), pxMutexHeldListItem );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	void vTaskSetBlockedOnMutex( void * const pvMutex )
+	{
+		pxCurrentTCB->pvBlockedOnMutex = pvMutex;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	void *pvTaskGetBlockedOnMutex( TaskHandle_t xTask )
+	{
+		/* Called from a critical section, so the task cannot be deleted while
+		its TCB is being accessed. */
+		return ( ( TCB_t * ) xTask )->pvBlockedOnMutex;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWait < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4450,17 +7523,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4468,7 +7541,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4480,22 +7553,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWait < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4528,14 +7603,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 			}
 
-			/* If ucNotifyValue is set then either the task never entered the
+			/* If ucNotifyState is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4544,11 +7619,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4560,44 +7635,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4640,16 +7716,26 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				#if ( configNUM_CORES == 1 )
 				{
-					/* The notified task has a priority above the currently
-					executing task so a yield is required. */
-					taskYIELD_IF_USING_PREEMPTION();
+					if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
+					{
+						/* The notified task has a priority above the currently
+						executing task so a yield is required. */
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* If the calling core must switch tasks the yield is
+					performed when the critical section is exited. */
+					prvYieldForTask( pxTCB );
 				}
+				#endif /* configNUM_CORES */
 			}
 			else
 			{
@@ -4666,7 +7752,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4674,6 +7760,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4695,34 +7782,34 @@ TickType_t uxReturn;
 
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4750,37 +7837,61 @@ TickType_t uxReturn;
 				{
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 					prvAddTaskToReadyList( pxTCB );
+
+					#if ( configNUM_CORES > 1 )
+					{
+						prvYieldForTask( pxTCB );
+					}
+					#endif
 				}
 				else
 				{
 					/* The delayed and ready lists cannot be accessed, so hold
 					this task pending until the scheduler is resumed. */
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+					taskRECORD_READY_TIME( pxTCB );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				#if ( configNUM_CORES == 1 )
 				{
-					/* The notified task has a priority above the currently
-					executing task so a yield is required. */
-					if( pxHigherPriorityTaskWoken != NULL )
+					if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
 					{
-						*pxHigherPriorityTaskWoken = pdTRUE;
+						/* The notified task has a priority above the currently
+						executing task so a yield is required. */
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							/* Mark that a yield is pending in case the user is not
+							using the "xHigherPriorityTaskWoken" parameter to an ISR
+							safe FreeRTOS function. */
+							xYieldPending = pdTRUE;
+						}
 					}
 					else
 					{
-						/* Mark that a yield is pending in case the user is not
-						using the "xHigherPriorityTaskWoken" parameter to an ISR
-						safe FreeRTOS function. */
-						xYieldPending = pdTRUE;
+						mtCOVERAGE_TEST_MARKER();
 					}
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* A yield is only required if the interrupted core was
+					selected to run the notified task. */
+					if( ( xYieldPending != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif /* configNUM_CORES */
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xReturn;
 	}
@@ -4790,13 +7901,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4818,14 +7930,14 @@ TickType_t uxReturn;
 
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -4840,37 +7952,61 @@ TickType_t uxReturn;
 				{
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 					prvAddTaskToReadyList( pxTCB );
+
+					#if ( configNUM_CORES > 1 )
+					{
+						prvYieldForTask( pxTCB );
+					}
+					#endif
 				}
 				else
 				{
 					/* The delayed and ready lists cannot be accessed, so hold
 					this task pending until the scheduler is resumed. */
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+					taskRECORD_READY_TIME( pxTCB );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				#if ( configNUM_CORES == 1 )
 				{
-					/* The notified task has a priority above the currently
-					executing task so a yield is required. */
-					if( pxHigherPriorityTaskWoken != NULL )
+					if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
 					{
-						*pxHigherPriorityTaskWoken = pdTRUE;
+						/* The notified task has a priority above the currently
+						executing task so a yield is required. */
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							/* Mark that a yield is pending in case the user is not
+							using the "xHigherPriorityTaskWoken" parameter in an ISR
+							safe FreeRTOS function. */
+							xYieldPending = pdTRUE;
+						}
 					}
 					else
 					{
-						/* Mark that a yield is pending in case the user is not
-						using the "xHigherPriorityTaskWoken" parameter in an ISR
-						safe FreeRTOS function. */
-						xYieldPending = pdTRUE;
+						mtCOVERAGE_TEST_MARKER();
 					}
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* A yield is only required if the interrupted core was
+					selected to run the notified task. */
+					if( ( xYieldPending != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif /* configNUM_CORES */
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 	}
 
 #endif /* configUSE_TASK_NOTIFICATIONS */
@@ -4879,20 +8015,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -4959,25 +8097,46 @@ const TickType_t xConstTickCount = xTickCount;
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
 				list. */
-				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+				{
+					vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				}
+				#else
+				{
+					/* The overflow list is not sorted.  Its tasks are placed
+					into the wheel when the tick count overflows. */
+					vListInsertEnd( &xOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				}
+				#endif
 			}
 			else
 			{
-				/* The wake time has not overflowed, so the current block list
-				is used. */
-				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-				/* If the task entering the blocked state was placed at the
-				head of the list of blocked tasks then xNextTaskUnblockTime
-				needs to be updated too. */
-				if( xTimeToWake < xNextTaskUnblockTime )
+				#if( configUSE_DELAYED_TASK_WHEEL == 0 )
 				{
-					xNextTaskUnblockTime = xTimeToWake;
+					/* The wake time has not overflowed, so the current block list
+					is used. */
+					vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+					/* If the task entering the blocked state was placed at the
+					head of the list of blocked tasks then xNextTaskUnblockTime
+					needs to be updated too. */
+					if( xTimeToWake < xNextTaskUnblockTime )
+					{
+						xNextTaskUnblockTime = xTimeToWake;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* The wake time has not overflowed, so the task is placed
+					in the wheel, which also updates xNextTaskUnblockTime if
+					necessary. */
+					prvDelayedWheelInsert( &( pxCurrentTCB->xStateListItem ) );
 				}
+				#endif
 			}
 		}
 	}
@@ -4994,24 +8153,45 @@ const TickType_t xConstTickCount = xTickCount;
 		if( xTimeToWake < xConstTickCount )
 		{
 			/* Wake time has overflowed.  Place this item in the overflow list. */
-			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+			{
+				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			}
+			#else
+			{
+				/* The overflow list is not sorted.  Its tasks are placed into
+				the wheel when the tick count overflows. */
+				vListInsertEnd( &xOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			}
+			#endif
 		}
 		else
 		{
-			/* The wake time has not overflowed, so the current block list is used. */
-			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-			/* If the task entering the blocked state was placed at the head of the
-			list of blocked tasks then xNextTaskUnblockTime needs to be updated
-			too. */
-			if( xTimeToWake < xNextTaskUnblockTime )
+			#if( configUSE_DELAYED_TASK_WHEEL == 0 )
 			{
-				xNextTaskUnblockTime = xTimeToWake;
+				/* The wake time has not overflowed, so the current block list is used. */
+				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+				/* If the task entering the blocked state was placed at the head of the
+				list of blocked tasks then xNextTaskUnblockTime needs to be updated
+				too. */
+				if( xTimeToWake < xNextTaskUnblockTime )
+				{
+					xNextTaskUnblockTime = xTimeToWake;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
-			else
+			#else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				/* The wake time has not overflowed, so the task is placed in
+				the wheel, which also updates xNextTaskUnblockTime if
+				necessary. */
+				prvDelayedWheelInsert( &( pxCurrentTCB->xStateListItem ) );
 			}
+			#endif
 		}
 
 		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
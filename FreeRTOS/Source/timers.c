@@ -38,6 +38,10 @@ task.h is included from an application file. */
 #include "queue.h"
 #include "timers.h"
 
+#if( configTIMER_POOL_LENGTH > 0 )
+	#include "pool.h"
+#endif
+
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
 	#error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
 #endif
@@ -58,6 +62,71 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 /* Misc definitions. */
 #define tmrNO_DELAY		( TickType_t ) 0U
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
+	/* Active timers are inserted into sorted lists. */
+	#define tmrINSERT_IN_CURRENT_LIST( pxTimer )	vListInsert( pxCurrentTimerList, &( ( pxTimer )->xTimerListItem ) )
+	#define tmrINSERT_IN_OVERFLOW_LIST( pxTimer )	vListInsert( pxOverflowTimerList, &( ( pxTimer )->xTimerListItem ) )
+	#define tmrOVERFLOW_LIST_IS_EMPTY()				listLIST_IS_EMPTY( pxOverflowTimerList )
+	#define tmrREMOVE_ACTIVE_TIMER( pxTimer )		( void ) uxListRemove( &( ( pxTimer )->xTimerListItem ) )
+
+#else /* configUSE_TIMER_WHEEL */
+
+	/* The active timer wheel is hierarchical, in the same way as the delayed
+	task wheel in tasks.c.  Each level has tmrWHEEL_SLOTS slots, and each slot
+	is a list of the active timers that expire within the period of time
+	represented by the slot.  Slots in level 0 each represent a single tick,
+	slots in level 1 each represent tmrWHEEL_SLOTS ticks, and so on, so enough
+	levels are required to cover every bit of the tick count.  The wheel is
+	only advanced by the timer service task, so slot indexes are relative to
+	xTimerWheelTime rather than to the tick count. */
+	#define tmrWHEEL_SLOT_BITS		( ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOTS			( ( UBaseType_t ) 1U << tmrWHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOT_MASK		( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+	#define tmrWHEEL_LEVELS			( ( ( sizeof( TickType_t ) * ( size_t ) 8U ) + ( size_t ) tmrWHEEL_SLOT_BITS - ( size_t ) 1U ) / ( size_t ) tmrWHEEL_SLOT_BITS )
+
+	/* The index of the slot that xTime falls within at level uxLevel. */
+	#define tmrWHEEL_SLOT_INDEX( xTime, uxLevel ) ( ( UBaseType_t ) ( ( ( xTime ) >> ( ( uxLevel ) * tmrWHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK ) )
+
+	/* Timers whose expiry time has overflowed the tick count are held unsorted
+	in xOverflowTimerList until the tick count overflows.  Removing the timer
+	that expires first invalidates the cached expiry time of the wheel. */
+	#define tmrINSERT_IN_CURRENT_LIST( pxTimer )	prvTimerWheelInsert( pxTimer )
+	#define tmrINSERT_IN_OVERFLOW_LIST( pxTimer )	vListInsertEnd( &xOverflowTimerList, &( ( pxTimer )->xTimerListItem ) )
+	#define tmrOVERFLOW_LIST_IS_EMPTY()				listLIST_IS_EMPTY( &xOverflowTimerList )
+	#define tmrREMOVE_ACTIVE_TIMER( pxTimer )																\
+	{																										\
+		if( listGET_LIST_ITEM_VALUE( &( ( pxTimer )->xTimerListItem ) ) == xTimerWheelNextExpiry )		\
+		{																									\
+			xTimerWheelNextExpiryValid = pdFALSE;															\
+		}																									\
+		( void ) uxListRemove( &( ( pxTimer )->xTimerListItem ) );											\
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+
+/* When configTIMER_POOL_LENGTH is greater than zero dynamically allocated
+timers are taken from the kernel's timer pool, and only come from the heap if
+the pool is empty. */
+#if( configTIMER_POOL_LENGTH > 0 )
+	#define tmrALLOCATE_TIMER()			pvPoolAllocKernelObject( poolKERNEL_POOL_TIMERS, sizeof( Timer_t ) )
+	#define tmrFREE_TIMER( pxTimer )	vPoolFreeKernelObject( poolKERNEL_POOL_TIMERS, ( void * ) ( pxTimer ) )
+#else
+	#define tmrALLOCATE_TIMER()			pvPortMalloc( sizeof( Timer_t ) )
+	#define tmrFREE_TIMER( pxTimer )	vPortFree( pxTimer )
+#endif
+
+/* A timer that has a slack time is held in the active timer list or wheel
+using the latest time it can expire, that is its expiry time plus its slack, so
+the timer service task only has to wake when that time is reached.  Timers
+whose expiry time, without their slack, has been reached by then are processed
+in the same wake-up. */
+#if( configUSE_TIMER_SLACK == 1 )
+	#define tmrGET_SLACK( pxTimer )		( ( pxTimer )->xTimerSlack )
+#else
+	#define tmrGET_SLACK( pxTimer )		( ( TickType_t ) 0U )
+#endif
+
 /* The name assigned to the timer service task.  This can be overridden by
 defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
 #ifndef configTIMER_SERVICE_TASK_NAME
@@ -80,6 +149,10 @@ typedef struct tmrTimerControl
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t 			ucStaticallyAllocated; /*<< Set to pdTRUE if the timer was created statically so no attempt is made to free the memory again if the timer is later deleted. */
 	#endif
+
+	#if( configUSE_TIMER_SLACK == 1 )
+		TickType_t			xTimerSlack;		/*<< How many ticks the timer can expire late by so it can share a wake-up with other timers.  The timer's list item value is its expiry time plus its slack. */
+	#endif
 } xTIMER;
 
 /* The old xTIMER name is maintained above then typedefed to the new Timer_t
@@ -125,13 +198,32 @@ typedef struct tmrTimerQueueMessage
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+#if( configUSE_TIMER_WHEEL == 0 )
+
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access these lists. */
+	PRIVILEGED_DATA static List_t xActiveTimerList1;
+	PRIVILEGED_DATA static List_t xActiveTimerList2;
+	PRIVILEGED_DATA static List_t *pxCurrentTimerList;
+	PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+
+#else
+
+	/* Active timers are held in the slot of the wheel that corresponds to their
+	expiry time.  Only the timer service task is allowed to access the wheel. */
+	PRIVILEGED_DATA static List_t xActiveTimerWheel[ tmrWHEEL_LEVELS * tmrWHEEL_SLOTS ];
+	PRIVILEGED_DATA static uint32_t ulActiveTimerWheelMap[ tmrWHEEL_LEVELS ];	/*< One bit per slot of each level of the wheel, set when a timer is placed in the slot. */
+	PRIVILEGED_DATA static List_t xOverflowTimerList;							/*< Active timers whose expiry time has overflowed the tick count. */
+	PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;		/*< The time the wheel has been advanced to.  Never ahead of the tick count. */
+	PRIVILEGED_DATA static TickType_t xTimerWheelNextExpiry = ( TickType_t ) 0U;	/*< The expiry time of the timer in the wheel that expires first... */
+	PRIVILEGED_DATA static BaseType_t xTimerWheelNextExpiryValid = pdFALSE;		/*< ...which is only valid if this is pdTRUE. */
+
+	#if( configUSE_TIMER_SLACK == 1 )
+		PRIVILEGED_DATA static Timer_t *pxTimerWheelNextTimer = NULL;			/*< A timer that expires at xTimerWheelNextExpiry. */
+	#endif
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -165,22 +257,75 @@ static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
 static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
 
 /*
- * Called by the timer service task to interpret and process a command it
- * received on the timer queue.
+ * Called by the timer service task to empty the timer queue, receiving up to
+ * configTIMER_COMMAND_BATCH_SIZE commands at a time.
  */
 static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called by prvProcessReceivedCommands() to interpret and process a command
+ * the timer service task received on the timer queue.
+ */
+static void prvProcessReceivedCommand( const DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
  */
-static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the active timer in the current list (or wheel) that expires first,
+ * or NULL if there are no active timers in the current list.  Must only be
+ * called once the timer's expiry time has been reached, as the wheel is
+ * advanced up to the expiry time.
+ */
+static Timer_t *prvGetFirstActiveTimer( void ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Place pxTimer into the slot of the wheel that corresponds to the expiry
+	 * time held in its list item's value, which must not be earlier than
+	 * xTimerWheelTime.
+	 */
+	static void prvTimerWheelInsert( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move every timer in pxList (a slot of the wheel, or the overflow list)
+	 * into the slot of the wheel that is correct for xTimerWheelTime.
+	 */
+	static void prvTimerWheelCascade( List_t *pxList ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Find the slot that holds the timer that expires first.  Slots in each
+	 * level represent longer periods than the slots in the level below, so that
+	 * is the first occupied slot found when searching upwards from level 0.
+	 * Returns pdFALSE if the wheel is empty.
+	 */
+	static BaseType_t prvTimerWheelFindFirstSlot( UBaseType_t * const puxLevel, UBaseType_t * const puxSlot ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The time at which the period represented by slot uxSlot of level uxLevel
+	 * starts.
+	 */
+	static TickType_t prvTimerWheelSlotTime( UBaseType_t uxLevel, UBaseType_t uxSlot ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto reload timer, then call its callback.
  */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+static void prvProcessExpiredTimer( Timer_t * const pxTimer, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called after a timer has expired to find any other timer that can be
+ * processed in the same wake-up - either because it has also expired, or
+ * because it has a slack time and the time it would have expired without the
+ * slack has been reached.  Returns NULL if there is no such timer.
+ */
+static Timer_t *prvGetTimerToCoalesce( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
@@ -283,7 +428,7 @@ BaseType_t xReturn = pdFAIL;
 	{
 	Timer_t *pxNewTimer;
 
-		pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) );
+		pxNewTimer = ( Timer_t * ) tmrALLOCATE_TIMER();
 
 		if( pxNewTimer != NULL )
 		{
@@ -349,6 +494,62 @@ BaseType_t xReturn = pdFAIL;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_TIMER_SLACK == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	TimerHandle_t xTimerCreateWithSlack(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const TickType_t xTimerPeriodInTicks,
+											const UBaseType_t uxAutoReload,
+											void * const pvTimerID,
+											TimerCallbackFunction_t pxCallbackFunction,
+											const TickType_t xTimerSlack )
+	{
+	Timer_t *pxNewTimer;
+
+		/* The slack is added to expiry times, so must leave room for the
+		timer's period within half the range of the tick count for overflows
+		to be detected. */
+		configASSERT( xTimerSlack < ( portMAX_DELAY >> 1 ) );
+
+		pxNewTimer = ( Timer_t * ) xTimerCreate( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction );
+
+		if( pxNewTimer != NULL )
+		{
+			pxNewTimer->xTimerSlack = xTimerSlack;
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* configUSE_TIMER_SLACK && configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_TIMER_SLACK == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	TimerHandle_t xTimerCreateStaticWithSlack(	const char * const pcTimerName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												const TickType_t xTimerPeriodInTicks,
+												const UBaseType_t uxAutoReload,
+												void * const pvTimerID,
+												TimerCallbackFunction_t pxCallbackFunction,
+												const TickType_t xTimerSlack,
+												StaticTimer_t *pxTimerBuffer )
+	{
+	Timer_t *pxNewTimer;
+
+		configASSERT( xTimerSlack < ( portMAX_DELAY >> 1 ) );
+
+		pxNewTimer = ( Timer_t * ) xTimerCreateStatic( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxTimerBuffer );
+
+		if( pxNewTimer != NULL )
+		{
+			pxNewTimer->xTimerSlack = xTimerSlack;
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* configUSE_TIMER_SLACK && configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 									const TickType_t xTimerPeriodInTicks,
 									const UBaseType_t uxAutoReload,
@@ -373,6 +574,13 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 		pxNewTimer->pvTimerID = pvTimerID;
 		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+
+		#if( configUSE_TIMER_SLACK == 1 )
+		{
+			pxNewTimer->xTimerSlack = ( TickType_t ) 0U;
+		}
+		#endif /* configUSE_TIMER_SLACK */
+
 		traceTIMER_CREATE( pxNewTimer );
 	}
 }
@@ -445,11 +653,24 @@ Timer_t * pxTimer = ( Timer_t * ) xTimer;
 TickType_t xReturn;
 
 	configASSERT( xTimer );
-	xReturn = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	xReturn = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) - tmrGET_SLACK( pxTimer );
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_SLACK == 1 )
+
+	TickType_t xTimerGetSlack( TimerHandle_t xTimer )
+	{
+	Timer_t *pxTimer = ( Timer_t * ) xTimer;
+
+		configASSERT( xTimer );
+		return pxTimer->xTimerSlack;
+	}
+
+#endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
 const char * pcTimerGetName( TimerHandle_t xTimer ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 {
 Timer_t *pxTimer = ( Timer_t * ) xTimer;
@@ -459,14 +680,18 @@ Timer_t *pxTimer = ( Timer_t * ) xTimer;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+static void prvProcessExpiredTimer( Timer_t * const pxTimer, const TickType_t xTimeNow )
 {
 BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+TickType_t xNextExpireTime;
 
 	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	been performed to ensure the list is not empty.  The time the timer
+	expired, from which an auto reload timer is reloaded, does not include
+	its slack. */
+	configASSERT( pxTimer );
+	xNextExpireTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) - tmrGET_SLACK( pxTimer );
+	tmrREMOVE_ACTIVE_TIMER( pxTimer );
 	traceTIMER_EXPIRED( pxTimer );
 
 	/* If the timer is an auto reload timer then calculate the next
@@ -539,6 +764,7 @@ static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseTy
 {
 TickType_t xTimeNow;
 BaseType_t xTimerListsWereSwitched;
+Timer_t *pxTimer;
 
 	vTaskSuspendAll();
 	{
@@ -554,7 +780,16 @@ BaseType_t xTimerListsWereSwitched;
 			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
 			{
 				( void ) xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				prvProcessExpiredTimer( prvGetFirstActiveTimer(), xTimeNow );
+
+				/* Process any other timers that can be processed by xTimeNow
+				now, rather than once per pass through the loop in
+				prvTimerTask(), which suspends the scheduler and samples the
+				time for each timer. */
+				while( ( pxTimer = prvGetTimerToCoalesce( xTimeNow ) ) != NULL )
+				{
+					prvProcessExpiredTimer( pxTimer, xTimeNow );
+				}
 			}
 			else
 			{
@@ -568,7 +803,7 @@ BaseType_t xTimerListsWereSwitched;
 				{
 					/* The current timer list is empty - is the overflow list
 					also empty? */
-					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					xListWasEmpty = tmrOVERFLOW_LIST_IS_EMPTY();
 				}
 
 				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
@@ -595,6 +830,73 @@ BaseType_t xTimerListsWereSwitched;
 }
 /*-----------------------------------------------------------*/
 
+static Timer_t *prvGetTimerToCoalesce( const TickType_t xTimeNow )
+{
+Timer_t *pxTimer = NULL;
+TickType_t xNextExpireTime;
+BaseType_t xListWasEmpty;
+
+	/* Stop if a command is waiting as a callback might have stopped or
+	changed one of the timers, and commands must be processed in order with
+	expiries. */
+	if( uxQueueMessagesWaiting( xTimerQueue ) == ( UBaseType_t ) 0 )
+	{
+		xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+
+		if( xListWasEmpty == pdFALSE )
+		{
+			if( xNextExpireTime <= xTimeNow )
+			{
+				pxTimer = prvGetFirstActiveTimer();
+			}
+			else
+			{
+				#if( configUSE_TIMER_SLACK == 1 )
+				{
+					/* The first timer is not yet at the latest time it can
+					expire, but can be processed now if its expiry time without
+					its slack has been reached.  The wheel cannot be advanced
+					to the timer as the wheel is never ahead of the tick count,
+					so the timer is taken from the cache. */
+					#if( configUSE_TIMER_WHEEL == 0 )
+					{
+						pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+					}
+					#else
+					{
+						pxTimer = pxTimerWheelNextTimer;
+					}
+					#endif /* configUSE_TIMER_WHEEL */
+
+					/* If subtracting the slack wraps then the expiry time
+					without the slack was before the tick count overflowed, so
+					has been reached. */
+					if( ( pxTimer->xTimerSlack <= xNextExpireTime ) && ( ( xNextExpireTime - pxTimer->xTimerSlack ) > xTimeNow ) )
+					{
+						pxTimer = NULL;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_TIMER_SLACK */
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxTimer;
+}
+/*-----------------------------------------------------------*/
+
 static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
 {
 TickType_t xNextExpireTime;
@@ -606,16 +908,106 @@ TickType_t xNextExpireTime;
 	this task to unblock when the tick count overflows, at which point the
 	timer lists will be switched and the next expiry time can be
 	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	#if( configUSE_TIMER_WHEEL == 0 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+		if( *pxListWasEmpty == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		else
+		{
+			/* Ensure the task unblocks when the tick count rolls over. */
+			xNextExpireTime = ( TickType_t ) 0U;
+		}
 	}
-	else
+	#else
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( TickType_t ) 0U;
+	UBaseType_t uxLevel, uxSlot;
+	const ListItem_t *pxListItem;
+	const ListItem_t *pxListEnd;
+
+		/* The wheel holds timers in the slot that represents their expiry
+		time, not in expiry time order.  The first expiry time is cached, and
+		only searched for when the cached value is invalidated by the first
+		timer being removed from the wheel. */
+		if( xTimerWheelNextExpiryValid == pdFALSE )
+		{
+			if( prvTimerWheelFindFirstSlot( &uxLevel, &uxSlot ) != pdFALSE )
+			{
+				if( uxLevel == ( UBaseType_t ) 0 )
+				{
+					/* Every timer in a level 0 slot expires at the same time. */
+					xTimerWheelNextExpiry = prvTimerWheelSlotTime( uxLevel, uxSlot );
+
+					#if( configUSE_TIMER_SLACK == 1 )
+					{
+						pxTimerWheelNextTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xActiveTimerWheel[ uxSlot ] ) );
+					}
+					#endif /* configUSE_TIMER_SLACK */
+				}
+				else
+				{
+					/* Timers in higher level slots expire at different times
+					within the period represented by the slot, so find the
+					first.  Using the start of the slot instead would wake the
+					timer service task before any timer had expired. */
+					pxListEnd = listGET_END_MARKER( &( xActiveTimerWheel[ ( uxLevel * tmrWHEEL_SLOTS ) + uxSlot ] ) );
+					pxListItem = listGET_HEAD_ENTRY( &( xActiveTimerWheel[ ( uxLevel * tmrWHEEL_SLOTS ) + uxSlot ] ) );
+					xTimerWheelNextExpiry = listGET_LIST_ITEM_VALUE( pxListItem );
+
+					#if( configUSE_TIMER_SLACK == 1 )
+					{
+						pxTimerWheelNextTimer = ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+					}
+					#endif /* configUSE_TIMER_SLACK */
+
+					while( pxListItem != pxListEnd )
+					{
+						if( listGET_LIST_ITEM_VALUE( pxListItem ) < xTimerWheelNextExpiry )
+						{
+							xTimerWheelNextExpiry = listGET_LIST_ITEM_VALUE( pxListItem );
+
+							#if( configUSE_TIMER_SLACK == 1 )
+							{
+								pxTimerWheelNextTimer = ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+							}
+							#endif /* configUSE_TIMER_SLACK */
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						pxListItem = listGET_NEXT( pxListItem );
+					}
+				}
+
+				xTimerWheelNextExpiryValid = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xTimerWheelNextExpiryValid != pdFALSE )
+		{
+			*pxListWasEmpty = pdFALSE;
+			xNextExpireTime = xTimerWheelNextExpiry;
+		}
+		else
+		{
+			/* Ensure the task unblocks when the tick count rolls over. */
+			*pxListWasEmpty = pdTRUE;
+			xNextExpireTime = ( TickType_t ) 0U;
+		}
 	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xNextExpireTime;
 }
@@ -644,9 +1036,10 @@ PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Va
 }
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
+static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
 {
 BaseType_t xProcessTimerNow = pdFALSE;
+const TickType_t xNextExpiryTime = xExpiryTime + tmrGET_SLACK( pxTimer );
 
 	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
@@ -663,7 +1056,7 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			tmrINSERT_IN_OVERFLOW_LIST( pxTimer );
 		}
 	}
 	else
@@ -677,7 +1070,7 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			tmrINSERT_IN_CURRENT_LIST( pxTimer );
 		}
 	}
 
@@ -687,146 +1080,159 @@ BaseType_t xProcessTimerNow = pdFALSE;
 
 static void	prvProcessReceivedCommands( void )
 {
-DaemonTaskMessage_t xMessage;
+DaemonTaskMessage_t xMessages[ configTIMER_COMMAND_BATCH_SIZE ];
+UBaseType_t uxMessagesReceived, uxMessage;
+
+	/* Receiving several commands at a time enters the queue's critical section
+	once per batch, rather than once per command. */
+	while( ( uxMessagesReceived = uxQueueReceiveMultiple( xTimerQueue, xMessages, ( UBaseType_t ) configTIMER_COMMAND_BATCH_SIZE, tmrNO_DELAY ) ) != ( UBaseType_t ) 0 ) /*lint !e603 xMessages does not have to be initialised as it is passed out, not in, and it is only used up to the number of messages received. */
+	{
+		for( uxMessage = ( UBaseType_t ) 0; uxMessage < uxMessagesReceived; uxMessage++ )
+		{
+			prvProcessReceivedCommand( &( xMessages[ uxMessage ] ) );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessReceivedCommand( const DaemonTaskMessage_t * const pxMessage )
+{
 Timer_t *pxTimer;
 BaseType_t xTimerListsWereSwitched, xResult;
 TickType_t xTimeNow;
 
-	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	#if ( INCLUDE_xTimerPendFunctionCall == 1 )
 	{
-		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+		/* Negative commands are pended function calls rather than timer
+		commands. */
+		if( pxMessage->xMessageID < ( BaseType_t ) 0 )
 		{
-			/* Negative commands are pended function calls rather than timer
-			commands. */
-			if( xMessage.xMessageID < ( BaseType_t ) 0 )
-			{
-				const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
+			const CallbackParameters_t * const pxCallback = &( pxMessage->u.xCallbackParameters );
 
-				/* The timer uses the xCallbackParameters member to request a
-				callback be executed.  Check the callback is not NULL. */
-				configASSERT( pxCallback );
+			/* The timer uses the xCallbackParameters member to request a
+			callback be executed.  Check the callback is not NULL. */
+			configASSERT( pxCallback );
 
-				/* Call the function. */
-				pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+			/* Call the function. */
+			pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
 		}
-		#endif /* INCLUDE_xTimerPendFunctionCall */
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* INCLUDE_xTimerPendFunctionCall */
 
-		/* Commands that are positive are timer commands rather than pended
-		function calls. */
-		if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+	/* Commands that are positive are timer commands rather than pended
+	function calls. */
+	if( pxMessage->xMessageID >= ( BaseType_t ) 0 )
+	{
+		/* The messages uses the xTimerParameters member to work on a
+		software timer. */
+		pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+
+		if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+		{
+			/* The timer is in a list, remove it. */
+			tmrREMOVE_ACTIVE_TIMER( pxTimer );
+		}
+		else
 		{
-			/* The messages uses the xTimerParameters member to work on a
-			software timer. */
-			pxTimer = xMessage.u.xTimerParameters.pxTimer;
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
-			{
-				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+		traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue );
 
-			traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+		/* In this case the xTimerListsWereSwitched parameter is not used, but
+		it must be present in the function call.  prvSampleTimeNow() must be
+		called after the message is received from xTimerQueue so there is no
+		possibility of a higher priority task adding a message to the message
+		queue with a time that is ahead of the timer daemon task (because it
+		pre-empted the timer daemon task after the xTimeNow value was set). */
+		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 
-			/* In this case the xTimerListsWereSwitched parameter is not used, but
-			it must be present in the function call.  prvSampleTimeNow() must be
-			called after the message is received from xTimerQueue so there is no
-			possibility of a higher priority task adding a message to the message
-			queue with a time that is ahead of the timer daemon task (because it
-			pre-empted the timer daemon task after the xTimeNow value was set). */
-			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+		switch( pxMessage->xMessageID )
+		{
+			case tmrCOMMAND_START :
+		    case tmrCOMMAND_START_FROM_ISR :
+		    case tmrCOMMAND_RESET :
+		    case tmrCOMMAND_RESET_FROM_ISR :
+			case tmrCOMMAND_START_DONT_TRACE :
+				/* Start or restart a timer. */
+				if( prvInsertTimerInActiveList( pxTimer,  pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, pxMessage->u.xTimerParameters.xMessageValue ) != pdFALSE )
+				{
+					/* The timer expired before it was added to the active
+					timer list.  Process it now. */
+					pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+					traceTIMER_EXPIRED( pxTimer );
 
-			switch( xMessage.xMessageID )
-			{
-				case tmrCOMMAND_START :
-			    case tmrCOMMAND_START_FROM_ISR :
-			    case tmrCOMMAND_RESET :
-			    case tmrCOMMAND_RESET_FROM_ISR :
-				case tmrCOMMAND_START_DONT_TRACE :
-					/* Start or restart a timer. */
-					if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
+					if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
 					{
-						/* The timer expired before it was added to the active
-						timer list.  Process it now. */
-						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-						traceTIMER_EXPIRED( pxTimer );
-
-						if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
-						{
-							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-							configASSERT( xResult );
-							( void ) xResult;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
+						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+						configASSERT( xResult );
+						( void ) xResult;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
-					break;
-
-				case tmrCOMMAND_STOP :
-				case tmrCOMMAND_STOP_FROM_ISR :
-					/* The timer has already been removed from the active list.
-					There is nothing to do here. */
-					break;
-
-				case tmrCOMMAND_CHANGE_PERIOD :
-				case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
-					pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-					configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-					/* The new period does not really have a reference, and can
-					be longer or shorter than the old one.  The command time is
-					therefore set to the current time, and as the period cannot
-					be zero the next expiry time can only be in the future,
-					meaning (unlike for the xTimerStart() case above) there is
-					no fail case that needs to be handled here. */
-					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-					break;
-
-				case tmrCOMMAND_DELETE :
-					/* The timer has already been removed from the active list,
-					just free up the memory if the memory was dynamically
-					allocated. */
-					#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				break;
+
+			case tmrCOMMAND_STOP :
+			case tmrCOMMAND_STOP_FROM_ISR :
+				/* The timer has already been removed from the active list.
+				There is nothing to do here. */
+				break;
+
+			case tmrCOMMAND_CHANGE_PERIOD :
+			case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+				pxTimer->xTimerPeriodInTicks = pxMessage->u.xTimerParameters.xMessageValue;
+				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+				/* The new period does not really have a reference, and can
+				be longer or shorter than the old one.  The command time is
+				therefore set to the current time, and as the period cannot
+				be zero the next expiry time can only be in the future,
+				meaning (unlike for the xTimerStart() case above) there is
+				no fail case that needs to be handled here. */
+				( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+				break;
+
+			case tmrCOMMAND_DELETE :
+				/* The timer has already been removed from the active list,
+				just free up the memory if the memory was dynamically
+				allocated. */
+				#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+				{
+					/* The timer can only have been allocated dynamically -
+					free it again. */
+					tmrFREE_TIMER( pxTimer );
+				}
+				#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+				{
+					/* The timer could have been allocated statically or
+					dynamically, so check before attempting to free the
+					memory. */
+					if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
 					{
-						/* The timer can only have been allocated dynamically -
-						free it again. */
-						vPortFree( pxTimer );
+						tmrFREE_TIMER( pxTimer );
 					}
-					#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+					else
 					{
-						/* The timer could have been allocated statically or
-						dynamically, so check before attempting to free the
-						memory. */
-						if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-						{
-							vPortFree( pxTimer );
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
+						mtCOVERAGE_TEST_MARKER();
 					}
-					#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-					break;
+				}
+				#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+				break;
 
-				default	:
-					/* Don't expect to get here. */
-					break;
-			}
+			default	:
+				/* Don't expect to get here. */
+				break;
 		}
 	}
 }
@@ -835,21 +1241,22 @@ TickType_t xTimeNow;
 static void prvSwitchTimerLists( void )
 {
 TickType_t xNextExpireTime, xReloadTime;
-List_t *pxTemp;
 Timer_t *pxTimer;
 BaseType_t xResult;
+#if( configUSE_TIMER_WHEEL == 0 )
+	List_t *pxTemp;
+#endif
 
 	/* The tick count has overflowed.  The timer lists must be switched.
 	If there are any timers still referenced from the current timer list
 	then they must have expired and should be processed before the lists
 	are switched. */
-	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+	while( ( pxTimer = prvGetFirstActiveTimer() ) != NULL )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		xNextExpireTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
 
 		/* Remove the timer from the list. */
-		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		tmrREMOVE_ACTIVE_TIMER( pxTimer );
 		traceTIMER_EXPIRED( pxTimer );
 
 		/* Execute its callback, then send a command to restart the timer if
@@ -870,11 +1277,11 @@ BaseType_t xResult;
 			{
 				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
 				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				tmrINSERT_IN_CURRENT_LIST( pxTimer );
 			}
 			else
 			{
-				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime - tmrGET_SLACK( pxTimer ), NULL, tmrNO_DELAY );
 				configASSERT( xResult );
 				( void ) xResult;
 			}
@@ -885,12 +1292,195 @@ BaseType_t xResult;
 		}
 	}
 
-	pxTemp = pxCurrentTimerList;
-	pxCurrentTimerList = pxOverflowTimerList;
-	pxOverflowTimerList = pxTemp;
+	#if( configUSE_TIMER_WHEEL == 0 )
+	{
+		pxTemp = pxCurrentTimerList;
+		pxCurrentTimerList = pxOverflowTimerList;
+		pxOverflowTimerList = pxTemp;
+	}
+	#else
+	{
+		/* The wheel is now empty.  Restart it from the new tick count, and
+		distribute the timers that were waiting for the overflow into it. */
+		xTimerWheelTime = ( TickType_t ) 0U;
+		xTimerWheelNextExpiryValid = pdFALSE;
+		prvTimerWheelCascade( &xOverflowTimerList );
+	}
+	#endif /* configUSE_TIMER_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
+	static Timer_t *prvGetFirstActiveTimer( void )
+	{
+	Timer_t *pxTimer;
+
+		if( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+		{
+			pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		else
+		{
+			pxTimer = NULL;
+		}
+
+		return pxTimer;
+	}
+
+#else /* configUSE_TIMER_WHEEL */
+
+	static Timer_t *prvGetFirstActiveTimer( void )
+	{
+	UBaseType_t uxLevel, uxSlot;
+	Timer_t *pxTimer = NULL;
+
+		/* Advance the wheel to the start of the first occupied slot, cascading
+		the timers in the slot to lower levels, until the first occupied slot
+		is in level 0.  Every timer in that slot expires at the time the wheel
+		has then been advanced to.  Each timer can only cascade once per level,
+		so this is a bounded loop.  As the wheel is never advanced beyond the
+		first expiry time, it is never ahead of the tick count. */
+		while( prvTimerWheelFindFirstSlot( &uxLevel, &uxSlot ) != pdFALSE )
+		{
+			xTimerWheelTime = prvTimerWheelSlotTime( uxLevel, uxSlot );
+
+			if( uxLevel == ( UBaseType_t ) 0 )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xActiveTimerWheel[ uxSlot ] ) );
+				break;
+			}
+			else
+			{
+				ulActiveTimerWheelMap[ uxLevel ] &= ~( 1UL << uxSlot );
+				prvTimerWheelCascade( &( xActiveTimerWheel[ ( uxLevel * tmrWHEEL_SLOTS ) + uxSlot ] ) );
+			}
+		}
+
+		return pxTimer;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvTimerWheelFindFirstSlot( UBaseType_t * const puxLevel, UBaseType_t * const puxSlot )
+	{
+	UBaseType_t uxLevel, uxSlot;
+	uint32_t ulPendingSlots, ulSlotBit;
+
+		for( uxLevel = ( UBaseType_t ) 0; uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS; uxLevel++ )
+		{
+			/* Only slots ahead of the slot xTimerWheelTime is in can hold
+			timers.  The exception is the current level 0 slot, which can hold
+			timers that expire at xTimerWheelTime. */
+			uxSlot = tmrWHEEL_SLOT_INDEX( xTimerWheelTime, uxLevel );
+
+			if( uxLevel == ( UBaseType_t ) 0 )
+			{
+				ulPendingSlots = ulActiveTimerWheelMap[ uxLevel ] & ~( ( 1UL << uxSlot ) - 1UL );
+			}
+			else
+			{
+				ulPendingSlots = ulActiveTimerWheelMap[ uxLevel ] & ~( ( 2UL << uxSlot ) - 1UL );
+			}
+
+			while( ulPendingSlots != 0UL )
+			{
+				/* Find the first occupied slot. */
+				uxSlot = ( UBaseType_t ) 0;
+				while( ( ulPendingSlots & ( 1UL << uxSlot ) ) == 0UL )
+				{
+					uxSlot++;
+				}
+
+				if( listLIST_IS_EMPTY( &( xActiveTimerWheel[ ( uxLevel * tmrWHEEL_SLOTS ) + uxSlot ] ) ) == pdFALSE )
+				{
+					*puxLevel = uxLevel;
+					*puxSlot = uxSlot;
+					return pdTRUE;
+				}
+				else
+				{
+					/* The timers that were in the slot have since expired,
+					been stopped or been restarted.  Slot bits are only cleared
+					here, and when the slot is cascaded, to keep removing a timer
+					from the wheel fast. */
+					ulSlotBit = 1UL << uxSlot;
+					ulActiveTimerWheelMap[ uxLevel ] &= ~ulSlotBit;
+					ulPendingSlots &= ~ulSlotBit;
+				}
+			}
+		}
+
+		return pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	static TickType_t prvTimerWheelSlotTime( UBaseType_t uxLevel, UBaseType_t uxSlot )
+	{
+	const UBaseType_t uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+	TickType_t xLevelMask;
+
+		/* The bits of the time that are represented by this level and the
+		levels below it. */
+		xLevelMask = ( TickType_t ) ( ( tmrWHEEL_SLOT_MASK << uxShift ) | ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U ) );
+
+		return ( TickType_t ) ( ( xTimerWheelTime & ( TickType_t ) ~xLevelMask ) | ( ( TickType_t ) uxSlot << uxShift ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimerWheelInsert( Timer_t * const pxTimer )
+	{
+	const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	TickType_t xDifference = xExpiryTime ^ xTimerWheelTime;
+	UBaseType_t uxLevel = ( UBaseType_t ) 0, uxSlot;
+
+		configASSERT( xExpiryTime >= xTimerWheelTime );
+
+		/* The level used is that of the most significant group of bits in
+		which the expiry time differs from xTimerWheelTime.  The timer is then
+		cascaded down a level each time the wheel is advanced to the slot it is
+		in, until it reaches level 0. */
+		while( xDifference > tmrWHEEL_SLOT_MASK )
+		{
+			xDifference >>= tmrWHEEL_SLOT_BITS;
+			uxLevel++;
+		}
+
+		uxSlot = tmrWHEEL_SLOT_INDEX( xExpiryTime, uxLevel );
+		vListInsertEnd( &( xActiveTimerWheel[ ( uxLevel * tmrWHEEL_SLOTS ) + uxSlot ] ), &( pxTimer->xTimerListItem ) );
+		ulActiveTimerWheelMap[ uxLevel ] |= ( 1UL << uxSlot );
+
+		if( ( xTimerWheelNextExpiryValid != pdFALSE ) && ( xExpiryTime < xTimerWheelNextExpiry ) )
+		{
+			xTimerWheelNextExpiry = xExpiryTime;
+
+			#if( configUSE_TIMER_SLACK == 1 )
+			{
+				pxTimerWheelNextTimer = pxTimer;
+			}
+			#endif /* configUSE_TIMER_SLACK */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimerWheelCascade( List_t *pxList )
+	{
+	ListItem_t *pxListItem;
+
+		while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+		{
+			pxListItem = listGET_HEAD_ENTRY( pxList );
+			( void ) uxListRemove( pxListItem );
+			prvTimerWheelInsert( ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxListItem ) );
+		}
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
 static void prvCheckForValidListAndQueue( void )
 {
 	/* Check that the list from which active timers are referenced, and the
@@ -900,10 +1490,25 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if( configUSE_TIMER_WHEEL == 0 )
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#else
+			{
+			UBaseType_t uxSlot;
+
+				for( uxSlot = ( UBaseType_t ) 0; uxSlot < ( UBaseType_t ) ( tmrWHEEL_LEVELS * tmrWHEEL_SLOTS ); uxSlot++ )
+				{
+					vListInitialise( &( xActiveTimerWheel[ uxSlot ] ) );
+				}
+
+				vListInitialise( &xOverflowTimerList );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
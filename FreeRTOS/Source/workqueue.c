@@ -0,0 +1,953 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "workqueue.h"
+
+/* Worker tasks wait for work using direct to task notifications. */
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build workqueue.c
+#endif
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* Work items submitted by one of a queue's own workers are given to that
+worker, which requires the handle of the calling task. */
+#if( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUM_CORES > 1 ) )
+	#define workqueueSUBMIT_TO_CALLING_WORKER	1
+#else
+	#define workqueueSUBMIT_TO_CALLING_WORKER	0
+#endif
+
+/* The states a work item can be in, stored in the ucState member of the work
+item.  A work item that is running is in the idle state, so it can be submitted
+again, and is recorded as the running item of its worker. */
+#define workqueueITEM_IDLE						( ( uint8_t ) 0 ) /* Not waiting to run. */
+#define workqueueITEM_PENDING					( ( uint8_t ) 1 ) /* In a worker's list of work items that are ready to run. */
+#define workqueueITEM_DELAYED					( ( uint8_t ) 2 ) /* In one of the queue's lists of delayed work items. */
+
+/* Bits stored in the ucFlags field of a work item. */
+#define workqueueFLAGS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 1 ) /* Set if the work item structure was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+struct xWORK_QUEUE;
+
+/* Structure that holds the state of a work item. */
+typedef struct xWORK_ITEM /*lint !e9058 Style convention uses tag. */
+{
+	ListItem_t xWorkListItem;			/* Held in a worker's list of pending work items, or in a list of delayed work items, while the work item is waiting to run.  The item value is the time at which a delayed work item becomes ready. */
+	WorkFunction_t pxWorkFunction;		/* The function called when the work item runs. */
+	void *pvParameter;					/* The value passed into pxWorkFunction. */
+	struct xWORK_QUEUE *pxWorkQueue;	/* The work queue the work item was last submitted to. */
+	TickType_t xReadyTime;				/* The time at which the work item became, or will become, ready to run.  Used to measure latency. */
+	uint8_t ucState;					/* One of the workqueueITEM_ states. */
+	uint8_t ucFlags;
+} WorkItem_t;
+
+/* Structure that holds the state of a worker task. */
+typedef struct xWORKER /*lint !e9058 Style convention uses tag. */
+{
+	List_t xPendingItems;				/* The work items given to this worker that are ready to run, in the order in which they became ready. */
+	TaskHandle_t xTask;					/* The worker task. */
+	struct xWORK_QUEUE *pxWorkQueue;	/* The work queue to which the worker belongs. */
+	WorkItem_t *pxRunningItem;			/* The work item the worker is running, or NULL. */
+	BaseType_t xIsIdle;					/* pdTRUE if the worker is waiting for work and has not yet been woken. */
+} Worker_t;
+
+/* Structure that holds the state of a work queue. */
+typedef struct xWORK_QUEUE /*lint !e9058 Style convention uses tag. */
+{
+	List_t xDelayedItems1;				/* Work items submitted with a delay, ordered by the time at which they become ready. */
+	List_t xDelayedItems2;				/* As above, the two lists are used as the current and overflow lists. */
+	List_t *pxDelayedItems;				/* Delayed work items that become ready before the tick count next overflows. */
+	List_t *pxOverflowDelayedItems;		/* Delayed work items that become ready after the tick count next overflows. */
+	TickType_t xLastTime;				/* The tick count when the delayed work items were last checked, used to detect the tick count overflowing. */
+	Worker_t *pxWorkers;				/* The array of uxNumberOfWorkers workers, allocated after the work queue structure. */
+	Worker_t *pxTimekeeper;				/* The idle worker that is waiting for the first delayed work item to become ready, or NULL. */
+	UBaseType_t uxNextWorker;			/* The worker the next work item submitted from outside the queue's workers is given to. */
+	WorkQueueStats_t xStats;			/* uxNumberOfWorkers, uxPendingItems and uxDelayedItems are kept up to date along with the other statistics. */
+} WorkQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The function executed by every worker task.  The parameter is the worker.
+ */
+static void prvWorkerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by a worker task to get the next work item to run.  Moves any delayed
+ * work items that have become ready to the worker's own list of pending work
+ * items, then takes the oldest pending work item from the worker's own list,
+ * or, if that is empty, from the worker with the most pending work items.
+ * Returns NULL if there are no pending work items, in which case
+ * *pxTicksToWait is set to the time the worker should wait before checking
+ * again.
+ */
+static WorkItem_t *prvGetWork( Worker_t * const pxWorker, TickType_t * const pxTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Implements both xWorkQueueSubmit() and xWorkQueueSubmitFromISR().
+ * pxHigherPriorityTaskWoken is NULL when called from a task.  Must be called
+ * from a critical section.
+ */
+static BaseType_t prvSubmit( WorkQueue_t * const pxWorkQueue, WorkItem_t * const pxWorkItem, const TickType_t xDelay, const TickType_t xTimeNow, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds a work item that is ready to run to the list of pending work items of
+ * pxWorker, or, if pxWorker is NULL, of the worker whose turn it is.  If that
+ * worker is busy then an idle worker, if any, is woken to take the work item
+ * from it.  Must be called from a critical section.
+ */
+static void prvAddPendingItem( WorkQueue_t * const pxWorkQueue, WorkItem_t * const pxWorkItem, Worker_t *pxWorker, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves delayed work items that are ready to run at xTimeNow to the list of
+ * pending work items of pxWorker, or of the workers in turn if pxWorker is
+ * NULL.  Switches the current and overflow lists of delayed work items if the
+ * tick count has overflowed since they were last checked.  Must be called
+ * from a critical section.
+ */
+static void prvMoveReadyDelayedItems( WorkQueue_t * const pxWorkQueue, Worker_t * const pxWorker, const TickType_t xTimeNow, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wakes pxWorker, or an idle worker if pxWorker is NULL.  Must be called from
+ * a critical section.
+ */
+static void prvWakeWorker( WorkQueue_t * const pxWorkQueue, Worker_t *pxWorker, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the work item that is delayed the least, or NULL if there are no
+ * delayed work items.
+ */
+static WorkItem_t *prvGetNextDelayedItem( const WorkQueue_t * const pxWorkQueue ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, UBaseType_t uxNumberOfWorkers, const UBaseType_t * const puxWorkerPriorities, configSTACK_DEPTH_TYPE usWorkerStackDepth )
+	{
+	WorkQueue_t *pxWorkQueue;
+	Worker_t *pxWorker;
+	UBaseType_t x;
+	BaseType_t xResult = pdPASS;
+
+		configASSERT( uxNumberOfWorkers > ( UBaseType_t ) 0 );
+		configASSERT( puxWorkerPriorities );
+
+		/* The workers are allocated in the same block of memory as the work
+		queue structure, after the structure. */
+		pxWorkQueue = ( WorkQueue_t * ) pvPortMalloc( sizeof( WorkQueue_t ) + ( sizeof( Worker_t ) * ( size_t ) uxNumberOfWorkers ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxWorkQueue != NULL )
+		{
+			vListInitialise( &( pxWorkQueue->xDelayedItems1 ) );
+			vListInitialise( &( pxWorkQueue->xDelayedItems2 ) );
+			pxWorkQueue->pxDelayedItems = &( pxWorkQueue->xDelayedItems1 );
+			pxWorkQueue->pxOverflowDelayedItems = &( pxWorkQueue->xDelayedItems2 );
+			pxWorkQueue->xLastTime = xTaskGetTickCount();
+			pxWorkQueue->pxWorkers = ( Worker_t * ) &( pxWorkQueue[ 1 ] ); /*lint !e9087 !e740 The workers are placed directly after the work queue structure. */
+			pxWorkQueue->pxTimekeeper = NULL;
+			pxWorkQueue->uxNextWorker = ( UBaseType_t ) 0;
+			( void ) memset( &( pxWorkQueue->xStats ), 0x00, sizeof( WorkQueueStats_t ) );
+			pxWorkQueue->xStats.uxNumberOfWorkers = uxNumberOfWorkers;
+
+			/* Initialise every worker before any worker task is created, as a
+			worker task with a priority above the calling task's runs as soon as
+			it is created, and can take work from the other workers. */
+			for( x = ( UBaseType_t ) 0; x < uxNumberOfWorkers; x++ )
+			{
+				pxWorker = &( pxWorkQueue->pxWorkers[ x ] );
+				vListInitialise( &( pxWorker->xPendingItems ) );
+				pxWorker->xTask = NULL;
+				pxWorker->pxWorkQueue = pxWorkQueue;
+				pxWorker->pxRunningItem = NULL;
+				pxWorker->xIsIdle = pdFALSE;
+			}
+
+			for( x = ( UBaseType_t ) 0; ( x < uxNumberOfWorkers ) && ( xResult == pdPASS ); x++ )
+			{
+				xResult = xTaskCreate( prvWorkerTask, pcName, usWorkerStackDepth, ( void * ) &( pxWorkQueue->pxWorkers[ x ] ), puxWorkerPriorities[ x ], &( pxWorkQueue->pxWorkers[ x ].xTask ) );
+			}
+
+			if( xResult == pdPASS )
+			{
+				traceWORK_QUEUE_CREATE( pxWorkQueue );
+			}
+			else
+			{
+				/* Not all the worker tasks could be created.  No work items
+				can have been submitted yet, so any workers that were created
+				are waiting for work and can be deleted. */
+				for( x = ( UBaseType_t ) 0; x < uxNumberOfWorkers; x++ )
+				{
+					if( pxWorkQueue->pxWorkers[ x ].xTask != NULL )
+					{
+						vTaskDelete( pxWorkQueue->pxWorkers[ x ].xTask );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				vPortFree( ( void * ) pxWorkQueue );
+				pxWorkQueue = NULL;
+				traceWORK_QUEUE_CREATE_FAILED();
+			}
+		}
+		else
+		{
+			traceWORK_QUEUE_CREATE_FAILED();
+		}
+
+		return ( WorkQueueHandle_t ) pxWorkQueue;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	WorkItemHandle_t xWorkItemCreate( WorkFunction_t pxWorkFunction, void *pvParameter )
+	{
+	WorkItem_t *pxWorkItem;
+
+		configASSERT( pxWorkFunction );
+
+		pxWorkItem = ( WorkItem_t * ) pvPortMalloc( sizeof( WorkItem_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxWorkItem != NULL )
+		{
+			vListInitialiseItem( &( pxWorkItem->xWorkListItem ) );
+			listSET_LIST_ITEM_OWNER( &( pxWorkItem->xWorkListItem ), pxWorkItem );
+			pxWorkItem->pxWorkFunction = pxWorkFunction;
+			pxWorkItem->pvParameter = pvParameter;
+			pxWorkItem->pxWorkQueue = NULL;
+			pxWorkItem->xReadyTime = ( TickType_t ) 0;
+			pxWorkItem->ucState = workqueueITEM_IDLE;
+			pxWorkItem->ucFlags = 0;
+			traceWORK_ITEM_CREATE( pxWorkItem );
+		}
+		else
+		{
+			traceWORK_ITEM_CREATE_FAILED();
+		}
+
+		return ( WorkItemHandle_t ) pxWorkItem;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxWorkFunction, void *pvParameter, StaticWorkItem_t *pxWorkItemBuffer )
+	{
+	WorkItem_t * const pxWorkItem = ( WorkItem_t * ) pxWorkItemBuffer; /*lint !e740 !e9087 Safe cast as StaticWorkItem_t is opaque WorkItem_t. */
+
+		configASSERT( pxWorkFunction );
+		configASSERT( pxWorkItemBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticWorkItem_t equals the size of the real work
+			item structure. */
+			volatile size_t xSize = sizeof( StaticWorkItem_t );
+			configASSERT( xSize == sizeof( WorkItem_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( pxWorkItem != NULL )
+		{
+			vListInitialiseItem( &( pxWorkItem->xWorkListItem ) );
+			listSET_LIST_ITEM_OWNER( &( pxWorkItem->xWorkListItem ), pxWorkItem );
+			pxWorkItem->pxWorkFunction = pxWorkFunction;
+			pxWorkItem->pvParameter = pvParameter;
+			pxWorkItem->pxWorkQueue = NULL;
+			pxWorkItem->xReadyTime = ( TickType_t ) 0;
+			pxWorkItem->ucState = workqueueITEM_IDLE;
+
+			/* Remember this was statically allocated in case it is ever deleted
+			again. */
+			pxWorkItem->ucFlags = workqueueFLAGS_IS_STATICALLY_ALLOCATED;
+
+			traceWORK_ITEM_CREATE( pxWorkItem );
+		}
+		else
+		{
+			traceWORK_ITEM_CREATE_FAILED();
+		}
+
+		return ( WorkItemHandle_t ) pxWorkItem;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vWorkItemDelete( WorkItemHandle_t xWorkItem )
+{
+WorkItem_t * const pxWorkItem = ( WorkItem_t * ) xWorkItem;
+
+	configASSERT( pxWorkItem );
+
+	/* A work item that is waiting to run, or running, cannot be deleted. */
+	configASSERT( xWorkItemIsBusy( xWorkItem ) == pdFALSE );
+
+	traceWORK_ITEM_DELETE( xWorkItem );
+
+	if( ( pxWorkItem->ucFlags & workqueueFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			vPortFree( ( void * ) pxWorkItem );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt.
+			Force an assert. */
+			configASSERT( xWorkItem == ( WorkItemHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The work item was statically allocated, so there is no memory to
+		free. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue, WorkItemHandle_t xWorkItem, TickType_t xDelay )
+{
+WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) xWorkQueue;
+WorkItem_t * const pxWorkItem = ( WorkItem_t * ) xWorkItem;
+BaseType_t xReturn;
+
+	configASSERT( pxWorkQueue );
+	configASSERT( pxWorkItem );
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvSubmit( pxWorkQueue, pxWorkItem, xDelay, xTaskGetTickCount(), NULL );
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue, WorkItemHandle_t xWorkItem, TickType_t xDelay, BaseType_t *pxHigherPriorityTaskWoken )
+{
+WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) xWorkQueue;
+WorkItem_t * const pxWorkItem = ( WorkItem_t * ) xWorkItem;
+BaseType_t xReturn, xTaskWoken = pdFALSE;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxWorkQueue );
+	configASSERT( pxWorkItem );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		xReturn = prvSubmit( pxWorkQueue, pxWorkItem, xDelay, xTaskGetTickCountFromISR(), &xTaskWoken );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	if( ( pxHigherPriorityTaskWoken != NULL ) && ( xTaskWoken != pdFALSE ) )
+	{
+		*pxHigherPriorityTaskWoken = pdTRUE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkItemCancel( WorkItemHandle_t xWorkItem )
+{
+WorkItem_t * const pxWorkItem = ( WorkItem_t * ) xWorkItem;
+WorkQueue_t *pxWorkQueue;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxWorkItem );
+
+	taskENTER_CRITICAL();
+	{
+		pxWorkQueue = pxWorkItem->pxWorkQueue;
+
+		if( pxWorkItem->ucState != workqueueITEM_IDLE )
+		{
+			( void ) uxListRemove( &( pxWorkItem->xWorkListItem ) );
+
+			if( pxWorkItem->ucState == workqueueITEM_PENDING )
+			{
+				( pxWorkQueue->xStats.uxPendingItems )--;
+			}
+			else
+			{
+				/* If this was the first delayed work item then the worker
+				waiting for it will find nothing to do when it wakes, and will
+				wait for the next delayed work item instead. */
+				( pxWorkQueue->xStats.uxDelayedItems )--;
+			}
+
+			pxWorkItem->ucState = workqueueITEM_IDLE;
+			( pxWorkQueue->xStats.uxNumberOfItemsCancelled )++;
+			traceWORK_ITEM_CANCEL( xWorkItem );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkItemIsBusy( WorkItemHandle_t xWorkItem )
+{
+WorkItem_t * const pxWorkItem = ( WorkItem_t * ) xWorkItem;
+const WorkQueue_t *pxWorkQueue;
+BaseType_t xReturn = pdFALSE;
+UBaseType_t x;
+
+	configASSERT( pxWorkItem );
+
+	taskENTER_CRITICAL();
+	{
+		pxWorkQueue = pxWorkItem->pxWorkQueue;
+
+		if( pxWorkItem->ucState != workqueueITEM_IDLE )
+		{
+			xReturn = pdTRUE;
+		}
+		else if( pxWorkQueue != NULL )
+		{
+			/* Is one of the workers of the queue the work item was last
+			submitted to running it? */
+			for( x = ( UBaseType_t ) 0; x < pxWorkQueue->xStats.uxNumberOfWorkers; x++ )
+			{
+				if( pxWorkQueue->pxWorkers[ x ].pxRunningItem == pxWorkItem )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			/* The work item has never been submitted. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xWorkQueueGetWorkerHandle( WorkQueueHandle_t xWorkQueue, UBaseType_t uxWorker )
+{
+const WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) xWorkQueue;
+
+	configASSERT( pxWorkQueue );
+	configASSERT( uxWorker < pxWorkQueue->xStats.uxNumberOfWorkers );
+
+	return pxWorkQueue->pxWorkers[ uxWorker ].xTask;
+}
+/*-----------------------------------------------------------*/
+
+void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue, WorkQueueStats_t *pxWorkQueueStats )
+{
+const WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) xWorkQueue;
+
+	configASSERT( pxWorkQueue );
+	configASSERT( pxWorkQueueStats );
+
+	taskENTER_CRITICAL();
+	{
+		*pxWorkQueueStats = pxWorkQueue->xStats;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+Worker_t * const pxWorker = ( Worker_t * ) pvParameters;
+WorkItem_t *pxWorkItem;
+WorkFunction_t pxWorkFunction;
+void *pvParameter;
+TickType_t xTicksToWait = portMAX_DELAY;
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxWorkItem = prvGetWork( pxWorker, &xTicksToWait );
+
+			if( pxWorkItem != NULL )
+			{
+				/* Read the function and its parameter while in the critical
+				section, as the work item can be submitted again, or cancelled
+				and deleted, as soon as it is marked as idle. */
+				pxWorkFunction = pxWorkItem->pxWorkFunction;
+				pvParameter = pxWorkItem->pvParameter;
+			}
+			else
+			{
+				pxWorkFunction = NULL;
+				pvParameter = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( pxWorkFunction != NULL )
+		{
+			pxWorkFunction( pvParameter );
+
+			taskENTER_CRITICAL();
+			{
+				pxWorker->pxRunningItem = NULL;
+				( pxWorker->pxWorkQueue->xStats.uxNumberOfItemsRun )++;
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			/* There is no work to do.  A work item submitted after the worker
+			was marked as idle leaves the notification pending, so this does
+			not block. */
+			( void ) ulTaskNotifyTakeIndexed( configWORK_QUEUE_NOTIFICATION_INDEX, pdTRUE, xTicksToWait );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static WorkItem_t *prvGetWork( Worker_t * const pxWorker, TickType_t * const pxTicksToWait )
+{
+WorkQueue_t * const pxWorkQueue = pxWorker->pxWorkQueue;
+const TickType_t xTimeNow = xTaskGetTickCount();
+WorkItem_t *pxWorkItem = NULL;
+Worker_t *pxVictim = pxWorker;
+UBaseType_t x, uxMostPendingItems;
+
+	/* The worker is running so is no longer idle, or waiting for a delayed
+	work item to become ready. */
+	pxWorker->xIsIdle = pdFALSE;
+
+	if( pxWorkQueue->pxTimekeeper == pxWorker )
+	{
+		pxWorkQueue->pxTimekeeper = NULL;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMoveReadyDelayedItems( pxWorkQueue, pxWorker, xTimeNow, NULL );
+
+	if( listLIST_IS_EMPTY( &( pxWorker->xPendingItems ) ) != pdFALSE )
+	{
+		/* Steal from the worker that has the most pending work items. */
+		uxMostPendingItems = ( UBaseType_t ) 0;
+
+		for( x = ( UBaseType_t ) 0; x < pxWorkQueue->xStats.uxNumberOfWorkers; x++ )
+		{
+			if( listCURRENT_LIST_LENGTH( &( pxWorkQueue->pxWorkers[ x ].xPendingItems ) ) > uxMostPendingItems )
+			{
+				uxMostPendingItems = listCURRENT_LIST_LENGTH( &( pxWorkQueue->pxWorkers[ x ].xPendingItems ) );
+				pxVictim = &( pxWorkQueue->pxWorkers[ x ] );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( listLIST_IS_EMPTY( &( pxVictim->xPendingItems ) ) == pdFALSE )
+	{
+		/* Take the oldest work item, which is at the head of the list. */
+		pxWorkItem = ( WorkItem_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxVictim->xPendingItems ) ); /*lint !e9087 !e9079 void * is used as the list owner. */
+		( void ) uxListRemove( &( pxWorkItem->xWorkListItem ) );
+		pxWorkItem->ucState = workqueueITEM_IDLE;
+		pxWorker->pxRunningItem = pxWorkItem;
+		( pxWorkQueue->xStats.uxPendingItems )--;
+
+		if( pxVictim != pxWorker )
+		{
+			( pxWorkQueue->xStats.uxNumberOfItemsStolen )++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( TickType_t ) ( xTimeNow - pxWorkItem->xReadyTime ) > pxWorkQueue->xStats.xMaxLatency )
+		{
+			pxWorkQueue->xStats.xMaxLatency = xTimeNow - pxWorkItem->xReadyTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceWORK_ITEM_START( pxWorkQueue, pxWorkItem );
+
+		/* If this worker was waiting for the first delayed work item then
+		another idle worker must take over. */
+		if( ( pxWorkQueue->pxTimekeeper == NULL ) && ( pxWorkQueue->xStats.uxDelayedItems > ( UBaseType_t ) 0 ) )
+		{
+			prvWakeWorker( pxWorkQueue, NULL, NULL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		/* There is no work to do.  Only one idle worker waits for the first
+		delayed work item to become ready, the rest wait to be woken. */
+		pxWorker->xIsIdle = pdTRUE;
+		pxWorkItem = prvGetNextDelayedItem( pxWorkQueue );
+
+		if( ( pxWorkItem != NULL ) && ( pxWorkQueue->pxTimekeeper == NULL ) )
+		{
+			pxWorkQueue->pxTimekeeper = pxWorker;
+
+			/* The tick count might have overflowed since the work item was
+			submitted, but the subtraction still gives the number of ticks
+			until it becomes ready. */
+			*pxTicksToWait = listGET_LIST_ITEM_VALUE( &( pxWorkItem->xWorkListItem ) ) - xTimeNow;
+		}
+		else
+		{
+			*pxTicksToWait = portMAX_DELAY;
+		}
+
+		pxWorkItem = NULL;
+	}
+
+	return pxWorkItem;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSubmit( WorkQueue_t * const pxWorkQueue, WorkItem_t * const pxWorkItem, const TickType_t xDelay, const TickType_t xTimeNow, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+Worker_t *pxWorker = NULL;
+TickType_t xReadyTime;
+BaseType_t xReturn;
+UBaseType_t x;
+
+	if( pxWorkItem->ucState == workqueueITEM_IDLE )
+	{
+		pxWorkItem->pxWorkQueue = pxWorkQueue;
+
+		/* Check for the tick count overflowing before a delayed work item is
+		placed in one of the lists of delayed work items. */
+		prvMoveReadyDelayedItems( pxWorkQueue, NULL, xTimeNow, pxHigherPriorityTaskWoken );
+
+		if( xDelay == ( TickType_t ) 0 )
+		{
+			#if( workqueueSUBMIT_TO_CALLING_WORKER == 1 )
+			{
+				/* A work item submitted by one of the queue's own workers is
+				given to that worker.  It is likely to be related to the work
+				item the worker is running, and other workers will take it if
+				they are idle. */
+				if( pxHigherPriorityTaskWoken == NULL )
+				{
+					for( x = ( UBaseType_t ) 0; x < pxWorkQueue->xStats.uxNumberOfWorkers; x++ )
+					{
+						if( pxWorkQueue->pxWorkers[ x ].xTask == xTaskGetCurrentTaskHandle() )
+						{
+							pxWorker = &( pxWorkQueue->pxWorkers[ x ] );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
+			{
+				( void ) x;
+			}
+			#endif /* workqueueSUBMIT_TO_CALLING_WORKER */
+
+			pxWorkItem->xReadyTime = xTimeNow;
+			prvAddPendingItem( pxWorkQueue, pxWorkItem, pxWorker, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			xReadyTime = xTimeNow + xDelay;
+			pxWorkItem->xReadyTime = xReadyTime;
+			pxWorkItem->ucState = workqueueITEM_DELAYED;
+			listSET_LIST_ITEM_VALUE( &( pxWorkItem->xWorkListItem ), xReadyTime );
+
+			if( xReadyTime < xTimeNow )
+			{
+				/* The ready time has overflowed. */
+				vListInsert( pxWorkQueue->pxOverflowDelayedItems, &( pxWorkItem->xWorkListItem ) );
+			}
+			else
+			{
+				vListInsert( pxWorkQueue->pxDelayedItems, &( pxWorkItem->xWorkListItem ) );
+			}
+
+			( pxWorkQueue->xStats.uxDelayedItems )++;
+
+			/* If there is a worker waiting for the first delayed work item,
+			and this work item is now the first, then that worker must wait
+			for this one instead.  If there is no such worker then an idle
+			worker takes on the job. */
+			if( pxWorkQueue->pxTimekeeper == NULL )
+			{
+				prvWakeWorker( pxWorkQueue, NULL, pxHigherPriorityTaskWoken );
+			}
+			else if( prvGetNextDelayedItem( pxWorkQueue ) == pxWorkItem )
+			{
+				prvWakeWorker( pxWorkQueue, pxWorkQueue->pxTimekeeper, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		( pxWorkQueue->xStats.uxNumberOfSubmissions )++;
+		traceWORK_ITEM_SUBMIT( pxWorkQueue, pxWorkItem, xDelay );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		/* The work item is already waiting to run. */
+		( pxWorkQueue->xStats.uxNumberOfFailedSubmissions )++;
+		traceWORK_ITEM_SUBMIT_FAILED( pxWorkQueue, pxWorkItem );
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddPendingItem( WorkQueue_t * const pxWorkQueue, WorkItem_t * const pxWorkItem, Worker_t *pxWorker, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+	if( pxWorker == NULL )
+	{
+		/* Share the work items between the workers in turn. */
+		pxWorker = &( pxWorkQueue->pxWorkers[ pxWorkQueue->uxNextWorker ] );
+		( pxWorkQueue->uxNextWorker )++;
+
+		if( pxWorkQueue->uxNextWorker >= pxWorkQueue->xStats.uxNumberOfWorkers )
+		{
+			pxWorkQueue->uxNextWorker = ( UBaseType_t ) 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	vListInsertEnd( &( pxWorker->xPendingItems ), &( pxWorkItem->xWorkListItem ) );
+	pxWorkItem->ucState = workqueueITEM_PENDING;
+	( pxWorkQueue->xStats.uxPendingItems )++;
+
+	if( pxWorkQueue->xStats.uxPendingItems > pxWorkQueue->xStats.uxMaxPendingItems )
+	{
+		pxWorkQueue->xStats.uxMaxPendingItems = pxWorkQueue->xStats.uxPendingItems;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Wake the worker if it is idle, otherwise wake an idle worker, if there
+	is one, to steal the work item from the busy worker. */
+	if( pxWorker->xIsIdle != pdFALSE )
+	{
+		prvWakeWorker( pxWorkQueue, pxWorker, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		prvWakeWorker( pxWorkQueue, NULL, pxHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMoveReadyDelayedItems( WorkQueue_t * const pxWorkQueue, Worker_t * const pxWorker, const TickType_t xTimeNow, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+WorkItem_t *pxWorkItem;
+List_t *pxTemp;
+
+	if( xTimeNow < pxWorkQueue->xLastTime )
+	{
+		/* The tick count has overflowed, so every work item remaining in the
+		current list of delayed work items became ready before the overflow.
+		Then switch the lists, as explained in the same situation in
+		timers.c. */
+		while( listLIST_IS_EMPTY( pxWorkQueue->pxDelayedItems ) == pdFALSE )
+		{
+			pxWorkItem = ( WorkItem_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxWorkQueue->pxDelayedItems ); /*lint !e9087 !e9079 void * is used as the list owner. */
+			( void ) uxListRemove( &( pxWorkItem->xWorkListItem ) );
+			( pxWorkQueue->xStats.uxDelayedItems )--;
+			prvAddPendingItem( pxWorkQueue, pxWorkItem, pxWorker, pxHigherPriorityTaskWoken );
+		}
+
+		pxTemp = pxWorkQueue->pxDelayedItems;
+		pxWorkQueue->pxDelayedItems = pxWorkQueue->pxOverflowDelayedItems;
+		pxWorkQueue->pxOverflowDelayedItems = pxTemp;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxWorkQueue->xLastTime = xTimeNow;
+
+	/* The current list is ordered by ready time, so stop at the first work
+	item that is not ready yet. */
+	while( ( listLIST_IS_EMPTY( pxWorkQueue->pxDelayedItems ) == pdFALSE ) && ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxWorkQueue->pxDelayedItems ) <= xTimeNow ) )
+	{
+		pxWorkItem = ( WorkItem_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxWorkQueue->pxDelayedItems ); /*lint !e9087 !e9079 void * is used as the list owner. */
+		( void ) uxListRemove( &( pxWorkItem->xWorkListItem ) );
+		( pxWorkQueue->xStats.uxDelayedItems )--;
+		prvAddPendingItem( pxWorkQueue, pxWorkItem, pxWorker, pxHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeWorker( WorkQueue_t * const pxWorkQueue, Worker_t *pxWorker, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t x;
+
+	if( pxWorker == NULL )
+	{
+		for( x = ( UBaseType_t ) 0; ( x < pxWorkQueue->xStats.uxNumberOfWorkers ) && ( pxWorker == NULL ); x++ )
+		{
+			if( pxWorkQueue->pxWorkers[ x ].xIsIdle != pdFALSE )
+			{
+				pxWorker = &( pxWorkQueue->pxWorkers[ x ] );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxWorker != NULL )
+	{
+		/* Once woken the worker is not idle, so the next work item submitted
+		wakes a different worker. */
+		pxWorker->xIsIdle = pdFALSE;
+
+		if( pxHigherPriorityTaskWoken == NULL )
+		{
+			( void ) xTaskNotifyGiveIndexed( pxWorker->xTask, configWORK_QUEUE_NOTIFICATION_INDEX );
+		}
+		else
+		{
+			vTaskNotifyGiveIndexedFromISR( pxWorker->xTask, configWORK_QUEUE_NOTIFICATION_INDEX, pxHigherPriorityTaskWoken );
+		}
+	}
+	else
+	{
+		/* Every worker is busy.  The work will be picked up when a worker
+		finishes the work item it is running. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static WorkItem_t *prvGetNextDelayedItem( const WorkQueue_t * const pxWorkQueue )
+{
+WorkItem_t *pxWorkItem;
+
+	if( listLIST_IS_EMPTY( pxWorkQueue->pxDelayedItems ) == pdFALSE )
+	{
+		pxWorkItem = ( WorkItem_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxWorkQueue->pxDelayedItems ); /*lint !e9087 !e9079 void * is used as the list owner. */
+	}
+	else if( listLIST_IS_EMPTY( pxWorkQueue->pxOverflowDelayedItems ) == pdFALSE )
+	{
+		pxWorkItem = ( WorkItem_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxWorkQueue->pxOverflowDelayedItems ); /*lint !e9087 !e9079 void * is used as the list owner. */
+	}
+	else
+	{
+		pxWorkItem = NULL;
+	}
+
+	return pxWorkItem;
+}
+/*-----------------------------------------------------------*/